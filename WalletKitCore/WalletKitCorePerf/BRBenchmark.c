@@ -0,0 +1,135 @@
+//
+//  BRBenchmark.c
+//  CorePerf
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "BRBenchmark.h"
+
+extern uint64_t
+benchmarkNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return 1000000000 * (uint64_t) ts.tv_sec + (uint64_t) ts.tv_nsec;
+}
+
+extern uint64_t
+benchmarkRandom (uint64_t *seed) {
+    uint64_t x = *seed;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *seed = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static int
+benchmarkCompareTimes (const void *t1, const void *t2) {
+    uint64_t v1 = *(const uint64_t *) t1;
+    uint64_t v2 = *(const uint64_t *) t2;
+    return (v1 < v2 ? -1 : (v1 > v2 ? 1 : 0));
+}
+
+// The nearest-rank percentile of the sorted `times`
+static uint64_t
+benchmarkPercentile (const uint64_t *times,
+                     size_t timesCount,
+                     unsigned int percentile) {
+    size_t rank = (percentile * timesCount + 99) / 100;
+    return times[rank > 0 ? rank - 1 : 0];
+}
+
+static void
+benchmarkRunOne (const BRBenchmark *benchmark,
+                 BRBenchmarkOptions options,
+                 int isFirst) {
+    size_t iterations = (0 != benchmark->iterations ? benchmark->iterations : options.iterations);
+    if (0 == iterations) iterations = 1;
+
+    uint64_t *times = calloc (iterations, sizeof (uint64_t));
+    assert (NULL != times);
+
+    fprintf (stderr, "BENCH: %-36s size: %8zu ...", benchmark->name, benchmark->size);
+    fflush  (stderr);
+
+    BRBenchmarkState state = benchmark->setup (benchmark->size);
+
+    size_t bytes = 0;
+    for (size_t index = 0; index < options.warmup + iterations; index++) {
+        if (NULL != benchmark->prepare) benchmark->prepare (state);
+
+        uint64_t start = benchmarkNow();
+        bytes = benchmark->run (state);
+        uint64_t time  = benchmarkNow() - start;
+
+        if (index >= options.warmup) times[index - options.warmup] = time;
+    }
+
+    if (NULL != benchmark->teardown) benchmark->teardown (state);
+
+    qsort (times, iterations, sizeof (uint64_t), benchmarkCompareTimes);
+
+    uint64_t total = 0;
+    for (size_t index = 0; index < iterations; index++)
+        total += times[index];
+
+    uint64_t median = benchmarkPercentile (times, iterations, 50);
+    double   seconds = (0 == median ? 1e-9 : (double) median / 1e9);
+
+    fprintf (stderr, " %12.3f ms (p50)\n", (double) median / 1e6);
+
+    fprintf (options.output,
+             "%s\n    { \"name\": \"%s\", \"size\": %zu, \"items\": %zu, \"warmup\": %zu, \"iterations\": %zu,\n"
+             "      \"ns\": { \"min\": %llu, \"mean\": %llu, \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu },\n"
+             "      \"itemsPerSecond\": %.1f",
+             (isFirst ? "" : ","),
+             benchmark->name,
+             benchmark->size,
+             benchmark->items,
+             options.warmup,
+             iterations,
+             (unsigned long long) times[0],
+             (unsigned long long) (total / iterations),
+             (unsigned long long) median,
+             (unsigned long long) benchmarkPercentile (times, iterations, 90),
+             (unsigned long long) benchmarkPercentile (times, iterations, 99),
+             (unsigned long long) times[iterations - 1],
+             (double) benchmark->items / seconds);
+
+    if (0 != bytes)
+        fprintf (options.output, ", \"bytesPerSecond\": %.1f", (double) bytes / seconds);
+
+    fprintf (options.output, " }");
+    free (times);
+}
+
+extern size_t
+benchmarksRun (const BRBenchmark *benchmarks,
+               size_t benchmarksCount,
+               BRBenchmarkOptions options) {
+    if (NULL == options.output) options.output = stdout;
+
+    size_t count = 0;
+    fprintf (options.output, "{ \"version\": 1,\n  \"benchmarks\": [");
+
+    for (size_t index = 0; index < benchmarksCount; index++) {
+        const BRBenchmark *benchmark = &benchmarks[index];
+        if (NULL != options.filter && NULL == strstr (benchmark->name, options.filter)) continue;
+
+        benchmarkRunOne (benchmark, options, 0 == count);
+        count += 1;
+    }
+
+    fprintf (options.output, "\n  ]\n}\n");
+    fflush  (options.output);
+
+    return count;
+}
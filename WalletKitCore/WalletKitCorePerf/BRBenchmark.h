@@ -0,0 +1,123 @@
+//
+//  BRBenchmark.h
+//  CorePerf
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#ifndef BRBenchmark_h
+#define BRBenchmark_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Benchmark
+
+typedef void *BRBenchmarkState;
+
+///
+/// A Benchmark times `run` over a workload built, once and untimed, by `setup`.  Workloads must
+/// be reproducible - built from fixed seeds, without the network - so that results from different
+/// builds can be compared.
+///
+typedef struct {
+    /// The name, as `<module>.<subject>.<operation>`
+    const char *name;
+
+    /// The workload size, passed to `setup`, such as the number of transactions in a history
+    size_t size;
+
+    /// The items processed by each `run`; used to report items per second.
+    size_t items;
+
+    /// The timed iterations; if zero, the default from BRBenchmarkOptions.
+    size_t iterations;
+
+    /// Build the workload.  Untimed.
+    BRBenchmarkState (*setup) (size_t size);
+
+    /// Optionally, prepare for the next `run`, such as by copying values that `run` consumes.
+    /// Untimed.
+    void (*prepare) (BRBenchmarkState state);
+
+    /// Run once; return the bytes processed, if meaningful, or zero.  Timed.
+    size_t (*run) (BRBenchmarkState state);
+
+    /// Release the workload.  Untimed.
+    void (*teardown) (BRBenchmarkState state);
+} BRBenchmark;
+
+typedef struct {
+    /// Untimed iterations before the timed ones.
+    size_t warmup;
+
+    /// Timed iterations, for benchmarks that don't specify their own.
+    size_t iterations;
+
+    /// If not NULL, run only benchmarks with names containing `filter`.
+    const char *filter;
+
+    /// Where to write the JSON results.
+    FILE *output;
+} BRBenchmarkOptions;
+
+#define BR_BENCHMARK_OPTIONS_DEFAULT     ((BRBenchmarkOptions) { 3, 20, NULL, NULL })
+
+///
+/// Run `benchmarks` and write the results, as JSON, to `options.output` (or stdout).  Progress is
+/// written to stderr.  The results have the form:
+///
+///   { "version": 1,
+///     "benchmarks": [
+///       { "name": "bitcoin.wallet.load", "size": 1000, "items": 1000,
+///         "warmup": 3, "iterations": 20,
+///         "ns": { "min": ..., "mean": ..., "p50": ..., "p90": ..., "p99": ..., "max": ... },
+///         "itemsPerSecond": ..., "bytesPerSecond": ... },
+///       ... ] }
+///
+/// where `ns` is the time of one `run`, over the timed iterations, and the rates are from the
+/// median.  The `bytesPerSecond` is included only if `run` returns non-zero.
+///
+/// @return the number of benchmarks run
+///
+extern size_t
+benchmarksRun (const BRBenchmark *benchmarks,
+               size_t benchmarksCount,
+               BRBenchmarkOptions options);
+
+/// A monotonic time, in nanoseconds
+extern uint64_t
+benchmarkNow (void);
+
+/// A deterministic pseudo-random sequence (xorshift64*), for building workloads.  The `seed`
+/// must not be zero.
+extern uint64_t
+benchmarkRandom (uint64_t *seed);
+
+// MARK: - Benchmarks
+
+/// Wallet load/register over synthetic histories; transaction parse, serialize and sign
+extern size_t
+benchmarksGetBitcoin (const BRBenchmark **benchmarks);
+
+/// RLP encode/decode of block bodies
+extern size_t
+benchmarksGetEthereum (const BRBenchmark **benchmarks);
+
+/// Sets, hashes, the file service and event queues
+extern size_t
+benchmarksGetSupport (const BRBenchmark **benchmarks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRBenchmark_h */
@@ -0,0 +1,713 @@
+//
+//  benchBitcoin.c
+//  CorePerf
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+#include "support/BRArray.h"
+#include "support/BRBIP32Sequence.h"
+#include "support/BRBIP39Mnemonic.h"
+#include "support/BRKey.h"
+#include "bitcoin/BRBIP38Key.h"
+#include "bitcoin/BRChainParams.h"
+#include "bitcoin/BRTransaction.h"
+#include "bitcoin/BRWallet.h"
+#include "crypto/BRCryptoTransferP.h"
+#include "BRBenchmark.h"
+
+#define BENCH_BITCOIN_PHRASE            "a random seed"
+#define BENCH_BITCOIN_ADDRESSES         (SEQUENCE_GAP_LIMIT_EXTERNAL)
+#define BENCH_BITCOIN_BLOCK_HEIGHT      (500000)
+#define BENCH_BITCOIN_BATCH             (100)
+#define BENCH_BITCOIN_BIP38_PASSPHRASE  "TestingOneTwoThree"
+#define BENCH_BITCOIN_BIP38_THREADS     (4)
+#define BENCH_BITCOIN_READERS           (3)
+#define BENCH_BITCOIN_READS             (1000)
+
+// A syntactically valid, but unverifiable, P2PKH scriptSig: <72 byte signature> <33 byte pubkey>
+static uint8_t benchScriptSig[1 + 72 + 1 + 33] = { 72, [73] = 33 };
+
+static BRMasterPubKey
+benchBitcoinMasterPubKey (void) {
+    UInt512 seed;
+    BRBIP39DeriveKey (&seed, BENCH_BITCOIN_PHRASE, NULL);
+    return BRBIP32MasterPubKey (&seed, sizeof (seed));
+}
+
+static size_t
+benchBitcoinScript (uint8_t *script, size_t scriptLen, const char *address) {
+    return BRAddressScriptPubKey (script, scriptLen, BRMainNetParams->addrParams, address);
+}
+
+// Serialize and parse `tx`, as if loaded from storage, to fill in the hashes
+static BRTransaction *
+benchBitcoinFinalize (BRTransaction *tx,
+                      uint32_t blockHeight) {
+    size_t bytesCount = BRTransactionSerialize (tx, NULL, 0);
+    uint8_t *bytes = malloc (bytesCount);
+    BRTransactionSerialize (tx, bytes, bytesCount);
+    BRTransactionFree (tx);
+
+    tx = BRTransactionParse (bytes, bytesCount);
+    assert (NULL != tx && BRTransactionIsSigned (tx));
+    free (bytes);
+
+    tx->blockHeight = blockHeight;
+    tx->timestamp   = (TX_UNCONFIRMED == blockHeight ? 0 : 1500000000 + 600 * blockHeight);
+    return tx;
+}
+
+typedef struct {
+    BRMasterPubKey mpk;
+    BRAddress receive[BENCH_BITCOIN_ADDRESSES];
+    BRAddress change;
+    BRAddress foreign;
+    uint64_t seed;
+} BRBenchBitcoinAccount;
+
+static BRBenchBitcoinAccount
+benchBitcoinAccountCreate (void) {
+    BRBenchBitcoinAccount account;
+    account.mpk  = benchBitcoinMasterPubKey();
+    account.seed = 0x5eed;
+
+    BRWallet *wallet = BRWalletNew (BRMainNetParams->addrParams, NULL, 0, account.mpk);
+    BRWalletUnusedAddrs (wallet, account.receive, BENCH_BITCOIN_ADDRESSES, 0);
+    BRWalletUnusedAddrs (wallet, &account.change, 1, 1);
+    BRWalletFree (wallet);
+
+    BRKey key;
+    UInt256 secret = UINT256_ZERO;
+    secret.u8[31] = 1;
+    BRKeySetSecret (&key, &secret, 1);
+    BRKeyAddress (&key, account.foreign.s, sizeof (account.foreign.s), BRMainNetParams->addrParams);
+
+    return account;
+}
+
+// A transaction paying `amount` from a foreign address to the account's `index` receive address.
+static BRTransaction *
+benchBitcoinCreateReceive (BRBenchBitcoinAccount *account,
+                           size_t index,
+                           uint64_t amount,
+                           uint32_t blockHeight) {
+    uint8_t script[64];
+    size_t  scriptLen;
+
+    UInt256 inHash;
+    for (size_t word = 0; word < 4; word++)
+        inHash.u64[word] = benchmarkRandom (&account->seed);
+
+    BRTransaction *tx = BRTransactionNew();
+
+    scriptLen = benchBitcoinScript (script, sizeof (script), account->foreign.s);
+    BRTransactionAddInput (tx, inHash, 0, amount + 10000, script, scriptLen,
+                           benchScriptSig, sizeof (benchScriptSig), NULL, 0, TXIN_SEQUENCE);
+
+    scriptLen = benchBitcoinScript (script, sizeof (script), account->receive[index % BENCH_BITCOIN_ADDRESSES].s);
+    BRTransactionAddOutput (tx, amount, script, scriptLen);
+
+    return benchBitcoinFinalize (tx, blockHeight);
+}
+
+// A transaction spending output 0 of `prev`, paying half to a foreign address and the rest to change.
+static BRTransaction *
+benchBitcoinCreateSend (BRBenchBitcoinAccount *account,
+                        BRTransaction *prev,
+                        uint32_t blockHeight) {
+    uint8_t script[64];
+    size_t  scriptLen;
+    uint64_t amount = prev->outputs[0].amount;
+
+    BRTransaction *tx = BRTransactionNew();
+
+    BRTransactionAddInput (tx, prev->txHash, 0, amount, prev->outputs[0].script, prev->outputs[0].scriptLen,
+                           benchScriptSig, sizeof (benchScriptSig), NULL, 0, TXIN_SEQUENCE);
+
+    scriptLen = benchBitcoinScript (script, sizeof (script), account->foreign.s);
+    BRTransactionAddOutput (tx, amount / 2, script, scriptLen);
+
+    scriptLen = benchBitcoinScript (script, sizeof (script), account->change.s);
+    BRTransactionAddOutput (tx, amount / 2 - 1000, script, scriptLen);
+
+    return benchBitcoinFinalize (tx, blockHeight);
+}
+
+// A history of `count` confirmed transactions: three receives then a send of the last receive.
+static BRArrayOf(BRTransaction*)
+benchBitcoinCreateHistory (BRBenchBitcoinAccount *account,
+                           size_t count) {
+    BRArrayOf(BRTransaction*) transactions;
+    array_new (transactions, count);
+
+    for (size_t index = 0; index < count; index++) {
+        uint32_t blockHeight = (uint32_t) (BENCH_BITCOIN_BLOCK_HEIGHT + index);
+        BRTransaction *tx = (3 == index % 4
+                             ? benchBitcoinCreateSend    (account, transactions[index - 1], blockHeight)
+                             : benchBitcoinCreateReceive (account, index, 100000 + 1000 * (index % 97), blockHeight));
+        array_add (transactions, tx);
+    }
+
+    return transactions;
+}
+
+static void
+benchBitcoinReleaseTransactions (BRArrayOf(BRTransaction*) transactions) {
+    for (size_t index = 0; index < array_count (transactions); index++)
+        BRTransactionFree (transactions[index]);
+    array_free (transactions);
+}
+
+// MARK: - Wallet Load
+
+typedef struct {
+    BRBenchBitcoinAccount account;
+    BRArrayOf(BRTransaction*) history;
+    BRArrayOf(BRTransaction*) copies;
+    BRWallet *wallet;
+} BRBenchWalletLoad;
+
+static BRBenchmarkState
+benchWalletLoadSetup (size_t size) {
+    BRBenchWalletLoad *bench = calloc (1, sizeof (BRBenchWalletLoad));
+    bench->account = benchBitcoinAccountCreate();
+    bench->history = benchBitcoinCreateHistory (&bench->account, size);
+    array_new (bench->copies, size);
+    return bench;
+}
+
+static void
+benchWalletLoadPrepare (BRBenchmarkState state) {
+    BRBenchWalletLoad *bench = state;
+
+    // The wallet owns, and frees, the prior copies.
+    if (NULL != bench->wallet) BRWalletFree (bench->wallet);
+    bench->wallet = NULL;
+
+    array_clear (bench->copies);
+    for (size_t index = 0; index < array_count (bench->history); index++)
+        array_add (bench->copies, BRTransactionCopy (bench->history[index]));
+}
+
+static size_t
+benchWalletLoadRun (BRBenchmarkState state) {
+    BRBenchWalletLoad *bench = state;
+    bench->wallet = BRWalletNew (BRMainNetParams->addrParams,
+                                 bench->copies, array_count (bench->copies),
+                                 bench->account.mpk);
+    assert (NULL != bench->wallet && BRWalletBalance (bench->wallet) > 0);
+    return 0;
+}
+
+static void
+benchWalletLoadTeardown (BRBenchmarkState state) {
+    BRBenchWalletLoad *bench = state;
+    if (NULL != bench->wallet) BRWalletFree (bench->wallet);
+    array_free (bench->copies);
+    benchBitcoinReleaseTransactions (bench->history);
+    free (bench);
+}
+
+// MARK: - Wallet Register
+
+typedef struct {
+    BRBenchBitcoinAccount account;
+    BRWallet *wallet;
+    BRTransaction *next;
+    size_t index;
+} BRBenchWalletRegister;
+
+static BRBenchmarkState
+benchWalletRegisterSetup (size_t size) {
+    BRBenchWalletRegister *bench = calloc (1, sizeof (BRBenchWalletRegister));
+    bench->account = benchBitcoinAccountCreate();
+
+    BRArrayOf(BRTransaction*) history = benchBitcoinCreateHistory (&bench->account, size);
+    bench->wallet = BRWalletNew (BRMainNetParams->addrParams, history, array_count (history), bench->account.mpk);
+    array_free (history);
+
+    bench->index = size;
+    return bench;
+}
+
+static void
+benchWalletRegisterPrepare (BRBenchmarkState state) {
+    BRBenchWalletRegister *bench = state;
+    bench->next = benchBitcoinCreateReceive (&bench->account, bench->index++, 50000, TX_UNCONFIRMED);
+}
+
+// Registering a wallet transaction updates the balance over the full history.
+static size_t
+benchWalletRegisterRun (BRBenchmarkState state) {
+    BRBenchWalletRegister *bench = state;
+    int registered = BRWalletRegisterTransaction (bench->wallet, bench->next);
+    assert (registered);
+    (void) registered;
+    return 0;
+}
+
+static void
+benchWalletRegisterTeardown (BRBenchmarkState state) {
+    BRBenchWalletRegister *bench = state;
+    BRWalletFree (bench->wallet);
+    free (bench);
+}
+
+// MARK: - Wallet Import
+
+// Import a history into an empty wallet, as an API sync of a restored wallet does; uses the same
+// workload, and state, as 'Wallet Load'.
+static void
+benchWalletImportPrepare (BRBenchmarkState state) {
+    BRBenchWalletLoad *bench = state;
+    benchWalletLoadPrepare (state);
+    bench->wallet = BRWalletNew (BRMainNetParams->addrParams, NULL, 0, bench->account.mpk);
+}
+
+// One transaction at a time; each registration updates the balance over the history so far.
+static size_t
+benchWalletImportRun (BRBenchmarkState state) {
+    BRBenchWalletLoad *bench = state;
+    for (size_t index = 0; index < array_count (bench->copies); index++)
+        BRWalletRegisterTransaction (bench->wallet, bench->copies[index]);
+    assert (BRWalletTransactions (bench->wallet, NULL, 0) == array_count (bench->copies));
+    return 0;
+}
+
+static size_t
+benchWalletImportBatchRun (BRBenchmarkState state) {
+    BRBenchWalletLoad *bench = state;
+    size_t added = BRWalletRegisterTransactions (bench->wallet, bench->copies, array_count (bench->copies));
+    assert (added == array_count (bench->copies));
+    (void) added;
+    return 0;
+}
+
+// MARK: - Wallet Transfers
+
+///
+/// The crypto transfers for a loaded wallet - one per transaction, each included - as a wallet
+/// manager creates them on start.  The 'transfersShow' benchmark then reads every transfer's
+/// amount, direction and addresses, as a UI listing all transfers would.
+///
+typedef struct {
+    BRBenchBitcoinAccount account;
+    BRWallet *wallet;
+    BRArrayOf(BRTransaction*) transactions;
+    BRCryptoCurrency currency;
+    BRCryptoUnit unit;
+} BRBenchWalletTransfers;
+
+static BRBenchmarkState
+benchWalletTransfersSetup (size_t size) {
+    BRBenchWalletTransfers *bench = calloc (1, sizeof (BRBenchWalletTransfers));
+    bench->account = benchBitcoinAccountCreate();
+
+    BRArrayOf(BRTransaction*) history = benchBitcoinCreateHistory (&bench->account, size);
+    bench->wallet = BRWalletNew (BRMainNetParams->addrParams, history, array_count (history), bench->account.mpk);
+    bench->transactions = history;  // owned by `wallet`
+
+    bench->currency = cryptoCurrencyCreate ("bitcoin-mainnet:__native__", "Bitcoin", "btc", "native", NULL);
+    bench->unit     = cryptoUnitCreateAsBase (bench->currency, "sat", "Satoshi", "SAT");
+    return bench;
+}
+
+static void
+benchWalletTransfersTeardown (BRBenchmarkState state) {
+    BRBenchWalletTransfers *bench = state;
+    cryptoUnitGive (bench->unit);
+    cryptoCurrencyGive (bench->currency);
+    array_free (bench->transactions);
+    BRWalletFree (bench->wallet);
+    free (bench);
+}
+
+static BRArrayOf(BRCryptoTransfer)
+benchWalletTransfersCreate (BRBenchWalletTransfers *bench) {
+    size_t count = array_count (bench->transactions);
+
+    BRArrayOf(BRCryptoTransfer) transfers;
+    array_new (transfers, count);
+
+    for (size_t index = 0; index < count; index++) {
+        BRTransaction *tid = bench->transactions[index];
+        BRCryptoTransfer transfer = cryptoTransferCreateAsBTC (bench->unit, bench->unit, bench->wallet, tid, CRYPTO_TRUE);
+
+        // As on BITCOIN_TRANSACTION_UPDATED; the confirmed fee basis is the estimated one.
+        BRCryptoFeeBasis feeBasis = cryptoTransferGetEstimatedFeeBasis (transfer);
+        BRCryptoTransferState state = cryptoTransferStateIncludedInit (tid->blockHeight, 0, tid->timestamp,
+                                                                       feeBasis, CRYPTO_TRUE, NULL);
+        cryptoTransferSetState (transfer, state);
+        cryptoTransferStateRelease (&state);
+        cryptoFeeBasisGive (feeBasis);
+
+        array_add (transfers, transfer);
+    }
+
+    return transfers;
+}
+
+static void
+benchWalletTransfersRelease (BRArrayOf(BRCryptoTransfer) transfers) {
+    for (size_t index = 0; index < array_count (transfers); index++)
+        cryptoTransferGive (transfers[index]);
+    array_free (transfers);
+}
+
+static size_t
+benchWalletTransfersRun (BRBenchmarkState state) {
+    benchWalletTransfersRelease (benchWalletTransfersCreate (state));
+    return 0;
+}
+
+static size_t
+benchWalletTransfersShowRun (BRBenchmarkState state) {
+    BRArrayOf(BRCryptoTransfer) transfers = benchWalletTransfersCreate (state);
+
+    for (size_t index = 0; index < array_count (transfers); index++) {
+        BRCryptoTransfer transfer = transfers[index];
+
+        BRCryptoAmount amount = cryptoTransferGetAmountDirected (transfer);
+        BRCryptoAddress source = cryptoTransferGetSourceAddress (transfer);
+        BRCryptoAddress target = cryptoTransferGetTargetAddress (transfer);
+
+        if (NULL != target) cryptoAddressGive (target);
+        if (NULL != source) cryptoAddressGive (source);
+        cryptoAmountGive (amount);
+    }
+
+    benchWalletTransfersRelease (transfers);
+    return 0;
+}
+
+// MARK: - Wallet Contention
+
+///
+/// Queries of a loaded wallet from `BENCH_BITCOIN_READERS` threads, as a UI makes them, each thread
+/// reading the balance, UTXOs and transactions `BENCH_BITCOIN_READS` times.  In 'readContended' a
+/// writer thread runs throughout, as the peer thread does during a sync: it re-orgs the latest
+/// transaction out, which updates the balance over the full history, and confirms it again.  The
+/// time is that of the readers; compare with 'read', which has no writer.
+///
+typedef struct {
+    BRBenchBitcoinAccount account;
+    BRWallet *wallet;
+    size_t transactionsCount;
+    UInt256 txHash;             // the latest transaction
+    uint32_t blockHeight;
+    uint32_t timestamp;
+    int hasWriter;
+    int done;
+    pthread_mutex_t lock;       // guards `done`
+} BRBenchWalletContention;
+
+static BRBenchmarkState
+benchWalletContentionCreate (size_t size, int hasWriter) {
+    BRBenchWalletContention *bench = calloc (1, sizeof (BRBenchWalletContention));
+    bench->account = benchBitcoinAccountCreate();
+
+    BRArrayOf(BRTransaction*) history = benchBitcoinCreateHistory (&bench->account, size);
+    BRTransaction *latest = history[size - 1];
+
+    bench->txHash      = latest->txHash;
+    bench->blockHeight = latest->blockHeight;
+    bench->timestamp   = latest->timestamp;
+
+    bench->wallet = BRWalletNew (BRMainNetParams->addrParams, history, array_count (history), bench->account.mpk);
+    bench->transactionsCount = array_count (history);
+    array_free (history);
+
+    bench->hasWriter = hasWriter;
+    pthread_mutex_init (&bench->lock, NULL);
+    return bench;
+}
+
+static BRBenchmarkState
+benchWalletReadSetup (size_t size) {
+    return benchWalletContentionCreate (size, 0);
+}
+
+static BRBenchmarkState
+benchWalletReadContendedSetup (size_t size) {
+    return benchWalletContentionCreate (size, 1);
+}
+
+static void
+benchWalletContentionTeardown (BRBenchmarkState state) {
+    BRBenchWalletContention *bench = state;
+    BRWalletFree (bench->wallet);
+    pthread_mutex_destroy (&bench->lock);
+    free (bench);
+}
+
+static int
+benchWalletContentionIsDone (BRBenchWalletContention *bench) {
+    pthread_mutex_lock (&bench->lock);
+    int done = bench->done;
+    pthread_mutex_unlock (&bench->lock);
+    return done;
+}
+
+static void *
+benchWalletContentionWriter (void *context) {
+    BRBenchWalletContention *bench = context;
+    while (!benchWalletContentionIsDone (bench)) {
+        BRWalletSetTxUnconfirmedAfter (bench->wallet, bench->blockHeight - 1);
+        BRWalletUpdateTransactions (bench->wallet, &bench->txHash, 1, bench->blockHeight, bench->timestamp);
+    }
+    return NULL;
+}
+
+static void *
+benchWalletContentionReader (void *context) {
+    BRBenchWalletContention *bench = context;
+
+    size_t utxosCount = BRWalletUTXOs (bench->wallet, NULL, 0);
+    BRUTXO *utxos = calloc (utxosCount + 1, sizeof (BRUTXO));
+    BRTransaction **transactions = calloc (bench->transactionsCount, sizeof (BRTransaction*));
+
+    uint64_t balance = 0;
+    for (size_t read = 0; read < BENCH_BITCOIN_READS; read++) {
+        balance += BRWalletBalance (bench->wallet);
+        BRWalletUTXOs (bench->wallet, utxos, utxosCount);
+        BRWalletTransactions (bench->wallet, transactions, bench->transactionsCount);
+    }
+    assert (balance > 0);
+    (void) balance;
+
+    free (transactions);
+    free (utxos);
+    return NULL;
+}
+
+static size_t
+benchWalletContentionRun (BRBenchmarkState state) {
+    BRBenchWalletContention *bench = state;
+    pthread_t writer, readers[BENCH_BITCOIN_READERS];
+
+    bench->done = 0;
+    if (bench->hasWriter) pthread_create (&writer, NULL, benchWalletContentionWriter, bench);
+
+    for (size_t index = 0; index < BENCH_BITCOIN_READERS; index++)
+        pthread_create (&readers[index], NULL, benchWalletContentionReader, bench);
+
+    for (size_t index = 0; index < BENCH_BITCOIN_READERS; index++)
+        pthread_join (readers[index], NULL);
+
+    pthread_mutex_lock (&bench->lock);
+    bench->done = 1;
+    pthread_mutex_unlock (&bench->lock);
+
+    if (bench->hasWriter) pthread_join (writer, NULL);
+    return 0;
+}
+
+// MARK: - Transaction
+
+typedef struct {
+    BRKey keys[2];
+    BRTransaction *unsignedTx;
+    BRTransaction *signedTx;
+    uint8_t *bytes;
+    size_t bytesCount;
+    BRTransaction *signing;
+} BRBenchTransaction;
+
+static BRBenchmarkState
+benchTransactionSetup (size_t size) {
+    BRBenchTransaction *bench = calloc (1, sizeof (BRBenchTransaction));
+    BRBenchBitcoinAccount account = benchBitcoinAccountCreate();
+
+    uint8_t script[64];
+    size_t  scriptLen;
+
+    bench->unsignedTx = BRTransactionNew();
+    for (size_t index = 0; index < 2; index++) {
+        UInt256 secret = UINT256_ZERO;
+        secret.u8[31] = (uint8_t) (index + 1);
+        BRKeySetSecret (&bench->keys[index], &secret, 1);
+
+        BRAddress address;
+        BRKeyAddress (&bench->keys[index], address.s, sizeof (address.s), BRMainNetParams->addrParams);
+        scriptLen = benchBitcoinScript (script, sizeof (script), address.s);
+
+        UInt256 inHash = UINT256_ZERO;
+        inHash.u64[0] = benchmarkRandom (&account.seed);
+        BRTransactionAddInput (bench->unsignedTx, inHash, (uint32_t) index, 100000, script, scriptLen,
+                               NULL, 0, NULL, 0, TXIN_SEQUENCE);
+    }
+
+    scriptLen = benchBitcoinScript (script, sizeof (script), account.receive[0].s);
+    BRTransactionAddOutput (bench->unsignedTx, 150000, script, scriptLen);
+    scriptLen = benchBitcoinScript (script, sizeof (script), account.change.s);
+    BRTransactionAddOutput (bench->unsignedTx, 40000, script, scriptLen);
+
+    bench->signedTx = BRTransactionCopy (bench->unsignedTx);
+    BRTransactionSign (bench->signedTx, 0, bench->keys, 2);
+    assert (BRTransactionIsSigned (bench->signedTx));
+
+    bench->bytesCount = BRTransactionSerialize (bench->signedTx, NULL, 0);
+    bench->bytes = malloc (bench->bytesCount);
+    BRTransactionSerialize (bench->signedTx, bench->bytes, bench->bytesCount);
+
+    return bench;
+}
+
+static size_t
+benchTransactionParseRun (BRBenchmarkState state) {
+    BRBenchTransaction *bench = state;
+    for (size_t index = 0; index < BENCH_BITCOIN_BATCH; index++)
+        BRTransactionFree (BRTransactionParse (bench->bytes, bench->bytesCount));
+    return BENCH_BITCOIN_BATCH * bench->bytesCount;
+}
+
+static size_t
+benchTransactionSerializeRun (BRBenchmarkState state) {
+    BRBenchTransaction *bench = state;
+    uint8_t bytes[bench->bytesCount];
+    for (size_t index = 0; index < BENCH_BITCOIN_BATCH; index++)
+        BRTransactionSerialize (bench->signedTx, bytes, sizeof (bytes));
+    return BENCH_BITCOIN_BATCH * bench->bytesCount;
+}
+
+static void
+benchTransactionSignPrepare (BRBenchmarkState state) {
+    BRBenchTransaction *bench = state;
+    if (NULL != bench->signing) BRTransactionFree (bench->signing);
+    bench->signing = BRTransactionCopy (bench->unsignedTx);
+}
+
+static size_t
+benchTransactionSignRun (BRBenchmarkState state) {
+    BRBenchTransaction *bench = state;
+    BRTransactionSign (bench->signing, 0, bench->keys, 2);
+    return 0;
+}
+
+static void
+benchTransactionTeardown (BRBenchmarkState state) {
+    BRBenchTransaction *bench = state;
+    if (NULL != bench->signing) BRTransactionFree (bench->signing);
+    BRTransactionFree (bench->unsignedTx);
+    BRTransactionFree (bench->signedTx);
+    free (bench->bytes);
+    free (bench);
+}
+
+// MARK: - BIP38
+
+///
+/// Sweeping paper wallets: decrypting `size` BIP38 (non-EC multiplied) keys, one at a time and as
+/// a batch over BENCH_BITCOIN_BIP38_THREADS threads.  Each key is one scrypt with N = 16384.
+///
+typedef struct {
+    size_t count;
+    char (*bip38Keys)[61];
+    const char **bip38KeyPointers;
+    const char **passphrases;
+    BRKey *keys;
+} BRBenchBIP38;
+
+static BRBenchmarkState
+benchBIP38Setup (size_t size) {
+    BRBenchBIP38 *bench = calloc (1, sizeof (BRBenchBIP38));
+    bench->count = size;
+    bench->bip38Keys = calloc (size, sizeof (bench->bip38Keys[0]));
+    bench->bip38KeyPointers = calloc (size, sizeof (const char *));
+    bench->passphrases = calloc (size, sizeof (const char *));
+    bench->keys = calloc (size, sizeof (BRKey));
+
+    for (size_t index = 0; index < size; index++) {
+        UInt256 secret = UINT256_ZERO;
+        secret.u32[7] = (uint32_t) (index + 1);
+
+        BRKey key;
+        BRKeySetSecret (&key, &secret, 1);
+        BRKeyBIP38Key (&key, bench->bip38Keys[index], sizeof (bench->bip38Keys[index]),
+                       BENCH_BITCOIN_BIP38_PASSPHRASE, BRMainNetParams->addrParams);
+
+        bench->bip38KeyPointers[index] = bench->bip38Keys[index];
+        bench->passphrases[index] = BENCH_BITCOIN_BIP38_PASSPHRASE;
+    }
+
+    return bench;
+}
+
+static size_t
+benchBIP38DecryptRun (BRBenchmarkState state) {
+    BRBenchBIP38 *bench = state;
+    for (size_t index = 0; index < bench->count; index++) {
+        int valid = BRKeySetBIP38Key (&bench->keys[index], bench->bip38KeyPointers[index],
+                                      bench->passphrases[index], BRMainNetParams->addrParams);
+        assert (valid);
+    }
+    return 0;
+}
+
+static size_t
+benchBIP38DecryptBatchRun (BRBenchmarkState state) {
+    BRBenchBIP38 *bench = state;
+    size_t decrypted = BRKeySetBIP38Keys (bench->keys, NULL, bench->bip38KeyPointers, bench->passphrases,
+                                          bench->count, BRMainNetParams->addrParams, BENCH_BITCOIN_BIP38_THREADS);
+    assert (decrypted == bench->count);
+    return 0;
+}
+
+static void
+benchBIP38Teardown (BRBenchmarkState state) {
+    BRBenchBIP38 *bench = state;
+    for (size_t index = 0; index < bench->count; index++)
+        BRKeyClean (&bench->keys[index]);
+    free (bench->keys);
+    free (bench->passphrases);
+    free (bench->bip38KeyPointers);
+    free (bench->bip38Keys);
+    free (bench);
+}
+
+// MARK: - Benchmarks
+
+static const BRBenchmark benchmarksBitcoin[] = {
+    { "bitcoin.wallet.load",             1000,   1000, 0, benchWalletLoadSetup, benchWalletLoadPrepare, benchWalletLoadRun, benchWalletLoadTeardown },
+    { "bitcoin.wallet.load",            10000,  10000, 0, benchWalletLoadSetup, benchWalletLoadPrepare, benchWalletLoadRun, benchWalletLoadTeardown },
+    { "bitcoin.wallet.load",           100000, 100000, 5, benchWalletLoadSetup, benchWalletLoadPrepare, benchWalletLoadRun, benchWalletLoadTeardown },
+
+    { "bitcoin.wallet.register",         1000,      1, 0, benchWalletRegisterSetup, benchWalletRegisterPrepare, benchWalletRegisterRun, benchWalletRegisterTeardown },
+    { "bitcoin.wallet.register",        10000,      1, 0, benchWalletRegisterSetup, benchWalletRegisterPrepare, benchWalletRegisterRun, benchWalletRegisterTeardown },
+    { "bitcoin.wallet.register",       100000,      1, 0, benchWalletRegisterSetup, benchWalletRegisterPrepare, benchWalletRegisterRun, benchWalletRegisterTeardown },
+
+    // One at a time is quadratic in the history; 100k is not run.
+    { "bitcoin.wallet.import",           1000,   1000, 0, benchWalletLoadSetup, benchWalletImportPrepare, benchWalletImportRun, benchWalletLoadTeardown },
+    { "bitcoin.wallet.import",          10000,  10000, 1, benchWalletLoadSetup, benchWalletImportPrepare, benchWalletImportRun, benchWalletLoadTeardown },
+
+    { "bitcoin.wallet.importBatch",      1000,   1000, 0, benchWalletLoadSetup, benchWalletImportPrepare, benchWalletImportBatchRun, benchWalletLoadTeardown },
+    { "bitcoin.wallet.importBatch",     10000,  10000, 0, benchWalletLoadSetup, benchWalletImportPrepare, benchWalletImportBatchRun, benchWalletLoadTeardown },
+    { "bitcoin.wallet.importBatch",    100000, 100000, 5, benchWalletLoadSetup, benchWalletImportPrepare, benchWalletImportBatchRun, benchWalletLoadTeardown },
+
+    { "bitcoin.wallet.transfers",        50000,  50000, 5, benchWalletTransfersSetup, NULL, benchWalletTransfersRun,     benchWalletTransfersTeardown },
+    { "bitcoin.wallet.transfersShow",    50000,  50000, 5, benchWalletTransfersSetup, NULL, benchWalletTransfersShowRun, benchWalletTransfersTeardown },
+
+    { "bitcoin.wallet.read",             10000, BENCH_BITCOIN_READERS * BENCH_BITCOIN_READS, 5, benchWalletReadSetup,          NULL, benchWalletContentionRun, benchWalletContentionTeardown },
+    { "bitcoin.wallet.readContended",    10000, BENCH_BITCOIN_READERS * BENCH_BITCOIN_READS, 5, benchWalletReadContendedSetup, NULL, benchWalletContentionRun, benchWalletContentionTeardown },
+
+    { "bitcoin.transaction.parse",          1, BENCH_BITCOIN_BATCH, 0, benchTransactionSetup, NULL, benchTransactionParseRun,     benchTransactionTeardown },
+    { "bitcoin.transaction.serialize",      1, BENCH_BITCOIN_BATCH, 0, benchTransactionSetup, NULL, benchTransactionSerializeRun, benchTransactionTeardown },
+    { "bitcoin.transaction.sign",           1,      1, 0, benchTransactionSetup, benchTransactionSignPrepare, benchTransactionSignRun, benchTransactionTeardown },
+
+    { "bitcoin.bip38.decrypt",              8,      8, 3, benchBIP38Setup, NULL, benchBIP38DecryptRun,      benchBIP38Teardown },
+    { "bitcoin.bip38.decryptBatch",         8,      8, 3, benchBIP38Setup, NULL, benchBIP38DecryptBatchRun, benchBIP38Teardown },
+};
+
+extern size_t
+benchmarksGetBitcoin (const BRBenchmark **benchmarks) {
+    *benchmarks = benchmarksBitcoin;
+    return sizeof (benchmarksBitcoin) / sizeof (BRBenchmark);
+}
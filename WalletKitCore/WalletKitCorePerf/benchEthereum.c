@@ -0,0 +1,289 @@
+//
+//  benchEthereum.c
+//  CorePerf
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#include "support/BRArray.h"
+#include "support/BRKey.h"
+#include "ethereum/rlp/BRRlp.h"
+#include "ethereum/base/BREthereumBase.h"
+#include "ethereum/blockchain/BREthereumBlockChain.h"
+#include "ethereum/contract/BREthereumContract.h"
+#include "BRBenchmark.h"
+
+// An ERC20 `transfer(address,uint256)` call, less the arguments
+#define BENCH_ETHEREUM_TRANSFER_SELECTOR        "0xa9059cbb"
+
+// MARK: - Block Body
+
+///
+/// A block body - `[[transactions...], [ommers...]]` - holding `size` signed transactions; every
+/// third an ERC20 transfer, the others Ether transfers.  There are no recorded bodies in the tree,
+/// so the body is built from fixed keys; each transaction has mainnet's shape and size.
+///
+typedef struct {
+    BREthereumNetwork network;
+    BRRlpCoder coder;
+    BRArrayOf(BREthereumTransaction) transactions;
+    BRRlpData body;
+} BRBenchBlockBody;
+
+static BREthereumTransaction
+benchEthereumCreateTransaction (BRKey *key,
+                                BREthereumAddress source,
+                                BREthereumNetwork network,
+                                BRRlpCoder coder,
+                                uint64_t *seed,
+                                size_t index) {
+    BREthereumAddress target;
+    for (size_t byte = 0; byte < sizeof (target.bytes); byte++)
+        target.bytes[byte] = (uint8_t) benchmarkRandom (seed);
+
+    char data[2 + 8 + 64 + 64 + 1] = { '\0' };
+    int  isToken = (0 == index % 3);
+    if (isToken)
+        sprintf (data, "%s%024d%016llx%016llx%08x%048d%016llx",
+                 BENCH_ETHEREUM_TRANSFER_SELECTOR,
+                 0,                                                     // address, padded
+                 (unsigned long long) benchmarkRandom (seed),
+                 (unsigned long long) benchmarkRandom (seed),
+                 (unsigned int) benchmarkRandom (seed),
+                 0,                                                     // amount, padded
+                 (unsigned long long) benchmarkRandom (seed));
+
+    BREthereumTransaction transaction =
+    transactionCreate (source,
+                       target,
+                       ethEtherCreateNumber (isToken ? 0 : benchmarkRandom (seed) >> 8, WEI),
+                       ethGasPriceCreate (ethEtherCreateNumber (20 + index % 10, GWEI)),
+                       ethGasCreate (isToken ? 60000 : 21000),
+                       (isToken ? data : NULL),
+                       index);
+
+    BRRlpItem item = transactionRlpEncode (transaction, network, RLP_TYPE_TRANSACTION_UNSIGNED, coder);
+    BRRlpData unsignedData = rlpItemGetData (coder, item);
+    rlpItemRelease (coder, item);
+
+    transactionSign (transaction, ethSignatureCreate (SIGNATURE_TYPE_RECOVERABLE_VRS_EIP,
+                                                      unsignedData.bytes,
+                                                      unsignedData.bytesCount,
+                                                      *key));
+    rlpDataRelease (unsignedData);
+
+    return transaction;
+}
+
+static BRRlpData
+benchEthereumEncodeBody (BRBenchBlockBody *bench) {
+    size_t count = array_count (bench->transactions);
+    BRRlpItem items[count];
+
+    for (size_t index = 0; index < count; index++)
+        items[index] = transactionRlpEncode (bench->transactions[index], bench->network, RLP_TYPE_NETWORK, bench->coder);
+
+    BRRlpItem body = rlpEncodeList2 (bench->coder,
+                                     rlpEncodeListItems (bench->coder, items, count),
+                                     rlpEncodeListItems (bench->coder, NULL, 0));
+
+    BRRlpData data = rlpItemGetData (bench->coder, body);
+    rlpItemRelease (bench->coder, body);
+    return data;
+}
+
+static BRBenchmarkState
+benchBlockBodySetup (size_t size) {
+    BRBenchBlockBody *bench = calloc (1, sizeof (BRBenchBlockBody));
+    bench->network = ethNetworkMainnet;
+    bench->coder   = rlpCoderCreate();
+
+    BRKey key;
+    UInt256 secret = UINT256_ZERO;
+    secret.u8[31] = 1;
+    BRKeySetSecret (&key, &secret, 0);
+    BRKeyPubKey (&key, NULL, 0);
+    BREthereumAddress source = ethAddressCreateKey (&key);
+
+    uint64_t seed = 0x5eed;
+    array_new (bench->transactions, size);
+    for (size_t index = 0; index < size; index++)
+        array_add (bench->transactions,
+                   benchEthereumCreateTransaction (&key, source, bench->network, bench->coder, &seed, index));
+
+    bench->body = benchEthereumEncodeBody (bench);
+    return bench;
+}
+
+static void
+benchBlockBodyTeardown (BRBenchmarkState state) {
+    BRBenchBlockBody *bench = state;
+    for (size_t index = 0; index < array_count (bench->transactions); index++)
+        transactionRelease (bench->transactions[index]);
+    array_free (bench->transactions);
+    rlpDataRelease (bench->body);
+    rlpCoderRelease (bench->coder);
+    free (bench);
+}
+
+static size_t
+benchBlockBodyEncodeRun (BRBenchmarkState state) {
+    BRBenchBlockBody *bench = state;
+    BRRlpData data = benchEthereumEncodeBody (bench);
+    size_t bytesCount = data.bytesCount;
+    rlpDataRelease (data);
+    return bytesCount;
+}
+
+// Walk the RLP structure only
+static size_t
+benchBlockBodyParseRun (BRBenchmarkState state) {
+    BRBenchBlockBody *bench = state;
+    BRRlpItem item = rlpDataGetItem (bench->coder, bench->body);
+    rlpItemRelease (bench->coder, item);
+    return bench->body.bytesCount;
+}
+
+// Decode the transactions, as LES does for a 'BlockBodies' message; includes recovering each
+// transaction's source address from its signature.
+static size_t
+benchBlockBodyDecodeRun (BRBenchmarkState state) {
+    BRBenchBlockBody *bench = state;
+    BRRlpItem item = rlpDataGetItem (bench->coder, bench->body);
+
+    size_t itemsCount;
+    const BRRlpItem *items = rlpDecodeList (bench->coder, item, &itemsCount);
+    assert (2 == itemsCount);
+
+    BRArrayOf(BREthereumTransaction) transactions = blockTransactionsRlpDecode (items[0],
+                                                                                bench->network,
+                                                                                RLP_TYPE_NETWORK,
+                                                                                bench->coder);
+    assert (array_count (transactions) == array_count (bench->transactions));
+
+    for (size_t index = 0; index < array_count (transactions); index++)
+        transactionRelease (transactions[index]);
+    array_free (transactions);
+
+    rlpItemRelease (bench->coder, item);
+    return bench->body.bytesCount;
+}
+
+// MARK: - Logs
+
+///
+/// The archived logs of a token-heavy account - `size` ERC20 Transfer logs, each RLP encoded as
+/// BCS saves them.  The 'decode' benchmark loads the logs, as on a wallet manager start.
+///
+typedef struct {
+    BRRlpCoder coder;
+    BRArrayOf(BRRlpData) archives;
+    size_t bytesCount;
+} BRBenchLogs;
+
+static BRBenchmarkState
+benchLogsSetup (size_t size) {
+    BRBenchLogs *bench = calloc (1, sizeof (BRBenchLogs));
+    bench->coder = rlpCoderCreate();
+    array_new (bench->archives, size);
+
+    BREthereumLogTopic topics[3];
+    topics[0] = logTopicCreateFromString (ethEventGetSelector (ethEventERC20Transfer));
+
+    uint64_t seed = 0x5eed;
+    for (size_t index = 0; index < size; index++) {
+        // A few tokens; the source and target addresses, zero padded, as topics 1 and 2
+        BREthereumAddress contract;
+        memset (contract.bytes, (int) (index % 16), sizeof (contract.bytes));
+
+        memset (topics[1].bytes, 0, 12);
+        memset (topics[2].bytes, 0, 12);
+        for (size_t byte = 12; byte < LOG_TOPIC_BYTES_COUNT; byte++) {
+            topics[1].bytes[byte] = (uint8_t) benchmarkRandom (&seed);
+            topics[2].bytes[byte] = (uint8_t) benchmarkRandom (&seed);
+        }
+
+        UInt256 amount = UINT256_ZERO;
+        amount.u64[0] = benchmarkRandom (&seed);
+        uint8_t amountBytes[32];
+        for (size_t byte = 0; byte < 32; byte++)
+            amountBytes[byte] = amount.u8[31 - byte];
+
+        BRRlpItem dataItem = rlpEncodeBytes (bench->coder, amountBytes, sizeof (amountBytes));
+        BRRlpData data = rlpItemGetData (bench->coder, dataItem);
+        rlpItemRelease (bench->coder, dataItem);
+
+        BREthereumHash transactionHash;
+        for (size_t byte = 0; byte < sizeof (transactionHash.bytes); byte++)
+            transactionHash.bytes[byte] = (uint8_t) benchmarkRandom (&seed);
+
+        BREthereumLog log = logCreate (contract, 3, topics, data);
+        logInitializeIdentifier (log, transactionHash, 0);
+        logSetStatus (log, transactionStatusCreateIncluded (transactionHash, 6000000 + index, 0,
+                                                            TRANSACTION_STATUS_BLOCK_TIMESTAMP_UNKNOWN,
+                                                            ethGasCreate (36000)));
+
+        BRRlpItem item = logRlpEncode (log, RLP_TYPE_ARCHIVE, bench->coder);
+        BRRlpData archive = rlpItemGetData (bench->coder, item);
+        rlpItemRelease (bench->coder, item);
+
+        array_add (bench->archives, archive);
+        bench->bytesCount += archive.bytesCount;
+
+        logRelease (log);
+        rlpDataRelease (data);
+    }
+
+    return bench;
+}
+
+static void
+benchLogsTeardown (BRBenchmarkState state) {
+    BRBenchLogs *bench = state;
+    for (size_t index = 0; index < array_count (bench->archives); index++)
+        rlpDataRelease (bench->archives[index]);
+    array_free (bench->archives);
+    rlpCoderRelease (bench->coder);
+    free (bench);
+}
+
+static size_t
+benchLogsDecodeRun (BRBenchmarkState state) {
+    BRBenchLogs *bench = state;
+    size_t count = array_count (bench->archives);
+
+    BRArrayOf(BREthereumLog) logs;
+    array_new (logs, count);
+
+    for (size_t index = 0; index < count; index++) {
+        BRRlpItem item = rlpDataGetItem (bench->coder, bench->archives[index]);
+        array_add (logs, logRlpDecode (item, RLP_TYPE_ARCHIVE, bench->coder));
+        rlpItemRelease (bench->coder, item);
+    }
+
+    logsRelease (logs);
+    return bench->bytesCount;
+}
+
+// MARK: - Benchmarks
+
+static const BRBenchmark benchmarksEthereum[] = {
+    { "ethereum.rlp.encodeBody",   200, 200, 0, benchBlockBodySetup, NULL, benchBlockBodyEncodeRun, benchBlockBodyTeardown },
+    { "ethereum.rlp.parseBody",    200, 200, 0, benchBlockBodySetup, NULL, benchBlockBodyParseRun,  benchBlockBodyTeardown },
+    { "ethereum.rlp.decodeBody",   200, 200, 0, benchBlockBodySetup, NULL, benchBlockBodyDecodeRun, benchBlockBodyTeardown },
+
+    { "ethereum.log.decode",     10000, 10000, 0, benchLogsSetup,    NULL, benchLogsDecodeRun,      benchLogsTeardown },
+};
+
+extern size_t
+benchmarksGetEthereum (const BRBenchmark **benchmarks) {
+    *benchmarks = benchmarksEthereum;
+    return sizeof (benchmarksEthereum) / sizeof (BRBenchmark);
+}
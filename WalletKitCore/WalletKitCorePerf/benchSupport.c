@@ -0,0 +1,647 @@
+//
+//  benchSupport.c
+//  CorePerf
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "support/BRInt.h"
+#include "support/BRSet.h"
+#include "support/BRCrypto.h"
+#include "support/BRFileService.h"
+#include "ethereum/event/BREvent.h"
+#include "ethereum/event/BREventQueue.h"
+#include "BRBenchmark.h"
+
+static size_t
+benchUInt256Hash (const void *value) {
+    return (size_t) ((const UInt256 *) value)->u64[0];
+}
+
+static int
+benchUInt256Eq (const void *value1, const void *value2) {
+    return UInt256Eq (*(const UInt256 *) value1, *(const UInt256 *) value2);
+}
+
+static UInt256 *
+benchUInt256Create (size_t count) {
+    UInt256 *values = malloc (count * sizeof (UInt256));
+    uint64_t seed = 0x5eed;
+
+    for (size_t index = 0; index < count; index++)
+        for (size_t word = 0; word < 4; word++)
+            values[index].u64[word] = benchmarkRandom (&seed);
+
+    return values;
+}
+
+// MARK: - Set
+
+typedef struct {
+    size_t count;
+    UInt256 *values;
+    BRSet *set;
+} BRBenchSet;
+
+static BRBenchmarkState
+benchSetSetup (size_t size) {
+    BRBenchSet *bench = calloc (1, sizeof (BRBenchSet));
+    bench->count  = size;
+    bench->values = benchUInt256Create (size);
+    bench->set    = BRSetNew (benchUInt256Hash, benchUInt256Eq, size);
+    for (size_t index = 0; index < size; index++)
+        BRSetAdd (bench->set, &bench->values[index]);
+    return bench;
+}
+
+static void
+benchSetTeardown (BRBenchmarkState state) {
+    BRBenchSet *bench = state;
+    BRSetFree (bench->set);
+    free (bench->values);
+    free (bench);
+}
+
+// From an empty set, so including the set's growth
+static size_t
+benchSetAddRun (BRBenchmarkState state) {
+    BRBenchSet *bench = state;
+    BRSet *set = BRSetNew (benchUInt256Hash, benchUInt256Eq, 10);
+    for (size_t index = 0; index < bench->count; index++)
+        BRSetAdd (set, &bench->values[index]);
+    BRSetFree (set);
+    return 0;
+}
+
+static size_t
+benchSetGetRun (BRBenchmarkState state) {
+    BRBenchSet *bench = state;
+    size_t found = 0;
+    for (size_t index = 0; index < bench->count; index++)
+        found += (NULL != BRSetGet (bench->set, &bench->values[index]));
+    assert (found == bench->count);
+    return 0;
+}
+
+static void
+benchSetRemovePrepare (BRBenchmarkState state) {
+    BRBenchSet *bench = state;
+    for (size_t index = 0; index < bench->count; index++)
+        BRSetAdd (bench->set, &bench->values[index]);
+}
+
+static size_t
+benchSetRemoveRun (BRBenchmarkState state) {
+    BRBenchSet *bench = state;
+    for (size_t index = 0; index < bench->count; index++)
+        BRSetRemove (bench->set, &bench->values[index]);
+    return 0;
+}
+
+// MARK: - Hash
+
+typedef struct {
+    size_t count;
+    uint8_t *bytes;
+} BRBenchHash;
+
+static BRBenchmarkState
+benchHashSetup (size_t size) {
+    BRBenchHash *bench = calloc (1, sizeof (BRBenchHash));
+    bench->count = size;
+    bench->bytes = malloc (size);
+
+    uint64_t seed = 0x5eed;
+    for (size_t index = 0; index < size; index++)
+        bench->bytes[index] = (uint8_t) benchmarkRandom (&seed);
+    return bench;
+}
+
+static void
+benchHashTeardown (BRBenchmarkState state) {
+    BRBenchHash *bench = state;
+    free (bench->bytes);
+    free (bench);
+}
+
+static size_t
+benchHashSHA256Run (BRBenchmarkState state) {
+    BRBenchHash *bench = state;
+    UInt256 md;
+    BRSHA256 (&md, bench->bytes, bench->count);
+    return bench->count;
+}
+
+static size_t
+benchHashKeccak256Run (BRBenchmarkState state) {
+    BRBenchHash *bench = state;
+    UInt256 md;
+    BRKeccak256 (&md, bench->bytes, bench->count);
+    return bench->count;
+}
+
+// MARK: - AES
+
+#define BENCH_AES_ECB_BLOCKS        (1000)
+
+///
+/// AES-256, as RLPx frames use it: CTR over the frame bytes and ECB over single blocks for the MAC
+/// updates.  The 'portable' benchmarks disable the AES instructions, for comparison.
+///
+typedef struct {
+    BRBenchHash hash;
+    UInt256 key;
+    uint8_t iv[16];
+    int hardware;
+} BRBenchAES;
+
+static BRBenchmarkState
+benchAESSetup (size_t size) {
+    BRBenchAES *bench = calloc (1, sizeof (BRBenchAES));
+    BRBenchHash *hash = benchHashSetup (size);
+
+    bench->hash = *hash;
+    free (hash);
+
+    uint64_t seed = 0xae5;
+    for (size_t index = 0; index < sizeof (bench->key.u8); index++)
+        bench->key.u8[index] = (uint8_t) benchmarkRandom (&seed);
+    for (size_t index = 0; index < sizeof (bench->iv); index++)
+        bench->iv[index] = (uint8_t) benchmarkRandom (&seed);
+
+    bench->hardware = BRAESSetHardwareEnabled (1);
+    return bench;
+}
+
+static BRBenchmarkState
+benchAESPortableSetup (size_t size) {
+    BRBenchAES *bench = benchAESSetup (size);
+    BRAESSetHardwareEnabled (0);
+    return bench;
+}
+
+static void
+benchAESTeardown (BRBenchmarkState state) {
+    BRBenchAES *bench = state;
+    BRAESSetHardwareEnabled (bench->hardware);
+    free (bench->hash.bytes);
+    free (bench);
+}
+
+static size_t
+benchAESCTRRun (BRBenchmarkState state) {
+    BRBenchAES *bench = state;
+    BRAESCTR (bench->hash.bytes, &bench->key, sizeof (bench->key), bench->iv, bench->hash.bytes, bench->hash.count);
+    return bench->hash.count;
+}
+
+static size_t
+benchAESECBRun (BRBenchmarkState state) {
+    BRBenchAES *bench = state;
+    for (size_t index = 0; index < BENCH_AES_ECB_BLOCKS; index++)
+        BRAESECBEncrypt (bench->hash.bytes, &bench->key, sizeof (bench->key));
+    return 16 * BENCH_AES_ECB_BLOCKS;
+}
+
+// MARK: - ChaCha20-Poly1305
+
+///
+/// ChaCha20-Poly1305 as BRCryptoCipher, and pigeon messages through ECIES, use it: decrypting an
+/// AEAD message; also the ChaCha20 cipher and the Poly1305 MAC on their own.  The 'portable'
+/// benchmarks disable the SIMD vector and 64-bit code, for comparison.
+///
+typedef struct {
+    BRBenchHash hash;
+    UInt256 key;
+    uint8_t nonce[12];
+    uint8_t *cipher;
+    uint8_t *plain;
+    int vector;
+} BRBenchChacha;
+
+static BRBenchmarkState
+benchChachaSetup (size_t size) {
+    BRBenchChacha *bench = calloc (1, sizeof (BRBenchChacha));
+    BRBenchHash *hash = benchHashSetup (size);
+
+    bench->hash = *hash;
+    free (hash);
+
+    uint64_t seed = 0xcac4a;
+    for (size_t index = 0; index < sizeof (bench->key.u8); index++)
+        bench->key.u8[index] = (uint8_t) benchmarkRandom (&seed);
+    for (size_t index = 0; index < sizeof (bench->nonce); index++)
+        bench->nonce[index] = (uint8_t) benchmarkRandom (&seed);
+
+    bench->vector = BRChacha20Poly1305SetVectorEnabled (1);
+    bench->cipher = malloc (size + 16);
+    bench->plain  = malloc (size);
+    BRChacha20Poly1305AEADEncrypt (bench->cipher, size + 16, &bench->key, bench->nonce,
+                                   bench->hash.bytes, size, NULL, 0);
+    return bench;
+}
+
+static BRBenchmarkState
+benchChachaPortableSetup (size_t size) {
+    BRBenchChacha *bench = benchChachaSetup (size);
+    BRChacha20Poly1305SetVectorEnabled (0);
+    return bench;
+}
+
+static void
+benchChachaTeardown (BRBenchmarkState state) {
+    BRBenchChacha *bench = state;
+    BRChacha20Poly1305SetVectorEnabled (bench->vector);
+    free (bench->plain);
+    free (bench->cipher);
+    free (bench->hash.bytes);
+    free (bench);
+}
+
+static size_t
+benchChachaCipherRun (BRBenchmarkState state) {
+    BRBenchChacha *bench = state;
+    BRChacha20 (bench->hash.bytes, &bench->key, &bench->nonce[4], bench->hash.bytes, bench->hash.count, 1);
+    return bench->hash.count;
+}
+
+static size_t
+benchChachaMACRun (BRBenchmarkState state) {
+    BRBenchChacha *bench = state;
+    uint8_t mac[16];
+    BRPoly1305 (mac, &bench->key, bench->hash.bytes, bench->hash.count);
+    return bench->hash.count;
+}
+
+static size_t
+benchChachaDecryptRun (BRBenchmarkState state) {
+    BRBenchChacha *bench = state;
+    size_t count = BRChacha20Poly1305AEADDecrypt (bench->plain, bench->hash.count, &bench->key, bench->nonce,
+                                                  bench->cipher, bench->hash.count + 16, NULL, 0);
+    assert (count == bench->hash.count);
+    return count;
+}
+
+// MARK: - Scrypt
+
+///
+/// scrypt with BIP38's parameters - N = 16384, r = 8, p = 8 - as each BIP38 key import runs it.
+/// The 'portable' benchmark disables the SIMD vector code, for comparison.
+///
+typedef struct {
+    int vector;
+} BRBenchScrypt;
+
+static BRBenchmarkState
+benchScryptSetup (size_t size) {
+    BRBenchScrypt *bench = calloc (1, sizeof (BRBenchScrypt));
+    bench->vector = BRScryptSetVectorEnabled (1);
+    return bench;
+}
+
+static BRBenchmarkState
+benchScryptPortableSetup (size_t size) {
+    BRBenchScrypt *bench = benchScryptSetup (size);
+    BRScryptSetVectorEnabled (0);
+    return bench;
+}
+
+static void
+benchScryptTeardown (BRBenchmarkState state) {
+    BRBenchScrypt *bench = state;
+    BRScryptSetVectorEnabled (bench->vector);
+    free (bench);
+}
+
+static size_t
+benchScryptRun (BRBenchmarkState state) {
+    UInt512 dk;
+    BRScrypt (&dk, sizeof (dk), "TestingOneTwoThree", 18, "salt", 4, 16384, 8, 8);
+    return 0;
+}
+
+// MARK: - File Service
+
+#define BENCH_FILE_SERVICE_TYPE             "entities"
+#define BENCH_FILE_SERVICE_ENTITY_SIZE      (256)   // About the size of a transaction
+
+typedef struct {
+    UInt256 identifier;
+    uint8_t bytes[BENCH_FILE_SERVICE_ENTITY_SIZE - sizeof (UInt256)];
+} BRBenchEntity;
+
+static UInt256
+benchEntityIdentifier (BRFileServiceContext context,
+                       BRFileService fs,
+                       const void *entity) {
+    return ((const BRBenchEntity *) entity)->identifier;
+}
+
+static void *
+benchEntityReader (BRFileServiceContext context,
+                   BRFileService fs,
+                   uint8_t *bytes,
+                   uint32_t bytesCount) {
+    if (sizeof (BRBenchEntity) != bytesCount) return NULL;
+
+    BRBenchEntity *entity = malloc (sizeof (BRBenchEntity));
+    memcpy (entity, bytes, bytesCount);
+    return entity;
+}
+
+static uint8_t *
+benchEntityWriter (BRFileServiceContext context,
+                   BRFileService fs,
+                   const void* entity,
+                   uint32_t *bytesCount) {
+    uint8_t *bytes = malloc (sizeof (BRBenchEntity));
+    memcpy (bytes, entity, sizeof (BRBenchEntity));
+    *bytesCount = sizeof (BRBenchEntity);
+    return bytes;
+}
+
+typedef struct {
+    char path[64];
+    BRFileService fs;
+    size_t count;
+    BRBenchEntity *entities;
+    BRSet *loaded;
+    int saved;
+} BRBenchFileService;
+
+static BRBenchmarkState
+benchFileServiceSetup (size_t size) {
+    BRBenchFileService *bench = calloc (1, sizeof (BRBenchFileService));
+
+    strcpy (bench->path, "/tmp/walletkit-bench-XXXXXX");
+    char *path = mkdtemp (bench->path);
+    assert (NULL != path);
+    (void) path;
+
+    bench->fs = fileServiceCreate (bench->path, "btc", "mainnet", NULL, NULL);
+    assert (NULL != bench->fs);
+
+    fileServiceDefineType (bench->fs, BENCH_FILE_SERVICE_TYPE, 0, NULL,
+                           benchEntityIdentifier,
+                           benchEntityReader,
+                           benchEntityWriter);
+    fileServiceDefineCurrentVersion (bench->fs, BENCH_FILE_SERVICE_TYPE, 0);
+
+    bench->count = size;
+    bench->entities = calloc (size, sizeof (BRBenchEntity));
+
+    uint64_t seed = 0x5eed;
+    for (size_t index = 0; index < size; index++) {
+        BRBenchEntity *entity = &bench->entities[index];
+        for (size_t word = 0; word < 4; word++)
+            entity->identifier.u64[word] = benchmarkRandom (&seed);
+        for (size_t byte = 0; byte < sizeof (entity->bytes); byte++)
+            entity->bytes[byte] = (uint8_t) benchmarkRandom (&seed);
+    }
+
+    bench->loaded = BRSetNew (benchUInt256Hash, benchUInt256Eq, size);
+    return bench;
+}
+
+static void
+benchEntityRelease (void *ignore, void *entity) {
+    free (entity);
+}
+
+static void
+benchFileServiceReleaseLoaded (BRBenchFileService *bench) {
+    BRSetApply (bench->loaded, NULL, benchEntityRelease);
+    BRSetClear (bench->loaded);
+}
+
+static void
+benchFileServiceTeardown (BRBenchmarkState state) {
+    BRBenchFileService *bench = state;
+
+    benchFileServiceReleaseLoaded (bench);
+    BRSetFree (bench->loaded);
+
+    fileServiceRelease (bench->fs);
+    fileServiceWipe (bench->path, "btc", "mainnet");
+    rmdir (bench->path);
+
+    free (bench->entities);
+    free (bench);
+}
+
+static void
+benchFileServiceSavePrepare (BRBenchmarkState state) {
+    BRBenchFileService *bench = state;
+    fileServiceClear (bench->fs, BENCH_FILE_SERVICE_TYPE);
+}
+
+// One entity at a time, as the wallet managers save transactions
+static size_t
+benchFileServiceSaveRun (BRBenchmarkState state) {
+    BRBenchFileService *bench = state;
+    for (size_t index = 0; index < bench->count; index++)
+        fileServiceSave (bench->fs, BENCH_FILE_SERVICE_TYPE, &bench->entities[index]);
+    return bench->count * sizeof (BRBenchEntity);
+}
+
+static size_t
+benchFileServiceReplaceRun (BRBenchmarkState state) {
+    BRBenchFileService *bench = state;
+    const void *entities[bench->count];
+    for (size_t index = 0; index < bench->count; index++)
+        entities[index] = &bench->entities[index];
+
+    fileServiceReplace (bench->fs, BENCH_FILE_SERVICE_TYPE, entities, bench->count);
+    return bench->count * sizeof (BRBenchEntity);
+}
+
+static void
+benchFileServiceLoadPrepare (BRBenchmarkState state) {
+    BRBenchFileService *bench = state;
+    benchFileServiceReleaseLoaded (bench);
+
+    // Save the entities, once, to be loaded by every run
+    if (!bench->saved) benchFileServiceReplaceRun (state);
+    bench->saved = 1;
+}
+
+static size_t
+benchFileServiceLoadRun (BRBenchmarkState state) {
+    BRBenchFileService *bench = state;
+    int success = fileServiceLoad (bench->fs, bench->loaded, BENCH_FILE_SERVICE_TYPE, 0);
+    assert (success && bench->count == BRSetCount (bench->loaded));
+    (void) success;
+    return bench->count * sizeof (BRBenchEntity);
+}
+
+// MARK: - Event Queue
+
+typedef struct {
+    struct BREventRecord base;
+    uint64_t value;
+} BRBenchEvent;
+
+static void
+benchEventDispatcher (BREventHandler handler,
+                      BREvent *event);
+
+static BREventType benchEventType = {
+    "Bench Event",
+    sizeof (BRBenchEvent),
+    benchEventDispatcher,
+    NULL
+};
+
+static const BREventType *benchEventTypes[] = {
+    &benchEventType
+};
+
+typedef struct {
+    size_t count;
+    BREventQueue queue;
+
+    BREventHandler handler;
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    size_t dispatched;
+} BRBenchEventQueue;
+
+// Only one handler runs at a time; its dispatcher finds it here.
+static BRBenchEventQueue *benchEventQueueCurrent = NULL;
+
+static void
+benchEventDispatcher (BREventHandler handler,
+                      BREvent *event) {
+    BRBenchEventQueue *bench = benchEventQueueCurrent;
+
+    pthread_mutex_lock (&bench->lock);
+    if (++bench->dispatched == bench->count)
+        pthread_cond_signal (&bench->cond);
+    pthread_mutex_unlock (&bench->lock);
+}
+
+static BRBenchmarkState
+benchEventQueueSetup (size_t size) {
+    BRBenchEventQueue *bench = calloc (1, sizeof (BRBenchEventQueue));
+    bench->count = size;
+    bench->queue = eventQueueCreate (sizeof (BRBenchEvent));
+
+    bench->handler = eventHandlerCreate ("Core Bench Event", benchEventTypes, 1, NULL);
+    pthread_mutex_init (&bench->lock, NULL);
+    pthread_cond_init  (&bench->cond, NULL);
+
+    benchEventQueueCurrent = bench;
+    eventHandlerStart (bench->handler);
+    return bench;
+}
+
+static void
+benchEventQueueTeardown (BRBenchmarkState state) {
+    BRBenchEventQueue *bench = state;
+
+    eventHandlerStop (bench->handler);
+    eventHandlerDestroy (bench->handler);
+    benchEventQueueCurrent = NULL;
+
+    pthread_cond_destroy  (&bench->cond);
+    pthread_mutex_destroy (&bench->lock);
+
+    eventQueueDestroy (bench->queue);
+    free (bench);
+}
+
+// Enqueue then dequeue, on one thread
+static size_t
+benchEventQueueRun (BRBenchmarkState state) {
+    BRBenchEventQueue *bench = state;
+    BRBenchEvent event = { { NULL, &benchEventType }, 0 };
+
+    for (size_t index = 0; index < bench->count; index++) {
+        event.value = index;
+        eventQueueEnqueueTail (bench->queue, (BREvent *) &event);
+    }
+
+    for (size_t index = 0; index < bench->count; index++)
+        eventQueueDequeue (bench->queue, (BREvent *) &event);
+
+    return 0;
+}
+
+static void
+benchEventHandlerPrepare (BRBenchmarkState state) {
+    BRBenchEventQueue *bench = state;
+    bench->dispatched = 0;
+}
+
+// Signal from this thread; dispatch on the handler's thread
+static size_t
+benchEventHandlerRun (BRBenchmarkState state) {
+    BRBenchEventQueue *bench = state;
+    BRBenchEvent event = { { NULL, &benchEventType }, 0 };
+
+    for (size_t index = 0; index < bench->count; index++) {
+        event.value = index;
+        eventHandlerSignalEvent (bench->handler, (BREvent *) &event);
+    }
+
+    pthread_mutex_lock (&bench->lock);
+    while (bench->dispatched < bench->count)
+        pthread_cond_wait (&bench->cond, &bench->lock);
+    pthread_mutex_unlock (&bench->lock);
+
+    return 0;
+}
+
+// MARK: - Benchmarks
+
+static const BRBenchmark benchmarksSupport[] = {
+    { "support.set.add",                100000,  100000, 0, benchSetSetup, NULL, benchSetAddRun, benchSetTeardown },
+    { "support.set.get",                100000,  100000, 0, benchSetSetup, NULL, benchSetGetRun, benchSetTeardown },
+    { "support.set.remove",             100000,  100000, 0, benchSetSetup, benchSetRemovePrepare, benchSetRemoveRun, benchSetTeardown },
+
+    { "support.hash.sha256",                64,       1, 0, benchHashSetup, NULL, benchHashSHA256Run,    benchHashTeardown },
+    { "support.hash.sha256",           1 << 20,       1, 0, benchHashSetup, NULL, benchHashSHA256Run,    benchHashTeardown },
+    { "support.hash.keccak256",             64,       1, 0, benchHashSetup, NULL, benchHashKeccak256Run, benchHashTeardown },
+    { "support.hash.keccak256",        1 << 20,       1, 0, benchHashSetup, NULL, benchHashKeccak256Run, benchHashTeardown },
+
+    { "support.aes.ctr",                  1024,       1, 0, benchAESSetup,         NULL, benchAESCTRRun, benchAESTeardown },
+    { "support.aes.ctr",               1 << 20,       1, 0, benchAESSetup,         NULL, benchAESCTRRun, benchAESTeardown },
+    { "support.aes.ctrPortable",          1024,       1, 0, benchAESPortableSetup, NULL, benchAESCTRRun, benchAESTeardown },
+    { "support.aes.ctrPortable",       1 << 20,       1, 0, benchAESPortableSetup, NULL, benchAESCTRRun, benchAESTeardown },
+    { "support.aes.ecb",                    16, BENCH_AES_ECB_BLOCKS, 0, benchAESSetup,         NULL, benchAESECBRun, benchAESTeardown },
+    { "support.aes.ecbPortable",            16, BENCH_AES_ECB_BLOCKS, 0, benchAESPortableSetup, NULL, benchAESECBRun, benchAESTeardown },
+
+    { "support.chacha20.cipher",                  1 << 20, 1, 0, benchChachaSetup,         NULL, benchChachaCipherRun,  benchChachaTeardown },
+    { "support.chacha20.cipherPortable",          1 << 20, 1, 0, benchChachaPortableSetup, NULL, benchChachaCipherRun,  benchChachaTeardown },
+    { "support.poly1305.mac",                     1 << 20, 1, 0, benchChachaSetup,         NULL, benchChachaMACRun,     benchChachaTeardown },
+    { "support.poly1305.macPortable",             1 << 20, 1, 0, benchChachaPortableSetup, NULL, benchChachaMACRun,     benchChachaTeardown },
+    { "support.chacha20poly1305.decrypt",            1024, 1, 0, benchChachaSetup,         NULL, benchChachaDecryptRun, benchChachaTeardown },
+    { "support.chacha20poly1305.decrypt",         1 << 20, 1, 0, benchChachaSetup,         NULL, benchChachaDecryptRun, benchChachaTeardown },
+    { "support.chacha20poly1305.decryptPortable",    1024, 1, 0, benchChachaPortableSetup, NULL, benchChachaDecryptRun, benchChachaTeardown },
+    { "support.chacha20poly1305.decryptPortable", 1 << 20, 1, 0, benchChachaPortableSetup, NULL, benchChachaDecryptRun, benchChachaTeardown },
+
+    { "support.scrypt.bip38",            16384,       1, 5, benchScryptSetup,         NULL, benchScryptRun, benchScryptTeardown },
+    { "support.scrypt.bip38Portable",    16384,       1, 5, benchScryptPortableSetup, NULL, benchScryptRun, benchScryptTeardown },
+
+    { "support.fileService.save",         1000,    1000, 5, benchFileServiceSetup, benchFileServiceSavePrepare, benchFileServiceSaveRun,    benchFileServiceTeardown },
+    { "support.fileService.replace",      1000,    1000, 5, benchFileServiceSetup, NULL,                        benchFileServiceReplaceRun, benchFileServiceTeardown },
+    { "support.fileService.load",         1000,    1000, 0, benchFileServiceSetup, benchFileServiceLoadPrepare, benchFileServiceLoadRun,    benchFileServiceTeardown },
+
+    { "support.event.queue",             10000,   10000, 0, benchEventQueueSetup, NULL,                     benchEventQueueRun,   benchEventQueueTeardown },
+    { "support.event.handler",           10000,   10000, 0, benchEventQueueSetup, benchEventHandlerPrepare, benchEventHandlerRun, benchEventQueueTeardown },
+};
+
+extern size_t
+benchmarksGetSupport (const BRBenchmark **benchmarks) {
+    *benchmarks = benchmarksSupport;
+    return sizeof (benchmarksSupport) / sizeof (BRBenchmark);
+}
@@ -10,11 +10,17 @@
 //
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
 #include <unistd.h>
 #include "support/BROSCompat.h"
 #include "support/BRBIP39WordsEn.h"
 #include "ethereum/BREthereum.h"
+#include "BRCryptoAccount.h"
+#include "BRCryptoNetwork.h"
 #include "test.h"  // runSyncTest
+#include "BRBenchmark.h"
 
 extern BREthereumClient
 runEWM_createClient (void);
@@ -80,10 +86,86 @@ runSyncMany (BREthereumNetwork newtork,
 //    alarmClockDestroy(alarmClock);
 }
 
+// Print the phases of creating a wallet manager on each builtin network
+static void
+runStartupProfile (const char *paperKey,
+                   const char *path) {
+    BRCryptoAccount account = cryptoAccountCreate (paperKey, 1539330275, "perf");
+
+    size_t networksCount = 0;
+    BRCryptoNetwork *networks = cryptoNetworkInstallBuiltins (&networksCount);
+
+    for (size_t index = 0; index < networksCount; index++) {
+        runCryptoWalletManagerStartupProfile (account,
+                                              networks[index],
+                                              cryptoNetworkGetDefaultSyncMode (networks[index]),
+                                              cryptoNetworkGetDefaultAddressScheme (networks[index]),
+                                              path);
+        cryptoNetworkGive (networks[index]);
+    }
+
+    free (networks);
+    cryptoAccountGive (account);
+}
+
+// Run the offline benchmarks:
+//   WalletKitCorePerf bench [--warmup N] [--iterations N] [--output FILE] [FILTER]
+static int
+runBenchmarks (int argc, const char * argv[]) {
+    BRBenchmarkOptions options = BR_BENCHMARK_OPTIONS_DEFAULT;
+    const char *outputPath = NULL;
+
+    for (int index = 0; index < argc; index++) {
+        if      (0 == strcmp (argv[index], "--warmup")     && index + 1 < argc) options.warmup     = (size_t) atol (argv[++index]);
+        else if (0 == strcmp (argv[index], "--iterations") && index + 1 < argc) options.iterations = (size_t) atol (argv[++index]);
+        else if (0 == strcmp (argv[index], "--output")     && index + 1 < argc) outputPath         = argv[++index];
+        else options.filter = argv[index];
+    }
+
+    if (NULL != outputPath) {
+        options.output = fopen (outputPath, "w");
+        if (NULL == options.output) { perror (outputPath); return 1; }
+    }
+
+    size_t (*getters[]) (const BRBenchmark **) = {
+        benchmarksGetBitcoin,
+        benchmarksGetEthereum,
+        benchmarksGetSupport
+    };
+
+    // Write a single JSON document, so concatenate the tables
+    size_t benchmarksCount = 0;
+    BRBenchmark benchmarks[64];
+    for (size_t index = 0; index < sizeof (getters) / sizeof (getters[0]); index++) {
+        const BRBenchmark *some;
+        size_t someCount = getters[index] (&some);
+        assert (benchmarksCount + someCount <= sizeof (benchmarks) / sizeof (BRBenchmark));
+
+        memcpy (&benchmarks[benchmarksCount], some, someCount * sizeof (BRBenchmark));
+        benchmarksCount += someCount;
+    }
+
+    size_t count = benchmarksRun (benchmarks, benchmarksCount, options);
+
+    if (NULL != outputPath) fclose (options.output);
+    return (0 == count ? 1 : 0);
+}
 
 int main(int argc, const char * argv[]) {
     BRCryptoSyncMode mode = CRYPTO_SYNC_MODE_API_WITH_P2P_SEND;
 
+    // `WalletKitCorePerf profile [paperKey]` prints where wallet manager creation spends time.
+    if (argc > 1 && 0 == strcmp (argv[1], "profile")) {
+        runStartupProfile ((argc > 2
+                            ? argv[2]
+                            : "ginger settle marine tissue robot crane night number ramp coast roast critic"),
+                           "core");
+        return 0;
+    }
+
+    if (argc > 1 && 0 == strcmp (argv[1], "bench"))
+        return runBenchmarks (argc - 2, &argv[2]);
+
     const char *paperKey = (argc > 1 ? argv[1] : "0xa9de3dbd7d561e67527bc1ecb025c59d53b9f7ef");
     BREthereumAccount account = ethAccountCreate (paperKey);
     BREthereumTimestamp timestamp = 1539330275; // ETHEREUM_TIMESTAMP_UNKNOWN;
@@ -139,6 +139,26 @@ final class WalletKitCoreTests: XCTestCase {
         }
     }
 
+    func testCryptoWalletManagerCreateMultiple() {
+        let account = cryptoAccountCreate(paperKey, 0, uids)
+        defer { cryptoAccountGive (account) }
+
+        storagePathClear();
+
+        // BTC and BCH share the account's derived addresses
+        var networks: [BRCryptoNetwork?] = [createBitcoinNetwork (isMainnet: true, blockHeight: 500_000),
+                                            createBitcoinCashNetwork (isMainnet: true, blockHeight: 500_000),
+                                            createBitcoinNetwork (isMainnet: false, blockHeight: 1_500_000),
+                                            createEthereumNetwork (isMainnet: true, blockHeight: 8_000_000)]
+        defer { networks.forEach { cryptoNetworkGive ($0) } }
+
+        let modes   = [CRYPTO_SYNC_MODE_API_ONLY, CRYPTO_SYNC_MODE_API_ONLY, CRYPTO_SYNC_MODE_API_ONLY, CRYPTO_SYNC_MODE_API_ONLY]
+        let schemes = [CRYPTO_ADDRESS_SCHEME_BTC_LEGACY, CRYPTO_ADDRESS_SCHEME_BTC_LEGACY, CRYPTO_ADDRESS_SCHEME_BTC_LEGACY, CRYPTO_ADDRESS_SCHEME_ETH_DEFAULT]
+
+        let success = runCryptoWalletManagerCreateMultipleTest (account, &networks, modes, schemes, networks.count, storagePath)
+        XCTAssertEqual(CRYPTO_TRUE, success)
+    }
+
     // MARK: - Ethereum
 
     func testRLPETH () {
@@ -288,6 +308,18 @@ final class WalletKitCoreTests: XCTestCase {
         }
     }
 
+    func XtestPerformanceBitcoinHeaderParse() {
+        self.measure {
+            BRRunPerfTestsHeaderParse (10);
+        }
+    }
+
+    func XtestPerformanceHederaSerialize() {
+        self.measure {
+            runHederaPerfTestsSerialize (10000);
+        }
+    }
+
     private func createBitcoinNetwork(isMainnet: Bool, blockHeight: UInt64) -> BRCryptoNetwork {
         let uids = "bitcoin-" + (isMainnet ? "mainnet" : "testnet")
         let network = cryptoNetworkFindBuiltin(uids);
@@ -397,6 +429,7 @@ final class WalletKitCoreTests: XCTestCase {
         ("testCryptoBTC",       testCryptoWithAccountAndNetworkBTC),
         ("testCryptoBCH",       testCryptoWithAccountAndNetworkBCH),
         ("testCryptoETH",       testCryptoWithAccountAndNetworkETH),
+        ("testCryptoMultiple",  testCryptoWalletManagerCreateMultiple),
 
         // Ethereum
         ("testRLP",             testRLPETH),
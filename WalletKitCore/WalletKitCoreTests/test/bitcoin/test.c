@@ -38,6 +38,7 @@
 #include "bcash/BRBCashAddr.h"
 
 #include "bitcoin/BRBloomFilter.h"
+#include "bitcoin/BRCompactFilter.h"
 #include "bitcoin/BRMerkleBlock.h"
 #include "bitcoin/BRWallet.h"
 #include "bitcoin/BRBIP38Key.h"
@@ -47,6 +48,7 @@
 #include "bitcoin/BRPaymentProtocol.h"
 #include "bitcoin/BRTransaction.h"
 #include "bitcoin/BRWalletManager.h"
+#include "bitcoin/BRSyncManager.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -1138,6 +1140,36 @@ int BRAuthEncryptTests()
     if (len != sizeof(cipher2) - 1 || memcmp(cipher2, out2, len) != 0)
         r = 0, fprintf(stderr, "***FAILED*** %s: BRChacha20Poly1305AEADEncrypt() cipher test 2\n", __func__);
 
+    // the simd vector code, when available, and the portable code agree - over the 8 and 4 block paths, the remaining
+    // single blocks, a partial block, and with the block counter carrying out of its low 32 bits
+    uint8_t data[1000 + 16], out3[1000 + 16], out4[1000 + 16], mac1[16], mac2[16];
+    const size_t dataLens[] = { 1000, 999, 512, 256, 255, 64, 15 };
+    int vector = BRChacha20Poly1305SetVectorEnabled(1);
+
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i*7);
+
+    for (size_t i = 0; i < sizeof(dataLens)/sizeof(*dataLens); i++) {
+        BRChacha20Poly1305SetVectorEnabled(0);
+        BRChacha20(out3, key2, nonce2 + 4, data, dataLens[i], 0xfffffffdULL);
+        BRPoly1305(mac1, key2, data, dataLens[i]);
+        BRChacha20Poly1305SetVectorEnabled(1);
+        BRChacha20(out4, key2, nonce2 + 4, data, dataLens[i], 0xfffffffdULL);
+        BRPoly1305(mac2, key2, data, dataLens[i]);
+        if (memcmp(out3, out4, dataLens[i]) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRChacha20() vector test %zu\n", __func__, dataLens[i]);
+        if (memcmp(mac1, mac2, sizeof(mac1)) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRPoly1305() vector test %zu\n", __func__, dataLens[i]);
+
+        BRChacha20Poly1305SetVectorEnabled(0);
+        len = BRChacha20Poly1305AEADEncrypt(out3, sizeof(out3), key1, nonce1, data, dataLens[i], ad1, sizeof(ad1) - 1);
+        BRChacha20Poly1305SetVectorEnabled(1);
+        if (len != BRChacha20Poly1305AEADDecrypt(out4, sizeof(out4), key1, nonce1, out3, len, ad1, sizeof(ad1) - 1) + 16 ||
+            memcmp(out4, data, dataLens[i]) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRChacha20Poly1305AEADDecrypt() vector test %zu\n", __func__,
+                           dataLens[i]);
+    }
+
+    BRChacha20Poly1305SetVectorEnabled(vector);
     return r;
 }
 
@@ -1201,6 +1233,42 @@ int BRAesTests()
     BRAESCTR(buf, &key3, 32, iv, in3, 64);
     if (memcmp(buf, plain, 64) != 0) r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAESCTR() test 3", __func__);
     
+    // the aes instructions, when the cpu has them, and the portable software agree - over the multi-block, single block
+    // and partial block paths, and with the counter carrying out of its low 64 bits
+    uint8_t data[1000], out1[1000], out2[1000], iv2[16];
+    const size_t dataLens[] = { 1000, 999, 256, 128, 15 };
+    int hardware = BRAESSetHardwareEnabled(1);
+
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i*7);
+    memset(iv2, 0xff, sizeof(iv2));
+    iv2[0] = 0;
+
+    for (size_t keyLen = 16; keyLen <= 32; keyLen += 8) {
+        for (size_t i = 0; i < sizeof(dataLens)/sizeof(*dataLens); i++) {
+            BRAESSetHardwareEnabled(0);
+            BRAESCTR(out1, &key3, keyLen, iv2, data, dataLens[i]);
+            BRAESSetHardwareEnabled(1);
+            BRAESCTR(out2, &key3, keyLen, iv2, data, dataLens[i]);
+            if (memcmp(out1, out2, dataLens[i]) != 0)
+                r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAESCTR() hardware test %zu", __func__, keyLen);
+        }
+
+        memcpy(out1, data, 16);
+        memcpy(out2, data, 16);
+        BRAESSetHardwareEnabled(0);
+        BRAESECBEncrypt(out1, &key3, keyLen);
+        BRAESSetHardwareEnabled(1);
+        BRAESECBEncrypt(out2, &key3, keyLen);
+        if (memcmp(out1, out2, 16) != 0)
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAESECBEncrypt() hardware test %zu", __func__, keyLen);
+
+        BRAESECBDecrypt(out2, &key3, keyLen);
+        if (memcmp(out2, data, 16) != 0)
+            r = 0, fprintf(stderr, "\n***FAILED*** %s: BRAESECBDecrypt() hardware test %zu", __func__, keyLen);
+    }
+
+    BRAESSetHardwareEnabled(hardware);
+    
     if (! r) fprintf(stderr, "\n                                    ");
     return r;
 }
@@ -1656,6 +1724,34 @@ int BRBIP38KeyTests()
     
     printf("\n");
 
+    // scrypt: https://tools.ietf.org/html/rfc7914 - with the simd vector code, when available, and the portable code; p
+    // of 16 runs the two lane avx2 path, and p of 1 the single lane path
+    uint8_t dk[64], dk2[64];
+    int vector = BRScryptSetVectorEnabled(1);
+    
+    for (int i = 0; i < 2; i++) {
+        BRScryptSetVectorEnabled(i == 0);
+        BRScrypt(dk, sizeof(dk), "", 0, "", 0, 16, 1, 1);
+        if (memcmp(dk, "\x77\xd6\x57\x62\x38\x65\x7b\x20\x3b\x19\xca\x42\xc1\x8a\x04\x97\xf1\x6b\x48\x44\xe3\x07\x4a"
+                   "\xe8\xdf\xdf\xfa\x3f\xed\xe2\x14\x42\xfc\xd0\x06\x9d\xed\x09\x48\xf8\x32\x6a\x75\x3a\x0f\xc8\x1f"
+                   "\x17\xe8\xd3\xe0\xfb\x2e\x0d\x36\x28\xcf\x35\xe2\x0c\x38\xd1\x89\x06", sizeof(dk)) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRScrypt() test 1 vector %d\n", __func__, i == 0);
+        
+        BRScrypt(dk, sizeof(dk), "password", 8, "NaCl", 4, 1024, 8, 16);
+        if (memcmp(dk, "\xfd\xba\xbe\x1c\x9d\x34\x72\x00\x78\x56\xe7\x19\x0d\x01\xe9\xfe\x7c\x6a\xd7\xcb\xc8\x23\x78"
+                   "\x30\xe7\x73\x76\x63\x4b\x37\x31\x62\x2e\xaf\x30\xd9\x2e\x22\xa3\x88\x6f\xf1\x09\x27\x9d\x98\x30"
+                   "\xda\xc7\x27\xaf\xb9\x4a\x83\xee\x6d\x83\x60\xcb\xdf\xa2\xcc\x06\x40", sizeof(dk)) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRScrypt() test 2 vector %d\n", __func__, i == 0);
+    }
+    
+    // an odd p runs a lane pair, and then a single lane
+    BRScryptSetVectorEnabled(0);
+    BRScrypt(dk, sizeof(dk), "x", 1, "y", 1, 1024, 1, 3);
+    BRScryptSetVectorEnabled(1);
+    BRScrypt(dk2, sizeof(dk2), "x", 1, "y", 1, 1024, 1, 3);
+    if (memcmp(dk, dk2, sizeof(dk)) != 0) r = 0, fprintf(stderr, "***FAILED*** %s: BRScrypt() test 3\n", __func__);
+    BRScryptSetVectorEnabled(vector);
+
     // non EC multiplied, uncompressed
     if (! BRKeySetPrivKey(&key, BRMainNetParams->addrParams, "5KN7MzqK5wt2TP1fQCYyHBtDrXdJuXbUzm4A9rKAteGu3Qi5CVR") ||
         ! BRKeyBIP38Key(&key, bip38Key, sizeof(bip38Key), "TestingOneTwoThree", BRMainNetParams->addrParams) ||
@@ -1750,6 +1846,27 @@ int BRBIP38KeyTests()
     if (BRKeySetBIP38Key(&key, "6PRW5o9FLp4gJDDVqJQKJFTpMvdsSGJxMYHtHaQBF3ooa8mwD69bapcDQn", "foobar", BRMainNetParams->addrParams))
         r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38Key() test 10\n", __func__);
 
+    // batch, over two threads, with one incorrect password
+    const char *bip38Keys[] = { "6PRVWUbkzzsbcVac2qwfssoUJAN1Xhrg6bNk8J7Nzm5H7kxEbn2Nh2ZoGg",
+                                "6PYNKZ1EAgYgmQfmNVamxyXVWHzK5s6DGhwP4J5o44cvXdoY7sRzhtpUeo",
+                                "6PfLGnQs6VZnrNpmVKfjotbnQuaJK4KZoPFrAjx1JMJUa1Ft8gnf5WxfKd",
+                                "6PRW5o9FLp4gJDDVqJQKJFTpMvdsSGJxMYHtHaQBF3ooa8mwD69bapcDQn" },
+               *passphrases[] = { "TestingOneTwoThree", "TestingOneTwoThree", "Satoshi", "foobar" },
+               *privKeys[] = { "5KN7MzqK5wt2TP1fQCYyHBtDrXdJuXbUzm4A9rKAteGu3Qi5CVR",
+                               "L44B5gGEpqEDRS9vVPz7QT35jcBG2r3CZwSwQ4fCewXAhAhqGVpP",
+                               "5KJ51SgxWaAYR13zd9ReMhJpwrcX47xTJh2D3fGPG9CM8vkv5sH" };
+    BRKey keys[4];
+    int results[4];
+    
+    if (BRKeySetBIP38Keys(keys, results, bip38Keys, passphrases, 4, BRMainNetParams->addrParams, 2) != 3 || results[3])
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38Keys() test 1\n", __func__);
+    
+    for (size_t i = 0; i < 3; i++) {
+        if (! results[i] || ! BRKeyPrivKey(&keys[i], privKey, sizeof(privKey), BRMainNetParams->addrParams) ||
+            strncmp(privKey, privKeys[i], sizeof(privKey)) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRKeySetBIP38Keys() test 1 key %zu\n", __func__, i);
+    }
+    
     printf("                                    ");
     return r;
 }
@@ -2470,6 +2587,19 @@ int BRWalletTests()
     if (BRWalletAllAddrs(w, NULL, 0) != SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED + SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED + 1)
         r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletAllAddrs() test\n", __func__);
     
+    BRAddress allAddrs[BRWalletAllAddrs(w, NULL, 0)];
+    UInt160 allPKH[BRWalletAllPKH(w, NULL, 0)], pkh;
+    size_t allCount = BRWalletAllAddrs(w, allAddrs, sizeof(allAddrs)/sizeof(*allAddrs));
+    
+    if (BRWalletAllPKH(w, allPKH, sizeof(allPKH)/sizeof(*allPKH)) != allCount)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletAllPKH() test 1\n", __func__);
+    
+    for (size_t i = 0; i < allCount; i++) {
+        if (BRAddressHash160(&pkh, BRMainNetParams->addrParams, allAddrs[i].s) && UInt160Eq(pkh, allPKH[i])) continue;
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletAllPKH() test 2\n", __func__);
+        break;
+    }
+    
     UInt256 hash = tx->txHash;
 
     tx = BRWalletCreateTransaction(w, SATOSHIS*2, addr.s);
@@ -2546,6 +2676,45 @@ int BRWalletTests()
 
     BRTransactionFree(tx);
     BRWalletFree(w);
+
+    // batch registration: a new wallet has SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED external addresses; the first tx below
+    // pays to an address generated only once the second tx is registered
+    BRAddress batchAddrs[SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED + 5];
+    uint32_t batchIndexes[] = { SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED + 4, SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED - 5, 0 };
+    BRTransaction *batchTxs[4];
+
+    w = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+    BRWalletUnusedAddrs(w, batchAddrs, SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED + 5, SEQUENCE_EXTERNAL_CHAIN);
+    BRWalletFree(w);
+    w = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+
+    for (size_t i = 0; i < 4; i++) {
+        const char *batchAddr = (i < 3) ? batchAddrs[batchIndexes[i]].s : addr.s; // the last isn't a wallet tx
+        uint8_t script[BRAddressScriptPubKey(NULL, 0, BRMainNetParams->addrParams, batchAddr)];
+        size_t scriptLen = BRAddressScriptPubKey(script, sizeof(script), BRMainNetParams->addrParams, batchAddr);
+
+        batchTxs[i] = BRTransactionNew();
+        BRTransactionAddInput(batchTxs[i], inHash, (uint32_t)i, 1, inScript, inScriptLen, NULL, 0, NULL, 0,
+                              TXIN_SEQUENCE);
+        BRTransactionAddOutput(batchTxs[i], SATOSHIS, script, scriptLen);
+        BRTransactionSign(batchTxs[i], 0, &k, 1);
+        batchTxs[i]->blockHeight = (uint32_t)(100 - i);
+    }
+
+    if (BRWalletRegisterTransactions(w, batchTxs, 4) != 3)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransactions() test 1\n", __func__);
+
+    if (BRWalletBalance(w) != SATOSHIS*3 || BRWalletTransactions(w, NULL, 0) != 3)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransactions() test 2\n", __func__);
+
+    if (BRWalletTransactionForHash(w, batchTxs[3]->txHash) != NULL) // non-wallet tx remains the caller's
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransactions() test 3\n", __func__);
+
+    if (BRWalletRegisterTransactions(w, batchTxs, 3) != 0 || BRWalletBalance(w) != SATOSHIS*3) // adding the same tx twice
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletRegisterTransactions() test 4\n", __func__);
+
+    BRTransactionFree(batchTxs[3]);
+    BRWalletFree(w);
     
     amt = BRBitcoinAmount(50000, 50000);
     if (amt != SATOSHIS) r = 0, fprintf(stderr, "***FAILED*** %s: BRBitcoinAmount() test 1\n", __func__);
@@ -2562,6 +2731,277 @@ int BRWalletTests()
     return r;
 }
 
+typedef struct {
+    BRAddressParams addrParams;
+    BRMasterPubKey mpk;
+    BRWalletPKHCache *cache;
+    BRWallet *wallet;
+} BRWalletPKHCacheTestContext;
+
+static void *_BRWalletPKHCacheTestThread(void *info)
+{
+    BRWalletPKHCacheTestContext *context = info;
+
+    context->wallet = BRWalletNewWithPKHCache(context->addrParams, NULL, 0, context->mpk, context->cache);
+    return NULL;
+}
+
+int BRWalletPKHCacheTests()
+{
+    int r = 1;
+    UInt512 seed;
+
+    BRBIP39DeriveKey(&seed, "a random seed", NULL);
+
+    BRMasterPubKey mpk = BRBIP32MasterPubKey(&seed, sizeof(seed)),
+                   otherMpk = BRBIP32MasterPubKey(&seed, sizeof(seed)/2);
+    BRWallet *w = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+    BRWalletPKHCache *cache = BRWalletPKHCacheNew(mpk);
+    BRWalletPKHCacheTestContext contexts[4];
+    pthread_t threads[4];
+    size_t count = BRWalletAllPKH(w, NULL, 0);
+    UInt160 pkhs[count], cachedPKHs[count];
+
+    BRWalletAllPKH(w, pkhs, count);
+
+    // bitcoin and bitcoin cash wallets derive the same chains; create them concurrently through one cache
+    for (size_t i = 0; i < 4; i++) {
+        contexts[i] = (BRWalletPKHCacheTestContext) {
+            (i % 2 == 0) ? BRMainNetParams->addrParams : BRBCashParams->addrParams, mpk, cache, NULL
+        };
+        pthread_create(&threads[i], NULL, _BRWalletPKHCacheTestThread, &contexts[i]);
+    }
+
+    for (size_t i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+
+        if (! contexts[i].wallet || BRWalletAllPKH(contexts[i].wallet, NULL, 0) != count)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletNewWithPKHCache() test %zu\n", __func__, i);
+        else if (BRWalletAllPKH(contexts[i].wallet, cachedPKHs, count) != count ||
+                 memcmp(pkhs, cachedPKHs, sizeof(pkhs)) != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletAllPKH() test %zu\n", __func__, i);
+
+        if (contexts[i].wallet) BRWalletFree(contexts[i].wallet);
+    }
+
+    // a cache for another mpk is not used
+    BRWallet *other = BRWalletNewWithPKHCache(BRMainNetParams->addrParams, NULL, 0, otherMpk, cache);
+
+    if (BRWalletAllPKH(other, cachedPKHs, count) != count || memcmp(pkhs, cachedPKHs, sizeof(pkhs)) == 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRWalletNewWithPKHCache() other mpk test\n", __func__);
+
+    BRWalletFree(other);
+    BRWalletPKHCacheFree(cache);
+    BRWalletFree(w);
+    return r;
+}
+
+#define SYNC_TEST_USED_COUNT 700
+
+typedef struct {
+    int rid;
+    BRArrayOf(char *) addresses;
+} BRSyncManagerTestRequest;
+
+typedef struct {
+    BRArrayOf(BRSyncManagerTestRequest) requests;
+    size_t requestCount, started, stopped, completed;
+} BRSyncManagerTestClient;
+
+static void _testSyncEvent(void *context, BRSyncManager manager, BRSyncManagerEvent event)
+{
+    BRSyncManagerTestClient *client = context;
+
+    if (event.type == SYNC_MANAGER_SYNC_STARTED) client->started++;
+    if (event.type == SYNC_MANAGER_SYNC_STOPPED) client->stopped++;
+    if (event.type == SYNC_MANAGER_SYNC_STOPPED && event.u.syncStopped.reason.type == CRYPTO_SYNC_STOPPED_REASON_COMPLETE)
+        client->completed++;
+}
+
+static void _testSyncGetBlockNumber(BRSyncManagerClientContext context, BRSyncManager manager, int rid)
+{
+}
+
+// records the request; it is answered later, by the test, as a client would from its own thread
+static void _testSyncGetTransactions(BRSyncManagerClientContext context, BRSyncManager manager,
+                                     const char **addresses, size_t addressCount, uint64_t begBlockNumber,
+                                     uint64_t endBlockNumber, int rid)
+{
+    BRSyncManagerTestClient *client = context;
+    BRSyncManagerTestRequest request = { rid, NULL };
+
+    array_new(request.addresses, addressCount);
+    for (size_t i = 0; i < addressCount; i++) array_add(request.addresses, strdup(addresses[i]));
+    array_add(client->requests, request);
+    client->requestCount++;
+}
+
+static void _testSyncSubmitTransaction(BRSyncManagerClientContext context, BRSyncManager manager, uint8_t *transaction,
+                                       size_t transactionLength, UInt256 transactionHash, int rid)
+{
+}
+
+static void _BRSyncManagerTestRequestFree(BRSyncManagerTestRequest request)
+{
+    for (size_t i = 0; i < array_count(request.addresses); i++) free(request.addresses[i]);
+    array_free(request.addresses);
+}
+
+static int _BRSyncManagerTestRequestHas(BRSyncManagerTestRequest request, const char *address)
+{
+    for (size_t i = 0; i < array_count(request.addresses); i++) {
+        if (strcmp(request.addresses[i], address) == 0) return 1;
+    }
+
+    return 0;
+}
+
+// a signed transaction paying used[index], serialized as the client would announce it
+static size_t _BRSyncManagerTestTx(uint8_t *buf, size_t bufLen, const BRAddress used[], size_t index)
+{
+    uint8_t sig[72], script[BRAddressScriptPubKey(NULL, 0, BRMainNetParams->addrParams, used[index].s)];
+    size_t scriptLen = BRAddressScriptPubKey(script, sizeof(script), BRMainNetParams->addrParams, used[index].s);
+    UInt256 inHash = UINT256_ZERO;
+    BRTransaction *tx = BRTransactionNew();
+
+    memset(sig, 0, sizeof(sig));
+    sig[0] = sizeof(sig) - 1; // push of a placeholder signature
+    UInt32SetLE(&inHash, (uint32_t)index + 1);
+    BRTransactionAddInput(tx, inHash, 0, 1, NULL, 0, sig, sizeof(sig), sig, 0, TXIN_SEQUENCE);
+    BRTransactionAddOutput(tx, SATOSHIS, script, scriptLen);
+
+    size_t len = BRTransactionSerialize(tx, buf, bufLen);
+
+    BRTransactionFree(tx);
+    return len;
+}
+
+// answers the oldest outstanding request: a transaction for each used address in it, then done
+static void _BRSyncManagerTestAnswer(BRSyncManager manager, BRSyncManagerTestClient *client, BRSet *usedSet,
+                                     const BRAddress used[])
+{
+    BRSyncManagerTestRequest request = client->requests[0];
+    uint8_t buf[1024];
+
+    array_rm(client->requests, 0);
+
+    for (size_t i = 0; i < array_count(request.addresses); i++) {
+        BRAddress address = BR_ADDRESS_NONE, *match;
+
+        strncpy(address.s, request.addresses[i], sizeof(address.s) - 1);
+        match = BRSetGet(usedSet, &address);
+        if (! match) continue;
+
+        size_t index = (size_t)(match - used), len = _BRSyncManagerTestTx(buf, sizeof(buf), used, index);
+
+        BRSyncManagerAnnounceGetTransactionsItem(manager, request.rid, buf, len, 1500000000 + index, 100 + index, 0);
+    }
+
+    BRSyncManagerAnnounceGetTransactionsDone(manager, request.rid, 1);
+    _BRSyncManagerTestRequestFree(request);
+}
+
+int BRSyncManagerTests()
+{
+    int r = 1;
+    UInt512 seed;
+
+    BRBIP39DeriveKey(&seed, "a random seed", NULL);
+
+    BRMasterPubKey mpk = BRBIP32MasterPubKey(&seed, sizeof(seed));
+    BRWallet *w = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk),
+             *ref = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, mpk);
+    BRAddress used[SYNC_TEST_USED_COUNT + 1], unused = BR_ADDRESS_NONE;
+    BRSet *usedSet = BRSetNew(BRAddressHash, BRAddressEq, SYNC_TEST_USED_COUNT);
+    BRSyncManagerTestClient client = { NULL, 0, 0, 0, 0 };
+    size_t maxOutstanding = 0, requestCount;
+    uint8_t buf[1024];
+
+    // the wallet has been used well past the gap limit, at the first SYNC_TEST_USED_COUNT receive addresses
+    BRWalletUnusedAddrs(ref, used, SYNC_TEST_USED_COUNT + 1, SEQUENCE_EXTERNAL_CHAIN);
+    for (size_t i = 0; i < SYNC_TEST_USED_COUNT; i++) BRSetAdd(usedSet, &used[i]);
+    BRWalletFree(ref);
+
+    array_new(client.requests, 4);
+
+    BRSyncManager manager =
+        BRSyncManagerNewForMode(CRYPTO_SYNC_MODE_API_ONLY, &client, _testSyncEvent, &client,
+                                (BRSyncManagerClientCallbacks) {
+                                    _testSyncGetBlockNumber, _testSyncGetTransactions, _testSyncSubmitTransaction
+                                }, BRMainNetParams, w, 0, 1000, 6, 1, NULL, 0, NULL, 0);
+
+    BRSyncManagerConnect(manager);
+    if (client.started != 1 || array_count(client.requests) == 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRSyncManagerConnect() test\n", __func__);
+
+    // a response for a request that isn't outstanding is ignored
+    requestCount = client.requestCount;
+    BRSyncManagerAnnounceGetTransactionsItem(manager, 10000, buf, _BRSyncManagerTestTx(buf, sizeof(buf), used, 0),
+                                             1500000000, 100, 0);
+    BRSyncManagerAnnounceGetTransactionsDone(manager, 10000, 1);
+    if (BRWalletTransactions(w, NULL, 0) != 0 || client.requestCount != requestCount || client.stopped != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: stale rid test\n", __func__);
+
+    // the scan completes only once every outstanding request has
+    while (array_count(client.requests) > 0) {
+        if (array_count(client.requests) > maxOutstanding) maxOutstanding = array_count(client.requests);
+        _BRSyncManagerTestAnswer(manager, &client, usedSet, used);
+
+        if (array_count(client.requests) > 0 && client.stopped != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: completed with requests outstanding\n", __func__);
+    }
+
+    if (client.stopped != 1 || client.completed != 1)
+        r = 0, fprintf(stderr, "***FAILED*** %s: scan completion test\n", __func__);
+
+    if (maxOutstanding < 2)
+        r = 0, fprintf(stderr, "***FAILED*** %s: overlapping requests test\n", __func__);
+
+    // every used address is discovered, in a handful of round trips rather than one per gap-limit window
+    BRWalletUnusedAddrs(w, &unused, 1, SEQUENCE_EXTERNAL_CHAIN);
+    if (BRWalletTransactions(w, NULL, 0) != SYNC_TEST_USED_COUNT || ! BRAddressEq(&unused, &used[SYNC_TEST_USED_COUNT]))
+        r = 0, fprintf(stderr, "***FAILED*** %s: gap limit discovery test\n", __func__);
+
+    if (client.requestCount > 10)
+        r = 0, fprintf(stderr, "***FAILED*** %s: discovery request count test\n", __func__);
+
+    // a late response, after the scan completed, is ignored as well
+    requestCount = client.requestCount;
+    BRSyncManagerAnnounceGetTransactionsDone(manager, 1, 1);
+    if (client.requestCount != requestCount || client.stopped != 1)
+        r = 0, fprintf(stderr, "***FAILED*** %s: late rid test\n", __func__);
+
+    // incremental scans query the unused and recently used addresses only, except every tenth queries all of them
+    size_t allCount = 2 * BRWalletAllAddrs(w, NULL, 0);
+
+    for (size_t tick = 1; tick <= 20; tick++) {
+        size_t addressCount = 0;
+        int hasUnused = 0, hasOld = 0;
+
+        BRSyncManagerTickTock(manager);
+
+        for (size_t i = 0; i < array_count(client.requests); i++) {
+            addressCount += array_count(client.requests[i].addresses);
+            hasUnused |= _BRSyncManagerTestRequestHas(client.requests[i], used[SYNC_TEST_USED_COUNT].s);
+            hasOld |= _BRSyncManagerTestRequestHas(client.requests[i], used[0].s);
+        }
+
+        if (! hasUnused || (tick % 10 == 0) != hasOld || (tick % 10 == 0) != (addressCount == allCount))
+            r = 0, fprintf(stderr, "***FAILED*** %s: incremental scan test %zu\n", __func__, tick);
+
+        while (array_count(client.requests) > 0) _BRSyncManagerTestAnswer(manager, &client, usedSet, used);
+    }
+
+    if (client.started != 1 || client.stopped != 1 || BRWalletTransactions(w, NULL, 0) != SYNC_TEST_USED_COUNT)
+        r = 0, fprintf(stderr, "***FAILED*** %s: incremental scan events test\n", __func__);
+
+    BRSyncManagerFree(manager);
+    array_free(client.requests);
+    BRSetFree(usedSet);
+    BRWalletFree(w);
+    return r;
+}
+
 int BRBloomFilterTests()
 {
     int r = 1;
@@ -2637,6 +3077,92 @@ int BRBloomFilterTests()
     return r;
 }
 
+int BRCompactFilterTests()
+{
+    int r = 1;
+    // BIP158 test vector for the testnet genesis block, the only element is the coinbase output script
+    UInt256 blockHash = UInt256Reverse(uint256("000000000933ea01ad0ee984209779baaec3ced90fa3f408719526f8d77f4943"));
+    uint8_t script[] = "\x41\x04\x67\x8a\xfd\xb0\xfe\x55\x48\x27\x19\x67\xf1\xa6\x71\x30\xb7\x10\x5c\xd6\xa8\x28\xe0\x39"
+    "\x09\xa6\x79\x62\xe0\xea\x1f\x61\xde\xb6\x49\xf6\xbc\x3f\x4c\xef\x38\xc4\xf3\x55\x04\xe5\x1e\xc1\x12\xde\x5c\x38"
+    "\x4d\xf7\xba\x0b\x8d\x57\x8a\x4c\x70\x2b\x6b\xf1\x1d\x5f\xac";
+    const uint8_t *elems[] = { script, script };
+    const size_t elemLens[] = { sizeof(script) - 1, sizeof(script) - 1 };
+    BRCompactFilter *f = BRCompactFilterNew(blockHash, elems, elemLens, 2), *f2;
+    char d1[] = "\x01\x9d\xfc\xa8";
+    uint8_t buf1[BRCompactFilterSerialize(f, NULL, 0)];
+    size_t len1 = BRCompactFilterSerialize(f, buf1, sizeof(buf1));
+    
+    if (f->elemCount != 1 || len1 != sizeof(d1) - 1 || memcmp(buf1, d1, len1) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterNew() test 1\n", __func__);
+
+    if (! UInt256Eq(BRCompactFilterHeader(BRCompactFilterHash(f), UINT256_ZERO),
+                    UInt256Reverse(uint256("21584579b7eb08997773e5aeff3a7f932700042d0ed2a6129012b7d7ae81b750"))))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterHeader() test 1\n", __func__);
+
+    f2 = BRCompactFilterParse(blockHash, CFILTER_TYPE_BASIC, buf1, len1);
+    
+    if (! f2 || ! BRCompactFilterContainsData(f2, script, sizeof(script) - 1))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterContainsData() test 1\n", __func__);
+    
+    // one byte short
+    if (f2 && BRCompactFilterContainsData(f2, script, sizeof(script) - 2))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterContainsData() test 2\n", __func__);
+
+    if (f2) BRCompactFilterFree(f2);
+    BRCompactFilterFree(f);
+    
+    // with 100 elements and a false positive rate of 1/784931, none of the other 100 should match
+    uint8_t data[200][sizeof(uint32_t)];
+    const uint8_t *elems2[200];
+    size_t elemLens2[200];
+    
+    for (uint32_t i = 0; i < 200; i++) {
+        UInt32SetLE(data[i], i*0x9e3779b9);
+        elems2[i] = data[i];
+        elemLens2[i] = sizeof(data[i]);
+    }
+    
+    f = BRCompactFilterNew(blockHash, elems2, elemLens2, 100);
+    
+    for (size_t i = 0; i < 200; i++) {
+        if (BRCompactFilterContainsData(f, data[i], sizeof(data[i])) == (i < 100)) continue;
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterContainsData() test 3\n", __func__);
+        break;
+    }
+    
+    if (! BRCompactFilterMatchAny(f, &elems2[99], &elemLens2[99], 101))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterMatchAny() test 1\n", __func__);
+
+    if (BRCompactFilterMatchAny(f, &elems2[100], &elemLens2[100], 100))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterMatchAny() test 2\n", __func__);
+
+    // the same 100 elements, each given twice and out of order, build the same filter
+    const uint8_t *elems3[200];
+    size_t elemLens3[200];
+    
+    for (size_t i = 0; i < 100; i++) {
+        elems3[i] = elems3[199 - i] = data[(i*37) % 100];
+        elemLens3[i] = elemLens3[199 - i] = sizeof(data[i]);
+    }
+    
+    f2 = BRCompactFilterNew(blockHash, elems3, elemLens3, 200);
+    
+    if (f2->elemCount != 100 || f2->length != f->length || memcmp(f2->data, f->data, f->length) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterNew() test 3\n", __func__);
+    
+    BRCompactFilterFree(f2);
+    BRCompactFilterFree(f);
+    
+    // empty filter
+    f = BRCompactFilterNew(blockHash, NULL, NULL, 0);
+    
+    if (f->length != 1 || f->data[0] != 0 || BRCompactFilterContainsData(f, script, sizeof(script) - 1))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRCompactFilterNew() test 2\n", __func__);
+
+    BRCompactFilterFree(f);
+    return r;
+}
+
 // true if block and otherBlock have equal data (in their respective structures).
 static int BRMerkleBlockEqual (const BRMerkleBlock *block1, const BRMerkleBlock *block2) {
     return 0 == memcmp(&block1->blockHash, &block2->blockHash, sizeof(UInt256))
@@ -2726,6 +3252,52 @@ int BRMerkleBlockTests()
 
     if (c) BRMerkleBlockFree(c);
 
+    // a batch of headers, checked on multiple threads, with an invalid proof-of-work at index 700
+    uint8_t headers[81*1000];
+    BRMerkleBlock *blocks[1000];
+    size_t n;
+    
+    for (size_t i = 0; i < 1000; i++) memcpy(&headers[81*i], block, 80), headers[81*i + 80] = 0;
+    headers[81*700 + 76] ^= 0x01; // nonce
+    n = BRMerkleBlockParseHeaders(blocks, headers, 81, 1000, (uint32_t)time(NULL), 4);
+    
+    if (n != 700 || ! blocks[699] || ! UInt256Eq(blocks[699]->blockHash, b->blockHash) || blocks[700] || blocks[999])
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRMerkleBlockParseHeaders() test\n", __func__);
+    
+    for (size_t i = 0; i < n; i++) BRMerkleBlockFree(blocks[i]);
+    
+    // build a partial merkle tree from a full list of tx hashes, as is done for blocks matched by compact filters
+    UInt256 hashes[5], row[5];
+    uint8_t matches[5] = { 0, 0, 1, 0, 1 };
+    size_t count;
+    
+    for (size_t i = 0; i < 5; i++) BRSHA256_2(&hashes[i], &i, sizeof(i)), row[i] = hashes[i];
+    
+    for (count = 5; count > 1; count = (count + 1)/2) { // compute the merkle root
+        for (size_t i = 0; i < count; i += 2) {
+            UInt256 pair[2] = { row[i], row[(i + 1 < count) ? i + 1 : i] };
+            
+            BRSHA256_2(&row[i/2], pair, sizeof(pair));
+        }
+    }
+    
+    c = BRMerkleBlockNew();
+    c->merkleRoot = row[0];
+    
+    if (! BRMerkleBlockSetTxMatches(c, hashes, matches, 5) || c->totalTx != 5)
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRMerkleBlockSetTxMatches() test 1\n", __func__);
+
+    if (BRMerkleBlockTxHashes(c, txHashes, 4) != 2 || ! UInt256Eq(txHashes[0], hashes[2]) ||
+        ! UInt256Eq(txHashes[1], hashes[4]))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRMerkleBlockSetTxMatches() test 2\n", __func__);
+
+    hashes[3] = hashes[2]; // wrong tx hash
+    
+    if (BRMerkleBlockSetTxMatches(c, hashes, matches, 5))
+        r = 0, fprintf(stderr, "***FAILED*** %s: BRMerkleBlockSetTxMatches() test 3\n", __func__);
+
+    BRMerkleBlockFree(c);
+
 
     if (b) BRMerkleBlockFree(b);
     return r;
@@ -3179,6 +3751,397 @@ int BRPeerTests()
     return r;
 }
 
+typedef struct {
+    UInt256 header;
+    BRCompactFilter *filter;
+    BRMerkleBlock *block;
+    BRTransaction *tx;
+    UInt256 txHash;
+    size_t txCount;
+} BRPeerCompactFilterTestInfo;
+
+static void _testRelayedCFHeaders(void *info, UInt256 stopHash, UInt256 prevHeader, const UInt256 filterHashes[],
+                                  size_t hashesCount)
+{
+    BRPeerCompactFilterTestInfo *test = info;
+    
+    for (size_t i = 0; i < hashesCount; i++) prevHeader = BRCompactFilterHeader(filterHashes[i], prevHeader);
+    test->header = prevHeader;
+}
+
+static void _testRelayedCFilter(void *info, BRCompactFilter *filter)
+{
+    ((BRPeerCompactFilterTestInfo *)info)->filter = filter;
+}
+
+static void _testRelayedFullBlock(void *info, BRMerkleBlock *block, BRTransaction *txs[], const UInt256 txHashes[],
+                                  size_t txCount)
+{
+    BRPeerCompactFilterTestInfo *test = info;
+    
+    test->block = block;
+    test->tx = txs[0];
+    test->txHash = txHashes[0];
+    test->txCount = txCount;
+    for (size_t i = 1; i < txCount; i++) if (txs[i]) BRTransactionFree(txs[i]);
+}
+
+// feeds a peer recorded BIP157 messages for the testnet genesis block, the same as a filter serving node would send
+int BRPeerCompactFilterTests()
+{
+    int r = 1;
+    BRPeer *p = BRPeerNew(BRTestNetParams->magicNumber);
+    BRPeerCompactFilterTestInfo test;
+    UInt256 blockHash = UInt256Reverse(uint256("000000000933ea01ad0ee984209779baaec3ced90fa3f408719526f8d77f4943"));
+    const char cfheaders[] = // filter type, stop hash, previous filter header, and filter hashes
+    "\x00\x43\x49\x7f\xd7\xf8\x26\x95\x71\x08\xf4\xa3\x0f\xd9\xce\xc3\xae\xba\x79\x97\x20\x84\xe9\x0e\xad\x01\xea\x33"
+    "\x09\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x01\x4c\x8a\xf7\xfa\x3a\xc4\x11\x1d\xc5\xfd\x75\x81\xd1\x76\xc0\x2d\xbb\xfd"
+    "\xe8\x3f\xd6\xf1\x64\x96\xa5\x76\xfb\xd6\xb2\x05\x37\xc0";
+    const char cfilter[] = // filter type, block hash, and filter
+    "\x00\x43\x49\x7f\xd7\xf8\x26\x95\x71\x08\xf4\xa3\x0f\xd9\xce\xc3\xae\xba\x79\x97\x20\x84\xe9\x0e\xad\x01\xea\x33"
+    "\x09\x00\x00\x00\x00\x04\x01\x9d\xfc\xa8";
+    const char block[] = // testnet genesis block
+    "\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x3b\xa3\xed\xfd\x7a\x7b\x12\xb2\x7a\xc7\x2c\x3e\x67\x76\x8f\x61\x7f\xc8\x1b\xc3"
+    "\x88\x8a\x51\x32\x3a\x9f\xb8\xaa\x4b\x1e\x5e\x4a\xda\xe5\x49\x4d\xff\xff\x00\x1d\x1a\xa4\xae\x18\x01\x01\x00\x00"
+    "\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\x4d\x04\xff\xff\x00\x1d\x01\x04\x45\x54\x68\x65\x20\x54\x69\x6d\x65\x73"
+    "\x20\x30\x33\x2f\x4a\x61\x6e\x2f\x32\x30\x30\x39\x20\x43\x68\x61\x6e\x63\x65\x6c\x6c\x6f\x72\x20\x6f\x6e\x20\x62"
+    "\x72\x69\x6e\x6b\x20\x6f\x66\x20\x73\x65\x63\x6f\x6e\x64\x20\x62\x61\x69\x6c\x6f\x75\x74\x20\x66\x6f\x72\x20\x62"
+    "\x61\x6e\x6b\x73\xff\xff\xff\xff\x01\x00\xf2\x05\x2a\x01\x00\x00\x00\x43\x41\x04\x67\x8a\xfd\xb0\xfe\x55\x48\x27"
+    "\x19\x67\xf1\xa6\x71\x30\xb7\x10\x5c\xd6\xa8\x28\xe0\x39\x09\xa6\x79\x62\xe0\xea\x1f\x61\xde\xb6\x49\xf6\xbc\x3f"
+    "\x4c\xef\x38\xc4\xf3\x55\x04\xe5\x1e\xc1\x12\xde\x5c\x38\x4d\xf7\xba\x0b\x8d\x57\x8a\x4c\x70\x2b\x6b\xf1\x1d\x5f"
+    "\xac\x00\x00\x00\x00";
+    uint8_t matches[] = { 1 };
+    
+    memset(&test, 0, sizeof(test));
+    BRPeerSetCallbacks(p, &test, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    BRPeerSetCompactFilterCallbacks(p, NULL, _testRelayedCFHeaders, _testRelayedCFilter, _testRelayedFullBlock);
+    
+    BRPeerAcceptMessageTest(p, (const uint8_t *)cfheaders, sizeof(cfheaders) - 1, MSG_CFHEADERS);
+    
+    if (! UInt256Eq(test.header,
+                    UInt256Reverse(uint256("21584579b7eb08997773e5aeff3a7f932700042d0ed2a6129012b7d7ae81b750"))))
+        r = 0, fprintf(stderr, "***FAILED*** %s: cfheaders test\n", __func__);
+
+    BRPeerAcceptMessageTest(p, (const uint8_t *)cfilter, sizeof(cfilter) - 1, MSG_CFILTER);
+    
+    if (! test.filter || ! UInt256Eq(test.filter->blockHash, blockHash) ||
+        ! UInt256Eq(BRCompactFilterHeader(BRCompactFilterHash(test.filter), UINT256_ZERO), test.header))
+        r = 0, fprintf(stderr, "***FAILED*** %s: cfilter test\n", __func__);
+
+    BRPeerAcceptMessageTest(p, (const uint8_t *)block, sizeof(block) - 1, MSG_BLOCK);
+    
+    if (! test.block || ! UInt256Eq(test.block->blockHash, blockHash) || test.txCount != 1 || ! test.tx ||
+        ! UInt256Eq(test.txHash, test.block->merkleRoot))
+        r = 0, fprintf(stderr, "***FAILED*** %s: block test 1\n", __func__);
+    
+    if (test.filter && test.tx &&
+        ! BRCompactFilterContainsData(test.filter, test.tx->outputs[0].script, test.tx->outputs[0].scriptLen))
+        r = 0, fprintf(stderr, "***FAILED*** %s: block test 2\n", __func__);
+
+    if (test.block && ! BRMerkleBlockSetTxMatches(test.block, &test.txHash, matches, 1))
+        r = 0, fprintf(stderr, "***FAILED*** %s: block test 3\n", __func__);
+
+    if (test.filter) BRCompactFilterFree(test.filter);
+    if (test.block) BRMerkleBlockFree(test.block);
+    if (test.tx) BRTransactionFree(test.tx);
+    BRPeerFree(p);
+    return r;
+}
+
+// appends a bitcoin protocol message, as on the wire, to the receive stream of capture
+static void _BRPeerReplayTestAddRecv(BRCapture capture, BRCaptureStream stream, uint32_t magicNumber,
+                                     const char *type, const uint8_t *payload, size_t payloadLen)
+{
+    uint8_t msg[24 + payloadLen], hash[32];
+
+    memset(msg, 0, sizeof(msg));
+    UInt32SetLE(&msg[0], magicNumber);
+    strncpy((char *)&msg[4], type, 12);
+    UInt32SetLE(&msg[16], (uint32_t)payloadLen);
+    BRSHA256_2(hash, payload, payloadLen);
+    memcpy(&msg[20], hash, sizeof(uint32_t));
+    memcpy(&msg[24], payload, payloadLen);
+    BRCaptureAddRecv(capture, stream, msg, sizeof(msg));
+}
+
+typedef struct {
+    int connected, disconnected, error;
+    volatile int done;
+} BRPeerReplayTestInfo;
+
+static void _testReplayConnected(void *info)
+{
+    ((BRPeerReplayTestInfo *)info)->connected = 1;
+}
+
+static void _testReplayDisconnected(void *info, int error)
+{
+    ((BRPeerReplayTestInfo *)info)->error = error;
+    ((BRPeerReplayTestInfo *)info)->disconnected = 1;
+}
+
+static void _testReplayThreadCleanup(void *info)
+{
+    ((BRPeerReplayTestInfo *)info)->done = 1;
+}
+
+static uint64_t _BRPeerReplayTestCounter(BRMetrics metrics, const char *name)
+{
+    BRMetricsCounterSnapshot counters[16];
+    size_t i, count = BRMetricsGetCounterSnapshots(metrics, counters, 16);
+
+    for (i = 0; i < count && strcmp(counters[i].name, name) != 0; i++);
+    return (i < count) ? counters[i].value : 0;
+}
+
+int BRPeerReplayTests()
+{
+    const char *path = "peerReplay.bin";
+    uint32_t magicNumber = BRMainNetParams->magicNumber;
+    uint8_t version[85], nonce[8];
+    int r = 1;
+
+    // a remote version (70013, no services, empty useragent) and verack, each after our own, then a run of pings that
+    // arrive together
+    memset(version, 0, sizeof(version));
+    UInt32SetLE(&version[0], 70013);
+
+    BRCapture capture = BRCaptureNew(path);
+    BRCaptureStream stream = BRCaptureOpenStream(capture, "127.0.0.1:8333");
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"version", 7);
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_VERSION, version, sizeof(version));
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"verack", 6);
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_VERACK, NULL, 0);
+
+    for (uint64_t i = 0; i < 5; i++) {
+        UInt64SetLE(nonce, i);
+        _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_PING, nonce, sizeof(nonce));
+    }
+
+    BRCaptureCloseStream(capture, stream);
+    BRCaptureFree(capture);
+
+    BRCaptureReplay replay = BRCaptureReplayNew(path);
+    remove(path);
+    if (! replay) return 0;
+
+    // the handshake completes from the replay alone; the end of the stream disconnects the peer
+    BRPeerReplayTestInfo info = { 0, 0, 0, 0 };
+    BRMetrics metrics = BRMetricsNew();
+    BRPeer *peer = BRPeerNew(magicNumber);
+
+    peer->address = ((UInt128) { .u8 = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 127, 0, 0, 1 } });
+    peer->port = 8333;
+    BRPeerSetCallbacks(peer, &info, _testReplayConnected, _testReplayDisconnected, NULL, NULL, NULL, NULL, NULL, NULL,
+                       NULL, NULL, NULL, _testReplayThreadCleanup);
+    BRPeerSetReplay(peer, replay);
+    BRPeerSetMetrics(peer, metrics);
+    BRPeerConnect(peer);
+
+    for (int i = 0; i < 500 && ! info.done; i++) usleep(10000);
+
+    if (! info.connected) r = 0, fprintf(stderr, "***FAILED*** %s: replay handshake\n", __func__);
+    if (! info.disconnected || info.error != ECONNRESET)
+        r = 0, fprintf(stderr, "***FAILED*** %s: replay end of stream\n", __func__);
+
+    // the pings are read at once, and the pongs written at once
+    if (_BRPeerReplayTestCounter(metrics, "peer.messagesReceived") != 7 ||
+        _BRPeerReplayTestCounter(metrics, "peer.messagesSent") != 7)
+        r = 0, fprintf(stderr, "***FAILED*** %s: replay message count\n", __func__);
+
+    if (_BRPeerReplayTestCounter(metrics, "peer.reads") >= _BRPeerReplayTestCounter(metrics, "peer.messagesReceived") ||
+        _BRPeerReplayTestCounter(metrics, "peer.writes") >= _BRPeerReplayTestCounter(metrics, "peer.messagesSent"))
+        r = 0, fprintf(stderr, "***FAILED*** %s: replay syscalls per message\n", __func__);
+
+    if (info.done) {
+        BRPeerFree(peer);
+        BRCaptureReplayFree(replay);
+        BRMetricsFree(metrics);
+    }
+
+    return r;
+}
+
+// mainnet blocks 1 to 3, which follow the genesis checkpoint; the headers must be real to pass the proof-of-work check
+static const uint8_t _BRPeerManagerCFTestHeaders[] =
+    "\x01\x00\x00\x00\x6f\xe2\x8c\x0a\xb6\xf1\xb3\x72\xc1\xa6\xa2\x46\xae\x63\xf7\x4f\x93\x1e\x83\x65"
+    "\xe1\x5a\x08\x9c\x68\xd6\x19\x00\x00\x00\x00\x00\x98\x20\x51\xfd\x1e\x4b\xa7\x44\xbb\xbe\x68\x0e"
+    "\x1f\xee\x14\x67\x7b\xa1\xa3\xc3\x54\x0b\xf7\xb1\xcd\xb6\x06\xe8\x57\x23\x3e\x0e\x61\xbc\x66\x49"
+    "\xff\xff\x00\x1d\x01\xe3\x62\x99\x01\x00\x00\x00\x48\x60\xeb\x18\xbf\x1b\x16\x20\xe3\x7e\x94\x90"
+    "\xfc\x8a\x42\x75\x14\x41\x6f\xd7\x51\x59\xab\x86\x68\x8e\x9a\x83\x00\x00\x00\x00\xd5\xfd\xcc\x54"
+    "\x1e\x25\xde\x1c\x7a\x5a\xdd\xed\xf2\x48\x58\xb8\xbb\x66\x5c\x9f\x36\xef\x74\x4e\xe4\x2c\x31\x60"
+    "\x22\xc9\x0f\x9b\xb0\xbc\x66\x49\xff\xff\x00\x1d\x08\xd2\xbd\x61\x01\x00\x00\x00\xbd\xdd\x99\xcc"
+    "\xfd\xa3\x9d\xa1\xb1\x08\xce\x1a\x5d\x70\x03\x8d\x0a\x96\x7b\xac\xb6\x8b\x6b\x63\x06\x5f\x62\x6a"
+    "\x00\x00\x00\x00\x44\xf6\x72\x22\x60\x90\xd8\x5d\xb9\xa9\xf2\xfb\xfe\x5f\x0f\x96\x09\xb3\x87\xaf"
+    "\x7b\xe5\xb7\xfb\xb7\xa1\x76\x7c\x83\x1c\x9e\x99\x5d\xbe\x66\x49\xff\xff\x00\x1d\x05\xe0\xed\x6d";
+
+// the coinbase tx of mainnet block 1, its only tx
+static const uint8_t _BRPeerManagerCFTestCoinbase[] =
+    "\x01\x00\x00\x00\x01\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\xff\xff\xff\xff\x07\x04\xff\xff\x00\x1d\x01"
+    "\x04\xff\xff\xff\xff\x01\x00\xf2\x05\x2a\x01\x00\x00\x00\x43\x41\x04\x96\xb5\x38\xe8\x53\x51\x9c"
+    "\x72\x6a\x2c\x91\xe6\x1e\xc1\x16\x00\xae\x13\x90\x81\x3a\x62\x7c\x66\xfb\x8b\xe7\x94\x7b\xe6\x3c"
+    "\x52\xda\x75\x89\x37\x95\x15\xd4\xe0\xa6\x04\xf8\x14\x17\x81\xe6\x22\x94\x72\x11\x66\xbf\x62\x1e"
+    "\x73\xa8\x2c\xbf\x23\x42\xc8\x58\xee\xac\x00\x00\x00\x00";
+
+static void _testCFReplaySyncStopped(void *info, int error)
+{
+    ((BRPeerReplayTestInfo *)info)->error = error;
+    ((BRPeerReplayTestInfo *)info)->done = 1;
+}
+
+// the totalTx and hashesCount of saved blocks 1 to 3, or UINT32_MAX if not saved
+static uint32_t _BRPeerManagerCFTestSavedTotalTx[4], _BRPeerManagerCFTestSavedHashes[4];
+
+static void _testCFReplaySaveBlocks(void *info, int replace, BRMerkleBlock *blocks[], size_t blocksCount)
+{
+    for (size_t i = 0; i < blocksCount; i++) {
+        if (blocks[i]->height < 1 || blocks[i]->height > 3) continue;
+        _BRPeerManagerCFTestSavedTotalTx[blocks[i]->height] = blocks[i]->totalTx;
+        _BRPeerManagerCFTestSavedHashes[blocks[i]->height] = (uint32_t)blocks[i]->hashesCount;
+    }
+}
+
+// syncs a wallet with compact filters from a replayed peer that serves headers 1 to 3, and filters in which only block
+// 1 matches the wallet; returns the last block height once the sync stops, relayBlock is false to withhold block 1
+static uint32_t _BRPeerManagerCFReplayTestSync(int relayBlock)
+{
+    const char *path = "peerManagerCFReplay.bin";
+    uint32_t magicNumber = BRMainNetParams->magicNumber, height;
+    size_t count = (sizeof(_BRPeerManagerCFTestHeaders) - 1)/80, txLen = sizeof(_BRPeerManagerCFTestCoinbase) - 1,
+           i, off;
+    uint8_t version[85], headers[1 + 81*count], cfheaders[66 + 32*count], cfilter[1024], block[80 + 1 + txLen],
+            nonce[8];
+    UInt256 blockHashes[count];
+    UInt512 seed;
+
+    BRBIP39DeriveKey(&seed, "a random seed", NULL);
+
+    BRWallet *wallet = BRWalletNew(BRMainNetParams->addrParams, NULL, 0, BRBIP32MasterPubKey(&seed, sizeof(seed)));
+    BRAddress addr = BRWalletReceiveAddress(wallet);
+    uint8_t script[BRAddressScriptPubKey(NULL, 0, BRMainNetParams->addrParams, addr.s)];
+    size_t scriptLen = BRAddressScriptPubKey(script, sizeof(script), BRMainNetParams->addrParams, addr.s);
+
+    // the filter elements are the coinbase output script, and for block 1 only, the wallet receive address script
+    const uint8_t *elems[] = { &_BRPeerManagerCFTestCoinbase[63], script };
+    size_t elemLens[] = { 67, scriptLen };
+
+    // a remote version (70013, serving compact filters, lastblock 3) and verack, each after our own
+    memset(version, 0, sizeof(version));
+    UInt32SetLE(&version[0], 70013);
+    UInt64SetLE(&version[4], SERVICES_NODE_NETWORK | SERVICES_NODE_BLOOM | SERVICES_NODE_WITNESS |
+                SERVICES_NODE_COMPACT_FILTERS);
+    UInt32SetLE(&version[81], (uint32_t)count);
+
+    BRCapture capture = BRCaptureNew(path);
+    BRCaptureStream stream = BRCaptureOpenStream(capture, "127.0.0.1:8333");
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"version", 7);
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_VERSION, version, sizeof(version));
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"verack", 6);
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_VERACK, NULL, 0);
+
+    // the headers, in reply to getheaders
+    headers[0] = (uint8_t)count;
+
+    for (i = 0; i < count; i++) {
+        memcpy(&headers[1 + 81*i], &_BRPeerManagerCFTestHeaders[80*i], 80);
+        headers[1 + 81*i + 80] = 0;
+        BRSHA256_2(&blockHashes[i], &_BRPeerManagerCFTestHeaders[80*i], 80);
+    }
+
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"getheaders", 10);
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_HEADERS, headers, sizeof(headers));
+
+    // the filter hashes, in reply to getcfheaders, then the filters, in reply to getcfilters
+    BRCompactFilter *filters[count];
+
+    memset(cfheaders, 0, sizeof(cfheaders));
+    cfheaders[0] = CFILTER_TYPE_BASIC;
+    UInt256Set(&cfheaders[1], blockHashes[count - 1]);
+    cfheaders[65] = (uint8_t)count;
+
+    for (i = 0; i < count; i++) {
+        filters[i] = BRCompactFilterNew(blockHashes[i], elems, elemLens, (i == 0) ? 2 : 1);
+        UInt256Set(&cfheaders[66 + 32*i], BRCompactFilterHash(filters[i]));
+    }
+
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"getcfheaders", 12);
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_CFHEADERS, cfheaders, sizeof(cfheaders));
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"getcfilters", 11);
+
+    for (i = 0; i < count; i++) {
+        cfilter[0] = CFILTER_TYPE_BASIC;
+        UInt256Set(&cfilter[1], blockHashes[i]);
+        off = 33 + BRVarIntSet(&cfilter[33], sizeof(cfilter) - 33, filters[i]->length);
+        memcpy(&cfilter[off], filters[i]->data, filters[i]->length);
+        _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_CFILTER, cfilter, off + filters[i]->length);
+        BRCompactFilterFree(filters[i]);
+    }
+
+    // the matched block, in reply to getdata, and the pong that ends the window
+    memcpy(block, _BRPeerManagerCFTestHeaders, 80);
+    block[80] = 1;
+    memcpy(&block[81], _BRPeerManagerCFTestCoinbase, txLen);
+    memset(nonce, 0, sizeof(nonce));
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"getdata", 7);
+    BRCaptureAddSend(capture, stream, (const uint8_t *)"ping", 4);
+    if (relayBlock) _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_BLOCK, block, sizeof(block));
+    _BRPeerReplayTestAddRecv(capture, stream, magicNumber, MSG_PONG, nonce, sizeof(nonce));
+
+    BRCaptureCloseStream(capture, stream);
+    BRCaptureFree(capture);
+
+    BRCaptureReplay replay = BRCaptureReplayNew(path);
+    remove(path);
+    if (! replay) return 0;
+
+    // the end of the stream disconnects the peer, and the sync stops once reconnecting to it fails
+    BRPeerReplayTestInfo info = { 0, 0, 0, 0 };
+    BRPeerManager *manager = BRPeerManagerNew(BRMainNetParams, wallet, 0, NULL, 0, NULL, 0);
+
+    for (i = 0; i < 4; i++) _BRPeerManagerCFTestSavedTotalTx[i] = _BRPeerManagerCFTestSavedHashes[i] = UINT32_MAX;
+    BRPeerManagerSetCallbacks(manager, &info, NULL, _testCFReplaySyncStopped, NULL, _testCFReplaySaveBlocks, NULL, NULL,
+                              NULL);
+    BRPeerManagerSetSyncMode(manager, BRPeerManagerSyncCompactFilter);
+    BRPeerManagerSetReplay(manager, replay);
+    BRPeerManagerConnect(manager);
+
+    for (i = 0; i < 1000 && ! info.done; i++) usleep(10000);
+    BRPeerManagerDisconnect(manager);
+    height = BRPeerManagerLastBlockHeight(manager);
+    BRPeerManagerFree(manager);
+    BRCaptureReplayFree(replay);
+    BRWalletFree(wallet);
+    return height;
+}
+
+int BRPeerManagerCompactFilterTests()
+{
+    int r = 1;
+
+    // block 1 matches, and is requested and relayed, blocks 2 and 3 don't match and are added as headers
+    if (_BRPeerManagerCFReplayTestSync(1) != 3)
+        r = 0, fprintf(stderr, "***FAILED*** %s: compact filter sync\n", __func__);
+
+    // block 1 is saved with its single matched tx, blocks 2 and 3 as plain headers with no merkle data
+    if (_BRPeerManagerCFTestSavedTotalTx[1] != 1 || _BRPeerManagerCFTestSavedHashes[1] != 1)
+        r = 0, fprintf(stderr, "***FAILED*** %s: compact filter sync, matched block saved\n", __func__);
+
+    for (int i = 2; i <= 3; i++) {
+        if (_BRPeerManagerCFTestSavedTotalTx[i] != 0 || _BRPeerManagerCFTestSavedHashes[i] != 0)
+            r = 0, fprintf(stderr, "***FAILED*** %s: compact filter sync, unmatched block %d saved\n", __func__, i);
+    }
+
+    // a matched block that isn't relayed by the time of the pong stops the sync before any block of the window is added
+    if (_BRPeerManagerCFReplayTestSync(0) != 0)
+        r = 0, fprintf(stderr, "***FAILED*** %s: compact filter sync, matched block withheld\n", __func__);
+
+    return r;
+}
+
 int BRRunTests()
 {
     int fail = 0;
@@ -3227,10 +4190,22 @@ int BRRunTests()
     printf("%s\n", (BRTransactionTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRWalletTests...                    ");
     printf("%s\n", (BRWalletTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRWalletPKHCacheTests...            ");
+    printf("%s\n", (BRWalletPKHCacheTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRSyncManagerTests...               ");
+    printf("%s\n", (BRSyncManagerTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRBloomFilterTests...               ");
     printf("%s\n", (BRBloomFilterTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRCompactFilterTests...             ");
+    printf("%s\n", (BRCompactFilterTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRMerkleBlockTests...               ");
     printf("%s\n", (BRMerkleBlockTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRPeerCompactFilterTests...         ");
+    printf("%s\n", (BRPeerCompactFilterTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRPeerReplayTests...                ");
+    printf("%s\n", (BRPeerReplayTests()) ? "success" : (fail++, "***FAIL***"));
+    printf("BRPeerManagerCompactFilterTests...  ");
+    printf("%s\n", (BRPeerManagerCompactFilterTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRPaymentProtocolTests...           ");
     printf("%s\n", (BRPaymentProtocolTests()) ? "success" : (fail++, "***FAIL***"));
     printf("BRPaymentProtocolEncryptionTests... ");
@@ -3365,6 +4340,61 @@ extern int BRRunTestsSync (const char *paperKey,
     return 1;
 }
 
+static void _perfRelayedBlock(void *info, BRMerkleBlock *block)
+{
+    (*(size_t *)info)++;
+    BRMerkleBlockFree(block);
+}
+
+// synthetic header parsing throughput benchmark: a 2000 header "headers" message, made of one real header (block 10001)
+// repeated, is parsed and checked with 1 to the maximum number of validation threads, and then fed through a peer the
+// same as if it was received over the network
+// NOTE: every header has the same hash and previous block, so this measures parsing, hashing and proof-of-work checks
+// only, not chaining a real run of headers
+extern void BRRunPerfTestsHeaderParse (int repeat) {
+    const char header[] = // block 10001
+    "\x01\x00\x00\x00\x06\xe5\x33\xfd\x1a\xda\x86\x39\x1f\x3f\x6c\x34\x32\x04\xb0\xd2\x78\xd4\xaa\xec\x1c"
+    "\x0b\x20\xaa\x27\xba\x03\x00\x00\x00\x00\x00\x6a\xbb\xb3\xeb\x3d\x73\x3a\x9f\xe1\x89\x67\xfd\x7d\x4c\x11\x7e\x4c"
+    "\xcb\xba\xc5\xbe\xc4\xd9\x10\xd9\x00\xb3\xae\x07\x93\xe7\x7f\x54\x24\x1b\x4d\x4c\x86\x04\x1b\x40\x89\xcc\x9b\x0c";
+    size_t count = 2000, relayed = 0, off = BRVarIntSize(count);
+    uint8_t *msg = malloc(off + 81*count);
+    BRMerkleBlock **blocks = calloc(count, sizeof(*blocks));
+    BRPeer *peer = BRPeerNew(BRMainNetParams->magicNumber);
+    struct timespec start, end;
+    double elapsed;
+
+    assert (msg != NULL && blocks != NULL);
+    BRVarIntSet(msg, off, count);
+    for (size_t i = 0; i < count; i++) memcpy(&msg[off + 81*i], header, 80), msg[off + 81*i + 80] = 0;
+
+    for (size_t threads = 1; threads <= BLOCK_MAX_VALIDATION_THREADS; threads *= 2) {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (int i = 0; i < repeat; i++) {
+            size_t n = BRMerkleBlockParseHeaders(blocks, &msg[off], 81, count, (uint32_t)time(NULL), threads);
+
+            assert (n == count);
+            for (size_t j = 0; j < n; j++) BRMerkleBlockFree(blocks[j]);
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec)/1e9;
+        printf ("BRMerkleBlockParseHeaders (synthetic), %zu thread(s): %.0f headers/s\n", threads, repeat*count/elapsed);
+    }
+
+    BRPeerSetCallbacks(peer, &relayed, NULL, NULL, NULL, NULL, NULL, NULL, _perfRelayedBlock, NULL, NULL, NULL, NULL,
+                       NULL);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < repeat; i++) BRPeerAcceptMessageTest(peer, msg, off + 81*count, MSG_HEADERS);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec)/1e9;
+    printf ("BRPeer headers message (synthetic): %.0f headers/s, %zu relayed\n", relayed/elapsed, relayed);
+
+    BRPeerFree(peer);
+    free(blocks);
+    free(msg);
+}
+
 #ifndef BITCOIN_TEST_NO_MAIN
 void syncStarted(void *info)
 {
@@ -103,7 +103,7 @@ extern int BRRunTestWalletManagerSync (const char *paperKey,
 
     BRCryptoSyncMode mode = CRYPTO_SYNC_MODE_P2P_ONLY;
 
-    BRWalletManager manager = BRWalletManagerNew (client, mpk, params, epoch, mode, storagePath, 0, 6);
+    BRWalletManager manager = BRWalletManagerNew (client, mpk, params, epoch, mode, storagePath, 0, 6, NULL);
 
     BRWalletManagerStart (manager);
 
@@ -569,7 +569,7 @@ BRRunTestWalletManagerSyncBwmSetup (BRCryptoSyncMode mode,
     } else {
         params = isMainnet ? BRBCashParams : BRBCashTestNetParams;
     }
-    return BRWalletManagerNew (client, mpk, params, earliestKeyTime, mode, storagePath, blockHeight, 6);
+    return BRWalletManagerNew (client, mpk, params, earliestKeyTime, mode, storagePath, blockHeight, 6, NULL);
 }
 
 static int
@@ -18,8 +18,10 @@
 
 #include "BRCryptoAmount.h"
 #include "BRCryptoWallet.h"
+#include "crypto/BRCryptoAccountP.h"
 #include "crypto/BRCryptoNetworkP.h"
 #include "crypto/BRCryptoTransferP.h"
+#include "crypto/BRCryptoWalletP.h"
 #include "crypto/BRCryptoWalletManagerP.h"
 
 #include "support/BRBIP32Sequence.h"
@@ -287,6 +289,17 @@ transferTestsAddress (void) {
         assert (0 == strcmp (test->input,  source));
         assert (0 == strcmp (test->output, target));
 
+        // The amounts, computed on first use, agree with the wallet
+        if (0 == BRWalletAmountSentByTx (wid, tid)) {
+            BRCryptoBoolean overflow = CRYPTO_FALSE;
+            BRCryptoAmount  amount   = cryptoTransferGetAmount (transfer);
+
+            assert (CRYPTO_TRANSFER_RECEIVED == cryptoTransferGetDirection (transfer));
+            assert (BRWalletAmountReceivedFromTx (wid, tid) == cryptoAmountGetIntegerRaw (amount, &overflow));
+            assert (CRYPTO_FALSE == overflow);
+            cryptoAmountGive (amount);
+        }
+
         free (testRawBytes);
         free (source); free (target);
         cryptoAddressGive(sourceAddress); cryptoAddressGive(targetAddress);
@@ -301,6 +314,198 @@ runCryptoTransferTests (void) {
     transferTestsAddress();
 }
 
+///
+/// Mark: BRCryptoWallet Tests
+///
+
+static BRCryptoTransferState
+walletTestsStateIncluded (uint64_t blockNumber) {
+    return (BRCryptoTransferState) { CRYPTO_TRANSFER_STATE_INCLUDED, { .included = { blockNumber, 0, 0, NULL, CRYPTO_TRUE } } };
+}
+
+static void
+walletTestsSetIncluded (BRCryptoTransfer transfer, uint64_t blockNumber) {
+    cryptoTransferSetState (transfer, walletTestsStateIncluded (blockNumber));
+}
+
+// Fill `transfers` with every transfer following `cursor`, in pages of `pageSize`; return the count
+static size_t
+walletTestsGetPages (BRCryptoWallet wallet,
+                     BRCryptoWalletTransferCursor *cursor,
+                     size_t pageSize,
+                     BRCryptoTransfer *transfers) {
+    size_t count = 0, filled;
+    while (0 != (filled = cryptoWalletGetTransfersPage (wallet, cursor, &transfers[count], pageSize))) {
+        for (size_t index = count; index < count + filled; index++) cryptoTransferGive (transfers[index]);
+        count += filled;
+    }
+    return count;
+}
+
+static void
+walletTestsTransfersPage (void) {
+    BRCryptoCurrency btc  = cryptoCurrencyCreate ("BitcoinUIDS", "Bitcoin", "BTC", "native", NULL);
+    BRCryptoUnit     sat  = cryptoUnitCreateAsBase (btc, "SatoshiUIDS", "Satoshi", "SAT");
+    BRCryptoWallet wallet = cryptoWalletCreateAsBTC (sat, sat, NULL, NULL);
+
+    BRTransaction   *tids[5];
+    BRCryptoTransfer t[5];
+    for (size_t index = 0; index < 5; index++) {
+        tids[index] = BRTransactionNew ();
+        t[index]    = cryptoTransferCreateAsBTC (sat, sat, NULL, tids[index], CRYPTO_TRUE);
+    }
+    walletTestsSetIncluded (t[0], 10);
+    walletTestsSetIncluded (t[1], 20);
+    walletTestsSetIncluded (t[3],  5);
+    walletTestsSetIncluded (t[4], 30);
+
+    // t[2] is not included; it orders last
+    cryptoWalletAddTransfer (wallet, t[2]);
+    cryptoWalletAddTransfer (wallet, t[1]);
+    cryptoWalletAddTransfer (wallet, t[0]);
+
+    BRCryptoTransfer page[5];
+    BRCryptoWalletTransferCursor cursor = cryptoWalletTransferCursorInit ();
+    assert (1 == cryptoWalletGetTransfersPage (wallet, &cursor, page, 1));
+    assert (t[0] == page[0]);
+    cryptoTransferGive (page[0]);
+
+    // t[2] is included ahead of the cursor, t[3] is added behind it and t[4] ahead of it
+    cryptoWalletSetTransferState (wallet, t[2], walletTestsStateIncluded (25));
+    cryptoWalletAddTransfer (wallet, t[3]);
+    cryptoWalletAddTransfer (wallet, t[4]);
+
+    assert (3 == walletTestsGetPages (wallet, &cursor, 2, page));
+    assert (t[1] == page[0] && t[2] == page[1] && t[4] == page[2]);
+    assert (0 == cryptoWalletGetTransfersPage (wallet, &cursor, page, 2));
+
+    // Paging does not reorder `cryptoWalletGetTransfers()`
+    size_t count;
+    BRCryptoTransfer *transfers = cryptoWalletGetTransfers (wallet, &count);
+    assert (5 == count);
+    assert (t[2] == transfers[0] && t[1] == transfers[1] && t[0] == transfers[2] &&
+            t[3] == transfers[3] && t[4] == transfers[4]);
+    for (size_t index = 0; index < count; index++) cryptoTransferGive (transfers[index]);
+    free (transfers);
+
+    cursor = cryptoWalletTransferCursorInit ();
+    assert (5 == walletTestsGetPages (wallet, &cursor, 2, page));
+    assert (t[3] == page[0] && t[0] == page[1] && t[1] == page[2] && t[2] == page[3] && t[4] == page[4]);
+
+    // A state change alone reorders; t[1] is no longer included
+    cryptoWalletSetTransferState (wallet, t[1], cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SUBMITTED));
+    cursor = cryptoWalletTransferCursorInit ();
+    assert (5 == walletTestsGetPages (wallet, &cursor, 3, page));
+    assert (t[3] == page[0] && t[0] == page[1] && t[2] == page[2] && t[4] == page[3] && t[1] == page[4]);
+
+    // A state change that keeps the position, or a position change in another wallet, leaves the
+    // order as built
+    assert (!wallet->transfersOrderDirty);
+    cryptoWalletSetTransferState (wallet, t[1], cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SIGNED));
+    assert (!wallet->transfersOrderDirty);
+
+    BRTransaction   *otherTid      = BRTransactionNew ();
+    BRCryptoTransfer otherTransfer = cryptoTransferCreateAsBTC (sat, sat, NULL, otherTid, CRYPTO_TRUE);
+    BRCryptoWallet   otherWallet   = cryptoWalletCreateAsBTC (sat, sat, NULL, NULL);
+    cryptoWalletAddTransfer (otherWallet, otherTransfer);
+    cryptoWalletSetTransferState (otherWallet, otherTransfer, walletTestsStateIncluded (1));
+    assert (!wallet->transfersOrderDirty);
+    assert (otherWallet->transfersOrderDirty);
+    cryptoWalletGive (otherWallet);
+    cryptoTransferGive (otherTransfer);
+    BRTransactionFree (otherTid);
+
+    // A removal
+    cryptoWalletRemTransfer (wallet, t[0]);
+    cursor = cryptoWalletTransferCursorInit ();
+    assert (4 == walletTestsGetPages (wallet, &cursor, 4, page));
+    assert (t[3] == page[0] && t[2] == page[1] && t[4] == page[2] && t[1] == page[3]);
+
+    cryptoWalletGive (wallet);
+    for (size_t index = 0; index < 5; index++) {
+        cryptoTransferGive (t[index]);
+        BRTransactionFree (tids[index]);
+    }
+    cryptoUnitGive (sat);
+    cryptoCurrencyGive (btc);
+}
+
+static void
+runCryptoWalletTests (void) {
+    walletTestsTransfersPage ();
+}
+
+///
+/// Mark: BRCryptoSigningSession Tests
+///
+
+#define SIGNING_SESSION_TEST_PAPER_KEY  "ginger settle marine tissue robot crane night number ramp coast roast critic"
+
+static void
+signingSessionTestsExpire (void) {
+    UInt512 expected = cryptoAccountDeriveSeed (SIGNING_SESSION_TEST_PAPER_KEY);
+    UInt512 seed;
+
+    // No lifetime; valid until expired explicitly
+    BRCryptoSigningSession session = cryptoSigningSessionCreate (SIGNING_SESSION_TEST_PAPER_KEY, 0);
+    assert (CRYPTO_FALSE == cryptoSigningSessionIsExpired (session));
+    assert (CRYPTO_TRUE  == cryptoSigningSessionGetSeed (session, &seed));
+    assert (UInt512Eq (expected, seed));
+
+    // Expired, the seed is gone: nothing is copied out
+    cryptoSigningSessionExpire (session);
+    assert (CRYPTO_TRUE  == cryptoSigningSessionIsExpired (session));
+    seed = UINT512_ZERO;
+    assert (CRYPTO_FALSE == cryptoSigningSessionGetSeed (session, &seed));
+    assert (UInt512IsZero (seed));
+
+    // Expiring again is harmless
+    cryptoSigningSessionExpire (session);
+    assert (CRYPTO_TRUE  == cryptoSigningSessionIsExpired (session));
+    cryptoSigningSessionGive (session);
+
+    // A one second lifetime; expired without an explicit expire
+    session = cryptoSigningSessionCreate (SIGNING_SESSION_TEST_PAPER_KEY, 1);
+    assert (CRYPTO_TRUE  == cryptoSigningSessionGetSeed (session, &seed));
+    assert (UInt512Eq (expected, seed));
+    sleep (2);
+    seed = UINT512_ZERO;
+    assert (CRYPTO_FALSE == cryptoSigningSessionGetSeed (session, &seed));
+    assert (UInt512IsZero (seed));
+    assert (CRYPTO_TRUE  == cryptoSigningSessionIsExpired (session));
+    cryptoSigningSessionGive (session);
+
+    // Released while valid
+    session = cryptoSigningSessionCreate (SIGNING_SESSION_TEST_PAPER_KEY, 0);
+    cryptoSigningSessionGive (session);
+}
+
+static void
+signingSessionTestsSignMultipleExpired (void) {
+    BRCryptoSigningSession session = cryptoSigningSessionCreate (SIGNING_SESSION_TEST_PAPER_KEY, 0);
+    cryptoSigningSessionExpire (session);
+
+    // An expired session signs nothing and never reaches the manager, wallet or transfers
+    BRCryptoTransfer transfers[3] = { NULL, NULL, NULL };
+    BRCryptoBoolean  results[3]   = { CRYPTO_TRUE, CRYPTO_TRUE, CRYPTO_TRUE };
+
+    assert (0 == cryptoWalletManagerSignMultipleWithSession (NULL, NULL, transfers, 3, session, results));
+    for (size_t index = 0; index < 3; index++)
+        assert (CRYPTO_FALSE == results[index]);
+
+    // Results are optional
+    assert (0 == cryptoWalletManagerSignMultipleWithSession (NULL, NULL, transfers, 3, session, NULL));
+    assert (CRYPTO_FALSE == cryptoWalletManagerSignWithSession (NULL, NULL, NULL, session));
+
+    cryptoSigningSessionGive (session);
+}
+
+static void
+runCryptoSigningSessionTests (void) {
+    signingSessionTestsExpire ();
+    signingSessionTestsSignMultipleExpired ();
+}
+
 ///
 /// Mark: BRCryptoWalletManager Tests
 ///
@@ -1505,6 +1710,193 @@ runCryptoWalletManagerLifecycleWithSetModeTest (BRCryptoAccount account,
     return success;
 }
 
+///
+/// Mark: Listener Batching Tests
+///
+
+static void
+_CWMEventRecordingBatchCallback (BRCryptoCWMListenerContext context,
+                                 BRCryptoCWMListenerEvent *events,
+                                 size_t eventsCount) {
+    for (size_t index = 0; index < eventsCount; index++) {
+        BRCryptoCWMListenerEvent *event = &events[index];
+        switch (event->type) {
+            case CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER:
+                _CWMEventRecordingManagerCallback (context, event->manager, event->u.manager);
+                break;
+            case CRYPTO_CWM_LISTENER_EVENT_WALLET:
+                _CWMEventRecordingWalletCallback (context, event->manager, event->wallet, event->u.wallet);
+                break;
+            case CRYPTO_CWM_LISTENER_EVENT_TRANSFER:
+                _CWMEventRecordingTransferCallback (context, event->manager, event->wallet, event->transfer, event->u.transfer);
+                break;
+        }
+    }
+}
+
+static size_t
+CWMEventRecordingCount (CWMEventRecordingState *state) {
+    pthread_mutex_lock (&state->lock);
+    size_t count = array_count (state->events);
+    pthread_mutex_unlock (&state->lock);
+    return count;
+}
+
+// Wait up to 5 seconds for `count` events to be recorded
+static int
+CWMEventRecordingWaitForCount (CWMEventRecordingState *state, size_t count) {
+    for (size_t tries = 0; tries < 500 && CWMEventRecordingCount (state) < count; tries++)
+        usleep (10000);
+    return CWMEventRecordingCount (state) == count;
+}
+
+static void
+_CWMListenerAnnounceBlockHeight (BRCryptoWalletManager manager, uint64_t blockHeight) {
+    cryptoWalletManagerListenerWalletManagerEvent (manager, cryptoWalletManagerTake (manager), (BRCryptoWalletManagerEvent) {
+        CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED,
+        { .blockHeight = { blockHeight }}
+    });
+}
+
+static void
+_CWMListenerAnnounceSyncStarted (BRCryptoWalletManager manager) {
+    cryptoWalletManagerListenerWalletManagerEvent (manager, cryptoWalletManagerTake (manager), (BRCryptoWalletManagerEvent) {
+        CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED
+    });
+}
+
+static void
+_CWMListenerAnnounceTransferChanged (BRCryptoWalletManager manager,
+                                     BRCryptoWallet wallet,
+                                     BRCryptoTransfer transfer,
+                                     BRCryptoTransferStateType oldType,
+                                     BRCryptoTransferStateType newType) {
+    cryptoWalletManagerListenerTransferEvent (manager,
+                                              cryptoWalletManagerTake (manager),
+                                              cryptoWalletTake (wallet),
+                                              cryptoTransferTake (transfer),
+                                              (BRCryptoTransferEvent) {
+        CRYPTO_TRANSFER_EVENT_CHANGED,
+        { .state = { cryptoTransferStateInit (oldType), cryptoTransferStateInit (newType) }}
+    });
+}
+
+static void
+_CWMListenerEventGive (BRCryptoCWMListenerEvent *event) {
+    cryptoWalletManagerGive (event->manager);
+    if (NULL != event->wallet)   cryptoWalletGive (event->wallet);
+    if (NULL != event->transfer) cryptoTransferGive (event->transfer);
+    if (CRYPTO_CWM_LISTENER_EVENT_TRANSFER == event->type) {
+        cryptoTransferStateRelease (&event->u.transfer.u.state.old);
+        cryptoTransferStateRelease (&event->u.transfer.u.state.new);
+    }
+}
+
+static int
+runCryptoWalletManagerListenerBatchingTest (BRCryptoAccount account,
+                                            BRCryptoNetwork network,
+                                            BRCryptoAddressScheme scheme,
+                                            const char *storagePath) {
+    printf("Testing BRCryptoWalletManager listener batching on network=\"%s\"...\n",
+           cryptoNetworkGetName (network));
+
+    BRCryptoBlockChainHeight originalNetworkHeight = cryptoNetworkGetHeight (network);
+
+    CWMEventRecordingState state = {0};
+    CWMEventRecordingStateNew (&state, CRYPTO_TRUE);
+
+    BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForLifecycleTest (&state, account, network, CRYPTO_SYNC_MODE_API_ONLY, scheme, storagePath);
+    BRCryptoWallet wallet = cryptoWalletManagerGetWallet (manager);
+    size_t count = CWMEventRecordingCount (&state);
+
+    // The transfer is only a reference in the events; any transfer will do
+    BRCryptoUnit unit = cryptoWalletGetUnit (wallet);
+    BRTransaction *tid = BRTransactionNew ();
+    BRCryptoTransfer transfer = cryptoTransferCreateAsBTC (unit, unit, NULL, tid, CRYPTO_TRUE);
+
+    BRCryptoCWMListenerBatching polled = { 10, 0, NULL };
+    cryptoWalletManagerSetListenerBatching (manager, &polled);
+
+    // Repeated CHANGED, BLOCK_HEIGHT_UPDATED events coalesce; the latest event takes the position
+    _CWMListenerAnnounceTransferChanged (manager, wallet, transfer, CRYPTO_TRANSFER_STATE_CREATED,   CRYPTO_TRANSFER_STATE_SIGNED);
+    _CWMListenerAnnounceBlockHeight     (manager, 1);
+    _CWMListenerAnnounceTransferChanged (manager, wallet, transfer, CRYPTO_TRANSFER_STATE_SIGNED,    CRYPTO_TRANSFER_STATE_SUBMITTED);
+    _CWMListenerAnnounceSyncStarted     (manager);
+    _CWMListenerAnnounceBlockHeight     (manager, 2);
+    _CWMListenerAnnounceTransferChanged (manager, wallet, transfer, CRYPTO_TRANSFER_STATE_SUBMITTED, CRYPTO_TRANSFER_STATE_DELETED);
+    assert (count == CWMEventRecordingCount (&state));
+
+    BRCryptoCWMListenerEvent events[3];
+    assert (2 == cryptoWalletManagerPollListenerEvents (manager, events, 2));
+    assert (CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER        == events[0].type);
+    assert (CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED        == events[0].u.manager.type);
+    assert (CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER        == events[1].type);
+    assert (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED == events[1].u.manager.type);
+    assert (2 == events[1].u.manager.u.blockHeight.value);
+    _CWMListenerEventGive (&events[0]);
+    _CWMListenerEventGive (&events[1]);
+
+    assert (1 == cryptoWalletManagerPollListenerEvents (manager, events, 3));
+    assert (CRYPTO_CWM_LISTENER_EVENT_TRANSFER == events[0].type);
+    assert (transfer == events[0].transfer);
+    assert (CRYPTO_TRANSFER_EVENT_CHANGED  == events[0].u.transfer.type);
+    assert (CRYPTO_TRANSFER_STATE_CREATED  == events[0].u.transfer.u.state.old.type);
+    assert (CRYPTO_TRANSFER_STATE_DELETED  == events[0].u.transfer.u.state.new.type);
+    _CWMListenerEventGive (&events[0]);
+
+    assert (0 == cryptoWalletManagerPollListenerEvents (manager, events, 3));
+
+    // Stopping with events queued announces them, in order, through the listener
+    _CWMListenerAnnounceBlockHeight (manager, 3);
+    _CWMListenerAnnounceSyncStarted (manager);
+    cryptoWalletManagerSetListenerBatching (manager, NULL);
+    assert (CWMEventRecordingCount (&state) == count + 2);
+    assert (CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED == state.events[count + 0]->u.m.event.type);
+    assert (CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED         == state.events[count + 1]->u.m.event.type);
+    assert (0 == cryptoWalletManagerPollListenerEvents (manager, events, 3));
+    count += 2;
+
+    // Unbatched, events are announced immediately
+    _CWMListenerAnnounceBlockHeight (manager, 4);
+    assert (CWMEventRecordingCount (&state) == ++count);
+
+    // With a callback, events are delivered once `eventsLimit` are queued
+    BRCryptoCWMListenerBatching batched = { 2, 60 * 1000, _CWMEventRecordingBatchCallback };
+    cryptoWalletManagerSetListenerBatching (manager, &batched);
+    _CWMListenerAnnounceSyncStarted (manager);
+    _CWMListenerAnnounceBlockHeight (manager, 5);
+    assert (CWMEventRecordingWaitForCount (&state, count += 2));
+
+    // Changing batching with an event queued announces it through the listener
+    _CWMListenerAnnounceBlockHeight (manager, 6);
+    batched = (BRCryptoCWMListenerBatching) { 10, 200, _CWMEventRecordingBatchCallback };
+    cryptoWalletManagerSetListenerBatching (manager, &batched);
+    assert (CWMEventRecordingCount (&state) == ++count);
+
+    // The latency runs from the oldest queued event, not from one since superseded
+    _CWMListenerAnnounceBlockHeight (manager, 7);
+    usleep (150 * 1000);
+    _CWMListenerAnnounceBlockHeight (manager, 8);
+    usleep (100 * 1000);
+    assert (CWMEventRecordingCount (&state) == count);
+    assert (CWMEventRecordingWaitForCount (&state, ++count));
+    assert (8 == state.events[count - 1]->u.m.event.u.blockHeight.value);
+
+    cryptoWalletManagerSetListenerBatching (manager, NULL);
+
+    cryptoTransferGive (transfer);
+    BRTransactionFree (tid);
+    cryptoUnitGive (unit);
+
+    cryptoNetworkSetHeight (network, originalNetworkHeight);
+    cryptoWalletManagerStop (manager);
+    cryptoWalletGive (wallet);
+    cryptoWalletManagerGive (manager);
+    CWMEventRecordingStateFree (&state);
+
+    return 1;
+}
+
 ///
 /// Mark: Entrypoints
 ///
@@ -1542,6 +1934,17 @@ runCryptoTestsWithAccountAndNetwork (BRCryptoAccount account,
         }
     }
 
+    if (isBtc || isEth || isGen) {
+        success = AS_CRYPTO_BOOLEAN(runCryptoWalletManagerListenerBatchingTest (account,
+                                                                                network,
+                                                                                scheme,
+                                                                                storagePath));
+        if (!success) {
+            fprintf(stderr, "***FAILED*** %s:%d: failed\n", __func__, __LINE__);
+            return success;
+        }
+    }
+
     if (isBtc || isBch || isEth) {
         success = AS_CRYPTO_BOOLEAN(runCryptoWalletManagerLifecycleTest (account,
                                                                          network,
@@ -1617,9 +2020,163 @@ runCryptoTestsWithAccountAndNetwork (BRCryptoAccount account,
     return success;
 }
 
+///
+/// Mark: Create Multiple
+///
+
+// Each index is reported once, on one worker; no two workers write the same element
+static BRCryptoWalletManager *createMultipleReported;
+
+static void
+_CWMCreateMultipleCallback (BRCryptoCWMListenerContext context,
+                            size_t index,
+                            BRCryptoNetwork network,
+                            BRCryptoWalletManager manager) {
+    createMultipleReported[index] = manager;
+}
+
+// The receive address of `manager`'s primary wallet, to compare managers
+static char *
+CWMCreateMultipleAddress (BRCryptoWalletManager manager) {
+    BRCryptoWallet  wallet  = cryptoWalletManagerGetWallet (manager);
+    BRCryptoAddress address = cryptoWalletGetAddress (wallet, cryptoWalletManagerGetAddressScheme (manager));
+    char *result = cryptoAddressAsString (address);
+    cryptoAddressGive (address);
+    cryptoWalletGive (wallet);
+    return result;
+}
+
+extern BRCryptoBoolean
+runCryptoWalletManagerCreateMultipleTest (BRCryptoAccount account,
+                                          BRCryptoNetwork *networks,
+                                          const BRCryptoSyncMode *modes,
+                                          const BRCryptoAddressScheme *schemes,
+                                          size_t networksCount,
+                                          const char *storagePath) {
+    printf("Testing BRCryptoWalletManager create multiple for %zu networks...\n", networksCount);
+    int success = 1;
+
+    CWMEventRecordingState state = {0};
+    CWMEventRecordingStateNew (&state, CRYPTO_TRUE);
+
+    // One at a time
+    char  *addresses[networksCount];
+    size_t transfersCounts[networksCount];
+    for (size_t index = 0; index < networksCount; index++) {
+        BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForLifecycleTest (&state, account, networks[index], modes[index], schemes[index], storagePath);
+        assert (NULL != manager);
+
+        BRCryptoWallet wallet  = cryptoWalletManagerGetWallet (manager);
+        addresses[index]       = CWMCreateMultipleAddress (manager);
+        transfersCounts[index] = cryptoWalletGetTransferCount (wallet);
+        cryptoWalletGive (wallet);
+
+        cryptoWalletManagerStop (manager);
+        cryptoWalletManagerGive (manager);
+    }
+
+    // Concurrently, one worker per network
+    BRCryptoWalletManager managers[networksCount];
+    BRCryptoWalletManager reported[networksCount];
+    createMultipleReported = reported;
+    memset (reported, 0, sizeof (reported));
+
+    BRCryptoCWMListener listener = (BRCryptoCWMListener) {
+        &state,
+        _CWMEventRecordingManagerCallback,
+        _CWMEventRecordingWalletCallback,
+        _CWMEventRecordingTransferCallback,
+    };
+
+    BRCryptoClient client = (BRCryptoClient) {
+        &state,
+        _CWMNopGetBlockNumberCallback,
+        _CWMNopGetTransactionsCallback,
+        _CWMNopGetTransfersCallback,
+        _CWMNopSubmitTransactionCallback,
+        _CWMNopEstimateTransactionFeeCallback
+    };
+
+    size_t created = cryptoWalletManagerCreateMultiple (listener, client, account,
+                                                        networks, modes, schemes, networksCount,
+                                                        storagePath, 0,
+                                                        _CWMCreateMultipleCallback,
+                                                        managers);
+    success = (created == networksCount);
+
+    for (size_t index = 0; success && index < networksCount; index++) {
+        BRCryptoNetwork network = cryptoWalletManagerGetNetwork (managers[index]);
+        BRCryptoWallet  wallet  = cryptoWalletManagerGetWallet  (managers[index]);
+        char *address = CWMCreateMultipleAddress (managers[index]);
+
+        success = (reported[index] == managers[index] &&
+                   network == networks[index] &&
+                   0 == strcmp (address, addresses[index]) &&
+                   cryptoWalletGetTransferCount (wallet) == transfersCounts[index]);
+        if (!success)
+            fprintf(stderr, "***FAILED*** %s: %s differs from one created alone\n", __func__, cryptoNetworkGetName (networks[index]));
+
+        free (address);
+        cryptoWalletGive  (wallet);
+        cryptoNetworkGive (network);
+    }
+
+    for (size_t index = 0; index < networksCount; index++) {
+        if (NULL != managers[index]) {
+            cryptoWalletManagerStop (managers[index]);
+            cryptoWalletManagerGive (managers[index]);
+        }
+        if (NULL != reported[index]) cryptoWalletManagerGive (reported[index]);
+        free (addresses[index]);
+    }
+    createMultipleReported = NULL;
+    CWMEventRecordingStateFree (&state);
+
+    return AS_CRYPTO_BOOLEAN (success);
+}
+
+///
+/// Mark: Startup Profile
+///
+
+extern void
+runCryptoWalletManagerStartupProfile (BRCryptoAccount account,
+                                      BRCryptoNetwork network,
+                                      BRCryptoSyncMode mode,
+                                      BRCryptoAddressScheme scheme,
+                                      const char *storagePath) {
+    CWMEventRecordingState state = {0};
+    CWMEventRecordingStateNewDefault (&state);
+
+    BRCryptoWalletManager manager = BRCryptoWalletManagerSetupForLifecycleTest (&state, account, network, mode, scheme, storagePath);
+    if (NULL == manager) {
+        printf ("%s: no manager\n", cryptoNetworkGetName (network));
+        CWMEventRecordingStateFree (&state);
+        return;
+    }
+
+    size_t phasesCount = cryptoWalletManagerGetStartupPhases (manager, NULL, 0);
+    BRCryptoWalletManagerPhase *phases = calloc (phasesCount > 0 ? phasesCount : 1, sizeof (BRCryptoWalletManagerPhase));
+    cryptoWalletManagerGetStartupPhases (manager, phases, phasesCount);
+
+    printf ("%s (%s):\n", cryptoNetworkGetName (network), cryptoSyncModeString (mode));
+    for (size_t index = 0; index < phasesCount; index++)
+        printf ("%*s%-*s %10.3f ms\n",
+                (int) (2 * phases[index].depth + 2), "",
+                (int) (40 - 2 * phases[index].depth), phases[index].name,
+                (double) phases[index].duration / 1e6);
+    free (phases);
+
+    cryptoWalletManagerStop (manager);
+    cryptoWalletManagerGive (manager);
+    CWMEventRecordingStateFree (&state);
+}
+
 extern void
 runCryptoTests (void) {
     runCryptoAmountTests ();
     runCryptoTransferTests();
+    runCryptoWalletTests();
+    runCryptoSigningSessionTests ();
     return;
 }
@@ -486,6 +486,11 @@ void testTransactionCodingToken () {
     assert (ETHEREUM_BOOLEAN_TRUE == addressEqual(transactionGetTargetAddress(transaction),
                                                      transactionGetTargetAddress(decodedTransaction)));
 #endif
+    // Data - the ERC20 `transfer` call, held as bytes and reproduced as hex
+    assert (NULL != transactionGetData(decodedTransaction));
+    assert (0 == strcmp (transactionGetData(transaction),
+                         transactionGetData(decodedTransaction)));
+
     // Signature
     assert (ETHEREUM_BOOLEAN_TRUE == ethSignatureEqual(transactionGetSignature (transaction),
                                                     transactionGetSignature (decodedTransaction)));
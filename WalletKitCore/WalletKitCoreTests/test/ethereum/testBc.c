@@ -313,6 +313,12 @@ runBlockTransactionTest (void) {
 #define LOG_1_TOPIC_0 "000000000000000000000000459d3a7595df9eba241365f4676803586d7d199c"
 #define LOG_1_TOPIC_1 "436f696e73000000000000000000000000000000000000000000000000000000"
 
+#define LOG_2_ADDRESS "0x96477a1c968a0e64e53b7ed01d0d6e4a311945c2"
+#define LOG_2_TOPIC_0 "0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925"
+#define LOG_2_TOPIC_1 "0x0000000000000000000000005c0f318407f37029f2a2b6b29468b79fbd178f2a"
+#define LOG_2_TOPIC_2 "0x000000000000000000000000642ae78fafbb8032da552d619ad43f1d81e4dd7c"
+#define LOG_2_DATA    "00000000000000000000000000000000000000000000000006f05b59d3b20000"
+
 extern void
 runLogTests (void) {
     printf ("==== Log\n");
@@ -385,6 +391,74 @@ runLogTests (void) {
 
     rlpDataRelease(encodeData);
     rlpDataRelease(data);
+
+    // Known Topics - each is the hash of its event signature
+    for (size_t index = 0; index < logTopicGetKnownCount(); index++) {
+        BREthereumLogTopic topic;
+        const char *signature = logTopicGetKnown (index, &topic);
+
+        BREthereumHash hash = ethHashCreateFromData ((BRRlpData) { strlen (signature), (uint8_t *) signature });
+        assert (0 == memcmp (hash.bytes, topic.bytes, LOG_TOPIC_BYTES_COUNT));
+    }
+
+    // An ERC20 Approval - topic-0 is known
+    BREthereumLogTopic topics[3] = {
+        logTopicCreateFromString (LOG_2_TOPIC_0),
+        logTopicCreateFromString (LOG_2_TOPIC_1),
+        logTopicCreateFromString (LOG_2_TOPIC_2)
+    };
+
+    size_t valueBytesCount;
+    uint8_t *valueBytes = hexDecodeCreate (&valueBytesCount, LOG_2_DATA, strlen (LOG_2_DATA));
+    BRRlpItem valueItem = rlpEncodeBytes (coder, valueBytes, valueBytesCount);
+    BRRlpData value = rlpItemGetData (coder, valueItem);
+    rlpItemRelease (coder, valueItem);
+    free (valueBytes);
+
+    BREthereumLog logKnown = logCreate (ethAddressCreate (LOG_2_ADDRESS), 3, topics, value);
+    logInitializeIdentifier (logKnown, someTxHash, 1);
+    logSetStatus (logKnown, status);
+
+    BREthereumLog logKnownCopy = logCopy (logKnown);
+
+    item = logRlpEncode (logKnown, RLP_TYPE_ARCHIVE, coder);
+    BREthereumLog logKnownArchived = logRlpDecode (item, RLP_TYPE_ARCHIVE, coder);
+    rlpItemRelease (coder, item);
+
+    BREthereumLog logsKnown[] = { logKnown, logKnownCopy, logKnownArchived };
+    for (size_t index = 0; index < sizeof (logsKnown) / sizeof (BREthereumLog); index++) {
+        BREthereumLog l = logsKnown[index];
+
+        assert (ETHEREUM_BOOLEAN_IS_TRUE (ethAddressEqual (ethAddressCreate (LOG_2_ADDRESS), logGetAddress (l))));
+        assert (3 == logGetTopicsCount (l));
+        for (size_t topic = 0; topic < 3; topic++)
+            assert (0 == memcmp (topics[topic].bytes, logGetTopic (l, topic).bytes, LOG_TOPIC_BYTES_COUNT));
+
+        BRRlpData lData = logGetDataShared (l);
+        assert (value.bytesCount == lData.bytesCount && 0 == memcmp (value.bytes, lData.bytes, value.bytesCount));
+
+        assert (ETHEREUM_BOOLEAN_IS_TRUE (ethHashEqual (logGetHash (logKnown), logGetHash (l))));
+        assert (ETHEREUM_BOOLEAN_IS_TRUE (logMatchesAddress (l, logTopicAsAddress (topics[2]), ETHEREUM_BOOLEAN_TRUE)));
+    }
+
+    // A log with more topics than the EVM can emit is rejected on decode
+    BREthereumLogTopic topicsTooMany[LOG_TOPICS_MAX_COUNT + 1];
+    for (size_t index = 0; index <= LOG_TOPICS_MAX_COUNT; index++)
+        topicsTooMany[index] = topics[1];
+
+    BREthereumLog logTooMany = logCreate (ethAddressCreate (LOG_2_ADDRESS), LOG_TOPICS_MAX_COUNT + 1, topicsTooMany, value);
+    item = logRlpEncode (logTooMany, RLP_TYPE_NETWORK, coder);
+    assert (NULL == logRlpDecode (item, RLP_TYPE_NETWORK, coder));
+    rlpItemRelease (coder, item);
+    logRelease (logTooMany);
+
+    logRelease (logKnownArchived);
+    logRelease (logKnownCopy);
+    logRelease (logKnown);
+    logRelease (logArchived);
+    logRelease (log);
+
+    rlpDataRelease(value);
     rlpCoderRelease(coder);
 }
 
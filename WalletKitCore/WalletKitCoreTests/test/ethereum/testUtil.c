@@ -440,6 +440,43 @@ runMathParseTests () {
     assert (CORE_PARSE_UNDERFLOW == status);
 
 
+    // Decimal strings, across chunk boundaries
+    r = uint256CreateParse("10000000000000000000", 10, &status);  // 10^19
+    assert (CORE_PARSE_OK == status && 0 == r.u64[1] && 10000000000000000000u == r.u64[0]);
+    s = uint256CoerceString(r, 10);
+    assert (0 == strcmp ("10000000000000000000", s));
+    free (s);
+
+    r = uint256CreateParse("18446744073709551616", 10, &status);  // 2^64
+    assert (CORE_PARSE_OK == status && 1 == r.u64[1] && 0 == r.u64[0]);
+    s = uint256CoerceString(r, 10);
+    assert (0 == strcmp ("18446744073709551616", s));
+    free (s);
+
+    r = uint256CreateParse("115792089237316195423570985008687907853269984665640564039457584007913129639936", 10, &status);
+    assert (CORE_PARSE_OVERFLOW == status);
+
+    r = uint256Create (1234500);
+    s = uint256CoerceStringDecimal(r, 2);
+    assert (0 == strcmp ("12345.00", s));
+    free (s);
+
+    s = uint256CoerceStringDecimal(r, 7);
+    assert (0 == strcmp ("0.1234500", s));
+    free (s);
+
+    s = uint256CoerceStringDecimal(r, 10);
+    assert (0 == strcmp ("0.0001234500", s));
+    free (s);
+
+    s = uint256CoerceStringDecimal(UINT256_ZERO, 3);
+    assert (0 == strcmp ("0.000", s));
+    free (s);
+
+    s = uint256CoerceStringDecimal(r, 0);
+    assert (0 == strcmp ("1234500", s));
+    free (s);
+
     // Strings for: 0xa
 
     r = uint256CreateParse("0xa", 16, &status);
@@ -24,6 +24,8 @@
 #include "hedera/BRHederaTransaction.h"
 #include "hedera/BRHederaAccount.h"
 #include "hedera/BRHederaWallet.h"
+#include "hedera/BRHederaSerialize.h"
+#include "generic/BRGenericHedera.h"
 
 static int debug_log = 0;
 
@@ -251,6 +253,41 @@ static void transaction_value_test(const char * source, const char * target, con
     hederaTransactionFree (transaction);
 }
 
+static void transactionUnpackTest(const char * source, const char * target, const char * node,
+                                  int64_t amount, int64_t seconds, int32_t nanos, int64_t fee)
+{
+    BRHederaTransaction transaction = createSignedTransaction(source, target, node, amount, seconds, nanos, fee, "unpack");
+
+    // The serialized bytes are prefixed with the node account id
+    size_t serializedSize = 0;
+    uint8_t * serializedBytes = hederaTransactionSerialize(transaction, &serializedSize);
+    assert (serializedSize > HEDERA_ADDRESS_SERIALIZED_SIZE);
+
+    BRHederaAddress sourceAddress, targetAddress, nodeAddress;
+    BRHederaUnitTinyBar txAmount, txFee;
+    BRHederaTimeStamp timeStamp;
+    assert (1 == hederaTransactionUnpack (serializedBytes + HEDERA_ADDRESS_SERIALIZED_SIZE,
+                                          serializedSize - HEDERA_ADDRESS_SERIALIZED_SIZE,
+                                          &sourceAddress, &targetAddress, &nodeAddress,
+                                          &txAmount, &txFee, &timeStamp));
+    assert (txAmount == amount);
+    assert (txFee == fee);
+    assert (timeStamp.seconds == seconds && timeStamp.nano == nanos);
+    assert (1 == checkAddress (sourceAddress, source));
+    assert (1 == checkAddress (targetAddress, target));
+    assert (1 == checkAddress (nodeAddress, node));
+
+    // Truncated bytes don't unpack
+    assert (0 == hederaTransactionUnpack (serializedBytes + HEDERA_ADDRESS_SERIALIZED_SIZE, 10,
+                                          &sourceAddress, &targetAddress, &nodeAddress,
+                                          &txAmount, &txFee, &timeStamp));
+
+    hederaAddressFree (sourceAddress);
+    hederaAddressFree (targetAddress);
+    hederaAddressFree (nodeAddress);
+    hederaTransactionFree (transaction);
+}
+
 static void createExistingTransaction(const char * sourceUserName, const char *targetUserName, int64_t amount)
 {
     struct account_info sourceAccountInfo  = find_account (sourceUserName);
@@ -512,6 +549,47 @@ static void walletBalanceTests()
     hederaTransactionFree(tx4);
 }
 
+static void walletTransactionIdTests()
+{
+    BRHederaAccount account = getAccount ("patient"); // Our wallet account
+    BRHederaWallet wallet = hederaWalletCreate (account);
+
+    // A transfer created locally, with an ID, and the same transfer recovered without one
+    BRHederaTransaction tx1 = createSignedTransaction("choose", "patient", "node3", 2000000000, 1, 0, 500000, NULL);
+    BRHederaAddress source = hederaTransactionGetSource(tx1);
+    BRHederaAddress target = hederaTransactionGetTarget(tx1);
+    BRHederaTransaction tx2 = hederaTransactionCreate(source, target, 2000000000, 500000, NULL,
+                                                      hederaTransactionGetHash(tx1), 1, 0, 0);
+    char * txId1 = hederaTransactionGetTransactionId(tx1);
+    char * txId2 = hederaTransactionGetTransactionId(tx2);
+    assert(NULL != txId1 && NULL == txId2);
+    free(txId1);
+    assert(hederaTransactionEqual(tx1, tx2));
+    assert(hederaTransactionEqual(tx2, tx1));
+    assert(hederaTransactionHashValue(tx1) == hederaTransactionHashValue(tx2));
+
+    // The wallet finds each as the other, and adds the transfer once
+    hederaWalletAddTransfer(wallet, tx1);
+    assert(hederaWalletHasTransfer(wallet, tx2));
+    hederaWalletAddTransfer(wallet, tx2);
+    assert(hederaWalletGetBalance (wallet) == 2000000000L);
+
+    // The other way around
+    BRHederaWallet wallet2 = hederaWalletCreate (account);
+    hederaWalletAddTransfer(wallet2, tx2);
+    assert(hederaWalletHasTransfer(wallet2, tx1));
+    hederaWalletAddTransfer(wallet2, tx1);
+    assert(hederaWalletGetBalance (wallet2) == 2000000000L);
+
+    hederaAddressFree (source);
+    hederaAddressFree (target);
+    hederaAccountFree (account);
+    hederaWalletFree (wallet);
+    hederaWalletFree (wallet2);
+    hederaTransactionFree(tx1);
+    hederaTransactionFree(tx2);
+}
+
 static void create_real_transactions() {
     // use the function to create sendable transactions to the hedera network
     time_t now;
@@ -576,17 +654,75 @@ static void nodeAddressTest()
     hederaAddressFree(address);
 }
 
+static void transferRecoverBinaryTests()
+{
+    const char * hashString = "a8c6c1e5a3b1d8b5b47e3f35e0b0e8ee8f2d4cb6b1b52e0f2a54b8a12e0b4b1cc4e2a3f8b1d6e7a9c3b5d2e1f0a9b8c7";
+    uint8_t hash[48], sourceBytes[HEDERA_ADDRESS_SERIALIZED_SIZE], targetBytes[HEDERA_ADDRESS_SERIALIZED_SIZE];
+    hex2bin(hashString, hash);
+
+    BRHederaAddress source = hederaAddressCreateFromString("0.0.114008", true);
+    BRHederaAddress target = hederaAddressCreateFromString("0.0.114009", true);
+    hederaAddressSerialize(source, sourceBytes, sizeof(sourceBytes));
+    hederaAddressSerialize(target, targetBytes, sizeof(targetBytes));
+
+    UInt256 amount = UINT256_ZERO, fee = UINT256_ZERO;
+    amount.u64[0] = 10000000;
+    fee.u64[0] = 500000;
+
+    // The binary values recover the same transfer as their strings
+    BRHederaTransaction transaction = (BRHederaTransaction) genericHederaHandlers->manager.transferRecover
+        (hashString, "0.0.114008", "0.0.114009", "10000000", "hbar", "500000", 1571928273, 100, 0);
+    BRHederaTransaction binary = (BRHederaTransaction) genericHederaHandlers->manager.transferRecoverBinary
+        (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0);
+    assert(NULL != binary);
+    assert(hederaTransactionGetAmount(transaction) == hederaTransactionGetAmount(binary));
+    assert(hederaTransactionGetFee(transaction) == hederaTransactionGetFee(binary));
+    assert(0 == memcmp(hederaTransactionGetHash(transaction).bytes, hederaTransactionGetHash(binary).bytes, 48));
+
+    BRHederaAddress binarySource = hederaTransactionGetSource(binary);
+    BRHederaAddress binaryTarget = hederaTransactionGetTarget(binary);
+    assert(1 == hederaAddressEqual(source, binarySource));
+    assert(1 == hederaAddressEqual(target, binaryTarget));
+    hederaAddressFree(binarySource);
+    hederaAddressFree(binaryTarget);
+    hederaTransactionFree(binary);
+    hederaTransactionFree(transaction);
+
+    // A missing or short hash, a short address and values beyond a tinybar's int64_t fail, without asserting
+    UInt256 large = amount, signedLarge = UINT256_ZERO;
+    large.u64[1] = 1;
+    signedLarge.u64[0] = (uint64_t) INT64_MAX + 1;
+    assert(NULL == genericHederaHandlers->manager.transferRecoverBinary
+           (NULL, 0, sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0));
+    assert(NULL == genericHederaHandlers->manager.transferRecoverBinary
+           (hash, 32, sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0));
+    assert(NULL == genericHederaHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, 8, amount, fee, 1571928273, 100, 0));
+    assert(NULL == genericHederaHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), large, fee, 1571928273, 100, 0));
+    assert(NULL == genericHederaHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), signedLarge, fee, 1571928273, 100, 0));
+    assert(NULL == genericHederaHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, large, 1571928273, 100, 0));
+
+    hederaAddressFree(source);
+    hederaAddressFree(target);
+}
+
 static void wallet_tests()
 {
     createAndDeleteWallet();
     walletBalanceTests();
+    walletTransactionIdTests();
     nodeAddressTest();
+    transferRecoverBinaryTests();
 }
 
 static void transaction_tests() {
     createExistingTransaction("patient", "choose", 400);
     create_new_transactions();
     transaction_value_test("patient", "choose", "node3", 10000000, 25, 4, 500000);
+    transactionUnpackTest("patient", "choose", "node3", 10000000, 1571928273, 500, 500000);
     //create_real_transactions();
 }
 
@@ -606,3 +742,56 @@ runHederaTest (void /* ... */) {
     transaction_tests();
     txIDTests();
 }
+
+// Serialize (pack the body, sign and pack the transaction) and deserialize (unpack the
+// transaction and its body) a crypto transfer `repeat` times each, reporting ops/sec.
+extern void
+runHederaPerfTestsSerialize (int repeat) {
+    struct account_info source_account = find_account ("patient");
+    struct account_info target_account = find_account ("choose");
+    struct account_info node_account = find_account ("node3");
+
+    BRHederaAddress source = hederaAddressCreateFromString (source_account.account_string, true);
+    BRHederaAddress target = hederaAddressCreateFromString (target_account.account_string, true);
+    BRHederaAddress node = hederaAddressCreateFromString (node_account.account_string, true);
+    BRHederaTimeStamp timeStamp = { 1571928273, 500 };
+    uint8_t signature[64] = { 0 }, publicKey[32] = { 0 };
+    struct timespec start, end;
+    double elapsed;
+
+    size_t bodySize = 0, serializedSize = 0;
+    uint8_t * body = NULL, * serializedBytes = NULL;
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < repeat; i++) {
+        body = hederaTransactionBodyPack (source, target, node, 1000000, timeStamp, 500000, "memo", &bodySize);
+        serializedBytes = hederaTransactionPack (signature, 64, publicKey, 32, body, bodySize, &serializedSize);
+        free (body);
+        if (i + 1 < repeat) free (serializedBytes);
+    }
+    clock_gettime (CLOCK_MONOTONIC, &end);
+    elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec)/1e9;
+    printf ("Hedera serialize: %.0f ops/s\n", repeat / elapsed);
+
+    BRHederaAddress unpackSource, unpackTarget, unpackNode;
+    BRHederaUnitTinyBar amount, fee;
+
+    clock_gettime (CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < repeat; i++) {
+        int success = hederaTransactionUnpack (serializedBytes, serializedSize,
+                                               &unpackSource, &unpackTarget, &unpackNode,
+                                               &amount, &fee, &timeStamp);
+        assert (success);
+        hederaAddressFree (unpackSource);
+        hederaAddressFree (unpackTarget);
+        hederaAddressFree (unpackNode);
+    }
+    clock_gettime (CLOCK_MONOTONIC, &end);
+    elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec)/1e9;
+    printf ("Hedera deserialize: %.0f ops/s\n", repeat / elapsed);
+
+    free (serializedBytes);
+    hederaAddressFree (source);
+    hederaAddressFree (target);
+    hederaAddressFree (node);
+}
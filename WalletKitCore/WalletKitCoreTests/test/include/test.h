@@ -94,6 +94,8 @@ extern int BRRunTestsBWM (const char *paperKey,
                           int isBTC,
                           int isMainnet);
 
+extern void BRRunPerfTestsHeaderParse (int repeat);
+
 extern void BRRandInit (void);
 
 // testCrypto.c
@@ -104,6 +106,24 @@ runCryptoTestsWithAccountAndNetwork (BRCryptoAccount account,
                                      BRCryptoNetwork network,
                                      const char *storagePath);
 
+/// Create managers for `networks` with `cryptoWalletManagerCreateMultiple()` and compare them to
+/// managers created one at a time
+extern BRCryptoBoolean
+runCryptoWalletManagerCreateMultipleTest (BRCryptoAccount account,
+                                          BRCryptoNetwork *networks,
+                                          const BRCryptoSyncMode *modes,
+                                          const BRCryptoAddressScheme *schemes,
+                                          size_t networksCount,
+                                          const char *storagePath);
+
+/// Create a manager and print the phases of its creation
+extern void
+runCryptoWalletManagerStartupProfile (BRCryptoAccount account,
+                                      BRCryptoNetwork network,
+                                      BRCryptoSyncMode mode,
+                                      BRCryptoAddressScheme scheme,
+                                      const char *storagePath);
+
 // Ripple
 extern void
 runRippleTest (void /* ... */);
@@ -112,6 +132,9 @@ runRippleTest (void /* ... */);
 extern void
 runHederaTest (void);
 
+extern void
+runHederaPerfTestsSerialize (int repeat);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,8 @@
 #include "support/BRBIP39WordsEn.h"
 #include "support/BRKey.h"
 #include "ripple/BRRipple.h"
+#include "generic/BRGenericTransferStore.h"
+#include "generic/BRGenericRipple.h"
 
 #include "testRippleTxList1.h"
 #include "testRippleTxList2.h"
@@ -827,11 +829,169 @@ void rippleTransactionTests()
     testTransactionDeserialize1(tx_two);
 }
 
+static int64_t storeTestValues[] = { 5, 3, 9, 3, 1, 7 };
+
+static size_t storeTestHash (const void *value) { return (size_t) (*(const int64_t *) value); }
+static int storeTestEqual (const void *v1, const void *v2) { return *(const int64_t *) v1 == *(const int64_t *) v2; }
+static int storeTestCompare (const void *v1, const void *v2) {
+    int64_t n1 = *(const int64_t *) v1, n2 = *(const int64_t *) v2;
+    return (n1 < n2 ? -1 : (n1 > n2 ? 1 : 0));
+}
+
+static void testTransferStore()
+{
+    BRGenericTransferStore store = genTransferStoreCreate ((BRGenericTransferStoreHandlers) {
+        storeTestHash,
+        storeTestEqual,
+        storeTestCompare
+    }, 1);
+
+    // The second '3' is a duplicate and is not added
+    size_t added = 0;
+    for (size_t index = 0; index < sizeof (storeTestValues) / sizeof (int64_t); index++)
+        added += genTransferStoreAdd (store, &storeTestValues[index]);
+    assert (5 == added && 5 == genTransferStoreCount (store));
+    assert (genTransferStoreHas (store, &storeTestValues[3]));
+    assert (&storeTestValues[1] == genTransferStoreGet (store, &storeTestValues[3]));
+
+    // Pages of two, in order
+    int64_t *page[2];
+    assert (2 == genTransferStoreGetRange (store, 0, (void **) page, 2) && 1 == *page[0] && 3 == *page[1]);
+    assert (2 == genTransferStoreGetRange (store, 2, (void **) page, 2) && 5 == *page[0] && 7 == *page[1]);
+    assert (1 == genTransferStoreGetRange (store, 4, (void **) page, 2) && 9 == *page[0]);
+    assert (0 == genTransferStoreGetRange (store, 5, (void **) page, 2));
+
+    assert (&storeTestValues[2] == genTransferStoreRemove (store, &storeTestValues[2]));
+    assert (NULL == genTransferStoreRemove (store, &storeTestValues[2]));
+    assert (4 == genTransferStoreCount (store) && 7 == *(int64_t *) genTransferStoreGetAt (store, 3));
+
+    genTransferStoreRelease (store);
+}
+
+static void testWalletTransfers()
+{
+    const char * paper_key = "patient doctor olympic frog force glimpse endless antenna online dragon bargain someone";
+    BRRippleAccount account = rippleAccountCreate(paper_key);
+    BRRippleAddress address = rippleAccountGetPrimaryAddress(account);
+    BRRippleWallet wallet = rippleWalletCreate(account);
+
+    const char * target_paper_key = "choose color rich dose toss winter dutch cannon over air cash market";
+    BRRippleAccount targetAccount = rippleAccountCreate(target_paper_key);
+    BRRippleAddress targetAddress = rippleAccountGetPrimaryAddress(targetAccount);
+
+    // Receive 100 drops in each of 200 blocks, newest first, then send 10 drops back in every
+    // other block; each transfer is added twice.
+    BRRippleTransactionHash hash;
+    memset (hash.bytes, 0, sizeof (hash.bytes));
+    for (uint64_t index = 0; index < 200; index++) {
+        hash.bytes[0] = (uint8_t) index;
+        hash.bytes[1] = 0;
+        BRRippleTransfer transfer = rippleTransferCreate(targetAddress, address, 100, 0, hash, 0, 1000 - index, 0);
+        rippleWalletAddTransfer(wallet, transfer);
+        rippleWalletAddTransfer(wallet, transfer);
+        assert(rippleWalletHasTransfer(wallet, transfer));
+        rippleTransferFree(transfer);
+
+        if (0 == index % 2) {
+            hash.bytes[1] = 1;
+            transfer = rippleTransferCreate(address, targetAddress, 10, 2, hash, 0, 1000 - index, 0);
+            rippleWalletAddTransfer(wallet, transfer);
+            rippleWalletAddTransfer(wallet, transfer);
+            rippleTransferFree(transfer);
+        }
+    }
+    assert(200 * 100 - 100 * 12 == rippleWalletGetBalance(wallet));
+    assert(100 == rippleAccountGetSequence(account));
+
+    // Remove a send
+    hash.bytes[0] = 10;
+    hash.bytes[1] = 1;
+    BRRippleTransfer transfer = rippleTransferCreate(address, targetAddress, 10, 2, hash, 0, 990, 0);
+    assert(rippleWalletHasTransfer(wallet, transfer));
+    rippleWalletRemTransfer(wallet, transfer);
+    assert(!rippleWalletHasTransfer(wallet, transfer));
+    rippleTransferFree(transfer);
+    assert(200 * 100 - 99 * 12 == rippleWalletGetBalance(wallet));
+    assert(99 == rippleAccountGetSequence(account));
+
+    rippleAddressFree(address);
+    rippleAddressFree(targetAddress);
+    rippleAccountFree(targetAccount);
+    rippleWalletFree(wallet);
+    rippleAccountFree(account);
+}
+
+static void testTransferRecoverBinary()
+{
+    const char * hashString   = "b52a3f6a3a6ac35c4e6a1e4ac0c2f4a7c04e3b3bd6c9bd8b4ab2a7a0c6a1e1d2";
+    const char * sourceString = "rw2ciyaNshpHe7bCHo4bRWq6pqqynnWKQg";
+    const char * targetString = "rpFRjDTUmUdVgMjwurx3osy4rNmXsoz7FE";
+
+    BRRippleAddress source = rippleAddressCreateFromString(sourceString, false);
+    BRRippleAddress target = rippleAddressCreateFromString(targetString, false);
+
+    uint8_t hash[32], sourceBytes[RIPPLE_ADDRESS_BYTES], targetBytes[RIPPLE_ADDRESS_BYTES];
+    hex2bin(hashString, hash);
+    rippleAddressGetRawBytes(source, sourceBytes, RIPPLE_ADDRESS_BYTES);
+    rippleAddressGetRawBytes(target, targetBytes, RIPPLE_ADDRESS_BYTES);
+
+    UInt256 amount = UINT256_ZERO, fee = UINT256_ZERO;
+    amount.u64[0] = 1000000;
+    fee.u64[0] = 12;
+
+    // The binary values recover the same transfer as their strings
+    BRRippleTransfer transfer = (BRRippleTransfer) genericRippleHandlers->manager.transferRecover
+        (hashString, sourceString, targetString, "1000000", "xrp", "12", 1571928273, 100, 0);
+    BRRippleTransfer binary = (BRRippleTransfer) genericRippleHandlers->manager.transferRecoverBinary
+        (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0);
+    assert(NULL != binary);
+    assert(rippleTransferGetAmount(transfer) == rippleTransferGetAmount(binary));
+    assert(rippleTransferGetFee(transfer) == rippleTransferGetFee(binary));
+    assert(0 == memcmp(rippleTransferGetTransactionId(transfer).bytes, rippleTransferGetTransactionId(binary).bytes, 32));
+
+    BRRippleAddress binarySource = rippleTransferGetSource(binary);
+    BRRippleAddress binaryTarget = rippleTransferGetTarget(binary);
+    assert(1 == rippleAddressEqual(source, binarySource));
+    assert(1 == rippleAddressEqual(target, binaryTarget));
+    rippleAddressFree(binarySource);
+    rippleAddressFree(binaryTarget);
+    rippleTransferFree(binary);
+    rippleTransferFree(transfer);
+
+    // A `to` of no bytes is the fee address
+    binary = (BRRippleTransfer) genericRippleHandlers->manager.transferRecoverBinary
+        (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), NULL, 0, fee, UINT256_ZERO, 1571928273, 100, 0);
+    binaryTarget = rippleTransferGetTarget(binary);
+    assert(1 == rippleAddressIsFeeAddress(binaryTarget));
+    rippleAddressFree(binaryTarget);
+    rippleTransferFree(binary);
+
+    // A missing or short hash, a short address and values beyond 64 bits fail, without asserting
+    UInt256 large = amount;
+    large.u64[1] = 1;
+    assert(NULL == genericRippleHandlers->manager.transferRecoverBinary
+           (NULL, 0, sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0));
+    assert(NULL == genericRippleHandlers->manager.transferRecoverBinary
+           (hash, 31, sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0));
+    assert(NULL == genericRippleHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, 19, targetBytes, sizeof(targetBytes), amount, fee, 1571928273, 100, 0));
+    assert(NULL == genericRippleHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), large, fee, 1571928273, 100, 0));
+    assert(NULL == genericRippleHandlers->manager.transferRecoverBinary
+           (hash, sizeof(hash), sourceBytes, sizeof(sourceBytes), targetBytes, sizeof(targetBytes), amount, large, 1571928273, 100, 0));
+
+    rippleAddressFree(source);
+    rippleAddressFree(target);
+}
+
 static void runWalletTests()
 {
     createAndDeleteWallet();
     testWalletValues();
     testWalletAddress();
+    testTransferStore();
+    testWalletTransfers();
+    testTransferRecoverBinary();
 }
 
 static void comparebuffers(const char *input, uint8_t * output, size_t outputSize)
@@ -20,6 +20,9 @@
 #include "support/BRFileService.h"
 #include "support/BRAssert.h"
 #include "support/BROSCompat.h"
+#include "support/BRProfile.h"
+#include "support/BRMetrics.h"
+#include "support/BRCapture.h"
 
 /// MARK: - File Service Tests
 
@@ -517,6 +520,181 @@ runSupAssertTests (void) {
     return success;
 }
 
+/// MARK: - Profile Tests
+
+static int
+runSupProfileTests (void) {
+    printf ("==== SUP: Profile\n");
+
+    // With no current profile nothing is recorded
+    if (BR_PROFILE_SPAN_NONE != BRProfileBegin ("none")) return 0;
+
+    BRProfile profile = BRProfileNew();
+    if (NULL != BRProfileSetCurrent (profile)) return 0;
+
+    BRProfileSpan outer = BRProfileBegin ("outer");
+    BRProfileSpan inner = BRProfileBegin ("inner");
+    usleep (1000);
+    BRProfileEnd (inner);
+    inner = BRProfileBegin ("inner");
+    BRProfileBegin ("open");            // ended with `outer`
+    BRProfileEnd (outer);
+    BRProfileSpan after = BRProfileBegin ("after");
+    BRProfileEnd (after);
+
+    if (profile != BRProfileSetCurrent (NULL)) return 0;
+    BRProfileEnd (inner);               // not current; ignored
+
+    if (5 != BRProfileGetPhaseCount (profile)) return 0;
+
+    size_t depths[5] = { 0, 1, 1, 2, 0 };
+    for (size_t index = 0; index < 5; index++) {
+        BRProfilePhase phase = BRProfileGetPhase (profile, index);
+        if (depths[index] != phase.depth || 0 == phase.duration) return 0;
+    }
+    if (BRProfileGetPhase (profile, 1).duration < 1000000) return 0;
+    if (BRProfileGetPhase (profile, 0).duration < BRProfileGetPhase (profile, 1).duration) return 0;
+
+    size_t count;
+    uint64_t total = BRProfileGetTotal (profile, "inner", &count);
+    if (2 != count || total < BRProfileGetPhase (profile, 1).duration) return 0;
+
+    BRProfilePrint (profile, "SUP: Profile", stdout);
+    BRProfileFree (profile);
+    return 1;
+}
+
+/// MARK: - Metrics Tests
+
+#define SUP_METRICS_THREADS         (4)
+#define SUP_METRICS_UPDATES         (100000)
+
+static void *
+runSupMetricsThread (BRMetrics metrics) {
+    // Look up by name on each thread; all get the same counter
+    BRMetricsCounter counter = BRMetricsGetCounter (metrics, "updates");
+    for (size_t index = 0; index < SUP_METRICS_UPDATES; index++)
+        BRMetricsCounterAdd (counter, 1);
+    return NULL;
+}
+
+static int
+runSupMetricsTests (void) {
+    printf ("==== SUP: Metrics\n");
+
+    // Without a registry, updates do nothing
+    if (NULL != BRMetricsGetCounter (NULL, "none")) return 0;
+    BRMetricsCounterAdd (NULL, 1);
+    BRMetricsHistogramRecord (NULL, 1);
+
+    BRMetrics metrics = BRMetricsNew();
+
+    pthread_t threads[SUP_METRICS_THREADS];
+    for (size_t index = 0; index < SUP_METRICS_THREADS; index++)
+        pthread_create (&threads[index], NULL, (void* (*) (void*)) runSupMetricsThread, metrics);
+    for (size_t index = 0; index < SUP_METRICS_THREADS; index++)
+        pthread_join (threads[index], NULL);
+
+    BRMetricsCounterSnapshot counter;
+    if (1 != BRMetricsGetCounterSnapshots (metrics, NULL, 0)) return 0;
+    if (1 != BRMetricsGetCounterSnapshots (metrics, &counter, 1)) return 0;
+    if (0 != strcmp ("updates", counter.name) ||
+        SUP_METRICS_THREADS * SUP_METRICS_UPDATES != counter.value) return 0;
+
+    BRMetricsHistogram histogram = BRMetricsGetHistogram (metrics, "values");
+    uint64_t values[] = { 0, 1, 2, 3, 1000, UINT64_MAX };
+    for (size_t index = 0; index < sizeof (values) / sizeof (uint64_t); index++)
+        BRMetricsHistogramRecord (histogram, values[index]);
+
+    BRMetricsHistogramSnapshot snapshot;
+    if (1 != BRMetricsGetHistogramSnapshots (metrics, &snapshot, 1)) return 0;
+    if (6 != snapshot.count ||
+        1 != snapshot.buckets[0] ||
+        1 != snapshot.buckets[1] ||
+        2 != snapshot.buckets[2] ||
+        1 != snapshot.buckets[10] ||
+        1 != snapshot.buckets[BR_METRICS_HISTOGRAM_BUCKETS - 1]) return 0;
+
+    BRMetricsFree (metrics);
+    return 1;
+}
+
+/// MARK: - Capture Tests
+
+#define SUP_CAPTURE_PATH        "supCapture.bin"
+
+static int
+runSupCaptureCheck (BRCaptureReplay replay,
+                    BRCaptureStream stream,
+                    const char *expected) {
+    const uint8_t *bytes;
+    size_t bytesCount;
+
+    return (BR_CAPTURE_REPLAY_READY == BRCaptureReplayNext (replay, stream, 0, &bytes, &bytesCount) &&
+            strlen (expected) == bytesCount &&
+            0 == memcmp (expected, bytes, bytesCount));
+}
+
+static int
+runSupCaptureTests (void) {
+    printf ("==== SUP: Capture\n");
+
+    // Without a capture, adds do nothing
+    BRCaptureAddRecv (NULL, 0, (const uint8_t *) "none", 4);
+
+    // Two peers: 'a' answers a request; 'b' just announces, in between 'a's request and response.
+    BRCapture capture = BRCaptureNew (SUP_CAPTURE_PATH);
+    if (NULL == capture) return 0;
+
+    BRCaptureStream a = BRCaptureOpenStream (capture, "a:1");
+    BRCaptureStream b = BRCaptureOpenStream (capture, "b:2");
+    BRCaptureAddRecv (capture, a, (const uint8_t *) "a-hello", 7);
+    BRCaptureAddSend (capture, a, (const uint8_t *) "a-request", 9);
+    BRCaptureAddRecv (capture, b, (const uint8_t *) "b-announce", 10);
+    BRCaptureAddRecv (capture, a, (const uint8_t *) "a-response", 10);
+    BRCaptureCloseStream (capture, a);
+    BRCaptureCloseStream (capture, b);
+    BRCaptureFree (capture);
+
+    BRCaptureReplay replay = BRCaptureReplayNew (SUP_CAPTURE_PATH);
+    remove (SUP_CAPTURE_PATH);
+    if (NULL == replay) return 0;
+
+    if (2 != BRCaptureReplayGetStreamCount (replay) ||
+        0 != strcmp ("b:2", BRCaptureReplayGetStreamName (replay, 1))) return 0;
+
+    BRCaptureStream ra, rb;
+    if (1 != BRCaptureReplayOpenStream (replay, "a:1", &ra) ||
+        1 != BRCaptureReplayOpenStream (replay, "b:2", &rb) ||
+        0 != BRCaptureReplayOpenStream (replay, "a:1", &ra)) return 0;    // only one 'a' stream
+
+    // 'b' waits on the earlier 'a-hello'
+    if (BR_CAPTURE_REPLAY_WAIT != BRCaptureReplayPeek (replay, rb)) return 0;
+    if (!runSupCaptureCheck (replay, ra, "a-hello")) return 0;
+
+    // 'a' waits on its request; 'b' no longer waits
+    if (BR_CAPTURE_REPLAY_WAIT != BRCaptureReplayPeek (replay, ra)) return 0;
+    if (!runSupCaptureCheck (replay, rb, "b-announce")) return 0;
+
+    BRCaptureReplaySent (replay, ra);
+    if (!runSupCaptureCheck (replay, ra, "a-response")) return 0;
+
+    if (BR_CAPTURE_REPLAY_END != BRCaptureReplayPeek (replay, ra)) return 0;
+
+    BRCaptureReplayCloseStream (replay, ra);
+    BRCaptureReplayCloseStream (replay, rb);
+    BRCaptureReplayFree (replay);
+
+    // A truncated file is rejected
+    FILE *file = fopen (SUP_CAPTURE_PATH, "wb");
+    fwrite ("BRCAPTUR", 1, 8, file);
+    fclose (file);
+    replay = BRCaptureReplayNew (SUP_CAPTURE_PATH);
+    remove (SUP_CAPTURE_PATH);
+
+    return NULL == replay;
+}
+
 ///
 /// Support Tests
 ///
@@ -527,6 +705,9 @@ int BRRunSupTests (void) {
     success &= runSupFileServiceTests();
     success &= runSupFileServiceMultiTests ();
     success &= runSupAssertTests();
+    success &= runSupProfileTests();
+    success &= runSupMetricsTests();
+    success &= runSupCaptureTests();
 
     return success;
 }
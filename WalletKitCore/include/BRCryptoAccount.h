@@ -137,6 +137,37 @@ extern "C" {
 
     DECLARE_CRYPTO_GIVE_TAKE (BRCryptoAccount, cryptoAccount);
 
+    /// MARK: - Signing Session
+
+    typedef struct BRCryptoSigningSessionRecord *BRCryptoSigningSession;
+
+    /**
+     * Create a signing session from a paperKey.  Deriving the seed from a paperKey is slow, by
+     * design; a session derives it once so that many transfers can be signed with it.  The seed
+     * is held in memory that is locked against paging and is zeroed when the session expires
+     * or is released.
+     *
+     * @param paperKey the paper key
+     * @param lifetime the seconds until the session expires, or 0 for a session that only
+     *        expires with `cryptoSigningSessionExpire()` or when released.
+     *
+     * @return The session
+     */
+    extern BRCryptoSigningSession
+    cryptoSigningSessionCreate (const char *paperKey,
+                                uint64_t lifetime);
+
+    extern BRCryptoBoolean
+    cryptoSigningSessionIsExpired (BRCryptoSigningSession session);
+
+    /**
+     * Expire `session` now, zeroing its seed.  Signing with an expired session fails.
+     */
+    extern void
+    cryptoSigningSessionExpire (BRCryptoSigningSession session);
+
+    DECLARE_CRYPTO_GIVE_TAKE (BRCryptoSigningSession, cryptoSigningSession);
+
 #ifdef __cplusplus
 }
 #endif
@@ -141,7 +141,8 @@ extern "C" {
                              BRCryptoTransfer transfer);
 
     /**
-     * Returns a newly allocated array of the wallet's transfers.
+     * Returns a newly allocated array of the wallet's transfers, in the order they were added.
+     * Paging with `cryptoWalletGetTransfersPage()` does not change this order.
      *
      * The caller is responsible for deallocating the returned array using
      * free().
@@ -156,6 +157,48 @@ extern "C" {
     cryptoWalletGetTransfers (BRCryptoWallet wallet,
                               size_t *count);
 
+    /**
+     * Returns the number of the wallet's transfers.
+     */
+    extern size_t
+    cryptoWalletGetTransferCount (BRCryptoWallet wallet);
+
+    /**
+     * A position in a wallet's transfers for use with `cryptoWalletGetTransfersPage()`.  Transfers
+     * are ordered by block number and then transaction index; transfers that are not included in
+     * a block order after all those that are.  The fields are opaque; initialize a cursor with
+     * `cryptoWalletTransferCursorInit()` to start at the first transfer.
+     */
+    typedef struct {
+        uint64_t blockNumber;
+        uint64_t transactionIndex;
+        uintptr_t identity;
+    } BRCryptoWalletTransferCursor;
+
+    extern BRCryptoWalletTransferCursor
+    cryptoWalletTransferCursorInit (void);
+
+    /**
+     * Fills `transfers` with up to `transfersCount` of the wallet's transfers, in order, following
+     * `cursor`, and then advances `cursor` past them.  Only the returned transfers are 'taken';
+     * the caller must 'give' each of them.
+     *
+     * A transfer that is added, or changes position, behind `cursor` while paging is not
+     * returned; one that changes position ahead of `cursor` is returned at its new position.
+     *
+     * @param wallet the wallet
+     * @param cursor the position to resume from; updated to the last transfer returned
+     * @param transfers an array of at least `transfersCount` transfers
+     * @param transfersCount the page size
+     *
+     * @return The number of transfers filled; zero once all transfers have been returned.
+     */
+    extern size_t
+    cryptoWalletGetTransfersPage (BRCryptoWallet wallet,
+                                  BRCryptoWalletTransferCursor *cursor,
+                                  BRCryptoTransfer *transfers,
+                                  size_t transfersCount);
+
     /**
      * Returns a 'new' adddress from `wallet` according to the provided `addressScheme`.  For BTC
      * this is a segwit or a bech32 address.  Note that the returned address is not associated with
@@ -162,6 +162,52 @@ extern "C" {
         BRCryptoCWMListenerTransferEvent transferEventCallback;
     } BRCryptoCWMListener;
 
+    /// MARK: Listener Batching
+
+    typedef enum {
+        CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER,
+        CRYPTO_CWM_LISTENER_EVENT_WALLET,
+        CRYPTO_CWM_LISTENER_EVENT_TRANSFER,
+    } BRCryptoCWMListenerEventType;
+
+    /// One event as it would have been passed to the corresponding listener callback, with the
+    /// same references for the handler to 'give'.  `wallet` is only set for WALLET and TRANSFER
+    /// events; `transfer` only for TRANSFER events.
+    typedef struct {
+        BRCryptoCWMListenerEventType type;
+        BRCryptoWalletManager manager;
+        BRCryptoWallet wallet;
+        BRCryptoTransfer transfer;
+        union {
+            BRCryptoWalletManagerEvent manager;
+            BRCryptoWalletEvent wallet;
+            BRCryptoTransferEvent transfer;
+        } u;
+    } BRCryptoCWMListenerEvent;
+
+    /// Handler must 'give' the references in each of `events`; `events` itself is not owned.
+    typedef void (*BRCryptoCWMListenerBatchEvents) (BRCryptoCWMListenerContext context,
+                                                    BRCryptoCWMListenerEvent *events,
+                                                    size_t eventsCount);
+
+    ///
+    /// With batching, listener events are queued instead of being announced one at a time.  A
+    /// queued event that is superseded by a later one is dropped: a wallet's BALANCE_UPDATED and
+    /// FEE_BASIS_UPDATED, a transfer's CHANGED (merged to span the old and the latest state) and
+    /// the manager's BLOCK_HEIGHT_UPDATED and SYNC_CONTINUES.
+    ///
+    /// With a `batchCallback`, queued events are delivered on a dedicated thread once
+    /// `eventsLimit` are queued or the oldest has waited `latencyLimit` milliseconds, in batches
+    /// of at most `eventsLimit`.  Without one, the host must drain the queue with
+    /// `cryptoWalletManagerPollListenerEvents()`.
+    ///
+    typedef struct {
+        size_t eventsLimit;
+        uint64_t latencyLimit;
+        BRCryptoCWMListenerBatchEvents batchCallback;
+    } BRCryptoCWMListenerBatching;
+
+
     /// MARK: Wallet Manager
 
     /// Can return NULL
@@ -174,6 +220,58 @@ extern "C" {
                                BRCryptoAddressScheme scheme,
                                const char *path);
 
+    /// Called, on a worker thread, as each manager of `cryptoWalletManagerCreateMultiple()` is
+    /// created; `manager` is NULL if it could not be.  Handler must 'give': manager
+    typedef void (*BRCryptoWalletManagerCreatedCallback) (BRCryptoCWMListenerContext context,
+                                                          size_t index,
+                                                          BRCryptoNetwork network,
+                                                          BRCryptoWalletManager manager);
+
+    /**
+     * Create a wallet manager for `account` on each of `networks`, as `cryptoWalletManagerCreate()`
+     * with `modes[i]` and `schemes[i]`, but concurrently on up to `threadsCount` worker threads
+     * (zero for one per network).  The account's keys are derived once, when the account is
+     * created, and are shared by every manager, as are the addresses the BTC and BCH managers
+     * derive from them; each manager opens its own file service.
+     *
+     * Returns once every manager has been created, filling `managers[i]` for `networks[i]` (or
+     * NULL).  Listener events, and `callback`, may arrive concurrently from different managers.
+     *
+     * @return The number of managers created.
+     */
+    extern size_t
+    cryptoWalletManagerCreateMultiple (BRCryptoCWMListener listener,
+                                       BRCryptoClient client,
+                                       BRCryptoAccount account,
+                                       BRCryptoNetwork *networks,
+                                       const BRCryptoSyncMode *modes,
+                                       const BRCryptoAddressScheme *schemes,
+                                       size_t networksCount,
+                                       const char *path,
+                                       size_t threadsCount,
+                                       BRCryptoWalletManagerCreatedCallback callback,
+                                       BRCryptoWalletManager *managers);
+
+    /**
+     * Enable or, if `batching` is NULL, disable batched listener event delivery.  Events queued
+     * when batching is disabled, or changed, are first delivered through the listener's
+     * individual callbacks.  Events announced during `cryptoWalletManagerCreate()` are never
+     * batched.
+     */
+    extern void
+    cryptoWalletManagerSetListenerBatching (BRCryptoWalletManager cwm,
+                                            const BRCryptoCWMListenerBatching *batching);
+
+    /**
+     * Remove up to `eventsCount` queued listener events, oldest first, into `events`.
+     *
+     * @return The number of events filled; the caller must 'give' each event's references.
+     */
+    extern size_t
+    cryptoWalletManagerPollListenerEvents (BRCryptoWalletManager cwm,
+                                           BRCryptoCWMListenerEvent *events,
+                                           size_t eventsCount);
+
     extern BRCryptoNetwork
     cryptoWalletManagerGetNetwork (BRCryptoWalletManager cwm);
 
@@ -199,6 +297,71 @@ extern "C" {
     extern const char *
     cryptoWalletManagerGetPath (BRCryptoWalletManager cwm);
 
+    /// A timed phase of `cryptoWalletManagerCreate()`, such as loading transactions from storage
+    /// or deriving addresses.  Phases nest; a phase at `depth` is part of the closest preceding
+    /// phase at `depth - 1`.  The `start` and `duration` are in nanoseconds; `start` is relative
+    /// to the beginning of `cryptoWalletManagerCreate()`.  The `name` is static.
+    typedef struct {
+        const char *name;
+        size_t depth;
+        uint64_t start;
+        uint64_t duration;
+    } BRCryptoWalletManagerPhase;
+
+    /**
+     * Fill `phases` with up to `phasesCount` of the phases of `cryptoWalletManagerCreate()`, in
+     * the order they began.  If `phases` is NULL, return the number of phases.  None are recorded
+     * in builds with BR_PROFILE_DISABLED.
+     *
+     * @return The number of phases filled.
+     */
+    extern size_t
+    cryptoWalletManagerGetStartupPhases (BRCryptoWalletManager cwm,
+                                         BRCryptoWalletManagerPhase *phases,
+                                         size_t phasesCount);
+
+    /// A counter, such as the bytes received from P2P peers, accumulated since the manager was
+    /// created.  The `name` is static.
+    typedef struct {
+        const char *name;
+        uint64_t value;
+    } BRCryptoWalletManagerCounter;
+
+#define CRYPTO_WALLET_MANAGER_HISTOGRAM_BUCKETS        (32)
+
+    /// A histogram, such as the latency of file service writes, accumulated since the manager
+    /// was created.  Times are in microseconds.  Buckets are powers of two: bucket 0 counts zero,
+    /// bucket N counts values in [2^(N-1), 2^N) and the last bucket counts everything larger.
+    typedef struct {
+        const char *name;
+        uint64_t count;
+        uint64_t sum;
+        uint64_t buckets[CRYPTO_WALLET_MANAGER_HISTOGRAM_BUCKETS];
+    } BRCryptoWalletManagerHistogram;
+
+    /**
+     * Fill `counters` with up to `countersCount` of the manager's counters.  If `counters` is
+     * NULL, return the number of counters.  Counters are created by the manager's subsystems as
+     * needed, so a later call may return more.
+     *
+     * @return The number of counters filled.
+     */
+    extern size_t
+    cryptoWalletManagerGetMetricCounters (BRCryptoWalletManager cwm,
+                                          BRCryptoWalletManagerCounter *counters,
+                                          size_t countersCount);
+
+    /**
+     * Fill `histograms` with up to `histogramsCount` of the manager's histograms.  If
+     * `histograms` is NULL, return the number of histograms.
+     *
+     * @return The number of histograms filled.
+     */
+    extern size_t
+    cryptoWalletManagerGetMetricHistograms (BRCryptoWalletManager cwm,
+                                            BRCryptoWalletManagerHistogram *histograms,
+                                            size_t histogramsCount);
+
     extern void
     cryptoWalletManagerSetNetworkReachable (BRCryptoWalletManager cwm,
                                             BRCryptoBoolean isNetworkReachable);
@@ -288,6 +451,34 @@ extern "C" {
                                BRCryptoTransfer tid,
                                const char *paperKey);
 
+    /**
+     * Sign `transfer` with the seed held by `session`, avoiding the paper key derivation.  Returns
+     * false if the session has expired or if signing fails.
+     */
+    extern BRCryptoBoolean
+    cryptoWalletManagerSignWithSession (BRCryptoWalletManager cwm,
+                                        BRCryptoWallet wallet,
+                                        BRCryptoTransfer transfer,
+                                        BRCryptoSigningSession session);
+
+    /**
+     * Sign each of `transfers` with the seed held by `session`.  If `results` is not NULL it is
+     * filled with the per-transfer outcome.  Returns the number of transfers signed.
+     */
+    extern size_t
+    cryptoWalletManagerSignMultipleWithSession (BRCryptoWalletManager cwm,
+                                                BRCryptoWallet wallet,
+                                                BRCryptoTransfer *transfers,
+                                                size_t transfersCount,
+                                                BRCryptoSigningSession session,
+                                                BRCryptoBoolean *results);
+
+    extern void
+    cryptoWalletManagerSubmitWithSession (BRCryptoWalletManager cwm,
+                                          BRCryptoWallet wallet,
+                                          BRCryptoTransfer transfer,
+                                          BRCryptoSigningSession session);
+
     extern void
     cryptoWalletManagerSubmitForKey (BRCryptoWalletManager cwm,
                                      BRCryptoWallet wallet,
@@ -100,6 +100,40 @@ cwmAnnounceGetTransferItem (BRCryptoWalletManager cwm,
                             OwnershipKept const char **attributeKeys,
                             OwnershipKept const char **attributeVals);
 
+/**
+ * As `cwmAnnounceGetTransferItem()` but with values already parsed: the `hash`, `from`, `to` and
+ * `blockHash` are the network's raw bytes (a `to` of zero bytes is the fee address), the
+ * `amount` and `fee` are 32-byte, big-endian unsigned integers (the `fee` may be NULL) and the
+ * `currency` is the network's currency, as from `cryptoNetworkGetCurrencyForUids()`.
+ *
+ * @return CRYPTO_FALSE, having skipped the transfer, if a hash or address has the wrong size for
+ * the network or the `amount` or `fee` is beyond its range (such as above 64 bits for XRP and
+ * HBAR); CRYPTO_TRUE otherwise.
+ */
+extern BRCryptoBoolean
+cwmAnnounceGetTransferItemBinary (BRCryptoWalletManager cwm,
+                                  BRCryptoClientCallbackState callbackState,
+                                  BRCryptoTransferStateType status,
+                                  OwnershipKept const uint8_t *hash,
+                                  size_t hashCount,
+                                  OwnershipKept const char *uids,
+                                  OwnershipKept const uint8_t *from,
+                                  size_t fromCount,
+                                  OwnershipKept const uint8_t *to,
+                                  size_t toCount,
+                                  OwnershipKept const uint8_t *amount,
+                                  OwnershipKept BRCryptoCurrency currency,
+                                  OwnershipKept const uint8_t *fee,
+                                  uint64_t blockTimestamp,
+                                  uint64_t blockNumber,
+                                  uint64_t blockConfirmations,
+                                  uint64_t blockTransactionIndex,
+                                  OwnershipKept const uint8_t *blockHash,
+                                  size_t blockHashCount,
+                                  size_t attributesCount,
+                                  OwnershipKept const char **attributeKeys,
+                                  OwnershipKept const char **attributeVals);
+
 extern void
 cwmAnnounceGetTransfersComplete (OwnershipKept BRCryptoWalletManager cwm,
                                  OwnershipGiven BRCryptoClientCallbackState callbackState,
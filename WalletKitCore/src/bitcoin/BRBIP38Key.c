@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
 
 #define BIP38_NOEC_PREFIX      0x0142
 #define BIP38_EC_PREFIX        0x0143
@@ -186,6 +187,66 @@ int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, B
     return r;
 }
 
+typedef struct {
+    BRKey *keys;
+    int *results;
+    const char **bip38Keys, **passphrases;
+    BRAddressParams params;
+    size_t start, end, decrypted;
+} _BRBIP38Batch;
+
+static void *_BRBIP38KeysRoutine(void *arg)
+{
+    _BRBIP38Batch *batch = arg;
+    
+    for (size_t i = batch->start; i < batch->end; i++) {
+        int r = BRKeySetBIP38Key(&batch->keys[i], batch->bip38Keys[i], batch->passphrases[i], batch->params);
+        
+        if (batch->results) batch->results[i] = r;
+        if (r) batch->decrypted++;
+    }
+    
+    return NULL;
+}
+
+// decrypts count BIP38 keys, bip38Keys[i] with passphrases[i] into keys[i], splitting them over up to threadCount
+// threads; each thread runs one scrypt at a time, so memory is bounded by the thread count, not the number of keys
+// results[i], if results is not NULL, is set to what BRKeySetBIP38Key() returns for that key
+// returns the number of keys decrypted with a correct passphrase
+size_t BRKeySetBIP38Keys(BRKey keys[], int results[], const char *bip38Keys[], const char *passphrases[], size_t count,
+                         BRAddressParams params, size_t threadCount)
+{
+    size_t i, n = 0, perThread;
+    
+    assert(keys != NULL || count == 0);
+    assert(bip38Keys != NULL || count == 0);
+    assert(passphrases != NULL || count == 0);
+    if (threadCount > BIP38_MAX_DECRYPT_THREADS) threadCount = BIP38_MAX_DECRYPT_THREADS;
+    if (threadCount > count) threadCount = count;
+    if (threadCount < 1) threadCount = 1;
+    perThread = (count + threadCount - 1)/threadCount;
+    
+    _BRBIP38Batch batches[threadCount];
+    pthread_t threads[threadCount];
+    int started[threadCount];
+    
+    for (i = 0; i < threadCount; i++) {
+        batches[i] = (_BRBIP38Batch) { keys, results, bip38Keys, passphrases, params, i*perThread, (i + 1)*perThread, 0 };
+        if (batches[i].start > count) batches[i].start = count;
+        if (batches[i].end > count) batches[i].end = count;
+        // the calling thread takes the first batch, and any batch a thread couldn't be started for
+        started[i] = (i > 0 && pthread_create(&threads[i], NULL, _BRBIP38KeysRoutine, &batches[i]) == 0);
+    }
+    
+    for (i = 0; i < threadCount; i++) {
+        if (started[i]) pthread_join(threads[i], NULL);
+        else _BRBIP38KeysRoutine(&batches[i]);
+        n += batches[i].decrypted;
+    }
+    
+    return n;
+}
+
 // generates an "intermediate code" for an EC multiply mode key
 // salt should be 64bits of random data
 // passphrase must be unicode NFC normalized
@@ -31,6 +31,8 @@
 extern "C" {
 #endif
 
+#define BIP38_MAX_DECRYPT_THREADS 8 // most threads used by BRKeySetBIP38Keys(), each with 16-32MB of scrypt memory
+
 // BIP38 is a method for encrypting private keys with a passphrase
 // https://github.com/bitcoin/bips/blob/master/bip-0038.mediawiki
 
@@ -40,6 +42,13 @@ int BRBIP38KeyIsValid(const char *bip38Key);
 // passphrase must be unicode NFC normalized: http://www.unicode.org/reports/tr15/#Norm_Forms
 int BRKeySetBIP38Key(BRKey *key, const char *bip38Key, const char *passphrase, BRAddressParams params);
 
+// decrypts count BIP38 keys, bip38Keys[i] with passphrases[i] into keys[i], splitting them over up to threadCount
+// threads; each thread runs one scrypt at a time, so memory is bounded by the thread count, not the number of keys
+// results[i], if results is not NULL, is set to what BRKeySetBIP38Key() returns for that key
+// returns the number of keys decrypted with a correct passphrase
+size_t BRKeySetBIP38Keys(BRKey keys[], int results[], const char *bip38Keys[], const char *passphrases[], size_t count,
+                         BRAddressParams params, size_t threadCount);
+
 // generates an "intermediate code" for an EC multiply mode key
 // salt should be 64bits of random data
 // passphrase must be unicode NFC normalized
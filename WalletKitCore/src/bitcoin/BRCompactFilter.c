@@ -0,0 +1,286 @@
+//
+//  BRCompactFilter.c
+//
+//  Created by agent on 10/19/26.
+//  Copyright (c) 2026 breadwallet LLC.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRCompactFilter.h"
+#include "support/BRBase.h"
+#include "support/BRCrypto.h"
+#include "support/BRAddress.h"
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+// returns the high 64 bits of the 128 bit product x*y, without relying on a native 128 bit type
+inline static uint64_t _BRMulHigh64(uint64_t x, uint64_t y)
+{
+    uint64_t xl = x & 0xffffffff, xh = x >> 32, yl = y & 0xffffffff, yh = y >> 32,
+             ll = xl*yl, lh = xl*yh, hl = xh*yl, hh = xh*yh,
+             mid = (ll >> 32) + (lh & 0xffffffff) + (hl & 0xffffffff);
+    
+    return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+
+// maps data uniformly onto the range [0, elemCount*M)
+inline static uint64_t _BRCompactFilterHash(UInt256 blockHash, uint64_t elemCount, const uint8_t *data,
+                                            size_t dataLen)
+{
+    return _BRMulHigh64(BRSip64(blockHash.u8, data, dataLen), elemCount*CFILTER_BASIC_M);
+}
+
+static int _BRUInt64Compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+} _BRElem;
+
+static int _BRElemCompare(const void *a, const void *b)
+{
+    const _BRElem *x = a, *y = b;
+    
+    if (x->len != y->len) return (x->len < y->len) ? -1 : 1;
+    return (x->len > 0) ? memcmp(x->data, y->data, x->len) : 0;
+}
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    size_t bit; // current bit position, bits are read most significant first
+} _BRBitReader;
+
+// returns -1 on end of data
+inline static int _BRBitReaderBit(_BRBitReader *r)
+{
+    int b;
+    
+    if (r->bit >= r->len*8) return -1;
+    b = (r->buf[r->bit/8] >> (7 - r->bit % 8)) & 1;
+    r->bit++;
+    return b;
+}
+
+// decodes the next golomb-rice coded delta, returns 0 on end of data
+static int _BRBitReaderGolomb(_BRBitReader *r, uint64_t *delta)
+{
+    uint64_t q = 0, rem = 0;
+    int i, b;
+    
+    while ((b = _BRBitReaderBit(r)) == 1) q++;
+    if (b < 0) return 0;
+    
+    for (i = 0; i < CFILTER_BASIC_P; i++) {
+        if ((b = _BRBitReaderBit(r)) < 0) return 0;
+        rem = (rem << 1) | (uint64_t)b;
+    }
+    
+    *delta = (q << CFILTER_BASIC_P) | rem;
+    return 1;
+}
+
+inline static void _BRBitWriterBits(uint8_t *buf, size_t *bit, uint64_t value, int count)
+{
+    while (count > 0) {
+        count--;
+        if ((value >> count) & 1) buf[*bit/8] |= (uint8_t)(0x80 >> (*bit % 8));
+        (*bit)++;
+    }
+}
+
+// returns a newly allocated basic filter for the given block and set of elements (duplicate elements are removed)
+// result must be freed by calling BRCompactFilterFree()
+BRCompactFilter *BRCompactFilterNew(UInt256 blockHash, const uint8_t *elems[], const size_t elemLens[],
+                                    size_t elemCount)
+{
+    BRCompactFilter *filter = calloc(1, sizeof(*filter));
+    uint64_t *hashes = (elemCount > 0) ? malloc(elemCount*sizeof(*hashes)) : NULL, prev = 0, delta;
+    _BRElem *sorted = (elemCount > 0) ? malloc(elemCount*sizeof(*sorted)) : NULL;
+    size_t i, j, n = 0, bit = 0, bits = 0, off;
+    
+    assert(filter != NULL);
+    assert(hashes != NULL || elemCount == 0);
+    assert(sorted != NULL || elemCount == 0);
+    assert(elems != NULL || elemCount == 0);
+    
+    // remove duplicate elements, the set size is part of the hash range so it must be known before hashing
+    for (i = 0; i < elemCount; i++) sorted[i] = (_BRElem) { elems[i], elemLens[i] };
+    if (elemCount > 0) qsort(sorted, elemCount, sizeof(*sorted), _BRElemCompare);
+    
+    for (i = 0; i < elemCount; i++) {
+        if (n == 0 || _BRElemCompare(&sorted[n - 1], &sorted[i]) != 0) sorted[n++] = sorted[i];
+    }
+    
+    for (i = 0; i < n; i++) hashes[i] = _BRCompactFilterHash(blockHash, n, sorted[i].data, sorted[i].len);
+    if (sorted) free(sorted);
+    
+    if (n > 0) qsort(hashes, n, sizeof(*hashes), _BRUInt64Compare);
+    
+    for (i = 0; i < n; i++) {
+        bits += (size_t)((hashes[i] - prev) >> CFILTER_BASIC_P) + 1 + CFILTER_BASIC_P;
+        prev = hashes[i];
+    }
+
+    filter->blockHash = blockHash;
+    filter->filterType = CFILTER_TYPE_BASIC;
+    filter->elemCount = n;
+    off = BRVarIntSize(n);
+    filter->length = off + (bits + 7)/8;
+    filter->data = calloc(filter->length, sizeof(*filter->data));
+    assert(filter->data != NULL);
+    BRVarIntSet(filter->data, off, n);
+    
+    for (i = 0, prev = 0; i < n; i++) {
+        delta = hashes[i] - prev;
+        prev = hashes[i];
+        
+        for (j = (size_t)(delta >> CFILTER_BASIC_P); j > 0; j--) _BRBitWriterBits(&filter->data[off], &bit, 1, 1);
+        _BRBitWriterBits(&filter->data[off], &bit, 0, 1);
+        _BRBitWriterBits(&filter->data[off], &bit, delta, CFILTER_BASIC_P);
+    }
+    
+    if (hashes) free(hashes);
+    return filter;
+}
+
+// buf must contain a serialized filter
+// returns a filter struct that must be freed by calling BRCompactFilterFree()
+BRCompactFilter *BRCompactFilterParse(UInt256 blockHash, uint8_t filterType, const uint8_t *buf, size_t bufLen)
+{
+    BRCompactFilter *filter = NULL;
+    size_t len = 0;
+    uint64_t n;
+    
+    assert(buf != NULL || bufLen == 0);
+    
+    if (buf && bufLen > 0) {
+        n = BRVarInt(buf, bufLen, &len);
+        
+        // each element takes at least P + 1 bits
+        if (len > 0 && len <= bufLen && n <= (bufLen - len)*8/(CFILTER_BASIC_P + 1)) {
+            filter = calloc(1, sizeof(*filter));
+            assert(filter != NULL);
+            filter->blockHash = blockHash;
+            filter->filterType = filterType;
+            filter->elemCount = n;
+            filter->length = bufLen;
+            filter->data = malloc(bufLen);
+            assert(filter->data != NULL);
+            memcpy(filter->data, buf, bufLen);
+        }
+    }
+    
+    return filter;
+}
+
+// returns number of bytes written to buf, or total bufLen needed if buf is NULL
+size_t BRCompactFilterSerialize(const BRCompactFilter *filter, uint8_t *buf, size_t bufLen)
+{
+    assert(filter != NULL);
+    assert(buf != NULL || bufLen == 0);
+    
+    if (buf && filter->length <= bufLen) memcpy(buf, filter->data, filter->length);
+    return (! buf || filter->length <= bufLen) ? filter->length : 0;
+}
+
+// true if data is matched by filter
+int BRCompactFilterContainsData(const BRCompactFilter *filter, const uint8_t *data, size_t dataLen)
+{
+    const uint8_t *elems[] = { data };
+    const size_t elemLens[] = { dataLen };
+    
+    assert(filter != NULL);
+    assert(data != NULL || dataLen == 0);
+    return (data) ? BRCompactFilterMatchAny(filter, elems, elemLens, 1) : 0;
+}
+
+// true if any of the given elements are matched by filter, this is much faster than calling
+// BRCompactFilterContainsData() for each element since the filter only needs to be decoded once
+// NOTE: a filter that can't be decoded matches everything, so a malformed filter never causes a wallet tx to be missed
+int BRCompactFilterMatchAny(const BRCompactFilter *filter, const uint8_t *elems[], const size_t elemLens[],
+                            size_t elemCount)
+{
+    uint64_t *hashes, value = 0, delta, k;
+    size_t i, len = 0;
+    _BRBitReader r;
+    int match = 0;
+    
+    assert(filter != NULL);
+    assert(elems != NULL || elemCount == 0);
+    if (filter->elemCount == 0 || elemCount == 0) return 0;
+    
+    hashes = malloc(elemCount*sizeof(*hashes));
+    assert(hashes != NULL);
+    for (i = 0; i < elemCount; i++) hashes[i] = _BRCompactFilterHash(filter->blockHash, filter->elemCount,
+                                                                      elems[i], elemLens[i]);
+    qsort(hashes, elemCount, sizeof(*hashes), _BRUInt64Compare);
+    
+    BRVarInt(filter->data, filter->length, &len);
+    r.buf = &filter->data[len];
+    r.len = filter->length - len;
+    r.bit = 0;
+    
+    // walk the sorted query hashes and the decoded filter set together, like a merge
+    for (i = 0, k = 0; ! match && i < elemCount && k < filter->elemCount; k++) {
+        if (! _BRBitReaderGolomb(&r, &delta)) match = 1;
+        value += delta;
+        while (! match && i < elemCount && hashes[i] < value) i++;
+        if (i < elemCount && hashes[i] == value) match = 1;
+    }
+    
+    free(hashes);
+    return match;
+}
+
+// double-SHA256 of the serialized filter
+UInt256 BRCompactFilterHash(const BRCompactFilter *filter)
+{
+    UInt256 hash;
+    
+    assert(filter != NULL);
+    BRSHA256_2(&hash, filter->data, filter->length);
+    return hash;
+}
+
+// the filter header commits to the filter hash and the filter header of the previous block
+UInt256 BRCompactFilterHeader(UInt256 filterHash, UInt256 prevHeader)
+{
+    uint8_t buf[sizeof(UInt256)*2];
+    UInt256 header;
+    
+    UInt256Set(buf, filterHash);
+    UInt256Set(&buf[sizeof(UInt256)], prevHeader);
+    BRSHA256_2(&header, buf, sizeof(buf));
+    return header;
+}
+
+// frees memory allocated for filter
+void BRCompactFilterFree(BRCompactFilter *filter)
+{
+    assert(filter != NULL);
+    if (filter->data) free(filter->data);
+    free(filter);
+}
@@ -0,0 +1,87 @@
+//
+//  BRCompactFilter.h
+//
+//  Created by agent on 10/19/26.
+//  Copyright (c) 2026 breadwallet LLC.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRCompactFilter_h
+#define BRCompactFilter_h
+
+#include "support/BRInt.h"
+#include <stddef.h>
+#include <inttypes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// compact block filters are explained in BIP158: https://github.com/bitcoin/bips/blob/master/bip-0158.mediawiki
+// and the p2p messages used to fetch them in BIP157: https://github.com/bitcoin/bips/blob/master/bip-0157.mediawiki
+
+#define CFILTER_TYPE_BASIC    0x00
+#define CFILTER_BASIC_P       19     // golomb-rice coding parameter
+#define CFILTER_BASIC_M       784931 // inverse false positive rate
+#define CFILTER_MAX_CFHEADERS 2000   // maximum filter hashes in a single cfheaders message
+#define CFILTER_MAX_CFILTERS  1000   // maximum filters requested by a single getcfilters message
+
+typedef struct {
+    UInt256 blockHash; // the filter key is the first 16 bytes of the hash of the block the filter was built from
+    uint8_t filterType;
+    uint64_t elemCount;
+    uint8_t *data; // serialized filter, CompactSize elemCount followed by the golomb-rice coded set
+    size_t length;
+} BRCompactFilter;
+
+// returns a newly allocated basic filter for the given block and set of elements (duplicate elements are removed)
+// result must be freed by calling BRCompactFilterFree()
+BRCompactFilter *BRCompactFilterNew(UInt256 blockHash, const uint8_t *elems[], const size_t elemLens[],
+                                    size_t elemCount);
+
+// buf must contain a serialized filter
+// returns a filter struct that must be freed by calling BRCompactFilterFree()
+BRCompactFilter *BRCompactFilterParse(UInt256 blockHash, uint8_t filterType, const uint8_t *buf, size_t bufLen);
+
+// returns number of bytes written to buf, or total bufLen needed if buf is NULL
+size_t BRCompactFilterSerialize(const BRCompactFilter *filter, uint8_t *buf, size_t bufLen);
+
+// true if data is matched by filter
+int BRCompactFilterContainsData(const BRCompactFilter *filter, const uint8_t *data, size_t dataLen);
+
+// true if any of the given elements are matched by filter, this is much faster than calling
+// BRCompactFilterContainsData() for each element since the filter only needs to be decoded once
+// NOTE: a filter that can't be decoded matches everything, so a malformed filter never causes a wallet tx to be missed
+int BRCompactFilterMatchAny(const BRCompactFilter *filter, const uint8_t *elems[], const size_t elemLens[],
+                            size_t elemCount);
+
+// double-SHA256 of the serialized filter
+UInt256 BRCompactFilterHash(const BRCompactFilter *filter);
+
+// the filter header commits to the filter hash and the filter header of the previous block
+UInt256 BRCompactFilterHeader(UInt256 filterHash, UInt256 prevHeader);
+
+// frees memory allocated for filter
+void BRCompactFilterFree(BRCompactFilter *filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BRCompactFilter_h
@@ -31,6 +31,7 @@
 #include <limits.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
 
 #define MAX_PROOF_OF_WORK 0x1d00ffff    // highest value for difficulty target (higher values are less difficult)
 #define TARGET_TIMESPAN   (14*24*60*60) // the targeted timespan between difficulty target adjustments
@@ -270,6 +271,90 @@ static UInt256 _BRMerkleBlockRootR(const BRMerkleBlock *block, size_t *hashIdx,
     return md;
 }
 
+typedef struct {
+    const UInt256 *txHashes;
+    const uint8_t *matches;
+    size_t txCount;
+    UInt256 *hashes;
+    size_t hashesCount;
+    uint8_t *flags;
+    size_t flagIdx;
+} _BRPartialTree;
+
+// number of nodes at the given height of the merkle tree, leaves are at height 0
+inline static size_t _BRPartialTreeWidth(const _BRPartialTree *tree, int height)
+{
+    return (tree->txCount + ((size_t)1 << height) - 1) >> height;
+}
+
+static UInt256 _BRPartialTreeHashR(const _BRPartialTree *tree, int height, size_t pos)
+{
+    UInt256 hashes[2], md;
+    
+    if (height == 0) return tree->txHashes[pos];
+    hashes[0] = _BRPartialTreeHashR(tree, height - 1, pos*2);
+    hashes[1] = (pos*2 + 1 < _BRPartialTreeWidth(tree, height - 1)) ?
+                _BRPartialTreeHashR(tree, height - 1, pos*2 + 1) : hashes[0];
+    BRSHA256_2(&md, hashes, sizeof(hashes));
+    return md;
+}
+
+// depth-first traversal that writes the flag bits and hashes of the BIP37 partial merkle branch format
+static void _BRPartialTreeBuildR(_BRPartialTree *tree, int height, size_t pos)
+{
+    size_t i, end = (pos + 1) << height;
+    int parentOfMatch = 0;
+    
+    if (end > tree->txCount) end = tree->txCount;
+    for (i = pos << height; ! parentOfMatch && i < end; i++) parentOfMatch = (tree->matches[i] != 0);
+    if (parentOfMatch) tree->flags[tree->flagIdx/8] |= (uint8_t)(1 << (tree->flagIdx % 8));
+    tree->flagIdx++;
+    
+    if (height == 0 || ! parentOfMatch) {
+        tree->hashes[tree->hashesCount++] = _BRPartialTreeHashR(tree, height, pos);
+    }
+    else {
+        _BRPartialTreeBuildR(tree, height - 1, pos*2); // left branch
+        if (pos*2 + 1 < _BRPartialTreeWidth(tree, height - 1)) _BRPartialTreeBuildR(tree, height - 1, pos*2 + 1);
+    }
+}
+
+// sets totalTx, hashes and flags for a block created from a full block's header, as if it was a merkleblock message
+// filtered to the txs with a non-zero entry in matches
+// returns true if the resulting merkle root matches block->merkleRoot
+int BRMerkleBlockSetTxMatches(BRMerkleBlock *block, const UInt256 txHashes[], const uint8_t matches[], size_t txCount)
+{
+    _BRPartialTree tree = { txHashes, matches, txCount, NULL, 0, NULL, 0 };
+    int height = 0;
+    size_t hashIdx = 0, flagIdx = 0;
+    
+    assert(block != NULL);
+    assert(txHashes != NULL || txCount == 0);
+    assert(matches != NULL || txCount == 0);
+    
+    if (block->hashes) free(block->hashes);
+    if (block->flags) free(block->flags);
+    block->hashes = NULL, block->hashesCount = 0;
+    block->flags = NULL, block->flagsLen = 0;
+    block->totalTx = (uint32_t)txCount;
+    if (txCount == 0) return 0;
+    
+    while (_BRPartialTreeWidth(&tree, height) > 1) height++;
+    
+    // a partial tree never has more nodes than the full tree, which has fewer than 2*txCount + height nodes
+    tree.hashes = malloc((2*txCount + (size_t)height)*sizeof(*tree.hashes));
+    tree.flags = calloc((2*txCount + (size_t)height + 7)/8, sizeof(*tree.flags));
+    assert(tree.hashes != NULL);
+    assert(tree.flags != NULL);
+    _BRPartialTreeBuildR(&tree, height, 0);
+    
+    block->hashes = tree.hashes;
+    block->hashesCount = tree.hashesCount;
+    block->flags = tree.flags;
+    block->flagsLen = (tree.flagIdx + 7)/8;
+    return UInt256Eq(_BRMerkleBlockRootR(block, &hashIdx, &flagIdx, 0), block->merkleRoot);
+}
+
 // true if merkle tree and timestamp are valid, and proof-of-work matches the stated difficulty target
 // NOTE: this only checks if the block difficulty matches the difficulty target in the header, it does not check if the
 // target is correct for the block's height in the chain - use BRMerkleBlockVerifyDifficulty() for that
@@ -304,6 +389,75 @@ int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime)
     return r;
 }
 
+typedef struct {
+    BRMerkleBlock **blocks;
+    const uint8_t *buf;
+    size_t headerLen, start, end;
+    uint32_t currentTime;
+} _BRHeaderBatch;
+
+static void *_BRMerkleBlockParseHeadersRoutine(void *arg)
+{
+    _BRHeaderBatch *batch = arg;
+    
+    for (size_t i = batch->start; i < batch->end; i++) {
+        batch->blocks[i] = BRMerkleBlockParse(&batch->buf[batch->headerLen*i], batch->headerLen);
+        
+        if (batch->blocks[i] && ! BRMerkleBlockIsValid(batch->blocks[i], batch->currentTime)) {
+            BRMerkleBlockFree(batch->blocks[i]);
+            batch->blocks[i] = NULL;
+        }
+    }
+    
+    return NULL;
+}
+
+// parses count serialized block headers, each headerLen bytes and stored one after another in buf, into blocks, and
+// checks each with BRMerkleBlockIsValid(), splitting the hashing and proof-of-work checks over up to threadCount threads
+// returns the number of leading headers that are valid, any blocks after those are freed and set to NULL
+// NOTE: this does not check that the headers connect, that needs to be done in order once the batch is returned
+size_t BRMerkleBlockParseHeaders(BRMerkleBlock *blocks[], const uint8_t *buf, size_t headerLen, size_t count,
+                                 uint32_t currentTime, size_t threadCount)
+{
+    size_t i, n = 0, perThread;
+    
+    assert(blocks != NULL || count == 0);
+    assert(buf != NULL || count == 0);
+    if (threadCount > BLOCK_MAX_VALIDATION_THREADS) threadCount = BLOCK_MAX_VALIDATION_THREADS;
+    if (threadCount > (count + BLOCK_MIN_HEADERS_PER_THREAD - 1)/BLOCK_MIN_HEADERS_PER_THREAD) {
+        threadCount = (count + BLOCK_MIN_HEADERS_PER_THREAD - 1)/BLOCK_MIN_HEADERS_PER_THREAD;
+    }
+    
+    if (threadCount < 1) threadCount = 1;
+    perThread = (count + threadCount - 1)/threadCount;
+    
+    _BRHeaderBatch batches[threadCount];
+    pthread_t threads[threadCount];
+    int started[threadCount];
+    
+    for (i = 0; i < threadCount; i++) {
+        batches[i] = (_BRHeaderBatch) { blocks, buf, headerLen, i*perThread, (i + 1)*perThread, currentTime };
+        if (batches[i].start > count) batches[i].start = count;
+        if (batches[i].end > count) batches[i].end = count;
+        // the calling thread takes the first batch, and any batch a thread couldn't be started for
+        started[i] = (i > 0 && pthread_create(&threads[i], NULL, _BRMerkleBlockParseHeadersRoutine, &batches[i]) == 0);
+    }
+    
+    for (i = 0; i < threadCount; i++) {
+        if (started[i]) pthread_join(threads[i], NULL);
+        else _BRMerkleBlockParseHeadersRoutine(&batches[i]);
+    }
+    
+    while (n < count && blocks[n]) n++;
+    
+    for (i = n; i < count; i++) {
+        if (blocks[i]) BRMerkleBlockFree(blocks[i]);
+        blocks[i] = NULL;
+    }
+    
+    return n;
+}
+
 // true if the given tx hash is known to be included in the block
 int BRMerkleBlockContainsTxHash(const BRMerkleBlock *block, UInt256 txHash)
 {
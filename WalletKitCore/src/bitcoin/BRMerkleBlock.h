@@ -36,6 +36,8 @@ extern "C" {
 #define BLOCK_DIFFICULTY_INTERVAL 2016 // number of blocks between difficulty target adjustments
 #define BLOCK_UNKNOWN_HEIGHT      INT32_MAX
 #define BLOCK_MAX_TIME_DRIFT      (2*60*60) // the furthest in the future a block is allowed to be timestamped
+#define BLOCK_MAX_VALIDATION_THREADS 8     // most threads used by BRMerkleBlockParseHeaders()
+#define BLOCK_MIN_HEADERS_PER_THREAD 250   // smaller batches aren't worth the thread startup cost
 
 typedef struct {
     UInt256 blockHash;
@@ -77,11 +79,23 @@ size_t BRMerkleBlockTxHashes(const BRMerkleBlock *block, UInt256 *txHashes, size
 void BRMerkleBlockSetTxHashes(BRMerkleBlock *block, const UInt256 hashes[], size_t hashesCount,
                               const uint8_t *flags, size_t flagsLen);
 
+// sets totalTx, hashes and flags for a block created from a full block's header, as if it was a merkleblock message
+// filtered to the txs with a non-zero entry in matches
+// returns true if the resulting merkle root matches block->merkleRoot
+int BRMerkleBlockSetTxMatches(BRMerkleBlock *block, const UInt256 txHashes[], const uint8_t matches[], size_t txCount);
+
 // true if merkle tree and timestamp are valid, and proof-of-work matches the stated difficulty target
 // NOTE: this only checks if the block difficulty matches the difficulty target in the header, it does not check if the
 // target is correct for the block's height in the chain - use BRMerkleBlockVerifyDifficulty() for that
 int BRMerkleBlockIsValid(const BRMerkleBlock *block, uint32_t currentTime);
 
+// parses count serialized block headers, each headerLen bytes and stored one after another in buf, into blocks, and
+// checks each with BRMerkleBlockIsValid(), splitting the hashing and proof-of-work checks over up to threadCount threads
+// returns the number of leading headers that are valid, any blocks after those are freed and set to NULL
+// NOTE: this does not check that the headers connect, that needs to be done in order once the batch is returned
+size_t BRMerkleBlockParseHeaders(BRMerkleBlock *blocks[], const uint8_t *buf, size_t headerLen, size_t count,
+                                 uint32_t currentTime, size_t threadCount);
+
 // true if the given tx hash is known to be included in the block
 int BRMerkleBlockContainsTxHash(const BRMerkleBlock *block, UInt256 txHash);
 
@@ -41,6 +41,7 @@
 #include <netdb.h>
 #include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <netinet/in.h>	
 #include <arpa/inet.h>
 
@@ -54,6 +55,9 @@
 #define CONNECT_TIMEOUT    3.0
 #define MESSAGE_TIMEOUT    10.0
 #define WITNESS_FLAG       0x40000000
+#define HEADER_THREADS     4     // threads used to hash and check proof-of-work of a batch of headers
+#define RECV_BUFFER_LENGTH 0x10000 // initial size of the receive buffer, grown to hold the largest message seen
+#define SEND_IOV_MAX       64    // most queued messages written by a single sendmsg()
 
 #define PTHREAD_STACK_SIZE  (512 * 1024)
 
@@ -127,10 +131,26 @@ typedef struct {
     BRTransaction *(*requestedTx)(void *info, UInt256 txHash);
     int (*networkIsReachable)(void *info);
     void (*threadCleanup)(void *info);
+    void (*relayedHeaders)(void *info, BRMerkleBlock *blocks[], size_t blocksCount);
+    void (*relayedCFHeaders)(void *info, UInt256 stopHash, UInt256 prevHeader, const UInt256 filterHashes[],
+                             size_t hashesCount);
+    void (*relayedCFilter)(void *info, BRCompactFilter *filter);
+    void (*relayedFullBlock)(void *info, BRMerkleBlock *block, BRTransaction *txs[], const UInt256 txHashes[],
+                             size_t txCount);
     void **volatile pongInfo;
     void (**volatile pongCallback)(void *info, int success);
     void *volatile mempoolInfo;
     void (*volatile mempoolCallback)(void *info, int success);
+    BRMetricsCounter messagesSent, bytesSent, messagesReceived, bytesReceived, reads, writes;
+    struct iovec *sendQueue; // framed messages not yet written to the socket
+    size_t sendOffset; // bytes of sendQueue[0] already written
+    pthread_mutex_t sendLock;
+    BRCapture capture;
+    BRCaptureStream captureStream;
+    BRCaptureReplay replay;
+    BRCaptureStream replayStream;
+    const uint8_t *replayBytes;
+    size_t replayBytesCount;
     pthread_t thread;
     pthread_mutex_t lock;
 } BRPeerContext;
@@ -467,6 +487,26 @@ static int _BRPeerAcceptHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t
                  BRVarIntSize(count) + 81*count, count);
         r = 0;
     }
+    else if (ctx->relayedHeaders) { // compact filter sync, the caller decides what to request next
+        BRMerkleBlock *_blocks[128], **blocks = (count <= 128) ? _blocks : malloc(count*sizeof(*blocks));
+        size_t i, n;
+        
+        assert(blocks != NULL || count == 0);
+        peer_log(peer, "got %zu header(s)", count);
+        n = BRMerkleBlockParseHeaders(blocks, &msg[off], 81, count, (uint32_t)time(NULL), HEADER_THREADS);
+        
+        if (n < count) {
+            UInt256 hash;
+            
+            BRSHA256_2(&hash, &msg[off + 81*n], 80);
+            peer_log(peer, "invalid block header: %s", u256hex(hash));
+            for (i = n; i > 0; i--) BRMerkleBlockFree(blocks[i - 1]);
+            r = 0;
+        }
+        else ctx->relayedHeaders(ctx->info, blocks, count);
+        
+        if (blocks != _blocks) free(blocks);
+    }
     else {
         peer_log(peer, "got %zu header(s)", count);
     
@@ -495,23 +535,28 @@ static int _BRPeerAcceptHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t
             }
             else BRPeerSendGetheaders(peer, locators, 2, UINT256_ZERO);
 
-            for (size_t i = 0; r && i < count; i++) {
-                BRMerkleBlock *block = BRMerkleBlockParse(&msg[off + 81*i], 81);
+            // hashing and proof-of-work checks are done for the whole batch in parallel, then the valid headers are
+            // relayed in order so they can be connected to the chain
+            BRMerkleBlock *_blocks[128], **blocks = (count <= 128) ? _blocks : malloc(count*sizeof(*blocks));
+            size_t n;
+            
+            assert(blocks != NULL);
+            n = BRMerkleBlockParseHeaders(blocks, &msg[off], 81, count, (uint32_t)now, HEADER_THREADS);
+            
+            for (size_t i = 0; i < n; i++) {
+                if (ctx->relayedBlock) ctx->relayedBlock(ctx->info, blocks[i]);
+                else BRMerkleBlockFree(blocks[i]);
+            }
+            
+            if (n < count) {
+                UInt256 hash;
                 
-                if (! block) {
-                    peer_log(peer, "malformed headers message with length: %zu", msgLen);
-                    r = 0;
-                }
-                else if (! BRMerkleBlockIsValid(block, (uint32_t)now)) {
-                    peer_log(peer, "invalid block header: %s", u256hex(block->blockHash));
-                    BRMerkleBlockFree(block);
-                    r = 0;
-                }
-                else if (ctx->relayedBlock) {
-                    ctx->relayedBlock(ctx->info, block);
-                }
-                else BRMerkleBlockFree(block);
+                BRSHA256_2(&hash, &msg[off + 81*n], 80);
+                peer_log(peer, "invalid block header: %s", u256hex(hash));
+                r = 0;
             }
+            
+            if (blocks != _blocks) free(blocks);
         }
         else {
             peer_log(peer, "non-standard headers message, %zu is fewer header(s) than expected", count);
@@ -676,7 +721,7 @@ static int _BRPeerAcceptPongMessage(BRPeer *peer, const uint8_t *msg, size_t msg
         peer_log(peer, "malformed pong message, length is %zu, should be %zu", msgLen, sizeof(uint64_t));
         r = 0;
     }
-    else if (UInt64GetLE(msg) != ctx->nonce) {
+    else if (! ctx->replay && UInt64GetLE(msg) != ctx->nonce) { // a replayed pong echoes the captured ping's nonce
         peer_log(peer, "pong message has wrong nonce: %"PRIu64", expected: %"PRIu64, UInt64GetLE(msg), ctx->nonce);
         r = 0;
     }
@@ -834,6 +879,196 @@ static int _BRPeerAcceptFeeFilterMessage(BRPeer *peer, const uint8_t *msg, size_
     return r;
 }
 
+// BIP157: https://github.com/bitcoin/bips/blob/master/bip-0157.mediawiki
+static int _BRPeerAcceptCFHeadersMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen)
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+    size_t off = sizeof(uint8_t) + sizeof(UInt256)*2, len = 0, count;
+    int r = 1;
+    
+    count = (off < msgLen) ? (size_t)BRVarInt(&msg[off], msgLen - off, &len) : 0;
+    
+    if (off + len > msgLen || count > CFILTER_MAX_CFHEADERS || off + len + sizeof(UInt256)*count > msgLen) {
+        peer_log(peer, "malformed cfheaders message, length is %zu, should be %zu for %zu filter hash(es)", msgLen,
+                 off + BRVarIntSize(count) + sizeof(UInt256)*count, count);
+        r = 0;
+    }
+    else if (msg[0] != CFILTER_TYPE_BASIC) {
+        peer_log(peer, "dropping cfheaders with unknown filter type: %u", msg[0]);
+    }
+    else {
+        UInt256 _hashes[128], *hashes = (count <= 128) ? _hashes : malloc(count*sizeof(UInt256));
+        UInt256 stopHash = UInt256Get(&msg[sizeof(uint8_t)]),
+                prevHeader = UInt256Get(&msg[sizeof(uint8_t) + sizeof(UInt256)]);
+        
+        assert(hashes != NULL);
+        peer_log(peer, "got cfheaders with %zu filter hash(es)", count);
+        off += len;
+        
+        for (size_t i = 0; i < count; i++) {
+            hashes[i] = UInt256Get(&msg[off]);
+            off += sizeof(UInt256);
+        }
+        
+        if (ctx->relayedCFHeaders) ctx->relayedCFHeaders(ctx->info, stopHash, prevHeader, hashes, count);
+        if (hashes != _hashes) free(hashes);
+    }
+    
+    return r;
+}
+
+// BIP157: https://github.com/bitcoin/bips/blob/master/bip-0157.mediawiki
+static int _BRPeerAcceptCFilterMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen)
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+    size_t off = sizeof(uint8_t) + sizeof(UInt256), len = 0, filterLen;
+    BRCompactFilter *filter = NULL;
+    int r = 1;
+    
+    filterLen = (off < msgLen) ? (size_t)BRVarInt(&msg[off], msgLen - off, &len) : 0;
+    if (off + len <= msgLen && filterLen <= msgLen - (off + len)) {
+        filter = BRCompactFilterParse(UInt256Get(&msg[sizeof(uint8_t)]), msg[0], &msg[off + len], filterLen);
+    }
+    
+    if (! filter) {
+        peer_log(peer, "malformed cfilter message with length: %zu", msgLen);
+        r = 0;
+    }
+    else if (filter->filterType != CFILTER_TYPE_BASIC) {
+        peer_log(peer, "dropping cfilter with unknown filter type: %u", filter->filterType);
+        BRCompactFilterFree(filter);
+    }
+    else if (ctx->relayedCFilter) {
+        ctx->relayedCFilter(ctx->info, filter);
+    }
+    else BRCompactFilterFree(filter);
+    
+    return r;
+}
+
+// returns the serialized length of the tx at the start of buf, or 0 if it's malformed, and sets txHash to its txid
+// NOTE: BRTransactionParse() only hashes signed transactions, but every tx hash is needed to build the merkle tree
+static size_t _BRPeerBlockTxLength(const uint8_t *buf, size_t bufLen, UInt256 *txHash)
+{
+    size_t i, j, off = sizeof(uint32_t), len = 0, sLen, witnessOff = 0, inCount, outCount, count;
+    int witnessFlag = (off + 2 <= bufLen && buf[off] == 0 && buf[off + 1] == 1);
+    uint8_t *sBuf;
+    
+    if (witnessFlag) off += 2;
+    inCount = (off < bufLen) ? (size_t)BRVarInt(&buf[off], bufLen - off, &len) : 0;
+    off += len;
+    if (inCount == 0 || off > bufLen) return 0;
+    
+    for (i = 0; i < inCount; i++) {
+        off += sizeof(UInt256) + sizeof(uint32_t);
+        sLen = (off < bufLen) ? (size_t)BRVarInt(&buf[off], bufLen - off, &len) : 0;
+        if (off >= bufLen || sLen > bufLen) return 0;
+        off += len + sLen + sizeof(uint32_t);
+        if (off > bufLen) return 0;
+    }
+    
+    outCount = (off < bufLen) ? (size_t)BRVarInt(&buf[off], bufLen - off, &len) : 0;
+    if (off >= bufLen) return 0;
+    off += len;
+    
+    for (i = 0; i < outCount; i++) {
+        off += sizeof(uint64_t);
+        sLen = (off < bufLen) ? (size_t)BRVarInt(&buf[off], bufLen - off, &len) : 0;
+        if (off >= bufLen || sLen > bufLen) return 0;
+        off += len + sLen;
+        if (off > bufLen) return 0;
+    }
+    
+    for (i = 0, witnessOff = off; witnessFlag && i < inCount; i++) {
+        count = (off < bufLen) ? (size_t)BRVarInt(&buf[off], bufLen - off, &len) : 0;
+        if (off >= bufLen) return 0;
+        off += len;
+        
+        for (j = 0; j < count; j++) {
+            sLen = (off < bufLen) ? (size_t)BRVarInt(&buf[off], bufLen - off, &len) : 0;
+            if (off >= bufLen || sLen > bufLen) return 0;
+            off += len + sLen;
+            if (off > bufLen) return 0;
+        }
+    }
+    
+    off += sizeof(uint32_t);
+    if (off > bufLen) return 0;
+    
+    if (witnessFlag) { // txid excludes the marker, flag, and witness data
+        sBuf = malloc((witnessOff - 2) + sizeof(uint32_t));
+        assert(sBuf != NULL);
+        memcpy(sBuf, buf, sizeof(uint32_t));
+        memcpy(&sBuf[sizeof(uint32_t)], &buf[sizeof(uint32_t) + 2], witnessOff - (sizeof(uint32_t) + 2));
+        memcpy(&sBuf[witnessOff - 2], &buf[off - sizeof(uint32_t)], sizeof(uint32_t));
+        BRSHA256_2(txHash, sBuf, (witnessOff - 2) + sizeof(uint32_t));
+        free(sBuf);
+    }
+    else BRSHA256_2(txHash, buf, off);
+    
+    return off;
+}
+
+static int _BRPeerAcceptBlockMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen)
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+    BRMerkleBlock *block = (msgLen >= 80) ? BRMerkleBlockParse(msg, 80) : NULL;
+    size_t i, off = 80, len = 0, txLen, count = (msgLen > off) ? (size_t)BRVarInt(&msg[off], msgLen - off, &len) : 0;
+    BRTransaction **txs = NULL;
+    UInt256 *txHashes = NULL;
+    int r = 1;
+    
+    off += len;
+    
+    if (! block || off > msgLen || count == 0 || count > (msgLen - off)/60) { // a tx is at least 60 bytes
+        peer_log(peer, "malformed block message with length: %zu", msgLen);
+        r = 0;
+    }
+    else if (! BRMerkleBlockIsValid(block, (uint32_t)time(NULL))) {
+        peer_log(peer, "invalid block: %s", u256hex(block->blockHash));
+        r = 0;
+    }
+    else {
+        txs = calloc(count, sizeof(*txs));
+        txHashes = calloc(count, sizeof(*txHashes));
+        assert(txs != NULL);
+        assert(txHashes != NULL);
+        
+        for (i = 0; r && i < count; i++) {
+            txLen = _BRPeerBlockTxLength(&msg[off], msgLen - off, &txHashes[i]);
+            
+            if (txLen == 0) {
+                peer_log(peer, "malformed tx %zu in block: %s", i, u256hex(block->blockHash));
+                r = 0;
+            }
+            else {
+                txs[i] = BRTransactionParse(&msg[off], txLen);
+                
+                if (txs[i] && ! UInt256Eq(txs[i]->txHash, txHashes[i])) { // unsigned or non-standard tx
+                    BRTransactionFree(txs[i]);
+                    txs[i] = NULL;
+                }
+                
+                off += txLen;
+            }
+        }
+        
+        if (r) peer_log(peer, "got block %s with %zu tx", u256hex(block->blockHash), count);
+    }
+    
+    if (r && ctx->relayedFullBlock) {
+        ctx->relayedFullBlock(ctx->info, block, txs, txHashes, count);
+    }
+    else {
+        for (i = 0; txs && i < count; i++) if (txs[i]) BRTransactionFree(txs[i]);
+        if (block) BRMerkleBlockFree(block);
+    }
+    
+    if (txs) free(txs);
+    if (txHashes) free(txHashes);
+    return r;
+}
+
 static int _BRPeerAcceptMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen, const char *type)
 {
     BRPeerContext *ctx = (BRPeerContext *)peer;
@@ -860,6 +1095,9 @@ static int _BRPeerAcceptMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen,
     else if (strncmp(MSG_MERKLEBLOCK, type, 12) == 0) r = _BRPeerAcceptMerkleblockMessage(peer, msg, msgLen);
     else if (strncmp(MSG_REJECT, type, 12) == 0) r = _BRPeerAcceptRejectMessage(peer, msg, msgLen);
     else if (strncmp(MSG_FEEFILTER, type, 12) == 0) r = _BRPeerAcceptFeeFilterMessage(peer, msg, msgLen);
+    else if (strncmp(MSG_CFHEADERS, type, 12) == 0) r = _BRPeerAcceptCFHeadersMessage(peer, msg, msgLen);
+    else if (strncmp(MSG_CFILTER, type, 12) == 0) r = _BRPeerAcceptCFilterMessage(peer, msg, msgLen);
+    else if (strncmp(MSG_BLOCK, type, 12) == 0) r = _BRPeerAcceptBlockMessage(peer, msg, msgLen);
     else peer_log(peer, "dropping %s, length %zu, not implemented", type, msgLen);
 
     return r;
@@ -944,6 +1182,78 @@ static int _BRPeerOpenSocket(BRPeer *peer, int domain, double timeout, int *erro
     return r;
 }
 
+// opens the stream captured for peer in replay, if there's one left
+static int _BRPeerOpenReplayStream(BRPeer *peer)
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+    char name[INET6_ADDRSTRLEN + 8];
+
+    snprintf(name, sizeof(name), "%s:%"PRIu16, BRPeerHost(peer), peer->port);
+    return BRCaptureReplayOpenStream(ctx->replay, name, &ctx->replayStream);
+}
+
+// "connects" to the replay stream opened by BRPeerConnect(); the socket is one end of a socketpair so that
+// disconnecting works as usual, but it is never read or written
+static int _BRPeerOpenReplay(BRPeer *peer, int *error)
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+    int fds[2], err = 0;
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+        err = errno;
+        BRCaptureReplayCloseStream(ctx->replay, ctx->replayStream);
+    }
+    else {
+        close(fds[1]);
+        ctx->replayBytesCount = 0;
+
+        pthread_mutex_lock(&ctx->lock);
+        ctx->socket = fds[0];
+        pthread_mutex_unlock(&ctx->lock);
+        peer_log(peer, "replay connected");
+    }
+
+    if (err) peer_log(peer, "replay error: %s", strerror(err));
+    if (error && err) *error = err;
+    return ! err;
+}
+
+// reads from socket or, when replaying, from the captured stream; returns as read() does - when replaying, all the
+// messages already deliverable are returned together, up to bufLen, as a socket would have them buffered
+static ssize_t _BRPeerRead(BRPeerContext *ctx, int socket, uint8_t *buf, size_t bufLen)
+{
+    size_t n, len = 0;
+
+    BRMetricsCounterAdd(ctx->reads, 1);
+    if (! ctx->replay) return read(socket, buf, bufLen);
+
+    if (BRPeerConnectStatus(&ctx->peer) == BRPeerStatusDisconnected) {
+        errno = ENOTCONN;
+        return -1;
+    }
+
+    if (ctx->replayBytesCount == 0) {
+        // wait as long as a socket read would, so the disconnect and mempool times are checked as usual
+        switch (BRCaptureReplayNext(ctx->replay, ctx->replayStream, 1.0, &ctx->replayBytes, &ctx->replayBytesCount)) {
+            case BR_CAPTURE_REPLAY_READY: break;
+            case BR_CAPTURE_REPLAY_WAIT: errno = EWOULDBLOCK; return -1;
+            case BR_CAPTURE_REPLAY_END: return 0;
+        }
+    }
+
+    while (len < bufLen && (ctx->replayBytesCount > 0 ||
+                            BRCaptureReplayNext(ctx->replay, ctx->replayStream, 0, &ctx->replayBytes,
+                                                &ctx->replayBytesCount) == BR_CAPTURE_REPLAY_READY)) {
+        n = (bufLen - len < ctx->replayBytesCount) ? bufLen - len : ctx->replayBytesCount;
+        memcpy(&buf[len], ctx->replayBytes, n);
+        ctx->replayBytes += n;
+        ctx->replayBytesCount -= n;
+        len += n;
+    }
+
+    return (ssize_t)len;
+}
+
 static int _peerCheckAndGetSocket (BRPeerContext *ctx, int *socket) {
     int exists;
 
@@ -984,7 +1294,60 @@ static double _peerGetMempoolTime (BRPeerContext *ctx) {
 
     return value;
 }
+#ifndef MSG_NOSIGNAL   // linux based systems have a MSG_NOSIGNAL send flag, useful for supressing SIGPIPE signals
+#define MSG_NOSIGNAL 0 // set to 0 if undefined (BSD has the SO_NOSIGPIPE sockopt, and windows has no signals at all)
+#endif
+
+// writes the queued messages, as many per sendmsg() as SEND_IOV_MAX allows; must hold sendLock
+static int _BRPeerFlush(BRPeerContext *ctx)
+{
+    struct iovec iov[SEND_IOV_MAX];
+    struct msghdr msg;
+    struct timeval tv;
+    size_t i, count, len;
+    ssize_t n = 0;
+    int socket = _peerGetSocket(ctx), error = 0;
+
+    while (socket >= 0 && ! error && array_count(ctx->sendQueue) > 0) {
+        count = (array_count(ctx->sendQueue) < SEND_IOV_MAX) ? array_count(ctx->sendQueue) : SEND_IOV_MAX;
+        memcpy(iov, ctx->sendQueue, count*sizeof(*iov));
+        iov[0].iov_base = (uint8_t *)iov[0].iov_base + ctx->sendOffset;
+        iov[0].iov_len -= ctx->sendOffset;
+        for (i = 0, len = 0; i < count; i++) len += iov[i].iov_len;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = (int)count;
+        BRMetricsCounterAdd(ctx->writes, 1);
+        n = (ctx->replay) ? (ssize_t)len : sendmsg(socket, &msg, MSG_NOSIGNAL); // when replaying, nothing to send to
+        if (n < 0 && errno != EWOULDBLOCK) error = errno;
+
+        for (len = (n > 0) ? (size_t)n + ctx->sendOffset : ctx->sendOffset, i = 0;
+             i < count && len >= ctx->sendQueue[i].iov_len; i++) {
+            len -= ctx->sendQueue[i].iov_len;
+            BRMetricsCounterAdd(ctx->messagesSent, 1);
+            BRMetricsCounterAdd(ctx->bytesSent, ctx->sendQueue[i].iov_len);
+            free(ctx->sendQueue[i].iov_base);
+        }
+
+        if (i > 0) array_rm_range(ctx->sendQueue, 0, i);
+        ctx->sendOffset = len;
+        gettimeofday(&tv, NULL);
+        if (! error && tv.tv_sec + (double)tv.tv_usec/1000000 >= _peerGetDisconnectTime(ctx)) error = ETIMEDOUT;
+        socket = _peerGetSocket(ctx);
+    }
+
+    if (error) { // the connection is lost, along with anything still queued
+        for (i = 0; i < array_count(ctx->sendQueue); i++) free(ctx->sendQueue[i].iov_base);
+        array_clear(ctx->sendQueue);
+        ctx->sendOffset = 0;
+    }
+
+    return error;
+}
 
+// the peer whose thread is the current thread, if any; messages it sends are queued and written together after it has
+// handled everything already read
+static __thread BRPeerContext *_peerThreadContext = NULL;
 
 static void *_peerThreadRoutine(void *arg)
 {
@@ -994,28 +1357,116 @@ static void *_peerThreadRoutine(void *arg)
 
     pthread_cleanup_push(ctx->threadCleanup, ctx->info);
     
-    if (_BRPeerOpenSocket(peer, PF_INET6, CONNECT_TIMEOUT, &error)) {
+    if (ctx->replay ? _BRPeerOpenReplay(peer, &error) : _BRPeerOpenSocket(peer, PF_INET6, CONNECT_TIMEOUT, &error)) {
         struct timeval tv;
-        double time = 0, msgTimeout;
-        uint8_t header[HEADER_LENGTH], *payload = malloc(0x1000);
-        size_t len = 0, payloadLen = 0x1000;
+        double time = 0, msgTimeout = DBL_MAX;
+        uint8_t *buf = malloc(RECV_BUFFER_LENGTH);
+        size_t start = 0, end = 0, bufLen = RECV_BUFFER_LENGTH, i;
         ssize_t n = 0;
 
-        assert(payload != NULL);
+        assert(buf != NULL);
+        _peerThreadContext = ctx;
+
+        if (ctx->capture) {
+            char name[INET6_ADDRSTRLEN + 8];
+
+            snprintf(name, sizeof(name), "%s:%"PRIu16, BRPeerHost(peer), peer->port);
+            ctx->captureStream = BRCaptureOpenStream(ctx->capture, name);
+        }
+
         gettimeofday(&tv, NULL);
         ctx->startTime = tv.tv_sec + (double)tv.tv_usec/1000000;
         BRPeerSendVersionMessage(peer);
 
+        // buf[start..end] holds what has been read but not yet handled; each read takes as much as the socket has, and
+        // every complete message is then handled in place
         while (_peerCheckAndGetSocket(ctx, &socket) && ! error) {
-            len = 0;
+            uint32_t msgLen = 0;
+            int inMessage = 0;
 
-            while (socket >= 0 && ! error && len < HEADER_LENGTH) {
-                n = read(socket, &header[len], sizeof(header) - len);
-                if (n > 0) len += n;
+            while (! error && end - start >= HEADER_LENGTH) {
+                const uint8_t *header = &buf[start];
+                const char *type = (const char *)(&header[4]);
+                uint32_t checksum = UInt32GetLE(&header[20]);
+                UInt256 hash;
+
+                if (UInt32GetLE(header) != ctx->magicNumber) { // consume one byte at a time until we find the magic number
+                    start++;
+                    continue;
+                }
+
+                msgLen = UInt32GetLE(&header[16]);
+
+                if (header[15] != 0) { // verify header type field is NULL terminated
+                    peer_log(peer, "malformed message header: type not NULL terminated");
+                    error = EPROTO;
+                }
+                else if (msgLen > MAX_MSG_LENGTH) { // check message length
+                    peer_log(peer, "error reading %s, message length %"PRIu32" is too long", type, msgLen);
+                    error = EPROTO;
+                }
+                else if (end - start < HEADER_LENGTH + msgLen) { // wait for the rest of the payload
+                    inMessage = 1;
+                    break;
+                }
+                else {
+                    BRSHA256_2(&hash, &header[HEADER_LENGTH], msgLen);
+
+                    if (UInt32GetLE(&hash) != checksum) { // verify checksum
+                        peer_log(peer, "error reading %s, invalid checksum %x, expected %x, payload length:%"PRIu32
+                                 ", SHA256_2:%s", type, UInt32GetLE(&hash), checksum, msgLen, u256hex(hash));
+                        error = EPROTO;
+                    }
+                    else {
+                        BRMetricsCounterAdd(ctx->messagesReceived, 1);
+                        BRMetricsCounterAdd(ctx->bytesReceived, HEADER_LENGTH + msgLen);
+
+                        // capture the message as it was on the wire
+                        if (ctx->capture) BRCaptureAddRecv(ctx->capture, ctx->captureStream, header,
+                                                           HEADER_LENGTH + msgLen);
+
+                        start += HEADER_LENGTH + msgLen;
+                        if (! _BRPeerAcceptMessage(peer, &header[HEADER_LENGTH], msgLen, type)) error = EPROTO;
+                    }
+                }
+            }
+
+            if (error) break;
+
+            if (start == end) start = end = 0;
+            else if (start > 0) { // move the partial message to the front
+                memmove(buf, &buf[start], end - start);
+                end -= start;
+                start = 0;
+            }
+
+            if (inMessage && HEADER_LENGTH + msgLen > bufLen) {
+                buf = realloc(buf, (bufLen = HEADER_LENGTH + msgLen));
+                assert(buf != NULL);
+            }
+
+            // write everything the handled messages queued, then read
+            pthread_mutex_lock(&ctx->sendLock);
+            error = _BRPeerFlush(ctx);
+            pthread_mutex_unlock(&ctx->sendLock);
+            socket = _peerGetSocket(ctx);
+
+            if (! error && socket >= 0) {
+                n = _BRPeerRead(ctx, socket, &buf[end], bufLen - end);
+                if (n > 0) end += (size_t)n;
                 if (n == 0) error = ECONNRESET;
                 if (n < 0 && errno != EWOULDBLOCK) error = errno;
-                gettimeofday(&tv, NULL);
-                time = tv.tv_sec + (double)tv.tv_usec/1000000;
+            }
+
+            gettimeofday(&tv, NULL);
+            time = tv.tv_sec + (double)tv.tv_usec/1000000;
+
+            if (inMessage) { // part way through a message, the peer must keep sending
+                if (n > 0 || msgTimeout == DBL_MAX) msgTimeout = time + MESSAGE_TIMEOUT;
+                if (! error && time >= msgTimeout) error = ETIMEDOUT;
+            }
+            else {
+                msgTimeout = DBL_MAX;
                 if (! error && time >= _peerGetDisconnectTime(ctx)) error = ETIMEDOUT;
 
                 if (! error && time >= _peerGetMempoolTime(ctx)) {
@@ -1027,68 +1478,21 @@ static void *_peerThreadRoutine(void *arg)
                     ctx->mempoolTime = DBL_MAX;
                     pthread_mutex_unlock(&ctx->lock);
                 }
-
-                while (sizeof(uint32_t) <= len && UInt32GetLE(header) != ctx->magicNumber) {
-                    memmove(header, &header[1], --len); // consume one byte at a time until we find the magic number
-                }
-
-                socket = _peerGetSocket(ctx);
-            }
-            
-            if (error) {
-                peer_log(peer, "%s", strerror(error));
-            }
-            else if (header[15] != 0) { // verify header type field is NULL terminated
-                peer_log(peer, "malformed message header: type not NULL terminated");
-                error = EPROTO;
-            }
-            else if (len == HEADER_LENGTH) {
-                const char *type = (const char *)(&header[4]);
-                uint32_t msgLen = UInt32GetLE(&header[16]);
-                uint32_t checksum = UInt32GetLE(&header[20]);
-                UInt256 hash;
-                
-                if (msgLen > MAX_MSG_LENGTH) { // check message length
-                    peer_log(peer, "error reading %s, message length %"PRIu32" is too long", type, msgLen);
-                    error = EPROTO;
-                }
-                else {
-                    if (msgLen > payloadLen) payload = realloc(payload, (payloadLen = msgLen));
-                    assert(payload != NULL);
-                    len = 0;
-                    socket = _peerGetSocket(ctx);
-                    msgTimeout = time + MESSAGE_TIMEOUT;
-                    
-                    while (socket >= 0 && ! error && len < msgLen) {
-                        n = read(socket, &payload[len], msgLen - len);
-                        if (n > 0) len += n;
-                        if (n == 0) error = ECONNRESET;
-                        if (n < 0 && errno != EWOULDBLOCK) error = errno;
-                        gettimeofday(&tv, NULL);
-                        time = tv.tv_sec + (double)tv.tv_usec/1000000;
-                        if (n > 0) msgTimeout = time + MESSAGE_TIMEOUT;
-                        if (! error && time >= msgTimeout) error = ETIMEDOUT;
-                        socket = _peerGetSocket(ctx);
-                    }
-                    
-                    if (error) {
-                        peer_log(peer, "%s", strerror(error));
-                    }
-                    else if (len == msgLen) {
-                        BRSHA256_2(&hash, payload, msgLen);
-                        
-                        if (UInt32GetLE(&hash) != checksum) { // verify checksum
-                            peer_log(peer, "error reading %s, invalid checksum %x, expected %x, payload length:%"PRIu32
-                                     ", SHA256_2:%s", type, UInt32GetLE(&hash), checksum, msgLen, u256hex(hash));
-                            error = EPROTO;
-                        }
-                        else if (! _BRPeerAcceptMessage(peer, payload, msgLen, type)) error = EPROTO;
-                    }
-                }
             }
+
+            if (error) peer_log(peer, "%s", strerror(error));
         }
-        
-        free(payload);
+
+        _peerThreadContext = NULL;
+        pthread_mutex_lock(&ctx->sendLock);
+        for (i = 0; i < array_count(ctx->sendQueue); i++) free(ctx->sendQueue[i].iov_base);
+        array_clear(ctx->sendQueue);
+        ctx->sendOffset = 0;
+        pthread_mutex_unlock(&ctx->sendLock);
+
+        free(buf);
+        if (ctx->capture) BRCaptureCloseStream(ctx->capture, ctx->captureStream);
+        if (ctx->replay) BRCaptureReplayCloseStream(ctx->replay, ctx->replayStream);
     }
 
     pthread_mutex_lock(&ctx->lock);
@@ -1133,6 +1537,7 @@ BRPeer *BRPeerNew(uint32_t magicNumber)
     ctx->knownTxHashSet = BRSetNew(BRTransactionHash, BRTransactionEq, 10);
     array_new(ctx->pongInfo, 10);
     array_new(ctx->pongCallback, 10);
+    array_new(ctx->sendQueue, 10);
     ctx->pingTime = DBL_MAX;
     ctx->mempoolTime = DBL_MAX;
     ctx->disconnectTime = DBL_MAX;
@@ -1144,6 +1549,7 @@ BRPeer *BRPeerNew(uint32_t magicNumber)
         pthread_mutexattr_init(&attr);
         pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL);
         pthread_mutex_init(&ctx->lock, &attr);
+        pthread_mutex_init(&ctx->sendLock, &attr);
         pthread_mutexattr_destroy(&attr);
     }
 
@@ -1194,12 +1600,62 @@ void BRPeerSetCallbacks(BRPeer *peer, void *info,
     ctx->threadCleanup = (threadCleanup) ? threadCleanup : _dummyThreadCleanup;
 }
 
+// callbacks used for BIP157 compact filter sync, ownership of all relayed blocks, filters and txs passes to the callee
+// once relayedHeaders is set, "headers" messages are relayed as a batch and the peer no longer requests the next headers
+// or switches to requesting blocks on its own, that is left to the caller
+// void relayedHeaders(void *, BRMerkleBlock *[], size_t) - called with the validated headers of a "headers" message
+// void relayedCFHeaders(void *, UInt256, UInt256, const UInt256[], size_t) - called when "cfheaders" is received with
+//      the stop hash, the previous filter header, and the filter hashes
+// void relayedCFilter(void *, BRCompactFilter *) - called when a "cfilter" message is received from peer
+// void relayedFullBlock(void *, BRMerkleBlock *, BRTransaction *[], const UInt256[], size_t) - called when a "block"
+//      message is received, txs has a NULL entry for any tx that couldn't be parsed, txHashes has every tx hash in order
+void BRPeerSetCompactFilterCallbacks(BRPeer *peer,
+                                     void (*relayedHeaders)(void *info, BRMerkleBlock *blocks[], size_t blocksCount),
+                                     void (*relayedCFHeaders)(void *info, UInt256 stopHash, UInt256 prevHeader,
+                                                              const UInt256 filterHashes[], size_t hashesCount),
+                                     void (*relayedCFilter)(void *info, BRCompactFilter *filter),
+                                     void (*relayedFullBlock)(void *info, BRMerkleBlock *block, BRTransaction *txs[],
+                                                              const UInt256 txHashes[], size_t txCount))
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+    
+    ctx->relayedHeaders = relayedHeaders;
+    ctx->relayedCFHeaders = relayedCFHeaders;
+    ctx->relayedCFilter = relayedCFilter;
+    ctx->relayedFullBlock = relayedFullBlock;
+}
+
 // set earliestKeyTime to wallet creation time in order to speed up initial sync
 void BRPeerSetEarliestKeyTime(BRPeer *peer, uint32_t earliestKeyTime)
 {
     ((BRPeerContext *)peer)->earliestKeyTime = earliestKeyTime;
 }
 
+// count messages and bytes sent and received in metrics; set before connecting
+void BRPeerSetMetrics(BRPeer *peer, BRMetrics metrics)
+{
+    BRPeerContext *ctx = (BRPeerContext *)peer;
+
+    ctx->messagesSent = BRMetricsGetCounter(metrics, "peer.messagesSent");
+    ctx->bytesSent = BRMetricsGetCounter(metrics, "peer.bytesSent");
+    ctx->messagesReceived = BRMetricsGetCounter(metrics, "peer.messagesReceived");
+    ctx->bytesReceived = BRMetricsGetCounter(metrics, "peer.bytesReceived");
+    ctx->reads = BRMetricsGetCounter(metrics, "peer.reads");
+    ctx->writes = BRMetricsGetCounter(metrics, "peer.writes");
+}
+
+// record the messages sent to and received from peer in capture; set before connecting
+void BRPeerSetCapture(BRPeer *peer, BRCapture capture)
+{
+    ((BRPeerContext *)peer)->capture = capture;
+}
+
+// replay the stream captured for peer rather than connecting to the network; set before connecting
+void BRPeerSetReplay(BRPeer *peer, BRCaptureReplay replay)
+{
+    ((BRPeerContext *)peer)->replay = replay;
+}
+
 // call this when local block height changes (helps detect tarpit nodes)
 void BRPeerSetCurrentBlockHeight(BRPeer *peer, uint32_t currentBlockHeight)
 {
@@ -1242,9 +1698,16 @@ void BRPeerConnect(BRPeer *peer)
             // No race - set before the thread starts.
             ctx->disconnectTime = tv.tv_sec + (double)tv.tv_usec/1000000 + CONNECT_TIMEOUT;
 
-            if (pthread_attr_init(&attr) != 0) {
+            // a replay with no stream left for peer fails before the thread starts, like a thread error, since a
+            // thread failing at once would race the caller's check for a failed connect
+            if (ctx->replay && ! _BRPeerOpenReplayStream(peer)) {
+                peer_log(peer, "replay error: %s", strerror(ECONNREFUSED));
+                ctx->status = BRPeerStatusDisconnected;
+            }
+            else if (pthread_attr_init(&attr) != 0) {
                 // error = ENOMEM;
                 peer_log(peer, "error creating thread");
+                if (ctx->replay) BRCaptureReplayCloseStream(ctx->replay, ctx->replayStream);
                 ctx->status = BRPeerStatusDisconnected;
                 //if (ctx->disconnected) ctx->disconnected(ctx->info, error);
             }
@@ -1254,6 +1717,7 @@ void BRPeerConnect(BRPeer *peer)
                 // error = EAGAIN;
                 peer_log(peer, "error creating thread");
                 pthread_attr_destroy(&attr);
+                if (ctx->replay) BRCaptureReplayCloseStream(ctx->replay, ctx->replayStream);
                 ctx->status = BRPeerStatusDisconnected;
                 //if (ctx->disconnected) ctx->disconnected(ctx->info, error);
             }
@@ -1348,11 +1812,8 @@ uint64_t BRPeerFeePerKb(BRPeer *peer)
     return feePerKb;
 }
 
-#ifndef MSG_NOSIGNAL   // linux based systems have a MSG_NOSIGNAL send flag, useful for supressing SIGPIPE signals
-#define MSG_NOSIGNAL 0 // set to 0 if undefined (BSD has the SO_NOSIGPIPE sockopt, and windows has no signals at all)
-#endif
-
-// sends a bitcoin protocol message to peer
+// sends a bitcoin protocol message to peer; messages sent from the peer's own thread are queued and written together
+// once the messages already received are handled
 void BRPeerSendMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen, const char *type)
 {
     if (msgLen > MAX_MSG_LENGTH) {
@@ -1360,12 +1821,11 @@ void BRPeerSendMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen, const ch
     }
     else {
         BRPeerContext *ctx = (BRPeerContext *)peer;
-        uint8_t buf[HEADER_LENGTH + msgLen], hash[32];
+        uint8_t *buf = malloc(HEADER_LENGTH + msgLen), hash[32];
         size_t off = 0;
-        ssize_t n = 0;
-        struct timeval tv;
-        int socket, error = 0;
+        int error = 0;
         
+        assert(buf != NULL);
         UInt32SetLE(&buf[off], ctx->magicNumber);
         off += sizeof(uint32_t);
         strncpy((char *)&buf[off], type, 12);
@@ -1377,19 +1837,22 @@ void BRPeerSendMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen, const ch
         off += sizeof(uint32_t);
         memcpy(&buf[off], msg, msgLen);
         peer_log(peer, "sending %s", type);
-        msgLen = 0;
-        socket = _peerGetSocket(ctx);
-        if (socket < 0) error = ENOTCONN;
-        
-        while (socket >= 0 && ! error && msgLen < sizeof(buf)) {
-            n = send(socket, &buf[msgLen], sizeof(buf) - msgLen, MSG_NOSIGNAL);
-            if (n >= 0) msgLen += n;
-            if (n < 0 && errno != EWOULDBLOCK) error = errno;
-            gettimeofday(&tv, NULL);
-            if (! error && tv.tv_sec + (double)tv.tv_usec/1000000 >= _peerGetDisconnectTime(ctx)) error = ETIMEDOUT;
-            socket = _peerGetSocket(ctx);
+
+        pthread_mutex_lock(&ctx->sendLock);
+
+        if (_peerGetSocket(ctx) < 0) {
+            error = ENOTCONN;
+            free(buf);
         }
-        
+        else {
+            if (ctx->capture) BRCaptureAddSend(ctx->capture, ctx->captureStream, buf, HEADER_LENGTH + msgLen);
+            if (ctx->replay) BRCaptureReplaySent(ctx->replay, ctx->replayStream);
+            array_add(ctx->sendQueue, ((struct iovec) { .iov_base = buf, .iov_len = HEADER_LENGTH + msgLen }));
+            if (_peerThreadContext != ctx) error = _BRPeerFlush(ctx);
+        }
+
+        pthread_mutex_unlock(&ctx->sendLock);
+
         if (error) {
             peer_log(peer, "%s", strerror(error));
             BRPeerDisconnect(peer);
@@ -1455,6 +1918,15 @@ void BRPeerSendFilterload(BRPeer *peer, const uint8_t *filter, size_t filterLen)
     BRPeerSendMessage(peer, filter, filterLen, MSG_FILTERLOAD);
 }
 
+void BRPeerSendFilteradd(BRPeer *peer, const uint8_t *data, size_t dataLen)
+{
+    uint8_t msg[BRVarIntSize(dataLen) + dataLen];
+    size_t off = BRVarIntSet(msg, sizeof(msg), dataLen);
+    
+    memcpy(&msg[off], data, dataLen);
+    BRPeerSendMessage(peer, msg, off + dataLen, MSG_FILTERADD);
+}
+
 void BRPeerSendMempool(BRPeer *peer, const UInt256 knownTxHashes[], size_t knownTxCount, void *info,
                        void (*completionCallback)(void *info, int success))
 {
@@ -1594,6 +2066,56 @@ void BRPeerSendGetdata(BRPeer *peer, const UInt256 txHashes[], size_t txCount, c
     }
 }
 
+void BRPeerSendGetdataBlocks(BRPeer *peer, const UInt256 blockHashes[], size_t blockCount)
+{
+    size_t i, off = 0;
+    
+    if (blockCount > MAX_GETDATA_HASHES) { // limit total hash count to MAX_GETDATA_HASHES
+        peer_log(peer, "couldn't send getdata, %zu is too many items, max is %d", blockCount, MAX_GETDATA_HASHES);
+    }
+    else if (blockCount > 0) {
+        size_t msgLen = BRVarIntSize(blockCount) + (sizeof(uint32_t) + sizeof(UInt256))*blockCount;
+        uint8_t msg[msgLen];
+        
+        off += BRVarIntSet(&msg[off], (off <= msgLen ? msgLen - off : 0), blockCount);
+        
+        for (i = 0; i < blockCount; i++) {
+            UInt32SetLE(&msg[off], inv_witness_block);
+            off += sizeof(uint32_t);
+            UInt256Set(&msg[off], blockHashes[i]);
+            off += sizeof(UInt256);
+        }
+        
+        ((BRPeerContext *)peer)->sentGetdata = 1;
+        BRPeerSendMessage(peer, msg, off, MSG_GETDATA);
+    }
+}
+
+static void _BRPeerSendCompactFilterRequest(BRPeer *peer, uint32_t startHeight, UInt256 stopHash, const char *type)
+{
+    size_t off = 0;
+    uint8_t msg[sizeof(uint8_t) + sizeof(uint32_t) + sizeof(UInt256)];
+    
+    msg[off] = CFILTER_TYPE_BASIC;
+    off += sizeof(uint8_t);
+    UInt32SetLE(&msg[off], startHeight);
+    off += sizeof(uint32_t);
+    UInt256Set(&msg[off], stopHash);
+    off += sizeof(UInt256);
+    peer_log(peer, "calling %s with start height %"PRIu32" stop hash: %s", type, startHeight, u256hex(stopHash));
+    BRPeerSendMessage(peer, msg, off, type);
+}
+
+void BRPeerSendGetcfheaders(BRPeer *peer, uint32_t startHeight, UInt256 stopHash)
+{
+    _BRPeerSendCompactFilterRequest(peer, startHeight, stopHash, MSG_GETCFHEADERS);
+}
+
+void BRPeerSendGetcfilters(BRPeer *peer, uint32_t startHeight, UInt256 stopHash)
+{
+    _BRPeerSendCompactFilterRequest(peer, startHeight, stopHash, MSG_GETCFILTERS);
+}
+
 void BRPeerSendGetaddr(BRPeer *peer)
 {
     ((BRPeerContext *)peer)->sentGetaddr = 1;
@@ -1640,7 +2162,13 @@ void BRPeerFree(BRPeer *peer)
     if (ctx->knownTxHashSet) BRSetFree(ctx->knownTxHashSet);
     if (ctx->pongCallback) array_free(ctx->pongCallback);
     if (ctx->pongInfo) array_free(ctx->pongInfo);
-    
+
+    if (ctx->sendQueue) {
+        for (size_t i = 0; i < array_count(ctx->sendQueue); i++) free(ctx->sendQueue[i].iov_base);
+        array_free(ctx->sendQueue);
+    }
+
+    pthread_mutex_destroy(&ctx->sendLock);
     pthread_mutex_destroy(&ctx->lock);
     free(ctx);
 }
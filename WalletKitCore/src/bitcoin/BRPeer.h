@@ -27,8 +27,11 @@
 
 #include "BRTransaction.h"
 #include "BRMerkleBlock.h"
+#include "BRCompactFilter.h"
 #include "support/BRAddress.h"
 #include "support/BRInt.h"
+#include "support/BRMetrics.h"
+#include "support/BRCapture.h"
 #include <stddef.h>
 #include <inttypes.h>
 
@@ -56,6 +59,7 @@ extern "C" {
 #define SERVICES_NODE_BLOOM   0x04 // BIP111: https://github.com/bitcoin/bips/blob/master/bip-0111.mediawiki
 #define SERVICES_NODE_WITNESS 0x08 // BIP144: https://github.com/bitcoin/bips/blob/master/bip-0144.mediawiki
 #define SERVICES_NODE_BCASH   0x20 // https://github.com/Bitcoin-UAHF/spec/blob/master/uahf-technical-spec.md
+#define SERVICES_NODE_COMPACT_FILTERS 0x40 // BIP157: https://github.com/bitcoin/bips/blob/master/bip-0157.mediawiki
     
 #define BR_VERSION "2.1"
 #define USER_AGENT "/bread:" BR_VERSION "/"
@@ -83,6 +87,10 @@ extern "C" {
 #define MSG_ALERT       "alert"
 #define MSG_REJECT      "reject"   // described in BIP61: https://github.com/bitcoin/bips/blob/master/bip-0061.mediawiki
 #define MSG_FEEFILTER   "feefilter"// described in BIP133 https://github.com/bitcoin/bips/blob/master/bip-0133.mediawiki
+#define MSG_GETCFILTERS  "getcfilters" // described in BIP157: https://github.com/bitcoin/bips/blob/master/bip-0157.mediawiki
+#define MSG_CFILTER      "cfilter"
+#define MSG_GETCFHEADERS "getcfheaders"
+#define MSG_CFHEADERS    "cfheaders"
 
 #define REJECT_INVALID     0x10 // transaction is invalid for some reason (invalid signature, output value > input, etc)
 #define REJECT_SPENT       0x12 // an input is already spent
@@ -138,9 +146,39 @@ void BRPeerSetCallbacks(BRPeer *peer, void *info,
                         int (*networkIsReachable)(void *info),
                         void (*threadCleanup)(void *info));
 
+// callbacks used for BIP157 compact filter sync, ownership of all relayed blocks, filters and txs passes to the callee
+// once relayedHeaders is set, "headers" messages are relayed as a batch and the peer no longer requests the next headers
+// or switches to requesting blocks on its own, that is left to the caller
+// void relayedHeaders(void *, BRMerkleBlock *[], size_t) - called with the validated headers of a "headers" message
+// void relayedCFHeaders(void *, UInt256, UInt256, const UInt256[], size_t) - called when "cfheaders" is received with
+//      the stop hash, the previous filter header, and the filter hashes
+// void relayedCFilter(void *, BRCompactFilter *) - called when a "cfilter" message is received from peer
+// void relayedFullBlock(void *, BRMerkleBlock *, BRTransaction *[], const UInt256[], size_t) - called when a "block"
+//      message is received, txs has a NULL entry for any tx that couldn't be parsed, txHashes has every tx hash in order
+void BRPeerSetCompactFilterCallbacks(BRPeer *peer,
+                                     void (*relayedHeaders)(void *info, BRMerkleBlock *blocks[], size_t blocksCount),
+                                     void (*relayedCFHeaders)(void *info, UInt256 stopHash, UInt256 prevHeader,
+                                                              const UInt256 filterHashes[], size_t hashesCount),
+                                     void (*relayedCFilter)(void *info, BRCompactFilter *filter),
+                                     void (*relayedFullBlock)(void *info, BRMerkleBlock *block, BRTransaction *txs[],
+                                                              const UInt256 txHashes[], size_t txCount));
+
 // set earliestKeyTime to wallet creation time in order to speed up initial sync
 void BRPeerSetEarliestKeyTime(BRPeer *peer, uint32_t earliestKeyTime);
 
+// count messages and bytes sent and received in metrics ("peer.messagesSent", "peer.bytesSent",
+// "peer.messagesReceived", "peer.bytesReceived"), and the socket reads and writes that carried them ("peer.reads",
+// "peer.writes"); set before connecting, metrics must outlive the peer
+void BRPeerSetMetrics(BRPeer *peer, BRMetrics metrics);
+
+// record the messages sent to and received from peer in capture, as a stream named "host:port"; set before
+// connecting, capture must outlive the peer
+void BRPeerSetCapture(BRPeer *peer, BRCapture capture);
+
+// connect to the stream captured for peer, by "host:port", in replay rather than to the network; received messages are
+// read from the stream and sent messages are discarded; set before connecting, replay must outlive the peer
+void BRPeerSetReplay(BRPeer *peer, BRCaptureReplay replay);
+
 // call this when local best block height changes (helps detect tarpit nodes)
 void BRPeerSetCurrentBlockHeight(BRPeer *peer, uint32_t currentBlockHeight);
 
@@ -180,6 +218,7 @@ double BRPeerPingTime(BRPeer *peer);
 // sends a bitcoin protocol message to peer
 void BRPeerSendMessage(BRPeer *peer, const uint8_t *msg, size_t msgLen, const char *type);
 void BRPeerSendFilterload(BRPeer *peer, const uint8_t *filter, size_t filterLen);
+void BRPeerSendFilteradd(BRPeer *peer, const uint8_t *data, size_t dataLen);
 void BRPeerSendMempool(BRPeer *peer, const UInt256 knownTxHashes[], size_t knownTxCount, void *info,
                        void (*completionCallback)(void *info, int success));
 void BRPeerSendGetheaders(BRPeer *peer, const UInt256 locators[], size_t locatorsCount, UInt256 hashStop);
@@ -187,6 +226,9 @@ void BRPeerSendGetblocks(BRPeer *peer, const UInt256 locators[], size_t locators
 void BRPeerSendInv(BRPeer *peer, const UInt256 txHashes[], size_t txCount);
 void BRPeerSendGetdata(BRPeer *peer, const UInt256 txHashes[], size_t txCount, const UInt256 blockHashes[],
                        size_t blockCount);
+void BRPeerSendGetdataBlocks(BRPeer *peer, const UInt256 blockHashes[], size_t blockCount); // full witness blocks
+void BRPeerSendGetcfheaders(BRPeer *peer, uint32_t startHeight, UInt256 stopHash);
+void BRPeerSendGetcfilters(BRPeer *peer, uint32_t startHeight, UInt256 stopHash);
 void BRPeerSendGetaddr(BRPeer *peer);
 void BRPeerSendPing(BRPeer *peer, void *info, void (*pongCallback)(void *info, int success));
 
@@ -24,11 +24,14 @@
 
 #include "BRPeerManager.h"
 #include "BRBloomFilter.h"
+#include "BRCompactFilter.h"
 #include "support/BRSet.h"
 #include "support/BRArray.h"
 #include "support/BRInt.h"
+#include "support/BRProfile.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <inttypes.h>
 #include <limits.h>
 #include <time.h>
@@ -38,11 +41,18 @@
 #include <netdb.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <arpa/inet.h>
 
 #define PROTOCOL_TIMEOUT      20.0
 #define MAX_CONNECT_FAILURES  20 // notify user of network problems after this many connect failures in a row
 #define PEER_FLAG_SYNCED      0x01
 #define PEER_FLAG_NEEDSUPDATE 0x02
+#define PEER_FLAG_FILTERLOADED 0x04 // peer holds the current bloom filter, cleared when the filter is reset
+#define FILTERADD_MAX_ELEMS   200 // most new wallet addresses sent with "filteradd" before doing a full filter update
+#define CFILTER_WINDOW        100 // filters matched at a time, also the most blocks re-matched when addresses are added
+#define CFILTER_BLOCK_NONE      0 // compact filter didn't match the wallet
+#define CFILTER_BLOCK_REQUESTED 1 // compact filter matched the wallet, full block requested
+#define CFILTER_BLOCK_RECEIVED  2 // full block received and its wallet tx registered
 
 #define genesis_block_hash(params) UInt256Reverse((params)->checkpoints[0].hash)
 
@@ -166,6 +176,18 @@ inline static int _BRBlockHeightEq(const void *block, const void *otherBlock)
     return (((const BRMerkleBlock *)block)->height == ((const BRMerkleBlock *)otherBlock)->height);
 }
 
+// returns a hash value for a pubkey hash suitable for use in a hashtable
+inline static size_t _BRPKHHash(const void *pkh)
+{
+    return (size_t)UInt32GetLE(pkh);
+}
+
+// true if pkh and otherPkh are equal
+inline static int _BRPKHEq(const void *pkh, const void *otherPkh)
+{
+    return UInt160Eq(UInt160Get(pkh), UInt160Get(otherPkh));
+}
+
 struct BRPeerManagerStruct {
     const BRChainParams *params;
     BRWallet *wallet;
@@ -174,12 +196,22 @@ struct BRPeerManagerStruct {
     char downloadPeerName[INET6_ADDRSTRLEN + 6];
     uint32_t earliestKeyTime, syncStartHeight, filterUpdateHeight, estimatedHeight;
     BRBloomFilter *bloomFilter;
+    UInt160 *filterPKH; // wallet pubkey hashes loaded into the bloom filter, in the order they were added
+    BRSet *filterPKHSet;
+    size_t filterAddCount; // pubkey hashes sent with "filteradd" since the filter was last loaded
     double fpRate, averageTxPerBlock;
     BRSet *blocks, *orphans, *checkpoints;
     BRMerkleBlock *lastBlock, *lastOrphan;
     BRTxPeerList *txRelays, *txRequests;
     BRPublishedTx *publishedTx;
     UInt256 *publishedTxHashes;
+    BRPeerManagerSyncMode syncMode;
+    int cfSync; // true while the download peer is syncing with compact filters
+    BRMerkleBlock **cfBlocks; // headers from the last "headers" message waiting to be checked against compact filters
+    BRCompactFilter **cfFilters;
+    UInt256 *cfFilterHashes, cfHeader; // filter hashes for cfBlocks, and the filter header for the last of them
+    uint8_t *cfStatus;
+    size_t cfWindowStart, cfWindowEnd, cfAddrsCount;
     void *info;
     void (*syncStarted)(void *info);
     void (*syncStopped)(void *info, int error);
@@ -188,9 +220,25 @@ struct BRPeerManagerStruct {
     void (*savePeers)(void *info, int replace, const BRPeer peers[], size_t peersCount);
     int (*networkIsReachable)(void *info);
     void (*threadCleanup)(void *info);
+    BRMetrics metrics;
+    BRCapture capture;
+    BRCaptureReplay replay;
+    BRMetricsHistogram lockWait; // microseconds spent blocked on lock
+    BRMetricsCounter txRelayed, txRelayedNotInWallet;
     pthread_mutex_t lock;
 };
 
+// locks manager->lock, recording the time spent blocked if the lock is contended
+static inline void _BRPeerManagerLock(BRPeerManager *manager)
+{
+    if (pthread_mutex_trylock(&manager->lock) != 0) {
+        uint64_t start = BRMetricsNow();
+
+        pthread_mutex_lock(&manager->lock);
+        BRMetricsHistogramRecordSince(manager->lockWait, start);
+    }
+}
+
 static void _BRPeerManagerPeerMisbehavin(BRPeerManager *manager, BRPeer *peer)
 {
     for (size_t i = array_count(manager->peers); i > 0; i--) {
@@ -263,6 +311,22 @@ static void _setApplyFreeBlock(void *info, void *block)
     BRMerkleBlockFree(block);
 }
 
+// records pkhs as loaded into the bloom filter
+static void _BRPeerManagerAddFilterPKH(BRPeerManager *manager, const UInt160 pkhs[], size_t pkhsCount)
+{
+    UInt160 *origPKH = manager->filterPKH;
+    size_t i = array_count(manager->filterPKH);
+    
+    array_add_array(manager->filterPKH, pkhs, pkhsCount);
+    
+    if (manager->filterPKH != origPKH) { // was filterPKH moved to a new memory location?
+        BRSetClear(manager->filterPKHSet);
+        i = 0;
+    }
+    
+    while (i < array_count(manager->filterPKH)) BRSetAdd(manager->filterPKHSet, &manager->filterPKH[i++]);
+}
+
 static void _BRPeerManagerLoadBloomFilter(BRPeerManager *manager, BRPeer *peer)
 {
     // every time a new wallet address is added, the bloom filter has to be rebuilt, and each address is only used
@@ -276,35 +340,38 @@ static void _BRPeerManagerLoadBloomFilter(BRPeerManager *manager, BRPeer *peer)
     manager->lastOrphan = NULL;
     manager->filterUpdateHeight = manager->lastBlock->height;
     manager->fpRate = BLOOM_REDUCED_FALSEPOSITIVE_RATE;
+    manager->filterAddCount = 0;
+    peer->flags |= PEER_FLAG_FILTERLOADED;
     
-    size_t addrsCount = BRWalletAllAddrs(manager->wallet, NULL, 0);
-    BRAddress *addrs = malloc(addrsCount*sizeof(*addrs));
+    size_t pkhsCount = BRWalletAllPKH(manager->wallet, NULL, 0);
+    UInt160 *pkhs = malloc(pkhsCount*sizeof(*pkhs));
     size_t utxosCount = BRWalletUTXOs(manager->wallet, NULL, 0);
     BRUTXO *utxos = malloc(utxosCount*sizeof(*utxos));
-    UInt160 hash;
     uint32_t blockHeight = (manager->lastBlock->height > 100) ? manager->lastBlock->height - 100 : 0;
     uint8_t o[sizeof(UInt256) + sizeof(uint32_t)];
     size_t txCount = BRWalletTxUnconfirmedBefore(manager->wallet, NULL, 0, blockHeight);
     BRTransaction **transactions = malloc(txCount*sizeof(*transactions));
     BRBloomFilter *filter;
     
-    assert(addrs != NULL);
+    assert(pkhs != NULL);
     assert(utxos != NULL);
     assert(transactions != NULL);
-    addrsCount = BRWalletAllAddrs(manager->wallet, addrs, addrsCount);
+    pkhsCount = BRWalletAllPKH(manager->wallet, pkhs, pkhsCount);
     utxosCount = BRWalletUTXOs(manager->wallet, utxos, utxosCount);
     txCount = BRWalletTxUnconfirmedBefore(manager->wallet, transactions, txCount, blockHeight);
-    filter = BRBloomFilterNew(manager->fpRate, addrsCount + utxosCount + txCount + 100, (uint32_t)BRPeerHash(peer),
+    filter = BRBloomFilterNew(manager->fpRate, pkhsCount + utxosCount + txCount + 100, (uint32_t)BRPeerHash(peer),
                               BLOOM_UPDATE_ALL); // BUG: XXX txCount not the same as number of spent wallet outputs
     
-    for (size_t i = 0; i < addrsCount; i++) { // add addresses to watch for tx receiveing money to the wallet
-        if (BRAddressHash160(&hash, manager->params->addrParams, addrs[i].s) &&
-            ! BRBloomFilterContainsData(filter, hash.u8, sizeof(hash))) {
-            BRBloomFilterInsertData(filter, hash.u8, sizeof(hash));
+    for (size_t i = 0; i < pkhsCount; i++) { // add addresses to watch for tx receiveing money to the wallet
+        if (! BRBloomFilterContainsData(filter, pkhs[i].u8, sizeof(*pkhs))) {
+            BRBloomFilterInsertData(filter, pkhs[i].u8, sizeof(*pkhs));
         }
     }
 
-    free(addrs);
+    array_clear(manager->filterPKH);
+    BRSetClear(manager->filterPKHSet);
+    _BRPeerManagerAddFilterPKH(manager, pkhs, pkhsCount);
+    free(pkhs);
         
     for (size_t i = 0; i < utxosCount; i++) { // add UTXOs to watch for tx sending money from the wallet
         UInt256Set(o, utxos[i].hash);
@@ -335,6 +402,18 @@ static void _BRPeerManagerLoadBloomFilter(BRPeerManager *manager, BRPeer *peer)
     BRPeerSendFilterload(peer, data, len);
 }
 
+// frees the bloom filter so it's rebuilt on the next load, peers still hold the old filter which no longer matches
+// filterPKH, so stop sending them "filteradd" until a new filter is loaded (the manager never sends "filterclear")
+static void _BRPeerManagerResetBloomFilter(BRPeerManager *manager)
+{
+    if (manager->bloomFilter) BRBloomFilterFree(manager->bloomFilter);
+    manager->bloomFilter = NULL;
+    
+    for (size_t i = array_count(manager->connectedPeers); i > 0; i--) {
+        manager->connectedPeers[i - 1]->flags &= ~PEER_FLAG_FILTERLOADED;
+    }
+}
+
 static void _updateFilterRerequestDone(void *info, int success)
 {
     BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
@@ -343,7 +422,7 @@ static void _updateFilterRerequestDone(void *info, int success)
     free(info);
     
     if (success) {
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
 
         if ((peer->flags & PEER_FLAG_NEEDSUPDATE) == 0) {
             UInt256 locators[_BRPeerManagerBlockLocators(manager, NULL, 0)];
@@ -365,7 +444,7 @@ static void _updateFilterLoadDone(void *info, int success)
     free(info);
     
     if (success) {
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
         BRPeerSetNeedsFilterUpdate(peer, 0);
         peer->flags &= ~PEER_FLAG_NEEDSUPDATE;
         
@@ -392,10 +471,9 @@ static void _updateFilterPingDone(void *info, int success)
     BRPeerCallbackInfo *peerInfo;
     
     if (success) {
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
         peer_log(peer, "updating filter with newly created wallet addresses");
-        if (manager->bloomFilter) BRBloomFilterFree(manager->bloomFilter);
-        manager->bloomFilter = NULL;
+        _BRPeerManagerResetBloomFilter(manager);
 
         if (manager->lastBlock->height < manager->estimatedHeight) { // if we're syncing, only update download peer
             if (manager->downloadPeer) {
@@ -440,6 +518,50 @@ static void _BRPeerManagerUpdateFilter(BRPeerManager *manager)
     }
 }
 
+// tops up the spare wallet addresses after a wallet tx, and adds any new addresses to the bloom filters of connected
+// peers with "filteradd" messages, so that receiving a payment doesn't require reloading the filter and rerequesting
+// blocks, the filter is only rebuilt when too many addresses were added or its false positive rate has degraded
+static void _BRPeerManagerExtendFilter(BRPeerManager *manager)
+{
+    size_t i, j, pkhsCount, count = 0;
+    UInt160 *pkhs;
+    
+    BRWalletUnusedAddrs(manager->wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED, SEQUENCE_EXTERNAL_CHAIN);
+    BRWalletUnusedAddrs(manager->wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED, SEQUENCE_INTERNAL_CHAIN);
+    pkhsCount = BRWalletAllPKH(manager->wallet, NULL, 0);
+    if (pkhsCount <= array_count(manager->filterPKH)) return; // wallet chains only grow, so nothing new was added
+    pkhs = malloc(pkhsCount*sizeof(*pkhs));
+    assert(pkhs != NULL);
+    pkhsCount = BRWalletAllPKH(manager->wallet, pkhs, pkhsCount);
+    
+    for (i = 0; i < pkhsCount; i++) { // keep only the pubkey hashes not already in the filter
+        if (! BRSetContains(manager->filterPKHSet, &pkhs[i])) pkhs[count++] = pkhs[i];
+    }
+    
+    if (manager->filterAddCount + count > FILTERADD_MAX_ELEMS ||
+        manager->fpRate > BLOOM_REDUCED_FALSEPOSITIVE_RATE*10.0) {
+        _BRPeerManagerResetBloomFilter(manager); // reset bloom filter so it's recreated with new wallet addresses
+        _BRPeerManagerUpdateFilter(manager);
+    }
+    else if (count > 0) {
+        for (i = 0; i < count; i++) BRBloomFilterInsertData(manager->bloomFilter, pkhs[i].u8, sizeof(*pkhs));
+        
+        for (j = array_count(manager->connectedPeers); j > 0; j--) {
+            BRPeer *peer = manager->connectedPeers[j - 1];
+            
+            if (BRPeerConnectStatus(peer) != BRPeerStatusConnected || (peer->flags & PEER_FLAG_FILTERLOADED) == 0 ||
+                (peer->flags & PEER_FLAG_NEEDSUPDATE) != 0) continue;
+            peer_log(peer, "adding %zu new wallet address(es) to filter", count);
+            for (i = 0; i < count; i++) BRPeerSendFilteradd(peer, pkhs[i].u8, sizeof(*pkhs));
+        }
+        
+        _BRPeerManagerAddFilterPKH(manager, pkhs, count);
+        manager->filterAddCount += count;
+    }
+    
+    free(pkhs);
+}
+
 // unconfirmed transactions that aren't in the mempools of any of connected peers have likely dropped off the network
 static void _requestUnrelayedTxGetdataDone(void *info, int success)
 {
@@ -449,7 +571,7 @@ static void _requestUnrelayedTxGetdataDone(void *info, int success)
     size_t count = 0;
 
     free(info);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     if (success) peer->flags |= PEER_FLAG_SYNCED;
     
     for (size_t i = array_count(manager->connectedPeers); i > 0; i--) {
@@ -546,7 +668,7 @@ static void _mempoolDone(void *info, int success)
     
     if (success) {
         peer_log(peer, "mempool request finished");
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
         if (manager->syncStartHeight > 0) {
             peer_log(peer, "sync succeeded");
             syncFinished = 1;
@@ -567,7 +689,7 @@ static void _loadBloomFilterDone(void *info, int success)
     BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     
     if (success) {
         BRPeerSendMempool(peer, manager->publishedTxHashes, array_count(manager->publishedTxHashes), info,
@@ -587,8 +709,35 @@ static void _loadBloomFilterDone(void *info, int success)
     }
 }
 
+static void _BRPeerManagerCFClearBatch(BRPeerManager *manager)
+{
+    for (size_t i = array_count(manager->cfBlocks); i > 0; i--) {
+        if (manager->cfBlocks[i - 1]) BRMerkleBlockFree(manager->cfBlocks[i - 1]);
+        if (manager->cfFilters[i - 1]) BRCompactFilterFree(manager->cfFilters[i - 1]);
+    }
+    
+    array_clear(manager->cfBlocks);
+    array_clear(manager->cfFilters);
+    array_clear(manager->cfFilterHashes);
+    array_clear(manager->cfStatus);
+    manager->cfWindowStart = manager->cfWindowEnd = 0;
+}
+
+static void _BRPeerManagerCFReset(BRPeerManager *manager)
+{
+    _BRPeerManagerCFClearBatch(manager);
+    manager->cfHeader = UINT256_ZERO;
+    manager->cfSync = 0;
+}
+
 static void _BRPeerManagerLoadMempools(BRPeerManager *manager)
 {
+    int cfSync = manager->cfSync;
+    
+    // once compact filter sync is done, the download peer tracks the mempool with a bloom filter like the other peers
+    if (cfSync && manager->downloadPeer) BRPeerSetCompactFilterCallbacks(manager->downloadPeer, NULL, NULL, NULL, NULL);
+    _BRPeerManagerCFReset(manager);
+    
     // after syncing, load filters and get mempools from other peers
     for (size_t i = array_count(manager->connectedPeers); i > 0; i--) {
         BRPeer *peer = manager->connectedPeers[i - 1];
@@ -600,7 +749,7 @@ static void _BRPeerManagerLoadMempools(BRPeerManager *manager)
         info->peer = peer;
         info->manager = manager;
         
-        if (peer != manager->downloadPeer || manager->fpRate > BLOOM_REDUCED_FALSEPOSITIVE_RATE*5.0) {
+        if (peer != manager->downloadPeer || cfSync || manager->fpRate > BLOOM_REDUCED_FALSEPOSITIVE_RATE*5.0) {
             _BRPeerManagerLoadBloomFilter(manager, peer);
             _BRPeerManagerPublishPendingTx(manager, peer);
             BRPeerSendPing(peer, info, _loadBloomFilterDone); // load mempool after updating bloomfilter
@@ -649,7 +798,7 @@ static void *_findPeersThreadRoutine(void *arg)
     pthread_cleanup_push(manager->threadCleanup, manager->info);
     addrList = _addressLookup(((BRFindPeersInfo *)arg)->hostname);
     free(arg);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     
     for (addr = addrList; addr && ! UInt128IsZero(*addr); addr++) {
         age = 24*60*60 + BRRand(2*24*60*60); // add between 1 and 3 days
@@ -663,6 +812,33 @@ static void *_findPeersThreadRoutine(void *arg)
     return NULL;
 }
 
+// adds the peers, by "host:port", of the streams captured in replay
+static void _BRPeerManagerFindReplayPeers(BRPeerManager *manager, uint64_t services, time_t now)
+{
+    for (size_t i = 0; i < BRCaptureReplayGetStreamCount(manager->replay); i++) {
+        const char *name = BRCaptureReplayGetStreamName(manager->replay, i), *colon = strrchr(name, ':');
+        char host[INET6_ADDRSTRLEN];
+        BRPeer peer = { UINT128_ZERO, 0, services, now, 0 };
+        int found = 0;
+
+        if (! colon || (size_t)(colon - name) >= sizeof(host)) continue;
+        memcpy(host, name, (size_t)(colon - name));
+        host[colon - name] = '\0';
+        peer.port = (uint16_t)strtoul(colon + 1, NULL, 10);
+
+        if (inet_pton(AF_INET, host, &peer.address.u32[3]) == 1) {
+            peer.address.u16[5] = 0xffff; // IPv4 mapped
+        }
+        else if (inet_pton(AF_INET6, host, &peer.address) != 1) continue;
+
+        for (size_t j = array_count(manager->peers); ! found && j > 0; j--) {
+            if (BRPeerEq(&peer, &manager->peers[j - 1])) found = 1;
+        }
+
+        if (! found) array_add(manager->peers, peer);
+    }
+}
+
 // DNS peer discovery
 static void _BRPeerManagerFindPeers(BRPeerManager *manager)
 {
@@ -680,6 +856,9 @@ static void _BRPeerManagerFindPeers(BRPeerManager *manager)
         manager->peers[0].services = services;
         manager->peers[0].timestamp = now;
     }
+    else if (manager->replay) {
+        _BRPeerManagerFindReplayPeers(manager, services, now);
+    }
     else {
         for (size_t i = 1; manager->params->dnsSeeds[i]; i++) {
             info = calloc(1, sizeof(BRFindPeersInfo));
@@ -703,13 +882,20 @@ static void _BRPeerManagerFindPeers(BRPeerManager *manager)
         do {
             pthread_mutex_unlock(&manager->lock);
             nanosleep(&ts, NULL); // pthread_yield() isn't POSIX standard :(
-            pthread_mutex_lock(&manager->lock);
+            _BRPeerManagerLock(manager);
         } while (manager->dnsThreadCount > 0 && array_count(manager->peers) < PEER_MAX_CONNECTIONS);
     
         qsort(manager->peers, array_count(manager->peers), sizeof(*manager->peers), _peerTimestampCompare);
     }
 }
 
+static void _peerRelayedHeaders(void *info, BRMerkleBlock *blocks[], size_t blocksCount);
+static void _peerRelayedCFHeaders(void *info, UInt256 stopHash, UInt256 prevHeader, const UInt256 filterHashes[],
+                                  size_t hashesCount);
+static void _peerRelayedCFilter(void *info, BRCompactFilter *filter);
+static void _peerRelayedFullBlock(void *info, BRMerkleBlock *block, BRTransaction *txs[], const UInt256 txHashes[],
+                                  size_t txCount);
+
 static void _peerConnected(void *info)
 {
     BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
@@ -717,7 +903,7 @@ static void _peerConnected(void *info)
     BRPeerCallbackInfo *peerInfo;
     time_t now = time(NULL);
     
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     if (peer->timestamp > now + 2*60*60 || peer->timestamp < now - 2*60*60) peer->timestamp = now; // sanity check
     
     // TODO: XXX does this work with 0.11 pruned nodes?
@@ -770,7 +956,23 @@ static void _peerConnected(void *info)
         manager->downloadPeer = peer;
         manager->isConnected = 1;
         manager->estimatedHeight = BRPeerLastBlock(peer);
-        _BRPeerManagerLoadBloomFilter(manager, peer);
+        manager->cfSync = (manager->syncMode == BRPeerManagerSyncCompactFilter &&
+                           manager->lastBlock->height < BRPeerLastBlock(peer) &&
+                           (peer->services & SERVICES_NODE_COMPACT_FILTERS) == SERVICES_NODE_COMPACT_FILTERS);
+        
+        if (manager->cfSync) {
+            BRPeerSetCompactFilterCallbacks(peer, _peerRelayedHeaders, _peerRelayedCFHeaders, _peerRelayedCFilter,
+                                            _peerRelayedFullBlock);
+        }
+        else {
+            if (manager->syncMode == BRPeerManagerSyncCompactFilter &&
+                manager->lastBlock->height < BRPeerLastBlock(peer)) {
+                peer_log(peer, "node doesn't serve compact filters, syncing with bloom filter");
+            }
+            
+            _BRPeerManagerLoadBloomFilter(manager, peer);
+        }
+        
         BRPeerSetCurrentBlockHeight(peer, manager->lastBlock->height);
         _BRPeerManagerPublishPendingTx(manager, peer);
             
@@ -780,9 +982,10 @@ static void _peerConnected(void *info)
             
             BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // schedule sync timeout
 
-            // request just block headers up to a week before earliestKeyTime, and then merkleblocks after that
+            // request just block headers up to a week before earliestKeyTime, and then merkleblocks after that, or
+            // when syncing with compact filters, request only headers and check their filters for matching blocks
             // we do not reset connect failure count yet incase this request times out
-            if (manager->lastBlock->timestamp + 7*24*60*60 >= manager->earliestKeyTime) {
+            if (! manager->cfSync && manager->lastBlock->timestamp + 7*24*60*60 >= manager->earliestKeyTime) {
                 BRPeerSendGetblocks(peer, locators, count, UINT256_ZERO);
             }
             else BRPeerSendGetheaders(peer, locators, count, UINT256_ZERO);
@@ -805,7 +1008,7 @@ static void _peerDisconnected(void *info, int error)
     size_t txCount = 0;
     
     //free(info);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     BRPublishedTx pubTx[array_count(manager->publishedTx)];
     
@@ -836,6 +1039,7 @@ static void _peerDisconnected(void *info, int error)
     if (peer == manager->downloadPeer) { // download peer disconnected
         manager->isConnected = 0;
         manager->downloadPeer = NULL;
+        _BRPeerManagerCFReset(manager);
         if (manager->connectFailureCount > MAX_CONNECT_FAILURES) manager->connectFailureCount = MAX_CONNECT_FAILURES;
     }
 
@@ -885,7 +1089,7 @@ static void _peerRelayedPeers(void *info, const BRPeer peers[], size_t peersCoun
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
     time_t now = time(NULL);
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     peer_log(peer, "relayed %zu peer(s)", peersCount);
 
     array_add_array(manager->peers, peers, peersCount);
@@ -918,7 +1122,7 @@ static void _peerRelayedTx(void *info, BRTransaction *tx)
     int isWalletTx = 0, hasPendingCallbacks = 0;
     size_t relayCount = 0;
     
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     peer_log(peer, "relayed tx: %s", u256hex(tx->txHash));
     
     for (size_t i = array_count(manager->publishedTx); i > 0; i--) { // see if tx is in list of published tx
@@ -937,6 +1141,8 @@ static void _peerRelayedTx(void *info, BRTransaction *tx)
         BRPeerScheduleDisconnect(peer, -1); // cancel publish tx timeout
     }
 
+    // mempool and inv relayed tx arrive one "tx" message at a time, and each one's publish callback, relay count and
+    // sync timeout depend on it being registered right away, so unlike a full block, they aren't batched
     if (manager->syncStartHeight == 0 || BRWalletContainsTransaction(manager->wallet, tx)) {
         isWalletTx = BRWalletRegisterTransaction(manager->wallet, tx);
         if (isWalletTx) tx = BRWalletTransactionForHash(manager->wallet, tx->txHash);
@@ -945,6 +1151,9 @@ static void _peerRelayedTx(void *info, BRTransaction *tx)
         BRTransactionFree(tx);
         tx = NULL;
     }
+
+    BRMetricsCounterAdd(manager->txRelayed, 1);
+    if (! isWalletTx) BRMetricsCounterAdd(manager->txRelayedNotInWallet, 1); // not registered: bloom false positives, and txs the wallet rejects
     
     if (tx && isWalletTx) {
         // reschedule sync timeout
@@ -962,24 +1171,9 @@ static void _peerRelayedTx(void *info, BRTransaction *tx)
         
         _BRTxPeerListRemovePeer(manager->txRequests, tx->txHash, peer);
         
-        if (manager->bloomFilter != NULL) { // check if bloom filter is already being updated
-            BRAddress addrs[SEQUENCE_GAP_LIMIT_EXTERNAL + SEQUENCE_GAP_LIMIT_INTERNAL];
-            UInt160 hash;
-
-            // the transaction likely consumed one or more wallet addresses, so check that at least the next <gap limit>
-            // unused addresses are still matched by the bloom filter
-            BRWalletUnusedAddrs(manager->wallet, addrs, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
-            BRWalletUnusedAddrs(manager->wallet, addrs + SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
-
-            for (size_t i = 0; i < SEQUENCE_GAP_LIMIT_EXTERNAL + SEQUENCE_GAP_LIMIT_INTERNAL; i++) {
-                if (! BRAddressHash160(&hash, manager->params->addrParams, addrs[i].s) ||
-                    BRBloomFilterContainsData(manager->bloomFilter, hash.u8, sizeof(hash))) continue;
-                if (manager->bloomFilter) BRBloomFilterFree(manager->bloomFilter);
-                manager->bloomFilter = NULL; // reset bloom filter so it's recreated with new wallet addresses
-                _BRPeerManagerUpdateFilter(manager);
-                break;
-            }
-        }
+        // the transaction likely consumed one or more wallet addresses, so make sure the bloom filter still matches
+        // the spare unused addresses (unless the filter is already being updated)
+        if (manager->bloomFilter != NULL) _BRPeerManagerExtendFilter(manager);
     }
     
     // set timestamp when tx is verified
@@ -1000,7 +1194,7 @@ static void _peerHasTx(void *info, UInt256 txHash)
     int isWalletTx = 0, hasPendingCallbacks = 0;
     size_t relayCount = 0;
     
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     tx = BRWalletTransactionForHash(manager->wallet, txHash);
     peer_log(peer, "has tx: %s", u256hex(txHash));
 
@@ -1051,7 +1245,7 @@ static void _peerRejectedTx(void *info, UInt256 txHash, uint8_t code)
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
     BRTransaction *tx, *t;
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     peer_log(peer, "rejected tx: %s", u256hex(txHash));
     tx = BRWalletTransactionForHash(manager->wallet, txHash);
     _BRTxPeerListRemovePeer(manager->txRequests, txHash, peer);
@@ -1141,7 +1335,9 @@ static void _peerRelayedBlockFailed (BRMerkleBlock *blockToFree, BRPeer *peer, c
     assert (0);
 }
 
-static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
+// isCFChecked is true for a header that a compact filter showed has no wallet tx, which is added to the chain as a
+// header (totalTx of 0) regardless of earliestKeyTime
+static void _BRPeerManagerRelayedBlock(void *info, BRMerkleBlock *block, int isCFChecked)
 {
     if (NULL == info || NULL == block) {
         _peerRelayedBlockFailed (block, NULL, "missed 'info' or 'block'");
@@ -1181,7 +1377,7 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
     assert(txHashes != NULL);
     txCount = BRMerkleBlockTxHashes(block, txHashes, txCount);
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     prev = BRSetGet(manager->blocks, &block->prevBlock);
 
     if (prev) {
@@ -1190,7 +1386,8 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
     }
     
     // track the observed bloom filter false positive rate using a low pass filter to smooth out variance
-    if (peer == manager->downloadPeer && block->totalTx > 0) {
+    // (blocks checked against compact filters only include wallet tx, so there's nothing to track)
+    if (peer == manager->downloadPeer && block->totalTx > 0 && ! manager->cfSync) {
         for (i = 0; i < txCount; i++) { // wallet tx are not false-positives
             if (! BRWalletTransactionForHash(manager->wallet, txHashes[i])) fpCount++;
         }
@@ -1209,18 +1406,19 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
                      manager->fpRate, manager->lastBlock->height + 1 - manager->filterUpdateHeight);
             BRPeerDisconnect(peer);
         }
-        else if (manager->lastBlock->height + 500 < BRPeerLastBlock(peer) &&
+        else if ((manager->lastBlock->height + 500 < BRPeerLastBlock(peer) || manager->filterAddCount > 0) &&
                  manager->fpRate > BLOOM_REDUCED_FALSEPOSITIVE_RATE*10.0) {
             _BRPeerManagerUpdateFilter(manager); // rebuild bloom filter when it starts to degrade
         }
     }
 
     // ignore block headers that are newer than one week before earliestKeyTime (it's a header if it has 0 totalTx)
-    if (block->totalTx == 0 && block->timestamp + 7*24*60*60 - 2*60*60 > manager->earliestKeyTime) {
+    if (block->totalTx == 0 && ! isCFChecked && block->timestamp + 7*24*60*60 - 2*60*60 > manager->earliestKeyTime) {
         BRMerkleBlockFree(block);
         block = NULL;
     }
-    else if (manager->bloomFilter == NULL) { // ingore potentially incomplete blocks when a filter update is pending
+    else if (manager->bloomFilter == NULL && ! manager->cfSync) { // ingore potentially incomplete blocks when a filter
+                                                                   // update is pending
         BRMerkleBlockFree(block);
         block = NULL;
 
@@ -1412,7 +1610,325 @@ static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
         manager->txStatusUpdate(manager->info); // notify that transaction confirmations may have changed
     }
     
-    if (next) _peerRelayedBlock(info, next);
+    if (next) _BRPeerManagerRelayedBlock(info, next, 1); // an orphan was already checked when it was relayed
+}
+
+static void _peerRelayedBlock(void *info, BRMerkleBlock *block)
+{
+    _BRPeerManagerRelayedBlock(info, block, 0);
+}
+
+// requests the next window of compact filters for the current batch of headers
+static void _BRPeerManagerCFRequestWindow(BRPeerManager *manager, BRPeer *peer)
+{
+    size_t count = array_count(manager->cfBlocks);
+    
+    manager->cfWindowStart = manager->cfWindowEnd;
+    manager->cfWindowEnd = (manager->cfWindowStart + CFILTER_WINDOW < count) ? manager->cfWindowStart + CFILTER_WINDOW :
+                           count;
+    BRPeerSendGetcfilters(peer, manager->cfBlocks[manager->cfWindowStart]->height,
+                          manager->cfBlocks[manager->cfWindowEnd - 1]->blockHash);
+}
+
+static void _cfWindowMatchDone(void *info, int success);
+
+// matches the current window of compact filters against the wallet scripts, and requests full blocks for any matches
+static void _BRPeerManagerCFMatchWindow(BRPeerManager *manager, BRPeer *peer)
+{
+    size_t i, pkhsCount, elemCount = 0, count = 0;
+    UInt160 *pkhs;
+    uint8_t *scripts, *s;
+    const uint8_t **elems;
+    size_t *elemLens;
+    UInt256 blockHashes[CFILTER_WINDOW];
+    BRPeerCallbackInfo *peerInfo;
+    
+    // generate some spare addresses, same as for the bloom filter, so fewer windows need to be matched twice
+    BRWalletUnusedAddrs(manager->wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED, SEQUENCE_EXTERNAL_CHAIN);
+    BRWalletUnusedAddrs(manager->wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED, SEQUENCE_INTERNAL_CHAIN);
+    pkhsCount = BRWalletAllPKH(manager->wallet, NULL, 0);
+    pkhs = malloc(pkhsCount*sizeof(*pkhs));
+    scripts = malloc(pkhsCount*(25 + 22));
+    elems = malloc(pkhsCount*2*sizeof(*elems));
+    elemLens = malloc(pkhsCount*2*sizeof(*elemLens));
+    assert(pkhs != NULL);
+    assert(scripts != NULL);
+    assert(elems != NULL);
+    assert(elemLens != NULL);
+    pkhsCount = BRWalletAllPKH(manager->wallet, pkhs, pkhsCount);
+    
+    // basic filters contain the output scripts of each tx, and the scripts of the outputs it spends, so wallet receives
+    // and spends are both matched by the pay-to-pubkey-hash and pay-to-witness-pubkey-hash scripts of wallet addresses
+    for (i = 0, s = scripts; i < pkhsCount; i++) {
+        s[0] = OP_DUP, s[1] = OP_HASH160, s[2] = sizeof(*pkhs);
+        UInt160Set(&s[3], pkhs[i]);
+        s[23] = OP_EQUALVERIFY, s[24] = OP_CHECKSIG;
+        elems[elemCount] = s, elemLens[elemCount++] = 25, s += 25;
+        s[0] = OP_0, s[1] = sizeof(*pkhs);
+        UInt160Set(&s[2], pkhs[i]);
+        elems[elemCount] = s, elemLens[elemCount++] = 22, s += 22;
+    }
+    
+    for (i = manager->cfWindowStart; i < manager->cfWindowEnd; i++) {
+        if (manager->cfStatus[i] != CFILTER_BLOCK_NONE ||
+            ! BRCompactFilterMatchAny(manager->cfFilters[i], elems, elemLens, elemCount)) continue;
+        manager->cfStatus[i] = CFILTER_BLOCK_REQUESTED;
+        blockHashes[count++] = manager->cfBlocks[i]->blockHash;
+    }
+    
+    free(elemLens);
+    free(elems);
+    free(scripts);
+    free(pkhs);
+    manager->cfAddrsCount = pkhsCount;
+    
+    if (count > 0) {
+        peer_log(peer, "requesting %zu block(s) matched by compact filters", count);
+        BRPeerSendGetdataBlocks(peer, blockHashes, count);
+    }
+    
+    peerInfo = calloc(1, sizeof(*peerInfo));
+    assert(peerInfo != NULL);
+    peerInfo->peer = peer;
+    peerInfo->manager = manager;
+    BRPeerSendPing(peer, peerInfo, _cfWindowMatchDone); // the pong arrives after any requested blocks
+}
+
+static void _cfWindowMatchDone(void *info, int success)
+{
+    BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
+    BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
+    BRMerkleBlock *blocks[CFILTER_WINDOW];
+    size_t i, count = 0;
+    int hasNext = 0;
+    
+    _BRPeerManagerLock(manager);
+    
+    if (! success || ! manager->cfSync || peer != manager->downloadPeer || manager->cfWindowEnd == 0) {
+        pthread_mutex_unlock(&manager->lock);
+        free(info);
+        return;
+    }
+    
+    if (BRWalletAllPKH(manager->wallet, NULL, 0) > manager->cfAddrsCount) {
+        // new wallet tx used up some addresses, match the window again with the newly generated ones
+        _BRPeerManagerCFMatchWindow(manager, peer);
+        pthread_mutex_unlock(&manager->lock);
+        free(info);
+        return;
+    }
+    
+    for (i = manager->cfWindowStart; i < manager->cfWindowEnd; i++) {
+        if (manager->cfStatus[i] != CFILTER_BLOCK_REQUESTED) continue;
+        peer_log(peer, "block %s matched by compact filter was not relayed", u256hex(manager->cfBlocks[i]->blockHash));
+        _BRPeerManagerPeerMisbehavin(manager, peer);
+        pthread_mutex_unlock(&manager->lock);
+        free(info);
+        return;
+    }
+    
+    for (i = manager->cfWindowStart; i < manager->cfWindowEnd; i++) { // unmatched blocks stay headers
+        blocks[count++] = manager->cfBlocks[i];
+        manager->cfBlocks[i] = NULL;
+    }
+    
+    hasNext = (manager->cfWindowEnd < array_count(manager->cfBlocks));
+    if (hasNext) _BRPeerManagerCFRequestWindow(manager, peer); // request the next filters while adding these blocks
+    else _BRPeerManagerCFClearBatch(manager);
+    pthread_mutex_unlock(&manager->lock);
+    
+    for (i = 0; i < count; i++) _BRPeerManagerRelayedBlock(info, blocks[i], 1);
+    
+    if (! hasNext) {
+        _BRPeerManagerLock(manager);
+        
+        // the batch is done, continue with the next headers unless the chain download completed with these blocks
+        if (manager->cfSync && peer == manager->downloadPeer &&
+            manager->lastBlock->height < manager->estimatedHeight) {
+            UInt256 locators[_BRPeerManagerBlockLocators(manager, NULL, 0)];
+            size_t locatorsCount = _BRPeerManagerBlockLocators(manager, locators, sizeof(locators)/sizeof(*locators));
+            
+            BRPeerSendGetheaders(peer, locators, locatorsCount, UINT256_ZERO);
+        }
+        
+        pthread_mutex_unlock(&manager->lock);
+    }
+    
+    free(info);
+}
+
+static void _peerRelayedHeaders(void *info, BRMerkleBlock *blocks[], size_t blocksCount)
+{
+    BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
+    BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
+    BRMerkleBlock *prev;
+    size_t i, j;
+    
+    // headers older than a week before earliestKeyTime can't contain wallet tx, so they're added to the chain as-is
+    for (i = 0; i < blocksCount && blocks[i]->timestamp + 7*24*60*60 - 2*60*60 <= manager->earliestKeyTime; i++) {
+        _peerRelayedBlock(info, blocks[i]);
+    }
+    
+    _BRPeerManagerLock(manager);
+    
+    if (! manager->cfSync || peer != manager->downloadPeer || array_count(manager->cfBlocks) > 0) {
+        if (i < blocksCount) peer_log(peer, "ignoring %zu unexpected header(s)", blocksCount - i);
+        for (j = i; j < blocksCount; j++) BRMerkleBlockFree(blocks[j]);
+        pthread_mutex_unlock(&manager->lock);
+        return;
+    }
+    
+    BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // reschedule sync timeout
+    manager->connectFailureCount = 0; // reset failure count once we know our initial request didn't timeout
+    prev = (i < blocksCount) ? BRSetGet(manager->blocks, &blocks[i]->prevBlock) : NULL;
+    
+    for (j = i; j < blocksCount; j++) {
+        if (prev && UInt256Eq(blocks[j]->prevBlock, prev->blockHash)) {
+            blocks[j]->height = prev->height + 1;
+            array_add(manager->cfBlocks, blocks[j]);
+            prev = blocks[j];
+        }
+        else {
+            BRMerkleBlockFree(blocks[j]);
+            prev = NULL;
+        }
+    }
+    
+    if (array_count(manager->cfBlocks) < blocksCount - i) {
+        peer_log(peer, "relayed headers that don't connect to the chain");
+        _BRPeerManagerCFClearBatch(manager);
+        _BRPeerManagerPeerMisbehavin(manager, peer);
+    }
+    else if (array_count(manager->cfBlocks) > 0) {
+        array_set_count(manager->cfFilters, array_count(manager->cfBlocks));
+        array_set_count(manager->cfStatus, array_count(manager->cfBlocks));
+        BRPeerSendGetcfheaders(peer, manager->cfBlocks[0]->height,
+                               manager->cfBlocks[array_count(manager->cfBlocks) - 1]->blockHash);
+    }
+    else if (blocksCount >= 2000) { // still before earliestKeyTime, request the next headers
+        UInt256 locators[_BRPeerManagerBlockLocators(manager, NULL, 0)];
+        size_t locatorsCount = _BRPeerManagerBlockLocators(manager, locators, sizeof(locators)/sizeof(*locators));
+        
+        BRPeerSendGetheaders(peer, locators, locatorsCount, UINT256_ZERO);
+    }
+    
+    pthread_mutex_unlock(&manager->lock);
+}
+
+static void _peerRelayedCFHeaders(void *info, UInt256 stopHash, UInt256 prevHeader, const UInt256 filterHashes[],
+                                  size_t hashesCount)
+{
+    BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
+    BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
+    size_t count;
+    
+    _BRPeerManagerLock(manager);
+    count = array_count(manager->cfBlocks);
+    
+    if (! manager->cfSync || peer != manager->downloadPeer || count == 0 ||
+        array_count(manager->cfFilterHashes) > 0 || hashesCount != count ||
+        ! UInt256Eq(stopHash, manager->cfBlocks[count - 1]->blockHash)) {
+        peer_log(peer, "ignoring unexpected cfheaders, stop hash: %s", u256hex(stopHash));
+    }
+    else if (! UInt256IsZero(manager->cfHeader) && ! UInt256Eq(prevHeader, manager->cfHeader)) {
+        peer_log(peer, "relayed cfheaders that don't connect to filter header %s", u256hex(manager->cfHeader));
+        _BRPeerManagerPeerMisbehavin(manager, peer);
+    }
+    else {
+        // the filter hashes are committed to by the filter header chain, which is continued from the previous batch
+        array_add_array(manager->cfFilterHashes, filterHashes, hashesCount);
+        manager->cfHeader = prevHeader;
+        
+        for (size_t i = 0; i < hashesCount; i++) {
+            manager->cfHeader = BRCompactFilterHeader(filterHashes[i], manager->cfHeader);
+        }
+        
+        BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // reschedule sync timeout
+        _BRPeerManagerCFRequestWindow(manager, peer);
+    }
+    
+    pthread_mutex_unlock(&manager->lock);
+}
+
+static void _peerRelayedCFilter(void *info, BRCompactFilter *filter)
+{
+    BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
+    BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
+    size_t i, j;
+    
+    _BRPeerManagerLock(manager);
+    i = manager->cfWindowStart;
+    while (i < manager->cfWindowEnd && ! UInt256Eq(manager->cfBlocks[i]->blockHash, filter->blockHash)) i++;
+    
+    if (! manager->cfSync || peer != manager->downloadPeer || i >= manager->cfWindowEnd || manager->cfFilters[i]) {
+        peer_log(peer, "ignoring unexpected cfilter for block: %s", u256hex(filter->blockHash));
+        BRCompactFilterFree(filter);
+    }
+    else if (! UInt256Eq(BRCompactFilterHash(filter), manager->cfFilterHashes[i])) {
+        peer_log(peer, "relayed cfilter that doesn't match cfheaders for block: %s", u256hex(filter->blockHash));
+        BRCompactFilterFree(filter);
+        _BRPeerManagerPeerMisbehavin(manager, peer);
+    }
+    else {
+        manager->cfFilters[i] = filter;
+        BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // reschedule sync timeout
+        for (j = manager->cfWindowStart; j < manager->cfWindowEnd && manager->cfFilters[j]; j++);
+        if (j == manager->cfWindowEnd) _BRPeerManagerCFMatchWindow(manager, peer);
+    }
+    
+    pthread_mutex_unlock(&manager->lock);
+}
+
+static void _peerRelayedFullBlock(void *info, BRMerkleBlock *block, BRTransaction *txs[], const UInt256 txHashes[],
+                                  size_t txCount)
+{
+    BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
+    BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
+    uint8_t *matches = calloc(txCount, sizeof(*matches));
+    size_t i, j;
+    
+    assert(matches != NULL || txCount == 0);
+    _BRPeerManagerLock(manager);
+    i = manager->cfWindowStart;
+    while (i < manager->cfWindowEnd && ! UInt256Eq(manager->cfBlocks[i]->blockHash, block->blockHash)) i++;
+    
+    if (! manager->cfSync || peer != manager->downloadPeer || i >= manager->cfWindowEnd ||
+        manager->cfStatus[i] != CFILTER_BLOCK_REQUESTED) {
+        peer_log(peer, "ignoring unexpected block: %s", u256hex(block->blockHash));
+    }
+    else if (! BRMerkleBlockSetTxMatches(manager->cfBlocks[i], txHashes, matches, txCount)) {
+        peer_log(peer, "relayed block with invalid merkle root: %s", u256hex(block->blockHash));
+        _BRPeerManagerPeerMisbehavin(manager, peer);
+    }
+    else {
+        for (j = 0; j < txCount; j++) {
+            if (txs[j] && BRWalletTransactionForHash(manager->wallet, txHashes[j])) { // already registered, e.g. our own tx
+                matches[j] = 1;
+                BRTransactionFree(txs[j]);
+                txs[j] = NULL;
+            }
+        }
+
+        // a wallet tx can pay to an address that was only generated when an earlier wallet tx was registered, and tx
+        // in a block aren't necessarily in dependency order; the batch registration handles both
+        BRWalletRegisterTransactions(manager->wallet, txs, txCount);
+
+        for (j = 0; j < txCount; j++) {
+            if (txs[j] && BRWalletTransactionForHash(manager->wallet, txHashes[j]) == txs[j]) {
+                matches[j] = 1;
+                txs[j] = NULL;
+            }
+        }
+        
+        BRMerkleBlockSetTxMatches(manager->cfBlocks[i], txHashes, matches, txCount);
+        manager->cfStatus[i] = CFILTER_BLOCK_RECEIVED;
+        BRPeerScheduleDisconnect(peer, PROTOCOL_TIMEOUT); // reschedule sync timeout
+    }
+    
+    pthread_mutex_unlock(&manager->lock);
+    for (j = 0; j < txCount; j++) if (txs[j]) BRTransactionFree(txs[j]);
+    BRMerkleBlockFree(block);
+    if (matches) free(matches);
 }
 
 static void _peerDataNotfound(void *info, const UInt256 txHashes[], size_t txCount,
@@ -1421,7 +1937,7 @@ static void _peerDataNotfound(void *info, const UInt256 txHashes[], size_t txCou
     BRPeer *peer = ((BRPeerCallbackInfo *)info)->peer;
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     for (size_t i = 0; i < txCount; i++) {
         _BRTxPeerListRemovePeer(manager->txRelays, txHashes[i], peer);
@@ -1437,7 +1953,7 @@ static void _peerSetFeePerKb(void *info, uint64_t feePerKb)
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
     uint64_t maxFeePerKb = 0, secondFeePerKb = 0;
     
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     
     for (size_t i = array_count(manager->connectedPeers); i > 0; i--) { // find second highest fee rate
         p = manager->connectedPeers[i - 1];
@@ -1461,7 +1977,7 @@ static BRTransaction *_peerRequestedTx(void *info, UInt256 txHash)
     BRPublishedTx pubTx = { NULL, NULL, NULL };
     int hasPendingCallbacks = 0, error = 0;
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     for (size_t i = array_count(manager->publishedTx); i > 0; i--) {
         if (UInt256Eq(manager->publishedTxHashes[i - 1], txHash)) {
@@ -1497,7 +2013,7 @@ static void _peerThreadCleanup(void *info)
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
 
     free(info);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     manager->peerThreadCount--;
     pthread_mutex_unlock(&manager->lock);
     if (manager->threadCleanup) manager->threadCleanup(manager->info);
@@ -1548,7 +2064,8 @@ BRPeerManager *BRPeerManagerNew(const BRChainParams *params, BRWallet *wallet, u
               (manager->lastBlock ? manager->lastBlock->height : (uint32_t) -1));
 
     block = NULL;
-    
+
+    BRProfileSpan span = BR_PROFILE_BEGIN("BRPeerManagerChainBlocks");
     for (size_t i = 0; blocks && i < blocksCount; i++) {
         assert(blocks[i]->height != BLOCK_UNKNOWN_HEIGHT); // height must be saved/restored along with serialized block
         BRSetAdd(manager->orphans, blocks[i]);
@@ -1565,6 +2082,7 @@ BRPeerManager *BRPeerManagerNew(const BRChainParams *params, BRWallet *wallet, u
         orphan.prevBlock = block->blockHash;
         block = BRSetGet(manager->orphans, &orphan);
     }
+    BR_PROFILE_END(span);
 
     _peer_log("BPM: initialized with %u last block height", manager->lastBlock->height);
 
@@ -1572,6 +2090,12 @@ BRPeerManager *BRPeerManagerNew(const BRChainParams *params, BRWallet *wallet, u
     array_new(manager->txRequests, 10);
     array_new(manager->publishedTx, 10);
     array_new(manager->publishedTxHashes, 10);
+    array_new(manager->cfBlocks, 2000);
+    array_new(manager->cfFilters, 2000);
+    array_new(manager->cfFilterHashes, 2000);
+    array_new(manager->cfStatus, 2000);
+    array_new(manager->filterPKH, 1000);
+    manager->filterPKHSet = BRSetNew(_BRPKHHash, _BRPKHEq, 1000);
     pthread_mutex_init(&manager->lock, NULL);
     manager->threadCleanup = _dummyThreadCleanup;
     return manager;
@@ -1608,20 +2132,29 @@ void BRPeerManagerSetCallbacks(BRPeerManager *manager, void *info,
     manager->threadCleanup = (threadCleanup) ? threadCleanup : _dummyThreadCleanup;
 }
 
+// not thread-safe, set the sync mode before calling BRPeerManagerConnect()
+// in compact filter mode, a download peer that doesn't advertise SERVICES_NODE_COMPACT_FILTERS falls back to bloom
+// filter sync, and once the chain is synced, the mempool is tracked with bloom filters the same as in bloom filter mode
+void BRPeerManagerSetSyncMode(BRPeerManager *manager, BRPeerManagerSyncMode syncMode)
+{
+    assert(manager != NULL);
+    manager->syncMode = syncMode;
+}
+
 // specifies a single fixed peer to use when connecting to the bitcoin network
 // set address to UINT128_ZERO to revert to default behavior
 void BRPeerManagerSetFixedPeer(BRPeerManager *manager, UInt128 address, uint16_t port)
 {
     assert(manager != NULL);
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     int samePeer = (UInt128Eq(address, manager->fixedPeer.address) &&
                     (port == manager->fixedPeer.port || UInt128IsZero(address)));
     pthread_mutex_unlock(&manager->lock);
 
     if (!samePeer) {
         BRPeerManagerDisconnect(manager);
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
         manager->maxConnectCount = UInt128IsZero(address) ? PEER_MAX_CONNECTIONS : 1;
         manager->fixedPeer = ((const BRPeer) { address, port, 0, 0, 0 });
         array_clear(manager->peers);
@@ -1629,13 +2162,48 @@ void BRPeerManagerSetFixedPeer(BRPeerManager *manager, UInt128 address, uint16_t
     }
 }
 
+// records the peer manager's lock contention, relayed and false positive transactions, and (for peers connected
+// from now on) the messages sent and received, in metrics; NULL to stop recording
+void BRPeerManagerSetMetrics(BRPeerManager *manager, BRMetrics metrics)
+{
+    assert(manager != NULL);
+
+    _BRPeerManagerLock(manager);
+    manager->metrics = metrics;
+    manager->lockWait = BRMetricsGetHistogram(metrics, "peerManager.lockWait");
+    manager->txRelayed = BRMetricsGetCounter(metrics, "peerManager.txRelayed");
+    manager->txRelayedNotInWallet = BRMetricsGetCounter(metrics, "peerManager.txRelayedNotInWallet");
+    pthread_mutex_unlock(&manager->lock);
+}
+
+// records the messages of peers connected from now on in capture; NULL to stop recording
+void BRPeerManagerSetCapture(BRPeerManager *manager, BRCapture capture)
+{
+    assert(manager != NULL);
+
+    _BRPeerManagerLock(manager);
+    manager->capture = capture;
+    pthread_mutex_unlock(&manager->lock);
+}
+
+// connects, from now on, to the peers captured in replay rather than to the network
+void BRPeerManagerSetReplay(BRPeerManager *manager, BRCaptureReplay replay)
+{
+    assert(manager != NULL);
+
+    _BRPeerManagerLock(manager);
+    manager->replay = replay;
+    array_clear(manager->peers); // found again, from replay
+    pthread_mutex_unlock(&manager->lock);
+}
+
 // current connect status
 BRPeerStatus BRPeerManagerConnectStatus(BRPeerManager *manager)
 {
     BRPeerStatus status = BRPeerStatusDisconnected;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     if (manager->isConnected != 0) status = BRPeerStatusConnected;
 
     for (size_t i = array_count(manager->connectedPeers); i > 0 && status == BRPeerStatusDisconnected; i--) {
@@ -1651,7 +2219,7 @@ BRPeerStatus BRPeerManagerConnectStatus(BRPeerManager *manager)
 void BRPeerManagerConnect(BRPeerManager *manager)
 {
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     if (manager->connectFailureCount >= MAX_CONNECT_FAILURES) manager->connectFailureCount = 0; //this is a manual retry
     
     if ((! manager->downloadPeer || manager->lastBlock->height < manager->estimatedHeight) &&
@@ -1659,7 +2227,7 @@ void BRPeerManagerConnect(BRPeerManager *manager)
         manager->syncStartHeight = manager->lastBlock->height + 1;
         pthread_mutex_unlock(&manager->lock);
         if (manager->syncStarted) manager->syncStarted(manager->info);
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
     }
     
     for (size_t i = array_count(manager->connectedPeers); i > 0; i--) {
@@ -1699,6 +2267,7 @@ void BRPeerManagerConnect(BRPeerManager *manager)
                 info->manager = manager;
                 info->peer = BRPeerNew(manager->params->magicNumber);
                 *info->peer = peers[i];
+                info->peer->flags = 0; // a new connection starts with no filter loaded
                 array_rm(peers, i);
                 array_add(manager->connectedPeers, info->peer);
                 manager->peerThreadCount++;
@@ -1706,12 +2275,15 @@ void BRPeerManagerConnect(BRPeerManager *manager)
                                    _peerRelayedTx, _peerHasTx, _peerRejectedTx, _peerRelayedBlock, _peerDataNotfound,
                                    _peerSetFeePerKb, _peerRequestedTx, _peerNetworkIsReachable, _peerThreadCleanup);
                 BRPeerSetEarliestKeyTime(info->peer, manager->earliestKeyTime);
+                BRPeerSetMetrics(info->peer, manager->metrics);
+                BRPeerSetCapture(info->peer, manager->capture);
+                BRPeerSetReplay(info->peer, manager->replay);
                 BRPeerConnect(info->peer);
 
                 if (BRPeerConnectStatus(info->peer) == BRPeerStatusDisconnected) {
                     pthread_mutex_unlock(&manager->lock);
                     _peerDisconnected(info, ENOTCONN);
-                    pthread_mutex_lock(&manager->lock);
+                    _BRPeerManagerLock(manager);
                     manager->peerThreadCount--;
                 }
             }
@@ -1735,7 +2307,7 @@ void BRPeerManagerDisconnect(BRPeerManager *manager)
     BRPeer *p;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     // prevent new peers from being spawned
     maxConnectCount = manager->maxConnectCount;
@@ -1756,13 +2328,13 @@ void BRPeerManagerDisconnect(BRPeerManager *manager)
     
     while (peerThreadCount > 0 || dnsThreadCount > 0) {
         nanosleep(&ts, NULL); // pthread_yield() isn't POSIX standard :(
-        pthread_mutex_lock(&manager->lock);
+        _BRPeerManagerLock(manager);
         peerThreadCount = manager->peerThreadCount;
         dnsThreadCount = manager->dnsThreadCount;
         pthread_mutex_unlock(&manager->lock);
     }
 
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     manager->maxConnectCount = maxConnectCount;
     pthread_mutex_unlock(&manager->lock);
 }
@@ -1790,7 +2362,7 @@ static int _BRPeerManagerRescan(BRPeerManager *manager, BRMerkleBlock *newLastBl
 void BRPeerManagerRescan(BRPeerManager *manager)
 {
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     
     int needConnect = 0;
     if (manager->isConnected) {
@@ -1816,7 +2388,7 @@ void BRPeerManagerRescan(BRPeerManager *manager)
 void BRPeerManagerRescanFromLastHardcodedCheckpoint(BRPeerManager *manager)
 {
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     int needConnect = 0;
     if (manager->isConnected) {
@@ -1855,7 +2427,7 @@ static BRMerkleBlock *_BRPeerManagerLookupBlockFromBlockNumber(BRPeerManager *ma
 void BRPeerManagerRescanFromBlockNumber(BRPeerManager *manager, uint32_t blockNumber)
 {
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     int needConnect = 0;
     if (manager->isConnected) {
@@ -1884,7 +2456,7 @@ uint32_t BRPeerManagerEstimatedBlockHeight(BRPeerManager *manager)
     uint32_t height;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     height = (manager->lastBlock->height < manager->estimatedHeight) ? manager->estimatedHeight :
              manager->lastBlock->height;
     pthread_mutex_unlock(&manager->lock);
@@ -1897,7 +2469,7 @@ uint32_t BRPeerManagerLastBlockHeight(BRPeerManager *manager)
     uint32_t height;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     height = manager->lastBlock->height;
     pthread_mutex_unlock(&manager->lock);
     return height;
@@ -1909,7 +2481,7 @@ uint32_t BRPeerManagerLastBlockTimestamp(BRPeerManager *manager)
     uint32_t timestamp;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     timestamp = manager->lastBlock->timestamp;
     pthread_mutex_unlock(&manager->lock);
     return timestamp;
@@ -1922,7 +2494,7 @@ double BRPeerManagerSyncProgress(BRPeerManager *manager, uint32_t startHeight)
     double progress;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     if (startHeight == 0) startHeight = manager->syncStartHeight;
     
     if (! manager->downloadPeer && manager->syncStartHeight == 0) {
@@ -1946,7 +2518,7 @@ size_t BRPeerManagerPeerCount(BRPeerManager *manager)
     size_t count = 0;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     
     for (size_t i = array_count(manager->connectedPeers); i > 0; i--) {
         if (BRPeerConnectStatus(manager->connectedPeers[i - 1]) != BRPeerStatusDisconnected) count++;
@@ -1960,7 +2532,7 @@ size_t BRPeerManagerPeerCount(BRPeerManager *manager)
 const char *BRPeerManagerDownloadPeerName(BRPeerManager *manager)
 {
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
 
     if (manager->downloadPeer) {
         sprintf(manager->downloadPeerName, "%s:%d", BRPeerHost(manager->downloadPeer), manager->downloadPeer->port);
@@ -1977,7 +2549,7 @@ static void _publishTxInvDone(void *info, int success)
     BRPeerManager *manager = ((BRPeerCallbackInfo *)info)->manager;
     
     free(info);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     _BRPeerManagerRequestUnrelayedTx(manager, peer);
     pthread_mutex_unlock(&manager->lock);
 }
@@ -1988,7 +2560,7 @@ void BRPeerManagerPublishTx(BRPeerManager *manager, BRTransaction *tx, void *inf
 {
     assert(manager != NULL);
     assert(tx != NULL && BRTransactionIsSigned(tx));
-    if (tx) pthread_mutex_lock(&manager->lock);
+    if (tx) _BRPeerManagerLock(manager);
     
     if (tx && ! BRTransactionIsSigned(tx)) {
         pthread_mutex_unlock(&manager->lock);
@@ -2005,7 +2577,7 @@ void BRPeerManagerPublishTx(BRPeerManager *manager, BRTransaction *tx, void *inf
             if (callback) callback(info, ENOTCONN); // not connected to bitcoin network
             tx = NULL;
         }
-        else pthread_mutex_lock(&manager->lock);
+        else _BRPeerManagerLock(manager);
     }
     
     if (tx) {
@@ -2047,7 +2619,7 @@ size_t BRPeerManagerRelayCount(BRPeerManager *manager, UInt256 txHash)
 
     assert(manager != NULL);
     assert(! UInt256IsZero(txHash));
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     
     for (size_t i = array_count(manager->txRelays); i > 0; i--) {
         if (! UInt256Eq(manager->txRelays[i - 1].txHash, txHash)) continue;
@@ -2069,7 +2641,7 @@ void BRPeerManagerFree(BRPeerManager *manager)
     BRTransaction *tx;
     
     assert(manager != NULL);
-    pthread_mutex_lock(&manager->lock);
+    _BRPeerManagerLock(manager);
     array_free(manager->peers);
     for (size_t i = array_count(manager->connectedPeers); i > 0; i--) BRPeerFree(manager->connectedPeers[i - 1]);
     array_free(manager->connectedPeers);
@@ -2089,6 +2661,13 @@ void BRPeerManagerFree(BRPeerManager *manager)
     }
 
     if (manager->bloomFilter) BRBloomFilterFree(manager->bloomFilter);
+    _BRPeerManagerCFClearBatch(manager);
+    array_free(manager->cfBlocks);
+    array_free(manager->cfFilters);
+    array_free(manager->cfFilterHashes);
+    array_free(manager->filterPKH);
+    BRSetFree(manager->filterPKHSet);
+    array_free(manager->cfStatus);
 
     array_free(manager->publishedTx);
     array_free(manager->publishedTxHashes);
@@ -41,6 +41,11 @@ extern "C" {
 
 typedef struct BRPeerManagerStruct BRPeerManager;
 
+typedef enum {
+    BRPeerManagerSyncBloomFilter = 0, // BIP37 filtered merkleblocks
+    BRPeerManagerSyncCompactFilter    // BIP157/158 compact block filters matched locally, then only matching blocks
+} BRPeerManagerSyncMode;
+
 // returns a newly allocated BRPeerManager struct that must be freed by calling BRPeerManagerFree()
 BRPeerManager *BRPeerManagerNew(const BRChainParams *params, BRWallet *wallet, uint32_t earliestKeyTime,
                                 BRMerkleBlock *blocks[], size_t blocksCount, const BRPeer peers[], size_t peersCount);
@@ -65,10 +70,27 @@ void BRPeerManagerSetCallbacks(BRPeerManager *manager, void *info,
                                int (*networkIsReachable)(void *info),
                                void (*threadCleanup)(void *info));
 
+// not thread-safe, set the sync mode before calling BRPeerManagerConnect()
+// in compact filter mode, a download peer that doesn't advertise SERVICES_NODE_COMPACT_FILTERS falls back to bloom
+// filter sync, and once the chain is synced, the mempool is tracked with bloom filters the same as in bloom filter mode
+void BRPeerManagerSetSyncMode(BRPeerManager *manager, BRPeerManagerSyncMode syncMode);
+
 // specifies a single fixed peer to use when connecting to the bitcoin network
 // set address to UINT128_ZERO to revert to default behavior
 void BRPeerManagerSetFixedPeer(BRPeerManager *manager, UInt128 address, uint16_t port);
 
+// records the peer manager's lock contention, relayed and false positive transactions, and (for peers connected
+// from now on) the messages sent and received, in metrics; NULL to stop recording
+void BRPeerManagerSetMetrics(BRPeerManager *manager, BRMetrics metrics);
+
+// records the messages sent to and received from peers connected from now on in capture, one stream per connection;
+// NULL to stop recording, capture must outlive the manager
+void BRPeerManagerSetCapture(BRPeerManager *manager, BRCapture capture);
+
+// connects, from now on, to the peers captured in replay rather than to the network, and replays their messages at full
+// speed; peers are found from replay rather than DNS, replay must outlive the manager
+void BRPeerManagerSetReplay(BRPeerManager *manager, BRCaptureReplay replay);
+
 // current connect status
 BRPeerStatus BRPeerManagerConnectStatus(BRPeerManager *manager);
 
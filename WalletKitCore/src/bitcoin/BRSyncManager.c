@@ -83,18 +83,32 @@ struct BRSyncManagerStruct {
 
 /// MARK: - Sync Manager Decls & Defs
 
+typedef struct {
+    int rid;
+    BRTransaction *transaction;
+    uint64_t blockHeight;
+    uint64_t timestamp;
+} BRClientSyncManagerAnnouncedTransaction;
+
 struct BRClientSyncManagerScanStateRecord {
-    int requestId;
+    BRArrayOf(int) requestIds;
+    BRArrayOf(BRClientSyncManagerAnnouncedTransaction) transactions;
     BRAddress lastExternalAddress;
     BRAddress lastInternalAddress;
     BRSetOf(BRAddress *) knownAddresses;
     uint64_t begBlockNumber;
     uint64_t endBlockNumber;
+    uint32_t lookahead;
     uint8_t isFullScan;
 };
 
 typedef struct BRClientSyncManagerScanStateRecord *BRClientSyncManagerScanState;
 
+typedef struct {
+    int rid;
+    BRArrayOf(char *) addresses;
+} BRClientSyncManagerTransactionsRequest;
+
 struct BRClientSyncManagerStruct {
     // !!! must be first !!!
     struct BRSyncManagerStruct common;
@@ -169,6 +183,11 @@ struct BRClientSyncManagerStruct {
      */
     int requestIdGenerator;
 
+    /**
+     * The number of incremental scans since one queried all of the wallet's addresses
+     */
+    uint32_t incrementalScanCount;
+
     /**
      * If we are syncing with BRD, instead of as P2P with PeerManager, then we'll keep a record to
      * ensure we've successfully completed the getTransactions() callbacks to the client.
@@ -184,6 +203,24 @@ typedef struct BRClientSyncManagerStruct * BRClientSyncManager;
 #define BWM_BRD_SYNC_DAYS_OFFSET                 1
 #define BWM_BRD_SYNC_START_BLOCK_OFFSET        ((BWM_BRD_SYNC_DAYS_OFFSET * 24 * 60) / BWM_MINUTES_PER_BLOCK)
 
+// When discovering addresses, derive and query this many gap-limit windows past the first unused
+// address, speculatively.  Every response that finds the first unused address moved doubles the
+// windows, up to the maximum, so that a wallet with many used addresses is restored in a handful
+// of round trips.
+#define BWM_BRD_SYNC_LOOKAHEAD_MIN                2
+#define BWM_BRD_SYNC_LOOKAHEAD_MAX              128
+
+// The most addresses in one `funcGetTransactions` request; larger sets are split into requests
+// that are issued together.
+#define BWM_BRD_SYNC_REQUEST_ADDRESS_LIMIT     1000
+
+// An incremental scan queries the unused addresses and the addresses of recent transactions -
+// those pending, in the scan's block range or among the newest few - but not more than the limit.
+// Every so many incremental scans, all addresses are queried, to find payments to old addresses.
+#define BWM_BRD_SYNC_RECENT_TRANSACTION_COUNT    10
+#define BWM_BRD_SYNC_RECENT_ADDRESS_LIMIT       100
+#define BWM_BRD_SYNC_ALL_ADDRESSES_PERIOD        10
+
 #define BRClientSyncManagerAsSyncManager(x)     ((BRSyncManager) (x))
 
 static BRClientSyncManager
@@ -260,6 +297,10 @@ BRClientSyncManagerAnnounceSubmitTransaction (BRClientSyncManager manager,
                                               OwnershipKept BRTransaction *transaction,
                                               int error);
 
+static void
+BRClientSyncManagerRegisterTransactions (BRClientSyncManager manager,
+                                         OwnershipGiven BRArrayOf(BRClientSyncManagerAnnouncedTransaction) transactions);
+
 static void
 BRClientSyncManagerUpdateBlockNumber (BRClientSyncManager manager);
 
@@ -269,13 +310,22 @@ BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager);
 static int
 BRClientSyncManagerGenerateRid (BRClientSyncManager manager);
 
+static BRArrayOf(BRClientSyncManagerTransactionsRequest)
+BRClientSyncManagerCreateTransactionsRequests (BRClientSyncManager manager,
+                                               OwnershipGiven BRArrayOf(BRAddress *) addresses);
+
+static void
+BRClientSyncManagerSendTransactionsRequests (BRClientSyncManager manager,
+                                             OwnershipGiven BRArrayOf(BRClientSyncManagerTransactionsRequest) requests,
+                                             uint64_t begBlockNumber,
+                                             uint64_t endBlockNumber);
+
 static void
 BRClientSyncManagerScanStateInit (BRClientSyncManagerScanState scanState,
                                   BRWallet *wallet,
                                   int isBTC,
                                   uint64_t syncedBlockHeight,
-                                  uint64_t networkBlockHeight,
-                                  int rid);
+                                  uint64_t networkBlockHeight);
 
 static void
 BRClientSyncManagerScanStateWipe (BRClientSyncManagerScanState scanState);
@@ -286,8 +336,28 @@ BRClientSyncManagerScanStateIsInProgress(BRClientSyncManagerScanState scanState)
 static uint8_t
 BRClientSyncManagerScanStateIsFullScan (BRClientSyncManagerScanState scanState);
 
+static void
+BRClientSyncManagerScanStateAddRequestId(BRClientSyncManagerScanState scanState,
+                                         int rid);
+
 static int
-BRClientSyncManagerScanStateGetRequestId(BRClientSyncManagerScanState scanState);
+BRClientSyncManagerScanStateRemoveRequestId(BRClientSyncManagerScanState scanState,
+                                            int rid);
+
+static int
+BRClientSyncManagerScanStateHasRequestId(BRClientSyncManagerScanState scanState,
+                                         int rid);
+
+static size_t
+BRClientSyncManagerScanStateGetRequestCount(BRClientSyncManagerScanState scanState);
+
+static void
+BRClientSyncManagerScanStateAddTransaction(BRClientSyncManagerScanState scanState,
+                                           BRClientSyncManagerAnnouncedTransaction transaction);
+
+static BRArrayOf(BRClientSyncManagerAnnouncedTransaction)
+BRClientSyncManagerScanStateRemoveTransactions(BRClientSyncManagerScanState scanState,
+                                               int rid);
 
 static uint64_t
 BRClientSyncManagerScanStateGetStartBlockNumber(BRClientSyncManagerScanState scanState);
@@ -299,7 +369,10 @@ static uint64_t
 BRClientSyncManagerScanStateGetSyncedBlockNumber(BRClientSyncManagerScanState scanState);
 
 static BRArrayOf(BRAddress *)
-BRClientSyncManagerScanStateGetAddresses(BRClientSyncManagerScanState scanState);
+BRClientSyncManagerScanStateGetAddresses(BRClientSyncManagerScanState scanState,
+                                         BRWallet *wallet,
+                                         int isBTC,
+                                         uint8_t isAllAddresses);
 
 static BRArrayOf(BRAddress *)
 BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (BRClientSyncManagerScanState scanState,
@@ -419,6 +492,10 @@ BRPeerSyncManagerSetFixedPeer (BRPeerSyncManager manager,
                                UInt128 address,
                                uint16_t port);
 
+static void
+BRPeerSyncManagerSetMetrics (BRPeerSyncManager manager,
+                             BRMetrics metrics);
+
 static void
 BRPeerSyncManagerConnect(BRPeerSyncManager manager);
 
@@ -467,6 +544,22 @@ _updateWalletAddressSet(BRSetOf(BRAddress *) addresses,
                         BRWallet *wallet,
                         int isBTC);
 
+static void
+_generateWalletAddresses (BRWallet *wallet,
+                          uint32_t windows);
+
+static void
+_addWalletAddress (BRSetOf(BRAddress *) addresses,
+                   BRWallet *wallet,
+                   const BRAddress *address,
+                   int isBTC);
+
+static size_t
+_addRecentWalletAddresses (BRSetOf(BRAddress *) addresses,
+                           BRWallet *wallet,
+                           int isBTC,
+                           uint64_t begBlockNumber);
+
 static uint32_t
 _calculateSyncDepthHeight(BRCryptoSyncDepth depth,
                           const BRChainParams *chainParams,
@@ -626,6 +719,21 @@ BRSyncManagerSetFixedPeer (BRSyncManager manager,
     }
 }
 
+extern void
+BRSyncManagerSetMetrics (BRSyncManager manager,
+                         BRMetrics metrics) {
+    switch (manager->mode) {
+        case CRYPTO_SYNC_MODE_API_ONLY:
+        break;
+        case CRYPTO_SYNC_MODE_P2P_ONLY:
+        BRPeerSyncManagerSetMetrics (BRSyncManagerAsPeerSyncManager(manager), metrics);
+        break;
+        default:
+        assert (0);
+        break;
+    }
+}
+
 extern void
 BRSyncManagerConnect(BRSyncManager manager) {
     switch (manager->mode) {
@@ -1187,28 +1295,32 @@ BRClientSyncManagerAnnounceGetTransactionsItem (BRClientSyncManager manager,
                                                 uint8_t  error) {
     BRTransaction *transaction = BRTransactionParse (txn, txnLength);
     uint8_t needRegistration = !error && NULL != transaction && BRTransactionIsSigned (transaction);
-    uint8_t needFree = 1;
 
     if (needRegistration) {
         if (0 == pthread_mutex_lock (&manager->lock)) {
             // confirm completion is for in-progress sync
-            needRegistration &= (rid == BRClientSyncManagerScanStateGetRequestId (&manager->scanState) && manager->isConnected);
+            needRegistration &= (BRClientSyncManagerScanStateHasRequestId (&manager->scanState, rid) && manager->isConnected);
+
+            // Hold a new transaction until its request completes; the request's transactions are
+            // then registered with the wallet together, in one batch.
+            if (needRegistration && NULL == BRWalletTransactionForHash (manager->wallet, transaction->txHash)) {
+                BRClientSyncManagerScanStateAddTransaction (&manager->scanState,
+                                                            (BRClientSyncManagerAnnouncedTransaction) {
+                                                                rid,
+                                                                transaction,
+                                                                blockHeight,
+                                                                timestamp
+                                                            });
+                transaction = NULL;
+            }
             pthread_mutex_unlock (&manager->lock);
         } else {
             assert (0);
         }
     }
 
-    if (needRegistration) {
-        if (NULL == BRWalletTransactionForHash (manager->wallet, transaction->txHash)) {
-            // BRWalletRegisterTransaction doesn't reliably report if the txn was added to the wallet.
-            BRWalletRegisterTransaction (manager->wallet, transaction);
-            if (transaction == BRWalletTransactionForHash (manager->wallet, transaction->txHash)) {
-                // If our transaction made it into the wallet, do not deallocate it
-                needFree = 0;
-            }
-        }
-    }
+    // ... held, or never parsed
+    if (NULL == transaction) return;
 
     // Check if the wallet knows about transaction.  This is an important check.  If the wallet
     // does not know about the tranaction then the subsequent BRWalletUpdateTransactions will
@@ -1231,10 +1343,8 @@ BRClientSyncManagerAnnounceGetTransactionsItem (BRClientSyncManager manager,
         }
     }
 
-    // Free if ownership hasn't been passed
-   if (needFree) {
-        BRTransactionFree (transaction);
-    }
+    // Free as ownership hasn't been passed; the wallet holds its own copy
+    BRTransactionFree (transaction);
 }
 
 static BRArrayOf(char *)
@@ -1281,40 +1391,51 @@ BRClientSyncManagerAnnounceGetTransactionsDone (BRClientSyncManager manager,
                                                 int success) {
     uint8_t needSyncEvent        = 0;
     uint8_t needDiscEvent        = 0;
-    uint8_t needClientCall       = 0;
     uint64_t begBlockNumber      = 0;
     uint64_t endBlockNumber      = 0;
-    size_t addressCount          = 0;
-    BRArrayOf(char *) addresses  = NULL;
+    BRArrayOf(BRClientSyncManagerTransactionsRequest) requests = NULL;
     BRSyncManagerEvent syncEvent = {0};
     BRSyncManagerEvent discEvent = {0};
 
+    BRArrayOf(BRClientSyncManagerAnnouncedTransaction) transactions = NULL;
+
+    if (0 == pthread_mutex_lock (&manager->lock)) {
+        // take the new transactions announced for the request...
+        transactions = BRClientSyncManagerScanStateRemoveTransactions (&manager->scanState, rid);
+        pthread_mutex_unlock (&manager->lock);
+    } else {
+        assert (0);
+    }
+
+    // ... and register them, WITHOUT holding the state lock, as BRWallet callbacks follow.  This
+    // must precede checking for new addresses, below.
+    if (NULL != transactions) {
+        BRClientSyncManagerRegisterTransactions (manager, transactions);
+    }
+
     if (0 == pthread_mutex_lock (&manager->lock)) {
         // confirm completion is for in-progress sync
-        if (rid == BRClientSyncManagerScanStateGetRequestId (&manager->scanState) &&
+        if (BRClientSyncManagerScanStateRemoveRequestId (&manager->scanState, rid) &&
             manager->isConnected) {
             // check for a successful completion
             if (success) {
 
-                // check if the first unused addresses have changed since last completion
-                addresses = BRClientSyncManagerConvertAddressToString
+                // check if the first unused addresses have changed since last completion; if so,
+                // request the newly derived addresses now, without waiting on other requests
+                requests = BRClientSyncManagerCreateTransactionsRequests
                 (manager,
                  BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (&manager->scanState,
                                                                         manager->wallet,
                                                                         BRChainParamsIsBitcoin (manager->chainParams)));
 
-                addressCount = NULL != addresses ? array_count(addresses) : 0;
-                if (0 != addressCount) {
+                if (NULL != requests) {
                     // ... we've discovered a new address (i.e. there were transactions announce)
 
                     // store sync data for callback outside of lock
                     begBlockNumber = BRClientSyncManagerScanStateGetStartBlockNumber (&manager->scanState);
                     endBlockNumber = BRClientSyncManagerScanStateGetEndBlockNumber (&manager->scanState);
 
-                    // store control flow flags
-                    needClientCall = 1;
-
-                } else {
+                } else if (0 == BRClientSyncManagerScanStateGetRequestCount (&manager->scanState)) {
                     // .. we haven't discovered any new addresses and we just finished the range
 
                     // store synced block height
@@ -1328,6 +1449,8 @@ BRClientSyncManagerAnnounceGetTransactionsDone (BRClientSyncManager manager,
                     BRClientSyncManagerScanStateWipe (&manager->scanState);
 
                 }
+                // ... otherwise other requests are still outstanding; the last to complete
+                // finishes the range
             } else {
                 // transition to the disconnected state
                 manager->isConnected = 0;
@@ -1364,36 +1487,20 @@ BRClientSyncManagerAnnounceGetTransactionsDone (BRClientSyncManager manager,
         assert (0);
     }
 
-    if (needClientCall) {
-        // Callback to 'client' to get all transactions (for all wallet addresses) between
-        // a {beg,end}BlockNumber.  The client will gather the transactions and then call
-        // bwmAnnounceTransaction()  (for each one or with all of them).
-        manager->clientCallbacks.funcGetTransactions (manager->clientContext,
-                                                      BRClientSyncManagerAsSyncManager (manager),
-                                                      (const char **) addresses,
-                                                      addressCount,
-                                                      begBlockNumber,
-                                                      endBlockNumber,
-                                                      rid);
-    }
-
-    if (NULL != addresses) {
-        for (size_t index = 0; index < addressCount; index++) {
-            free (addresses[index]);
-        }
-        array_free (addresses);
+    if (NULL != requests) {
+        BRClientSyncManagerSendTransactionsRequests (manager,
+                                                     requests,
+                                                     begBlockNumber,
+                                                     endBlockNumber);
     }
 }
 
 static void
 BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager) {
-    int rid                      = 0;
     uint8_t needSyncEvent        = 0;
-    uint8_t needClientCall       = 0;
     uint64_t begBlockNumber      = 0;
     uint64_t endBlockNumber      = 0;
-    size_t addressCount          = 0;
-    BRArrayOf(char *) addresses  = NULL;
+    BRArrayOf(BRClientSyncManagerTransactionsRequest) requests = NULL;
 
     if (0 == pthread_mutex_lock (&manager->lock)) {
         // check if we are connect and the prior sync has completed.
@@ -1404,25 +1511,28 @@ BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager) {
                                               manager->wallet,
                                               BRChainParamsIsBitcoin (manager->chainParams),
                                               manager->syncedBlockHeight,
-                                              manager->networkBlockHeight,
-                                              BRClientSyncManagerGenerateRid (manager));
+                                              manager->networkBlockHeight);
 
-            // get the addresses to query the BDB with
-            addresses = BRClientSyncManagerConvertAddressToString
-            (manager, BRClientSyncManagerScanStateGetAddresses (&manager->scanState));
+            // a full scan queries every address; an incremental scan only some, but periodically all
+            uint8_t isAllAddresses = (BRClientSyncManagerScanStateIsFullScan (&manager->scanState) ||
+                                      0 == manager->incrementalScanCount % BWM_BRD_SYNC_ALL_ADDRESSES_PERIOD);
+            manager->incrementalScanCount = (isAllAddresses ? 1 : manager->incrementalScanCount + 1);
 
-            assert (NULL != addresses);
-            addressCount = array_count (addresses);
-            assert (0 != addressCount);
+            // get the addresses to query the BDB with
+            requests = BRClientSyncManagerCreateTransactionsRequests
+            (manager,
+             BRClientSyncManagerScanStateGetAddresses (&manager->scanState,
+                                                       manager->wallet,
+                                                       BRChainParamsIsBitcoin (manager->chainParams),
+                                                       isAllAddresses));
+            assert (NULL != requests);
 
             // store sync data for callback outside of lock
-            rid = BRClientSyncManagerScanStateGetRequestId (&manager->scanState);
             begBlockNumber = BRClientSyncManagerScanStateGetStartBlockNumber (&manager->scanState);
             endBlockNumber = BRClientSyncManagerScanStateGetEndBlockNumber (&manager->scanState);
 
             // store control flow flags
             needSyncEvent = BRClientSyncManagerScanStateIsFullScan (&manager->scanState);
-            needClientCall = 1;
         }
 
         // Send event while holding the state lock so that event
@@ -1441,31 +1551,74 @@ BRClientSyncManagerUpdateTransactions (BRClientSyncManager manager) {
         assert (0);
     }
 
-    if (needClientCall) {
+    if (NULL != requests) {
         // We'll force the 'client' to return all transactions w/o regard to the `endBlockNumber`
         // Doing this ensures that the initial 'full-sync' returns everything.  Thus there is no
         // need to wait for a future 'tick tock' to get the recent and pending transactions'.  For
         // BTC the future 'tick tock' is minutes away; which is a burden on Users as they wait.
         endBlockNumber = BLOCK_HEIGHT_UNBOUND;
 
-        // Callback to 'client' to get all transactions (for all wallet addresses) between
-        // a {beg,end}BlockNumber.  The client will gather the transactions and then call
-        // bwmAnnounceTransaction()  (for each one or with all of them).
-        manager->clientCallbacks.funcGetTransactions (manager->clientContext,
-                                                      BRClientSyncManagerAsSyncManager (manager),
-                                                      (const char **) addresses,
-                                                      addressCount,
-                                                      begBlockNumber,
-                                                      endBlockNumber,
-                                                      rid);
+        BRClientSyncManagerSendTransactionsRequests (manager,
+                                                     requests,
+                                                     begBlockNumber,
+                                                     endBlockNumber);
     }
+}
+
+static int
+BRClientSyncManagerAnnouncedTransactionCompare (const void *tx1, const void *tx2) {
+    const BRClientSyncManagerAnnouncedTransaction *t1 = tx1, *t2 = tx2;
+    if (t1->blockHeight != t2->blockHeight) return t1->blockHeight < t2->blockHeight ? -1 : 1;
+    if (t1->timestamp   != t2->timestamp)   return t1->timestamp   < t2->timestamp   ? -1 : 1;
+    return 0;
+}
+
+static void
+BRClientSyncManagerRegisterTransactions (BRClientSyncManager manager,
+                                         OwnershipGiven BRArrayOf(BRClientSyncManagerAnnouncedTransaction) transactions) {
+    size_t transactionsCount = array_count (transactions);
+
+    // Order by block; the wallet inserts each in its sorted list of transactions and, below, those
+    // in one block are updated together.
+    qsort (transactions, transactionsCount, sizeof (BRClientSyncManagerAnnouncedTransaction),
+           BRClientSyncManagerAnnouncedTransactionCompare);
+
+    BRTransaction **walletTransactions = calloc (transactionsCount, sizeof (BRTransaction *));
+    for (size_t index = 0; index < transactionsCount; index++)
+        walletTransactions[index] = transactions[index].transaction;
+
+    BRWalletRegisterTransactions (manager->wallet, walletTransactions, transactionsCount);
+    free (walletTransactions);
 
-    if (NULL != addresses) {
-        for (size_t index = 0; index < addressCount; index++) {
-            free (addresses[index]);
+    UInt256 *txHashes = calloc (transactionsCount, sizeof (UInt256));
+
+    for (size_t index = 0; index < transactionsCount; ) {
+        uint64_t blockHeight = transactions[index].blockHeight;
+        uint64_t timestamp   = transactions[index].timestamp;
+        size_t   txHashCount = 0;
+
+        for (; index < transactionsCount &&
+             blockHeight == transactions[index].blockHeight &&
+             timestamp   == transactions[index].timestamp; index++) {
+            BRTransaction *transaction = transactions[index].transaction;
+
+            // As when a single transaction is announced: if the wallet knows about the transaction
+            // update its block; this will cascade through BRWallet callbacks to produce
+            // 'balanceUpdated' and 'txUpdated'.
+            if (BRWalletContainsTransaction (manager->wallet, transaction))
+                txHashes[txHashCount++] = transaction->txHash;
+
+            // Free if ownership hasn't been passed, including for a duplicate
+            if (transaction != BRWalletTransactionForHash (manager->wallet, transaction->txHash))
+                BRTransactionFree (transaction);
         }
-        array_free (addresses);
+
+        if (0 != txHashCount)
+            BRWalletUpdateTransactions (manager->wallet, txHashes, txHashCount, (uint32_t) blockHeight, (uint32_t) timestamp);
     }
+
+    free (txHashes);
+    array_free (transactions);
 }
 
 static void
@@ -1494,13 +1647,75 @@ BRClientSyncManagerGenerateRid (BRClientSyncManager manager) {
     return ++manager->requestIdGenerator;
 }
 
+static BRArrayOf(BRClientSyncManagerTransactionsRequest)
+BRClientSyncManagerCreateTransactionsRequests (BRClientSyncManager manager,
+                                               OwnershipGiven BRArrayOf(BRAddress *) addresses) {
+    if (NULL == addresses) return NULL;
+    if (0 == array_count(addresses)) { array_free (addresses); return NULL; }
+
+    size_t addressesCount = array_count(addresses);
+
+    BRArrayOf(BRClientSyncManagerTransactionsRequest) requests;
+    array_new (requests, 1 + addressesCount / BWM_BRD_SYNC_REQUEST_ADDRESS_LIMIT);
+
+    // Split `addresses` into requests; each is part of the scan from when it is created so that
+    // the scan does not complete until every one of them has.
+    for (size_t index = 0; index < addressesCount; index += BWM_BRD_SYNC_REQUEST_ADDRESS_LIMIT) {
+        size_t count = MIN (BWM_BRD_SYNC_REQUEST_ADDRESS_LIMIT, addressesCount - index);
+
+        BRArrayOf(BRAddress *) requestAddresses;
+        array_new (requestAddresses, count);
+        array_add_array (requestAddresses, &addresses[index], count);
+
+        BRClientSyncManagerTransactionsRequest request = {
+            BRClientSyncManagerGenerateRid (manager),
+            BRClientSyncManagerConvertAddressToString (manager, requestAddresses)
+        };
+        BRClientSyncManagerScanStateAddRequestId (&manager->scanState, request.rid);
+
+        array_add (requests, request);
+    }
+
+    // the addresses themselves are now owned by the requests
+    array_free (addresses);
+
+    return requests;
+}
+
+static void
+BRClientSyncManagerSendTransactionsRequests (BRClientSyncManager manager,
+                                             OwnershipGiven BRArrayOf(BRClientSyncManagerTransactionsRequest) requests,
+                                             uint64_t begBlockNumber,
+                                             uint64_t endBlockNumber) {
+    for (size_t index = 0; index < array_count (requests); index++) {
+        BRArrayOf(char *) addresses = requests[index].addresses;
+        size_t addressCount         = array_count (addresses);
+
+        // Callback to 'client' to get all transactions (for the request's addresses) between
+        // a {beg,end}BlockNumber.  The client will gather the transactions and then call
+        // bwmAnnounceTransaction()  (for each one or with all of them).
+        manager->clientCallbacks.funcGetTransactions (manager->clientContext,
+                                                      BRClientSyncManagerAsSyncManager (manager),
+                                                      (const char **) addresses,
+                                                      addressCount,
+                                                      begBlockNumber,
+                                                      endBlockNumber,
+                                                      requests[index].rid);
+
+        for (size_t addressIndex = 0; addressIndex < addressCount; addressIndex++) {
+            free (addresses[addressIndex]);
+        }
+        array_free (addresses);
+    }
+    array_free (requests);
+}
+
 static void
 BRClientSyncManagerScanStateInit (BRClientSyncManagerScanState scanState,
                                   BRWallet *wallet,
                                   int isBTC,
                                   uint64_t syncedBlockHeight,
-                                  uint64_t networkBlockHeight,
-                                  int rid) {
+                                  uint64_t networkBlockHeight) {
     // update the `endBlockNumber` to the current block height;
     // since this is exclusive on the end height, we need to increment by
     // one to make sure we get the last block
@@ -1515,16 +1730,17 @@ BRClientSyncManagerScanStateInit (BRClientSyncManagerScanState scanState,
     // check that we don't have an overflow
     assert (scanState->endBlockNumber > scanState->begBlockNumber);
 
-    // generate addresses
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
+    // generate addresses, speculatively past the gap limit
+    scanState->lookahead = BWM_BRD_SYNC_LOOKAHEAD_MIN;
+    _generateWalletAddresses (wallet, scanState->lookahead);
 
     // save the last known external and internal addresses
     BRWalletUnusedAddrs(wallet, &scanState->lastExternalAddress, 1, SEQUENCE_EXTERNAL_CHAIN);
     BRWalletUnusedAddrs(wallet, &scanState->lastInternalAddress, 1, SEQUENCE_INTERNAL_CHAIN);
 
-    // save the current requestId
-    scanState->requestId = rid;
+    // the scan is in progress, with no requests yet
+    assert (NULL == scanState->requestIds);
+    array_new (scanState->requestIds, 4);
 
     // mark as sync or not
     scanState->isFullScan = ((scanState->endBlockNumber - scanState->begBlockNumber) > BWM_BRD_SYNC_START_BLOCK_OFFSET);
@@ -1540,12 +1756,20 @@ BRClientSyncManagerScanStateWipe (BRClientSyncManagerScanState scanState) {
     if (NULL != scanState->knownAddresses) {
         BRSetFreeAll (scanState->knownAddresses, free);
     }
+    if (NULL != scanState->requestIds) {
+        array_free (scanState->requestIds);
+    }
+    if (NULL != scanState->transactions) {
+        for (size_t index = 0; index < array_count (scanState->transactions); index++)
+            BRTransactionFree (scanState->transactions[index].transaction);
+        array_free (scanState->transactions);
+    }
     memset (scanState, 0, sizeof(*scanState));
 }
 
 static int
 BRClientSyncManagerScanStateIsInProgress(BRClientSyncManagerScanState scanState) {
-    return 0 != scanState->requestId;
+    return NULL != scanState->requestIds;
 }
 
 static uint8_t
@@ -1553,9 +1777,64 @@ BRClientSyncManagerScanStateIsFullScan (BRClientSyncManagerScanState scanState)
     return scanState->isFullScan;
 }
 
+static void
+BRClientSyncManagerScanStateAddRequestId(BRClientSyncManagerScanState scanState,
+                                         int rid) {
+    assert (NULL != scanState->requestIds);
+    array_add (scanState->requestIds, rid);
+}
+
+static int
+BRClientSyncManagerScanStateRemoveRequestId(BRClientSyncManagerScanState scanState,
+                                            int rid) {
+    for (size_t index = 0; NULL != scanState->requestIds && index < array_count (scanState->requestIds); index++) {
+        if (rid == scanState->requestIds[index]) {
+            array_rm (scanState->requestIds, index);
+            return 1;
+        }
+    }
+    return 0;
+}
+
 static int
-BRClientSyncManagerScanStateGetRequestId(BRClientSyncManagerScanState scanState) {
-    return scanState->requestId;
+BRClientSyncManagerScanStateHasRequestId(BRClientSyncManagerScanState scanState,
+                                         int rid) {
+    for (size_t index = 0; NULL != scanState->requestIds && index < array_count (scanState->requestIds); index++) {
+        if (rid == scanState->requestIds[index]) return 1;
+    }
+    return 0;
+}
+
+static size_t
+BRClientSyncManagerScanStateGetRequestCount(BRClientSyncManagerScanState scanState) {
+    return NULL != scanState->requestIds ? array_count (scanState->requestIds) : 0;
+}
+
+static void
+BRClientSyncManagerScanStateAddTransaction(BRClientSyncManagerScanState scanState,
+                                           BRClientSyncManagerAnnouncedTransaction transaction) {
+    if (NULL == scanState->transactions) array_new (scanState->transactions, 10);
+    array_add (scanState->transactions, transaction);
+}
+
+static BRArrayOf(BRClientSyncManagerAnnouncedTransaction)
+BRClientSyncManagerScanStateRemoveTransactions(BRClientSyncManagerScanState scanState,
+                                               int rid) {
+    BRArrayOf(BRClientSyncManagerAnnouncedTransaction) transactions = NULL;
+    if (NULL == scanState->transactions) return NULL;
+
+    // move those for `rid` out; compact the others in place
+    size_t keepCount = 0;
+    for (size_t index = 0; index < array_count (scanState->transactions); index++) {
+        if (rid == scanState->transactions[index].rid) {
+            if (NULL == transactions) array_new (transactions, array_count (scanState->transactions));
+            array_add (transactions, scanState->transactions[index]);
+        }
+        else scanState->transactions[keepCount++] = scanState->transactions[index];
+    }
+    array_set_count (scanState->transactions, keepCount);
+
+    return transactions;
 }
 
 static uint64_t
@@ -1576,20 +1855,48 @@ BRClientSyncManagerScanStateGetSyncedBlockNumber(BRClientSyncManagerScanState sc
 }
 
 static BRArrayOf(BRAddress *)
-BRClientSyncManagerScanStateGetAddresses(BRClientSyncManagerScanState scanState) {
-    size_t addressCount = BRSetCount(scanState->knownAddresses);
+BRClientSyncManagerScanStateGetAddresses(BRClientSyncManagerScanState scanState,
+                                         BRWallet *wallet,
+                                         int isBTC,
+                                         uint8_t isAllAddresses) {
+    BRSetOf(BRAddress *) addressSet = scanState->knownAddresses;
+
+    // An incremental scan needn't query addresses that were queried on prior scans and haven't
+    // been used since; only the unused addresses, where new payments arrive, and those of
+    // recent transactions, which might yet change.
+    if (!isAllAddresses) {
+        addressSet = BRSetNew (BRAddressHash, BRAddressEq, BWM_BRD_SYNC_RECENT_ADDRESS_LIMIT);
+
+        uint32_t externalCount = SEQUENCE_GAP_LIMIT_EXTERNAL * scanState->lookahead;
+        uint32_t internalCount = SEQUENCE_GAP_LIMIT_INTERNAL * scanState->lookahead;
+        BRAddress unusedAddresses[externalCount + internalCount];
+
+        BRWalletUnusedAddrs (wallet, &unusedAddresses[0],             externalCount, SEQUENCE_EXTERNAL_CHAIN);
+        BRWalletUnusedAddrs (wallet, &unusedAddresses[externalCount], internalCount, SEQUENCE_INTERNAL_CHAIN);
+
+        for (size_t index = 0; index < externalCount + internalCount; index++)
+            _addWalletAddress (addressSet, wallet, &unusedAddresses[index], isBTC);
+
+        _addRecentWalletAddresses (addressSet, wallet, isBTC, scanState->begBlockNumber);
+    }
+
+    size_t addressCount = BRSetCount(addressSet);
 
     BRArrayOf(BRAddress *) addresses;
     array_new (addresses, addressCount);
     array_set_count (addresses, addressCount);
 
     size_t index = 0;
-    FOR_SET (BRAddress *, knownAddress, scanState->knownAddresses) {
+    FOR_SET (BRAddress *, address, addressSet) {
         addresses[index] = malloc (sizeof(BRAddress));
-        *addresses[index] = *knownAddress;
+        *addresses[index] = *address;
         index++;
     }
 
+    if (addressSet != scanState->knownAddresses) {
+        BRSetFreeAll (addressSet, free);
+    }
+
     return addresses;
 }
 
@@ -1599,10 +1906,6 @@ BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (BRClientSyncManagerScanSt
                                                        int isBTC) {
     BRArrayOf(BRAddress *) newAddresses = NULL;
 
-    // generate addresses
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
-    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
-
     // get the first unused address
     BRAddress externalAddress = BR_ADDRESS_NONE;
     BRAddress internalAddress = BR_ADDRESS_NONE;
@@ -1613,13 +1916,17 @@ BRClientSyncManagerScanStateAdvanceAndGetNewAddresses (BRClientSyncManagerScanSt
     if (!BRAddressEq (&externalAddress, &scanState->lastExternalAddress) ||
         !BRAddressEq (&internalAddress, &scanState->lastInternalAddress)) {
         // ... we've discovered a new address (i.e. there were transactions announce)
-        // so we need to requery the same range including the newly derived addresses
+        // so we need to requery the same range including the newly derived addresses.  The
+        // wallet is in use past where we looked; look further ahead this time.
+        scanState->lookahead = MIN (2 * scanState->lookahead, BWM_BRD_SYNC_LOOKAHEAD_MAX);
+        _generateWalletAddresses (wallet, scanState->lookahead);
 
         // store the first unused addresses for comparison in the next complete call
         scanState->lastExternalAddress = externalAddress;
         scanState->lastInternalAddress = internalAddress;
 
-        // get the list of newly discovered addresses
+        // get the list of newly discovered addresses; those already queried, speculatively,
+        // are in the known set and are not queried again
         newAddresses = _updateWalletAddressSet (scanState->knownAddresses, wallet, isBTC);
     }
 
@@ -1744,6 +2051,12 @@ BRPeerSyncManagerSetFixedPeer (BRPeerSyncManager manager,
     BRPeerManagerSetFixedPeer (manager->peerManager, address, port);
 }
 
+static void
+BRPeerSyncManagerSetMetrics (BRPeerSyncManager manager,
+                             BRMetrics metrics) {
+    BRPeerManagerSetMetrics (manager->peerManager, metrics);
+}
+
 static void
 BRPeerSyncManagerConnect(BRPeerSyncManager manager) {
     BRPeerManagerConnect (manager->peerManager);
@@ -2184,6 +2497,70 @@ _updateWalletAddressSet(BRSetOf(BRAddress *) addresses, BRWallet *wallet, int is
     return newAddresses;
 }
 
+static void
+_generateWalletAddresses (BRWallet *wallet, uint32_t windows) {
+    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL * windows, SEQUENCE_EXTERNAL_CHAIN);
+    BRWalletUnusedAddrs (wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL * windows, SEQUENCE_INTERNAL_CHAIN);
+}
+
+static void
+_addWalletAddress (BRSetOf(BRAddress *) addresses, BRWallet *wallet, const BRAddress *address, int isBTC) {
+    // For BTC, as in _getWalletAddresses(), include the LEGACY type
+    BRAddress legacyAddress = BR_ADDRESS_NONE;
+    if (isBTC) legacyAddress = BRWalletAddressToLegacy (wallet, (BRAddress *) address);
+
+    const BRAddress *candidates[] = { address, &legacyAddress };
+    for (size_t index = 0; index < (isBTC ? 2 : 1); index++) {
+        if ('\0' != candidates[index]->s[0] && !BRSetContains (addresses, candidates[index])) {
+            BRAddress *copy = malloc (sizeof(BRAddress));
+            *copy = *candidates[index];
+            BRSetAdd (addresses, copy);
+        }
+    }
+}
+
+static size_t
+_addRecentWalletAddresses (BRSetOf(BRAddress *) addresses, BRWallet *wallet, int isBTC, uint64_t begBlockNumber) {
+    size_t addedCount = 0;
+    BRAddressParams addressParams = BRWalletGetAddressParams (wallet);
+
+    size_t transactionsCount = BRWalletTransactions (wallet, NULL, 0);
+    if (0 == transactionsCount) return 0;
+
+    BRTransaction **transactions = calloc (transactionsCount, sizeof (BRTransaction *));
+    transactionsCount = BRWalletTransactions (wallet, transactions, transactionsCount);
+
+    // Newest first; the wallet sorts its transactions oldest first
+    for (size_t index = transactionsCount; index > 0 && addedCount < BWM_BRD_SYNC_RECENT_ADDRESS_LIMIT; index--) {
+        BRTransaction *transaction = transactions[index - 1];
+
+        if (transactionsCount - index >= BWM_BRD_SYNC_RECENT_TRANSACTION_COUNT &&
+            TX_UNCONFIRMED != transaction->blockHeight &&
+            transaction->blockHeight < begBlockNumber) continue;
+
+        for (size_t inputIndex = 0; inputIndex < transaction->inCount; inputIndex++) {
+            BRAddress address = BR_ADDRESS_NONE;
+            BRTxInputAddress (&transaction->inputs[inputIndex], address.s, sizeof (address.s), addressParams);
+            if (BRWalletContainsAddress (wallet, address.s)) {
+                _addWalletAddress (addresses, wallet, &address, isBTC);
+                addedCount++;
+            }
+        }
+
+        for (size_t outputIndex = 0; outputIndex < transaction->outCount; outputIndex++) {
+            BRAddress address = BR_ADDRESS_NONE;
+            BRTxOutputAddress (&transaction->outputs[outputIndex], address.s, sizeof (address.s), addressParams);
+            if (BRWalletContainsAddress (wallet, address.s)) {
+                _addWalletAddress (addresses, wallet, &address, isBTC);
+                addedCount++;
+            }
+        }
+    }
+
+    free (transactions);
+    return addedCount;
+}
+
 static uint32_t
 _calculateSyncDepthHeight(BRCryptoSyncDepth depth,
                           const BRChainParams *chainParams,
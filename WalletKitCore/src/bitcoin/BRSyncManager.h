@@ -171,6 +171,11 @@ BRSyncManagerSetFixedPeer (BRSyncManager manager,
                            UInt128 address,
                            uint16_t port);
 
+/// Record the sync manager's metrics (in P2P mode, the peer manager's) in `metrics`
+extern void
+BRSyncManagerSetMetrics (BRSyncManager manager,
+                         BRMetrics metrics);
+
 extern void
 BRSyncManagerConnect(BRSyncManager manager);
 
@@ -26,6 +26,7 @@
 #include "support/BRSet.h"
 #include "support/BRAddress.h"
 #include "support/BRArray.h"
+#include "support/BRProfile.h"
 #include <stdlib.h>
 #include <inttypes.h>
 #include <limits.h>
@@ -66,6 +67,14 @@ inline static size_t _txChainIndex(const BRTransaction *tx, const UInt160 *chain
     return -1;
 }
 
+// an immutable copy of the balance, totals, UTXOs and transaction list, published after each change so that the queries
+// a UI makes most often never wait on a writer that holds the wallet lock (e.g. while updating the balance)
+typedef struct {
+    uint64_t balance, totalSent, totalReceived;
+    BRUTXO *utxos;
+    BRTransaction **transactions;
+} BRWalletSnapshot;
+
 struct BRWalletStruct {
     uint64_t balance, totalSent, totalReceived, feePerKb, *balanceHist;
     uint32_t blockHeight;
@@ -80,9 +89,102 @@ struct BRWalletStruct {
     void (*txAdded)(void *info, BRTransaction *tx);
     void (*txUpdated)(void *info, const UInt256 txHashes[], size_t txCount, uint32_t blockHeight, uint32_t timestamp);
     void (*txDeleted)(void *info, UInt256 txHash, int notifyUser, int recommendRescan);
+    BRWalletSnapshot *snapshot;
+    BRWalletPKHCache *pkhCache; // only set while BRWalletNewWithPKHCache() runs
+    pthread_rwlock_t lock, snapshotLock; // queries take read locks, only changes to the wallet take write locks
+};
+
+struct BRWalletPKHCacheStruct {
+    BRMasterPubKey masterPubKey;
+    UInt160 *chains[2]; // indexed by SEQUENCE_EXTERNAL_CHAIN, SEQUENCE_INTERNAL_CHAIN
     pthread_mutex_t lock;
 };
 
+BRWalletPKHCache *BRWalletPKHCacheNew(BRMasterPubKey mpk)
+{
+    BRWalletPKHCache *cache = calloc(1, sizeof(*cache));
+
+    assert(cache != NULL);
+    cache->masterPubKey = mpk;
+    array_new(cache->chains[SEQUENCE_EXTERNAL_CHAIN], SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED);
+    array_new(cache->chains[SEQUENCE_INTERNAL_CHAIN], SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED);
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+void BRWalletPKHCacheFree(BRWalletPKHCache *cache)
+{
+    assert(cache != NULL);
+    array_free(cache->chains[SEQUENCE_EXTERNAL_CHAIN]);
+    array_free(cache->chains[SEQUENCE_INTERNAL_CHAIN]);
+    pthread_mutex_destroy(&cache->lock);
+    free(cache);
+}
+
+// derives the pubkey hash at index in the internal or external chain of mpk, returns true on success
+static int _BRWalletDerivePKH(BRMasterPubKey mpk, uint32_t internal, uint32_t index, UInt160 *pkh)
+{
+    BRKey key;
+    uint8_t pubKey[BRBIP32PubKey(NULL, 0, mpk, internal, index)];
+    size_t len = BRBIP32PubKey(pubKey, sizeof(pubKey), mpk, internal, index);
+
+    if (! BRKeySetPubKey(&key, pubKey, len)) return 0;
+    *pkh = BRKeyHash160(&key);
+    return 1;
+}
+
+// as _BRWalletDerivePKH(), but from wallet's cache if it has one; a cache holds every pubkey hash up to its count
+static int _BRWalletChainPKH(BRWallet *wallet, uint32_t internal, uint32_t index, UInt160 *pkh)
+{
+    BRWalletPKHCache *cache = wallet->pkhCache;
+    UInt160 *chain;
+    int r = 1;
+
+    if (! cache) return _BRWalletDerivePKH(wallet->masterPubKey, internal, index, pkh);
+    pthread_mutex_lock(&cache->lock);
+    chain = cache->chains[internal];
+
+    while (r && array_count(chain) <= index) { // another wallet deriving the same index waits, then shares it
+        r = _BRWalletDerivePKH(cache->masterPubKey, internal, (uint32_t)array_count(chain), pkh);
+        if (r) array_add(chain, *pkh);
+    }
+
+    cache->chains[internal] = chain;
+    if (r) *pkh = chain[index];
+    pthread_mutex_unlock(&cache->lock);
+    return r;
+}
+
+static void _BRWalletSnapshotFree(BRWalletSnapshot *snapshot)
+{
+    if (! snapshot) return;
+    array_free(snapshot->utxos);
+    array_free(snapshot->transactions);
+    free(snapshot);
+}
+
+// publishes a snapshot of the current balance, totals, UTXOs and transaction list; the caller must hold the write lock
+static void _BRWalletPublish(BRWallet *wallet)
+{
+    BRWalletSnapshot *snapshot = calloc(1, sizeof(*snapshot)), *old;
+
+    assert(snapshot != NULL);
+    snapshot->balance = wallet->balance;
+    snapshot->totalSent = wallet->totalSent;
+    snapshot->totalReceived = wallet->totalReceived;
+    array_new(snapshot->utxos, array_count(wallet->utxos));
+    array_add_array(snapshot->utxos, wallet->utxos, array_count(wallet->utxos));
+    array_new(snapshot->transactions, array_count(wallet->transactions));
+    array_add_array(snapshot->transactions, wallet->transactions, array_count(wallet->transactions));
+
+    // readers hold the snapshot lock only while copying out of the snapshot, so the swap waits for at most a copy
+    pthread_rwlock_wrlock(&wallet->snapshotLock);
+    old = wallet->snapshot;
+    wallet->snapshot = snapshot;
+    pthread_rwlock_unlock(&wallet->snapshotLock);
+    _BRWalletSnapshotFree(old);
+}
+
 inline static int _BRWalletTxIsAscending(BRWallet *wallet, const BRTransaction *tx1, const BRTransaction *tx2)
 {
     if (! tx1 || ! tx2) return 0;
@@ -255,10 +357,17 @@ static void _BRWalletUpdateBalance(BRWallet *wallet)
 
     assert(array_count(wallet->balanceHist) == array_count(wallet->transactions));
     wallet->balance = balance;
+    _BRWalletPublish(wallet);
 }
 
 // allocates and populates a BRWallet struct which must be freed by calling BRWalletFree()
 BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[], size_t txCount, BRMasterPubKey mpk)
+{
+    return BRWalletNewWithPKHCache(addrParams, transactions, txCount, mpk, NULL);
+}
+
+BRWallet *BRWalletNewWithPKHCache(BRAddressParams addrParams, BRTransaction *transactions[], size_t txCount,
+                                  BRMasterPubKey mpk, BRWalletPKHCache *cache)
 {
     BRWallet *wallet = NULL;
     BRTransaction *tx;
@@ -272,6 +381,9 @@ BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[],
     wallet->feePerKb = DEFAULT_FEE_PER_KB;
     wallet->masterPubKey = mpk;
     wallet->addrParams = addrParams;
+    wallet->pkhCache = (cache && cache->masterPubKey.fingerPrint == mpk.fingerPrint &&
+                        UInt256Eq(cache->masterPubKey.chainCode, mpk.chainCode) &&
+                        memcmp(cache->masterPubKey.pubKey, mpk.pubKey, sizeof(mpk.pubKey)) == 0) ? cache : NULL;
     array_new(wallet->internalChain, 100);
     array_new(wallet->externalChain, 100);
     array_new(wallet->balanceHist, txCount + 100);
@@ -281,8 +393,10 @@ BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[],
     wallet->spentOutputs = BRSetNew(BRUTXOHash, BRUTXOEq, txCount + 100);
     wallet->usedPKH = BRSetNew(_pkhHash, _pkhEq, txCount + 100);
     wallet->allPKH = BRSetNew(_pkhHash, _pkhEq, txCount + 100);
-    pthread_mutex_init(&wallet->lock, NULL);
+    pthread_rwlock_init(&wallet->lock, NULL);
+    pthread_rwlock_init(&wallet->snapshotLock, NULL);
 
+    BRProfileSpan span = BR_PROFILE_BEGIN("BRWalletInsertTx");
     for (size_t i = 0; transactions && i < txCount; i++) {
         tx = transactions[i];
         if (! BRTransactionIsSigned(tx) || BRSetContains(wallet->allTx, tx)) continue;
@@ -294,11 +408,17 @@ BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[],
             if (pkh) BRSetAdd(wallet->usedPKH, (void *)pkh);
         }
     }
-    
+
+    BR_PROFILE_END(span);
+    span = BR_PROFILE_BEGIN("BRWalletUnusedAddrs");
     BRWalletUnusedAddrs(wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL_EXTENDED, SEQUENCE_EXTERNAL_CHAIN);
     BRWalletUnusedAddrs(wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL_EXTENDED, SEQUENCE_INTERNAL_CHAIN);
+    wallet->pkhCache = NULL;
+    BR_PROFILE_END(span);
 
+    span = BR_PROFILE_BEGIN("BRWalletUpdateBalance");
     _BRWalletUpdateBalance(wallet);
+    BR_PROFILE_END(span);
 
     if (txCount > 0 && ! _BRWalletContainsTx(wallet, transactions[0])) { // verify transactions match master pubKey
         BRWalletFree(wallet);
@@ -337,14 +457,12 @@ void BRWalletSetCallbacks(BRWallet *wallet, void *info,
 // the internal chain is used for change addresses and the external chain for receive addresses
 // addrs may be NULL to only generate addresses for BRWalletContainsAddress()
 // returns the number addresses written to addrs
-size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimit, uint32_t internal)
+// non-threadsafe version of BRWalletUnusedAddrs()
+static size_t _BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimit, uint32_t internal)
 {
     UInt160 *chain = NULL, *origChain;
     size_t i, j = 0, count, startCount;
 
-    assert(wallet != NULL);
-    assert(gapLimit > 0);
-    pthread_mutex_lock(&wallet->lock);
     if (internal == SEQUENCE_EXTERNAL_CHAIN) chain = wallet->externalChain;
     if (internal == SEQUENCE_INTERNAL_CHAIN) chain = wallet->internalChain;
     assert(chain != NULL);
@@ -355,12 +473,10 @@ size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimi
     while (i > 0 && ! BRSetContains(wallet->usedPKH, &chain[i - 1])) i--;
     
     while (i + gapLimit > count) { // generate new addresses up to gapLimit
-        BRKey key;
-        uint8_t pubKey[BRBIP32PubKey(NULL, 0, wallet->masterPubKey, internal, count)];
-        size_t len = BRBIP32PubKey(pubKey, sizeof(pubKey), wallet->masterPubKey, internal, (uint32_t)count);
+        UInt160 pkh;
         
-        if (! BRKeySetPubKey(&key, pubKey, len)) break;
-        array_add(chain, BRKeyHash160(&key));
+        if (! _BRWalletChainPKH(wallet, internal, (uint32_t)count, &pkh)) break;
+        array_add(chain, pkh);
         count++;
         if (BRSetContains(wallet->usedPKH, &chain[array_count(chain) - 1])) i = count;
     }
@@ -392,19 +508,60 @@ size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimi
         }
     }
 
-    pthread_mutex_unlock(&wallet->lock);
     return j;
 }
 
+// non-threadsafe, read-only version of _BRWalletUnusedAddrs(), true if the chain already holds gapLimit unused addresses
+// following the last used address, in which case they are written to addrs
+static int _BRWalletHasUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimit, uint32_t internal)
+{
+    UInt160 *chain = NULL;
+    size_t i, count;
+
+    if (internal == SEQUENCE_EXTERNAL_CHAIN) chain = wallet->externalChain;
+    if (internal == SEQUENCE_INTERNAL_CHAIN) chain = wallet->internalChain;
+    assert(chain != NULL);
+    i = count = array_count(chain);
+    while (i > 0 && ! BRSetContains(wallet->usedPKH, &chain[i - 1])) i--;
+    if (i + gapLimit > count) return 0;
+
+    for (size_t j = 0; addrs && j < gapLimit; j++) {
+        BRAddressFromHash160(addrs[j].s, sizeof(*addrs), wallet->addrParams, &chain[i + j]);
+    }
+
+    return 1;
+}
+
+size_t BRWalletUnusedAddrs(BRWallet *wallet, BRAddress addrs[], uint32_t gapLimit, uint32_t internal)
+{
+    size_t count;
+    int found;
+
+    assert(wallet != NULL);
+    assert(gapLimit > 0);
+
+    // the addresses have usually been generated already (each registered transaction extends the chains) so look for
+    // them under a read lock first, and only take the write lock to generate more
+    pthread_rwlock_rdlock(&wallet->lock);
+    found = _BRWalletHasUnusedAddrs(wallet, addrs, gapLimit, internal);
+    pthread_rwlock_unlock(&wallet->lock);
+    if (found) return (addrs) ? gapLimit : 0;
+
+    pthread_rwlock_wrlock(&wallet->lock);
+    count = _BRWalletUnusedAddrs(wallet, addrs, gapLimit, internal);
+    pthread_rwlock_unlock(&wallet->lock);
+    return count;
+}
+
 // current wallet balance, not including transactions known to be invalid
 uint64_t BRWalletBalance(BRWallet *wallet)
 {
     uint64_t balance;
 
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
-    balance = wallet->balance;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->snapshotLock);
+    balance = wallet->snapshot->balance;
+    pthread_rwlock_unlock(&wallet->snapshotLock);
     return balance;
 }
 
@@ -412,14 +569,14 @@ uint64_t BRWalletBalance(BRWallet *wallet)
 size_t BRWalletUTXOs(BRWallet *wallet, BRUTXO *utxos, size_t utxosCount)
 {
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
-    if (! utxos || array_count(wallet->utxos) < utxosCount) utxosCount = array_count(wallet->utxos);
+    pthread_rwlock_rdlock(&wallet->snapshotLock);
+    if (! utxos || array_count(wallet->snapshot->utxos) < utxosCount) utxosCount = array_count(wallet->snapshot->utxos);
 
     for (size_t i = 0; utxos && i < utxosCount; i++) {
-        utxos[i] = wallet->utxos[i];
+        utxos[i] = wallet->snapshot->utxos[i];
     }
 
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->snapshotLock);
     return utxosCount;
 }
 
@@ -428,14 +585,16 @@ size_t BRWalletUTXOs(BRWallet *wallet, BRUTXO *utxos, size_t utxosCount)
 size_t BRWalletTransactions(BRWallet *wallet, BRTransaction *transactions[], size_t txCount)
 {
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
-    if (! transactions || array_count(wallet->transactions) < txCount) txCount = array_count(wallet->transactions);
+    pthread_rwlock_rdlock(&wallet->snapshotLock);
+    if (! transactions || array_count(wallet->snapshot->transactions) < txCount) {
+        txCount = array_count(wallet->snapshot->transactions);
+    }
 
     for (size_t i = 0; transactions && i < txCount; i++) {
-        transactions[i] = wallet->transactions[i];
+        transactions[i] = wallet->snapshot->transactions[i];
     }
     
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->snapshotLock);
     return txCount;
 }
 
@@ -447,7 +606,7 @@ size_t BRWalletTxUnconfirmedBefore(BRWallet *wallet, BRTransaction *transactions
     size_t total, n = 0;
 
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     total = array_count(wallet->transactions);
     while (n < total && wallet->transactions[(total - n) - 1]->blockHeight >= blockHeight) n++;
     if (! transactions || n < txCount) txCount = n;
@@ -456,7 +615,7 @@ size_t BRWalletTxUnconfirmedBefore(BRWallet *wallet, BRTransaction *transactions
         transactions[i] = wallet->transactions[(total - n) + i];
     }
 
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return txCount;
 }
 
@@ -466,9 +625,9 @@ uint64_t BRWalletTotalSent(BRWallet *wallet)
     uint64_t totalSent;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
-    totalSent = wallet->totalSent;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->snapshotLock);
+    totalSent = wallet->snapshot->totalSent;
+    pthread_rwlock_unlock(&wallet->snapshotLock);
     return totalSent;
 }
 
@@ -478,9 +637,9 @@ uint64_t BRWalletTotalReceived(BRWallet *wallet)
     uint64_t totalReceived;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
-    totalReceived = wallet->totalReceived;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->snapshotLock);
+    totalReceived = wallet->snapshot->totalReceived;
+    pthread_rwlock_unlock(&wallet->snapshotLock);
     return totalReceived;
 }
 
@@ -490,18 +649,18 @@ uint64_t BRWalletFeePerKb(BRWallet *wallet)
     uint64_t feePerKb;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     feePerKb = wallet->feePerKb;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return feePerKb;
 }
 
 void BRWalletSetFeePerKb(BRWallet *wallet, uint64_t feePerKb)
 {
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_wrlock(&wallet->lock);
     wallet->feePerKb = feePerKb;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
 }
 
 BRAddressParams BRWalletGetAddressParams (BRWallet *wallet) {
@@ -551,7 +710,7 @@ size_t BRWalletAllAddrs(BRWallet *wallet, BRAddress addrs[], size_t addrsCount)
     size_t i, internalCount = 0, externalCount = 0;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     internalCount = (! addrs || array_count(wallet->internalChain) < addrsCount) ?
                     array_count(wallet->internalChain) : addrsCount;
 
@@ -566,7 +725,26 @@ size_t BRWalletAllAddrs(BRWallet *wallet, BRAddress addrs[], size_t addrsCount)
         BRAddressFromHash160(addrs[internalCount + i].s, sizeof(*addrs), wallet->addrParams, &wallet->externalChain[i]);
     }
 
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
+    return internalCount + externalCount;
+}
+
+// writes the pubkey hashes of all addresses previously genereated with BRWalletUnusedAddrs() to pkhs, in the same order
+// as BRWalletAllAddrs(), this avoids encoding and decoding address strings when only the hashes are needed
+// returns the number of hashes written, or total number available if pkhs is NULL
+size_t BRWalletAllPKH(BRWallet *wallet, UInt160 pkhs[], size_t pkhsCount)
+{
+    size_t internalCount = 0, externalCount = 0;
+    
+    assert(wallet != NULL);
+    pthread_rwlock_rdlock(&wallet->lock);
+    internalCount = (! pkhs || array_count(wallet->internalChain) < pkhsCount) ?
+                    array_count(wallet->internalChain) : pkhsCount;
+    if (pkhs) memcpy(pkhs, wallet->internalChain, internalCount*sizeof(*pkhs));
+    externalCount = (! pkhs || array_count(wallet->externalChain) < pkhsCount - internalCount) ?
+                    array_count(wallet->externalChain) : pkhsCount - internalCount;
+    if (pkhs) memcpy(&pkhs[internalCount], wallet->externalChain, externalCount*sizeof(*pkhs));
+    pthread_rwlock_unlock(&wallet->lock);
     return internalCount + externalCount;
 }
 
@@ -578,10 +756,10 @@ int BRWalletContainsAddress(BRWallet *wallet, const char *addr)
     
     assert(wallet != NULL);
     assert(addr != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     if (addr) BRAddressHash160(&pkh, wallet->addrParams, addr);
     r = BRSetContains(wallet->allPKH, &pkh);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return r;
 }
 
@@ -593,10 +771,10 @@ int BRWalletAddressIsUsed(BRWallet *wallet, const char *addr)
     
     assert(wallet != NULL);
     assert(addr != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     if (addr) BRAddressHash160(&pkh, wallet->addrParams, addr);
     r = BRSetContains(wallet->usedPKH, &pkh);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return r;
 }
 
@@ -650,7 +828,7 @@ BRTransaction *BRWalletCreateTxForOutputsWithFeePerKb(BRWallet *wallet, uint64_t
     }
     
     minAmount = BRWalletMinOutputAmountWithFeePerKb(wallet, feePerKb);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     feePerKb = UINT64_MAX == feePerKb ? wallet->feePerKb : feePerKb;
     feeAmount = _txFee(feePerKb, BRTransactionVSize(transaction) + TX_OUTPUT_SIZE);
     
@@ -672,7 +850,7 @@ BRTransaction *BRWalletCreateTxForOutputsWithFeePerKb(BRWallet *wallet, uint64_t
             // check for sufficient total funds before building a smaller transaction
             if (wallet->balance < amount + _txFee(feePerKb, 10 + array_count(wallet->utxos)*TX_INPUT_SIZE +
                                                   (outCount + 1)*TX_OUTPUT_SIZE + cpfpSize)) break;
-            pthread_mutex_unlock(&wallet->lock);
+            pthread_rwlock_unlock(&wallet->lock);
 
             if (outputs[outCount - 1].amount > amount + feeAmount + minAmount - balance) {
                 BRTxOutput newOutputs[outCount];
@@ -687,7 +865,7 @@ BRTransaction *BRWalletCreateTxForOutputsWithFeePerKb(BRWallet *wallet, uint64_t
             else transaction = BRWalletCreateTxForOutputsWithFeePerKb(wallet, feePerKb, outputs, outCount - 1); // remove last output
 
             balance = amount = feeAmount = 0;
-            pthread_mutex_lock(&wallet->lock);
+            pthread_rwlock_rdlock(&wallet->lock);
             break;
         }
         
@@ -707,7 +885,7 @@ BRTransaction *BRWalletCreateTxForOutputsWithFeePerKb(BRWallet *wallet, uint64_t
         if (balance == amount + feeAmount || balance >= amount + feeAmount + minAmount) break;
     }
     
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     
     if (transaction && (outCount < 1 || balance < amount + feeAmount)) { // no outputs/insufficient funds
         BRTransactionFree(transaction);
@@ -737,7 +915,7 @@ int BRWalletSignTransaction(BRWallet *wallet, BRTransaction *tx, uint8_t forkId,
     
     assert(wallet != NULL);
     assert(tx != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     
     for (i = 0; tx && i < tx->inCount; i++) {
         const uint8_t *pkh = BRScriptPKH(tx->inputs[i].script, tx->inputs[i].scriptLen);
@@ -751,7 +929,7 @@ int BRWalletSignTransaction(BRWallet *wallet, BRTransaction *tx, uint8_t forkId,
         }
     }
 
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
 
     BRKey keys[internalCount + externalCount];
 
@@ -775,9 +953,9 @@ int BRWalletContainsTransaction(BRWallet *wallet, const BRTransaction *tx)
     
     assert(wallet != NULL);
     assert(tx != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     if (tx) r = _BRWalletContainsTx(wallet, tx);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return r;
 }
 
@@ -790,7 +968,7 @@ int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx)
     assert(tx != NULL && BRTransactionIsSigned(tx));
     
     if (tx && BRTransactionIsSigned(tx)) {
-        pthread_mutex_lock(&wallet->lock);
+        pthread_rwlock_wrlock(&wallet->lock);
 
         if (! BRSetContains(wallet->allTx, tx)) {
             if (_BRWalletContainsTx(wallet, tx)) {
@@ -810,7 +988,7 @@ int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx)
             }
         }
     
-        pthread_mutex_unlock(&wallet->lock);
+        pthread_rwlock_unlock(&wallet->lock);
     }
     else r = 0;
 
@@ -825,6 +1003,65 @@ int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx)
     return r;
 }
 
+// adds the wallet transactions in txs to the wallet, as BRWalletRegisterTransaction() would one at a time, but updates the
+// balance and extends the address chains once for the batch and calls balanceChanged() once
+// NOTE: unlike BRWalletRegisterTransaction(), unconfirmed non-wallet tx are not kept; a caller registering tx it has not
+// first checked with BRWalletContainsTransaction() would otherwise hand the wallet every tx it sees
+size_t BRWalletRegisterTransactions(BRWallet *wallet, BRTransaction *txs[], size_t txCount)
+{
+    BRTransaction *tx, **added = NULL;
+    const uint8_t *pkh;
+    uint64_t balance;
+    size_t i, j, found, addedCount;
+
+    assert(wallet != NULL);
+    assert(txs != NULL || txCount == 0);
+    if (txCount == 0) return 0;
+    array_new(added, txCount);
+    pthread_rwlock_wrlock(&wallet->lock);
+
+    // a wallet tx can pay to an address that was only generated when an earlier wallet tx was registered, and tx aren't
+    // necessarily in dependency order, so repeat until no new wallet tx are found
+    do {
+        for (i = 0, found = 0; i < txCount; i++) {
+            tx = txs[i];
+            if (! tx || ! BRTransactionIsSigned(tx) || BRSetContains(wallet->allTx, tx)) continue;
+            if (! _BRWalletContainsTx(wallet, tx)) continue;
+            BRSetAdd(wallet->allTx, tx);
+            _BRWalletInsertTx(wallet, tx);
+            array_add(added, tx);
+            found++;
+
+            // mark the tx outputs used now, rather than in _BRWalletUpdateBalance(), so the chains extend past them
+            for (j = 0; j < tx->outCount; j++) {
+                pkh = BRScriptPKH(tx->outputs[j].script, tx->outputs[j].scriptLen);
+                if (pkh && BRSetContains(wallet->allPKH, pkh)) BRSetAdd(wallet->usedPKH, (void *)pkh);
+            }
+        }
+
+        if (found > 0) { // when a wallet address is used in a transaction, generate a new address to replace it
+            _BRWalletUnusedAddrs(wallet, NULL, SEQUENCE_GAP_LIMIT_EXTERNAL, SEQUENCE_EXTERNAL_CHAIN);
+            _BRWalletUnusedAddrs(wallet, NULL, SEQUENCE_GAP_LIMIT_INTERNAL, SEQUENCE_INTERNAL_CHAIN);
+        }
+    } while (found > 0);
+
+    addedCount = array_count(added);
+    if (addedCount > 0) _BRWalletUpdateBalance(wallet);
+    balance = wallet->balance;
+    pthread_rwlock_unlock(&wallet->lock);
+
+    if (addedCount > 0) {
+        if (wallet->balanceChanged) wallet->balanceChanged(wallet->callbackInfo, balance);
+
+        for (i = 0; wallet->txAdded && i < addedCount; i++) {
+            wallet->txAdded(wallet->callbackInfo, added[i]);
+        }
+    }
+
+    array_free(added);
+    return addedCount;
+}
+
 // removes a tx from the wallet, along with any tx that depend on its outputs
 void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash)
 {
@@ -834,7 +1071,7 @@ void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash)
 
     assert(wallet != NULL);
     assert(! UInt256IsZero(txHash));
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_wrlock(&wallet->lock);
     tx = BRSetGet(wallet->allTx, &txHash);
 
     if (tx) {
@@ -853,7 +1090,7 @@ void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash)
         }
         
         if (array_count(hashes) > 0) {
-            pthread_mutex_unlock(&wallet->lock);
+            pthread_rwlock_unlock(&wallet->lock);
             
             for (size_t i = array_count(hashes); i > 0; i--) {
                 BRWalletRemoveTransaction(wallet, hashes[i - 1]);
@@ -869,7 +1106,7 @@ void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash)
             }
             
             _BRWalletUpdateBalance(wallet);
-            pthread_mutex_unlock(&wallet->lock);
+            pthread_rwlock_unlock(&wallet->lock);
             
             // if this is for a transaction we sent, and it wasn't already known to be invalid, notify user
             if (BRWalletAmountSentByTx(wallet, tx) > 0 && BRWalletTransactionIsValid(wallet, tx)) {
@@ -889,7 +1126,7 @@ void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash)
         
         array_free(hashes);
     }
-    else pthread_mutex_unlock(&wallet->lock);
+    else pthread_rwlock_unlock(&wallet->lock);
 }
 
 // returns the transaction with the given hash if it's been registered in the wallet
@@ -899,9 +1136,9 @@ BRTransaction *BRWalletTransactionForHash(BRWallet *wallet, UInt256 txHash)
     
     assert(wallet != NULL);
     assert(! UInt256IsZero(txHash));
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     tx = BRSetGet(wallet->allTx, &txHash);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return tx;
 }
 
@@ -911,10 +1148,10 @@ BRTransaction *BRWalletTransactionCopyForHash(BRWallet *wallet, UInt256 txHash)
 
     assert(wallet != NULL);
     assert(! UInt256IsZero(txHash));
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     tx = BRSetGet(wallet->allTx, &txHash);
     if (tx) tx = BRTransactionCopy (tx);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return tx;
 }
 
@@ -931,7 +1168,7 @@ int BRWalletTransactionIsValid(BRWallet *wallet, const BRTransaction *tx)
     // TODO: XXX conflicted tx with the same wallet outputs should be presented as the same tx to the user
 
     if (tx && tx->blockHeight == TX_UNCONFIRMED) { // only unconfirmed transactions can be invalid
-        pthread_mutex_lock(&wallet->lock);
+        pthread_rwlock_rdlock(&wallet->lock);
 
         if (! BRSetContains(wallet->allTx, tx)) {
             for (size_t i = 0; r && i < tx->inCount; i++) {
@@ -940,7 +1177,7 @@ int BRWalletTransactionIsValid(BRWallet *wallet, const BRTransaction *tx)
         }
         else if (BRSetContains(wallet->invalidTx, tx)) r = 0;
 
-        pthread_mutex_unlock(&wallet->lock);
+        pthread_rwlock_unlock(&wallet->lock);
 
         for (size_t i = 0; r && i < tx->inCount; i++) {
             t = BRWalletTransactionForHash(wallet, tx->inputs[i].txHash);
@@ -961,9 +1198,9 @@ int BRWalletTransactionIsPending(BRWallet *wallet, const BRTransaction *tx)
     
     assert(wallet != NULL);
     assert(tx != NULL && BRTransactionIsSigned(tx));
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     blockHeight = wallet->blockHeight;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
 
     if (tx && tx->blockHeight == TX_UNCONFIRMED) { // only unconfirmed transactions can be postdated
         if (BRTransactionVSize(tx) > TX_MAX_SIZE) r = 1; // check transaction size is under TX_MAX_SIZE
@@ -1042,13 +1279,13 @@ int BRWalletTransactionIsResolved (BRWallet *wallet, const BRTransaction *tx) {
     _IsResolvedTransactionAssert (tx != NULL);
     _IsResolvedSignatureAssert (BRTransactionIsSigned(tx));
 
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     for (size_t i = 0; r && i < tx->inCount; i++) {
         if (_BRWalletContainsTxInput (wallet, tx, &tx->inputs[i]) &&
             NULL == BRSetGet(wallet->allTx, &tx->inputs[i].txHash))
             r = 0;
     }
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
 
     return r;
 }
@@ -1065,7 +1302,7 @@ void BRWalletUpdateTransactions(BRWallet *wallet, const UInt256 txHashes[], size
     
     assert(wallet != NULL);
     assert(txHashes != NULL || txCount == 0);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_wrlock(&wallet->lock);
     if (blockHeight != TX_UNCONFIRMED && blockHeight > wallet->blockHeight) wallet->blockHeight = blockHeight;
     
     for (i = 0, j = 0; txHashes && i < txCount; i++) {
@@ -1092,7 +1329,8 @@ void BRWalletUpdateTransactions(BRWallet *wallet, const UInt256 txHashes[], size
     }
     
     if (needsUpdate) _BRWalletUpdateBalance(wallet);
-    pthread_mutex_unlock(&wallet->lock);
+    else if (j > 0) _BRWalletPublish(wallet); // the transaction list was re-sorted
+    pthread_rwlock_unlock(&wallet->lock);
     if (j > 0 && wallet->txUpdated) wallet->txUpdated(wallet->callbackInfo, hashes, j, blockHeight, timestamp);
 }
 
@@ -1102,7 +1340,7 @@ void BRWalletSetTxUnconfirmedAfter(BRWallet *wallet, uint32_t blockHeight)
     size_t i, j, count;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_wrlock(&wallet->lock);
     wallet->blockHeight = blockHeight;
     count = i = array_count(wallet->transactions);
     while (i > 0 && wallet->transactions[i - 1]->blockHeight > blockHeight) i--;
@@ -1116,7 +1354,7 @@ void BRWalletSetTxUnconfirmedAfter(BRWallet *wallet, uint32_t blockHeight)
     }
     
     if (count > 0) _BRWalletUpdateBalance(wallet);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     if (count > 0 && wallet->txUpdated) wallet->txUpdated(wallet->callbackInfo, hashes, count, TX_UNCONFIRMED, 0);
 }
 
@@ -1128,7 +1366,7 @@ uint64_t BRWalletAmountReceivedFromTx(BRWallet *wallet, const BRTransaction *tx)
     
     assert(wallet != NULL);
     assert(tx != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     
     // TODO: don't include outputs below TX_MIN_OUTPUT_AMOUNT
     for (size_t i = 0; tx && i < tx->outCount; i++) {
@@ -1136,7 +1374,7 @@ uint64_t BRWalletAmountReceivedFromTx(BRWallet *wallet, const BRTransaction *tx)
         if (pkh && BRSetContains(wallet->allPKH, pkh)) amount += tx->outputs[i].amount;
     }
     
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return amount;
 }
 
@@ -1147,7 +1385,7 @@ uint64_t BRWalletAmountSentByTx(BRWallet *wallet, const BRTransaction *tx)
     
     assert(wallet != NULL);
     assert(tx != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     
     for (size_t i = 0; tx && i < tx->inCount; i++) {
         BRTransaction *t = BRSetGet(wallet->allTx, &tx->inputs[i].txHash);
@@ -1160,7 +1398,7 @@ uint64_t BRWalletAmountSentByTx(BRWallet *wallet, const BRTransaction *tx)
         }
     }
     
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return amount;
 }
 
@@ -1171,7 +1409,7 @@ uint64_t BRWalletFeeForTx(BRWallet *wallet, const BRTransaction *tx)
     
     assert(wallet != NULL);
     assert(tx != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     
     for (size_t i = 0; tx && i < tx->inCount && amount != UINT64_MAX; i++) {
         BRTransaction *t = BRSetGet(wallet->allTx, &tx->inputs[i].txHash);
@@ -1183,7 +1421,7 @@ uint64_t BRWalletFeeForTx(BRWallet *wallet, const BRTransaction *tx)
         else amount = UINT64_MAX;
     }
     
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     
     for (size_t i = 0; tx && i < tx->outCount && amount != UINT64_MAX; i++) {
         amount -= tx->outputs[i].amount;
@@ -1199,7 +1437,7 @@ uint64_t BRWalletBalanceAfterTx(BRWallet *wallet, const BRTransaction *tx)
     
     assert(wallet != NULL);
     assert(tx != NULL && BRTransactionIsSigned(tx));
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     balance = wallet->balance;
     
     for (size_t i = array_count(wallet->transactions); tx && i > 0; i--) {
@@ -1208,7 +1446,7 @@ uint64_t BRWalletBalanceAfterTx(BRWallet *wallet, const BRTransaction *tx)
         break;
     }
 
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return balance;
 }
 
@@ -1218,9 +1456,9 @@ uint64_t BRWalletFeeForTxSize(BRWallet *wallet, size_t size)
     uint64_t fee;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     fee = _txFee(wallet->feePerKb, size);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return fee;
 }
 
@@ -1269,10 +1507,10 @@ uint64_t BRWalletMinOutputAmountWithFeePerKb(BRWallet *wallet, uint64_t feePerKb
     uint64_t amount;
     
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     feePerKb = UINT64_MAX == feePerKb ? wallet->feePerKb : feePerKb;
     amount = (TX_MIN_OUTPUT_AMOUNT*feePerKb + MIN_FEE_PER_KB - 1)/MIN_FEE_PER_KB;
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     return (amount > TX_MIN_OUTPUT_AMOUNT) ? amount : TX_MIN_OUTPUT_AMOUNT;
 }
 
@@ -1292,7 +1530,7 @@ uint64_t BRWalletMaxOutputAmountWithFeePerKb(BRWallet *wallet, uint64_t feePerKb
     size_t i, txSize, cpfpSize = 0, inCount = 0;
 
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_rdlock(&wallet->lock);
     feePerKb = UINT64_MAX == feePerKb ? wallet->feePerKb : feePerKb;
 
     for (i = array_count(wallet->utxos); i > 0; i--) {
@@ -1310,7 +1548,7 @@ uint64_t BRWalletMaxOutputAmountWithFeePerKb(BRWallet *wallet, uint64_t feePerKb
 
     txSize = 8 + BRVarIntSize(inCount) + TX_INPUT_SIZE*inCount + BRVarIntSize(2) + TX_OUTPUT_SIZE*2;
     fee = _txFee(feePerKb, txSize + cpfpSize);
-    pthread_mutex_unlock(&wallet->lock);
+    pthread_rwlock_unlock(&wallet->lock);
     
     return (amount > fee) ? amount - fee : 0;
 }
@@ -1324,7 +1562,7 @@ static void _setApplyFreeTx(void *info, void *tx)
 void BRWalletFree(BRWallet *wallet)
 {
     assert(wallet != NULL);
-    pthread_mutex_lock(&wallet->lock);
+    pthread_rwlock_wrlock(&wallet->lock);
     BRSetFree(wallet->allPKH);
     BRSetFree(wallet->usedPKH);
     BRSetFree(wallet->invalidTx);
@@ -1337,8 +1575,10 @@ void BRWalletFree(BRWallet *wallet)
     array_free(wallet->balanceHist);
     array_free(wallet->transactions);
     array_free(wallet->utxos);
-    pthread_mutex_unlock(&wallet->lock);
-    pthread_mutex_destroy(&wallet->lock);
+    _BRWalletSnapshotFree(wallet->snapshot);
+    pthread_rwlock_unlock(&wallet->lock);
+    pthread_rwlock_destroy(&wallet->lock);
+    pthread_rwlock_destroy(&wallet->snapshotLock);
     free(wallet);
 }
 
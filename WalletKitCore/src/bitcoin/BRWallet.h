@@ -61,6 +61,21 @@ typedef struct BRWalletStruct BRWallet;
 // allocates and populates a BRWallet struct that must be freed by calling BRWalletFree()
 BRWallet *BRWalletNew(BRAddressParams addrParams, BRTransaction *transactions[], size_t txCount, BRMasterPubKey mpk);
 
+// a thread-safe cache of the pubkey hashes derived from a master pubkey, so that wallets created with the same mpk (for
+// instance bitcoin and bitcoin cash) derive their chains only once
+typedef struct BRWalletPKHCacheStruct BRWalletPKHCache;
+
+// returns a new cache for mpk that must be freed by calling BRWalletPKHCacheFree()
+BRWalletPKHCache *BRWalletPKHCacheNew(BRMasterPubKey mpk);
+
+// frees memory allocated for cache
+void BRWalletPKHCacheFree(BRWalletPKHCache *cache);
+
+// as BRWalletNew(), but the chain addresses generated while creating the wallet are taken from, or added to, cache
+// cache must be for mpk, or NULL; the wallet does not keep it
+BRWallet *BRWalletNewWithPKHCache(BRAddressParams addrParams, BRTransaction *transactions[], size_t txCount,
+                                  BRMasterPubKey mpk, BRWalletPKHCache *cache);
+
 // not thread-safe, set callbacks once after BRWalletNew(), before calling other BRWallet functions
 // info is a void pointer that will be passed along with each callback call
 // void balanceChanged(void *, uint64_t) - called when the wallet balance changes
@@ -98,6 +113,11 @@ BRAddress BRWalletAddressToLegacy (BRWallet *wallet, BRAddress *addr);
 // returns the number addresses written, or total number available if addrs is NULL
 size_t BRWalletAllAddrs(BRWallet *wallet, BRAddress addrs[], size_t addrsCount);
 
+// writes the pubkey hashes of all addresses previously genereated with BRWalletUnusedAddrs() to pkhs, in the same order
+// as BRWalletAllAddrs(), this avoids encoding and decoding address strings when only the hashes are needed
+// returns the number of hashes written, or total number available if pkhs is NULL
+size_t BRWalletAllPKH(BRWallet *wallet, UInt160 pkhs[], size_t pkhsCount);
+
 // true if the address was previously generated by BRWalletUnusedAddrs() (even if it's now used)
 int BRWalletContainsAddress(BRWallet *wallet, const char *addr);
 
@@ -165,6 +185,14 @@ int BRWalletContainsTransaction(BRWallet *wallet, const BRTransaction *tx);
 // adds a transaction to the wallet, or returns false if it isn't associated with the wallet
 int BRWalletRegisterTransaction(BRWallet *wallet, BRTransaction *tx);
 
+// adds the transactions in txs that are associated with the wallet, in one batch: the balance is updated and
+// balanceChanged() is called once, and txAdded() is called for each added transaction
+// a transaction may pay to an address generated only once another in txs is added; it is added all the same
+// the wallet takes ownership of the added transactions, those that BRWalletTransactionForHash() then returns; others,
+// including unconfirmed non-wallet transactions, remain the caller's
+// returns the number of transactions added
+size_t BRWalletRegisterTransactions(BRWallet *wallet, BRTransaction *txs[], size_t txCount);
+
 // removes a tx from the wallet, along with any tx that depend on its outputs
 void BRWalletRemoveTransaction(BRWallet *wallet, UInt256 txHash);
 
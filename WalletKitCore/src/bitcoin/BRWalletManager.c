@@ -24,6 +24,7 @@
 #include "bcash/BRBCashParams.h"
 
 #include "support/BRFileService.h"
+#include "support/BRProfile.h"
 #include "ethereum/event/BREvent.h"
 #include "ethereum/event/BREventAlarm.h"
 
@@ -997,7 +998,8 @@ BRWalletManagerNew (BRWalletManagerClient client,
                     BRCryptoSyncMode mode,
                     const char *baseStoragePath,
                     uint64_t blockHeight,
-                    uint64_t confirmationsUntilFinal) {
+                    uint64_t confirmationsUntilFinal,
+                    BRWalletPKHCache *pkhCache) {
     assert (mode == CRYPTO_SYNC_MODE_API_ONLY || CRYPTO_SYNC_MODE_P2P_ONLY);
 
     BRWalletManager bwm = calloc (1, sizeof (struct BRWalletManagerStruct));
@@ -1041,20 +1043,30 @@ BRWalletManagerNew (BRWalletManagerClient client,
     //
     const char *networkName  = getNetworkName  (params);
     const char *currencyName = getCurrencyName (params);
+    BRProfileSpan span = BR_PROFILE_BEGIN ("fileServiceCreate");
     bwm->fileService = fileServiceCreateFromTypeSpecfications (baseStoragePath, currencyName, networkName,
                                                                bwm,
                                                                bwmFileServiceErrorHandler,
                                                                fileServiceSpecificationsCount,
                                                                fileServiceSpecifications);
+    BR_PROFILE_END (span);
     if (NULL == bwm->fileService) {
         return bwmCreateErrorHandler (bwm, 1, "create");
     }
 
     /// Load transactions for the wallet manager.
+    span = BR_PROFILE_BEGIN ("loadTransactions");
     BRArrayOf(BRTransaction*) transactions = initialTransactionsLoad(bwm);
+    BR_PROFILE_END (span);
+
     /// Load blocks and peers for the peer manager.
+    span = BR_PROFILE_BEGIN ("loadBlocks");
     BRArrayOf(BRMerkleBlock*) blocks = initialBlocksLoad(bwm);
+    BR_PROFILE_END (span);
+
+    span = BR_PROFILE_BEGIN ("loadPeers");
     BRArrayOf(BRPeer) peers = initialPeersLoad(bwm);
+    BR_PROFILE_END (span);
 
     // If any of these are NULL, then there was a failure; on a failure they all need to be cleared
     // which will cause a *FULL SYNC*
@@ -1074,7 +1086,9 @@ BRWalletManagerNew (BRWalletManagerClient client,
 
     // Create the Wallet being managed and populate with the loaded transactions
     _peer_log ("BWM: initializing wallet with %zu transactions", array_count(transactions));
-    bwm->wallet = BRWalletNew (params->addrParams, transactions, array_count(transactions), mpk);
+    span = BR_PROFILE_BEGIN ("BRWalletNew");
+    bwm->wallet = BRWalletNewWithPKHCache (params->addrParams, transactions, array_count(transactions), mpk, pkhCache);
+    BR_PROFILE_END (span);
     if (NULL == bwm->wallet) {
         array_free(transactions); array_free(blocks); array_free(peers);
         return bwmCreateErrorHandler (bwm, 0, "wallet");
@@ -1091,6 +1105,7 @@ BRWalletManagerNew (BRWalletManagerClient client,
     // for retrieving blockchain data
     _peer_log ("BWM: initializing sync manager with %zu blocks and %zu peers",
                array_count(blocks), array_count(peers));
+    span = BR_PROFILE_BEGIN ("BRSyncManagerNew");
     bwm->syncManager = BRSyncManagerNewForMode (mode,
                                                 bwm,
                                                 _BRWalletManagerSyncEvent,
@@ -1108,6 +1123,7 @@ BRWalletManagerNew (BRWalletManagerClient client,
                                                 DEFAULT_NETWORK_IS_REACHABLE,
                                                 blocks, array_count(blocks),
                                                 peers,  array_count(peers));
+    BR_PROFILE_END (span);
 
     // No longer need the loaded txns/blocks/peers
     array_free(transactions); array_free(blocks); array_free(peers);
@@ -1241,6 +1257,17 @@ BRWalletManagerSetFixedPeer (BRWalletManager manager,
     pthread_mutex_unlock (&manager->lock);
 }
 
+extern void
+BRWalletManagerSetMetrics (BRWalletManager manager,
+                           BRMetrics metrics) {
+    pthread_mutex_lock (&manager->lock);
+    manager->metrics = metrics;
+    fileServiceSetMetrics (manager->fileService, metrics);
+    eventHandlerSetMetrics (manager->handler, metrics);
+    BRSyncManagerSetMetrics (manager->syncManager, metrics);
+    pthread_mutex_unlock (&manager->lock);
+}
+
 extern void
 BRWalletManagerWipe (const BRChainParams *params,
                       const char *baseStoragePath) {
@@ -1330,6 +1357,7 @@ BRWalletManagerSetMode (BRWalletManager manager, BRCryptoSyncMode mode) {
                                                         isNetworkReachable,
                                                         blocks, array_count (blocks),
                                                         peers, array_count (peers));
+        BRSyncManagerSetMetrics (manager->syncManager, manager->metrics);
 
         // No longer need the loaded blocks/peers
         array_free(blocks); array_free(peers);
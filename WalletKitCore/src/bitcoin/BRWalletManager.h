@@ -273,7 +273,8 @@ BRWalletManagerNew (BRWalletManagerClient client,
                     BRCryptoSyncMode mode,
                     const char *storagePath,
                     uint64_t blockHeight,
-                    uint64_t confirmationsUntilFinal);
+                    uint64_t confirmationsUntilFinal,
+                    BRWalletPKHCache *pkhCache);   // for `mpk`, or NULL; see BRWalletNewWithPKHCache()
 
 extern void
 BRWalletManagerFree (BRWalletManager manager);
@@ -295,6 +296,14 @@ BRWalletManagerSetFixedPeer (BRWalletManager manager,
                              UInt128 address,
                              uint16_t port);
 
+/**
+ * Record the file service, event handler and sync manager metrics in `metrics`, which must
+ * outlive the manager (or be replaced with NULL).
+ */
+extern void
+BRWalletManagerSetMetrics (BRWalletManager manager,
+                           BRMetrics metrics);
+
 extern void
 BRWalletManagerScan (BRWalletManager manager);
 
@@ -62,6 +62,11 @@ struct BRWalletManagerStruct {
      */
     uint32_t sleepWakeupsForSyncTickTock;
 
+    /**
+     * The metrics, if any, recorded by the file service, handler and sync manager.  Not owned.
+     */
+    BRMetrics metrics;
+
     /**
      * The Lock ensuring single thread access to BWM state.
      */
@@ -8,7 +8,10 @@
 //  See the LICENSE file at the project root for license information.
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
+#include <sys/mman.h>           // mlock()
+#include <unistd.h>             // sysconf()
 #include "support/BROSCompat.h"
+#include "support/BRCrypto.h"   // mem_clean()
 #include "BRCryptoAccountP.h"
 #include "BRCryptoNetworkP.h"
 
@@ -86,6 +89,7 @@ cryptoAccountCreateInternal (BRMasterPubKey btc,
     BRCryptoAccount account = malloc (sizeof (struct BRCryptoAccountRecord));
 
     account->btc = btc;
+    account->btcPKHCache = BRWalletPKHCacheNew (btc);
     account->eth = eth;
     account->xrp = xrp;
     account->hbar = hbar;
@@ -218,6 +222,7 @@ if (bytesPtr > bytesEnd) return NULL; /* overkill */ \
 
 static void
 cryptoAccountRelease (BRCryptoAccount account) {
+    BRWalletPKHCacheFree (account->btcPKHCache);
     ethAccountRelease(account->eth);
     genAccountRelease(account->xrp);
     genAccountRelease(account->hbar);
@@ -469,6 +474,112 @@ cryptoAccountAsBTC (BRCryptoAccount account) {
     return account->btc;
 }
 
+private_extern BRWalletPKHCache *
+cryptoAccountAsBTCPKHCache (BRCryptoAccount account) {
+    return account->btcPKHCache;
+}
+
+/// MARK: - Signing Session
+
+struct BRCryptoSigningSessionRecord {
+    pthread_mutex_t lock;
+
+    /// The seed, in its own whole-page, locked allocation of `seedSize` bytes; NULL once expired.
+    UInt512 *seed;
+    size_t seedSize;
+    BRCryptoBoolean seedLocked;
+
+    /// The time, in seconds since the epoch, of expiration; 0 for none.
+    uint64_t expiration;
+
+    BRCryptoRef ref;
+};
+
+IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoSigningSession, cryptoSigningSession);
+
+extern BRCryptoSigningSession
+cryptoSigningSessionCreate (const char *paperKey,
+                            uint64_t lifetime) {
+    BRCryptoSigningSession session = calloc (1, sizeof (struct BRCryptoSigningSessionRecord));
+
+    // Whole pages of its own, so the seed shares locked memory with nothing else
+    size_t pageSize = (size_t) sysconf (_SC_PAGESIZE);
+    size_t seedSize = pageSize * ((sizeof (UInt512) + pageSize - 1) / pageSize);
+    void *seed = NULL;
+    if (0 != posix_memalign (&seed, pageSize, seedSize)) seed = NULL;
+    assert (NULL != seed);
+    memset (seed, 0, seedSize);
+
+    // Locking may fail, such as for RLIMIT_MEMLOCK; the session is still usable.
+    session->seedLocked = AS_CRYPTO_BOOLEAN (0 == mlock (seed, seedSize));
+
+    session->seed     = seed;
+    session->seedSize = seedSize;
+    *session->seed = cryptoAccountDeriveSeedInternal (paperKey);
+
+    session->expiration = (0 == lifetime ? 0 : (uint64_t) time (NULL) + lifetime);
+    session->ref = CRYPTO_REF_ASSIGN (cryptoSigningSessionRelease);
+
+    pthread_mutex_init (&session->lock, NULL);
+
+    return session;
+}
+
+// Zero and free the seed.  The session is locked.
+static void
+cryptoSigningSessionExpireInternal (BRCryptoSigningSession session) {
+    if (NULL == session->seed) return;
+
+    mem_clean (session->seed, session->seedSize);
+    if (CRYPTO_TRUE == session->seedLocked) munlock (session->seed, session->seedSize);
+    free (session->seed);
+
+    session->seed = NULL;
+}
+
+static void
+cryptoSigningSessionRelease (BRCryptoSigningSession session) {
+    cryptoSigningSessionExpireInternal (session);
+    pthread_mutex_destroy (&session->lock);
+
+    memset (session, 0, sizeof(*session));
+    free (session);
+}
+
+// Expire the session if past its expiration.  The session is locked.
+static void
+cryptoSigningSessionCheckExpiration (BRCryptoSigningSession session) {
+    if (0 != session->expiration && (uint64_t) time (NULL) >= session->expiration)
+        cryptoSigningSessionExpireInternal (session);
+}
+
+extern BRCryptoBoolean
+cryptoSigningSessionIsExpired (BRCryptoSigningSession session) {
+    pthread_mutex_lock (&session->lock);
+    cryptoSigningSessionCheckExpiration (session);
+    BRCryptoBoolean expired = AS_CRYPTO_BOOLEAN (NULL == session->seed);
+    pthread_mutex_unlock (&session->lock);
+    return expired;
+}
+
+extern void
+cryptoSigningSessionExpire (BRCryptoSigningSession session) {
+    pthread_mutex_lock (&session->lock);
+    cryptoSigningSessionExpireInternal (session);
+    pthread_mutex_unlock (&session->lock);
+}
+
+private_extern BRCryptoBoolean
+cryptoSigningSessionGetSeed (BRCryptoSigningSession session,
+                             UInt512 *seed) {
+    pthread_mutex_lock (&session->lock);
+    cryptoSigningSessionCheckExpiration (session);
+    BRCryptoBoolean valid = AS_CRYPTO_BOOLEAN (NULL != session->seed);
+    if (CRYPTO_TRUE == valid) *seed = *session->seed;
+    pthread_mutex_unlock (&session->lock);
+    return valid;
+}
+
 // https://en.wikipedia.org/wiki/Fletcher%27s_checksum
 static uint16_t
 checksumFletcher16(const uint8_t *data, size_t count )
@@ -16,6 +16,7 @@
 #include "support/BRBIP32Sequence.h"
 #include "support/BRBIP39Mnemonic.h"
 #include "support/BRKey.h"
+#include "bitcoin/BRWallet.h"
 #include "ethereum/BREthereum.h"
 #include "generic/BRGeneric.h"
 
@@ -25,6 +26,9 @@ extern "C" {
 
 struct BRCryptoAccountRecord {
     BRMasterPubKey btc;
+
+    /// The addresses derived from `btc`, shared by the account's BTC and BCH wallets
+    BRWalletPKHCache *btcPKHCache;
     BREthereumAccount eth;
     BRGenericAccount xrp;
     BRGenericAccount hbar;
@@ -70,6 +74,19 @@ cryptoAccountAddressAsETH (BRCryptoAccount account);
 private_extern BRMasterPubKey
 cryptoAccountAsBTC (BRCryptoAccount account);
 
+private_extern BRWalletPKHCache *
+cryptoAccountAsBTCPKHCache (BRCryptoAccount account);
+
+/**
+ * Copy the session's seed into `seed`, unless the session has expired.  The caller must zero
+ * `seed` once done.
+ *
+ * @return CRYPTO_TRUE if `seed` was filled; CRYPTO_FALSE if expired.
+ */
+private_extern BRCryptoBoolean
+cryptoSigningSessionGetSeed (BRCryptoSigningSession session,
+                             UInt512 *seed);
+
 #ifdef __cplusplus
 }
 #endif
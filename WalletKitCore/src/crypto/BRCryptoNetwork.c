@@ -121,6 +121,32 @@ cryptoNetworkFeeAsGEN( BRCryptoNetworkFee networkFee) {
 
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoNetwork, cryptoNetwork)
 
+// An entry in `currenciesByUids`.  The `uids` must come first: lookups probe the set with the
+// address of a `const char *` and the hash and equal functions read through `const char **`.
+typedef struct {
+    const char *uids;
+    BRCryptoCurrency currency;
+} BRCryptoNetworkCurrencyEntry;
+
+static size_t
+cryptoNetworkCurrencyEntryHash (const void *item) {
+    // FNV-1a
+    size_t hash = (size_t) 0x811C9DC5;
+    for (const char *uids = *(const char **) item; '\0' != *uids; uids++)
+        hash = (hash ^ (size_t) (uint8_t) *uids) * (size_t) 0x01000193;
+    return hash;
+}
+
+static int
+cryptoNetworkCurrencyEntryEqual (const void *item1, const void *item2) {
+    return 0 == strcmp (*(const char **) item1, *(const char **) item2);
+}
+
+static void
+cryptoNetworkCurrencyEntryRelease (void *info, void *item) {
+    free (item);
+}
+
 static BRCryptoNetwork
 cryptoNetworkCreate (const char *uids,
                      const char *name,
@@ -133,6 +159,9 @@ cryptoNetworkCreate (const char *uids,
     network->currency = NULL;
     network->height = 0;
     array_new (network->associations, CRYPTO_NETWORK_DEFAULT_CURRENCY_ASSOCIATIONS);
+    network->currenciesByUids = BRSetNew (cryptoNetworkCurrencyEntryHash,
+                                          cryptoNetworkCurrencyEntryEqual,
+                                          CRYPTO_NETWORK_DEFAULT_CURRENCY_ASSOCIATIONS);
     array_new (network->fees, CRYPTO_NETWORK_DEFAULT_FEES);
 
     network->addressSchemes = NULL;
@@ -209,6 +238,9 @@ cryptoNetworkRelease (BRCryptoNetwork network) {
     }
     array_free (network->associations);
 
+    BRSetApply (network->currenciesByUids, NULL, cryptoNetworkCurrencyEntryRelease);
+    BRSetFree  (network->currenciesByUids);
+
     for (size_t index = 0; index < array_count (network->fees); index++) {
         cryptoNetworkFeeGive (network->fees[index]);
     }
@@ -365,14 +397,9 @@ cryptoNetworkGetCurrencyForCode (BRCryptoNetwork network,
 extern BRCryptoCurrency
 cryptoNetworkGetCurrencyForUids (BRCryptoNetwork network,
                                    const char *uids) {
-    BRCryptoCurrency currency = NULL;
     pthread_mutex_lock (&network->lock);
-    for (size_t index = 0; index < array_count(network->associations); index++) {
-        if (0 == strcmp (uids, cryptoCurrencyGetUids (network->associations[index].currency))) {
-            currency = cryptoCurrencyTake (network->associations[index].currency);
-            break;
-        }
-    }
+    BRCryptoNetworkCurrencyEntry *entry = BRSetGet (network->currenciesByUids, &uids);
+    BRCryptoCurrency currency = (NULL == entry ? NULL : cryptoCurrencyTake (entry->currency));
     pthread_mutex_unlock (&network->lock);
     return currency;
 }
@@ -483,6 +510,15 @@ cryptoNetworkAddCurrency (BRCryptoNetwork network,
     pthread_mutex_lock (&network->lock);
     array_new (association.units, 2);
     array_add (network->associations, association);
+
+    // Index the currency by uids; the first currency added for a uids is the one found.
+    const char *uids = cryptoCurrencyGetUids (currency);
+    if (!BRSetContains (network->currenciesByUids, &uids)) {
+        BRCryptoNetworkCurrencyEntry *entry = malloc (sizeof (BRCryptoNetworkCurrencyEntry));
+        entry->uids     = uids;
+        entry->currency = association.currency;
+        BRSetAdd (network->currenciesByUids, entry);
+    }
     pthread_mutex_unlock (&network->lock);
 }
 
@@ -20,6 +20,7 @@
 #include "bcash/BRBCashParams.h"
 #include "ethereum/BREthereum.h"
 #include "generic/BRGeneric.h"
+#include "support/BRSet.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,7 @@ struct BRCryptoNetworkRecord {
     BRCryptoBlockChainHeight height;
     BRCryptoCurrency currency;
     BRArrayOf(BRCryptoCurrencyAssociation) associations;
+    BRSet *currenciesByUids;    // BRCryptoNetworkCurrencyEntry, for the first currency with a uids
     BRArrayOf(BRCryptoNetworkFee) fees;
     
     uint32_t confirmationsUntilFinal;
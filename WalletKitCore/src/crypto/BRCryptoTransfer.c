@@ -78,14 +78,39 @@ cryptoTransferCreateAsBTC (BRCryptoUnit unit,
                            BRWallet *wid,
                            OwnershipKept BRTransaction *tid,
                            BRCryptoBoolean isBTC) {
-    BRAddressParams  addressParams = BRWalletGetAddressParams (wid);
-    BRCryptoTransfer transfer      = cryptoTransferCreateInternal (BLOCK_CHAIN_TYPE_BTC, unit, unitForFee);
-    transfer->u.btc.tid = tid;
+    BRCryptoTransfer transfer = cryptoTransferCreateInternal (BLOCK_CHAIN_TYPE_BTC, unit, unitForFee);
+    transfer->u.btc.tid   = tid;
+    transfer->u.btc.wid   = wid;
+    transfer->u.btc.isBTC = isBTC;
+
+    // The values that require the wallet are computed on demand; see below.
+    return transfer;
+}
+
+// Compute the values that require the wallet.  The caller must hold `transfer->lock`.
+static void
+cryptoTransferMaterializeAmountsAsBTC (BRCryptoTransfer transfer) {
+    if (transfer->u.btc.hasAmounts) return;
+
+    BRWallet      *wid = transfer->u.btc.wid;
+    BRTransaction *tid = transfer->u.btc.tid;
 
-    // cache the values that require the wallet
     transfer->u.btc.fee  = BRWalletFeeForTx (wid, tid);
     transfer->u.btc.recv = BRWalletAmountReceivedFromTx (wid, tid);
     transfer->u.btc.send = BRWalletAmountSentByTx (wid, tid);
+    transfer->u.btc.hasAmounts = 1;
+}
+
+// Compute the source and target addresses.  The caller must hold `transfer->lock`.
+static void
+cryptoTransferMaterializeAddressesAsBTC (BRCryptoTransfer transfer) {
+    if (transfer->u.btc.hasAddresses) return;
+    cryptoTransferMaterializeAmountsAsBTC (transfer);
+
+    BRWallet        *wid   = transfer->u.btc.wid;
+    BRTransaction   *tid   = transfer->u.btc.tid;
+    BRCryptoBoolean  isBTC = transfer->u.btc.isBTC;
+    BRAddressParams  addressParams = BRWalletGetAddressParams (wid);
 
     BRCryptoTransferDirection direction = cryptoTransferDirectionFromBTC (transfer->u.btc.send,
                                                                           transfer->u.btc.recv,
@@ -144,24 +169,43 @@ cryptoTransferCreateAsBTC (BRCryptoUnit unit,
         }
     }
 
+    transfer->u.btc.hasAddresses = 1;
+}
+
+// Compute the estimated fee basis.  The caller must hold `transfer->lock`.
+static void
+cryptoTransferMaterializeFeeBasisAsBTC (BRCryptoTransfer transfer) {
+    if (NULL != transfer->feeBasisEstimated) return;
+    cryptoTransferMaterializeAmountsAsBTC (transfer);
+
     //
-    // Currently this function, cryptoTransferCreateAsBTC(), is only called in various CWM
-    // event handlers based on BTC events.  Thus for a newly created BTC transfer, the
-    // BRCryptoFeeBasis is long gone.  The best we can do is reconstruct the feeBasis from the
-    // BRTransaction itself.
+    // Currently cryptoTransferCreateAsBTC() is only called in various CWM event handlers based
+    // on BTC events.  Thus for a newly created BTC transfer, the BRCryptoFeeBasis is long gone.
+    // The best we can do is reconstruct the feeBasis from the BRTransaction itself.
     //
     uint64_t fee = transfer->u.btc.fee;
     uint32_t feePerKB = 0;  // assume not our transaction (fee == UINT64_MAX)
-    uint32_t sizeInByte = (uint32_t) BRTransactionVSize (tid);
+    uint32_t sizeInByte = (uint32_t) BRTransactionVSize (transfer->u.btc.tid);
 
     if (UINT64_MAX != fee) {
         // round to nearest satoshi per kb
         feePerKB = (uint32_t) (((1000 * fee) + (sizeInByte/2)) / sizeInByte);
     }
 
-    transfer->feeBasisEstimated = cryptoFeeBasisCreateAsBTC (transfer->unitForFee, feePerKB, sizeInByte);;
+    transfer->feeBasisEstimated = cryptoFeeBasisCreateAsBTC (transfer->unitForFee, feePerKB, sizeInByte);
+}
 
-    return transfer;
+static void
+cryptoTransferGetAmountsAsBTC (BRCryptoTransfer transfer,
+                               uint64_t *fee,
+                               uint64_t *send,
+                               uint64_t *recv) {
+    pthread_mutex_lock (&transfer->lock);
+    cryptoTransferMaterializeAmountsAsBTC (transfer);
+    *fee  = transfer->u.btc.fee;
+    *send = transfer->u.btc.send;
+    *recv = transfer->u.btc.recv;
+    pthread_mutex_unlock (&transfer->lock);
 }
 
 private_extern BRCryptoTransfer
@@ -268,12 +312,20 @@ cryptoTransferGetType (BRCryptoTransfer transfer) {
 
 extern BRCryptoAddress
 cryptoTransferGetSourceAddress (BRCryptoTransfer transfer) {
-    return NULL == transfer->sourceAddress ? NULL : cryptoAddressTake (transfer->sourceAddress);
+    pthread_mutex_lock (&transfer->lock);
+    if (BLOCK_CHAIN_TYPE_BTC == transfer->type) cryptoTransferMaterializeAddressesAsBTC (transfer);
+    BRCryptoAddress address = (NULL == transfer->sourceAddress ? NULL : cryptoAddressTake (transfer->sourceAddress));
+    pthread_mutex_unlock (&transfer->lock);
+    return address;
 }
 
 extern BRCryptoAddress
 cryptoTransferGetTargetAddress (BRCryptoTransfer transfer) {
-    return NULL == transfer->targetAddress ? NULL : cryptoAddressTake (transfer->targetAddress);
+    pthread_mutex_lock (&transfer->lock);
+    if (BLOCK_CHAIN_TYPE_BTC == transfer->type) cryptoTransferMaterializeAddressesAsBTC (transfer);
+    BRCryptoAddress address = (NULL == transfer->targetAddress ? NULL : cryptoAddressTake (transfer->targetAddress));
+    pthread_mutex_unlock (&transfer->lock);
+    return address;
 }
 
 static BRCryptoAmount
@@ -282,12 +334,10 @@ cryptoTransferGetAmountAsSign (BRCryptoTransfer transfer, BRCryptoBoolean isNega
 
     switch (transfer->type) {
         case BLOCK_CHAIN_TYPE_BTC: {
-            uint64_t fee = transfer->u.btc.fee;
+            uint64_t fee, send, recv;
+            cryptoTransferGetAmountsAsBTC (transfer, &fee, &send, &recv);
             if (UINT64_MAX == fee) fee = 0;
 
-            uint64_t recv = transfer->u.btc.recv;
-            uint64_t send = transfer->u.btc.send;
-
             switch (cryptoTransferGetDirection(transfer)) {
                 case CRYPTO_TRANSFER_RECOVERED:
                     amount = cryptoAmountCreate (transfer->unit,
@@ -390,9 +440,7 @@ cryptoTransferGetAmountDirectedNet (BRCryptoTransfer transfer) {
 
     BRCryptoFeeBasis feeBasis = cryptoTransferGetConfirmedFeeBasis(transfer);
     if (NULL == feeBasis)
-        feeBasis = (NULL == transfer->feeBasisEstimated
-                    ? NULL
-                    : cryptoFeeBasisTake (transfer->feeBasisEstimated));
+        feeBasis = cryptoTransferGetEstimatedFeeBasis (transfer);
 
     // If there is no fee basis, then there is no fee
     if (NULL == feeBasis)
@@ -529,7 +577,33 @@ cryptoTransferGetState (BRCryptoTransfer transfer) {
     return state;
 }
 
-private_extern void
+private_extern BRCryptoBoolean
+cryptoTransferGetIncludedPosition (BRCryptoTransfer transfer,
+                                   uint64_t *blockNumber,
+                                   uint64_t *transactionIndex) {
+    pthread_mutex_lock (&transfer->lock);
+    BRCryptoBoolean included = AS_CRYPTO_BOOLEAN (CRYPTO_TRANSFER_STATE_INCLUDED == transfer->state.type);
+    if (CRYPTO_TRUE == included) {
+        *blockNumber      = transfer->state.u.included.blockNumber;
+        *transactionIndex = transfer->state.u.included.transactionIndex;
+    }
+    pthread_mutex_unlock (&transfer->lock);
+
+    return included;
+}
+
+static int
+cryptoTransferStatePositionEqual (const BRCryptoTransferState *s1,
+                                  const BRCryptoTransferState *s2) {
+    int included1 = CRYPTO_TRANSFER_STATE_INCLUDED == s1->type;
+    int included2 = CRYPTO_TRANSFER_STATE_INCLUDED == s2->type;
+
+    return (included1 == included2 &&
+            (!included1 || (s1->u.included.blockNumber      == s2->u.included.blockNumber &&
+                            s1->u.included.transactionIndex == s2->u.included.transactionIndex)));
+}
+
+private_extern BRCryptoBoolean
 cryptoTransferSetState (BRCryptoTransfer transfer,
                         BRCryptoTransferState state) {
     BRCryptoTransferState newState = cryptoTransferStateCopy (&state);
@@ -537,9 +611,11 @@ cryptoTransferSetState (BRCryptoTransfer transfer,
     pthread_mutex_lock (&transfer->lock);
     BRCryptoTransferState oldState = transfer->state;
     transfer->state = newState;
+    BRCryptoBoolean positionChanged = AS_CRYPTO_BOOLEAN (!cryptoTransferStatePositionEqual (&oldState, &newState));
     pthread_mutex_unlock (&transfer->lock);
 
     cryptoTransferStateRelease (&oldState);
+    return positionChanged;
 }
 
 static BRCryptoTransferDirection
@@ -558,10 +634,11 @@ cryptoTransferDirectionFromBTC (uint64_t send, uint64_t recv, uint64_t fee) {
 extern BRCryptoTransferDirection
 cryptoTransferGetDirection (BRCryptoTransfer transfer) {
     switch (transfer->type) {
-        case BLOCK_CHAIN_TYPE_BTC:
-            return cryptoTransferDirectionFromBTC (transfer->u.btc.send,
-                                                   transfer->u.btc.recv,
-                                                   transfer->u.btc.fee);
+        case BLOCK_CHAIN_TYPE_BTC: {
+            uint64_t fee, send, recv;
+            cryptoTransferGetAmountsAsBTC (transfer, &fee, &send, &recv);
+            return cryptoTransferDirectionFromBTC (send, recv, fee);
+        }
 
         case BLOCK_CHAIN_TYPE_ETH: {
             BREthereumEWM      ewm = transfer->u.eth.ewm;
@@ -674,7 +751,11 @@ cryptoTransferGetEstimatedFeeBasis (BRCryptoTransfer transfer) {
 
 extern BRCryptoFeeBasis
 cryptoTransferGetEstimatedFeeBasis (BRCryptoTransfer transfer) {
-    return (NULL == transfer->feeBasisEstimated ? NULL : cryptoFeeBasisTake (transfer->feeBasisEstimated));
+    pthread_mutex_lock (&transfer->lock);
+    if (BLOCK_CHAIN_TYPE_BTC == transfer->type) cryptoTransferMaterializeFeeBasisAsBTC (transfer);
+    BRCryptoFeeBasis feeBasis = (NULL == transfer->feeBasisEstimated ? NULL : cryptoFeeBasisTake (transfer->feeBasisEstimated));
+    pthread_mutex_unlock (&transfer->lock);
+    return feeBasis;
 }
 
 extern BRCryptoFeeBasis
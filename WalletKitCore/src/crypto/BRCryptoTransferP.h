@@ -40,6 +40,14 @@ struct BRCryptoTransferRecord {
     union {
         struct {
             BRTransaction *tid;
+            BRWallet *wid;
+            BRCryptoBoolean isBTC;
+
+            /// The values that require the wallet are computed on first use, not on creation;
+            /// a wallet loads many more transfers than are ever shown.  The `sourceAddress`,
+            /// `targetAddress` and `feeBasisEstimated` are likewise filled in on first use.
+            int hasAmounts;
+            int hasAddresses;
             uint64_t fee;
             uint64_t send;
             uint64_t recv;
@@ -78,10 +86,19 @@ struct BRCryptoTransferRecord {
 private_extern BRCryptoBlockChainType
 cryptoTransferGetType (BRCryptoTransfer transfer);
 
-private_extern void
+/// Set the state, returning TRUE if the included position changed.  A transfer held by a wallet
+/// has its state set with `cryptoWalletSetTransferState()`, so that the wallet's order follows.
+private_extern BRCryptoBoolean
 cryptoTransferSetState (BRCryptoTransfer transfer,
                         BRCryptoTransferState state);
 
+/// If `transfer` is included, fill in its block number and transaction index and return TRUE.
+/// Unlike `cryptoTransferGetState()` this does not copy the state.
+private_extern BRCryptoBoolean
+cryptoTransferGetIncludedPosition (BRCryptoTransfer transfer,
+                                   uint64_t *blockNumber,
+                                   uint64_t *transactionIndex);
+
 private_extern BRCryptoTransfer
 cryptoTransferCreateAsBTC (BRCryptoUnit unit,
                            BRCryptoUnit unitForFee,
@@ -34,6 +34,8 @@ cryptoWalletCreateInternal (BRCryptoBlockChainType type,
     wallet->unit  = cryptoUnitTake (unit);
     wallet->unitForFee = cryptoUnitTake (unitForFee);
     array_new (wallet->transfers, 5);
+    array_new (wallet->transfersOrdered, 5);
+    wallet->transfersOrderDirty = 1;
 
     wallet->ref = CRYPTO_REF_ASSIGN (cryptoWalletRelease);
 
@@ -94,6 +96,7 @@ cryptoWalletRelease (BRCryptoWallet wallet) {
     for (size_t index = 0; index < array_count(wallet->transfers); index++)
         cryptoTransferGive (wallet->transfers[index]);
     array_free (wallet->transfers);
+    array_free (wallet->transfersOrdered);
 
     switch (wallet->type) {
         case BLOCK_CHAIN_TYPE_BTC:
@@ -278,6 +281,7 @@ cryptoWalletAddTransfer (BRCryptoWallet wallet,
     pthread_mutex_lock (&wallet->lock);
     if (CRYPTO_FALSE == cryptoWalletHasTransfer (wallet, transfer)) {
         array_add (wallet->transfers, cryptoTransferTake(transfer));
+        wallet->transfersOrderDirty = 1;
     }
     pthread_mutex_unlock (&wallet->lock);
 }
@@ -290,6 +294,7 @@ cryptoWalletRemTransfer (BRCryptoWallet wallet, BRCryptoTransfer transfer) {
         if (CRYPTO_TRUE == cryptoTransferEqual (wallet->transfers[index], transfer)) {
             walletTransfer = wallet->transfers[index];
             array_rm (wallet->transfers, index);
+            wallet->transfersOrderDirty = 1;
             break;
         }
     }
@@ -314,6 +319,105 @@ cryptoWalletGetTransfers (BRCryptoWallet wallet, size_t *count) {
     return transfers;
 }
 
+extern size_t
+cryptoWalletGetTransferCount (BRCryptoWallet wallet) {
+    pthread_mutex_lock (&wallet->lock);
+    size_t count = array_count (wallet->transfers);
+    pthread_mutex_unlock (&wallet->lock);
+    return count;
+}
+
+extern BRCryptoWalletTransferCursor
+cryptoWalletTransferCursorInit (void) {
+    // No transfer has a zero identity; all order after this.
+    return (BRCryptoWalletTransferCursor) { 0, 0, 0 };
+}
+
+static BRCryptoWalletTransferCursor
+cryptoWalletTransferCursorForTransfer (BRCryptoTransfer transfer) {
+    BRCryptoWalletTransferCursor cursor = { UINT64_MAX, UINT64_MAX, (uintptr_t) transfer };
+    cryptoTransferGetIncludedPosition (transfer, &cursor.blockNumber, &cursor.transactionIndex);
+    return cursor;
+}
+
+static int
+cryptoWalletTransferCursorCompare (const BRCryptoWalletTransferCursor *c1,
+                                   const BRCryptoWalletTransferCursor *c2) {
+    if (c1->blockNumber      != c2->blockNumber)      return c1->blockNumber      < c2->blockNumber      ? -1 : 1;
+    if (c1->transactionIndex != c2->transactionIndex) return c1->transactionIndex < c2->transactionIndex ? -1 : 1;
+    if (c1->identity         != c2->identity)         return c1->identity         < c2->identity         ? -1 : 1;
+    return 0;
+}
+
+static int
+cryptoWalletTransferCompareForSort (const void *t1, const void *t2) {
+    return cryptoWalletTransferCursorCompare (&((const BRCryptoWalletTransferOrdered *) t1)->cursor,
+                                              &((const BRCryptoWalletTransferOrdered *) t2)->cursor);
+}
+
+private_extern void
+cryptoWalletSetTransferState (BRCryptoWallet wallet,
+                              BRCryptoTransfer transfer,
+                              BRCryptoTransferState state) {
+    if (CRYPTO_TRUE == cryptoTransferSetState (transfer, state)) {
+        pthread_mutex_lock (&wallet->lock);
+        wallet->transfersOrderDirty = 1;
+        pthread_mutex_unlock (&wallet->lock);
+    }
+}
+
+///
+/// Rebuild `wallet->transfersOrdered` if one of the wallet's transfers was added, removed or
+/// changed its included position since it was last built.  Otherwise, paging costs only the
+/// binary search; neither the transfers nor their locks are visited.
+///
+static void
+cryptoWalletOrderTransfers (BRCryptoWallet wallet) {
+    if (!wallet->transfersOrderDirty) return;
+
+    size_t count = array_count (wallet->transfers);
+    array_clear (wallet->transfersOrdered);
+    for (size_t index = 0; index < count; index++) {
+        BRCryptoWalletTransferOrdered ordered = {
+            cryptoWalletTransferCursorForTransfer (wallet->transfers[index]),
+            wallet->transfers[index]
+        };
+        array_add (wallet->transfersOrdered, ordered);
+    }
+    qsort (wallet->transfersOrdered, count, sizeof (BRCryptoWalletTransferOrdered), cryptoWalletTransferCompareForSort);
+
+    wallet->transfersOrderDirty = 0;
+}
+
+extern size_t
+cryptoWalletGetTransfersPage (BRCryptoWallet wallet,
+                              BRCryptoWalletTransferCursor *cursor,
+                              BRCryptoTransfer *transfers,
+                              size_t transfersCount) {
+    size_t filled = 0;
+
+    pthread_mutex_lock (&wallet->lock);
+    cryptoWalletOrderTransfers (wallet);
+
+    // Binary search for the first transfer following `cursor`
+    size_t count = array_count (wallet->transfersOrdered);
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cryptoWalletTransferCursorCompare (&wallet->transfersOrdered[mid].cursor, cursor) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    for (size_t index = lo; index < count && filled < transfersCount; index++)
+        transfers[filled++] = cryptoTransferTake (wallet->transfersOrdered[index].transfer);
+
+    if (filled > 0)
+        *cursor = wallet->transfersOrdered[lo + filled - 1].cursor;
+    pthread_mutex_unlock (&wallet->lock);
+
+    return filled;
+}
+
 extern BRCryptoAddress
 cryptoWalletGetAddress (BRCryptoWallet wallet,
                         BRCryptoAddressScheme addressScheme) {
@@ -9,6 +9,7 @@
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
 #include <assert.h>
+#include <sys/time.h>       // gettimeofday()
 #include <arpa/inet.h>      // struct in_addr
 
 #include "BRCryptoBase.h"
@@ -30,6 +31,7 @@
 #include "bitcoin/BRWalletManager.h"
 #include "ethereum/BREthereum.h"
 #include "support/BRFileService.h"
+#include "support/BRCrypto.h"
 
 uint64_t BLOCK_HEIGHT_UNBOUND_VALUE = UINT64_MAX;
 
@@ -43,6 +45,15 @@ cryptoWalletManagerSyncCallbackGEN (BRGenericManagerSyncContext context,
                                     uint64_t endBlockHeight,
                                     uint64_t fullSyncIncrement);
 
+static void
+cryptoListenerQueueInit (BRCryptoCWMListenerQueue *queue);
+
+static void
+cryptoListenerQueueRelease (BRCryptoCWMListenerQueue *queue);
+
+static void
+cryptoListenerThreadStop (BRCryptoWalletManager cwm);
+
 IMPLEMENT_CRYPTO_GIVE_TAKE (BRCryptoWalletManager, cryptoWalletManager)
 
 /// =============================================================================================
@@ -110,6 +121,7 @@ cryptoWalletManagerCreateInternal (BRCryptoCWMListener listener,
 
     cwm->type = type;
     cwm->listener = listener;
+    cryptoListenerQueueInit (&cwm->listenerQueue);
     cwm->client  = client;
     cwm->network = cryptoNetworkTake (network);
     cwm->account = cryptoAccountTake (account);
@@ -120,6 +132,8 @@ cryptoWalletManagerCreateInternal (BRCryptoCWMListener listener,
     cwm->wallet = NULL;
     array_new (cwm->wallets, 1);
 
+    cwm->metrics = BRMetricsNew();
+
     cwm->ref = CRYPTO_REF_ASSIGN (cryptoWalletManagerRelease);
 
     {
@@ -169,6 +183,15 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
     // `1 == error`, perform some cleanup actions.
     int error = 0;
 
+    // Record the creation phases, including those deep in BWM, EWM and GWM, on this thread.
+#if !defined (BR_PROFILE_DISABLED)
+    BRProfile profile = BRProfileNew();
+    BRProfile profilePrevious = BRProfileSetCurrent (profile);
+#else
+    BRProfile profile = NULL;
+#endif
+    BRProfileSpan profileSpan = BR_PROFILE_BEGIN ("cryptoWalletManagerCreate");
+
     // TODO: extend path... with network-type : network-name - or is that done by ewmCreate(), ...
     char *cwmPath = strdup (path);
 
@@ -179,6 +202,7 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
                                                                      network,
                                                                      scheme,
                                                                      cwmPath);
+    cwm->startupProfile = profile;
 
     // Primary wallet currency and unit.
     BRCryptoCurrency currency = cryptoNetworkGetCurrency (cwm->network);
@@ -189,6 +213,7 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
             BRWalletManagerClient client = cryptoWalletManagerClientCreateBTCClient (cwm);
 
             // Create BWM - will also create the BWM primary wallet....
+            BRProfileSpan span = BR_PROFILE_BEGIN ("BRWalletManagerNew");
             cwm->u.btc = BRWalletManagerNew (client,
                                              cryptoAccountAsBTC (account),
                                              cryptoNetworkAsBTC (network),
@@ -196,7 +221,9 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
                                              mode,
                                              cwmPath,
                                              cryptoNetworkGetHeight(network),
-                                             cryptoNetworkGetConfirmationsUntilFinal (network));
+                                             cryptoNetworkGetConfirmationsUntilFinal (network),
+                                             cryptoAccountAsBTCPKHCache (account));
+            BR_PROFILE_END (span);
             if (NULL == cwm->u.btc) { error = 1; break ; }
 
             // ... get the CWM primary wallet in place...
@@ -205,8 +232,13 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
             // ... add the CWM primary wallet to CWM
             cryptoWalletManagerAddWallet (cwm, cwm->wallet);
 
+            // ... record metrics...
+            BRWalletManagerSetMetrics (cwm->u.btc, cwm->metrics);
+
             // ... and finally start the BWM event handling (with CWM fully in place).
+            span = BR_PROFILE_BEGIN ("BRWalletManagerStart");
             BRWalletManagerStart (cwm->u.btc);
+            BR_PROFILE_END (span);
 
             break;
         }
@@ -215,6 +247,7 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
             BREthereumClient client = cryptoWalletManagerClientCreateETHClient (cwm);
 
             // Create EWM - will also create the EWM primary wallet....
+            BRProfileSpan span = BR_PROFILE_BEGIN ("ewmCreate");
             cwm->u.eth = ewmCreate (cryptoNetworkAsETH(network),
                                     cryptoAccountAsETH(account),
                                     (BREthereumTimestamp) cryptoAccountGetTimestamp(account),
@@ -223,6 +256,7 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
                                     cwmPath,
                                     cryptoNetworkGetHeight(network),
                                     cryptoNetworkGetConfirmationsUntilFinal (network));
+            BR_PROFILE_END (span);
             if (NULL == cwm->u.eth) { error = 1; break; }
 
             // ... get the CWM primary wallet in place...
@@ -231,12 +265,19 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
             // ... add the CWM primary wallet to CWM
             cryptoWalletManagerAddWallet (cwm, cwm->wallet);
 
+            // ... record metrics...
+            ewmSetMetrics (cwm->u.eth, cwm->metrics);
+
             // ... and finally start the EWM event handling (with CWM fully in place).
+            span = BR_PROFILE_BEGIN ("ewmStart");
             ewmStart (cwm->u.eth);
+            BR_PROFILE_END (span);
 
             // This will install ERC20 Tokens for the CWM Currencies.  Corresponding Wallets are
             // not created for these currencies.
+            span = BR_PROFILE_BEGIN ("installTokens");
             cryptoWalletManagerInstallETHTokensForCurrencies(cwm);
+            BR_PROFILE_END (span);
 
             // We finish here with possibly EWM events in the EWM handler queue and/or with
             // CWM events in the CWM handler queue.
@@ -253,6 +294,7 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
             // Create CWM as 'GEN' based on the network's base currency.
             BRCryptoNetworkCanonicalType type = cryptoNetworkGetCanonicalType (network);
 
+            BRProfileSpan span = BR_PROFILE_BEGIN ("genManagerCreate");
             cwm->u.gen = genManagerCreate (client,
                                            type,
                                            cryptoNetworkAsGEN (network),
@@ -263,11 +305,14 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
                                            cwm,
                                            cryptoWalletManagerSyncCallbackGEN,
                                            cryptoNetworkGetHeight(network));
+            BR_PROFILE_END (span);
             if (NULL == cwm->u.gen) {
                 pthread_mutex_unlock (&cwm->lock);
                 error = 1;
                 break; }
 
+            genManagerSetMetrics (cwm->u.gen, cwm->metrics);
+
             // ... and create the primary wallet
             cwm->wallet = cryptoWalletCreateAsGEN (unit, unit, genManagerGetPrimaryWallet (cwm->u.gen));
 
@@ -277,53 +322,63 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
             pthread_mutex_unlock (&cwm->lock);
 
             // Announce the new wallet manager;
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_CREATED
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_CREATED
+                                                           });
 
             // ... and announce the created wallet.
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (cwm->wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_CREATED
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (cwm->wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_CREATED
+                                                    });
 
             // ... and announce the manager's new wallet.
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
-                                                          { .wallet = { cryptoWalletTake (cwm->wallet) }}
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                                                               { .wallet = { cryptoWalletTake (cwm->wallet) }}
+                                                           });
             pthread_mutex_lock (&cwm->lock);
 
             // Load transfers from persistent storage
+            span = BR_PROFILE_BEGIN ("genManagerLoadTransfers");
             BRArrayOf(BRGenericTransfer) transfers = genManagerLoadTransfers (cwm->u.gen);
+            BR_PROFILE_END (span);
+
+            span = BR_PROFILE_BEGIN ("handleTransfers");
             for (size_t index = 0; index < array_count (transfers); index++) {
                 // TODO: A BRGenericTransfer must allow us to determine the Wallet (via a Currency).
                 cryptoWalletManagerHandleTransferGEN (cwm, transfers[index]);
             }
             array_free (transfers);
+            BR_PROFILE_END (span);
 
             // Having added the transfers, get the wallet balance...
             BRCryptoAmount balance = cryptoWalletGetBalance (cwm->wallet);
             pthread_mutex_unlock (&cwm->lock);
 
             // ... and announce the balance
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (cwm->wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
-                                                   { .balanceUpdated = { balance }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (cwm->wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                                        { .balanceUpdated = { balance }}
+                                                    });
             break;
         }
     }
 
+    BR_PROFILE_END (profileSpan);
+#if !defined (BR_PROFILE_DISABLED)
+    BRProfileSetCurrent (profilePrevious);
+#endif
+
     if (error) {
         cryptoWalletManagerGive (cwm);
         cwm = NULL;
@@ -337,6 +392,121 @@ cryptoWalletManagerCreate (BRCryptoCWMListener listener,
     return cwm;
 }
 
+// MARK: - Create Multiple
+
+typedef struct {
+    BRCryptoCWMListener listener;
+    BRCryptoClient client;
+    BRCryptoAccount account;
+    BRCryptoNetwork *networks;
+    const BRCryptoSyncMode *modes;
+    const BRCryptoAddressScheme *schemes;
+    size_t networksCount;
+    const char *path;
+    BRCryptoWalletManagerCreatedCallback callback;
+    BRCryptoWalletManager *managers;
+
+    pthread_mutex_t lock;
+    size_t next;       // the index of the next network to create, guarded by `lock`
+    size_t created;    // the number of managers created, guarded by `lock`
+} BRCryptoWalletManagerCreateMultipleContext;
+
+static void *
+cryptoWalletManagerCreateMultipleThread (void *data) {
+    BRCryptoWalletManagerCreateMultipleContext *context = data;
+
+    while (1) {
+        pthread_mutex_lock (&context->lock);
+        size_t index = context->next++;
+        pthread_mutex_unlock (&context->lock);
+
+        if (index >= context->networksCount) break;
+
+        BRCryptoWalletManager cwm = cryptoWalletManagerCreate (context->listener,
+                                                               context->client,
+                                                               context->account,
+                                                               context->networks[index],
+                                                               context->modes[index],
+                                                               context->schemes[index],
+                                                               context->path);
+        context->managers[index] = cwm;
+
+        if (NULL != cwm) {
+            pthread_mutex_lock (&context->lock);
+            context->created += 1;
+            pthread_mutex_unlock (&context->lock);
+        }
+
+        if (NULL != context->callback)
+            context->callback (context->listener.context,
+                               index,
+                               context->networks[index],
+                               (NULL == cwm ? NULL : cryptoWalletManagerTake (cwm)));
+    }
+
+    return NULL;
+}
+
+extern size_t
+cryptoWalletManagerCreateMultiple (BRCryptoCWMListener listener,
+                                   BRCryptoClient client,
+                                   BRCryptoAccount account,
+                                   BRCryptoNetwork *networks,
+                                   const BRCryptoSyncMode *modes,
+                                   const BRCryptoAddressScheme *schemes,
+                                   size_t networksCount,
+                                   const char *path,
+                                   size_t threadsCount,
+                                   BRCryptoWalletManagerCreatedCallback callback,
+                                   BRCryptoWalletManager *managers) {
+    if (0 == networksCount) return 0;
+    assert (NULL != networks && NULL != modes && NULL != schemes && NULL != managers);
+
+    // Install the account's static state before any worker might need it.
+    cryptoAccountInstall();
+
+    if (0 == threadsCount || threadsCount > networksCount)
+        threadsCount = networksCount;
+
+    BRCryptoWalletManagerCreateMultipleContext context = {
+        listener,
+        client,
+        account,
+        networks,
+        modes,
+        schemes,
+        networksCount,
+        path,
+        callback,
+        managers,
+    };
+    context.next    = 0;
+    context.created = 0;
+    pthread_mutex_init (&context.lock, NULL);
+
+    // The calling thread is one of the workers.
+    pthread_t *threads = calloc (threadsCount, sizeof (pthread_t));
+    size_t threadsStarted = 0;
+
+    pthread_attr_t attr;
+    pthread_attr_init (&attr);
+    pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+    pthread_attr_setstacksize (&attr, 1024 * 1024);
+    for (size_t index = 1; index < threadsCount; index++)
+        if (0 == pthread_create (&threads[threadsStarted], &attr, cryptoWalletManagerCreateMultipleThread, &context))
+            threadsStarted += 1;
+    pthread_attr_destroy (&attr);
+
+    cryptoWalletManagerCreateMultipleThread (&context);
+
+    for (size_t index = 0; index < threadsStarted; index++)
+        pthread_join (threads[index], NULL);
+    free (threads);
+
+    pthread_mutex_destroy (&context.lock);
+    return context.created;
+}
+
 static void
 cryptoWalletManagerRelease (BRCryptoWalletManager cwm) {
     // Ensure CWM is stopped...
@@ -351,6 +521,8 @@ cryptoWalletManagerRelease (BRCryptoWalletManager cwm) {
         cryptoWalletGive (cwm->wallets[index]);
     array_free (cwm->wallets);
 
+    BRProfileFree (cwm->startupProfile);
+
     // Release the specific cwm type, if it exists.
     switch (cwm->type) {
         case BLOCK_CHAIN_TYPE_BTC:
@@ -367,8 +539,15 @@ cryptoWalletManagerRelease (BRCryptoWalletManager cwm) {
             break;
     }
 
+    // With the subsystems gone, nothing updates the metrics.
+    BRMetricsFree (cwm->metrics);
+
     free (cwm->path);
 
+    // Queued events hold `cwm`; none remain.
+    cryptoListenerThreadStop (cwm);
+    cryptoListenerQueueRelease (&cwm->listenerQueue);
+
     pthread_mutex_destroy (&cwm->lock);
 
     memset (cwm, 0, sizeof(*cwm));
@@ -475,6 +654,66 @@ cryptoWalletManagerGetPath (BRCryptoWalletManager cwm) {
     return cwm->path;
 }
 
+extern size_t
+cryptoWalletManagerGetStartupPhases (BRCryptoWalletManager cwm,
+                                     BRCryptoWalletManagerPhase *phases,
+                                     size_t phasesCount) {
+    size_t count = (NULL == cwm->startupProfile ? 0 : BRProfileGetPhaseCount (cwm->startupProfile));
+    if (NULL == phases) return count;
+
+    if (phasesCount > count) phasesCount = count;
+    for (size_t index = 0; index < phasesCount; index++) {
+        BRProfilePhase phase = BRProfileGetPhase (cwm->startupProfile, index);
+        phases[index] = (BRCryptoWalletManagerPhase) {
+            phase.name,
+            phase.depth,
+            phase.start,
+            phase.duration
+        };
+    }
+    return phasesCount;
+}
+
+extern size_t
+cryptoWalletManagerGetMetricCounters (BRCryptoWalletManager cwm,
+                                      BRCryptoWalletManagerCounter *counters,
+                                      size_t countersCount) {
+    if (NULL == counters) return BRMetricsGetCounterSnapshots (cwm->metrics, NULL, 0);
+
+    BRMetricsCounterSnapshot *snapshots = calloc (countersCount, sizeof (BRMetricsCounterSnapshot));
+    countersCount = BRMetricsGetCounterSnapshots (cwm->metrics, snapshots, countersCount);
+
+    for (size_t index = 0; index < countersCount; index++)
+        counters[index] = (BRCryptoWalletManagerCounter) {
+            snapshots[index].name,
+            snapshots[index].value
+        };
+
+    free (snapshots);
+    return countersCount;
+}
+
+extern size_t
+cryptoWalletManagerGetMetricHistograms (BRCryptoWalletManager cwm,
+                                        BRCryptoWalletManagerHistogram *histograms,
+                                        size_t histogramsCount) {
+    assert (CRYPTO_WALLET_MANAGER_HISTOGRAM_BUCKETS == BR_METRICS_HISTOGRAM_BUCKETS);
+    if (NULL == histograms) return BRMetricsGetHistogramSnapshots (cwm->metrics, NULL, 0);
+
+    BRMetricsHistogramSnapshot *snapshots = calloc (histogramsCount, sizeof (BRMetricsHistogramSnapshot));
+    histogramsCount = BRMetricsGetHistogramSnapshots (cwm->metrics, snapshots, histogramsCount);
+
+    for (size_t index = 0; index < histogramsCount; index++) {
+        histograms[index].name  = snapshots[index].name;
+        histograms[index].count = snapshots[index].count;
+        histograms[index].sum   = snapshots[index].sum;
+        memcpy (histograms[index].buckets, snapshots[index].buckets, sizeof (histograms[index].buckets));
+    }
+
+    free (snapshots);
+    return histogramsCount;
+}
+
 extern void
 cryptoWalletManagerSetNetworkReachable (BRCryptoWalletManager cwm,
                                         BRCryptoBoolean isNetworkReachable) {
@@ -693,12 +932,12 @@ cryptoWalletManagerConnect (BRCryptoWalletManager cwm,
                 cryptoWalletManagerSetState (cwm, newState);
                 pthread_mutex_unlock (&cwm->lock);
 
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake (cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                    CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
-                    { .state = { oldState, newState }}
-                });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake (cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                         CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                         { .state = { oldState, newState }}
+                     });
             }
             else pthread_mutex_unlock (&cwm->lock);
             break;
@@ -725,12 +964,12 @@ cryptoWalletManagerDisconnect (BRCryptoWalletManager cwm) {
                 cryptoWalletManagerSetState (cwm, newState);
                 pthread_mutex_unlock (&cwm->lock);
 
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake (cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                    CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
-                    { .state = { oldState, newState }}
-                });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake (cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                         CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                         { .state = { oldState, newState }}
+                     });
             }
             else pthread_mutex_unlock (&cwm->lock);
             break;
@@ -812,20 +1051,20 @@ cryptoWalletManagerSetTransferStateGEN (BRCryptoWalletManager cwm,
                                                                        cryptoTransferGetUnitForFee(transfer));
 
         pthread_mutex_unlock (&cwm->lock);
-        cwm->listener.transferEventCallback (cwm->listener.context,
-                                             cryptoWalletManagerTake (cwm),
-                                             cryptoWalletTake (wallet),
-                                             cryptoTransferTake(transfer),
-                                             (BRCryptoTransferEvent) {
-            CRYPTO_TRANSFER_EVENT_CHANGED,
-            { .state = {
-                cryptoTransferStateCopy (&oldState),
-                cryptoTransferStateCopy (&newState) }}
-        });
+        cryptoWalletManagerListenerTransferEvent (cwm,
+                                                  cryptoWalletManagerTake (cwm),
+                                                  cryptoWalletTake (wallet),
+                                                  cryptoTransferTake(transfer),
+                                                  (BRCryptoTransferEvent) {
+                 CRYPTO_TRANSFER_EVENT_CHANGED,
+                 { .state = {
+                     cryptoTransferStateCopy (&oldState),
+                     cryptoTransferStateCopy (&newState) }}
+             });
         pthread_mutex_lock (&cwm->lock);
 
         genTransferSetState (genericTransfer, newGenericState);
-        cryptoTransferSetState (transfer, newState);
+        cryptoWalletSetTransferState (wallet, transfer, newState);
 
         cryptoTransferStateRelease (&oldState);
         cryptoTransferStateRelease (&newState);
@@ -841,20 +1080,20 @@ cryptoWalletManagerSetTransferStateGEN (BRCryptoWalletManager cwm,
         genWalletRemTransfer(cryptoWalletAsGEN(wallet), genericTransfer);
 
         BRCryptoAmount balance = cryptoWalletGetBalance(wallet);
-        cwm->listener.walletEventCallback (cwm->listener.context,
-                                           cryptoWalletManagerTake (cwm),
-                                           cryptoWalletTake (cwm->wallet),
-                                           (BRCryptoWalletEvent) {
-                                               CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
-                                               { .balanceUpdated = { balance }}
-                                           });
-
-        cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                  cryptoWalletManagerTake (cwm),
-                                                  (BRCryptoWalletManagerEvent) {
-            CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
-            { .wallet = cryptoWalletTake (cwm->wallet) }
-        });
+        cryptoWalletManagerListenerWalletEvent (cwm,
+                                                cryptoWalletManagerTake (cwm),
+                                                cryptoWalletTake (cwm->wallet),
+                                                (BRCryptoWalletEvent) {
+                                                    CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                                    { .balanceUpdated = { balance }}
+                                                });
+
+        cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                       cryptoWalletManagerTake (cwm),
+                                                       (BRCryptoWalletManagerEvent) {
+                 CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
+                 { .wallet = cryptoWalletTake (cwm->wallet) }
+             });
     }
 
     pthread_mutex_unlock (&cwm->lock);
@@ -874,13 +1113,13 @@ cryptoWalletManagerCreateTransferMultiple (BRCryptoWalletManager cwm,
             break;
         case BLOCK_CHAIN_TYPE_GEN:
             if (NULL != transfer) {
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake(transfer),
-                                                     (BRCryptoTransferEvent) {
-                    CRYPTO_TRANSFER_EVENT_CREATED
-                });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake(transfer),
+                                                          (BRCryptoTransferEvent) {
+                         CRYPTO_TRANSFER_EVENT_CREATED
+                     });
             }
             break;
     }
@@ -906,29 +1145,27 @@ cryptoWalletManagerCreateTransfer (BRCryptoWalletManager cwm,
             break;
         case BLOCK_CHAIN_TYPE_GEN:
             if (NULL != transfer) {
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake(transfer),
-                                                     (BRCryptoTransferEvent) {
-                    CRYPTO_TRANSFER_EVENT_CREATED
-                });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake(transfer),
+                                                          (BRCryptoTransferEvent) {
+                         CRYPTO_TRANSFER_EVENT_CREATED
+                     });
             }
             break;
     }
     return transfer;
 }
 
-extern BRCryptoBoolean
-cryptoWalletManagerSign (BRCryptoWalletManager cwm,
-                         BRCryptoWallet wallet,
-                         BRCryptoTransfer transfer,
-                         const char *paperKey) {
+// Sign `transfer` with `seed`; for GEN, also mark the transfer as signed.
+static BRCryptoBoolean
+cryptoWalletManagerSignWithSeed (BRCryptoWalletManager cwm,
+                                 BRCryptoWallet wallet,
+                                 BRCryptoTransfer transfer,
+                                 UInt512 seed) {
     BRCryptoBoolean success = CRYPTO_FALSE;
 
-    // Derived the seed used for signing.
-    UInt512 seed = cryptoAccountDeriveSeed(paperKey);
-
     switch (cwm->type) {
         case BLOCK_CHAIN_TYPE_BTC: {
             success = AS_CRYPTO_BOOLEAN (BRWalletManagerSignTransaction (cwm->u.btc,
@@ -939,9 +1176,21 @@ cryptoWalletManagerSign (BRCryptoWalletManager cwm,
             break;
         }
 
-        case BLOCK_CHAIN_TYPE_ETH:
-            // TODO(fix): ewmWalletSignTransferWithPaperKey() doesn't return a status
+        case BLOCK_CHAIN_TYPE_ETH: {
+            // ewmWalletSignTransfer() doesn't return a status; the transfer's transaction does
+            BREthereumAccount account = ewmGetAccount (cwm->u.eth);
+            BRKey key = derivePrivateKeyFromSeed (seed,
+                                                  ethAccountGetAddressIndex (account,
+                                                                             ethAccountGetPrimaryAddress (account)));
+            ewmWalletSignTransfer (cwm->u.eth,
+                                   cryptoWalletAsETH (wallet),
+                                   cryptoTransferAsETH (transfer),
+                                   key);
+            BRKeyClean (&key);
+            success = AS_CRYPTO_BOOLEAN (ETHEREUM_BOOLEAN_IS_TRUE (ewmTransferIsSigned (cwm->u.eth,
+                                                                                        cryptoTransferAsETH (transfer))));
             break;
+        }
 
         case BLOCK_CHAIN_TYPE_GEN:
             success = AS_CRYPTO_BOOLEAN (genManagerSignTransfer (cwm->u.gen,
@@ -960,6 +1209,65 @@ cryptoWalletManagerSign (BRCryptoWalletManager cwm,
     return success;
 }
 
+extern BRCryptoBoolean
+cryptoWalletManagerSign (BRCryptoWalletManager cwm,
+                         BRCryptoWallet wallet,
+                         BRCryptoTransfer transfer,
+                         const char *paperKey) {
+    // Derived the seed used for signing.
+    UInt512 seed = cryptoAccountDeriveSeed(paperKey);
+
+    BRCryptoBoolean success = cryptoWalletManagerSignWithSeed (cwm, wallet, transfer, seed);
+
+    // Zero-out the seed.
+    seed = UINT512_ZERO;
+
+    return success;
+}
+
+extern BRCryptoBoolean
+cryptoWalletManagerSignWithSession (BRCryptoWalletManager cwm,
+                                    BRCryptoWallet wallet,
+                                    BRCryptoTransfer transfer,
+                                    BRCryptoSigningSession session) {
+    UInt512 seed;
+    if (CRYPTO_FALSE == cryptoSigningSessionGetSeed (session, &seed)) return CRYPTO_FALSE;
+
+    BRCryptoBoolean success = cryptoWalletManagerSignWithSeed (cwm, wallet, transfer, seed);
+
+    // Zero-out the seed.
+    mem_clean (&seed, sizeof (seed));
+
+    return success;
+}
+
+extern size_t
+cryptoWalletManagerSignMultipleWithSession (BRCryptoWalletManager cwm,
+                                            BRCryptoWallet wallet,
+                                            BRCryptoTransfer *transfers,
+                                            size_t transfersCount,
+                                            BRCryptoSigningSession session,
+                                            BRCryptoBoolean *results) {
+    UInt512 seed;
+    size_t signedCount = 0;
+
+    // One copy of the seed for the batch; if the session expires midway, the batch completes.
+    BRCryptoBoolean valid = cryptoSigningSessionGetSeed (session, &seed);
+
+    for (size_t index = 0; index < transfersCount; index++) {
+        BRCryptoBoolean success = (CRYPTO_TRUE == valid
+                                   ? cryptoWalletManagerSignWithSeed (cwm, wallet, transfers[index], seed)
+                                   : CRYPTO_FALSE);
+        if (NULL != results) results[index] = success;
+        if (CRYPTO_TRUE == success) signedCount += 1;
+    }
+
+    // Zero-out the seed.
+    mem_clean (&seed, sizeof (seed));
+
+    return signedCount;
+}
+
 extern void
 cryptoWalletManagerSubmit (BRCryptoWalletManager cwm,
                            BRCryptoWallet wallet,
@@ -969,43 +1277,8 @@ cryptoWalletManagerSubmit (BRCryptoWalletManager cwm,
     // Derive the seed used for signing
     UInt512 seed = cryptoAccountDeriveSeed(paperKey);
 
-    switch (cwm->type) {
-        case BLOCK_CHAIN_TYPE_BTC: {
-
-            if (BRWalletManagerSignTransaction (cwm->u.btc,
-                                                cryptoWalletAsBTC (wallet),
-                                                cryptoTransferAsBTC(transfer),
-                                                &seed,
-                                                sizeof (seed))) {
-                cryptoWalletManagerSubmitSigned (cwm, wallet, transfer);
-            }
-            break;
-        }
-
-        case BLOCK_CHAIN_TYPE_ETH: {
-            ewmWalletSignTransferWithPaperKey (cwm->u.eth,
-                                               cryptoWalletAsETH (wallet),
-                                               cryptoTransferAsETH (transfer),
-                                               paperKey);
-
-            cryptoWalletManagerSubmitSigned (cwm, wallet, transfer);
-            break;
-        }
-
-        case BLOCK_CHAIN_TYPE_GEN: {
-            BRGenericWallet genWallet = cryptoWalletAsGEN (wallet);
-            BRGenericTransfer genTransfer = cryptoTransferAsGEN (transfer);
-
-            // Sign the transfer
-            if (genManagerSignTransfer (cwm->u.gen, genWallet, genTransfer, seed)) {
-                cryptoWalletManagerSetTransferStateGEN (cwm, wallet, transfer,
-                                                        genTransferStateCreateOther (GENERIC_TRANSFER_STATE_SIGNED));
-                // Submit the transfer
-                cryptoWalletManagerSubmitSigned (cwm, wallet, transfer);
-            }
-            break;
-        }
-    }
+    if (CRYPTO_TRUE == cryptoWalletManagerSignWithSeed (cwm, wallet, transfer, seed))
+        cryptoWalletManagerSubmitSigned (cwm, wallet, transfer);
 
     // Zero-out the seed.
     seed = UINT512_ZERO;
@@ -1013,6 +1286,15 @@ cryptoWalletManagerSubmit (BRCryptoWalletManager cwm,
     return;
 }
 
+extern void
+cryptoWalletManagerSubmitWithSession (BRCryptoWalletManager cwm,
+                                      BRCryptoWallet wallet,
+                                      BRCryptoTransfer transfer,
+                                      BRCryptoSigningSession session) {
+    if (CRYPTO_TRUE == cryptoWalletManagerSignWithSession (cwm, wallet, transfer, session))
+        cryptoWalletManagerSubmitSigned (cwm, wallet, transfer);
+}
+
 extern void
 cryptoWalletManagerSubmitForKey (BRCryptoWalletManager cwm,
                                  BRCryptoWallet wallet,
@@ -1086,13 +1368,13 @@ cryptoWalletManagerSubmitSigned (BRCryptoWalletManager cwm,
             genWalletAddTransfer (cryptoWalletAsGEN(wallet), cryptoTransferAsGEN(transfer));
 
             // ... and announce the wallet's newly added transfer
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
-                { .transfer = { cryptoTransferTake (transfer) }}
-            });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                     CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
+                     { .transfer = { cryptoTransferTake (transfer) }}
+                 });
 
             // ... perform the actual submit
             genManagerSubmitTransfer (cwm->u.gen,
@@ -1100,13 +1382,13 @@ cryptoWalletManagerSubmitSigned (BRCryptoWalletManager cwm,
                                       cryptoTransferAsGEN (transfer));
 
             // ... and then announce the submission.
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                CRYPTO_WALLET_EVENT_TRANSFER_SUBMITTED,
-                { .transfer = { cryptoTransferTake (transfer) }}
-            });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                     CRYPTO_WALLET_EVENT_TRANSFER_SUBMITTED,
+                     { .transfer = { cryptoTransferTake (transfer) }}
+                 });
 
             break;
         }
@@ -1301,17 +1583,17 @@ cryptoWalletManagerEstimateFeeBasis (BRCryptoWalletManager cwm,
             BRCryptoUnit unitForFee = cryptoWalletGetUnitForFee (wallet);
             BRCryptoFeeBasis feeBasis = cryptoFeeBasisCreateAsGEN (unitForFee, genFeeBasis);
             
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
-                { .feeBasisEstimated = {
-                    CRYPTO_SUCCESS,
-                    cookie,
-                    cryptoFeeBasisTake (feeBasis)
-                }}
-            });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                     CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
+                     { .feeBasisEstimated = {
+                         CRYPTO_SUCCESS,
+                         cookie,
+                         cryptoFeeBasisTake (feeBasis)
+                     }}
+                 });
 
             cryptoFeeBasisGive (feeBasis);
             cryptoUnitGive(unitForFee);
@@ -1509,7 +1791,7 @@ cryptoWalletManagerHandleTransferGEN (BRCryptoWalletManager cwm,
     // Set the state from `transferGeneric`.  This is where we move from 'submitted' to 'included'
     BRCryptoTransferState oldState = cryptoTransferGetState (transfer);
     BRCryptoTransferState newState = cryptoTransferStateCreateGEN (genTransferGetState(transferGeneric), unitForFee);
-    cryptoTransferSetState (transfer, newState);
+    cryptoWalletSetTransferState (wallet, transfer, newState);
 
     if (!transferWasCreated)
         genTransferRelease(transferGeneric);
@@ -1520,13 +1802,13 @@ cryptoWalletManagerHandleTransferGEN (BRCryptoWalletManager cwm,
     // If we created the transfer...
     if (transferWasCreated) {
         // ... announce the newly created transfer.
-        cwm->listener.transferEventCallback (cwm->listener.context,
-                                             cryptoWalletManagerTake (cwm),
-                                             cryptoWalletTake (wallet),
-                                             cryptoTransferTake(transfer),
-                                             (BRCryptoTransferEvent) {
-            CRYPTO_TRANSFER_EVENT_CREATED
-        });
+        cryptoWalletManagerListenerTransferEvent (cwm,
+                                                  cryptoWalletManagerTake (cwm),
+                                                  cryptoWalletTake (wallet),
+                                                  cryptoTransferTake(transfer),
+                                                  (BRCryptoTransferEvent) {
+                 CRYPTO_TRANSFER_EVENT_CREATED
+             });
 
         // ... add the transfer to its wallet...
         cryptoWalletAddTransfer (wallet, transfer);
@@ -1535,43 +1817,43 @@ cryptoWalletManagerHandleTransferGEN (BRCryptoWalletManager cwm,
         genWalletAddTransfer (cryptoWalletAsGEN(wallet), cryptoTransferAsGEN(transfer));
 
         // ... and announce the wallet's newly added transfer
-        cwm->listener.walletEventCallback (cwm->listener.context,
-                                           cryptoWalletManagerTake (cwm),
-                                           cryptoWalletTake (wallet),
-                                           (BRCryptoWalletEvent) {
-            CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
-            { .transfer = { cryptoTransferTake (transfer) }}
-        });
+        cryptoWalletManagerListenerWalletEvent (cwm,
+                                                cryptoWalletManagerTake (cwm),
+                                                cryptoWalletTake (wallet),
+                                                (BRCryptoWalletEvent) {
+                 CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
+                 { .transfer = { cryptoTransferTake (transfer) }}
+             });
 
         BRCryptoAmount balance = cryptoWalletGetBalance(wallet);
-        cwm->listener.walletEventCallback (cwm->listener.context,
-                                           cryptoWalletManagerTake (cwm),
-                                           cryptoWalletTake (cwm->wallet),
-                                           (BRCryptoWalletEvent) {
-                                               CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
-                                               { .balanceUpdated = { balance }}
-                                           });
-
-        cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                  cryptoWalletManagerTake (cwm),
-                                                  (BRCryptoWalletManagerEvent) {
-            CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
-            { .wallet = cryptoWalletTake (cwm->wallet) }
-        });
+        cryptoWalletManagerListenerWalletEvent (cwm,
+                                                cryptoWalletManagerTake (cwm),
+                                                cryptoWalletTake (cwm->wallet),
+                                                (BRCryptoWalletEvent) {
+                                                    CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                                    { .balanceUpdated = { balance }}
+                                                });
+
+        cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                       cryptoWalletManagerTake (cwm),
+                                                       (BRCryptoWalletManagerEvent) {
+                 CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
+                 { .wallet = cryptoWalletTake (cwm->wallet) }
+             });
     }
 
     // If the state is not created and changed, announce a transfer state change.
     if (CRYPTO_TRANSFER_STATE_CREATED != newState.type && oldState.type != newState.type) {
-        cwm->listener.transferEventCallback (cwm->listener.context,
-                                             cryptoWalletManagerTake (cwm),
-                                             cryptoWalletTake (wallet),
-                                             cryptoTransferTake(transfer),
-                                             (BRCryptoTransferEvent) {
-            CRYPTO_TRANSFER_EVENT_CHANGED,
-            { .state = {
-                cryptoTransferStateCopy (&oldState),
-                cryptoTransferStateCopy (&newState) }}
-        });
+        cryptoWalletManagerListenerTransferEvent (cwm,
+                                                  cryptoWalletManagerTake (cwm),
+                                                  cryptoWalletTake (wallet),
+                                                  cryptoTransferTake(transfer),
+                                                  (BRCryptoTransferEvent) {
+                 CRYPTO_TRANSFER_EVENT_CHANGED,
+                 { .state = {
+                     cryptoTransferStateCopy (&oldState),
+                     cryptoTransferStateCopy (&newState) }}
+             });
     }
 
     cryptoTransferStateRelease (&oldState);
@@ -1616,50 +1898,474 @@ cryptoWalletManagerSyncCallbackGEN (BRGenericManagerSyncContext context,
 
         if (fullSync) {
             // Generate a SYNC_STARTED...
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED
-            });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                     CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED
+                 });
 
             // ... and then a SYNC_CONTINUES at %100
-            //            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-            //                                                      cryptoWalletManagerTake (cwm),
-            //                                                      (BRCryptoWalletManagerEvent) {
-            //                CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES,
-            //                { .syncContinues = { NO_CRYPTO_SYNC_TIMESTAMP, 0 }}
-            //            });
+            //            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+            //                                                           cryptoWalletManagerTake (cwm),
+            //                                                           (BRCryptoWalletManagerEvent) {
+            //                     CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES,
+            //                     { .syncContinues = { NO_CRYPTO_SYNC_TIMESTAMP, 0 }}
+            //                 });
         }
         else {
             // Generate a SYNC_CONTINUES at %100...
-            //            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-            //                                                      cryptoWalletManagerTake (cwm),
-            //                                                      (BRCryptoWalletManagerEvent) {
-            //                CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES,
-            //                { .syncContinues = { NO_CRYPTO_SYNC_TIMESTAMP, 100 }}
-            //            });
+            //            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+            //                                                           cryptoWalletManagerTake (cwm),
+            //                                                           (BRCryptoWalletManagerEvent) {
+            //                     CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES,
+            //                     { .syncContinues = { NO_CRYPTO_SYNC_TIMESTAMP, 100 }}
+            //                 });
 
             // ... and then a CRYPTO_WALLET_MANAGER_EVENT_SYNC_STOPPED
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                CRYPTO_WALLET_MANAGER_EVENT_SYNC_STOPPED,
-                { .syncStopped = { CRYPTO_SYNC_STOPPED_REASON_COMPLETE }}
-            });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                     CRYPTO_WALLET_MANAGER_EVENT_SYNC_STOPPED,
+                     { .syncStopped = { CRYPTO_SYNC_STOPPED_REASON_COMPLETE }}
+                 });
         }
 
-        cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                  cryptoWalletManagerTake (cwm),
-                                                  (BRCryptoWalletManagerEvent) {
-            CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
-            { .state = { oldState, newState }}
-        });
+        cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                       cryptoWalletManagerTake (cwm),
+                                                       (BRCryptoWalletManagerEvent) {
+                 CRYPTO_WALLET_MANAGER_EVENT_CHANGED,
+                 { .state = { oldState, newState }}
+             });
     }
     else pthread_mutex_unlock (&cwm->lock);
 
     cryptoWalletManagerGive (cwm);
 }
 
+/// =============================================================================================
+///
+/// MARK: - Listener
+///
+///
+
+struct BRCryptoCWMListenerSlotRecord {
+    BRCryptoCWMListenerEvent event;
+    BRCryptoBoolean superseded;
+    uint64_t queuedAt;          // milliseconds
+};
+
+typedef struct BRCryptoCWMListenerSlotRecord *BRCryptoCWMListenerSlot;
+
+struct BRCryptoCWMListenerThreadRecord {
+    pthread_t thread;
+    BRCryptoWalletManager cwm;
+    BRCryptoBoolean quit;
+
+    /// Set if `thread` was stopped by a handler running on it; `thread` must then exit without
+    /// touching `cwm`, which may be gone.
+    BRCryptoBoolean detached;
+};
+
+static uint64_t
+cryptoListenerNow (void) {
+    struct timeval now;
+    gettimeofday (&now, NULL);
+    return 1000 * (uint64_t) now.tv_sec + (uint64_t) now.tv_usec / 1000;
+}
+
+// The object whose later events supersede `event`, if any
+static const void *
+cryptoListenerEventSupersededBy (const BRCryptoCWMListenerEvent *event, int *kind) {
+    switch (event->type) {
+        case CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER:
+            *kind = 1 + event->u.manager.type;
+            return ((CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED == event->u.manager.type ||
+                     CRYPTO_WALLET_MANAGER_EVENT_SYNC_CONTINUES       == event->u.manager.type)
+                    ? event->manager
+                    : NULL);
+
+        case CRYPTO_CWM_LISTENER_EVENT_WALLET:
+            *kind = 100 + event->u.wallet.type;
+            return ((CRYPTO_WALLET_EVENT_BALANCE_UPDATED   == event->u.wallet.type ||
+                     CRYPTO_WALLET_EVENT_FEE_BASIS_UPDATED == event->u.wallet.type)
+                    ? event->wallet
+                    : NULL);
+
+        case CRYPTO_CWM_LISTENER_EVENT_TRANSFER:
+            *kind = 200 + event->u.transfer.type;
+            return (CRYPTO_TRANSFER_EVENT_CHANGED == event->u.transfer.type
+                    ? event->transfer
+                    : NULL);
+    }
+    return NULL;
+}
+
+static size_t
+cryptoListenerSlotHash (const void *slot) {
+    int kind;
+    const void *object = cryptoListenerEventSupersededBy (&((BRCryptoCWMListenerSlot) slot)->event, &kind);
+    return ((size_t) object) ^ (size_t) kind;
+}
+
+static int
+cryptoListenerSlotEqual (const void *slot1, const void *slot2) {
+    int kind1, kind2;
+    const void *object1 = cryptoListenerEventSupersededBy (&((BRCryptoCWMListenerSlot) slot1)->event, &kind1);
+    const void *object2 = cryptoListenerEventSupersededBy (&((BRCryptoCWMListenerSlot) slot2)->event, &kind2);
+    return kind1 == kind2 && object1 == object2;
+}
+
+// Give the references held by `superseded`, which is replaced by `event`
+static void
+cryptoListenerEventSupersede (BRCryptoCWMListenerEvent *superseded,
+                              BRCryptoCWMListenerEvent *event) {
+    switch (superseded->type) {
+        case CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER:
+            break;
+
+        case CRYPTO_CWM_LISTENER_EVENT_WALLET:
+            switch (superseded->u.wallet.type) {
+                case CRYPTO_WALLET_EVENT_BALANCE_UPDATED:
+                    cryptoAmountGive (superseded->u.wallet.u.balanceUpdated.amount);
+                    break;
+                case CRYPTO_WALLET_EVENT_FEE_BASIS_UPDATED:
+                    cryptoFeeBasisGive (superseded->u.wallet.u.feeBasisUpdated.basis);
+                    break;
+                default:
+                    assert (0);
+                    break;
+            }
+            cryptoWalletGive (superseded->wallet);
+            break;
+
+        case CRYPTO_CWM_LISTENER_EVENT_TRANSFER:
+            // The merged event spans from the superseded event's old state to the latest state
+            cryptoTransferStateRelease (&event->u.transfer.u.state.old);
+            event->u.transfer.u.state.old = superseded->u.transfer.u.state.old;
+            cryptoTransferStateRelease (&superseded->u.transfer.u.state.new);
+
+            cryptoTransferGive (superseded->transfer);
+            cryptoWalletGive (superseded->wallet);
+            break;
+    }
+    cryptoWalletManagerGive (superseded->manager);
+}
+
+static void
+cryptoListenerEventAnnounce (BRCryptoCWMListener listener,
+                             BRCryptoCWMListenerEvent event) {
+    switch (event.type) {
+        case CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER:
+            listener.walletManagerEventCallback (listener.context, event.manager, event.u.manager);
+            break;
+        case CRYPTO_CWM_LISTENER_EVENT_WALLET:
+            listener.walletEventCallback (listener.context, event.manager, event.wallet, event.u.wallet);
+            break;
+        case CRYPTO_CWM_LISTENER_EVENT_TRANSFER:
+            listener.transferEventCallback (listener.context, event.manager, event.wallet, event.transfer, event.u.transfer);
+            break;
+    }
+}
+
+static void
+cryptoListenerQueueInit (BRCryptoCWMListenerQueue *queue) {
+    pthread_mutex_init (&queue->lock, NULL);
+    pthread_cond_init  (&queue->cond, NULL);
+
+    queue->enabled       = CRYPTO_FALSE;
+    queue->slots         = NULL;
+    queue->slotsCapacity = 0;
+    queue->slotsHead     = 0;
+    queue->slotsCount    = 0;
+    queue->eventsCount   = 0;
+    queue->coalescable   = BRSetNew (cryptoListenerSlotHash, cryptoListenerSlotEqual, 100);
+    queue->thread        = NULL;
+}
+
+static void
+cryptoListenerQueueRelease (BRCryptoCWMListenerQueue *queue) {
+    BRSetFree (queue->coalescable);
+    if (NULL != queue->slots) free (queue->slots);
+
+    pthread_cond_destroy  (&queue->cond);
+    pthread_mutex_destroy (&queue->lock);
+}
+
+static BRCryptoCWMListenerSlot
+cryptoListenerQueueSlotAt (BRCryptoCWMListenerQueue *queue, size_t index) {
+    return &queue->slots[(queue->slotsHead + index) % queue->slotsCapacity];
+}
+
+// Drop superseded slots from the front, so that the first slot, if any, holds the oldest queued
+// event.  The queue is locked.
+static void
+cryptoListenerQueueTrim (BRCryptoCWMListenerQueue *queue) {
+    while (queue->slotsCount > 0 && CRYPTO_TRUE == cryptoListenerQueueSlotAt (queue, 0)->superseded) {
+        queue->slotsHead   = (queue->slotsHead + 1) % queue->slotsCapacity;
+        queue->slotsCount -= 1;
+    }
+}
+
+// Add `event` to the ring buffer, growing it if full, and supersede any queued event it replaces.
+// The queue is locked.
+static void
+cryptoListenerQueueAdd (BRCryptoCWMListenerQueue *queue,
+                        BRCryptoCWMListenerEvent event) {
+    if (queue->slotsCount == queue->slotsCapacity) {
+        size_t capacity = (queue->slotsCapacity > 0 ? 2 * queue->slotsCapacity : 2 * queue->batching.eventsLimit + 1);
+        struct BRCryptoCWMListenerSlotRecord *slots = calloc (capacity, sizeof (struct BRCryptoCWMListenerSlotRecord));
+
+        // Copy the slots in order to the new buffer and re-index them
+        BRSetClear (queue->coalescable);
+        for (size_t index = 0; index < queue->slotsCount; index++) {
+            slots[index] = *cryptoListenerQueueSlotAt (queue, index);
+            int kind;
+            if (CRYPTO_FALSE == slots[index].superseded &&
+                NULL != cryptoListenerEventSupersededBy (&slots[index].event, &kind))
+                BRSetAdd (queue->coalescable, &slots[index]);
+        }
+
+        if (NULL != queue->slots) free (queue->slots);
+        queue->slots         = slots;
+        queue->slotsCapacity = capacity;
+        queue->slotsHead     = 0;
+    }
+
+    BRCryptoCWMListenerSlot slot = cryptoListenerQueueSlotAt (queue, queue->slotsCount);
+    *slot = (struct BRCryptoCWMListenerSlotRecord) { event, CRYPTO_FALSE, cryptoListenerNow() };
+
+    int kind;
+    if (NULL != cryptoListenerEventSupersededBy (&slot->event, &kind)) {
+        BRCryptoCWMListenerSlot superseded = BRSetRemove (queue->coalescable, slot);
+        if (NULL != superseded) {
+            cryptoListenerEventSupersede (&superseded->event, &slot->event);
+            superseded->superseded = CRYPTO_TRUE;
+            queue->eventsCount -= 1;
+        }
+        BRSetAdd (queue->coalescable, slot);
+    }
+
+    queue->slotsCount  += 1;
+    queue->eventsCount += 1;
+
+    cryptoListenerQueueTrim (queue);
+}
+
+// Remove up to `eventsCount` events, skipping those superseded.  The queue is locked.
+static size_t
+cryptoListenerQueueRemove (BRCryptoCWMListenerQueue *queue,
+                           BRCryptoCWMListenerEvent *events,
+                           size_t eventsCount) {
+    size_t count = 0;
+
+    while (queue->slotsCount > 0 && count < eventsCount) {
+        BRCryptoCWMListenerSlot slot = cryptoListenerQueueSlotAt (queue, 0);
+
+        if (CRYPTO_FALSE == slot->superseded) {
+            int kind;
+            if (NULL != cryptoListenerEventSupersededBy (&slot->event, &kind))
+                BRSetRemove (queue->coalescable, slot);
+
+            events[count++] = slot->event;
+            queue->eventsCount -= 1;
+        }
+
+        queue->slotsHead   = (queue->slotsHead + 1) % queue->slotsCapacity;
+        queue->slotsCount -= 1;
+    }
+    cryptoListenerQueueTrim (queue);
+
+    return count;
+}
+
+static void *
+cryptoListenerThread (void *context) {
+    struct BRCryptoCWMListenerThreadRecord *thread = context;
+    BRCryptoWalletManager cwm = thread->cwm;
+    BRCryptoCWMListenerQueue *queue = &cwm->listenerQueue;
+
+    pthread_mutex_lock (&queue->lock);
+    while (CRYPTO_FALSE == thread->quit) {
+        if (0 == queue->eventsCount) {
+            pthread_cond_wait (&queue->cond, &queue->lock);
+            continue;
+        }
+
+        // Deliver once enough events are queued, or the oldest has waited long enough.  The first
+        // slot is never superseded; see `cryptoListenerQueueTrim()`.
+        uint64_t deliverAt = cryptoListenerQueueSlotAt (queue, 0)->queuedAt + queue->batching.latencyLimit;
+        if (queue->eventsCount < queue->batching.eventsLimit && cryptoListenerNow() < deliverAt) {
+            struct timespec timeout = { (time_t) (deliverAt / 1000), (long) (1000000 * (deliverAt % 1000)) };
+            pthread_cond_timedwait (&queue->cond, &queue->lock, &timeout);
+            continue;
+        }
+
+        size_t eventsLimit = queue->batching.eventsLimit;
+        BRCryptoCWMListenerEvent *events = calloc (eventsLimit, sizeof (BRCryptoCWMListenerEvent));
+        size_t eventsCount = cryptoListenerQueueRemove (queue, events, eventsLimit);
+        BRCryptoCWMListenerBatchEvents batchCallback = queue->batching.batchCallback;
+        pthread_mutex_unlock (&queue->lock);
+
+        // Hold `cwm` while delivering; the handler may give the last of the events' references.
+        cryptoWalletManagerTake (cwm);
+        batchCallback (cwm->listener.context, events, eventsCount);
+        free (events);
+        cryptoWalletManagerGive (cwm);
+
+        if (CRYPTO_TRUE == thread->detached) {
+            free (thread);
+            return NULL;
+        }
+        pthread_mutex_lock (&queue->lock);
+    }
+    pthread_mutex_unlock (&queue->lock);
+
+    return NULL;
+}
+
+// Stop delivering batches.  The queue is not locked.
+static void
+cryptoListenerThreadStop (BRCryptoWalletManager cwm) {
+    BRCryptoCWMListenerQueue *queue = &cwm->listenerQueue;
+
+    pthread_mutex_lock (&queue->lock);
+    struct BRCryptoCWMListenerThreadRecord *thread = queue->thread;
+    queue->thread = NULL;
+    if (NULL != thread) {
+        thread->quit = CRYPTO_TRUE;
+        pthread_cond_broadcast (&queue->cond);
+    }
+    pthread_mutex_unlock (&queue->lock);
+
+    if (NULL == thread) return;
+
+    if (pthread_equal (pthread_self(), thread->thread)) {
+        // Called from a handler on `thread`; it exits once the handler returns.
+        thread->detached = CRYPTO_TRUE;
+        pthread_detach (thread->thread);
+    }
+    else {
+        pthread_join (thread->thread, NULL);
+        free (thread);
+    }
+}
+
+extern void
+cryptoWalletManagerSetListenerBatching (BRCryptoWalletManager cwm,
+                                        const BRCryptoCWMListenerBatching *batching) {
+    BRCryptoCWMListenerQueue *queue = &cwm->listenerQueue;
+
+    cryptoListenerThreadStop (cwm);
+
+    // Announce anything already queued
+    pthread_mutex_lock (&queue->lock);
+    size_t eventsCount = queue->eventsCount;
+    BRCryptoCWMListenerEvent *events = calloc (eventsCount > 0 ? eventsCount : 1, sizeof (BRCryptoCWMListenerEvent));
+    cryptoListenerQueueRemove (queue, events, eventsCount);
+    queue->enabled = CRYPTO_FALSE;
+    pthread_mutex_unlock (&queue->lock);
+
+    for (size_t index = 0; index < eventsCount; index++)
+        cryptoListenerEventAnnounce (cwm->listener, events[index]);
+    free (events);
+
+    if (NULL == batching) return;
+    assert (batching->eventsLimit > 0);
+
+    pthread_mutex_lock (&queue->lock);
+    queue->batching = *batching;
+    queue->enabled  = CRYPTO_TRUE;
+
+    if (NULL != batching->batchCallback) {
+        struct BRCryptoCWMListenerThreadRecord *thread = calloc (1, sizeof (struct BRCryptoCWMListenerThreadRecord));
+        thread->cwm      = cwm;
+        thread->quit     = CRYPTO_FALSE;
+        thread->detached = CRYPTO_FALSE;
+
+        pthread_attr_t attr;
+        pthread_attr_init (&attr);
+        pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_JOINABLE);
+        pthread_attr_setstacksize (&attr, 1024 * 1024);
+        pthread_create (&thread->thread, &attr, cryptoListenerThread, thread);
+        pthread_attr_destroy (&attr);
+
+        queue->thread = thread;
+    }
+    pthread_mutex_unlock (&queue->lock);
+}
+
+extern size_t
+cryptoWalletManagerPollListenerEvents (BRCryptoWalletManager cwm,
+                                       BRCryptoCWMListenerEvent *events,
+                                       size_t eventsCount) {
+    BRCryptoCWMListenerQueue *queue = &cwm->listenerQueue;
+
+    pthread_mutex_lock (&queue->lock);
+    eventsCount = cryptoListenerQueueRemove (queue, events, eventsCount);
+    pthread_mutex_unlock (&queue->lock);
+
+    return eventsCount;
+}
+
+static void
+cryptoWalletManagerListenerEvent (BRCryptoWalletManager cwm,
+                                  BRCryptoCWMListenerEvent event) {
+    BRCryptoCWMListenerQueue *queue = &cwm->listenerQueue;
+
+    pthread_mutex_lock (&queue->lock);
+    if (CRYPTO_TRUE == queue->enabled) {
+        cryptoListenerQueueAdd (queue, event);
+        if (NULL != queue->thread) pthread_cond_signal (&queue->cond);
+        pthread_mutex_unlock (&queue->lock);
+        return;
+    }
+    pthread_mutex_unlock (&queue->lock);
+
+    cryptoListenerEventAnnounce (cwm->listener, event);
+}
+
+private_extern void
+cryptoWalletManagerListenerWalletManagerEvent (BRCryptoWalletManager cwm,
+                                               BRCryptoWalletManager manager,
+                                               BRCryptoWalletManagerEvent event) {
+    cryptoWalletManagerListenerEvent (cwm, (BRCryptoCWMListenerEvent) {
+        CRYPTO_CWM_LISTENER_EVENT_WALLET_MANAGER,
+        manager,
+        NULL,
+        NULL,
+        { .manager = event }
+    });
+}
+
+private_extern void
+cryptoWalletManagerListenerWalletEvent (BRCryptoWalletManager cwm,
+                                        BRCryptoWalletManager manager,
+                                        BRCryptoWallet wallet,
+                                        BRCryptoWalletEvent event) {
+    cryptoWalletManagerListenerEvent (cwm, (BRCryptoCWMListenerEvent) {
+        CRYPTO_CWM_LISTENER_EVENT_WALLET,
+        manager,
+        wallet,
+        NULL,
+        { .wallet = event }
+    });
+}
+
+private_extern void
+cryptoWalletManagerListenerTransferEvent (BRCryptoWalletManager cwm,
+                                          BRCryptoWalletManager manager,
+                                          BRCryptoWallet wallet,
+                                          BRCryptoTransfer transfer,
+                                          BRCryptoTransferEvent event) {
+    cryptoWalletManagerListenerEvent (cwm, (BRCryptoCWMListenerEvent) {
+        CRYPTO_CWM_LISTENER_EVENT_TRANSFER,
+        manager,
+        wallet,
+        transfer,
+        { .transfer = event }
+    });
+}
+
 extern const char *
 cryptoWalletManagerEventTypeString (BRCryptoWalletManagerEventType t) {
     switch (t) {
@@ -194,27 +194,27 @@ cwmWalletManagerEventAsBTC (BRWalletManagerClientContext context,
             needEvent = 0;
 
             // Generate a CRYPTO wallet manager event for CREATED...
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_CREATED
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_CREATED
+                                                           });
 
             // Generate a CRYPTO wallet event for CREATED...
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (cwm->wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_CREATED
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (cwm->wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_CREATED
+                                                    });
 
             // ... and then a CRYPTO wallet manager event for WALLET_ADDED
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
-                                                          { .wallet = { cryptoWalletTake (cwm->wallet) }}
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                                                               { .wallet = { cryptoWalletTake (cwm->wallet) }}
+                                                           });
             break;
         }
 
@@ -240,9 +240,9 @@ cwmWalletManagerEventAsBTC (BRWalletManagerClientContext context,
             cwmEvent = (BRCryptoWalletManagerEvent) {
                 CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED
             };
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      cwmEvent);
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           cwmEvent);
 
             BRCryptoWalletManagerState state = cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_SYNCING);
             cwmEvent = (BRCryptoWalletManagerEvent) {
@@ -269,9 +269,9 @@ cwmWalletManagerEventAsBTC (BRWalletManagerClientContext context,
                     event.u.syncStopped.reason,
                 }}
             };
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      cwmEvent);
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           cwmEvent);
 
             BRCryptoWalletManagerState state = cryptoWalletManagerStateInit (CRYPTO_WALLET_MANAGER_STATE_CONNECTED);
             cwmEvent = (BRCryptoWalletManagerEvent) {
@@ -303,9 +303,9 @@ cwmWalletManagerEventAsBTC (BRWalletManagerClientContext context,
     }
 
     if (needEvent)
-        cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                  cryptoWalletManagerTake (cwm),
-                                                  cwmEvent);
+        cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                       cryptoWalletManagerTake (cwm),
+                                                       cwmEvent);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -349,21 +349,21 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
             BRCryptoAmount amount = cryptoAmountCreateInteger ((int64_t) event.u.balance.satoshi, unit); // taken
 
             // Generate BALANCE_UPDATED with 'amount' (taken)
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
-                                                   { .balanceUpdated = { cryptoAmountTake (amount) }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                                        { .balanceUpdated = { cryptoAmountTake (amount) }}
+                                                    });
 
             // ... and then a CRYPTO wallet manager event for WALLET_CHANGED
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
-                                                          { .wallet = { cryptoWalletTake (wallet) }}
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
+                                                               { .wallet = { cryptoWalletTake (wallet) }}
+                                                           });
 
             cryptoAmountGive (amount);
             cryptoWalletGive (wallet);
@@ -386,21 +386,21 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
                                                                    1000);
 
             // Generate FEE_BASIS_UPDATED for default fee basis change
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_FEE_BASIS_UPDATED,
-                                                   { .feeBasisUpdated = { cryptoFeeBasisTake (feeBasis) }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_FEE_BASIS_UPDATED,
+                                                        { .feeBasisUpdated = { cryptoFeeBasisTake (feeBasis) }}
+                                                    });
 
             // ... and then a CRYPTO wallet manager event for WALLET_CHANGED
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
-                                                          { .wallet = { cryptoWalletTake (wallet) }}
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
+                                                               { .wallet = { cryptoWalletTake (wallet) }}
+                                                           });
 
             cryptoFeeBasisGive (feeBasis);
             cryptoUnitGive (feeUnit);
@@ -422,16 +422,16 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
             assert (CRYPTO_TRANSFER_STATE_SUBMITTED != oldState.type);
 
             BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SUBMITTED);
-            cryptoTransferSetState (transfer, newState);
+            cryptoWalletSetTransferState (wallet, transfer, newState);
 
-            cwm->listener.transferEventCallback (cwm->listener.context,
-                                                 cryptoWalletManagerTake (cwm),
-                                                 cryptoWalletTake (wallet),
-                                                 cryptoTransferTake (transfer),
-                                                 (BRCryptoTransferEvent) {
-                                                     CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                     { .state = { oldState, newState }}
-                                                 });
+            cryptoWalletManagerListenerTransferEvent (cwm,
+                                                      cryptoWalletManagerTake (cwm),
+                                                      cryptoWalletTake (wallet),
+                                                      cryptoTransferTake (transfer),
+                                                      (BRCryptoTransferEvent) {
+                                                          CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                          { .state = { oldState, newState }}
+                                                      });
 
             cryptoTransferGive (transfer);
             cryptoWalletGive (wallet);
@@ -452,16 +452,16 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
             // allow changes to different error states? don't assert (CRYPTO_TRANSFER_STATE_ERRORED != oldState.type);
 
             BRCryptoTransferState newState = cryptoTransferStateErroredInit (event.u.submitFailed.error);
-            cryptoTransferSetState (transfer, newState);
+            cryptoWalletSetTransferState (wallet, transfer, newState);
 
-            cwm->listener.transferEventCallback (cwm->listener.context,
-                                                 cryptoWalletManagerTake (cwm),
-                                                 cryptoWalletTake (wallet),
-                                                 cryptoTransferTake (transfer),
-                                                 (BRCryptoTransferEvent) {
-                                                     CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                     { .state = { oldState, newState }}
-                                                 });
+            cryptoWalletManagerListenerTransferEvent (cwm,
+                                                      cryptoWalletManagerTake (cwm),
+                                                      cryptoWalletTake (wallet),
+                                                      cryptoTransferTake (transfer),
+                                                      (BRCryptoTransferEvent) {
+                                                          CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                          { .state = { oldState, newState }}
+                                                      });
 
             cryptoTransferGive (transfer);
             cryptoWalletGive (wallet);
@@ -482,17 +482,17 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
                                                                    event.u.feeEstimated.sizeInByte);
 
             // Generate FEE_BASIS_ESTIMATED
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
-                                                   { .feeBasisEstimated = {
-                                                       CRYPTO_SUCCESS,
-                                                       event.u.feeEstimated.cookie,
-                                                       cryptoFeeBasisTake(feeBasis)
-                                                   }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
+                                                        { .feeBasisEstimated = {
+                                                            CRYPTO_SUCCESS,
+                                                            event.u.feeEstimated.cookie,
+                                                            cryptoFeeBasisTake(feeBasis)
+                                                        }}
+                                                    });
 
             cryptoFeeBasisGive (feeBasis);
             cryptoUnitGive (feeUnit);
@@ -512,20 +512,20 @@ cwmWalletEventAsBTC (BRWalletManagerClientContext context,
             cryptoWalletManagerRemWallet (cwm, wallet);
 
             // Generate a CRYPTO wallet manager event for WALLET_DELETED...
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_WALLET_DELETED,
-                                                          { .wallet = { cryptoWalletTake (wallet) }}
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_WALLET_DELETED,
+                                                               { .wallet = { cryptoWalletTake (wallet) }}
+                                                           });
 
             // ... and then a CRYPTO wallet event for DELETED.
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_DELETED
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_DELETED
+                                                    });
 
             cryptoWalletGive (wallet);
             break;
@@ -577,25 +577,25 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
                                                   isBTC);
 
             // Generate a CRYPTO transfer event for CREATED'...
-            cwm->listener.transferEventCallback (cwm->listener.context,
-                                                 cryptoWalletManagerTake (cwm),
-                                                 cryptoWalletTake (wallet),
-                                                 cryptoTransferTake (transfer),
-                                                 (BRCryptoTransferEvent) {
-                                                     CRYPTO_TRANSFER_EVENT_CREATED
-                                                 });
+            cryptoWalletManagerListenerTransferEvent (cwm,
+                                                      cryptoWalletManagerTake (cwm),
+                                                      cryptoWalletTake (wallet),
+                                                      cryptoTransferTake (transfer),
+                                                      (BRCryptoTransferEvent) {
+                                                          CRYPTO_TRANSFER_EVENT_CREATED
+                                                      });
 
             // ... add 'transfer' to 'wallet' (argubaly late... but to prove a point)...
             cryptoWalletAddTransfer (wallet, transfer);
 
             // ... and then generate a CRYPTO wallet event for 'TRANSFER_ADDED'
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
-                                                   { .transfer = { cryptoTransferTake (transfer) }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
+                                                        { .transfer = { cryptoTransferTake (transfer) }}
+                                                    });
 
             cryptoTransferGive (transfer);
             cryptoUnitGive (unitForFee);
@@ -614,16 +614,16 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
             assert (CRYPTO_TRANSFER_STATE_SIGNED != oldState.type);
 
             BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SIGNED);
-            cryptoTransferSetState (transfer, newState);
+            cryptoWalletSetTransferState (wallet, transfer, newState);
 
-            cwm->listener.transferEventCallback (cwm->listener.context,
-                                                 cryptoWalletManagerTake (cwm),
-                                                 cryptoWalletTake (wallet),
-                                                 cryptoTransferTake (transfer ),
-                                                 (BRCryptoTransferEvent) {
-                                                     CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                     { .state = { oldState, newState }}
-                                                 });
+            cryptoWalletManagerListenerTransferEvent (cwm,
+                                                      cryptoWalletManagerTake (cwm),
+                                                      cryptoWalletTake (wallet),
+                                                      cryptoTransferTake (transfer ),
+                                                      (BRCryptoTransferEvent) {
+                                                          CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                          { .state = { oldState, newState }}
+                                                      });
 
             cryptoTransferGive (transfer);
             break;
@@ -652,25 +652,25 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
                                                       isBTC);
 
                 // Generate a CRYPTO transfer event for CREATED'...
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CREATED
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CREATED
+                                                          });
 
                 // ... add 'transfer' to 'wallet' (argubaly late... but to prove a point)...
                 cryptoWalletAddTransfer (wallet, transfer);
 
                 // ... and then generate a CRYPTO wallet event for 'TRANSFER_ADDED'
-                cwm->listener.walletEventCallback (cwm->listener.context,
-                                                   cryptoWalletManagerTake (cwm),
-                                                   cryptoWalletTake (wallet),
-                                                   (BRCryptoWalletEvent) {
-                                                       CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
-                                                       { .transfer = { cryptoTransferTake (transfer) }}
-                                                   });
+                cryptoWalletManagerListenerWalletEvent (cwm,
+                                                        cryptoWalletManagerTake (cwm),
+                                                        cryptoWalletTake (wallet),
+                                                        (BRCryptoWalletEvent) {
+                                                            CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
+                                                            { .transfer = { cryptoTransferTake (transfer) }}
+                                                        });
 
                 cryptoUnitGive (unitForFee);
                 cryptoUnitGive (unit);
@@ -707,16 +707,16 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
                 (0 == event.u.updated.timestamp || TX_UNCONFIRMED == event.u.updated.blockHeight)) {
                 BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SUBMITTED);
 
-                cryptoTransferSetState (transfer, newState);
+                cryptoWalletSetTransferState (wallet, transfer, newState);
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
 
             } else if (CRYPTO_TRANSFER_STATE_INCLUDED != oldState.type &&
                        0 != event.u.updated.timestamp && TX_UNCONFIRMED != event.u.updated.blockHeight) {
@@ -733,16 +733,16 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
 
                 cryptoFeeBasisGive(feeBasisConfirmed);
 
-                cryptoTransferSetState (transfer, newState);
+                cryptoWalletSetTransferState (wallet, transfer, newState);
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
             } else {
                 // no change; just release the old state and carry on
                 cryptoTransferStateRelease (&oldState);
@@ -762,25 +762,25 @@ cwmTransactionEventAsBTC (BRWalletManagerClientContext context,
             assert (NULL != transfer);
 
             // Generate a CRYPTO wallet event for 'TRANSFER_DELETED'...
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_TRANSFER_DELETED,
-                                                   { .transfer = { cryptoTransferTake (transfer) }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_TRANSFER_DELETED,
+                                                        { .transfer = { cryptoTransferTake (transfer) }}
+                                                    });
 
             // ... Remove 'transfer' from 'wallet'
             cryptoWalletRemTransfer (wallet, transfer);
 
             // ... and then follow up with a CRYPTO transfer event for 'DELETED'
-            cwm->listener.transferEventCallback (cwm->listener.context,
-                                                 cryptoWalletManagerTake (cwm),
-                                                 cryptoWalletTake (wallet),
-                                                 cryptoTransferTake (transfer),
-                                                 (BRCryptoTransferEvent) {
-                                                     CRYPTO_TRANSFER_EVENT_DELETED
-                                                 });
+            cryptoWalletManagerListenerTransferEvent (cwm,
+                                                      cryptoWalletManagerTake (cwm),
+                                                      cryptoWalletTake (wallet),
+                                                      cryptoTransferTake (transfer),
+                                                      (BRCryptoTransferEvent) {
+                                                          CRYPTO_TRANSFER_EVENT_DELETED
+                                                      });
 
             cryptoTransferGive (transfer);
             break;
@@ -829,27 +829,27 @@ cwmWalletManagerEventAsETH (BREthereumClientContext context,
             needEvent = 0;
 
             // Generate a CRYPTO wallet manager event for CREATED...
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_CREATED
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_CREATED
+                                                           });
 
             // Generate a CRYPTO wallet event for CREATED...
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (cwm->wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_CREATED
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (cwm->wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_CREATED
+                                                    });
 
             // ... and then a CRYPTO wallet manager event for WALLET_ADDED
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake (cwm),
-                                                      (BRCryptoWalletManagerEvent) {
-                                                          CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
-                                                          { .wallet = { cryptoWalletTake (cwm->wallet) }}
-                                                      });
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake (cwm),
+                                                           (BRCryptoWalletManagerEvent) {
+                                                               CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                                                               { .wallet = { cryptoWalletTake (cwm->wallet) }}
+                                                           });
 
             break;
         }
@@ -858,22 +858,22 @@ cwmWalletManagerEventAsETH (BREthereumClientContext context,
             // If the newState is `syncing` we want a syncStarted event
             if (EWM_STATE_SYNCING == event.u.changed.newState) {
                 assert (EWM_STATE_CONNECTED == event.u.changed.oldState);
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake(cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                                                              CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED
-                                                          });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake(cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                                                                   CRYPTO_WALLET_MANAGER_EVENT_SYNC_STARTED
+                                                               });
             }
 
             // If the oldState is `syncing` we want a syncEnded event
             if (EWM_STATE_SYNCING == event.u.changed.oldState) {
                 assert (EWM_STATE_CONNECTED == event.u.changed.newState);
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake(cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                                                              CRYPTO_WALLET_MANAGER_EVENT_SYNC_STOPPED,
-                                                              { .syncStopped = { cryptoSyncStoppedReasonComplete() } }
-                                                          });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake(cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                                                                   CRYPTO_WALLET_MANAGER_EVENT_SYNC_STOPPED,
+                                                                   { .syncStopped = { cryptoSyncStoppedReasonComplete() } }
+                                                               });
             }
 
             cwmEvent = (BRCryptoWalletManagerEvent) {
@@ -920,9 +920,9 @@ cwmWalletManagerEventAsETH (BREthereumClientContext context,
     }
 
     if (needEvent)
-        cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                  cryptoWalletManagerTake (cwm),
-                                                  cwmEvent);
+        cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                       cryptoWalletManagerTake (cwm),
+                                                       cwmEvent);
 
     cryptoWalletManagerGive (cwm);
 }
@@ -1005,19 +1005,19 @@ cwmWalletEventAsETH (BREthereumClientContext context,
                 cryptoCurrencyGive (currency);
 
                 // This is invoked directly on an EWM thread. (as is all this function's code).
-                cwm->listener.walletEventCallback (cwm->listener.context,
-                                                   cryptoWalletManagerTake (cwm),
-                                                   cryptoWalletTake (wallet),
-                                                   (BRCryptoWalletEvent) {
-                                                       CRYPTO_WALLET_EVENT_CREATED
-                                                   });
-
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake (cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                                                              CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
-                                                              { .wallet = { wallet }}
-                                                          });
+                cryptoWalletManagerListenerWalletEvent (cwm,
+                                                        cryptoWalletManagerTake (cwm),
+                                                        cryptoWalletTake (wallet),
+                                                        (BRCryptoWalletEvent) {
+                                                            CRYPTO_WALLET_EVENT_CREATED
+                                                        });
+
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake (cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                                                                   CRYPTO_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                                                                   { .wallet = { wallet }}
+                                                               });
             }
             break;
         }
@@ -1040,21 +1040,21 @@ cwmWalletEventAsETH (BREthereumClientContext context,
                 cryptoUnitGive(unit);
 
                 // Generate a BALANCE_UPDATED for the wallet
-                cwm->listener.walletEventCallback(cwm->listener.context,
-                                                  cryptoWalletManagerTake(cwm),
-                                                  cryptoWalletTake (wallet),
-                                                  (BRCryptoWalletEvent) {
-                                                      CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
-                                                      {.balanceUpdated = {cryptoAmount}}
-                                                  });
+                cryptoWalletManagerListenerWalletEvent(cwm,
+                                                       cryptoWalletManagerTake(cwm),
+                                                       cryptoWalletTake (wallet),
+                                                       (BRCryptoWalletEvent) {
+                                                           CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                                           {.balanceUpdated = {cryptoAmount}}
+                                                       });
 
                 // ... and then a CRYPTO wallet manager event for WALLET_CHANGED
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake (cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                                                              CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
-                                                              { .wallet = { wallet }}
-                                                          });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake (cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                                                                   CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
+                                                                   { .wallet = { wallet }}
+                                                               });
             }
             break;
         }
@@ -1068,21 +1068,21 @@ cwmWalletEventAsETH (BREthereumClientContext context,
                                                                        ewmWalletGetDefaultGasLimit(cwm->u.eth, wid),
                                                                        ewmWalletGetDefaultGasPrice(cwm->u.eth,wid));
                 // Generate a FEE_BASIS_UPDATED for the wallet
-                cwm->listener.walletEventCallback(cwm->listener.context,
-                                                  cryptoWalletManagerTake(cwm),
-                                                  cryptoWalletTake (wallet),
-                                                  (BRCryptoWalletEvent) {
-                                                      CRYPTO_WALLET_EVENT_FEE_BASIS_UPDATED,
-                                                      {.feeBasisUpdated = {feeBasis}}
-                                                  });
+                cryptoWalletManagerListenerWalletEvent(cwm,
+                                                       cryptoWalletManagerTake(cwm),
+                                                       cryptoWalletTake (wallet),
+                                                       (BRCryptoWalletEvent) {
+                                                           CRYPTO_WALLET_EVENT_FEE_BASIS_UPDATED,
+                                                           {.feeBasisUpdated = {feeBasis}}
+                                                       });
 
                 // ... and then a CRYPTO wallet manager event for WALLET_CHANGED
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake (cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                                                              CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
-                                                              { .wallet = { wallet }}
-                                                          });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake (cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                                                                   CRYPTO_WALLET_MANAGER_EVENT_WALLET_CHANGED,
+                                                                   { .wallet = { wallet }}
+                                                               });
                 cryptoUnitGive (feeUnit);
             }
             break;
@@ -1094,30 +1094,30 @@ cwmWalletEventAsETH (BREthereumClientContext context,
 
                     BRCryptoFeeBasis feeBasis = cryptoFeeBasisCreateAsETH (feeUnit, event.u.feeEstimate.gasEstimate, event.u.feeEstimate.gasPrice);
 
-                    cwm->listener.walletEventCallback(cwm->listener.context,
-                                                      cryptoWalletManagerTake(cwm),
-                                                      wallet,
-                                                      (BRCryptoWalletEvent) {
-                                                           CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
-                                                           { .feeBasisEstimated = {
-                                                               CRYPTO_SUCCESS,
-                                                               event.u.feeEstimate.cookie,
-                                                               feeBasis
-                                                           }}
-                                                       });
+                    cryptoWalletManagerListenerWalletEvent(cwm,
+                                                           cryptoWalletManagerTake(cwm),
+                                                           wallet,
+                                                           (BRCryptoWalletEvent) {
+                                                                CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
+                                                                { .feeBasisEstimated = {
+                                                                    CRYPTO_SUCCESS,
+                                                                    event.u.feeEstimate.cookie,
+                                                                    feeBasis
+                                                                }}
+                                                            });
 
                     cryptoUnitGive (feeUnit);
                 } else {
-                    cwm->listener.walletEventCallback(cwm->listener.context,
-                                                      cryptoWalletManagerTake(cwm),
-                                                      wallet,
-                                                      (BRCryptoWalletEvent) {
-                                                           CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
-                                                           { .feeBasisEstimated = {
-                                                               cryptoStatusFromETH (event.status),
-                                                               event.u.feeEstimate.cookie,
-                                                           }}
-                                                       });
+                    cryptoWalletManagerListenerWalletEvent(cwm,
+                                                           cryptoWalletManagerTake(cwm),
+                                                           wallet,
+                                                           (BRCryptoWalletEvent) {
+                                                                CRYPTO_WALLET_EVENT_FEE_BASIS_ESTIMATED,
+                                                                { .feeBasisEstimated = {
+                                                                    cryptoStatusFromETH (event.status),
+                                                                    event.u.feeEstimate.cookie,
+                                                                }}
+                                                            });
                 }
             }
             break;
@@ -1125,20 +1125,20 @@ cwmWalletEventAsETH (BREthereumClientContext context,
         case WALLET_EVENT_DELETED:
             if (NULL != wallet) {
                 // Generate a CRYPTO wallet manager event for WALLET_DELETED...
-                cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                          cryptoWalletManagerTake (cwm),
-                                                          (BRCryptoWalletManagerEvent) {
-                                                              CRYPTO_WALLET_MANAGER_EVENT_WALLET_DELETED,
-                                                              { .wallet = { cryptoWalletTake (wallet) }}
-                                                          });
+                cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                               cryptoWalletManagerTake (cwm),
+                                                               (BRCryptoWalletManagerEvent) {
+                                                                   CRYPTO_WALLET_MANAGER_EVENT_WALLET_DELETED,
+                                                                   { .wallet = { cryptoWalletTake (wallet) }}
+                                                               });
 
                 // ... and then a CRYPTO wallet event for DELETED.
-                cwm->listener.walletEventCallback (cwm->listener.context,
-                                                   cryptoWalletManagerTake (cwm),
-                                                   wallet,
-                                                   (BRCryptoWalletEvent) {
-                                                       CRYPTO_WALLET_EVENT_DELETED
-                                                   });
+                cryptoWalletManagerListenerWalletEvent (cwm,
+                                                        cryptoWalletManagerTake (cwm),
+                                                        wallet,
+                                                        (BRCryptoWalletEvent) {
+                                                            CRYPTO_WALLET_EVENT_DELETED
+                                                        });
             }
             break;
     }
@@ -1222,23 +1222,23 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
                                                       tid,
                                                       NULL); // taken
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CREATED
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CREATED
+                                                          });
 
                 cryptoWalletAddTransfer (wallet, transfer);
 
-                cwm->listener.walletEventCallback (cwm->listener.context,
-                                                   cryptoWalletManagerTake (cwm),
-                                                   cryptoWalletTake (wallet),
-                                                   (BRCryptoWalletEvent) {
-                                                       CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
-                                                       { .transfer = { cryptoTransferTake (transfer) }}
-                                                   });
+                cryptoWalletManagerListenerWalletEvent (cwm,
+                                                        cryptoWalletManagerTake (cwm),
+                                                        cryptoWalletTake (wallet),
+                                                        (BRCryptoWalletEvent) {
+                                                            CRYPTO_WALLET_EVENT_TRANSFER_ADDED,
+                                                            { .transfer = { cryptoTransferTake (transfer) }}
+                                                        });
 
                 cryptoUnitGive (unitForFee);
                 cryptoUnitGive (unit);
@@ -1252,16 +1252,16 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
                 BRCryptoTransferState oldState = cryptoTransferGetState (transfer);
                 BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SIGNED);
 
-                cryptoTransferSetState (transfer, newState);
+                cryptoWalletSetTransferState (wallet, transfer, newState);
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
             }
             break;
         }
@@ -1272,16 +1272,16 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
                 BRCryptoTransferState oldState = cryptoTransferGetState (transfer);
                 BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_SUBMITTED);
 
-                cryptoTransferSetState (transfer, newState);
+                cryptoWalletSetTransferState (wallet, transfer, newState);
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
             }
             break;
         }
@@ -1312,16 +1312,16 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
                 cryptoFeeBasisGive (feeBasisConfirmed);
                 cryptoUnitGive (unit);
 
-                cryptoTransferSetState (transfer, newState);
+                cryptoWalletSetTransferState (wallet, transfer, newState);
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
             }
             break;
         }
@@ -1332,16 +1332,16 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
                 BRCryptoTransferState oldState = cryptoTransferGetState (transfer);
                 BRCryptoTransferState newState = cryptoTransferStateErroredInit (cryptoTransferSubmitErrorUnknown ());
 
-                cryptoTransferSetState (transfer, newState);
+                cryptoWalletSetTransferState (wallet, transfer, newState);
 
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
             }
             break;
         }
@@ -1357,36 +1357,36 @@ cwmTransactionEventAsETH (BREthereumClientContext context,
                 cryptoWalletRemTransfer (wallet, transfer);
 
                 // Deleted from wallet
-                cwm->listener.walletEventCallback (cwm->listener.context,
-                                                   cryptoWalletManagerTake (cwm),
-                                                   cryptoWalletTake (wallet),
-                                                   (BRCryptoWalletEvent) {
-                                                       CRYPTO_WALLET_EVENT_TRANSFER_DELETED,
-                                                       { .transfer = { cryptoTransferTake (transfer) }}
-                                                   });
+                cryptoWalletManagerListenerWalletEvent (cwm,
+                                                        cryptoWalletManagerTake (cwm),
+                                                        cryptoWalletTake (wallet),
+                                                        (BRCryptoWalletEvent) {
+                                                            CRYPTO_WALLET_EVENT_TRANSFER_DELETED,
+                                                            { .transfer = { cryptoTransferTake (transfer) }}
+                                                        });
 
                 // State changed
                 BRCryptoTransferState oldState = cryptoTransferGetState (transfer);
                 BRCryptoTransferState newState = cryptoTransferStateInit (CRYPTO_TRANSFER_STATE_DELETED);
 
-                cryptoTransferSetState (transfer, newState);
-
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_CHANGED,
-                                                         { .state = { oldState, newState }}
-                                                     });
-
-                cwm->listener.transferEventCallback (cwm->listener.context,
-                                                     cryptoWalletManagerTake (cwm),
-                                                     cryptoWalletTake (wallet),
-                                                     cryptoTransferTake (transfer),
-                                                     (BRCryptoTransferEvent) {
-                                                         CRYPTO_TRANSFER_EVENT_DELETED
-                                                     });
+                cryptoWalletSetTransferState (wallet, transfer, newState);
+
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_CHANGED,
+                                                              { .state = { oldState, newState }}
+                                                          });
+
+                cryptoWalletManagerListenerTransferEvent (cwm,
+                                                          cryptoWalletManagerTake (cwm),
+                                                          cryptoWalletTake (wallet),
+                                                          cryptoTransferTake (transfer),
+                                                          (BRCryptoTransferEvent) {
+                                                              CRYPTO_TRANSFER_EVENT_DELETED
+                                                          });
             }
             break;
         }
@@ -1808,12 +1808,12 @@ cwmAnnounceGetBlockNumberSuccess (OwnershipKept BRCryptoWalletManager cwm,
             BRCryptoNetwork network = cryptoWalletManagerGetNetwork(cwm);
             cryptoNetworkSetHeight (network, blockNumber);
 
-            cwm->listener.walletManagerEventCallback (cwm->listener.context,
-                                                      cryptoWalletManagerTake(cwm),
-                                                      ((BRCryptoWalletManagerEvent) {
-                CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED,
-                { .blockHeight = { blockNumber } }
-            }));
+            cryptoWalletManagerListenerWalletManagerEvent (cwm,
+                                                           cryptoWalletManagerTake(cwm),
+                                                           ((BRCryptoWalletManagerEvent) {
+                     CRYPTO_WALLET_MANAGER_EVENT_BLOCK_HEIGHT_UPDATED,
+                     { .blockHeight = { blockNumber } }
+                 }));
 
             cryptoNetworkGive(network);
             break;
@@ -2033,6 +2033,142 @@ cwmParseUInt256 (const char *string, bool *error) {
     return result;
 }
 
+// Complete a GEN transfer item: assign the state and attributes and handle the transfer.
+static void
+cwmAnnounceGetTransferItemGEN (BRCryptoWalletManager cwm,
+                               BRCryptoWallet wallet,
+                               BRGenericTransfer genTransfer,
+                               BRCryptoTransferStateType status,
+                               uint64_t blockTimestamp,
+                               uint64_t blockNumber,
+                               size_t attributesCount,
+                               OwnershipKept const char **attributeKeys,
+                               OwnershipKept const char **attributeVals) {
+    BRGenericWallet genWallet = cryptoWalletAsGEN(wallet);
+
+    genTransferSetState (genTransfer, cwmAnnounceGetTransferStateGEN (genTransfer, status, blockTimestamp, blockNumber));
+
+    // If we are passed in attribues, they will replace any attribute already held
+    // in `genTransfer`.  Specifically, for example, if we created an XRP transfer, then
+    // we might have a 'DestinationTag'.  If the attributes provided do not include
+    // 'DestinatinTag' then that attribute will be lost.  Losing such an attribute would
+    // indicate a BlockSet error in processing transfers.
+    if (attributesCount > 0) {
+        BRGenericAddress genTarget = genTransferGetTargetAddress (genTransfer);
+
+        // Build the transfer attributes
+        BRArrayOf(BRGenericTransferAttribute) genAttributes;
+        array_new(genAttributes, attributesCount);
+        for (size_t index = 0; index < attributesCount; index++) {
+            const char *keyFound;
+            BRCryptoBoolean isRequiredAttribute;
+            BRCryptoBoolean isAttribute = genWalletHasTransferAttributeForKey (genWallet,
+                                                                               genTarget,
+                                                                               attributeKeys[index],
+                                                                               &keyFound,
+                                                                               &isRequiredAttribute);
+            if (CRYPTO_TRUE == isAttribute)
+                array_add (genAttributes,
+                           genTransferAttributeCreate (keyFound,
+                                                       attributeVals[index],
+                                                       CRYPTO_TRUE == isRequiredAttribute));
+        }
+        genTransferSetAttributes(genTransfer, genAttributes);
+        genTransferAttributeReleaseAll(genAttributes);
+        genAddressRelease(genTarget);
+    }
+
+    // Announce to GWM.  Note: the equivalent BTC+ETH announce transaction is going to
+    // create BTC+ETH wallet manager + wallet + transfer events that we'll handle by
+    // incorporating the BTC+ETH transfer into 'crypto'.  However, GEN does not generate
+    // similar events.
+    //
+    // genManagerAnnounceTransfer (cwm->u.gen, callbackState->rid, transfer);
+    cryptoWalletManagerHandleTransferGEN (cwm, genTransfer);
+}
+
+// Announce an ETH transaction, or an ERC20 log if `walletCurrency` is a token, to the EWM.  The
+// `valueError` is TRUE if `value` could not be parsed; the transaction is then announced as errored.
+static void
+cwmAnnounceGetTransferItemETH (BRCryptoWalletManager cwm,
+                               BRCryptoClientCallbackState callbackState,
+                               BRCryptoCurrency walletCurrency,
+                               BRCryptoTransferStateType status,
+                               BREthereumHash hash,
+                               BREthereumAddress from,
+                               BREthereumAddress to,
+                               UInt256 value,
+                               bool valueError,
+                               uint64_t blockTimestamp,
+                               uint64_t blockNumber,
+                               uint64_t blockConfirmations,
+                               uint64_t blockTransactionIndex,
+                               BREthereumHash blockHash,
+                               size_t attributesCount,
+                               OwnershipKept const char **attributeKeys,
+                               OwnershipKept const char **attributeVals) {
+    bool error = valueError;
+
+    const char *contract = cryptoCurrencyGetIssuer(walletCurrency);
+    char *data     = "";
+    uint64_t gasLimit = cwmParseUInt64 (cwmLookupAttributeValueForKey ("gasLimit", attributesCount, attributeKeys, attributeVals), &error);
+    uint64_t gasUsed  = cwmParseUInt64 (cwmLookupAttributeValueForKey ("gasUsed",  attributesCount, attributeKeys, attributeVals), &error); // strtoull(strGasUsed, NULL, 0);
+    UInt256  gasPrice = cwmParseUInt256(cwmLookupAttributeValueForKey ("gasPrice", attributesCount, attributeKeys, attributeVals), &error);
+    uint64_t nonce    = cwmParseUInt64 (cwmLookupAttributeValueForKey ("nonce",    attributesCount, attributeKeys, attributeVals), &error);
+
+    error |= (CRYPTO_TRANSFER_STATE_ERRORED == status);
+
+    if (NULL != contract) {
+        // The ERC20 'Transfer' topics: the event selector and then the `from` and `to`
+        // addresses, each padded on the left to the 32 bytes of a topic.
+        size_t topicsCount = 3;
+        BREthereumLogTopic topics[3] = {
+            logTopicCreateFromString (ethEventGetSelector(ethEventERC20Transfer))
+        };
+        memset (topics[1].bytes, 0, sizeof (topics[1].bytes));
+        memset (topics[2].bytes, 0, sizeof (topics[2].bytes));
+        memcpy (&topics[1].bytes[LOG_TOPIC_BYTES_COUNT - ADDRESS_BYTES], from.bytes, ADDRESS_BYTES);
+        memcpy (&topics[2].bytes[LOG_TOPIC_BYTES_COUNT - ADDRESS_BYTES], to.bytes,   ADDRESS_BYTES);
+
+        size_t logIndex = 0;
+
+        // The log's data, like the original `data` of "", has a value of zero.
+        ewmAnnounceLogBinary (cwm->u.eth,
+                              callbackState->rid,
+                              hash,
+                              ethAddressCreate (contract),
+                              topicsCount,
+                              topics,
+                              UINT256_ZERO,
+                              gasPrice,
+                              gasUsed,
+                              logIndex,
+                              blockNumber,
+                              blockTransactionIndex,
+                              blockTimestamp);
+    }
+    else {
+        ewmAnnounceTransactionBinary (cwm->u.eth,
+                                      callbackState->rid,
+                                      hash,
+                                      from,
+                                      to,
+                                      EMPTY_ADDRESS_INIT,
+                                      value,
+                                      gasLimit,
+                                      gasPrice,
+                                      data,
+                                      nonce,
+                                      gasUsed,
+                                      blockNumber,
+                                      blockHash,
+                                      blockConfirmations,
+                                      blockTransactionIndex,
+                                      blockTimestamp,
+                                      error);
+    }
+}
+
 extern void
 cwmAnnounceGetTransferItem (BRCryptoWalletManager cwm,
                             BRCryptoClientCallbackState callbackState,
@@ -2071,129 +2207,152 @@ cwmAnnounceGetTransferItem (BRCryptoWalletManager cwm,
         switch (callbackState->type) {
             case CWM_CALLBACK_TYPE_GEN_GET_TRANSFERS: {
                 // Create a 'GEN' transfer
-                BRGenericWallet   genWallet   = cryptoWalletAsGEN(wallet);
-                BRGenericTransfer genTransfer = genManagerRecoverTransfer (cwm->u.gen, genWallet, hash, uids,
+                BRGenericTransfer genTransfer = genManagerRecoverTransfer (cwm->u.gen, cryptoWalletAsGEN(wallet), hash, uids,
                                                                            from, to,
                                                                            amount, currency, fee,
                                                                            blockTimestamp, blockNumber,
                                                                            CRYPTO_TRANSFER_STATE_ERRORED == status);
 
-                genTransferSetState (genTransfer, cwmAnnounceGetTransferStateGEN (genTransfer, status, blockTimestamp, blockNumber));
-
-                // If we are passed in attribues, they will replace any attribute already held
-                // in `genTransfer`.  Specifically, for example, if we created an XRP transfer, then
-                // we might have a 'DestinationTag'.  If the attributes provided do not include
-                // 'DestinatinTag' then that attribute will be lost.  Losing such an attribute would
-                // indicate a BlockSet error in processing transfers.
-                if (attributesCount > 0) {
-                    BRGenericAddress genTarget = genTransferGetTargetAddress (genTransfer);
-
-                    // Build the transfer attributes
-                    BRArrayOf(BRGenericTransferAttribute) genAttributes;
-                    array_new(genAttributes, attributesCount);
-                    for (size_t index = 0; index < attributesCount; index++) {
-                        const char *keyFound;
-                        BRCryptoBoolean isRequiredAttribute;
-                        BRCryptoBoolean isAttribute = genWalletHasTransferAttributeForKey (genWallet,
-                                                                                           genTarget,
-                                                                                           attributeKeys[index],
-                                                                                           &keyFound,
-                                                                                           &isRequiredAttribute);
-                        if (CRYPTO_TRUE == isAttribute)
-                            array_add (genAttributes,
-                                       genTransferAttributeCreate (keyFound,
-                                                                   attributeVals[index],
-                                                                   CRYPTO_TRUE == isRequiredAttribute));
-                    }
-                    genTransferSetAttributes(genTransfer, genAttributes);
-                    genTransferAttributeReleaseAll(genAttributes);
-                    genAddressRelease(genTarget);
-                }
-
-                // Announce to GWM.  Note: the equivalent BTC+ETH announce transaction is going to
-                // create BTC+ETH wallet manager + wallet + transfer events that we'll handle by
-                // incorporating the BTC+ETH transfer into 'crypto'.  However, GEN does not generate
-                // similar events.
-                //
-                // genManagerAnnounceTransfer (cwm->u.gen, callbackState->rid, transfer);
-                cryptoWalletManagerHandleTransferGEN (cwm, genTransfer);
+                cwmAnnounceGetTransferItemGEN (cwm, wallet, genTransfer, status,
+                                               blockTimestamp, blockNumber,
+                                               attributesCount, attributeKeys, attributeVals);
                 break;
             }
 
             case CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS: {
                 bool error = false;
-
                 UInt256 value = cwmParseUInt256 (amount, &error);
 
-                const char *contract = cryptoCurrencyGetIssuer(walletCurrency);
-                char *data     = "";
-                uint64_t gasLimit = cwmParseUInt64 (cwmLookupAttributeValueForKey ("gasLimit", attributesCount, attributeKeys, attributeVals), &error);
-                uint64_t gasUsed  = cwmParseUInt64 (cwmLookupAttributeValueForKey ("gasUsed",  attributesCount, attributeKeys, attributeVals), &error); // strtoull(strGasUsed, NULL, 0);
-                UInt256  gasPrice = cwmParseUInt256(cwmLookupAttributeValueForKey ("gasPrice", attributesCount, attributeKeys, attributeVals), &error);
-                uint64_t nonce    = cwmParseUInt64 (cwmLookupAttributeValueForKey ("nonce",    attributesCount, attributeKeys, attributeVals), &error);
+                cwmAnnounceGetTransferItemETH (cwm, callbackState, walletCurrency, status,
+                                               ethHashCreate (hash),
+                                               ethAddressCreate (from),
+                                               ethAddressCreate (to),
+                                               value,
+                                               error,
+                                               blockTimestamp,
+                                               blockNumber,
+                                               blockConfirmations,
+                                               blockTransactionIndex,
+                                               ethHashCreate (blockHash),
+                                               attributesCount, attributeKeys, attributeVals);
+                break;
+            }
 
-                error |= (CRYPTO_TRANSFER_STATE_ERRORED == status);
+            default: assert (0);
+        }
+    }
+    
+    if (NULL != wallet) cryptoWalletGive (wallet);
+    if (NULL != walletCurrency) cryptoCurrencyGive (walletCurrency);
 
-                if (NULL != contract) {
-                    size_t topicsCount = 3;
-                    char *topics[3] = {
-                        (char *) ethEventGetSelector(ethEventERC20Transfer),
-                        ethEventERC20TransferEncodeAddress (ethEventERC20Transfer, from),
-                        ethEventERC20TransferEncodeAddress (ethEventERC20Transfer, to)
-                    };
+    cryptoNetworkGive (network);
+    cryptoWalletManagerGive (cwm);
+    // DON'T free (callbackState);
+}
 
-                    size_t logIndex = 0;
+// A UInt256 from 32 big-endian bytes
+static UInt256
+cwmCreateUInt256 (const uint8_t bytes[32]) {
+    UInt256 value;
+    for (size_t index = 0; index < 32; index++)
+        value.u8[index] = bytes[31 - index];
+    return value;
+}
 
-                    ewmAnnounceLog (cwm->u.eth,
-                                    callbackState->rid,
-                                    hash,
-                                    contract,
-                                    topicsCount,
-                                    (const char **) &topics[0],
-                                    data,
-                                    gasPrice,
-                                    gasUsed,
-                                    logIndex,
-                                    blockNumber,
-                                    blockTransactionIndex,
-                                    blockTimestamp);
+extern BRCryptoBoolean
+cwmAnnounceGetTransferItemBinary (BRCryptoWalletManager cwm,
+                                  BRCryptoClientCallbackState callbackState,
+                                  BRCryptoTransferStateType status,
+                                  OwnershipKept const uint8_t *hash,
+                                  size_t hashCount,
+                                  OwnershipKept const char *uids,
+                                  OwnershipKept const uint8_t *from,
+                                  size_t fromCount,
+                                  OwnershipKept const uint8_t *to,
+                                  size_t toCount,
+                                  OwnershipKept const uint8_t *amount,
+                                  OwnershipKept BRCryptoCurrency currency,
+                                  OwnershipKept const uint8_t *fee,
+                                  uint64_t blockTimestamp,
+                                  uint64_t blockNumber,
+                                  uint64_t blockConfirmations,
+                                  uint64_t blockTransactionIndex,
+                                  OwnershipKept const uint8_t *blockHash,
+                                  size_t blockHashCount,
+                                  size_t attributesCount,
+                                  OwnershipKept const char **attributeKeys,
+                                  OwnershipKept const char **attributeVals) {
+    assert (cwm); assert (callbackState); assert (currency);
+    assert (CWM_CALLBACK_TYPE_GEN_GET_TRANSFERS    == callbackState->type ||
+            CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS == callbackState->type);
+    cwm = cryptoWalletManagerTake (cwm);
 
-                    free (topics[1]);
-                    free (topics[2]);
-                }
-                else {
-                    ewmAnnounceTransaction (cwm->u.eth,
-                                            callbackState->rid,
-                                            hash,
-                                            from,
-                                            to,
-                                            contract,
-                                            value,
-                                            gasLimit,
-                                            gasPrice,
-                                            data,
-                                            nonce,
-                                            gasUsed,
-                                            blockNumber,
-                                            blockHash,
-                                            blockConfirmations,
-                                            blockTransactionIndex,
-                                            blockTimestamp,
-                                            error);
-                }
+    BRCryptoBoolean success = CRYPTO_TRUE;
+
+    // Find the corresponding wallet; no lookup of `currency` by uids is needed.
+    BRCryptoWallet wallet = cryptoWalletManagerGetWalletForCurrency (cwm, currency);
+
+    // If we have a wallet, then proceed
+    if (NULL != wallet) {
+        switch (callbackState->type) {
+            case CWM_CALLBACK_TYPE_GEN_GET_TRANSFERS: {
+                // Create a 'GEN' transfer
+                BRGenericTransfer genTransfer = genManagerRecoverTransferBinary (cwm->u.gen, cryptoWalletAsGEN(wallet),
+                                                                                 hash, hashCount, uids,
+                                                                                 from, fromCount,
+                                                                                 to, toCount,
+                                                                                 cwmCreateUInt256 (amount),
+                                                                                 (NULL == fee ? UINT256_ZERO : cwmCreateUInt256 (fee)),
+                                                                                 blockTimestamp, blockNumber,
+                                                                                 CRYPTO_TRANSFER_STATE_ERRORED == status);
+
+                // ... malformed, or beyond the network's range; skip it
+                if (NULL == genTransfer) { success = CRYPTO_FALSE; break; }
+
+                cwmAnnounceGetTransferItemGEN (cwm, wallet, genTransfer, status,
+                                               blockTimestamp, blockNumber,
+                                               attributesCount, attributeKeys, attributeVals);
+                break;
+            }
+
+            case CWM_CALLBACK_TYPE_ETH_GET_TRANSACTIONS: {
+                if (NULL == hash || ETHEREUM_HASH_BYTES != hashCount ||
+                    NULL == from || ADDRESS_BYTES != fromCount ||
+                    NULL == to   || ADDRESS_BYTES != toCount) { success = CRYPTO_FALSE; break; }
+
+                BREthereumHash ethHash, ethBlockHash = ethHashCreateEmpty();
+                BREthereumAddress ethFrom, ethTo;
+                memcpy (ethHash.bytes, hash, ETHEREUM_HASH_BYTES);
+                memcpy (ethFrom.bytes, from, ADDRESS_BYTES);
+                memcpy (ethTo.bytes,   to,   ADDRESS_BYTES);
+                if (NULL != blockHash && ETHEREUM_HASH_BYTES == blockHashCount)
+                    memcpy (ethBlockHash.bytes, blockHash, ETHEREUM_HASH_BYTES);
+
+                cwmAnnounceGetTransferItemETH (cwm, callbackState, currency, status,
+                                               ethHash,
+                                               ethFrom,
+                                               ethTo,
+                                               cwmCreateUInt256 (amount),
+                                               false,
+                                               blockTimestamp,
+                                               blockNumber,
+                                               blockConfirmations,
+                                               blockTransactionIndex,
+                                               ethBlockHash,
+                                               attributesCount, attributeKeys, attributeVals);
                 break;
             }
 
             default: assert (0);
         }
     }
-    
+
     if (NULL != wallet) cryptoWalletGive (wallet);
-    if (NULL != walletCurrency) cryptoCurrencyGive (walletCurrency);
 
-    cryptoNetworkGive (network);
     cryptoWalletManagerGive (cwm);
     // DON'T free (callbackState);
+
+    return success;
 }
 
 extern void
@@ -2214,13 +2373,13 @@ cwmAnnounceGetTransfersComplete (OwnershipKept BRCryptoWalletManager cwm,
             // Synchronizing of transfers is complete - calculate the new balance
             BRCryptoAmount balance = cryptoWalletGetBalance(cwm->wallet);
             // ... and announce the balance
-            cwm->listener.walletEventCallback (cwm->listener.context,
-                                               cryptoWalletManagerTake (cwm),
-                                               cryptoWalletTake (cwm->wallet),
-                                               (BRCryptoWalletEvent) {
-                                                   CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
-                                                   { .balanceUpdated = { cryptoAmountTake(balance) }}
-                                               });
+            cryptoWalletManagerListenerWalletEvent (cwm,
+                                                    cryptoWalletManagerTake (cwm),
+                                                    cryptoWalletTake (cwm->wallet),
+                                                    (BRCryptoWalletEvent) {
+                                                        CRYPTO_WALLET_EVENT_BALANCE_UPDATED,
+                                                        { .balanceUpdated = { cryptoAmountTake(balance) }}
+                                                    });
 
             cryptoAmountGive(balance);
             break;
@@ -13,6 +13,10 @@
 
 #include <pthread.h>
 
+#include "support/BRSet.h"
+#include "support/BRProfile.h"
+#include "support/BRMetrics.h"
+
 #include "BRCryptoBase.h"
 #include "BRCryptoNetwork.h"
 #include "BRCryptoAccount.h"
@@ -27,6 +31,30 @@
 extern "C" {
 #endif
 
+/// A ring buffer of listener events, with an index of the queued events that a later event
+/// would supersede.
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+
+    BRCryptoBoolean enabled;
+    BRCryptoCWMListenerBatching batching;
+
+    struct BRCryptoCWMListenerSlotRecord *slots;
+    size_t slotsCapacity;
+    size_t slotsHead;
+    size_t slotsCount;
+
+    /// The number of `slots` with an event that has not been superseded
+    size_t eventsCount;
+
+    /// The queued events that can be superseded; a BRSet of slot pointers
+    BRSet *coalescable;
+
+    /// Delivers batches when `batching.batchCallback` is set
+    struct BRCryptoCWMListenerThreadRecord *thread;
+} BRCryptoCWMListenerQueue;
+
 struct BRCryptoWalletManagerRecord {
     pthread_mutex_t lock;
 
@@ -38,6 +66,9 @@ struct BRCryptoWalletManagerRecord {
     } u;
 
     BRCryptoCWMListener listener;
+
+    /// Queued listener events, when batching; see `cryptoWalletManagerSetListenerBatching()`
+    BRCryptoCWMListenerQueue listenerQueue;
     BRCryptoClient client;
     BRCryptoNetwork network;
     BRCryptoAccount account;
@@ -52,6 +83,13 @@ struct BRCryptoWalletManagerRecord {
     BRArrayOf(BRCryptoWallet) wallets;
     char *path;
 
+    /// The phases of `cryptoWalletManagerCreate()`; see `cryptoWalletManagerGetStartupPhases()`
+    BRProfile startupProfile;
+
+    /// The counters and histograms of the BWM, EWM or GWM subsystems; see
+    /// `cryptoWalletManagerGetMetricCounters()`
+    BRMetrics metrics;
+
     BRCryptoRef ref;
 };
 
@@ -77,6 +115,28 @@ private_extern void
 cryptoWalletManagerSetState (BRCryptoWalletManager cwm,
                              BRCryptoWalletManagerState state);
 
+/// MARK: - Listener
+
+/// Announce events to the listener, or queue them if batching.  The references are as for the
+/// corresponding BRCryptoCWMListener callback.
+private_extern void
+cryptoWalletManagerListenerWalletManagerEvent (BRCryptoWalletManager cwm,
+                                               BRCryptoWalletManager manager,
+                                               BRCryptoWalletManagerEvent event);
+
+private_extern void
+cryptoWalletManagerListenerWalletEvent (BRCryptoWalletManager cwm,
+                                        BRCryptoWalletManager manager,
+                                        BRCryptoWallet wallet,
+                                        BRCryptoWalletEvent event);
+
+private_extern void
+cryptoWalletManagerListenerTransferEvent (BRCryptoWalletManager cwm,
+                                          BRCryptoWalletManager manager,
+                                          BRCryptoWallet wallet,
+                                          BRCryptoTransfer transfer,
+                                          BRCryptoTransferEvent event);
+
 
 private_extern void
 cryptoWalletManagerStop (BRCryptoWalletManager cwm);
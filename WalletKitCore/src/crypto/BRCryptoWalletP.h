@@ -26,6 +26,11 @@
 extern "C" {
 #endif
 
+/// A transfer and its cursor, as of the last time a wallet's transfers were ordered.
+typedef struct {
+    BRCryptoWalletTransferCursor cursor;
+    BRCryptoTransfer transfer;      // not taken; `transfers` holds the reference
+} BRCryptoWalletTransferOrdered;
 
 struct BRCryptoWalletRecord {
     pthread_mutex_t lock;
@@ -62,6 +67,12 @@ struct BRCryptoWalletRecord {
     //
     BRArrayOf (BRCryptoTransfer) transfers;
 
+    /// The `transfers` in cursor order, for `cryptoWalletGetTransfersPage()`; `transfers` itself
+    /// stays in the order added.  Rebuilt on the next page after a transfer is added or removed,
+    /// or after one of this wallet's transfers changes its included position.
+    BRArrayOf (BRCryptoWalletTransferOrdered) transfersOrdered;
+    int transfersOrderDirty;
+
     BRCryptoRef ref;
 };
 
@@ -118,6 +129,13 @@ cryptoWalletAddTransfer (BRCryptoWallet wallet, BRCryptoTransfer transfer);
 private_extern void
 cryptoWalletRemTransfer (BRCryptoWallet wallet, BRCryptoTransfer transfer);
 
+/// Set the state of `transfer`, one of `wallet`'s, and reorder the wallet's transfers if the
+/// transfer's included position changed.
+private_extern void
+cryptoWalletSetTransferState (BRCryptoWallet wallet,
+                              BRCryptoTransfer transfer,
+                              BRCryptoTransferState state);
+
 /// MARK: - Wallet Sweeper
 
 private_extern BRWalletSweeper
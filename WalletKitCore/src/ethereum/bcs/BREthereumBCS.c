@@ -303,6 +303,24 @@ bcsCreate (BREthereumNetwork network,
     return bcs;
 }
 
+extern void
+bcsSetMetrics (BREthereumBCS bcs,
+               BRMetrics metrics) {
+    if (NULL != bcs->les) lesSetMetrics (bcs->les, metrics);
+}
+
+extern void
+bcsSetCapture (BREthereumBCS bcs,
+               BRCapture capture) {
+    if (NULL != bcs->les) lesSetCapture (bcs->les, capture);
+}
+
+extern void
+bcsSetReplay (BREthereumBCS bcs,
+              BRCaptureReplay replay) {
+    if (NULL != bcs->les) lesSetReplay (bcs->les, replay);
+}
+
 extern void
 bcsStart (BREthereumBCS bcs) {
     eventHandlerStart(bcs->handler);
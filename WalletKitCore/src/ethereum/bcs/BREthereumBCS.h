@@ -167,6 +167,25 @@ bcsCreate (BREthereumNetwork network,
            BRSetOf(BREthereumTransaction) transactions,
            BRSetOf(BREthereumLog) logs);
 
+/**
+ * Record the BCS metrics (currently, those of LES) in `metrics`
+ */
+extern void
+bcsSetMetrics (BREthereumBCS bcs,
+               BRMetrics metrics);
+
+/**
+ * Capture the LES node messages to `capture`, or replay them from `replay`, so that a sync can be
+ * repeated offline.  See lesSetCapture() and lesSetReplay().  Set before bcsStart().
+ */
+extern void
+bcsSetCapture (BREthereumBCS bcs,
+               BRCapture capture);
+
+extern void
+bcsSetReplay (BREthereumBCS bcs,
+              BRCaptureReplay replay);
+
 extern void
 bcsStart (BREthereumBCS bcs);
 
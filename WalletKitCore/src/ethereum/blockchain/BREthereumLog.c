@@ -8,6 +8,7 @@
 //  See the LICENSE file at the project root for license information.
 //  See the CONTRIBUTORS file at the project root for a list of contributors.
 
+#include <limits.h>
 #include "support/BRArray.h"
 #include "BREthereumLog.h"
 
@@ -107,20 +108,6 @@ logTopicAsAddress (BREthereumLogTopic topic) {
 //
 // Support
 //
-static BREthereumLogTopic
-logTopicRlpDecode (BRRlpItem item,
-                       BRRlpCoder coder) {
-    BREthereumLogTopic topic;
-
-    BRRlpData data = rlpDecodeBytes(coder, item);
-    assert (32 == data.bytesCount);
-
-    memcpy (topic.bytes, data.bytes, 32);
-    rlpDataRelease(data);
-
-    return topic;
-}
-
 static BRRlpItem
 logTopicRlpEncode(BREthereumLogTopic topic,
                       BRRlpCoder coder) {
@@ -129,12 +116,58 @@ logTopicRlpEncode(BREthereumLogTopic topic,
 
 static BREthereumLogTopic emptyTopic;
 
-static BRArrayOf(BREthereumLogTopic)
-logTopicsCopy (BRArrayOf(BREthereumLogTopic) topics) {
-    BRArrayOf(BREthereumLogTopic) copy;
-    array_new(copy, array_count(topics));
-    array_add_array(copy, topics, array_count(topics));
-    return copy;
+//
+// Known Topics
+//
+
+/**
+ * Topic-0 of a log is, by Solidity convention, the Keccak256 hash of the event signature.  Nearly
+ * every log held by a wallet is an ERC20 (or ERC721) Transfer or Approval and thus shares one of
+ * a handful of topic-0 values.  A log whose topic-0 is listed here references the entry and does
+ * not store the topic itself.
+ */
+static const struct {
+    const char *signature;
+    BREthereumLogTopic topic;
+} logTopicsKnown[] = {
+    { "Transfer(address,address,uint256)",
+        { { 0xdd, 0xf2, 0x52, 0xad, 0x1b, 0xe2, 0xc8, 0x9b, 0x69, 0xc2, 0xb0, 0x68, 0xfc, 0x37, 0x8d, 0xaa,
+            0x95, 0x2b, 0xa7, 0xf1, 0x63, 0xc4, 0xa1, 0x16, 0x28, 0xf5, 0x5a, 0x4d, 0xf5, 0x23, 0xb3, 0xef } } },
+    { "Approval(address,address,uint256)",
+        { { 0x8c, 0x5b, 0xe1, 0xe5, 0xeb, 0xec, 0x7d, 0x5b, 0xd1, 0x4f, 0x71, 0x42, 0x7d, 0x1e, 0x84, 0xf3,
+            0xdd, 0x03, 0x14, 0xc0, 0xf7, 0xb2, 0x29, 0x1e, 0x5b, 0x20, 0x0a, 0xc8, 0xc7, 0xc3, 0xb9, 0x25 } } },
+    { "Deposit(address,uint256)",
+        { { 0xe1, 0xff, 0xfc, 0xc4, 0x92, 0x3d, 0x04, 0xb5, 0x59, 0xf4, 0xd2, 0x9a, 0x8b, 0xfc, 0x6c, 0xda,
+            0x04, 0xeb, 0x5b, 0x0d, 0x3c, 0x46, 0x07, 0x51, 0xc2, 0x40, 0x2c, 0x5c, 0x5c, 0xc9, 0x10, 0x9c } } },
+    { "Withdrawal(address,uint256)",
+        { { 0x7f, 0xcf, 0x53, 0x2c, 0x15, 0xf0, 0xa6, 0xdb, 0x0b, 0xd6, 0xd0, 0xe0, 0x38, 0xbe, 0xa7, 0x1d,
+            0x30, 0xd8, 0x08, 0xc7, 0xd9, 0x8c, 0xb3, 0xbf, 0x72, 0x68, 0xa9, 0x5b, 0xf5, 0x08, 0x1b, 0x65 } } },
+    { "ApprovalForAll(address,address,bool)",
+        { { 0x17, 0x30, 0x7e, 0xab, 0x39, 0xab, 0x61, 0x07, 0xe8, 0x89, 0x98, 0x45, 0xad, 0x3d, 0x59, 0xbd,
+            0x96, 0x53, 0xf2, 0x00, 0xf2, 0x20, 0x92, 0x04, 0x89, 0xca, 0x2b, 0x59, 0x37, 0x69, 0x6c, 0x31 } } },
+};
+
+#define LOG_TOPICS_KNOWN_COUNT      (sizeof (logTopicsKnown) / sizeof (logTopicsKnown[0]))
+
+static const BREthereumLogTopic *
+logTopicLookupKnown (const uint8_t *bytes) {
+    for (size_t index = 0; index < LOG_TOPICS_KNOWN_COUNT; index++)
+        if (0 == memcmp (logTopicsKnown[index].topic.bytes, bytes, LOG_TOPIC_BYTES_COUNT))
+            return &logTopicsKnown[index].topic;
+    return NULL;
+}
+
+extern size_t
+logTopicGetKnownCount (void) {
+    return LOG_TOPICS_KNOWN_COUNT;
+}
+
+extern const char *
+logTopicGetKnown (size_t index,
+                  BREthereumLogTopic *topic) {
+    assert (index < LOG_TOPICS_KNOWN_COUNT);
+    if (NULL != topic) *topic = logTopicsKnown[index].topic;
+    return logTopicsKnown[index].signature;
 }
 
 //
@@ -154,16 +187,6 @@ struct BREthereumLogRecord {
      */
     BREthereumAddress address;
 
-    /**
-     * a series of 32-byte log topics, Ot;
-     */
-    BRArrayOf(BREthereumLogTopic) topics;
-
-    /**
-     * and some number of bytes of data, Od
-     */
-    BRRlpData data;
-
     /**
      * A unique identifer - derived from the transactionHash and the transactionReceiptIndex
      */
@@ -186,29 +209,100 @@ struct BREthereumLogRecord {
      * status
      */
     BREthereumTransactionStatus status;
+
+    /**
+     * If topic-0 is a known topic, its entry in `logTopicsKnown`; otherwise NULL and topic-0, if
+     * any, is the first of `topics`.
+     */
+    const BREthereumLogTopic *topicKnown;
+
+    /**
+     * a series of 32-byte log topics, Ot; the count includes `topicKnown`
+     */
+    unsigned int topicsCount;
+
+    /**
+     * and some number of bytes of data, Od.  The bytes, being the RLP encoding of the data,
+     * follow `topics`.
+     */
+    size_t dataCount;
+
+    /**
+     * The topics, less `topicKnown`, and then the data - all in the log's one allocation.
+     */
+    BREthereumLogTopic topics[];
 };
 
+static inline size_t
+logTopicsInlineCount (BREthereumLog log) {
+    return log->topicsCount - (NULL == log->topicKnown ? 0 : 1);
+}
+
+static inline uint8_t *
+logDataBytes (BREthereumLog log) {
+    return (uint8_t *) &log->topics[logTopicsInlineCount (log)];
+}
+
+static inline size_t
+logAllocationSize (size_t topicsInlineCount,
+                   size_t dataCount) {
+    return (sizeof (struct BREthereumLogRecord)
+            + topicsInlineCount * sizeof (BREthereumLogTopic)
+            + dataCount);
+}
+
+static inline const BREthereumLogTopic *
+logTopicAt (BREthereumLog log, size_t index) {
+    return (NULL == log->topicKnown
+            ? &log->topics[index]
+            : (0 == index ? log->topicKnown : &log->topics[index - 1]));
+}
+
+/**
+ * Allocate a log with room for `topicsCount` topics, less `topicKnown`, and `dataCount` bytes of
+ * data.  The caller fills in the topics and the data.
+ */
+static BREthereumLog
+logCreateAllocate (BREthereumAddress address,
+                   size_t topicsCount,
+                   const BREthereumLogTopic *topicKnown,
+                   size_t dataCount) {
+    assert (topicsCount <= UINT_MAX);
+    size_t topicsInlineCount = topicsCount - (NULL == topicKnown ? 0 : 1);
+
+    BREthereumLog log = calloc (1, logAllocationSize (topicsInlineCount, dataCount));
+
+    log->hash = ethHashCreateEmpty();
+    log->address = address;
+    log->topicKnown  = topicKnown;
+    log->topicsCount = (unsigned int) topicsCount;
+    log->dataCount   = dataCount;
+
+    // Mark the `identifier` as unknown.
+    log->identifier.transactionReceiptIndex = LOG_TRANSACTION_RECEIPT_INDEX_UNKNOWN;
+
+    return log;
+}
+
 extern BREthereumLog
 logCreate (BREthereumAddress address,
            unsigned int topicsCount,
            BREthereumLogTopic *topics,
            BRRlpData data) {
-    BREthereumLog log = calloc (1, sizeof(struct BREthereumLogRecord));
-
-    log->hash = ethHashCreateEmpty();
-    log->address = address;
-
-    array_new(log->topics, topicsCount);
-    for (size_t index = 0; index < topicsCount; index++)
-        array_add (log->topics, topics[index]);
+    const BREthereumLogTopic *topicKnown = (topicsCount > 0 ? logTopicLookupKnown (topics[0].bytes) : NULL);
+    size_t topicsSkipped = (NULL == topicKnown ? 0 : 1);
 
-    // RLP Decoded (see below) performs: log->data = rlpDecodeBytes(coder, items[2]);
+    // RLP Decoded (see below) performs: log->data = rlpItemGetData(coder, items[2]);
     // We'll assume `data` has the proper form....
+    size_t dataCount = (NULL == data.bytes ? 0 : data.bytesCount);
 
-    log->data = rlpDataCopy(data);
+    BREthereumLog log = logCreateAllocate (address, topicsCount, topicKnown, dataCount);
 
-    // Mark the `identifier` as unknown.
-    log->identifier.transactionReceiptIndex = LOG_TRANSACTION_RECEIPT_INDEX_UNKNOWN;
+    if (topicsCount > topicsSkipped)
+        memcpy (log->topics, &topics[topicsSkipped], (topicsCount - topicsSkipped) * sizeof (BREthereumLogTopic));
+
+    if (dataCount > 0)
+        memcpy (logDataBytes (log), data.bytes, dataCount);
 
     return log;
 }
@@ -310,24 +404,24 @@ logHasAddress (BREthereumLog log,
 
 extern size_t
 logGetTopicsCount (BREthereumLog log) {
-    return array_count(log->topics);
+    return log->topicsCount;
 }
 
 extern  BREthereumLogTopic
 logGetTopic (BREthereumLog log, size_t index) {
-    return (index < array_count(log->topics)
-            ? log->topics[index]
+    return (index < log->topicsCount
+            ? *logTopicAt (log, index)
             : emptyTopic);
 }
 
 extern BRRlpData
 logGetData (BREthereumLog log) {
-    return rlpDataCopy(log->data);
+    return rlpDataCopy ((BRRlpData) { log->dataCount, logDataBytes (log) });
 }
 
 extern BRRlpData
 logGetDataShared (BREthereumLog log) {
-    return log->data;
+    return (BRRlpData) { log->dataCount, logDataBytes (log) };
 }
 
 extern BREthereumBoolean
@@ -337,7 +431,7 @@ logMatchesAddress (BREthereumLog log,
     int match = 0;
     size_t count = logGetTopicsCount(log);
     for (int i = 0; i < count; i++)
-        match |= logTopicMatchesAddressBool(log->topics[i], address);
+        match |= logTopicMatchesAddressBool(*logTopicAt (log, i), address);
 
     return (ETHEREUM_BOOLEAN_IS_TRUE(topicsOnly)
             ? AS_ETHEREUM_BOOLEAN(match)
@@ -377,11 +471,7 @@ logHashEqual (const void *l1, const void *l2) {
 
 extern void
 logRelease (BREthereumLog log) {
-    if (NULL != log) {
-        array_free(log->topics);
-        rlpDataRelease(log->data);
-        free (log);
-    }
+    if (NULL != log) free (log);
 }
 
 extern void
@@ -401,14 +491,11 @@ logReleaseForSet (void *ignore, void *item) {
 
 extern BREthereumLog
 logCopy (BREthereumLog log) {
-    BREthereumLog copy = calloc (1, sizeof(struct BREthereumLogRecord));
-    memcpy (copy, log, sizeof(struct BREthereumLogRecord));
-
-    // Copy the topics
-    copy->topics = logTopicsCopy(log->topics);
+    // The topics and data are in the one allocation; `topicKnown` is shared
+    size_t size = logAllocationSize (logTopicsInlineCount (log), log->dataCount);
 
-    // Copy the data
-    copy->data = rlpDataCopy(log->data);
+    BREthereumLog copy = malloc (size);
+    memcpy (copy, log, size);
 
     return copy;
 }
@@ -418,50 +505,51 @@ logCopy (BREthereumLog log) {
 static BRRlpItem
 logTopicsRlpEncode (BREthereumLog log,
                     BRRlpCoder coder) {
-    size_t itemsCount = array_count(log->topics);
+    size_t itemsCount = log->topicsCount;
     BRRlpItem items[itemsCount];
 
     for (int i = 0; i < itemsCount; i++)
-        items[i] = logTopicRlpEncode(log->topics[i], coder);
+        items[i] = logTopicRlpEncode(*logTopicAt (log, i), coder);
 
     return rlpEncodeListItems(coder, items, itemsCount);
 }
 
-static BREthereumLogTopic *
-logTopicsRlpDecode (BRRlpItem item,
-                    BRRlpCoder coder) {
-    size_t itemsCount = 0;
-    const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
-
-    BREthereumLogTopic *topics;
-    array_new(topics, itemsCount);
-
-    for (int i = 0; i < itemsCount; i++) {
-        BREthereumLogTopic topic = logTopicRlpDecode(items[i], coder);
-        array_add(topics, topic);
-    }
-
-    return topics;
-}
-
 extern BREthereumLog
 logRlpDecode (BRRlpItem item,
               BREthereumRlpType type,
               BRRlpCoder coder) {
-    BREthereumLog log = (BREthereumLog) calloc (1, sizeof (struct BREthereumLogRecord));
-
     size_t itemsCount = 0;
     const BRRlpItem *items = rlpDecodeList(coder, item, &itemsCount);
     assert ((3 == itemsCount && RLP_TYPE_NETWORK == type) ||
             (6 == itemsCount && RLP_TYPE_ARCHIVE == type));
 
-    log->address = ethAddressRlpDecode(items[0], coder);
-    log->topics = logTopicsRlpDecode (items[1], coder);
+    // The topics and the data are copied directly from the coder into the log
+    size_t topicsCount = 0;
+    const BRRlpItem *topicItems = rlpDecodeList(coder, items[1], &topicsCount);
 
-    log->data = rlpItemGetData (coder, items[2]); //  rlpDecodeBytes(coder, items[2]);
+    // The count comes from the peer; bound it before sizing `topics` on the stack.
+    if (topicsCount > LOG_TOPICS_MAX_COUNT) return NULL;
 
-    // 
-    log->identifier.transactionReceiptIndex = LOG_TRANSACTION_RECEIPT_INDEX_UNKNOWN;
+    BRRlpData topics[topicsCount > 0 ? topicsCount : 1];
+    for (size_t index = 0; index < topicsCount; index++) {
+        topics[index] = rlpDecodeBytesSharedDontRelease (coder, topicItems[index]);
+        assert (LOG_TOPIC_BYTES_COUNT == topics[index].bytesCount);
+    }
+
+    const BREthereumLogTopic *topicKnown = (topicsCount > 0 ? logTopicLookupKnown (topics[0].bytes) : NULL);
+    size_t topicsSkipped = (NULL == topicKnown ? 0 : 1);
+
+    BRRlpData data = rlpItemGetDataSharedDontRelease (coder, items[2]);
+
+    BREthereumLog log = logCreateAllocate (ethAddressRlpDecode(items[0], coder),
+                                           topicsCount,
+                                           topicKnown,
+                                           data.bytesCount);
+
+    for (size_t index = topicsSkipped; index < topicsCount; index++)
+        memcpy (log->topics[index - topicsSkipped].bytes, topics[index].bytes, LOG_TOPIC_BYTES_COUNT);
+
+    memcpy (logDataBytes (log), data.bytes, data.bytesCount);
 
     if (RLP_TYPE_ARCHIVE == type) {
         BREthereumHash hash = ethHashRlpDecode(items[3], coder);
@@ -484,7 +572,7 @@ logRlpEncode(BREthereumLog log,
 
     items[0] = ethAddressRlpEncode(log->address, coder);
     items[1] = logTopicsRlpEncode(log, coder);
-    items[2] = rlpDataGetItem(coder, log->data); //  rlpEncodeBytes(coder, log->data.bytes, log->data.bytesCount);
+    items[2] = rlpDataGetItem(coder, logGetDataShared (log)); //  rlpEncodeBytes(coder, log->data.bytes, log->data.bytesCount);
 
     if (RLP_TYPE_ARCHIVE == type) {
         items[3] = ethHashRlpEncode(log->identifier.transactionHash, coder);
@@ -23,6 +23,9 @@ extern "C" {
 
 #define LOG_TOPIC_BYTES_COUNT   32
 
+// The EVM's LOG0 ... LOG4 opcodes bound a log to at most four topics.
+#define LOG_TOPICS_MAX_COUNT    4
+
 /**
  * An Ethereum Log Topic is 32 bytes of arbitary data.
  */
@@ -59,6 +62,22 @@ logTopicAsString (BREthereumLogTopic topic);
 extern BREthereumAddress
 logTopicAsAddress (BREthereumLogTopic topic);
 
+/**
+ * The known topics - the Keccak256 hashes of common event signatures, such as ERC20's
+ * 'Transfer(address,address,uint256)'.  A log with a known topic-0 shares the topic rather than
+ * storing it.
+ */
+extern size_t
+logTopicGetKnownCount (void);
+
+/**
+ * Return the event signature for the known topic at `index`; if `topic` is non-NULL, it is
+ * filled with the topic.
+ */
+extern const char *
+logTopicGetKnown (size_t index,
+                  BREthereumLogTopic *topic);
+
 
 /// MARK: - Log
 
@@ -159,6 +178,9 @@ logHashValue (const void *h);
 extern int
 logHashEqual (const void *h1, const void *h2);
 
+/**
+ * Decode a log.  Returns NULL if the log has more than LOG_TOPICS_MAX_COUNT topics.
+ */
 extern BREthereumLog
 logRlpDecode (BRRlpItem item,
               BREthereumRlpType type,
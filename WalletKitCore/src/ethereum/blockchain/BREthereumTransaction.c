@@ -21,6 +21,29 @@
 static unsigned int transactionAllocCount = 0;
 #endif
 
+static BRRlpData
+transactionDataCreate (const uint8_t *bytes, size_t bytesCount) {
+    // Allocate at least one byte, so that empty data is distinct from no data
+    BRRlpData data = { bytesCount, malloc (bytesCount > 0 ? bytesCount : 1) };
+    if (NULL != bytes && bytesCount > 0) memcpy (data.bytes, bytes, bytesCount);
+    return data;
+}
+
+static BRRlpData
+transactionDataCreateFromHex (const char *hex) {
+    if (NULL == hex) return (BRRlpData) { 0, NULL };
+
+    // Strip off "0x" if it exists
+    if (0 == strncmp (hex, "0x", 2)) hex = &hex[2];
+
+    size_t hexLen = strlen (hex);
+    assert (0 == hexLen % 2);
+
+    BRRlpData data = transactionDataCreate (NULL, hexLen / 2);
+    hexDecode (data.bytes, data.bytesCount, hex, hexLen);
+    return data;
+}
+
 //
 // Transaction
 //
@@ -76,9 +99,16 @@ struct BREthereumTransactionRecord {
     BREthereumChainId chainId;   // EIP-135 - chainId - "Since EIP-155 use chainId for v"
 
     /**
-     * The data
+     * The data, as bytes.  The `bytes` are NULL if, and only if, the transaction has no data;
+     * empty data has non-NULL `bytes` and a zero `bytesCount`.
      */
-    char *data;
+    BRRlpData data;
+
+    /**
+     * The data as a "0x" prefixed hex string - created by `transactionGetData()`, on demand, as
+     * only the public interface needs the string.
+     */
+    char *dataHex;
 
     /**
      * The signature, if signed (signer is not NULL).  This is a 'VRS' signature.
@@ -107,7 +137,7 @@ transactionCreate(BREthereumAddress sourceAddress,
     transaction->amount = amount;
     transaction->gasPrice = gasPrice;
     transaction->gasLimit = gasLimit;           // Must not be changed.
-    transaction->data = (NULL == data ? NULL : strdup (data));
+    transaction->data = transactionDataCreateFromHex (data);
     transaction->nonce = nonce;
     transaction->chainId = 0;
     transaction->hash = ethHashCreateEmpty();
@@ -126,7 +156,10 @@ extern BREthereumTransaction
 transactionCopy (BREthereumTransaction transaction) {
     BREthereumTransaction copy = calloc (1, sizeof (struct BREthereumTransactionRecord));
     memcpy (copy, transaction, sizeof (struct BREthereumTransactionRecord));
-    copy->data = (NULL == transaction->data ? NULL : strdup(transaction->data));
+    copy->data = (NULL == transaction->data.bytes
+                  ? transaction->data
+                  : transactionDataCreate (transaction->data.bytes, transaction->data.bytesCount));
+    copy->dataHex = NULL;
 
 #if defined (TRANSACTION_LOG_ALLOC_COUNT)
     eth_log ("MEM", "TX Copy - Count: %d", ++transactionAllocCount);
@@ -138,7 +171,8 @@ transactionCopy (BREthereumTransaction transaction) {
 extern void
 transactionRelease (BREthereumTransaction transaction) {
     if (NULL != transaction) {
-        if (NULL != transaction->data) free (transaction->data);
+        if (NULL != transaction->data.bytes) rlpDataRelease (transaction->data);
+        if (NULL != transaction->dataHex) free (transaction->dataHex);
 #if defined (TRANSACTION_LOG_ALLOC_COUNT)
         eth_log ("MEM", "TX Release - Count: %d", --transactionAllocCount);
 #endif
@@ -267,7 +301,14 @@ transactionHashEqual (const void *t1, const void *t2) {
 //
 extern const char *
 transactionGetData (BREthereumTransaction transaction) {
-    return transaction->data;
+    if (NULL == transaction->dataHex && NULL != transaction->data.bytes) {
+        size_t hexLen = 2 * transaction->data.bytesCount;
+
+        transaction->dataHex = malloc (2 + hexLen + 1);
+        strcpy (transaction->dataHex, "0x");
+        hexEncode (&transaction->dataHex[2], hexLen + 1, transaction->data.bytes, transaction->data.bytesCount);
+    }
+    return transaction->dataHex;
 }
 
 //
@@ -352,7 +393,9 @@ transactionRlpEncode(BREthereumTransaction transaction,
     items[2] = ethGasRlpEncode(transaction->gasLimit, coder);
     items[3] = ethAddressRlpEncode(transaction->targetAddress, coder);
     items[4] = ethEtherRlpEncode(transaction->amount, coder);
-    items[5] = rlpEncodeHexString(coder, transaction->data);
+    items[5] = (NULL == transaction->data.bytes
+                ? rlpEncodeString(coder, "")
+                : rlpEncodeBytes(coder, transaction->data.bytes, transaction->data.bytesCount));
     itemsCount = 6;
 
     // EIP-155:
@@ -439,7 +482,8 @@ transactionRlpDecode (BRRlpItem item,
     
     transaction->targetAddress = ethAddressRlpDecode(items[3], coder);
     transaction->amount = ethEtherRlpDecode(items[4], coder);
-    transaction->data = rlpDecodeHexString (coder, items[5], "0x");
+    BRRlpData data = rlpDecodeBytesSharedDontRelease (coder, items[5]);
+    transaction->data = transactionDataCreate (data.bytes, data.bytesCount);
     
     transaction->chainId = ethNetworkGetChainId(network);
     
@@ -642,13 +686,14 @@ transactionShow (BREthereumTransaction transaction, const char *topic) {
     eth_log (topic, "    Fee   : %s ETHER", fee);
     eth_log (topic, "    Total : %s ETHER", total);
     eth_log (topic, "    Total : %s WEI", totalWEI);
-    eth_log (topic, "    Data  : %s", transaction->data);
+    const char *data = transactionGetData (transaction);
+    eth_log (topic, "    Data  : %s", data);
 
-    BREthereumContractFunction function = ethContractLookupFunctionForEncoding (ethContractERC20, transaction->data);
+    BREthereumContractFunction function = ethContractLookupFunctionForEncoding (ethContractERC20, data);
     if (NULL != function && ethFunctionERC20Transfer == function) {
         BRCoreParseStatus status;
-        UInt256 funcAmount = ethFunctionERC20TransferDecodeAmount(function, transaction->data, &status);
-        char *funcAddr   = ethFunctionERC20TransferDecodeAddress (function, transaction->data);
+        UInt256 funcAmount = ethFunctionERC20TransferDecodeAmount(function, data, &status);
+        char *funcAddr   = ethFunctionERC20TransferDecodeAddress (function, data);
         char *funcAmt    = uint256CoerceString(funcAmount, 10);
 
         // BREthereumToken token = tokenLookup(target);
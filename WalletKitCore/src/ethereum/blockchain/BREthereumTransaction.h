@@ -129,7 +129,7 @@ extern void
 transactionSetHash (BREthereumTransaction transaction,
                     BREthereumHash hash);
 
-extern const char * // no not modify the return value
+extern const char * // do not modify or free; "0x" prefixed hex, NULL if no data
 transactionGetData (BREthereumTransaction transaction);
 
 // Support BRSet
@@ -114,7 +114,7 @@ transactionReceiptLogsRlpDecode (BRRlpItem item,
 
     for (int i = 0; i < itemsCount; i++) {
         BREthereumLog log = logRlpDecode(items[i], RLP_TYPE_NETWORK, coder);
-        array_add(logs, log);
+        if (NULL != log) array_add(logs, log);
     }
 
     return logs;
@@ -69,6 +69,10 @@ struct BREventHandlerRecord {
 
     // A lock for protecting the dispatch call.  Optional but recommended.
     pthread_mutex_t *lockOnDispatch;
+
+    // Metrics, if any; see `eventHandlerSetMetrics()`
+    BRMetricsHistogram metricsQueueDepth;
+    BRMetricsHistogram metricsDispatchLatency;
 };
 
 extern BREventHandler
@@ -153,7 +157,9 @@ eventHandlerThread (BREventHandler handler) {
             case EVENT_STATUS_SUCCESS:
                 // We got an event, dispatch
                 if (handler->lockOnDispatch) pthread_mutex_lock (handler->lockOnDispatch);
+                uint64_t dispatchStart = (NULL != handler->metricsDispatchLatency ? BRMetricsNow() : 0);
                 handler->scratch->type->eventDispatcher (handler, handler->scratch);
+                BRMetricsHistogramRecordSince (handler->metricsDispatchLatency, dispatchStart);
                 if (handler->lockOnDispatch) pthread_mutex_unlock (handler->lockOnDispatch);
 
                 // Yield here so that we don't have a situation where we repeatedly acquire
@@ -182,6 +188,13 @@ eventHandlerThread (BREventHandler handler) {
     return NULL;
 }
 
+extern void
+eventHandlerSetMetrics (BREventHandler handler,
+                        BRMetrics metrics) {
+    handler->metricsQueueDepth      = BRMetricsGetHistogram (metrics, "event.queueDepth");
+    handler->metricsDispatchLatency = BRMetricsGetHistogram (metrics, "event.dispatchLatency");
+}
+
 extern void
 eventHandlerDestroy (BREventHandler handler) {
     // First stop...
@@ -294,6 +307,8 @@ extern BREventStatus
 eventHandlerSignalEvent (BREventHandler handler,
                          BREvent *event) {
     eventQueueEnqueueTailSignal (handler->queue, event);
+    if (NULL != handler->metricsQueueDepth)
+        BRMetricsHistogramRecord (handler->metricsQueueDepth, eventQueuePendingCount (handler->queue));
     return EVENT_STATUS_SUCCESS;
 }
 
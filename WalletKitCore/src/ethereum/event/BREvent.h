@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <time.h>
 #include <pthread.h>
+#include "support/BRMetrics.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -127,6 +128,15 @@ eventHandlerSetTimeoutDispatcher (BREventHandler handler,
 extern void
 eventHandlerDestroy (BREventHandler handler);
 
+/**
+ * Record the queue depth as each event is signalled ('event.queueDepth') and the time to
+ * dispatch each event, in microseconds ('event.dispatchLatency'), in `metrics`.  The `metrics`
+ * must outlive the handler.
+ */
+extern void
+eventHandlerSetMetrics (BREventHandler handler,
+                        BRMetrics metrics);
+
 //
 // Start / Stop
 //
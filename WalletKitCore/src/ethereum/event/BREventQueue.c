@@ -19,6 +19,9 @@ struct BREventQueueRecord {
     // A linked-list (through event->next) of pending events.
     BREvent *pending;
 
+    // The number of pending events
+    size_t pendingCount;
+
     // A linked-list (through event->next) of available events
     BREvent *available;
 
@@ -95,6 +98,7 @@ eventQueueClear (BREventQueue queue) {
     eventFreeAll(queue->available, 0);
 
     queue->pending = NULL;
+    queue->pendingCount = 0;
     queue->available = NULL;
 
     pthread_mutex_unlock(&queue->lock);
@@ -145,6 +149,7 @@ eventQueueEnqueue (BREventQueue queue,
         this->next = queue->pending;
         queue->pending = this;
     }
+    queue->pendingCount += 1;
 
     if (signal) pthread_cond_signal (&queue->cond);
     pthread_mutex_unlock(&queue->lock);
@@ -184,6 +189,7 @@ _eventQueueDequeue (BREventQueue queue,
 
     // Remove `this` from the pending list.
     queue->pending = this->next;
+    queue->pendingCount -= 1;
 
     // Fill in the provided event;
     this->next = NULL;
@@ -255,3 +261,11 @@ eventQueueHasPending (BREventQueue queue) {
     pthread_mutex_unlock(&queue->lock);
     return pending;
 }
+
+extern size_t
+eventQueuePendingCount (BREventQueue queue) {
+    pthread_mutex_lock(&queue->lock);
+    size_t count = queue->pendingCount;
+    pthread_mutex_unlock(&queue->lock);
+    return count;
+}
@@ -63,6 +63,9 @@ eventQueueDequeueWaitAbortReset (BREventQueue queue);
 extern int
 eventQueueHasPending (BREventQueue queue);
 
+extern size_t
+eventQueuePendingCount (BREventQueue queue);
+
 extern void
 eventQueueClear (BREventQueue queue);
 
@@ -13,6 +13,7 @@
 
 #include <stdbool.h>
 #include "BREthereumBase.h"
+#include "ethereum/blockchain/BREthereumLog.h"
 #include "BRCryptoSync.h"
 
 
@@ -177,6 +178,29 @@ extern "C" {
                            // txreceipt_status
                            bool isError);
 
+    /**
+     * As `ewmAnnounceTransaction()` but with the hashes and addresses already parsed.
+     */
+    extern BREthereumStatus
+    ewmAnnounceTransactionBinary (BREthereumEWM ewm,
+                                  int id,
+                                  BREthereumHash hash,
+                                  BREthereumAddress from,
+                                  BREthereumAddress to,
+                                  BREthereumAddress contract,
+                                  UInt256 amount, // value
+                                  uint64_t gasLimit,
+                                  UInt256 gasPrice,
+                                  const char *data,
+                                  uint64_t nonce,
+                                  uint64_t  gasUsed,
+                                  uint64_t  blockNumber,
+                                  BREthereumHash blockHash,
+                                  uint64_t blockConfirmations,
+                                  uint64_t blockTransactionIndex,
+                                  uint64_t blockTimestamp,
+                                  bool isError);
+
     extern void
     ewmAnnounceTransactionComplete (BREthereumEWM ewm,
                                     int id,
@@ -209,6 +233,25 @@ extern "C" {
                     uint64_t blockTransactionIndex,
                     uint64_t blockTimestamp);
 
+    /**
+     * As `ewmAnnounceLog()` but with the hash, contract and topics already parsed and with the
+     * log's data as its numeric `value`.
+     */
+    extern BREthereumStatus
+    ewmAnnounceLogBinary (BREthereumEWM ewm,
+                          int id,
+                          BREthereumHash hash,
+                          BREthereumAddress contract,
+                          size_t topicCount,
+                          const BREthereumLogTopic *topics,
+                          UInt256  value,
+                          UInt256  gasPrice,
+                          uint64_t gasUsed,
+                          uint64_t logIndex,
+                          uint64_t blockNumber,
+                          uint64_t blockTransactionIndex,
+                          uint64_t blockTimestamp);
+
     extern void
     ewmAnnounceLogComplete (BREthereumEWM ewm,
                             int id,
@@ -21,6 +21,7 @@
 #include "support/BRArray.h"
 #include "support/BRBIP39Mnemonic.h"
 #include "support/BRAssert.h"
+#include "support/BRProfile.h"
 #include "ethereum/event/BREvent.h"
 #include "ethereum/event/BREventAlarm.h"
 #include "BREthereumEWMPrivate.h"
@@ -193,12 +194,31 @@ ewmCreateInitialSets (BREthereumEWM ewm,
                       BRSetOf(BREthereumToken) *tokens,
                       BRSetOf(BREthereumWalletState) *states) {
 
+    BRProfileSpan span;
+
+    span = BR_PROFILE_BEGIN ("loadTransactions");
     *transactions = initialTransactionsLoad(ewm);
+    BR_PROFILE_END (span);
+
+    span = BR_PROFILE_BEGIN ("loadLogs");
     *logs = initialLogsLoad(ewm);
+    BR_PROFILE_END (span);
+
+    span = BR_PROFILE_BEGIN ("loadNodes");
     *nodes = initialNodesLoad(ewm);
+    BR_PROFILE_END (span);
+
+    span = BR_PROFILE_BEGIN ("loadBlocks");
     *blocks = initialBlocksLoad(ewm);
+    BR_PROFILE_END (span);
+
+    span = BR_PROFILE_BEGIN ("loadTokens");
     *tokens = initialTokensLoad(ewm);
+    BR_PROFILE_END (span);
+
+    span = BR_PROFILE_BEGIN ("loadWalletStates");
     *states = initialWalletsLoad(ewm);
+    BR_PROFILE_END (span);
 
     // If any are NULL, then we have an error and a full sync is required.  The sync will be
     // started automatically, as part of the normal processing, of 'blocks' (we'll use a checkpoint,
@@ -290,11 +310,13 @@ ewmCreate (BREthereumNetwork network,
 
     // The file service.  Initialize {nodes, blocks, transactions and logs} from the FileService
 
+    BRProfileSpan span = BR_PROFILE_BEGIN ("fileServiceCreate");
     ewm->fs = fileServiceCreateFromTypeSpecfications (storagePath, "eth", ethNetworkGetName (network),
                                                       ewm,
                                                       ewmFileServiceErrorHandler,
                                                       ewmFileServiceSpecificationsCount,
                                                       ewmFileServiceSpecifications);
+    BR_PROFILE_END (span);
     if (NULL == ewm->fs) return ewmCreateErrorHandler(ewm, 1, "create");
 
     // Load all the persistent entities
@@ -341,6 +363,7 @@ ewmCreate (BREthereumNetwork network,
                             (BRAssertRecoveryHandler) ewmAssertRecovery);
 
     // Having restored the WalletState. restore that Wallet (balance).
+    span = BR_PROFILE_BEGIN ("restoreWalletStates");
     FOR_SET (BREthereumWalletState, state, walletStates) {
         BREthereumAddress address = walletStateGetAddress (state);
 
@@ -371,6 +394,7 @@ ewmCreate (BREthereumNetwork network,
                                     ETHEREUM_BOOLEAN_TRUE);
         }
     }
+    BR_PROFILE_END (span);
 
     // Create BCS - note: when BCS processes blocks, peers, transactions, and logs there
     // will be callbacks made to the EWM client.  Because we've defined `handlerForMain`
@@ -378,6 +402,7 @@ ewmCreate (BREthereumNetwork network,
     //
 
     // Support the requested mode
+    span = BR_PROFILE_BEGIN ("bcsCreate");
     switch (ewm->mode) {
         case CRYPTO_SYNC_MODE_API_ONLY:
         case CRYPTO_SYNC_MODE_API_WITH_P2P_SEND: {
@@ -491,6 +516,7 @@ ewmCreate (BREthereumNetwork network,
             break;
         }
     }
+    BR_PROFILE_END (span);
 
     BRSetFreeAll (walletStates, (void (*) (void*)) walletStateRelease);
 
@@ -1088,12 +1114,24 @@ ewmUpdateMode (BREthereumEWM ewm,
                 BRSetFreeAll (states, (void (*) (void*)) walletStateRelease);
                 break;
          }
+        bcsSetMetrics (ewm->bcs, ewm->metrics);
 
         // Don't reestablish a connection
     }
     pthread_mutex_unlock (&ewm->lock);
 }
 
+extern void
+ewmSetMetrics (BREthereumEWM ewm,
+               BRMetrics metrics) {
+    pthread_mutex_lock (&ewm->lock);
+    ewm->metrics = metrics;
+    fileServiceSetMetrics (ewm->fs, metrics);
+    eventHandlerSetMetrics (ewm->handler, metrics);
+    bcsSetMetrics (ewm->bcs, metrics);
+    pthread_mutex_unlock (&ewm->lock);
+}
+
 extern void
 ewmWipe (BREthereumNetwork network,
          const char *storagePath) {
@@ -2583,6 +2621,18 @@ ewmTransferGetOriginatingTransactionHash(BREthereumEWM ewm,
     return hash;
 }
 
+extern BREthereumBoolean
+ewmTransferIsSigned (BREthereumEWM ewm,
+                     BREthereumTransfer transfer) {
+    pthread_mutex_lock (&ewm->lock);
+    BREthereumTransaction transaction = transferGetOriginatingTransaction (transfer);
+    BREthereumBoolean isSigned = (NULL == transaction
+                                  ? ETHEREUM_BOOLEAN_FALSE
+                                  : transactionIsSigned (transaction));
+    pthread_mutex_unlock (&ewm->lock);
+    return isSigned;
+}
+
 extern char *
 ewmTransferGetAmountEther(BREthereumEWM ewm,
                           BREthereumTransfer transfer,
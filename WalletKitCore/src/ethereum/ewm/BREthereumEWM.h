@@ -11,6 +11,7 @@
 #ifndef BR_Ethereum_EWM_H
 #define BR_Ethereum_EWM_H
 
+#include "support/BRMetrics.h"
 #include "ethereum/blockchain/BREthereumNetwork.h"
 #include "ethereum/contract/BREthereumContract.h"
 #include "BREthereumBase.h"
@@ -128,6 +129,14 @@ extern void
 ewmUpdateMode (BREthereumEWM ewm,
                BRCryptoSyncMode mode);
 
+/**
+ * Record the file service, event handler and BCS metrics in `metrics`, which must outlive the
+ * EWM (or be replaced with NULL).
+ */
+extern void
+ewmSetMetrics (BREthereumEWM ewm,
+               BRMetrics metrics);
+
 extern uint64_t
 ewmGetBlockHeight (BREthereumEWM ewm);
 
@@ -322,6 +331,11 @@ extern BREthereumHash
 ewmTransferGetOriginatingTransactionHash (BREthereumEWM ewm,
                                           BREthereumTransfer transfer);
 
+/// TRUE if `transfer` has an originating transaction and it is signed
+extern BREthereumBoolean
+ewmTransferIsSigned (BREthereumEWM ewm,
+                     BREthereumTransfer transfer);
+
 
 extern BREthereumAmount
 ewmTransferGetAmount(BREthereumEWM ewm,
@@ -449,15 +449,53 @@ ewmAnnounceTransaction(BREthereumEWM ewm,
                        uint64_t blockTransactionIndex,
                        uint64_t blockTimestamp,
                        bool isError) {
+    return ewmAnnounceTransactionBinary (ewm, id,
+                                         ethHashCreate(hashString),
+                                         ethAddressCreate(from),
+                                         ethAddressCreate(to),
+                                         (NULL == contract || '\0' == contract[0]
+                                          ? EMPTY_ADDRESS_INIT
+                                          : ethAddressCreate(contract)),
+                                         amount,
+                                         gasLimit,
+                                         gasPrice,
+                                         data,
+                                         nonce,
+                                         gasUsed,
+                                         blockNumber,
+                                         ethHashCreate (strBlockHash),
+                                         blockConfirmations,
+                                         blockTransactionIndex,
+                                         blockTimestamp,
+                                         isError);
+}
+
+extern BREthereumStatus
+ewmAnnounceTransactionBinary (BREthereumEWM ewm,
+                              int id,
+                              BREthereumHash hash,
+                              BREthereumAddress from,
+                              BREthereumAddress to,
+                              BREthereumAddress contract,
+                              UInt256 amount, // value
+                              uint64_t gasLimit,
+                              UInt256 gasPrice,
+                              const char *data,
+                              uint64_t nonce,
+                              uint64_t  gasUsed,
+                              uint64_t  blockNumber,
+                              BREthereumHash blockHash,
+                              uint64_t blockConfirmations,
+                              uint64_t blockTransactionIndex,
+                              uint64_t blockTimestamp,
+                              bool isError) {
     BREthereumEWMClientAnnounceTransactionBundle *bundle = malloc(sizeof (BREthereumEWMClientAnnounceTransactionBundle));
 
-    bundle->hash = ethHashCreate(hashString);
+    bundle->hash = hash;
 
-    bundle->from = ethAddressCreate(from);
-    bundle->to   = ethAddressCreate(to);
-    bundle->contract = (NULL == contract || '\0' == contract[0]
-                        ? EMPTY_ADDRESS_INIT
-                        : ethAddressCreate(contract));
+    bundle->from = from;
+    bundle->to   = to;
+    bundle->contract = contract;
 
     bundle->amount = amount; // uint256CreateParse(strAmount, 0, &parseStatus);
 
@@ -469,7 +507,7 @@ ewmAnnounceTransaction(BREthereumEWM ewm,
     bundle->gasUsed = gasUsed;
 
     bundle->blockNumber = blockNumber;
-    bundle->blockHash = ethHashCreate (strBlockHash);
+    bundle->blockHash = blockHash;
     bundle->blockConfirmations = blockConfirmations;
     bundle->blockTransactionIndex = blockTransactionIndex;
     bundle->blockTimestamp = blockTimestamp;
@@ -501,24 +539,15 @@ ewmHandleAnnounceLog (BREthereumEWM ewm,
             // This 'announce' call is coming from the guaranteed BRD endpoint; thus we don't need to
             // worry about the validity of the transaction - it is surely confirmed.
 
-            BREthereumLogTopic topics [bundle->topicCount];
-            for (size_t index = 0; index < bundle->topicCount; index++)
-                topics[index] = logTopicCreateFromString(bundle->arrayTopics[index]);
-
             // In general, log->data is arbitrary data.  In the case of an ERC20 token, log->data
             // is a numeric value - for the transfer amount.  When parsing in logRlpDecode(),
             // log->data is assigned with rlpDecodeBytes(coder, items[2]); we'll need the same
             // thing, somehow
-
-            BRCoreParseStatus parseStatus = CORE_PARSE_OK;
-            UInt256 value = uint256CreateParse(bundle->data, 0, &parseStatus);
-            assert (CORE_PARSE_OK == parseStatus);
-
-            BRRlpItem  item  = rlpEncodeUInt256 (ewm->coder, value, 1);
+            BRRlpItem  item  = rlpEncodeUInt256 (ewm->coder, bundle->value, 1);
 
             BREthereumLog log = logCreate(bundle->contract,
                                           bundle->topicCount,
-                                          topics,
+                                          bundle->topics,
                                           rlpItemGetDataSharedDontRelease(ewm->coder, item));
             rlpItemRelease (ewm->coder, item);
 
@@ -577,16 +606,51 @@ ewmAnnounceLog (BREthereumEWM ewm,
                 uint64_t blockNumber,
                 uint64_t blockTransactionIndex,
                 uint64_t blockTimestamp) {
+    BREthereumLogTopic topics [topicsCount > 0 ? topicsCount : 1];
+    for (size_t i = 0; i < topicsCount; i++)
+        topics[i] = logTopicCreateFromString (arrayTopics[i]);
+
+    BRCoreParseStatus parseStatus = CORE_PARSE_OK;
+    UInt256 value = uint256CreateParse(strData, 0, &parseStatus);
+    assert (CORE_PARSE_OK == parseStatus);
+
+    return ewmAnnounceLogBinary (ewm, id,
+                                 ethHashCreate (hash),
+                                 ethAddressCreate (contract),
+                                 topicsCount,
+                                 topics,
+                                 value,
+                                 gasPrice,
+                                 gasUsed,
+                                 logIndex,
+                                 blockNumber,
+                                 blockTransactionIndex,
+                                 blockTimestamp);
+}
+
+extern BREthereumStatus
+ewmAnnounceLogBinary (BREthereumEWM ewm,
+                      int id,
+                      BREthereumHash hash,
+                      BREthereumAddress contract,
+                      size_t topicsCount,
+                      const BREthereumLogTopic *topics,
+                      UInt256  value,
+                      UInt256  gasPrice,
+                      uint64_t gasUsed,
+                      uint64_t logIndex,
+                      uint64_t blockNumber,
+                      uint64_t blockTransactionIndex,
+                      uint64_t blockTimestamp) {
 
     BREthereumEWMClientAnnounceLogBundle *bundle = malloc(sizeof (BREthereumEWMClientAnnounceLogBundle));
 
-    bundle->hash = ethHashCreate(hash);
-    bundle->contract = ethAddressCreate(contract);
-    bundle->topicCount = topicsCount;
-    bundle->arrayTopics = calloc (topicsCount, sizeof (char *));
-    for (int i = 0; i < topicsCount; i++)
-        bundle->arrayTopics[i] = strdup (arrayTopics[i]);
-    bundle->data = strdup (strData);
+    bundle->hash = hash;
+    bundle->contract = contract;
+    bundle->topicCount = (int) topicsCount;
+    bundle->topics = calloc (topicsCount > 0 ? topicsCount : 1, sizeof (BREthereumLogTopic));
+    memcpy (bundle->topics, topics, topicsCount * sizeof (BREthereumLogTopic));
+    bundle->value = value;
     bundle->gasPrice = gasPrice;
     bundle->gasUsed = gasUsed;
     bundle->logIndex = logIndex;
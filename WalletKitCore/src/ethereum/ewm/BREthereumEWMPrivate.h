@@ -143,6 +143,11 @@ struct BREthereumEWMRecord {
      */
     BRFileService fs;
 
+    /**
+     * The metrics, if any, recorded by the file service, handler and BCS.  Not owned.
+     */
+    BRMetrics metrics;
+
     /**
      * If we are syncing with BRD, instead of as P2P with BCS, then we'll keep a record to
      * ensure we've successfully completed the getTransactions() and getLogs() callbacks to
@@ -453,8 +458,8 @@ typedef struct {
     BREthereumHash hash;
     BREthereumAddress contract;
     int topicCount;
-    char **arrayTopics;
-    char *data;
+    BREthereumLogTopic *topics;
+    UInt256 value;
     UInt256 gasPrice;
     uint64_t gasUsed;
     uint64_t logIndex;
@@ -465,10 +470,7 @@ typedef struct {
 
 static inline void
 ewmClientAnnounceLogBundleRelease (BREthereumEWMClientAnnounceLogBundle *bundle) {
-    for (int i = 0; i < bundle->topicCount; i++)
-        free (bundle->arrayTopics[i]);
-    free (bundle->arrayTopics);
-    free (bundle->data);
+    free (bundle->topics);
     free (bundle);
 }
 
@@ -252,6 +252,9 @@ typedef struct {
      */
     BREthereumNode node;
 
+    /** The time this request was added, from BRMetricsNow() */
+    uint64_t created;
+
 } BREthereumLESRequest;
 
 static void
@@ -354,6 +357,14 @@ struct BREthereumLESRecord {
     pthread_t thread;
     pthread_mutex_t lock;
 
+    /** Metrics, if any */
+    BRMetricsCounter provisions;
+    BRMetricsHistogram provisionLatency;
+
+    /** Capture or replay of node messages, if any */
+    BRCapture capture;
+    BRCaptureReplay replay;
+
     /** replace with pipe() message */
     int theTimeToQuitIsNow;
     int theTimeToCleanIsNow;
@@ -416,6 +427,8 @@ lesEnsureNodeForEndpoint (BREthereumLES les,
                            (BREthereumNodeCallbackProvide) lesHandleProvision,
                            (BREthereumNodeCallbackNeighbor) lesHandleNeighbor,
                            les->handleSync);
+        nodeSetCapture (node, les->capture);
+        nodeSetReplay  (node, les->replay);
         nodeSetStateInitial (node, NODE_ROUTE_TCP, state);
 
         // ... add it to 'all nodes'
@@ -655,6 +668,39 @@ lesCreate (BREthereumNetwork network,
     return les;
 }
 
+extern void
+lesSetMetrics (BREthereumLES les,
+               BRMetrics metrics) {
+    pthread_mutex_lock (&les->lock);
+    les->provisions       = BRMetricsGetCounter   (metrics, "les.provisions");
+    les->provisionLatency = BRMetricsGetHistogram (metrics, "les.provisionLatency");
+    pthread_mutex_unlock (&les->lock);
+}
+
+extern void
+lesSetCapture (BREthereumLES les,
+               BRCapture capture) {
+    pthread_mutex_lock (&les->lock);
+    les->capture = capture;
+    FOR_NODES (les, node)
+        nodeSetCapture (node, capture);
+    pthread_mutex_unlock (&les->lock);
+}
+
+extern void
+lesSetReplay (BREthereumLES les,
+              BRCaptureReplay replay) {
+    pthread_mutex_lock (&les->lock);
+    les->replay = replay;
+    FOR_NODES (les, node)
+        nodeSetReplay (node, replay);
+
+    // Stay off the network: no DNS seeds and no UDP discovery.
+    les->isPendingDNSSeeds = 0;
+    les->discoverNodes = ETHEREUM_BOOLEAN_FALSE;
+    pthread_mutex_unlock (&les->lock);
+}
+
 extern void
 lesStart (BREthereumLES les) {
     pthread_mutex_lock (&les->lock);
@@ -888,6 +934,9 @@ lesHandleProvision (BREthereumLES les,
                     // remove the request (which releases the result but we passed a copy,
                     // w/ provision and w/ provision references (to hashes, etc)).
 
+                    BRMetricsCounterAdd (les->provisions, 1);
+                    BRMetricsHistogramRecordSince (les->provisionLatency, request->created);
+
                     request->callback (request->context,
                                        les,
                                        node,
@@ -1564,7 +1613,7 @@ lesAddRequestSpecifically (BREthereumLES les,
                            BREthereumLESProvisionCallback callback,
                            OwnershipGiven BREthereumProvision provision) {
     provision.identifier = les->requestsIdentifier++;
-    BREthereumLESRequest request = { context, callback, provision, node, NULL };
+    BREthereumLESRequest request = { context, callback, provision, node, NULL, BRMetricsNow() };
     array_add (les->requests, request);
 }
 
@@ -14,6 +14,8 @@
 #include <inttypes.h>
 #include "support/BRArray.h"
 #include "support/BRKey.h"
+#include "support/BRMetrics.h"
+#include "support/BRCapture.h"
 #include "ethereum/base/BREthereumBase.h"
 #include "ethereum/blockchain/BREthereumBlockChain.h"
 #include "BREthereumProvision.h"
@@ -201,6 +203,31 @@ lesCreate (BREthereumNetwork network,
 extern void
 lesRelease(BREthereumLES les);
 
+/**
+ * Record the number of provisions completed, and the latency from request to completion, in
+ * `metrics`; NULL to stop recording.
+ */
+extern void
+lesSetMetrics (BREthereumLES les,
+               BRMetrics metrics);
+
+/**
+ * Record the messages exchanged with each node in `capture`; see nodeSetCapture().  Set before
+ * lesStart(); `capture` must outlive `les`.
+ */
+extern void
+lesSetCapture (BREthereumLES les,
+               BRCapture capture);
+
+/**
+ * Replay the messages captured for each node from `replay`, rather than connect to the network;
+ * see nodeSetReplay().  Nodes without a captured stream fail to connect; DNS seeds and node
+ * discovery are skipped.  Set before lesStart(); `replay` must outlive `les`.
+ */
+extern void
+lesSetReplay (BREthereumLES les,
+              BRCaptureReplay replay);
+
 extern void
 lesStart (BREthereumLES les);
 
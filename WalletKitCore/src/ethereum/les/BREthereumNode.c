@@ -523,6 +523,15 @@ struct BREthereumNodeRecord {
 
     BRArrayOf(BREthereumNodeProvisioner) provisioners;
 
+    // Capture and replay of the TCP route, if any; a stream is open while the route is.
+    BRCapture capture;
+    BRCaptureStream captureStream;
+    int captureStreamOpen;
+
+    BRCaptureReplay replay;
+    BRCaptureStream replayStream;
+    int replayStreamOpen;
+
     // A largely unneeded lock.
     pthread_mutex_t lock;
 };
@@ -755,6 +764,38 @@ nodeClean (BREthereumNode node) {
     rlpCoderReclaim(node->coder.rlp);
 }
 
+extern void
+nodeSetCapture (BREthereumNode node,
+                BRCapture capture) {
+    node->capture = capture;
+}
+
+extern void
+nodeSetReplay (BREthereumNode node,
+               BRCaptureReplay replay) {
+    node->replay = replay;
+}
+
+// The capture/replay stream name for `node`
+static void
+nodeGetStreamName (BREthereumNode node,
+                   char *name,
+                   size_t nameLength) {
+    snprintf (name, nameLength, "%s:%d",
+              nodeEndpointGetHostname (node->remote),
+              nodeEndpointGetPort (node->remote, NODE_ROUTE_TCP));
+}
+
+// When replaying, the socket is always readable; only recv if the captured stream has a message
+// due - or has ended, which the recv reports as an error.
+static int
+nodeCanRecv (BREthereumNode node,
+             BREthereumNodeEndpointRoute route) {
+    return (NULL == node->replay ||
+            NODE_ROUTE_TCP != route ||
+            BR_CAPTURE_REPLAY_WAIT != BRCaptureReplayPeek (node->replay, node->replayStream));
+}
+
 extern BREthereumBoolean
 nodeUpdatedLocalStatus (BREthereumNode node,
                         BREthereumNodeEndpointRoute route) {
@@ -826,11 +867,36 @@ nodeConnect (BREthereumNode node,
 #endif
 
 
+    char name[128];
+    nodeGetStreamName (node, name, sizeof (name));
+
+    // When replaying, connect TCP to the captured stream; there is nothing to authenticate.
+    if (NULL != node->replay) {
+        if (NODE_ROUTE_TCP != route ||
+            !BRCaptureReplayOpenStream (node->replay, name, &node->replayStream))
+            return nodeProcessFailure (node, route, NULL, nodeStateCreateErrorUnix(ECONNREFUSED));
+
+        error = nodeEndpointOpenReplay (node->remote, route);
+        if (error) {
+            BRCaptureReplayCloseStream (node->replay, node->replayStream);
+            return nodeProcessFailure (node, route, NULL, nodeStateCreateErrorUnix(error));
+        }
+        node->replayStreamOpen = 1;
+
+        nodeUpdateTimeout(node, now);
+        return nodeStateAnnounce(node, route, nodeStateCreateConnecting (NODE_CONNECT_HELLO));
+    }
+
     // Actually open the endpoint connection/port
     error = nodeEndpointOpen (node->remote, route);
     if (error)
         return nodeProcessFailure (node, route, NULL, nodeStateCreateErrorUnix(error));
 
+    if (NULL != node->capture && NODE_ROUTE_TCP == route) {
+        node->captureStream = BRCaptureOpenStream (node->capture, name);
+        node->captureStreamOpen = 1;
+    }
+
     // Move to the next state.
     nodeUpdateTimeout(node, now);
     return nodeStateAnnounce(node, route, nodeStateCreateConnecting (NODE_ROUTE_TCP == route
@@ -854,6 +920,16 @@ nodeDisconnect (BREthereumNode node,
     nodeEndpointClose (node->remote, route, !nodeHasErrorState (node, route));
 #endif
 
+    if (NODE_ROUTE_TCP == route && node->captureStreamOpen) {
+        BRCaptureCloseStream (node->capture, node->captureStream);
+        node->captureStreamOpen = 0;
+    }
+
+    if (NODE_ROUTE_TCP == route && node->replayStreamOpen) {
+        BRCaptureReplayCloseStream (node->replay, node->replayStream);
+        node->replayStreamOpen = 0;
+    }
+
     // Clear any pending timeout.
     node->timeout = -1;
 
@@ -1313,6 +1389,10 @@ nodeProcess (BREthereumNode node,
     // Do nothing if there is no socket.
     if (-1 == socket) return node->states[route];
 
+    // When replaying, another node's recv might have made this node's message no longer due.
+    if (NULL != recv && FD_ISSET (socket, recv) && !nodeCanRecv (node, route))
+        FD_CLR (socket, recv);
+
     switch (node->states[route].type) {
             //
             // When CONNECTED:
@@ -1839,7 +1919,7 @@ nodeUpdateDescriptors (BREthereumNode node,
             break;
 
         case NODE_CONNECTED:
-            if (NULL != recv)
+            if (NULL != recv && nodeCanRecv (node, route))
                 FD_SET (socket, recv);
 
             // If we have any provisioner with a pending message, we are willing to send
@@ -1874,7 +1954,7 @@ nodeUpdateDescriptors (BREthereumNode node,
                 case NODE_CONNECT_PING_ACK_DISCOVER_ACK:
                 case NODE_CONNECT_DISCOVER_ACK:
                 case NODE_CONNECT_DISCOVER_ACK_TOO:
-                    if (NULL != recv) FD_SET (socket, recv);
+                    if (NULL != recv && nodeCanRecv (node, route)) FD_SET (socket, recv);
                     break;
             }
             break;
@@ -2028,6 +2108,15 @@ nodeSend (BREthereumNode node,
             // RLP encoding of a list; thus we use `rlpDecodeList`.
             BRRlpData data = rlpDecodeListSharedDontRelease(node->coder.rlp, item);
 
+            if (node->captureStreamOpen)
+                BRCaptureAddSend (node->capture, node->captureStream, data.bytes, data.bytesCount);
+
+            // When replaying there is no one to send to; just account for the message.
+            if (node->replayStreamOpen) {
+                BRCaptureReplaySent (node->replay, node->replayStream);
+                break;
+            }
+
             // Encrypt the length-less data
             BRRlpData encryptedData;
             pthread_mutex_lock (&node->lock);
@@ -2098,55 +2187,79 @@ nodeRecv (BREthereumNode node,
         case NODE_ROUTE_TCP: {
             size_t headerCount = 32;
 
-            {
-                // get header, decrypt it, validate it and then determine the bytesCount
-                uint8_t header[32];
-                memset(header, -1, 32);
+            if (node->replayStreamOpen) {
+                // Replay the next (decrypted) message captured for this node
+                const uint8_t *replayBytes;
 
-                error = nodeEndpointRecvData (node->remote, route, header, &headerCount, 1);
-                if (error) return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorUnix (error));
+                if (BR_CAPTURE_REPLAY_READY != BRCaptureReplayNext (node->replay, node->replayStream, 0,
+                                                                    &replayBytes, &headerCount))
+                    return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorUnix (ECONNRESET));
 
                 pthread_mutex_lock (&node->lock);
-                if (ETHEREUM_BOOLEAN_IS_FALSE(frameCoderDecryptHeader(node->frameCoder, header, 32))) {
-                    pthread_mutex_unlock (&node->lock);
-                    return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorProtocol(NODE_PROTOCOL_TCP_AUTHENTICATION));
+                if (headerCount > bytesLimit) {
+                    node->recvDataBuffer = (BRRlpData) {
+                        2 * headerCount,
+                        realloc(node->recvDataBuffer.bytes, 2 * headerCount)
+                    };
+                    bytes = node->recvDataBuffer.bytes;
                 }
+                memcpy (bytes, replayBytes, headerCount);
                 pthread_mutex_unlock (&node->lock);
-                headerCount = ((uint32_t)(header[2]) <<  0 |
-                               (uint32_t)(header[1]) <<  8 |
-                               (uint32_t)(header[0]) << 16);
+            }
+            else {
+                {
+                    // get header, decrypt it, validate it and then determine the bytesCount
+                    uint8_t header[32];
+                    memset(header, -1, 32);
+
+                    error = nodeEndpointRecvData (node->remote, route, header, &headerCount, 1);
+                    if (error) return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorUnix (error));
+
+                    pthread_mutex_lock (&node->lock);
+                    if (ETHEREUM_BOOLEAN_IS_FALSE(frameCoderDecryptHeader(node->frameCoder, header, 32))) {
+                        pthread_mutex_unlock (&node->lock);
+                        return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorProtocol(NODE_PROTOCOL_TCP_AUTHENTICATION));
+                    }
+                    pthread_mutex_unlock (&node->lock);
+                    headerCount = ((uint32_t)(header[2]) <<  0 |
+                                   (uint32_t)(header[1]) <<  8 |
+                                   (uint32_t)(header[0]) << 16);
 
-                // ??round to 16 ?? 32 ??
-                bytesCount = headerCount + ((16 - (headerCount % 16)) % 16) + 16;
-                // bytesCount = (headerCount + 15) & ~15;
+                    // ??round to 16 ?? 32 ??
+                    bytesCount = headerCount + ((16 - (headerCount % 16)) % 16) + 16;
+                    // bytesCount = (headerCount + 15) & ~15;
 
-                // ?? node->bodySize = headerCount; ??
-            }
+                    // ?? node->bodySize = headerCount; ??
+                }
 
-            // Given bytesCount, update recvDataBuffer if too small
-            pthread_mutex_lock (&node->lock);
-            if (bytesCount > bytesLimit) {
-                // Expand recvDataBuffer, with some margin
-                node->recvDataBuffer = (BRRlpData) {
-                    2 * bytesCount,
-                    realloc(node->recvDataBuffer.bytes, 2 * bytesCount)
-                };
-                bytes = node->recvDataBuffer.bytes;
-                // bytesLimit = node->recvDataBuffer.bytesCount;
-            }
-            pthread_mutex_unlock (&node->lock);
+                // Given bytesCount, update recvDataBuffer if too small
+                pthread_mutex_lock (&node->lock);
+                if (bytesCount > bytesLimit) {
+                    // Expand recvDataBuffer, with some margin
+                    node->recvDataBuffer = (BRRlpData) {
+                        2 * bytesCount,
+                        realloc(node->recvDataBuffer.bytes, 2 * bytesCount)
+                    };
+                    bytes = node->recvDataBuffer.bytes;
+                    // bytesLimit = node->recvDataBuffer.bytesCount;
+                }
+                pthread_mutex_unlock (&node->lock);
 
 #if defined (NEED_TO_PRINT_SEND_RECV_DATA)
-            eth_log (LES_LOG_TOPIC, "Size: Recv: TCP: PayLoad: %u, Frame: %zu", headerCount, bytesCount);
+                eth_log (LES_LOG_TOPIC, "Size: Recv: TCP: PayLoad: %u, Frame: %zu", headerCount, bytesCount);
 #endif
             
-            // get body/frame
-            error = nodeEndpointRecvData (node->remote, route, bytes, &bytesCount, 1);
-            if (error) return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorUnix (error));
+                // get body/frame
+                error = nodeEndpointRecvData (node->remote, route, bytes, &bytesCount, 1);
+                if (error) return nodeRecvFailed (node, NODE_ROUTE_TCP, nodeStateCreateErrorUnix (error));
 
-            pthread_mutex_lock (&node->lock);
-            frameCoderDecryptFrame(node->frameCoder, bytes, bytesCount);
-            pthread_mutex_unlock (&node->lock);
+                pthread_mutex_lock (&node->lock);
+                frameCoderDecryptFrame(node->frameCoder, bytes, bytesCount);
+                pthread_mutex_unlock (&node->lock);
+
+                if (node->captureStreamOpen)
+                    BRCaptureAddRecv (node->capture, node->captureStream, bytes, headerCount);
+            }
 
             // ?? node->bodySize = headerCount; ??
 
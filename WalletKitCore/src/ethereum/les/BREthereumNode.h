@@ -14,6 +14,7 @@
 #include "BREthereumMessage.h"
 #include "BREthereumNodeEndpoint.h"
 #include "BREthereumProvision.h"
+#include "support/BRCapture.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -226,6 +227,24 @@ nodeReleaseForSet (void *ignore, void *item) {
 extern void
 nodeClean (BREthereumNode node);
 
+/**
+ * Record the (decrypted) messages sent and received on the TCP route in `capture`, as a stream
+ * named 'hostname:port'.  Set before connecting; `capture` must outlive the node.
+ */
+extern void
+nodeSetCapture (BREthereumNode node,
+                BRCapture capture);
+
+/**
+ * Connect the TCP route to the stream captured for this node in `replay`, rather than to the
+ * network.  The auth handshake is skipped - captured messages are already decrypted - and sent
+ * messages are discarded.  The UDP route is not replayed and fails to connect.  Set before
+ * connecting; `replay` must outlive the node.
+ */
+extern void
+nodeSetReplay (BREthereumNode node,
+               BRCaptureReplay replay);
+
 extern BREthereumBoolean
 nodeUpdatedLocalStatus (BREthereumNode node,
                         BREthereumNodeEndpointRoute route);
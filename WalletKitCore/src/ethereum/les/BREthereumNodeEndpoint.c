@@ -364,6 +364,19 @@ nodeEndpointOpen (BREthereumNodeEndpoint endpoint,
                        NODE_ENDPOINT_OPEN_SOCKET_TIMEOUT);
 }
 
+extern int
+nodeEndpointOpenReplay (BREthereumNodeEndpoint endpoint,
+                        BREthereumNodeEndpointRoute route) {
+    if (nodeEndpointIsOpen (endpoint, route)) return 0;
+
+    int sockets[2];
+    if (socketpair (AF_UNIX, SOCK_STREAM, 0, sockets) < 0) return errno;
+
+    close (sockets[1]);
+    endpoint->sockets[route] = sockets[0];
+    return 0;
+}
+
 extern int
 nodeEndpointClose (BREthereumNodeEndpoint endpoint,
                    BREthereumNodeEndpointRoute route,
@@ -148,6 +148,15 @@ extern int
 nodeEndpointOpen (BREthereumNodeEndpoint endpoint,
                   BREthereumNodeEndpointRoute route);
 
+/**
+ * Open `route` for a replay, rather than to the network.  The socket is one end of a socket pair,
+ * with the other end closed; it is always ready but must never be read or written.  Used only for
+ * the select() and close() handling shared with network sockets.
+ */
+extern int
+nodeEndpointOpenReplay (BREthereumNodeEndpoint endpoint,
+                        BREthereumNodeEndpointRoute route);
+
 extern int
 nodeEndpointClose (BREthereumNodeEndpoint endpoint,
                    BREthereumNodeEndpointRoute route,
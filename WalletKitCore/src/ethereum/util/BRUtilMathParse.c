@@ -65,6 +65,77 @@ stringParseIsDecimal(const char *number) {
 
 #define SURELY_ENOUGH_CHARS 100     // No more than ~78 in UInt256
 
+// Decimal strings convert to and from a UInt256 a chunk of digits at a time: a chunk is the
+// largest power of 10 that fits in a limb, so that one multiply or divide pass over the limbs
+// handles a whole chunk.  With 128-bit arithmetic a limb is 64 bits and a chunk is 10^19;
+// otherwise a limb is 32 bits and a chunk is 10^9.
+#if defined (__SIZEOF_INT128__)
+typedef uint64_t           BRDecimalLimb;
+__extension__ typedef unsigned __int128 BRDecimalWide;
+#define DECIMAL_LIMB_BITS       (64)
+#define DECIMAL_LIMBS(x)        ((x).u64)
+#define DECIMAL_CHUNK_DIGITS    (19)
+#define DECIMAL_CHUNK           (10000000000000000000ull)
+#else
+typedef uint32_t           BRDecimalLimb;
+typedef uint64_t           BRDecimalWide;
+#define DECIMAL_LIMB_BITS       (32)
+#define DECIMAL_LIMBS(x)        ((x).u32)
+#define DECIMAL_CHUNK_DIGITS    (9)
+#define DECIMAL_CHUNK           (1000000000ull)
+#endif
+
+#define DECIMAL_LIMB_COUNT      (256 / DECIMAL_LIMB_BITS)
+
+// Compute `x * scale + add`; on overflow, set `overflow` to 1
+static UInt256
+decimalMulAdd (UInt256 x, BRDecimalLimb scale, BRDecimalLimb add, int *overflow) {
+    BRDecimalWide carry = add;
+    for (size_t i = 0; i < DECIMAL_LIMB_COUNT; i++) {
+        BRDecimalWide value = (BRDecimalWide) DECIMAL_LIMBS(x)[i] * scale + carry;
+        DECIMAL_LIMBS(x)[i] = (BRDecimalLimb) value;
+        carry = value >> DECIMAL_LIMB_BITS;
+    }
+    *overflow = (0 != carry);
+    return x;
+}
+
+// Divide `x` by DECIMAL_CHUNK, in place; return the remainder
+static BRDecimalLimb
+decimalDivChunk (UInt256 *x) {
+    BRDecimalWide remainder = 0;
+    for (size_t i = DECIMAL_LIMB_COUNT; i-- > 0; ) {
+        BRDecimalWide value = (remainder << DECIMAL_LIMB_BITS) | DECIMAL_LIMBS(*x)[i];
+        DECIMAL_LIMBS(*x)[i] = (BRDecimalLimb) (value / DECIMAL_CHUNK);
+        remainder = value % DECIMAL_CHUNK;
+    }
+    return (BRDecimalLimb) remainder;
+}
+
+// Fill `buffer` with the decimal digits of `x`, ending at `buffer[SURELY_ENOUGH_CHARS - 1]`
+// with '\0'.  Returns the first digit and, in `length`, the number of digits.
+static char *
+decimalFormat (UInt256 x, char buffer[SURELY_ENOUGH_CHARS], size_t *length) {
+    char *digits = &buffer[SURELY_ENOUGH_CHARS - 1];
+    *digits = '\0';
+
+    int more;
+    do {
+        BRDecimalLimb chunk = decimalDivChunk (&x);
+        more = !uint256EQL (x, UINT256_ZERO);
+
+        // All but the leading chunk are zero-padded to DECIMAL_CHUNK_DIGITS
+        size_t count = 0;
+        do {
+            *--digits = (char) ('0' + chunk % 10);
+            chunk /= 10;
+        } while (++count < DECIMAL_CHUNK_DIGITS && (more || 0 != chunk));
+    } while (more);
+
+    *length = (size_t) (&buffer[SURELY_ENOUGH_CHARS - 1] - digits);
+    return digits;
+}
+
 extern UInt256
 uint256CreateParseDecimal (const char *string, int decimals, BRCoreParseStatus *status) {
     // Check basic `string` content.
@@ -254,6 +325,32 @@ uint256CreateParse (const char *string, int base, BRCoreParseStatus *status) {
         return UINT256_ZERO;
     }
     
+    // Base 10 accumulates DECIMAL_CHUNK_DIGITS digits at a time, with one multiply-add each.
+    if (10 == base) {
+        UInt256 value = UINT256_ZERO;
+
+        // The leading chunk is short, so the rest are full.
+        size_t chunkDigits = length % DECIMAL_CHUNK_DIGITS;
+        if (0 == chunkDigits) chunkDigits = DECIMAL_CHUNK_DIGITS;
+
+        for (size_t index = 0; index < length; index += chunkDigits, chunkDigits = DECIMAL_CHUNK_DIGITS) {
+            BRDecimalLimb chunk = 0, scale = 1;
+            for (size_t digit = 0; digit < chunkDigits; digit++) {
+                chunk = 10 * chunk + (BRDecimalLimb) (string[index + digit] - '0');
+                scale = 10 * scale;
+            }
+
+            int overflow = 0;
+            value = decimalMulAdd (value, scale, chunk, &overflow);
+            if (overflow) {
+                *status = CORE_PARSE_OVERFLOW;
+                return UINT256_ZERO;
+            }
+        }
+        *status = CORE_PARSE_OK;
+        return value;
+    }
+
     // We'll process this many digits in `string`.
     size_t stringChunks = parseMaximumDigitsForUInt64InBase(base);
 
@@ -299,15 +396,6 @@ uint256CreateParse (const char *string, int base, BRCoreParseStatus *status) {
 //
 //
 //
-static char *
-coerceReverseString (const char *s) {
-    size_t len = strlen(s);
-    char *t = calloc (1 + len, 1);
-    for (size_t i = 0; i < len; i++)
-        t[len - i - 1] = s[i];
-    return t;
-}
-
 extern char *
 uint256CoerceString (UInt256 x, int base) {
     // Handle 0 explicitly, rather than in each case
@@ -333,16 +421,11 @@ uint256CoerceString (UInt256 x, int base) {
             return hexEncodeCreate (NULL, &xr.u8[xrIndex], sizeof (xr.u8) - xrIndex);
         }
             
-            // Repeatedly divide by 10; append the result with the remainder.
+            // Repeatedly divide by DECIMAL_CHUNK; prepend the remainder's digits.
         case 10: {
-            char r[257];
-            memset (r, 0, 257);
-            for (int i = 0; i < 256 && !uint256EQL(x, UINT256_ZERO); i++) {
-                uint32_t rem;
-                x = uint256Div_Small(x, base, &rem);
-                r[i] = '0' + rem;
-            }
-            return coerceReverseString(r);
+            char buffer[SURELY_ENOUGH_CHARS];
+            size_t length;
+            return strdup (decimalFormat (x, buffer, &length));
         }
             
             // Get the base 16 result and then swap hex values for binary strings.
@@ -389,35 +472,32 @@ uint256CoerceStringPrefaced (UInt256 x, int base, const char *preface) {
 
 extern char * 
 uint256CoerceStringDecimal (UInt256 x, int decimals) {
-    char *string = uint256CoerceString(x, 10);
-    
-    if (0 == decimals)
-        return string;
-    
-    int slength = (int) strlen (string);
-    if (decimals >= slength) {
-        char *result = calloc (decimals + 3, 1);  // 0.<decimals>'\0'
-        
-        // Fill to decimals
-        char format [10];
-        sprintf (format, "0.%%%ds", decimals);
-        sprintf (result, format, string);
-        
-        // Replace fills of ' ' with '0'
-        for (int i = 0; i < decimals + 2; i++) {
-            if (' ' == result[i])
-                result[i] = '0';
-        }
-        free (string);
+    char buffer[SURELY_ENOUGH_CHARS];
+    size_t length;
+    char *digits = decimalFormat (x, buffer, &length);
+
+    if (decimals <= 0)
+        return strdup (digits);
+
+    size_t fractLength = (size_t) decimals;
+
+    // 0.<zeros><digits>
+    if (fractLength >= length) {
+        char *result = malloc (fractLength + 3);
+        result[0] = '0';
+        result[1] = '.';
+        memset (&result[2], '0', fractLength - length);
+        memcpy (&result[2 + fractLength - length], digits, length + 1);
         return result;
     }
+
+    // <whole>.<fract>
     else {
-        int dindex = slength - decimals;
-        char *result = calloc (slength + 2, 1);  // <whole>.<decimals>'\0'
-        strncpy (result, string, dindex);
-        result[dindex] = '.';
-        strcpy (&result[dindex+1], &string[dindex]);
-        free (string);
+        size_t wholeLength = length - fractLength;
+        char *result = malloc (length + 2);
+        memcpy (result, digits, wholeLength);
+        result[wholeLength] = '.';
+        memcpy (&result[wholeLength + 1], &digits[wholeLength], fractLength + 1);
         return result;
     }
 }
@@ -15,6 +15,7 @@
 #include "support/BRSet.h" // BRSet
 #include "support/BRKey.h" // BRKey
 #include "support/BRArray.h"
+#include "support/BRMetrics.h"
 #include "BRGenericBase.h"
 #include "BRGenericClient.h"
 
@@ -278,6 +279,11 @@ extern "C" {
     extern void
     genManagerStop (BRGenericManager gwm);
 
+    /// Record the file service and event handler metrics in `metrics`
+    extern void
+    genManagerSetMetrics (BRGenericManager gwm,
+                          BRMetrics metrics);
+
     extern void
     genManagerConnect (BRGenericManager gwm);
 
@@ -331,6 +337,29 @@ extern "C" {
                                uint64_t blockHeight,
                                int error);
 
+    /**
+     * Recover a transfer from already parsed values, as `genManagerRecoverTransfer()` does from
+     * strings.  See `BRGenericWalletManagerRecoverTransferBinary` for the `hash`, `from` and `to`
+     * bytes.
+     *
+     * @return the transfer, or NULL if a value is malformed or out of the network's range
+     */
+    extern BRGenericTransfer
+    genManagerRecoverTransferBinary (BRGenericManager gwm,
+                                     BRGenericWallet wallet,
+                                     const uint8_t *hash,
+                                     size_t hashCount,
+                                     const char *uids,
+                                     const uint8_t *from,
+                                     size_t fromCount,
+                                     const uint8_t *to,
+                                     size_t toCount,
+                                     UInt256 amount,
+                                     UInt256 fee,
+                                     uint64_t timestamp,
+                                     uint64_t blockHeight,
+                                     int error);
+
     extern void
     genManagerWipe (BRGenericNetwork network,
                     const char *storagePath);
@@ -189,6 +189,21 @@ extern "C" {
                                                                            uint64_t blockHeight,
                                                                            int error);
 
+    // Create a transfer from already parsed values.  The `hash`, `from` and `to` are the raw bytes
+    // of the network's hash and address types; a `to` with zero bytes is the fee address.  Returns
+    // NULL, without asserting, if a size doesn't match or the `amount` or `fee` is out of range.
+    typedef BRGenericTransferRef (*BRGenericWalletManagerRecoverTransferBinary) (const uint8_t *hash,
+                                                                                 size_t hashCount,
+                                                                                 const uint8_t *from,
+                                                                                 size_t fromCount,
+                                                                                 const uint8_t *to,
+                                                                                 size_t toCount,
+                                                                                 UInt256 amount,
+                                                                                 UInt256 fee,
+                                                                                 uint64_t timestamp,
+                                                                                 uint64_t blockHeight,
+                                                                                 int error);
+
     typedef BRArrayOf(BRGenericTransferRef) (*BRGenericWalletManagerRecoverTransfersFromRawTransaction) (uint8_t *bytes,
                                                                                                          size_t   bytesCount);
 
@@ -196,6 +211,7 @@ extern "C" {
 
     typedef struct {
         BRGenericWalletManagerRecoverTransfer transferRecover;
+        BRGenericWalletManagerRecoverTransferBinary transferRecoverBinary;
         BRGenericWalletManagerRecoverTransfersFromRawTransaction transfersRecoverFromRawTransaction;
         BRGenericWalletManagerGetAPISyncType apiSyncType;
     } BRGenericManagerHandlers;
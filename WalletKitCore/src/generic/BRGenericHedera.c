@@ -429,6 +429,47 @@ genericHederaWalletManagerRecoverTransfer (const char *hash,
     return (BRGenericTransferRef) transfer;
 }
 
+static BRGenericTransferRef
+genericHederaWalletManagerRecoverTransferBinary (const uint8_t *hash,
+                                                 size_t hashCount,
+                                                 const uint8_t *from,
+                                                 size_t fromCount,
+                                                 const uint8_t *to,
+                                                 size_t toCount,
+                                                 UInt256 amount,
+                                                 UInt256 fee,
+                                                 uint64_t timestamp,
+                                                 uint64_t blockHeight,
+                                                 int error) {
+    BRHederaTransactionHash txHash;
+
+    // Fail, rather than truncate or abort, on values that are not HBAR's: a hash or address of
+    // another size, or an amount or fee beyond the (signed) 64 bits of tinybars.
+    if (NULL == hash || sizeof (txHash.bytes) != hashCount ||
+        NULL == from || HEDERA_ADDRESS_SERIALIZED_SIZE != fromCount ||
+        (0 != toCount && (NULL == to || HEDERA_ADDRESS_SERIALIZED_SIZE != toCount)) ||
+        0 != (amount.u64[1] | amount.u64[2] | amount.u64[3]) || amount.u64[0] > INT64_MAX ||
+        0 != (fee.u64[1]    | fee.u64[2]    | fee.u64[3])    || fee.u64[0]    > INT64_MAX) return NULL;
+
+    BRHederaUnitTinyBar amountHbar = (BRHederaUnitTinyBar) amount.u64[0];
+    BRHederaUnitTinyBar feeHbar    = (BRHederaUnitTinyBar) fee.u64[0];
+    BRHederaAddress toAddress   = (0 == toCount
+                                   ? hederaAddressCreateFromString ("__fee__", false)
+                                   : hederaAddressCreateFromBytes (to, toCount));
+    BRHederaAddress fromAddress = hederaAddressCreateFromBytes (from, fromCount);
+
+    memcpy (txHash.bytes, hash, sizeof (txHash.bytes));
+
+    BRHederaTransaction transfer = hederaTransactionCreate(fromAddress, toAddress, amountHbar,
+                                                           feeHbar, NULL, txHash, timestamp, blockHeight,
+                                                           error);
+
+    hederaAddressFree (toAddress);
+    hederaAddressFree (fromAddress);
+
+    return (BRGenericTransferRef) transfer;
+}
+
 static BRArrayOf(BRGenericTransferRef)
 genericHederaWalletManagerRecoverTransfersFromRawTransaction (uint8_t *bytes,
                                                             size_t   bytesCount) {
@@ -501,6 +542,7 @@ struct BRGenericHandersRecord genericHederaHandlersRecord = {
 
     { // Wallet Manager
         genericHederaWalletManagerRecoverTransfer,
+        genericHederaWalletManagerRecoverTransferBinary,
         genericHederaWalletManagerRecoverTransfersFromRawTransaction,
         genericHederaWalletManagerGetAPISyncType,
     },
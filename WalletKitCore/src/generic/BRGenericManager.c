@@ -414,6 +414,13 @@ genManagerGetPrimaryWallet (BRGenericManager gwm) {
    return gwm->wallet;
 }
 
+extern void
+genManagerSetMetrics (BRGenericManager gwm,
+                      BRMetrics metrics) {
+    fileServiceSetMetrics  (gwm->fileService, metrics);
+    eventHandlerSetMetrics (gwm->handler,     metrics);
+}
+
 extern void
 genManagerConnect (BRGenericManager gwm) {
     eventHandlerStart (gwm->handler);
@@ -503,6 +510,15 @@ genManagerSubmitTransfer (BRGenericManager gwm,
     free (tx);
 }
 
+static BRGenericTransfer
+genManagerRecoverTransferInit (BRGenericManager gwm,
+                               BRGenericWallet wallet,
+                               BRGenericTransferRef ref,
+                               const char *uids,
+                               uint64_t timestamp,
+                               uint64_t blockHeight,
+                               int error);
+
 extern BRGenericTransfer
 genManagerRecoverTransfer (BRGenericManager gwm,
                            BRGenericWallet wallet,
@@ -516,8 +532,47 @@ genManagerRecoverTransfer (BRGenericManager gwm,
                            uint64_t timestamp,
                            uint64_t blockHeight,
                            int error) {
-    BRGenericTransfer transfer = genTransferAllocAndInit (gwm->handlers->type,
-                                                          gwm->handlers->manager.transferRecover (hash, from, to, amount, currency, fee, timestamp, blockHeight, error));
+    return genManagerRecoverTransferInit (gwm, wallet,
+                                          gwm->handlers->manager.transferRecover (hash, from, to, amount, currency, fee, timestamp, blockHeight, error),
+                                          uids, timestamp, blockHeight, error);
+}
+
+extern BRGenericTransfer
+genManagerRecoverTransferBinary (BRGenericManager gwm,
+                                 BRGenericWallet wallet,
+                                 const uint8_t *hash,
+                                 size_t hashCount,
+                                 const char *uids,
+                                 const uint8_t *from,
+                                 size_t fromCount,
+                                 const uint8_t *to,
+                                 size_t toCount,
+                                 UInt256 amount,
+                                 UInt256 fee,
+                                 uint64_t timestamp,
+                                 uint64_t blockHeight,
+                                 int error) {
+    BRGenericTransferRef ref = gwm->handlers->manager.transferRecoverBinary (hash, hashCount,
+                                                                             from, fromCount,
+                                                                             to, toCount,
+                                                                             amount, fee,
+                                                                             timestamp, blockHeight, error);
+
+    // ... values the network can't represent
+    if (NULL == ref) return NULL;
+
+    return genManagerRecoverTransferInit (gwm, wallet, ref, uids, timestamp, blockHeight, error);
+}
+
+static BRGenericTransfer
+genManagerRecoverTransferInit (BRGenericManager gwm,
+                               BRGenericWallet wallet,
+                               BRGenericTransferRef ref,
+                               const char *uids,
+                               uint64_t timestamp,
+                               uint64_t blockHeight,
+                               int error) {
+    BRGenericTransfer transfer = genTransferAllocAndInit (gwm->handlers->type, ref);
 
     transfer->uids = strdup (uids);
 
@@ -423,6 +423,45 @@ genericRippleWalletManagerRecoverTransfer (const char *hash,
     return (BRGenericTransferRef) transfer;
 }
 
+static BRGenericTransferRef
+genericRippleWalletManagerRecoverTransferBinary (const uint8_t *hash,
+                                                 size_t hashCount,
+                                                 const uint8_t *from,
+                                                 size_t fromCount,
+                                                 const uint8_t *to,
+                                                 size_t toCount,
+                                                 UInt256 amount,
+                                                 UInt256 fee,
+                                                 uint64_t timestamp,
+                                                 uint64_t blockHeight,
+                                                 int error) {
+    BRRippleTransactionHash txId;
+
+    // Fail, rather than truncate or abort, on values that are not XRP's: a hash or address of
+    // another size, or an amount or fee beyond 64 bits of drops.
+    if (NULL == hash || sizeof (txId.bytes) != hashCount ||
+        NULL == from || RIPPLE_ADDRESS_BYTES != fromCount ||
+        (0 != toCount && (NULL == to || RIPPLE_ADDRESS_BYTES != toCount)) ||
+        0 != (amount.u64[1] | amount.u64[2] | amount.u64[3]) ||
+        0 != (fee.u64[1]    | fee.u64[2]    | fee.u64[3])) return NULL;
+
+    BRRippleUnitDrops amountDrops = amount.u64[0];
+    BRRippleUnitDrops feeDrops    = fee.u64[0];
+    BRRippleAddress toAddress   = (0 == toCount
+                                   ? rippleAddressCreateFromString ("__fee__", false)
+                                   : rippleAddressCreateFromBytes ((uint8_t *) to, (int) toCount));
+    BRRippleAddress fromAddress = rippleAddressCreateFromBytes ((uint8_t *) from, (int) fromCount);
+
+    memcpy (txId.bytes, hash, sizeof (txId.bytes));
+
+    BRRippleTransfer transfer = rippleTransferCreate(fromAddress, toAddress, amountDrops, feeDrops, txId, timestamp, blockHeight, error);
+
+    rippleAddressFree (toAddress);
+    rippleAddressFree (fromAddress);
+
+    return (BRGenericTransferRef) transfer;
+}
+
 static BRArrayOf(BRGenericTransferRef)
 genericRippleWalletManagerRecoverTransfersFromRawTransaction (uint8_t *bytes,
                                                             size_t   bytesCount) {
@@ -495,6 +534,7 @@ struct BRGenericHandersRecord genericRippleHandlersRecord = {
 
     { // Wallet Manager
         genericRippleWalletManagerRecoverTransfer,
+        genericRippleWalletManagerRecoverTransferBinary,
         genericRippleWalletManagerRecoverTransfersFromRawTransaction,
         genericRippleWalletManagerGetAPISyncType,
     },
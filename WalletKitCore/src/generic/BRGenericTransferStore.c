@@ -0,0 +1,150 @@
+//
+//  BRGenericTransferStore.c
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "support/BRArray.h"
+#include "support/BRSet.h"
+#include "BRGenericTransferStore.h"
+
+struct BRGenericTransferStoreRecord {
+    BRGenericTransferStoreHandlers handlers;
+
+    /// The transfers, by `handlers.hash` and `handlers.equal`
+    BRSet *index;
+
+    /// The transfers, by `handlers.compare`
+    BRArrayOf(void*) ordered;
+};
+
+extern BRGenericTransferStore
+genTransferStoreCreate (BRGenericTransferStoreHandlers handlers,
+                        size_t capacity) {
+    assert (NULL != handlers.hash && NULL != handlers.equal && NULL != handlers.compare);
+
+    BRGenericTransferStore store = calloc (1, sizeof (struct BRGenericTransferStoreRecord));
+    assert (NULL != store);
+
+    store->handlers = handlers;
+    store->index    = BRSetNew (handlers.hash, handlers.equal, capacity);
+    array_new (store->ordered, (capacity > 0 ? capacity : 1));
+
+    return store;
+}
+
+extern void
+genTransferStoreRelease (BRGenericTransferStore store) {
+    if (NULL == store) return;
+
+    BRSetFree (store->index);
+    array_free (store->ordered);
+    free (store);
+}
+
+extern size_t
+genTransferStoreCount (BRGenericTransferStore store) {
+    return array_count (store->ordered);
+}
+
+extern void *
+genTransferStoreGet (BRGenericTransferStore store,
+                     const void *transfer) {
+    return BRSetGet (store->index, transfer);
+}
+
+extern int
+genTransferStoreHas (BRGenericTransferStore store,
+                     const void *transfer) {
+    return BRSetContains (store->index, transfer);
+}
+
+// The index of the first transfer ordered after `transfer`
+static size_t
+genTransferStoreUpperBound (BRGenericTransferStore store,
+                            const void *transfer) {
+    size_t lo = 0, hi = array_count (store->ordered);
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (store->handlers.compare (store->ordered[mid], transfer) <= 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// The index of the first transfer not ordered before `transfer`
+static size_t
+genTransferStoreLowerBound (BRGenericTransferStore store,
+                            const void *transfer) {
+    size_t lo = 0, hi = array_count (store->ordered);
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (store->handlers.compare (store->ordered[mid], transfer) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+extern int
+genTransferStoreAdd (BRGenericTransferStore store,
+                     void *transfer) {
+    assert (NULL != transfer);
+    if (BRSetContains (store->index, transfer)) return 0;
+
+    BRSetAdd (store->index, transfer);
+
+    // Transfers mostly arrive in order; append without a search when `transfer` is the newest.
+    size_t count = array_count (store->ordered);
+    if (0 == count || store->handlers.compare (store->ordered[count - 1], transfer) <= 0)
+        array_add (store->ordered, transfer);
+    else
+        array_insert (store->ordered, genTransferStoreUpperBound (store, transfer), transfer);
+
+    return 1;
+}
+
+extern void *
+genTransferStoreRemove (BRGenericTransferStore store,
+                        const void *transfer) {
+    void *stored = BRSetRemove (store->index, transfer);
+    if (NULL == stored) return NULL;
+
+    // Find `stored` itself among the transfers that order the same
+    size_t count = array_count (store->ordered);
+    for (size_t index = genTransferStoreLowerBound (store, stored); index < count; index++)
+        if (stored == store->ordered[index]) {
+            array_rm (store->ordered, index);
+            break;
+        }
+
+    return stored;
+}
+
+extern void *
+genTransferStoreGetAt (BRGenericTransferStore store,
+                       size_t index) {
+    assert (index < array_count (store->ordered));
+    return store->ordered[index];
+}
+
+extern size_t
+genTransferStoreGetRange (BRGenericTransferStore store,
+                          size_t offset,
+                          void *transfers[],
+                          size_t transfersCount) {
+    size_t count = array_count (store->ordered);
+    if (offset >= count) return 0;
+
+    if (transfersCount > count - offset) transfersCount = count - offset;
+    memcpy (transfers, &store->ordered[offset], transfersCount * sizeof (void*));
+    return transfersCount;
+}
@@ -0,0 +1,93 @@
+//
+//  BRGenericTransferStore.h
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#ifndef BRGenericTransferStore_h
+#define BRGenericTransferStore_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    // MARK: - Transfer Store
+
+    ///
+    /// A wallet's transfers, indexed by hash for constant time lookup and kept in (block, index)
+    /// order for paging.  The store holds opaque transfer pointers; it does not copy or free them.
+    /// Transfers that compare equal in order keep their insertion order.
+    ///
+    /// The store is not thread safe; it is expected to be protected by the owning wallet's lock.
+    ///
+    typedef struct BRGenericTransferStoreRecord *BRGenericTransferStore;
+
+    typedef struct {
+        /// A hash value; transfers that are `equal` must have the same hash value.
+        size_t (*hash) (const void *transfer);
+
+        /// True (non-zero) if `t1` and `t2` are the same transfer
+        int (*equal) (const void *t1, const void *t2);
+
+        /// Negative, zero or positive as `t1` orders before, with or after `t2` - typically by
+        /// block height and then by the index in the block.
+        int (*compare) (const void *t1, const void *t2);
+    } BRGenericTransferStoreHandlers;
+
+    extern BRGenericTransferStore
+    genTransferStoreCreate (BRGenericTransferStoreHandlers handlers,
+                            size_t capacity);
+
+    /// Release the store, but not the transfers.  Use `genTransferStoreGetAt()` to free those
+    /// first, if owned.
+    extern void
+    genTransferStoreRelease (BRGenericTransferStore store);
+
+    extern size_t
+    genTransferStoreCount (BRGenericTransferStore store);
+
+    /// Returns the stored transfer equal to `transfer`, or NULL.
+    extern void *
+    genTransferStoreGet (BRGenericTransferStore store,
+                         const void *transfer);
+
+    extern int
+    genTransferStoreHas (BRGenericTransferStore store,
+                         const void *transfer);
+
+    /// Add `transfer`, if an equal transfer is not already stored.  Returns true if added.
+    extern int
+    genTransferStoreAdd (BRGenericTransferStore store,
+                         void *transfer);
+
+    /// Remove the stored transfer equal to `transfer`.  Returns the removed transfer, which the
+    /// caller may then free, or NULL if there is no such transfer.
+    extern void *
+    genTransferStoreRemove (BRGenericTransferStore store,
+                            const void *transfer);
+
+    /// Returns the transfer at `index` in (block, index) order.  The index must be less than
+    /// `genTransferStoreCount()`.
+    extern void *
+    genTransferStoreGetAt (BRGenericTransferStore store,
+                           size_t index);
+
+    /// Fill `transfers` with up to `transfersCount` transfers, in (block, index) order, starting
+    /// at `offset`.  Returns the number filled; zero once `offset` is past the end.
+    extern size_t
+    genTransferStoreGetRange (BRGenericTransferStore store,
+                              size_t offset,
+                              void *transfers[],
+                              size_t transfersCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRGenericTransferStore_h */
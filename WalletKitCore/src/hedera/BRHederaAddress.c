@@ -211,3 +211,17 @@ void hederaAddressSerialize(BRHederaAddress address, uint8_t * buffer, size_t si
     memcpy(buffer + (2 * componentSize), &account, componentSize);
 }
 
+
+BRHederaAddress hederaAddressCreateFromBytes(const uint8_t * buffer, size_t bufferSize)
+{
+    assert(bufferSize == HEDERA_ADDRESS_SERIALIZED_SIZE);
+
+    // The 3 int64_t numbers, in network order, as written by hederaAddressSerialize()
+    size_t componentSize = sizeof (BRHederaAddressComponentType);
+
+    BRHederaAddress address = calloc(1, sizeof(struct BRHederaAddressRecord));
+    address->shard   = (BRHederaAddressComponentType) UInt64GetBE(buffer);
+    address->realm   = (BRHederaAddressComponentType) UInt64GetBE(buffer + componentSize);
+    address->account = (BRHederaAddressComponentType) UInt64GetBE(buffer + (2 * componentSize));
+    return address;
+}
@@ -112,6 +112,17 @@ hederaAddressEqual (BRHederaAddress a1, BRHederaAddress a2);
 extern void
 hederaAddressSerialize(BRHederaAddress address, uint8_t * buffer, size_t bufferSize);
 
+/**
+ * Create an Hedera address from the bytes produced by `hederaAddressSerialize()`
+ *
+ * @param buffer      - the serialized address
+ * @param bufferSize  - must be HEDERA_ADDRESS_SERIALIZED_SIZE
+ *
+ * @return address - caller must free with hederaAddressFree()
+ */
+extern BRHederaAddress
+hederaAddressCreateFromBytes(const uint8_t * buffer, size_t bufferSize);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,12 +12,110 @@
 #include "proto/Transaction.pb-c.h"
 #include "proto/TransactionBody.pb-c.h"
 #include <stdlib.h>
+#include <string.h>
+#include <assert.h>
 
 const size_t max_memo_size = 100L;
 
-Proto__AccountID * createAccountID (BRHederaAddress address)
+// MARK: - Arena
+
+// Every protobuf object built to pack or unpack a transaction lives only for that one call, so
+// they are bump-allocated from an arena (via protobuf-c's ProtobufCAllocator) and released all
+// at once.  The first `HEDERA_ARENA_INLINE_SIZE` bytes are on the stack; a crypto transfer fits.
+#define HEDERA_ARENA_INLINE_SIZE      (2048)
+#define HEDERA_ARENA_ALIGNMENT        (16)
+
+typedef struct BRHederaArenaBlockRecord {
+    struct BRHederaArenaBlockRecord *next;
+} BRHederaArenaBlock;
+
+typedef struct {
+    uint8_t *buffer;
+    size_t   size;
+    size_t   used;
+    BRHederaArenaBlock *blocks;    // overflow blocks, from malloc()
+    uint8_t  inlineBuffer[HEDERA_ARENA_INLINE_SIZE] __attribute__((aligned(HEDERA_ARENA_ALIGNMENT)));
+} BRHederaArena;
+
+#define HEDERA_ARENA_BLOCK_HEADER_SIZE                                                  \
+    ((sizeof (BRHederaArenaBlock) + HEDERA_ARENA_ALIGNMENT - 1) & ~(size_t) (HEDERA_ARENA_ALIGNMENT - 1))
+
+static void
+hederaArenaInit (BRHederaArena *arena)
+{
+    arena->buffer = arena->inlineBuffer;
+    arena->size   = HEDERA_ARENA_INLINE_SIZE;
+    arena->used   = 0;
+    arena->blocks = NULL;
+}
+
+static void
+hederaArenaRelease (BRHederaArena *arena)
+{
+    while (NULL != arena->blocks) {
+        BRHederaArenaBlock *block = arena->blocks;
+        arena->blocks = block->next;
+        free (block);
+    }
+    arena->buffer = NULL;
+    arena->size   = 0;
+    arena->used   = 0;
+}
+
+static void *
+hederaArenaAlloc (void *allocatorData, size_t size)
+{
+    BRHederaArena *arena = allocatorData;
+    size = (size + HEDERA_ARENA_ALIGNMENT - 1) & ~(size_t) (HEDERA_ARENA_ALIGNMENT - 1);
+
+    if (size > arena->size - arena->used) {
+        // Start a new block; at least double the inline size so that blocks stay few.
+        size_t blockSize = (size > 2 * HEDERA_ARENA_INLINE_SIZE ? size : 2 * HEDERA_ARENA_INLINE_SIZE);
+        BRHederaArenaBlock *block = malloc (HEDERA_ARENA_BLOCK_HEADER_SIZE + blockSize);
+        if (NULL == block) return NULL;
+
+        block->next   = arena->blocks;
+        arena->blocks = block;
+        arena->buffer = (uint8_t *) block + HEDERA_ARENA_BLOCK_HEADER_SIZE;
+        arena->size   = blockSize;
+        arena->used   = 0;
+    }
+
+    void *pointer = arena->buffer + arena->used;
+    arena->used += size;
+    return pointer;
+}
+
+static void
+hederaArenaFree (void *allocatorData, void *pointer)
+{
+    // Nothing; everything is released by hederaArenaRelease()
+}
+
+static ProtobufCAllocator
+hederaArenaAllocator (BRHederaArena *arena)
+{
+    return (ProtobufCAllocator) {
+        hederaArenaAlloc,
+        hederaArenaFree,
+        arena
+    };
+}
+
+static void *
+hederaArenaCalloc (BRHederaArena *arena, size_t count, size_t size)
 {
-    Proto__AccountID *protoAccountID = calloc(1, sizeof(Proto__AccountID));
+    void *pointer = hederaArenaAlloc (arena, count * size);
+    assert (NULL != pointer);
+    memset (pointer, 0, count * size);
+    return pointer;
+}
+
+// MARK: - Pack
+
+static Proto__AccountID * createAccountID (BRHederaArena *arena, BRHederaAddress address)
+{
+    Proto__AccountID *protoAccountID = hederaArenaCalloc(arena, 1, sizeof(Proto__AccountID));
     proto__account_id__init(protoAccountID);
     protoAccountID->shardnum = hederaAddressGetShard (address);
     protoAccountID->realmnum = hederaAddressGetRealm (address);
@@ -25,42 +123,50 @@ Proto__AccountID * createAccountID (BRHederaAddress address)
     return protoAccountID;
 }
 
-Proto__Timestamp * createTimeStamp  (BRHederaTimeStamp timeStamp)
+static Proto__Timestamp * createTimeStamp  (BRHederaArena *arena, BRHederaTimeStamp timeStamp)
 {
-    Proto__Timestamp *ts = calloc(1, sizeof(Proto__Timestamp));
+    Proto__Timestamp *ts = hederaArenaCalloc(arena, 1, sizeof(Proto__Timestamp));
     proto__timestamp__init(ts);
     ts->seconds = timeStamp.seconds;
     ts->nanos = timeStamp.nano;
     return ts;
 }
 
-Proto__TransactionID * createProtoTransactionID (BRHederaAddress address, BRHederaTimeStamp timeStamp)
+static Proto__TransactionID * createProtoTransactionID (BRHederaArena *arena, BRHederaAddress address, BRHederaTimeStamp timeStamp)
 {
-    Proto__TransactionID *txID = calloc(1, sizeof(Proto__TransactionID));
+    Proto__TransactionID *txID = hederaArenaCalloc(arena, 1, sizeof(Proto__TransactionID));
     proto__transaction_id__init(txID);
-    txID->transactionvalidstart = createTimeStamp(timeStamp);
-    txID->accountid = createAccountID(address);
+    txID->transactionvalidstart = createTimeStamp(arena, timeStamp);
+    txID->accountid = createAccountID(arena, address);
 
     return txID;
 }
 
-Proto__Duration * createTransactionDuration(int64_t seconds)
+static Proto__Duration * createTransactionDuration(BRHederaArena *arena, int64_t seconds)
 {
-    Proto__Duration * duration = calloc(1, sizeof(Proto__Duration));
+    Proto__Duration * duration = hederaArenaCalloc(arena, 1, sizeof(Proto__Duration));
     proto__duration__init(duration);
     duration->seconds = seconds;
     return duration;
 }
 
-Proto__AccountAmount * createAccountAmount (BRHederaAddress address, int64_t amount)
+static Proto__AccountAmount * createAccountAmount (BRHederaArena *arena, BRHederaAddress address, int64_t amount)
 {
-    Proto__AccountAmount * accountAmount = calloc(1, sizeof(Proto__AccountAmount));
+    Proto__AccountAmount * accountAmount = hederaArenaCalloc(arena, 1, sizeof(Proto__AccountAmount));
     proto__account_amount__init(accountAmount);
-    accountAmount->accountid = createAccountID(address);
+    accountAmount->accountid = createAccountID(arena, address);
     accountAmount->amount = amount;
     return accountAmount;
 }
 
+static char * createMemo (BRHederaArena *arena, const char * memo)
+{
+    size_t memoSize = strnlen(memo, max_memo_size);
+    char * memoCopy = hederaArenaCalloc(arena, 1, memoSize + 1);
+    memcpy(memoCopy, memo, memoSize);
+    return memoCopy;
+}
+
 uint8_t * hederaTransactionBodyPack (BRHederaAddress source,
                                        BRHederaAddress target,
                                        BRHederaAddress nodeAddress,
@@ -70,17 +176,20 @@ uint8_t * hederaTransactionBodyPack (BRHederaAddress source,
                                        const char * memo,
                                        size_t *size)
 {
-    Proto__TransactionBody *body = calloc(1, sizeof(Proto__TransactionBody));
+    BRHederaArena arena;
+    hederaArenaInit (&arena);
+
+    Proto__TransactionBody *body = hederaArenaCalloc(&arena, 1, sizeof(Proto__TransactionBody));
     proto__transaction_body__init(body);
 
     // Create a transaction ID
-    body->transactionid = createProtoTransactionID(source, timeStamp);
-    body->nodeaccountid = createAccountID(nodeAddress);
+    body->transactionid = createProtoTransactionID(&arena, source, timeStamp);
+    body->nodeaccountid = createAccountID(&arena, nodeAddress);
     body->transactionfee = (uint64_t)fee;
 
     // Docs say the limit of 100 is enforced. The max size of not defined
     // in the .proto file so I guess we just have to trust that it is string with max 100 chars
-    if (memo) body->memo = strndup(memo, max_memo_size);
+    if (memo) body->memo = createMemo(&arena, memo);
 
     // Set the duration
     // *** NOTE 1 *** if the transaction is unable to be verified in this
@@ -88,54 +197,50 @@ uint8_t * hederaTransactionBodyPack (BRHederaAddress source,
     // is 120. I have set ours to 180 since it requires a couple of extra hops
     // *** NOTE 2 *** if you change this value then it will break the unit tests
     // since it will change the serialized bytes.
-    body->transactionvalidduration = createTransactionDuration(180);
+    body->transactionvalidduration = createTransactionDuration(&arena, 180);
 
     // We are creating a "Cryto Transfer" transaction which has a transfer list
     body->data_case =  PROTO__TRANSACTION_BODY__DATA_CRYPTO_TRANSFER;
-    body->cryptotransfer = calloc(1, sizeof(Proto__CryptoTransferTransactionBody));
+    body->cryptotransfer = hederaArenaCalloc(&arena, 1, sizeof(Proto__CryptoTransferTransactionBody));
     proto__crypto_transfer_transaction_body__init(body->cryptotransfer);
-    body->cryptotransfer->transfers = calloc(1, sizeof(Proto__TransferList));
+    body->cryptotransfer->transfers = hederaArenaCalloc(&arena, 1, sizeof(Proto__TransferList));
     proto__transfer_list__init(body->cryptotransfer->transfers);
 
     // We are only supporting sending from A to B at this point - so create 2 transfers
     body->cryptotransfer->transfers->n_accountamounts = 2;
-    body->cryptotransfer->transfers->accountamounts = calloc(2, sizeof(Proto__AccountAmount*));
+    body->cryptotransfer->transfers->accountamounts = hederaArenaCalloc(&arena, 2, sizeof(Proto__AccountAmount*));
     // NOTE - the amounts in the transfer MUST add up to 0
-    body->cryptotransfer->transfers->accountamounts[0] = createAccountAmount(source, -(amount));
-    body->cryptotransfer->transfers->accountamounts[1] = createAccountAmount(target, amount);
+    body->cryptotransfer->transfers->accountamounts[0] = createAccountAmount(&arena, source, -(amount));
+    body->cryptotransfer->transfers->accountamounts[1] = createAccountAmount(&arena, target, amount);
 
     // Serialize the transaction body
     *size = proto__transaction_body__get_packed_size(body);
     uint8_t * buffer = calloc(1, *size);
     proto__transaction_body__pack(body, buffer);
 
-    // Free the body object now that we have serialized to bytes
-    proto__transaction_body__free_unpacked(body, NULL);
+    // Release the body object, all at once, now that we have serialized to bytes
+    hederaArenaRelease (&arena);
 
     return buffer;
 }
 
-Proto__SignatureMap * createSigMap(uint8_t *signature, uint8_t * publicKey)
+static Proto__SignatureMap * createSigMap(BRHederaArena *arena,
+                                          uint8_t *signature, size_t signatureSize,
+                                          uint8_t * publicKey, size_t publicKeySize)
 {
-    Proto__SignatureMap * sigMap = calloc(1, sizeof(Proto__SignatureMap));
+    Proto__SignatureMap * sigMap = hederaArenaCalloc(arena, 1, sizeof(Proto__SignatureMap));
     proto__signature_map__init(sigMap);
-    sigMap->sigpair = calloc(1, sizeof(Proto__SignaturePair*)); // A single signature
-    sigMap->sigpair[0] = calloc(1, sizeof(Proto__SignaturePair));
+    sigMap->sigpair = hederaArenaCalloc(arena, 1, sizeof(Proto__SignaturePair*)); // A single signature
+    sigMap->sigpair[0] = hederaArenaCalloc(arena, 1, sizeof(Proto__SignaturePair));
     proto__signature_pair__init(sigMap->sigpair[0]);
     sigMap->sigpair[0]->signature_case = PROTO__SIGNATURE_PAIR__SIGNATURE_ED25519;
 
-    // We need to take copies of the the following fields or else we
-    // get a double free assert.  They will get freed later in the call
-    // to proto__transaction__free_unpacked
-    uint8_t * pubKeyBuffer = calloc(1, 32);
-    memcpy(pubKeyBuffer, publicKey, 32);
-    uint8_t * sigCopy = calloc(1, 64);
-    memcpy(sigCopy, signature, 64);
-
-    sigMap->sigpair[0]->pubkeyprefix.data = pubKeyBuffer;
-    sigMap->sigpair[0]->pubkeyprefix.len = 32;
-    sigMap->sigpair[0]->ed25519.data = sigCopy;
-    sigMap->sigpair[0]->ed25519.len = 64;
+    // The signature map is only ever packed, never freed by protobuf-c, so these
+    // can reference the caller's buffers directly rather than copies.
+    sigMap->sigpair[0]->pubkeyprefix.data = publicKey;
+    sigMap->sigpair[0]->pubkeyprefix.len = publicKeySize;
+    sigMap->sigpair[0]->ed25519.data = signature;
+    sigMap->sigpair[0]->ed25519.len = signatureSize;
     sigMap->n_sigpair = 1;
 
     return sigMap;
@@ -146,28 +251,87 @@ uint8_t * hederaTransactionPack (uint8_t * signature, size_t signatureSize,
                                       uint8_t * body, size_t bodySize,
                                       size_t * serializedSize)
 {
-    struct _Proto__Transaction * transaction = calloc(1, sizeof(struct _Proto__Transaction));
+    BRHederaArena arena;
+    hederaArenaInit (&arena);
+
+    struct _Proto__Transaction * transaction = hederaArenaCalloc(&arena, 1, sizeof(struct _Proto__Transaction));
     proto__transaction__init(transaction);
     transaction->body_data_case = PROTO__TRANSACTION__BODY_DATA_BODY_BYTES;
 
     // Attach the signature and the bytes to our transaction object
-    transaction->sigmap = createSigMap(signature, publicKey);
-
-    // The call to free_unpacked below will delete the .data field, so take
-    // a copy here so we don't get a double free
-    uint8_t * bodyCopy = calloc(1, bodySize);
-    memcpy(bodyCopy, body, bodySize);
-    transaction->bodybytes.data = bodyCopy;
+    transaction->sigmap = createSigMap(&arena, signature, signatureSize, publicKey, publicKeySize);
+    transaction->bodybytes.data = body;
     transaction->bodybytes.len = bodySize;
-    transaction->body_data_case = PROTO__TRANSACTION__BODY_DATA_BODY_BYTES;
 
     // Get the packed bytes
     *serializedSize = proto__transaction__get_packed_size(transaction);
     uint8_t * serializeBytes = calloc(1, *serializedSize);
     proto__transaction__pack(transaction, serializeBytes);
 
-    // Free the transaction now that we have serialized to bytes
-    proto__transaction__free_unpacked(transaction, NULL);
+    // Release the transaction now that we have serialized to bytes
+    hederaArenaRelease (&arena);
 
     return serializeBytes;
 }
+
+// MARK: - Unpack
+
+static BRHederaAddress createAddress (const Proto__AccountID *accountID)
+{
+    return hederaAddressCreate (accountID->shardnum, accountID->realmnum, accountID->accountnum);
+}
+
+int hederaTransactionUnpack (const uint8_t * bytes, size_t bytesSize,
+                             BRHederaAddress * source,
+                             BRHederaAddress * target,
+                             BRHederaAddress * nodeAddress,
+                             BRHederaUnitTinyBar * amount,
+                             BRHederaUnitTinyBar * fee,
+                             BRHederaTimeStamp * timeStamp)
+{
+    BRHederaArena arena;
+    hederaArenaInit (&arena);
+    ProtobufCAllocator allocator = hederaArenaAllocator (&arena);
+    int success = 0;
+
+    // Both the transaction and its body bytes unpack into the same arena
+    Proto__Transaction *transaction = proto__transaction__unpack (&allocator, bytesSize, bytes);
+    Proto__TransactionBody *body = NULL;
+
+    if (NULL != transaction &&
+        PROTO__TRANSACTION__BODY_DATA_BODY_BYTES == transaction->body_data_case)
+        body = proto__transaction_body__unpack (&allocator,
+                                                transaction->bodybytes.len,
+                                                transaction->bodybytes.data);
+
+    if (NULL != body &&
+        PROTO__TRANSACTION_BODY__DATA_CRYPTO_TRANSFER == body->data_case &&
+        NULL != body->transactionid &&
+        NULL != body->transactionid->transactionvalidstart &&
+        NULL != body->nodeaccountid &&
+        NULL != body->cryptotransfer &&
+        NULL != body->cryptotransfer->transfers &&
+        2 == body->cryptotransfer->transfers->n_accountamounts) {
+        // The source is the debited account, with the negative amount
+        Proto__AccountAmount **accountAmounts = body->cryptotransfer->transfers->accountamounts;
+        size_t sourceIndex = (accountAmounts[0]->amount <= 0 ? 0 : 1);
+
+        if (NULL != accountAmounts[0]->accountid && NULL != accountAmounts[1]->accountid) {
+            *source      = createAddress (accountAmounts[sourceIndex]->accountid);
+            *target      = createAddress (accountAmounts[1 - sourceIndex]->accountid);
+            *nodeAddress = createAddress (body->nodeaccountid);
+            *amount      = accountAmounts[1 - sourceIndex]->amount;
+            *fee         = (BRHederaUnitTinyBar) body->transactionfee;
+            *timeStamp   = (BRHederaTimeStamp) {
+                body->transactionid->transactionvalidstart->seconds,
+                body->transactionid->transactionvalidstart->nanos
+            };
+            success = 1;
+        }
+    }
+
+    // No free_unpacked(); the transaction and body go with the arena
+    hederaArenaRelease (&arena);
+
+    return success;
+}
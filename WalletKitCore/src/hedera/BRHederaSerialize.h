@@ -32,6 +32,18 @@ uint8_t * hederaTransactionPack (uint8_t * signature, size_t signatureSize,
                                       uint8_t * body, size_t bodySize,
                                       size_t * serializedSize);
 
+/**
+ * Unpack `bytes`, as produced by `hederaTransactionPack()`, into the crypto transfer fields of
+ * its body.  Returns 1 on success, with the addresses owned by the caller; otherwise 0.
+ */
+int hederaTransactionUnpack (const uint8_t * bytes, size_t bytesSize,
+                             BRHederaAddress * source,
+                             BRHederaAddress * target,
+                             BRHederaAddress * nodeAddress,
+                             BRHederaUnitTinyBar * amount,
+                             BRHederaUnitTinyBar * fee,
+                             BRHederaTimeStamp * timeStamp);
+
 #ifdef __cplusplus
 }
 #endif
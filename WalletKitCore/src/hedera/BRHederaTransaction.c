@@ -300,6 +300,11 @@ extern int hederaTransactionHasError (BRHederaTransaction transaction) {
     return transaction->error;
 }
 
+extern uint64_t hederaTransactionGetBlockHeight (BRHederaTransaction transaction) {
+    assert (transaction);
+    return transaction->blockHeight;
+}
+
 extern bool hederaTransactionEqual (BRHederaTransaction t1, BRHederaTransaction t2)
 {
     assert(t1);
@@ -312,7 +317,8 @@ extern bool hederaTransactionEqual (BRHederaTransaction t1, BRHederaTransaction
             result = true;
         }
     } else {
-        // Transaction IDs are not available - use the hash
+        // Transaction IDs are not available on both - use the hash.  A transfer created locally
+        // and the same transfer recovered from the server may differ in having an ID.
         BRHederaTransactionHash hash1 = hederaTransactionGetHash(t1);
         BRHederaTransactionHash hash2 = hederaTransactionGetHash(t2);
         if (memcmp(hash1.bytes, hash2.bytes, sizeof(hash1.bytes)) == 0) {
@@ -336,6 +342,14 @@ extern bool hederaTransactionEqual (BRHederaTransaction t1, BRHederaTransaction
     return result;
 }
 
+extern size_t hederaTransactionHashValue (BRHederaTransaction transaction)
+{
+    assert(transaction);
+    // Every copy of a transaction shares its hash, with or without an ID; an ID names one signed
+    // transaction, and so one hash.
+    return (size_t) UInt32GetLE (transaction->hash.bytes);
+}
+
 extern BRHederaTimeStamp hederaGenerateTimeStamp(void)
 {
     BRHederaTimeStamp ts;
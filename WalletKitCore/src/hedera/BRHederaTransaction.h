@@ -106,6 +106,7 @@ extern BRHederaUnitTinyBar hederaTransactionGetAmount(BRHederaTransaction transa
 extern BRHederaAddress hederaTransactionGetSource(BRHederaTransaction transaction);
 extern BRHederaAddress hederaTransactionGetTarget(BRHederaTransaction transaction);
 extern int hederaTransactionHasError (BRHederaTransaction transaction);
+extern uint64_t hederaTransactionGetBlockHeight (BRHederaTransaction transaction);
 
 // Memo
 extern void hederaTransactionSetMemo(BRHederaTransaction transaction, const char* memo);
@@ -115,6 +116,10 @@ hederaTransactionGetMemo(BRHederaTransaction transaction);
 // Check equality
 extern bool hederaTransactionEqual (BRHederaTransaction t1, BRHederaTransaction t2);
 
+// A hash value consistent with hederaTransactionEqual() - on the transaction hash, which copies
+// with and without a transaction ID share
+extern size_t hederaTransactionHashValue (BRHederaTransaction transaction);
+
 extern BRHederaTimeStamp hederaGenerateTimeStamp(void);
 extern BRHederaTimeStamp hederaParseTimeStamp(const char* txID);
 
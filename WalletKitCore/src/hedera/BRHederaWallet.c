@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include "support/BRArray.h"
+#include "generic/BRGenericTransferStore.h"
 #include "BRHederaAddress.h"
 #include <stdio.h>
 #include <stdbool.h>
@@ -22,11 +23,16 @@ struct BRHederaWalletRecord {
     BRHederaFeeBasis feeBasis;
     BRArrayOf(BRHederaAddress)  nodes;
 
-    BRArrayOf(BRHederaTransaction) transactions;
+    // Transactions, indexed by hash and ordered by block height
+    BRGenericTransferStore transactions;
 
     pthread_mutex_t lock;
 };
 
+static size_t walletTransactionHashValue (const void *transaction);
+static int hederaTransactionEqualValue (const void *t1, const void *t2);
+static int hederaTransactionCompareValue (const void *t1, const void *t2);
+
 extern BRHederaWallet
 hederaWalletCreate (BRHederaAccount account)
 {
@@ -51,7 +57,11 @@ hederaWalletCreate (BRHederaAccount account)
     }
 
     // Putting a '1' here avoids a 'false positive' in the Xcode leak instrument.
-    array_new(wallet->transactions, 1);
+    wallet->transactions = genTransferStoreCreate ((BRGenericTransferStoreHandlers) {
+        walletTransactionHashValue,
+        hederaTransactionEqualValue,
+        hederaTransactionCompareValue
+    }, 1);
 
     // Add a default fee basis
     wallet->feeBasis.costFactor = 1;
@@ -70,7 +80,7 @@ hederaWalletFree (BRHederaWallet wallet)
     array_free(wallet->nodes);
 
     // Transactions owned elsewhere, it seems.  Therefore, free the array, not the contents.
-    array_free (wallet->transactions);
+    genTransferStoreRelease (wallet->transactions);
 
     free(wallet);
 }
@@ -145,13 +155,26 @@ hederaWalletGetDefaultFeeBasis (BRHederaWallet wallet)
     return wallet->feeBasis;
 }
 
+static size_t
+walletTransactionHashValue (const void *transaction) {
+    return hederaTransactionHashValue ((BRHederaTransaction) transaction);
+}
+
+static int
+hederaTransactionEqualValue (const void *t1, const void *t2) {
+    return t1 == t2 || hederaTransactionEqual ((BRHederaTransaction) t1, (BRHederaTransaction) t2);
+}
+
+static int
+hederaTransactionCompareValue (const void *t1, const void *t2) {
+    uint64_t blockHeight1 = hederaTransactionGetBlockHeight ((BRHederaTransaction) t1);
+    uint64_t blockHeight2 = hederaTransactionGetBlockHeight ((BRHederaTransaction) t2);
+    return (blockHeight1 < blockHeight2 ? -1 : (blockHeight1 > blockHeight2 ? 1 : 0));
+}
+
 static bool
 walletHasTransfer (BRHederaWallet wallet, BRHederaTransaction transaction) {
-    bool r = false;
-    for (size_t index = 0; index < array_count(wallet->transactions) && false == r; index++) {
-        r = hederaTransactionEqual (transaction, wallet->transactions[index]);
-    }
-    return r;
+    return genTransferStoreHas (wallet->transactions, transaction);
 }
 
 extern int hederaWalletHasTransfer (BRHederaWallet wallet, BRHederaTransaction transfer) {
@@ -168,7 +191,7 @@ extern void hederaWalletAddTransfer(BRHederaWallet wallet, BRHederaTransaction t
     pthread_mutex_lock (&wallet->lock);
     if (!walletHasTransfer(wallet, transaction)) {
         transaction = hederaTransactionClone(transaction);
-        array_add(wallet->transactions, transaction);
+        genTransferStoreAdd (wallet->transactions, transaction);
 
         // Update the balance
         BRHederaUnitTinyBar amount = (hederaTransactionHasError(transaction)
@@ -207,12 +230,7 @@ extern void hederaWalletRemTransfer (BRHederaWallet wallet,
     assert(transaction);
     pthread_mutex_lock (&wallet->lock);
     if (walletHasTransfer(wallet, transaction)) {
-        for (size_t index = 0; index < array_count(wallet->transactions); index++)
-            if (hederaTransactionEqual (transaction, wallet->transactions[index])) {
-                hederaTransactionFree(wallet->transactions[index]);
-                array_rm (wallet->transactions, index);
-                break;
-            }
+        hederaTransactionFree (genTransferStoreRemove (wallet->transactions, transaction));
 
         // Update the balance
         BRHederaUnitTinyBar amount = (hederaTransactionHasError(transaction)
@@ -148,9 +148,10 @@ static const unsigned proto__transaction_body__field_indices_by_name[] = {
   0,   /* field[0] = transactionID */
   3,   /* field[3] = transactionValidDuration */
 };
-static const ProtobufCIntRange proto__transaction_body__number_ranges[1 + 1] =
+static const ProtobufCIntRange proto__transaction_body__number_ranges[2 + 1] =
 {
   { 1, 0 },
+  { 14, 6 },
   { 0, 7 }
 };
 const ProtobufCMessageDescriptor proto__transaction_body__descriptor =
@@ -164,7 +165,7 @@ const ProtobufCMessageDescriptor proto__transaction_body__descriptor =
   7,
   proto__transaction_body__field_descriptors,
   proto__transaction_body__field_indices_by_name,
-  1,  proto__transaction_body__number_ranges,
+  2,  proto__transaction_body__number_ranges,
   (ProtobufCMessageInit) proto__transaction_body__init,
   NULL,NULL,NULL    /* reserved[123] */
 };
@@ -21,7 +21,7 @@
 static char rippleAlphabet[] = "rpshnaf39wBUDNEGHJKLM4PQRST7VWXYZ2bcdeCg65jkm8oFqi1tuvAxyz";
 
 // A Ripple Address - 20 bytes
-#define ADDRESS_BYTES   (20)
+#define ADDRESS_BYTES   RIPPLE_ADDRESS_BYTES
 
 struct BRRippleAddressRecord {
     uint8_t bytes[ADDRESS_BYTES];
@@ -18,6 +18,9 @@
 extern "C" {
 #endif
 
+// The size of a (non-fee) address's raw bytes
+#define RIPPLE_ADDRESS_BYTES (20)
+
 typedef struct BRRippleAddressRecord *BRRippleAddress;
 
 /**
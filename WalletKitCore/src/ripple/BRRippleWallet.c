@@ -12,6 +12,8 @@
 #include <pthread.h>
 #include "BRRippleWallet.h"
 #include "support/BRArray.h"
+#include "support/BRInt.h"
+#include "generic/BRGenericTransferStore.h"
 #include "BRRipplePrivateStructs.h"
 #include "BRRippleFeeBasis.h"
 #include "BRRippleAddress.h"
@@ -30,18 +32,30 @@ struct BRRippleWalletRecord
     // Ripple account
     BRRippleAccount account;
 
-    BRArrayOf(BRRippleTransfer) transfers;
+    // Transfers, indexed by hash and ordered by block height
+    BRGenericTransferStore transfers;
+
+    // The number of transfers with `account` as the source
+    BRRippleSequence sequence;
 
     pthread_mutex_t lock;
 };
 
+static size_t rippleTransferHashValue (const void *transfer);
+static int rippleTransferEqualValue (const void *t1, const void *t2);
+static int rippleTransferCompareValue (const void *t1, const void *t2);
+
 extern BRRippleWallet
 rippleWalletCreate (BRRippleAccount account)
 {
     BRRippleWallet wallet = (BRRippleWallet) calloc (1, sizeof(struct BRRippleWalletRecord));
 
     // To void a Xcode 'Leaks' Instrument false positive; use '1'.
-    array_new(wallet->transfers, 1);
+    wallet->transfers = genTransferStoreCreate ((BRGenericTransferStoreHandlers) {
+        rippleTransferHashValue,
+        rippleTransferEqualValue,
+        rippleTransferCompareValue
+    }, 1);
 
     wallet->account = account;
     wallet->balance = 0;
@@ -66,9 +80,9 @@ rippleWalletFree (BRRippleWallet wallet)
 {
     if (wallet) {
         pthread_mutex_lock (&wallet->lock);
-        for (size_t index = 0; index < array_count(wallet->transfers); index++)
-            rippleTransferFree (wallet->transfers[index]);
-        array_free(wallet->transfers);
+        for (size_t index = 0; index < genTransferStoreCount(wallet->transfers); index++)
+            rippleTransferFree (genTransferStoreGetAt (wallet->transfers, index));
+        genTransferStoreRelease(wallet->transfers);
         pthread_mutex_unlock (&wallet->lock);
 
         pthread_mutex_destroy (&wallet->lock);
@@ -163,13 +177,27 @@ static bool rippleTransferEqual(BRRippleTransfer t1, BRRippleTransfer t2) {
     return result;
 }
 
+static size_t
+rippleTransferHashValue (const void *transfer) {
+    BRRippleTransactionHash hash = rippleTransferGetTransactionId ((BRRippleTransfer) transfer);
+    return (size_t) UInt32GetLE (hash.bytes);
+}
+
+static int
+rippleTransferEqualValue (const void *t1, const void *t2) {
+    return t1 == t2 || rippleTransferEqual ((BRRippleTransfer) t1, (BRRippleTransfer) t2);
+}
+
+static int
+rippleTransferCompareValue (const void *t1, const void *t2) {
+    uint64_t blockHeight1 = rippleTransferGetBlockHeight ((BRRippleTransfer) t1);
+    uint64_t blockHeight2 = rippleTransferGetBlockHeight ((BRRippleTransfer) t2);
+    return (blockHeight1 < blockHeight2 ? -1 : (blockHeight1 > blockHeight2 ? 1 : 0));
+}
+
 static bool
 walletHasTransfer (BRRippleWallet wallet, BRRippleTransfer transfer) {
-    bool r = false;
-    for (size_t index = 0; index < array_count(wallet->transfers) && false == r; index++) {
-        r = rippleTransferEqual (transfer, wallet->transfers[index]);
-    }
-    return r;
+    return genTransferStoreHas (wallet->transfers, transfer);
 }
 
 extern int rippleWalletHasTransfer (BRRippleWallet wallet, BRRippleTransfer transfer) {
@@ -179,22 +207,16 @@ extern int rippleWalletHasTransfer (BRRippleWallet wallet, BRRippleTransfer tran
     return result;
 }
 
-static void rippleWalletUpdateSequence (BRRippleWallet wallet,
-                                        OwnershipKept BRRippleAddress accountAddress) {
-    // Now update the account's sequence id
-    BRRippleSequence sequence = 0;
+static void rippleWalletUpdateSequence (BRRippleWallet wallet) {
     // We need to keep track of the first block where this account shows up due to a
-    // change in how ripple assigns the sequence number to new accounts
-    uint64_t minBlockHeight = INT64_MAX;
-    for (size_t index = 0; index < array_count(wallet->transfers); index++) {
-        uint64_t blockHeight = rippleTransferGetBlockHeight(wallet->transfers[index]);
-        minBlockHeight = blockHeight < minBlockHeight ? blockHeight : minBlockHeight;
-        if (rippleTransferHasSource (wallet->transfers[index], accountAddress))
-            sequence += 1;
-    }
+    // change in how ripple assigns the sequence number to new accounts.  The transfers
+    // are ordered by block height, so that is the first transfer's block.
+    uint64_t minBlockHeight = (genTransferStoreCount (wallet->transfers) > 0
+                               ? rippleTransferGetBlockHeight (genTransferStoreGetAt (wallet->transfers, 0))
+                               : INT64_MAX);
 
     rippleAccountSetBlockNumberAtCreation(wallet->account, minBlockHeight);
-    rippleAccountSetSequence (wallet->account, sequence);
+    rippleAccountSetSequence (wallet->account, wallet->sequence);
 }
 
 extern void rippleWalletAddTransfer (BRRippleWallet wallet,
@@ -206,7 +228,7 @@ extern void rippleWalletAddTransfer (BRRippleWallet wallet,
     if (!walletHasTransfer(wallet, transfer)) {
         // We'll add `transfer` to `wallet->transfers`; since we don't own `transfer` we must copy.
         transfer = rippleTransferClone(transfer);
-        array_add(wallet->transfers, transfer);
+        genTransferStoreAdd (wallet->transfers, transfer);
 
         // Update the balance
         BRRippleUnitDrops amount = (rippleTransferHasError(transfer)
@@ -214,13 +236,15 @@ extern void rippleWalletAddTransfer (BRRippleWallet wallet,
                                     : rippleTransferGetAmount(transfer));
         BRRippleUnitDrops fee    = rippleTransferGetFee(transfer);
 
-        BRRippleAddress accountAddress = rippleAccountGetAddress(wallet->account);
         BRRippleAddress source = rippleTransferGetSource(transfer);
         BRRippleAddress target = rippleTransferGetTarget(transfer);
 
         int isSource = rippleAccountHasAddress (wallet->account, source);
         int isTarget = rippleAccountHasAddress (wallet->account, target);
 
+        if (isSource)
+            wallet->sequence += 1;
+
         if (isSource && isTarget)
             wallet->balance -= fee;
         else if (isSource)
@@ -233,8 +257,7 @@ extern void rippleWalletAddTransfer (BRRippleWallet wallet,
         rippleAddressFree (source);
         rippleAddressFree (target);
 
-        rippleWalletUpdateSequence(wallet, accountAddress);
-        rippleAddressFree (accountAddress);
+        rippleWalletUpdateSequence(wallet);
     }
     pthread_mutex_unlock (&wallet->lock);
     // Now update the balance
@@ -247,12 +270,7 @@ extern void rippleWalletRemTransfer (BRRippleWallet wallet,
     assert(transfer);
     pthread_mutex_lock (&wallet->lock);
     if (walletHasTransfer(wallet, transfer)) {
-        for (size_t index = 0; index < array_count(wallet->transfers); index++)
-            if (rippleTransferEqual (transfer, wallet->transfers[index])) {
-                rippleTransferFree(wallet->transfers[index]);
-                array_rm (wallet->transfers, index);
-                break;
-            }
+        rippleTransferFree (genTransferStoreRemove (wallet->transfers, transfer));
 
         // Update the balance
         BRRippleUnitDrops amount = (rippleTransferHasError(transfer)
@@ -261,13 +279,15 @@ extern void rippleWalletRemTransfer (BRRippleWallet wallet,
 
         BRRippleUnitDrops fee    = rippleTransferGetFee(transfer);
 
-        BRRippleAddress accountAddress = rippleAccountGetAddress(wallet->account);
         BRRippleAddress source = rippleTransferGetSource(transfer);
         BRRippleAddress target = rippleTransferGetTarget(transfer);
 
         int isSource = rippleAccountHasAddress (wallet->account, source);
         int isTarget = rippleAccountHasAddress (wallet->account, target);
 
+        if (isSource)
+            wallet->sequence -= 1;
+
         if (isSource && isTarget)
             wallet->balance += fee;
         else if (isSource)
@@ -280,8 +300,7 @@ extern void rippleWalletRemTransfer (BRRippleWallet wallet,
         rippleAddressFree (source);
         rippleAddressFree (target);
 
-        rippleWalletUpdateSequence(wallet, accountAddress);
-        rippleAddressFree (accountAddress);
+        rippleWalletUpdateSequence(wallet);
     }
     pthread_mutex_unlock (&wallet->lock);
     // Now update the balance
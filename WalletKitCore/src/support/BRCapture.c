@@ -0,0 +1,490 @@
+//
+//  BRCapture.c
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <assert.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include "BRArray.h"
+#include "BRInt.h"
+#include "BRCapture.h"
+
+//
+// The file is a header followed by records:
+//
+//   header: magic[8] = "BRCAPTUR", version: uint32, reserved: uint32
+//   record: type: uint8, reserved[3], stream: uint32, time: uint64 (microseconds), length: uint32,
+//           bytes[length]
+//
+// All integers are little-endian.  A STREAM record names a new stream - with the next stream
+// number - and precedes all of the stream's other records.
+//
+#define CAPTURE_MAGIC               "BRCAPTUR"
+#define CAPTURE_MAGIC_LENGTH        (8)
+#define CAPTURE_VERSION             (1)
+#define CAPTURE_HEADER_LENGTH       (CAPTURE_MAGIC_LENGTH + 2 * sizeof (uint32_t))
+#define CAPTURE_RECORD_LENGTH       (4 + sizeof (uint32_t) + sizeof (uint64_t) + sizeof (uint32_t))
+
+typedef enum {
+    CAPTURE_RECORD_STREAM = 1,
+    CAPTURE_RECORD_CLOSE,
+    CAPTURE_RECORD_RECV,
+    CAPTURE_RECORD_SEND
+} BRCaptureRecordType;
+
+static uint64_t
+captureNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return 1000000 * (uint64_t) ts.tv_sec + (uint64_t) ts.tv_nsec / 1000;
+}
+
+// MARK: - Capture
+
+struct BRCaptureRecord {
+    FILE *file;
+    uint64_t start;
+    BRCaptureStream streamsCount;
+    pthread_mutex_t lock;
+};
+
+static void
+captureWrite (BRCapture capture,
+              BRCaptureRecordType type,
+              BRCaptureStream stream,
+              const uint8_t *bytes,
+              size_t bytesCount) {
+    uint8_t header[CAPTURE_RECORD_LENGTH] = { (uint8_t) type };
+
+    UInt32SetLE (&header[4],  stream);
+    UInt64SetLE (&header[8],  captureNow() - capture->start);
+    UInt32SetLE (&header[16], (uint32_t) bytesCount);
+
+    // Caller holds the lock
+    fwrite (header, 1, sizeof (header), capture->file);
+    if (bytesCount > 0) fwrite (bytes, 1, bytesCount, capture->file);
+}
+
+extern BRCapture
+BRCaptureNew (const char *path) {
+    FILE *file = fopen (path, "wb");
+    if (NULL == file) return NULL;
+
+    uint8_t header[CAPTURE_HEADER_LENGTH] = { 0 };
+    memcpy (header, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH);
+    UInt32SetLE (&header[CAPTURE_MAGIC_LENGTH], CAPTURE_VERSION);
+
+    if (sizeof (header) != fwrite (header, 1, sizeof (header), file)) {
+        fclose (file);
+        return NULL;
+    }
+
+    BRCapture capture = calloc (1, sizeof (struct BRCaptureRecord));
+    assert (NULL != capture);
+
+    capture->file  = file;
+    capture->start = captureNow();
+    capture->streamsCount = 0;
+
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL);
+        pthread_mutex_init(&capture->lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+    }
+
+    return capture;
+}
+
+extern void
+BRCaptureFree (BRCapture capture) {
+    if (NULL == capture) return;
+
+    fclose (capture->file);
+    pthread_mutex_destroy (&capture->lock);
+
+    memset (capture, 0, sizeof (*capture));
+    free (capture);
+}
+
+extern BRCaptureStream
+BRCaptureOpenStream (BRCapture capture,
+                     const char *name) {
+    if (NULL == capture) return 0;
+
+    pthread_mutex_lock (&capture->lock);
+    BRCaptureStream stream = capture->streamsCount++;
+    captureWrite (capture, CAPTURE_RECORD_STREAM, stream, (const uint8_t *) name, strlen (name));
+    pthread_mutex_unlock (&capture->lock);
+
+    return stream;
+}
+
+extern void
+BRCaptureCloseStream (BRCapture capture,
+                      BRCaptureStream stream) {
+    if (NULL == capture) return;
+
+    pthread_mutex_lock (&capture->lock);
+    captureWrite (capture, CAPTURE_RECORD_CLOSE, stream, NULL, 0);
+    fflush (capture->file);
+    pthread_mutex_unlock (&capture->lock);
+}
+
+extern void
+BRCaptureAddRecv (BRCapture capture,
+                  BRCaptureStream stream,
+                  const uint8_t *bytes,
+                  size_t bytesCount) {
+    if (NULL == capture) return;
+
+    pthread_mutex_lock (&capture->lock);
+    captureWrite (capture, CAPTURE_RECORD_RECV, stream, bytes, bytesCount);
+    pthread_mutex_unlock (&capture->lock);
+}
+
+extern void
+BRCaptureAddSend (BRCapture capture,
+                  BRCaptureStream stream,
+                  const uint8_t *bytes,
+                  size_t bytesCount) {
+    if (NULL == capture) return;
+
+    pthread_mutex_lock (&capture->lock);
+    captureWrite (capture, CAPTURE_RECORD_SEND, stream, bytes, bytesCount);
+    pthread_mutex_unlock (&capture->lock);
+}
+
+// MARK: - Replay
+
+typedef struct {
+    /// The position in the capture, across all streams
+    size_t sequence;
+
+    /// The captured time
+    uint64_t time;
+
+    /// The number of messages sent on the stream before this one was received
+    size_t sends;
+
+    const uint8_t *bytes;
+    size_t bytesCount;
+} BRCaptureReplayMessage;
+
+typedef enum {
+    REPLAY_STREAM_UNOPENED,
+    REPLAY_STREAM_OPEN,
+    REPLAY_STREAM_CLOSED
+} BRCaptureReplayStreamState;
+
+typedef struct {
+    char *name;
+    BRCaptureReplayStreamState state;
+
+    /// The received messages, in order, and the index of the next to deliver
+    BRArrayOf(BRCaptureReplayMessage) messages;
+    size_t next;
+
+    /// The messages sent, as recorded during the capture and as reported during the replay
+    size_t sendsCaptured;
+    size_t sendsReplayed;
+} BRCaptureReplayStream;
+
+struct BRCaptureReplayRecord {
+    /// The entire file; messages reference their bytes within it
+    uint8_t *data;
+    size_t dataCount;
+
+    BRArrayOf(BRCaptureReplayStream) streams;
+
+    uint64_t duration;
+
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+};
+
+static int
+replayParse (BRCaptureReplay replay) {
+    const uint8_t *data = replay->data;
+    size_t offset = CAPTURE_HEADER_LENGTH;
+
+    if (replay->dataCount < CAPTURE_HEADER_LENGTH ||
+        0 != memcmp (data, CAPTURE_MAGIC, CAPTURE_MAGIC_LENGTH) ||
+        CAPTURE_VERSION != UInt32GetLE (&data[CAPTURE_MAGIC_LENGTH])) return 0;
+
+    for (size_t sequence = 0; offset < replay->dataCount; sequence++) {
+        if (replay->dataCount - offset < CAPTURE_RECORD_LENGTH) return 0;
+
+        BRCaptureRecordType type = (BRCaptureRecordType) data[offset];
+        BRCaptureStream stream   = UInt32GetLE (&data[offset + 4]);
+        uint64_t time            = UInt64GetLE (&data[offset + 8]);
+        size_t   length          = UInt32GetLE (&data[offset + 16]);
+        offset += CAPTURE_RECORD_LENGTH;
+
+        if (replay->dataCount - offset < length) return 0;
+        const uint8_t *bytes = &data[offset];
+        offset += length;
+
+        if (time > replay->duration) replay->duration = time;
+
+        // Streams are numbered in order of their STREAM record
+        if (CAPTURE_RECORD_STREAM == type) {
+            if (stream != array_count (replay->streams)) return 0;
+
+            BRCaptureReplayStream replayStream = { calloc (1, length + 1), REPLAY_STREAM_UNOPENED };
+            memcpy (replayStream.name, bytes, length);
+            array_new (replayStream.messages, 10);
+            array_add (replay->streams, replayStream);
+            continue;
+        }
+
+        if (stream >= array_count (replay->streams)) return 0;
+        BRCaptureReplayStream *replayStream = &replay->streams[stream];
+
+        switch (type) {
+            case CAPTURE_RECORD_CLOSE:
+                break;
+
+            case CAPTURE_RECORD_RECV: {
+                BRCaptureReplayMessage message = {
+                    sequence,
+                    time,
+                    replayStream->sendsCaptured,
+                    bytes,
+                    length
+                };
+                array_add (replayStream->messages, message);
+                break;
+            }
+
+            case CAPTURE_RECORD_SEND:
+                replayStream->sendsCaptured += 1;
+                break;
+
+            default:
+                return 0;
+        }
+    }
+    return 1;
+}
+
+extern BRCaptureReplay
+BRCaptureReplayNew (const char *path) {
+    FILE *file = fopen (path, "rb");
+    if (NULL == file) return NULL;
+
+    long size = -1;
+    if (0 == fseek (file, 0, SEEK_END)) size = ftell (file);
+    if (size < 0 || 0 != fseek (file, 0, SEEK_SET)) {
+        fclose (file);
+        return NULL;
+    }
+
+    BRCaptureReplay replay = calloc (1, sizeof (struct BRCaptureReplayRecord));
+    assert (NULL != replay);
+
+    replay->dataCount = (size_t) size;
+    replay->data = malloc (replay->dataCount);
+    assert (0 == replay->dataCount || NULL != replay->data);
+    array_new (replay->streams, 10);
+
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL);
+        pthread_mutex_init(&replay->lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+
+        pthread_cond_init(&replay->cond, NULL);
+    }
+
+    int success = (replay->dataCount == fread (replay->data, 1, replay->dataCount, file));
+    fclose (file);
+
+    if (!success || !replayParse (replay)) {
+        BRCaptureReplayFree (replay);
+        return NULL;
+    }
+
+    return replay;
+}
+
+extern void
+BRCaptureReplayFree (BRCaptureReplay replay) {
+    if (NULL == replay) return;
+
+    for (size_t index = 0; index < array_count (replay->streams); index++) {
+        free (replay->streams[index].name);
+        array_free (replay->streams[index].messages);
+    }
+    array_free (replay->streams);
+    if (NULL != replay->data) free (replay->data);
+
+    pthread_cond_destroy  (&replay->cond);
+    pthread_mutex_destroy (&replay->lock);
+
+    memset (replay, 0, sizeof (*replay));
+    free (replay);
+}
+
+extern size_t
+BRCaptureReplayGetStreamCount (BRCaptureReplay replay) {
+    return (NULL == replay ? 0 : array_count (replay->streams));
+}
+
+extern const char *
+BRCaptureReplayGetStreamName (BRCaptureReplay replay,
+                              size_t index) {
+    assert (index < array_count (replay->streams));
+    return replay->streams[index].name;
+}
+
+extern int
+BRCaptureReplayOpenStream (BRCaptureReplay replay,
+                           const char *name,
+                           BRCaptureStream *stream) {
+    int found = 0;
+    if (NULL == replay) return found;
+
+    pthread_mutex_lock (&replay->lock);
+    for (size_t index = 0; !found && index < array_count (replay->streams); index++)
+        if (REPLAY_STREAM_UNOPENED == replay->streams[index].state &&
+            0 == strcmp (name, replay->streams[index].name)) {
+            replay->streams[index].state = REPLAY_STREAM_OPEN;
+            *stream = (BRCaptureStream) index;
+            found = 1;
+        }
+    pthread_cond_broadcast (&replay->cond);
+    pthread_mutex_unlock (&replay->lock);
+
+    return found;
+}
+
+extern void
+BRCaptureReplayCloseStream (BRCaptureReplay replay,
+                            BRCaptureStream stream) {
+    if (NULL == replay) return;
+
+    pthread_mutex_lock (&replay->lock);
+    assert (stream < array_count (replay->streams));
+    replay->streams[stream].state = REPLAY_STREAM_CLOSED;
+    pthread_cond_broadcast (&replay->cond);
+    pthread_mutex_unlock (&replay->lock);
+}
+
+extern void
+BRCaptureReplaySent (BRCaptureReplay replay,
+                     BRCaptureStream stream) {
+    if (NULL == replay) return;
+
+    pthread_mutex_lock (&replay->lock);
+    assert (stream < array_count (replay->streams));
+    replay->streams[stream].sendsReplayed += 1;
+    pthread_cond_broadcast (&replay->cond);
+    pthread_mutex_unlock (&replay->lock);
+}
+
+// The next message of `stream`, if it is deliverable now, ignoring other streams.
+static BRCaptureReplayMessage *
+replayStreamGetDeliverable (BRCaptureReplayStream *stream) {
+    if (REPLAY_STREAM_OPEN != stream->state || stream->next >= array_count (stream->messages))
+        return NULL;
+
+    BRCaptureReplayMessage *message = &stream->messages[stream->next];
+    return (stream->sendsReplayed >= message->sends ? message : NULL);
+}
+
+// The status of `stream`; caller holds the lock.  A stream's next message waits on its peer's
+// sends and on any deliverable message, of another stream, that was captured earlier.
+static BRCaptureReplayStatus
+replayStatus (BRCaptureReplay replay,
+              BRCaptureStream stream) {
+    BRCaptureReplayStream *replayStream = &replay->streams[stream];
+
+    if (REPLAY_STREAM_OPEN != replayStream->state ||
+        replayStream->next >= array_count (replayStream->messages))
+        return BR_CAPTURE_REPLAY_END;
+
+    BRCaptureReplayMessage *message = replayStreamGetDeliverable (replayStream);
+    if (NULL == message) return BR_CAPTURE_REPLAY_WAIT;
+
+    for (size_t index = 0; index < array_count (replay->streams); index++) {
+        BRCaptureReplayMessage *other = replayStreamGetDeliverable (&replay->streams[index]);
+        if (NULL != other && other->sequence < message->sequence) return BR_CAPTURE_REPLAY_WAIT;
+    }
+
+    return BR_CAPTURE_REPLAY_READY;
+}
+
+extern BRCaptureReplayStatus
+BRCaptureReplayNext (BRCaptureReplay replay,
+                     BRCaptureStream stream,
+                     double timeout,
+                     const uint8_t **bytes,
+                     size_t *bytesCount) {
+    if (NULL == replay) return BR_CAPTURE_REPLAY_END;
+
+    struct timeval tv;
+    gettimeofday (&tv, NULL);
+
+    double deadline = (double) tv.tv_sec + (double) tv.tv_usec / 1000000 + timeout;
+    struct timespec ts = {
+        (time_t) deadline,
+        (long) ((deadline - (double) (time_t) deadline) * 1000000000)
+    };
+
+    pthread_mutex_lock (&replay->lock);
+    assert (stream < array_count (replay->streams));
+
+    BRCaptureReplayStatus status = replayStatus (replay, stream);
+    while (BR_CAPTURE_REPLAY_WAIT == status && timeout > 0) {
+        if (ETIMEDOUT == pthread_cond_timedwait (&replay->cond, &replay->lock, &ts)) {
+            status = replayStatus (replay, stream);
+            break;
+        }
+        status = replayStatus (replay, stream);
+    }
+
+    if (BR_CAPTURE_REPLAY_READY == status) {
+        BRCaptureReplayStream *replayStream = &replay->streams[stream];
+        BRCaptureReplayMessage *message = &replayStream->messages[replayStream->next++];
+
+        *bytes      = message->bytes;
+        *bytesCount = message->bytesCount;
+
+        pthread_cond_broadcast (&replay->cond);
+    }
+    pthread_mutex_unlock (&replay->lock);
+
+    return status;
+}
+
+extern BRCaptureReplayStatus
+BRCaptureReplayPeek (BRCaptureReplay replay,
+                     BRCaptureStream stream) {
+    if (NULL == replay) return BR_CAPTURE_REPLAY_END;
+
+    pthread_mutex_lock (&replay->lock);
+    assert (stream < array_count (replay->streams));
+    BRCaptureReplayStatus status = replayStatus (replay, stream);
+    pthread_mutex_unlock (&replay->lock);
+
+    return status;
+}
+
+extern uint64_t
+BRCaptureReplayGetDuration (BRCaptureReplay replay) {
+    return (NULL == replay ? 0 : replay->duration);
+}
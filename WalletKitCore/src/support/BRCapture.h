@@ -0,0 +1,149 @@
+//
+//  BRCapture.h
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#ifndef BRCapture_h
+#define BRCapture_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Capture
+
+///
+/// A Capture records the messages exchanged with P2P peers (BRPeer, BREthereumNode) to a file, so
+/// that a sync can later be replayed without the network.  Each connection is a 'stream', named
+/// for the peer's host and port; the stream holds the complete inbound messages, as parsed from
+/// the wire, and the outbound messages, interleaved in the order they occurred.
+///
+/// A Capture may be shared by any number of peers and threads.  Every function accepts NULL, and
+/// does nothing, so that peers without a capture need not check.
+///
+typedef struct BRCaptureRecord *BRCapture;
+
+typedef uint32_t BRCaptureStream;
+
+/// Create a capture writing to `path`, replacing any existing file.  Returns NULL if the file
+/// cannot be created.
+extern BRCapture
+BRCaptureNew (const char *path);
+
+/// Flush and close the file.  No peer may still add to the capture.
+extern void
+BRCaptureFree (BRCapture capture);
+
+/// Start a stream for a connection to `name`, typically 'host:port'.
+extern BRCaptureStream
+BRCaptureOpenStream (BRCapture capture,
+                     const char *name);
+
+extern void
+BRCaptureCloseStream (BRCapture capture,
+                      BRCaptureStream stream);
+
+/// Add a message received on `stream`
+extern void
+BRCaptureAddRecv (BRCapture capture,
+                  BRCaptureStream stream,
+                  const uint8_t *bytes,
+                  size_t bytesCount);
+
+/// Add a message sent on `stream`
+extern void
+BRCaptureAddSend (BRCapture capture,
+                  BRCaptureStream stream,
+                  const uint8_t *bytes,
+                  size_t bytesCount);
+
+// MARK: - Replay
+
+///
+/// A Replay feeds the inbound messages of a capture back to peers, at full speed.  A peer opens
+/// the stream recorded for its name and then, in place of reading its socket, takes the stream's
+/// messages in turn.  Outbound messages are not sent anywhere; the peer reports each one so that
+/// an inbound message is not delivered before the messages that, in the capture, preceded it -
+/// a response never arrives ahead of its request.
+///
+/// With several streams open, messages are delivered in their captured order whenever the
+/// replaying peers allow it; a stream waiting on its peer to send does not hold up the others.
+///
+/// Timing is not replayed.  Peers, the peer manager and the LES node keep their wall-clock
+/// timeouts, which at full speed rarely fire; a capture that ends in a timeout replays as a
+/// connection closed at the end of its stream.
+///
+typedef struct BRCaptureReplayRecord *BRCaptureReplay;
+
+typedef enum {
+    BR_CAPTURE_REPLAY_READY,    // a message is available
+    BR_CAPTURE_REPLAY_WAIT,     // a message is pending, but not yet deliverable
+    BR_CAPTURE_REPLAY_END       // the stream has no more messages
+} BRCaptureReplayStatus;
+
+/// Load the capture at `path`.  Returns NULL if the file cannot be read or is malformed.
+extern BRCaptureReplay
+BRCaptureReplayNew (const char *path);
+
+/// Free the replay, including all message bytes.  No peer may still use the replay.
+extern void
+BRCaptureReplayFree (BRCaptureReplay replay);
+
+/// The number of captured streams; a name appears once per connection to it.
+extern size_t
+BRCaptureReplayGetStreamCount (BRCaptureReplay replay);
+
+/// The name of the stream at `index`
+extern const char *
+BRCaptureReplayGetStreamName (BRCaptureReplay replay,
+                              size_t index);
+
+/// Open the first unopened stream captured for `name`.  Returns 0 if there is none - as when the
+/// peer was never connected during the capture - and 1 otherwise, with `stream` filled in.
+extern int
+BRCaptureReplayOpenStream (BRCaptureReplay replay,
+                           const char *name,
+                           BRCaptureStream *stream);
+
+/// Close `stream`; its remaining messages are never delivered.
+extern void
+BRCaptureReplayCloseStream (BRCaptureReplay replay,
+                            BRCaptureStream stream);
+
+/// Report that the peer sent a message on `stream`.
+extern void
+BRCaptureReplaySent (BRCaptureReplay replay,
+                     BRCaptureStream stream);
+
+/// Take the next message for `stream`, waiting for up to `timeout` seconds if it is not yet
+/// deliverable.  On BR_CAPTURE_REPLAY_READY, `bytes` and `bytesCount` are filled in; the bytes
+/// are owned by `replay`.
+extern BRCaptureReplayStatus
+BRCaptureReplayNext (BRCaptureReplay replay,
+                     BRCaptureStream stream,
+                     double timeout,
+                     const uint8_t **bytes,
+                     size_t *bytesCount);
+
+/// Check, without taking it, if the next message for `stream` is deliverable.
+extern BRCaptureReplayStatus
+BRCaptureReplayPeek (BRCaptureReplay replay,
+                     BRCaptureStream stream);
+
+/// The captured duration, in microseconds
+extern uint64_t
+BRCaptureReplayGetDuration (BRCaptureReplay replay);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRCapture_h */
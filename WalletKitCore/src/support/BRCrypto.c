@@ -27,6 +27,20 @@
 #include <string.h>
 #include <assert.h>
 
+// aes hardware instructions, used when the cpu has them: aes-ni, and vaes for 256bit vectors; chacha20 computed on
+// several blocks at once in sse2 or avx2 vectors; and the scrypt salsa20/8 core in sse2 or avx2 vectors
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BR_AES_NI 1
+#define BR_CHACHA_SIMD 1
+#define BR_SCRYPT_SIMD 1
+#include <immintrin.h>
+#endif
+
+// poly1305 in 44bit limbs, with 128bit products, where the compiler has a 128bit integer type
+#if defined(__SIZEOF_INT128__)
+#define BR_POLY1305_64 1
+#endif
+
 // endian swapping
 #if __BIG_ENDIAN__ || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
 #define be32(x) (x)
@@ -705,10 +719,91 @@ void BRHMACDRBG(void *out, size_t outLen, void *K, void *V, void (*hash)(void *,
     }
 }
 
+static volatile int _BRChacha20Poly1305VectorEnabled = 1;
+
+#if BR_CHACHA_SIMD
+// 0 - portable, 1 - sse2, 2 - avx2
+static int _BRChacha20Vector(void)
+{
+    static volatile int level = -1;
+    
+    if (level < 0) {
+        __builtin_cpu_init();
+        level = (__builtin_cpu_supports("avx2")) ? 2 : (__builtin_cpu_supports("sse2")) ? 1 : 0;
+    }
+    
+    return (_BRChacha20Poly1305VectorEnabled) ? level : 0;
+}
+#endif
+
+#if BR_POLY1305_64
+// processes whole 16 byte blocks of data in 44bit limbs, converting h to and from the 26bit limbs used by
+// _BRPoly1305Compress(); returns the number of bytes processed
+static size_t _BRPoly1305Blocks64(uint32_t h[5], const void *key32, const void *data, size_t dataLen)
+{
+    const uint8_t *d = data;
+    uint64_t t0, t1, r0, r1, r2, s1, s2, h0, h1, h2, c;
+    unsigned __int128 d0, d1, d2;
+    size_t i;
+    
+    // r &= 0xffffffc0ffffffc0ffffffc0fffffff
+    memcpy(&t0, key32, 8), memcpy(&t1, (const uint8_t *)key32 + 8, 8);
+    t0 = le64(t0), t1 = le64(t1);
+    r0 = t0 & 0xffc0fffffff, r1 = ((t0 >> 44) | (t1 << 20)) & 0xfffffc0ffff, r2 = (t1 >> 24) & 0x00ffffffc0f;
+    s1 = r1*(5 << 2), s2 = r2*(5 << 2);
+    
+    // fully carry h, then repack it from 26bit to 44bit limbs
+    h[1] += h[0] >> 26, h[0] &= 0x03ffffff, h[2] += h[1] >> 26, h[1] &= 0x03ffffff;
+    h[3] += h[2] >> 26, h[2] &= 0x03ffffff, h[4] += h[3] >> 26, h[3] &= 0x03ffffff;
+    h0 = (h[0] | ((uint64_t)h[1] << 26)) & 0xfffffffffff;
+    h1 = ((h[1] >> 18) | ((uint64_t)h[2] << 8) | ((uint64_t)h[3] << 34)) & 0xfffffffffff;
+    h2 = (h[3] >> 10) | ((uint64_t)h[4] << 16);
+    
+    for (i = 0; i + 16 <= dataLen; i += 16) {
+        // h += x
+        memcpy(&t0, &d[i], 8), memcpy(&t1, &d[i + 8], 8);
+        t0 = le64(t0), t1 = le64(t1);
+        h0 += t0 & 0xfffffffffff, h1 += ((t0 >> 44) | (t1 << 20)) & 0xfffffffffff;
+        h2 += ((t1 >> 24) & 0x3ffffffffff) | ((uint64_t)1 << 40);
+        
+        // h *= r
+        d0 = (unsigned __int128)h0*r0 + (unsigned __int128)h1*s2 + (unsigned __int128)h2*s1;
+        d1 = (unsigned __int128)h0*r1 + (unsigned __int128)h1*r0 + (unsigned __int128)h2*s2;
+        d2 = (unsigned __int128)h0*r2 + (unsigned __int128)h1*r1 + (unsigned __int128)h2*r0;
+        
+        // (partial) h %= p
+        c = (uint64_t)(d0 >> 44), h0 = (uint64_t)d0 & 0xfffffffffff, d1 += c;
+        c = (uint64_t)(d1 >> 44), h1 = (uint64_t)d1 & 0xfffffffffff, d2 += c;
+        c = (uint64_t)(d2 >> 42), h2 = (uint64_t)d2 & 0x3ffffffffff;
+        h0 += c*5, c = h0 >> 44, h0 &= 0xfffffffffff, h1 += c;
+    }
+    
+    // repack h into 26bit limbs
+    h2 += h1 >> 44, h1 &= 0xfffffffffff;
+    h[0] = (uint32_t)h0 & 0x03ffffff, h[1] = (uint32_t)((h0 >> 26) | (h1 << 18)) & 0x03ffffff;
+    h[2] = (uint32_t)(h1 >> 8) & 0x03ffffff, h[3] = (uint32_t)((h1 >> 34) | (h2 << 10)) & 0x03ffffff;
+    h[4] = (uint32_t)(h2 >> 16);
+    
+    var_clean(&t0, &t1, &r0, &r1, &r2, &s1, &s2, &h0, &h1, &h2, &c);
+    var_clean(&d0, &d1, &d2);
+    return i;
+}
+#endif
+
+// chacha20 and poly1305 use the cpu's simd vectors and 64bit arithmetic when available; returns the previous setting
+int BRChacha20Poly1305SetVectorEnabled(int enabled)
+{
+    int previous = _BRChacha20Poly1305VectorEnabled;
+    
+    _BRChacha20Poly1305VectorEnabled = enabled;
+    return previous;
+}
+
 static void _BRPoly1305Compress(uint32_t h[5], const void *key32, const void *data, size_t dataLen, int final)
 {
     uint32_t x[4], b, t0, t1, t2, t3, t4, r0, r1, r2, r3, r4;
     uint64_t d0, d1, d2, d3, d4;
+    size_t off = 0;
 
     // r &= 0xffffffc0ffffffc0ffffffc0fffffff
     memcpy(x, key32, 16);
@@ -716,7 +811,11 @@ static void _BRPoly1305Compress(uint32_t h[5], const void *key32, const void *da
     r0 = t0 & 0x03ffffff, r1 = ((t0 >> 26) | (t1 << 6)) & 0x03ffff03, r2 = ((t1 >> 20) | (t2 << 12)) & 0x03ffc0ff;
     r3 = ((t2 >> 14) | (t3 << 18)) & 0x03f03fff, r4 = (t3 >> 8) & 0x000fffff;
     
-    for (size_t i = 0; i < dataLen; i += 16) { // process data in 16 byte blocks
+#if BR_POLY1305_64
+    if (_BRChacha20Poly1305VectorEnabled) off = _BRPoly1305Blocks64(h, key32, data, dataLen);
+#endif
+    
+    for (size_t i = off; i < dataLen; i += 16) { // process data in 16 byte blocks
         if (i + 16 > dataLen) {
             memcpy(x, (const uint8_t *)data + i, dataLen - i);
             memset((uint8_t *)x + (dataLen - i), 0, 16 - (dataLen - i)); // clear remainder of x
@@ -791,12 +890,122 @@ void BRPoly1305(void *mac16, const void *key32, const void *data, size_t dataLen
 #define qr(a, b, c, d) ((a) += (b), (d) = rol32((d) ^ (a), 16), (c) += (d), (b) = rol32((b) ^ (c), 12),\
                         (a) += (b), (d) = rol32((d) ^ (a), 8), (c) += (d), (b) = rol32((b) ^ (c), 7))
 
+#if BR_CHACHA_SIMD
+
+// the chacha double round on the 16 state words in x, each a vector holding that word of several blocks
+#define chacha_rounds(qr, x) (qr((x)[0], (x)[4], (x)[8], (x)[12]), qr((x)[1], (x)[5], (x)[9], (x)[13]),\
+                              qr((x)[2], (x)[6], (x)[10], (x)[14]), qr((x)[3], (x)[7], (x)[11], (x)[15]),\
+                              qr((x)[0], (x)[5], (x)[10], (x)[15]), qr((x)[1], (x)[6], (x)[11], (x)[12]),\
+                              qr((x)[2], (x)[7], (x)[8], (x)[13]), qr((x)[3], (x)[4], (x)[9], (x)[14]))
+
+// transposes 4 rows of 4 words, per 128bit lane; with rows of one word from 4 blocks, each row becomes 4 words of one
+// block
+#define chacha_transpose(pre, a, b, c, d) (t0 = pre##_unpacklo_epi32(a, b), t1 = pre##_unpacklo_epi32(c, d),\
+                                           t2 = pre##_unpackhi_epi32(a, b), t3 = pre##_unpackhi_epi32(c, d),\
+                                           (a) = pre##_unpacklo_epi64(t0, t1), (b) = pre##_unpackhi_epi64(t0, t1),\
+                                           (c) = pre##_unpacklo_epi64(t2, t3), (d) = pre##_unpackhi_epi64(t2, t3))
+
+#define rol128(x, n) _mm_or_si128(_mm_slli_epi32((x), (n)), _mm_srli_epi32((x), 32 - (n)))
+#define qr128(a, b, c, d) ((a) = _mm_add_epi32(a, b), (d) = rol128(_mm_xor_si128(d, a), 16),\
+                           (c) = _mm_add_epi32(c, d), (b) = rol128(_mm_xor_si128(b, c), 12),\
+                           (a) = _mm_add_epi32(a, b), (d) = rol128(_mm_xor_si128(d, a), 8),\
+                           (c) = _mm_add_epi32(c, d), (b) = rol128(_mm_xor_si128(b, c), 7))
+
+// chacha20 on 4 blocks at a time, one per 32bit vector lane; returns the number of bytes processed, a multiple of 256
+__attribute__((target("sse2")))
+static size_t _BRChacha20SSE2(uint8_t *out, const uint8_t *data, size_t dataLen, const uint32_t s[16],
+                              uint64_t *counter)
+{
+    __m128i x[16], t0, t1, t2, t3;
+    size_t i, j, off;
+    
+    for (off = 0; dataLen - off >= 64*4; off += 64*4, *counter += 4) {
+        for (i = 0; i < 16; i++) x[i] = _mm_set1_epi32((int)s[i]);
+        x[12] = _mm_set_epi32((int)(*counter + 3), (int)(*counter + 2), (int)(*counter + 1), (int)*counter);
+        x[13] = _mm_set_epi32((int)((*counter + 3) >> 32), (int)((*counter + 2) >> 32), (int)((*counter + 1) >> 32),
+                              (int)(*counter >> 32));
+        t0 = x[12], t1 = x[13];
+        
+        for (j = 0; j < 10; j++) chacha_rounds(qr128, x);
+        
+        for (i = 0; i < 16; i++) x[i] = _mm_add_epi32(x[i], (i == 12) ? t0 : (i == 13) ? t1 : _mm_set1_epi32((int)s[i]));
+        chacha_transpose(_mm, x[0], x[1], x[2], x[3]), chacha_transpose(_mm, x[4], x[5], x[6], x[7]);
+        chacha_transpose(_mm, x[8], x[9], x[10], x[11]), chacha_transpose(_mm, x[12], x[13], x[14], x[15]);
+        
+        for (i = 0; i < 16; i++) { // x[4*w + b] holds words 4*w...4*w + 3 of block b
+            j = (i % 4)*64 + (i / 4)*16;
+            _mm_storeu_si128((__m128i *)&out[off + j],
+                             _mm_xor_si128(x[i], _mm_loadu_si128((const __m128i *)&data[off + j])));
+        }
+    }
+    
+    mem_clean(x, sizeof(x));
+    var_clean(&t0, &t1, &t2, &t3);
+    return off;
+}
+
+#define rol256(x, n) _mm256_or_si256(_mm256_slli_epi32((x), (n)), _mm256_srli_epi32((x), 32 - (n)))
+#define qr256(a, b, c, d) ((a) = _mm256_add_epi32(a, b), (d) = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16),\
+                           (c) = _mm256_add_epi32(c, d), (b) = rol256(_mm256_xor_si256(b, c), 12),\
+                           (a) = _mm256_add_epi32(a, b), (d) = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8),\
+                           (c) = _mm256_add_epi32(c, d), (b) = rol256(_mm256_xor_si256(b, c), 7))
+
+// chacha20 on 8 blocks at a time, one per 32bit lane of 256bit vectors; returns the number of bytes processed, a
+// multiple of 512
+__attribute__((target("avx2")))
+static size_t _BRChacha20AVX2(uint8_t *out, const uint8_t *data, size_t dataLen, const uint32_t s[16],
+                              uint64_t *counter)
+{
+    const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                          13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2),
+                  rot8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+                                         14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+    __m256i x[16], t0, t1, t2, t3;
+    uint32_t lo[8], hi[8];
+    size_t i, j, off;
+    
+    for (off = 0; dataLen - off >= 64*8; off += 64*8, *counter += 8) {
+        for (i = 0; i < 8; i++) lo[i] = (uint32_t)(*counter + i), hi[i] = (uint32_t)((*counter + i) >> 32);
+        for (i = 0; i < 16; i++) x[i] = _mm256_set1_epi32((int)s[i]);
+        x[12] = _mm256_loadu_si256((const __m256i *)lo);
+        x[13] = _mm256_loadu_si256((const __m256i *)hi);
+        
+        for (j = 0; j < 10; j++) chacha_rounds(qr256, x);
+        
+        for (i = 0; i < 16; i++) {
+            t0 = (i == 12) ? _mm256_loadu_si256((const __m256i *)lo) :
+                 (i == 13) ? _mm256_loadu_si256((const __m256i *)hi) : _mm256_set1_epi32((int)s[i]);
+            x[i] = _mm256_add_epi32(x[i], t0);
+        }
+        
+        chacha_transpose(_mm256, x[0], x[1], x[2], x[3]), chacha_transpose(_mm256, x[4], x[5], x[6], x[7]);
+        chacha_transpose(_mm256, x[8], x[9], x[10], x[11]), chacha_transpose(_mm256, x[12], x[13], x[14], x[15]);
+        
+        for (i = 0; i < 4; i++) { // the low lanes of x[4*w + b] hold words of block b, the high lanes block b + 4
+            for (j = 0; j < 4; j += 2) {
+                t0 = _mm256_permute2x128_si256(x[4*j + i], x[4*j + 4 + i], 0x20);
+                t1 = _mm256_permute2x128_si256(x[4*j + i], x[4*j + 4 + i], 0x31);
+                t2 = _mm256_loadu_si256((const __m256i *)&data[off + i*64 + j*16]);
+                t3 = _mm256_loadu_si256((const __m256i *)&data[off + (i + 4)*64 + j*16]);
+                _mm256_storeu_si256((__m256i *)&out[off + i*64 + j*16], _mm256_xor_si256(t0, t2));
+                _mm256_storeu_si256((__m256i *)&out[off + (i + 4)*64 + j*16], _mm256_xor_si256(t1, t3));
+            }
+        }
+    }
+    
+    mem_clean(x, sizeof(x));
+    var_clean(&t0, &t1, &t2, &t3);
+    return off;
+}
+
+#endif // BR_CHACHA_SIMD
+
 // chacha20 stream cipher: https://cr.yp.to/chacha.html
 void BRChacha20(void *out, const void *key32, const void *iv8, const void *data, size_t dataLen, uint64_t counter)
 {
     static const char sigma[16] = "expand 32-byte k";
     uint32_t b[16], s[16], x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
-    size_t i, j;
+    size_t i, j, off = 0;
     
     assert(out != NULL || dataLen == 0);
     assert(data != NULL || dataLen == 0);
@@ -810,7 +1019,16 @@ void BRChacha20(void *out, const void *key32, const void *iv8, const void *data,
     memcpy(&s[14], iv8, 8);
     for (i = 0; i < 16; i++) s[i] = le32(s[i]);
 
-    for (i = 0; i < dataLen; i++) {
+#if BR_CHACHA_SIMD
+    if (_BRChacha20Vector()) {
+        counter = s[12] | ((uint64_t)s[13] << 32);
+        if (_BRChacha20Vector() > 1) off = _BRChacha20AVX2(out, data, dataLen, s, &counter);
+        off += _BRChacha20SSE2((uint8_t *)out + off, (const uint8_t *)data + off, dataLen - off, s, &counter);
+        s[12] = (uint32_t)counter, s[13] = (uint32_t)(counter >> 32);
+    }
+#endif
+
+    for (i = off; i < dataLen; i++) {
         if (i % 64 == 0) {
             x0 = s[0], x1 = s[1], x2 = s[2], x3 = s[3], x4 = s[4], x5 = s[5], x6 = s[6], x7 = s[7];
             x8 = s[8], x9 = s[9], x10 = s[10], x11 = s[11], x12 = s[12], x13 = s[13], x14 = s[14], x15 = s[15];
@@ -1011,6 +1229,200 @@ static void _BRAESDecipher(uint8_t x[16], const uint8_t k[256], size_t kl)
     var_clean(&a, &b, &c, &d, &e, &f, &g);
 }
 
+#if BR_AES_NI
+
+static volatile int _BRAESHardwareEnabled = 1;
+
+// 0 - portable software, 1 - aes-ni, 2 - aes-ni with vaes
+static int _BRAESHardware(void)
+{
+    static volatile int level = -1;
+    
+    if (level < 0) {
+        __builtin_cpu_init();
+        level = (! __builtin_cpu_supports("aes")) ? 0 :
+                (__builtin_cpu_supports("vaes") && __builtin_cpu_supports("avx2")) ? 2 : 1;
+    }
+    
+    return (_BRAESHardwareEnabled) ? level : 0;
+}
+
+#define aesni_expand(k, t) ((k) = _mm_xor_si128((k), _mm_slli_si128((k), 4)),\
+                            (k) = _mm_xor_si128((k), _mm_slli_si128((k), 4)),\
+                            (k) = _mm_xor_si128((k), _mm_slli_si128((k), 4)), (k) = _mm_xor_si128((k), (t)))
+#define aesni_expand128(i, rcon) (t = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(a, rcon), 0xff),\
+                                  aesni_expand(a, t), rk[i] = a)
+#define aesni_expand256a(i, rcon) (t = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(b, rcon), 0xff),\
+                                   aesni_expand(a, t), rk[i] = a)
+#define aesni_expand256b(i) (t = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(a, 0), 0xaa), aesni_expand(b, t), rk[i] = b)
+
+// returns the number of rounds
+__attribute__((target("aes,sse2")))
+static size_t _BRAESNIExpandKey(__m128i rk[15], const void *key, size_t kl)
+{
+    __m128i a, b, t;
+    uint8_t k[256];
+    size_t i, rounds = kl/4 + 6;
+    
+    if (kl == 16) {
+        rk[0] = a = _mm_loadu_si128((const __m128i *)key);
+        aesni_expand128(1, 0x01), aesni_expand128(2, 0x02), aesni_expand128(3, 0x04), aesni_expand128(4, 0x08);
+        aesni_expand128(5, 0x10), aesni_expand128(6, 0x20), aesni_expand128(7, 0x40), aesni_expand128(8, 0x80);
+        aesni_expand128(9, 0x1b), aesni_expand128(10, 0x36);
+    }
+    else if (kl == 32) {
+        rk[0] = a = _mm_loadu_si128((const __m128i *)key);
+        rk[1] = b = _mm_loadu_si128((const __m128i *)key + 1);
+        aesni_expand256a(2, 0x01), aesni_expand256b(3), aesni_expand256a(4, 0x02), aesni_expand256b(5);
+        aesni_expand256a(6, 0x04), aesni_expand256b(7), aesni_expand256a(8, 0x08), aesni_expand256b(9);
+        aesni_expand256a(10, 0x10), aesni_expand256b(11), aesni_expand256a(12, 0x20), aesni_expand256b(13);
+        aesni_expand256a(14, 0x40);
+    }
+    else { // aes-192 round keys straddle the 24 byte key words, so expand in software
+        _BRAESExpandKey(k, key, kl);
+        for (i = 0; i <= rounds; i++) rk[i] = _mm_loadu_si128((const __m128i *)&k[i*16]);
+        mem_clean(k, sizeof(k));
+    }
+    
+    return rounds;
+}
+
+__attribute__((target("aes,sse2")))
+static void _BRAESNIEncrypt(void *buf16, const void *key, size_t kl)
+{
+    __m128i rk[15], x = _mm_loadu_si128((const __m128i *)buf16);
+    size_t i, rounds = _BRAESNIExpandKey(rk, key, kl);
+    
+    x = _mm_xor_si128(x, rk[0]);
+    for (i = 1; i < rounds; i++) x = _mm_aesenc_si128(x, rk[i]);
+    _mm_storeu_si128((__m128i *)buf16, _mm_aesenclast_si128(x, rk[rounds]));
+    mem_clean(rk, sizeof(rk));
+}
+
+__attribute__((target("aes,sse2")))
+static void _BRAESNIDecrypt(void *buf16, const void *key, size_t kl)
+{
+    __m128i rk[15], x = _mm_loadu_si128((const __m128i *)buf16);
+    size_t i, rounds = _BRAESNIExpandKey(rk, key, kl);
+    
+    x = _mm_xor_si128(x, rk[rounds]);
+    for (i = rounds - 1; i > 0; i--) x = _mm_aesdec_si128(x, _mm_aesimc_si128(rk[i])); // equivalent inverse cipher
+    _mm_storeu_si128((__m128i *)buf16, _mm_aesdeclast_si128(x, rk[0]));
+    mem_clean(rk, sizeof(rk));
+}
+
+// applies the round function f with round key k to all 8 blocks, unrolled so that the blocks stay in registers
+#define aes_round8(f, x, k) ((x)[0] = f((x)[0], k), (x)[1] = f((x)[1], k), (x)[2] = f((x)[2], k),\
+                             (x)[3] = f((x)[3], k), (x)[4] = f((x)[4], k), (x)[5] = f((x)[5], k),\
+                             (x)[6] = f((x)[6], k), (x)[7] = f((x)[7], k))
+
+// the counter block for iv hi:lo, as a big endian 128bit integer
+#define aesni_counter(hi, lo) _mm_set_epi64x((long long)__builtin_bswap64(lo), (long long)__builtin_bswap64(hi))
+
+// aes-ctr on 16 blocks at a time, two per 256bit vector; returns the number of bytes processed, a multiple of 256
+__attribute__((target("vaes,avx2,aes")))
+static size_t _BRVAESCTR(uint8_t *out, const uint8_t *data, size_t dataLen, const __m128i rk[15], size_t rounds,
+                         uint64_t *hi, uint64_t *lo)
+{
+    __m256i k[15], x[8];
+    size_t i, j, off;
+    
+    for (i = 0; i <= rounds; i++) k[i] = _mm256_broadcastsi128_si256(rk[i]);
+    
+    for (off = 0; dataLen - off >= 16*16; off += 16*16) {
+        for (i = 0; i < 8; i++) {
+            __m128i c0 = aesni_counter(*hi, *lo);
+            
+            if (++*lo == 0) ++*hi;
+            x[i] = _mm256_inserti128_si256(_mm256_castsi128_si256(c0), aesni_counter(*hi, *lo), 1);
+            if (++*lo == 0) ++*hi;
+            x[i] = _mm256_xor_si256(x[i], k[0]);
+        }
+        
+        for (j = 1; j < rounds; j++) aes_round8(_mm256_aesenc_epi128, x, k[j]);
+        aes_round8(_mm256_aesenclast_epi128, x, k[rounds]);
+        
+        for (i = 0; i < 8; i++) {
+            _mm256_storeu_si256((__m256i *)&out[off + i*32],
+                                _mm256_xor_si256(x[i], _mm256_loadu_si256((const __m256i *)&data[off + i*32])));
+        }
+    }
+    
+    mem_clean(k, sizeof(k));
+    mem_clean(x, sizeof(x));
+    return off;
+}
+
+// aes-ctr on 8 blocks at a time, so the latency of each aesenc is hidden behind the others; iv16 is incremented once
+// per block, including a final partial block
+__attribute__((target("aes,sse2")))
+static void _BRAESNICTR(void *out, const void *key, size_t kl, uint8_t iv16[16], const void *data, size_t dataLen,
+                        int vaes)
+{
+    const uint8_t *d = data;
+    uint8_t *o = out, ks[16];
+    __m128i rk[15], x[8];
+    uint64_t hi, lo;
+    size_t i, j, off = 0, rounds = _BRAESNIExpandKey(rk, key, kl);
+    
+    memcpy(&hi, iv16, sizeof(hi));
+    memcpy(&lo, &iv16[8], sizeof(lo));
+    hi = __builtin_bswap64(hi), lo = __builtin_bswap64(lo);
+    if (vaes) off = _BRVAESCTR(o, d, dataLen, rk, rounds, &hi, &lo);
+    
+    for (; dataLen - off >= 16*8; off += 16*8) {
+        for (i = 0; i < 8; i++) {
+            x[i] = _mm_xor_si128(aesni_counter(hi, lo), rk[0]);
+            if (++lo == 0) ++hi;
+        }
+        
+        for (j = 1; j < rounds; j++) aes_round8(_mm_aesenc_si128, x, rk[j]);
+        aes_round8(_mm_aesenclast_si128, x, rk[rounds]);
+        
+        for (i = 0; i < 8; i++) {
+            _mm_storeu_si128((__m128i *)&o[off + i*16],
+                             _mm_xor_si128(x[i], _mm_loadu_si128((const __m128i *)&d[off + i*16])));
+        }
+    }
+    
+    for (; off < dataLen; off += 16) {
+        x[0] = _mm_xor_si128(aesni_counter(hi, lo), rk[0]);
+        if (++lo == 0) ++hi;
+        for (j = 1; j < rounds; j++) x[0] = _mm_aesenc_si128(x[0], rk[j]);
+        x[0] = _mm_aesenclast_si128(x[0], rk[rounds]);
+        
+        if (dataLen - off >= 16) {
+            _mm_storeu_si128((__m128i *)&o[off], _mm_xor_si128(x[0], _mm_loadu_si128((const __m128i *)&d[off])));
+        }
+        else { // final partial block
+            _mm_storeu_si128((__m128i *)ks, x[0]);
+            for (i = 0; off + i < dataLen; i++) o[off + i] = d[off + i] ^ ks[i];
+        }
+    }
+    
+    hi = __builtin_bswap64(hi), lo = __builtin_bswap64(lo);
+    memcpy(iv16, &hi, sizeof(hi));
+    memcpy(&iv16[8], &lo, sizeof(lo));
+    mem_clean(rk, sizeof(rk));
+    mem_clean(x, sizeof(x));
+    mem_clean(ks, sizeof(ks));
+}
+
+#endif // BR_AES_NI
+
+// use the cpu's aes instructions, when it has them; returns the previous setting
+int BRAESSetHardwareEnabled(int enabled)
+{
+#if BR_AES_NI
+    int previous = _BRAESHardwareEnabled;
+    
+    _BRAESHardwareEnabled = enabled;
+    return previous;
+#else
+    return 0;
+#endif
+}
+
 // aes-ecb block cipher
 void BRAESECBEncrypt(void *buf16, const void *key, size_t keyLen)
 {
@@ -1020,6 +1432,13 @@ void BRAESECBEncrypt(void *buf16, const void *key, size_t keyLen)
     assert(key != NULL);
     assert(keyLen == 16 || keyLen == 24 || keyLen == 32);
     
+#if BR_AES_NI
+    if (_BRAESHardware()) {
+        _BRAESNIEncrypt(buf16, key, keyLen);
+        return;
+    }
+#endif
+
     _BRAESExpandKey(k, key, keyLen);
     _BRAESCipher(buf16, k, keyLen);
     mem_clean(k, sizeof(k));
@@ -1033,6 +1452,13 @@ void BRAESECBDecrypt(void *buf16, const void *key, size_t keyLen)
     assert(key != NULL);
     assert(keyLen == 16 || keyLen == 24 || keyLen == 32);
     
+#if BR_AES_NI
+    if (_BRAESHardware()) {
+        _BRAESNIDecrypt(buf16, key, keyLen);
+        return;
+    }
+#endif
+
     _BRAESExpandKey(k, key, keyLen);
     _BRAESDecipher(buf16, k, keyLen);
     mem_clean(k, sizeof(k));
@@ -1051,6 +1477,14 @@ void BRAESCTR(void *out, const void *key, size_t keyLen, const void *iv16, const
     assert(data != NULL || dataLen == 0);
     
     memcpy(iv, iv16, 16);
+    
+#if BR_AES_NI
+    if (_BRAESHardware()) {
+        _BRAESNICTR(out, key, keyLen, iv, data, dataLen, _BRAESHardware() > 1);
+        return;
+    }
+#endif
+
     _BRAESExpandKey(k, key, keyLen);
     
     for (off = 0; off < dataLen; off++) {
@@ -1080,6 +1514,15 @@ void BRAESCTR_OFFSET(void *out, size_t outLen, const void *key, size_t keyLen, v
     assert(data != NULL || dataLen == 0);
     
     memcpy(iv, iv16, 16);
+    
+#if BR_AES_NI
+    if (_BRAESHardware() && (dataLen - outLen) % 16 == 0) {
+        _BRAESNICTR(out, key, keyLen, iv, data, outLen, _BRAESHardware() > 1);
+        memcpy(iv16, iv, 16);
+        return;
+    }
+#endif
+
     _BRAESExpandKey(k, key, keyLen);
     
     for (off = (dataLen - outLen); off < dataLen; off++, outIdx++) {
@@ -1177,13 +1620,210 @@ static void _blockmix_salsa8(uint64_t *dest, const uint64_t *src, uint64_t *b, u
     }
 }
 
+static volatile int _BRScryptVectorEnabled = 1;
+
+#if BR_SCRYPT_SIMD
+
+// 0 - portable, 1 - sse2, 2 - avx2
+static int _BRScryptVector(void)
+{
+    static volatile int level = -1;
+    
+    if (level < 0) {
+        __builtin_cpu_init();
+        level = (__builtin_cpu_supports("avx2")) ? 2 : (__builtin_cpu_supports("sse2")) ? 1 : 0;
+    }
+    
+    return (_BRScryptVectorEnabled) ? level : 0;
+}
+
+// in the vector code each 64 byte salsa20/8 block is held as 4 vectors of its diagonals - words 0, 5, 10, 15, then
+// 4, 9, 14, 3, then 8, 13, 2, 7, then 12, 1, 6, 11 - so that the column and row operations each apply to whole
+// vectors, with a rotation of the vector words between them
+#define salsa_diagonal(i) ((i)*5 % 16)
+
+#define salsa_step128(a, b, c, n) (t = _mm_add_epi32(b, c),\
+                                   (a) = _mm_xor_si128(_mm_xor_si128(a, _mm_slli_epi32(t, n)), _mm_srli_epi32(t, 32 - (n))))
+
+// blockmix with salsa20/8, in sse2 vectors
+__attribute__((target("sse2")))
+static void _blockmix_salsa8_sse2(__m128i *dest, const __m128i *src, unsigned r)
+{
+    __m128i x0 = src[(2*r - 1)*4], x1 = src[(2*r - 1)*4 + 1], x2 = src[(2*r - 1)*4 + 2], x3 = src[(2*r - 1)*4 + 3],
+            y0, y1, y2, y3, t;
+    
+    for (unsigned i = 0; i < 8*r; i += 4) { // one 64 byte block, 4 vectors, at a time
+        x0 = y0 = _mm_xor_si128(x0, src[i]), x1 = y1 = _mm_xor_si128(x1, src[i + 1]);
+        x2 = y2 = _mm_xor_si128(x2, src[i + 2]), x3 = y3 = _mm_xor_si128(x3, src[i + 3]);
+        
+        for (unsigned j = 0; j < 8; j += 2) {
+            // operate on columns
+            salsa_step128(x1, x0, x3, 7), salsa_step128(x2, x1, x0, 9);
+            salsa_step128(x3, x2, x1, 13), salsa_step128(x0, x3, x2, 18);
+            x1 = _mm_shuffle_epi32(x1, 0x93), x2 = _mm_shuffle_epi32(x2, 0x4e), x3 = _mm_shuffle_epi32(x3, 0x39);
+            
+            // operate on rows
+            salsa_step128(x3, x0, x1, 7), salsa_step128(x2, x3, x0, 9);
+            salsa_step128(x1, x2, x3, 13), salsa_step128(x0, x1, x2, 18);
+            x1 = _mm_shuffle_epi32(x1, 0x39), x2 = _mm_shuffle_epi32(x2, 0x4e), x3 = _mm_shuffle_epi32(x3, 0x93);
+        }
+        
+        x0 = _mm_add_epi32(x0, y0), x1 = _mm_add_epi32(x1, y1), x2 = _mm_add_epi32(x2, y2), x3 = _mm_add_epi32(x3, y3);
+        
+        // even blocks to the first half of dest, odd blocks to the second
+        dest[((i/4) % 2)*r*4 + (i/8)*4] = x0, dest[((i/4) % 2)*r*4 + (i/8)*4 + 1] = x1;
+        dest[((i/4) % 2)*r*4 + (i/8)*4 + 2] = x2, dest[((i/4) % 2)*r*4 + (i/8)*4 + 3] = x3;
+    }
+}
+
+// scrypt romix on one lane of b, 32*r words, using v, 128*r*n bytes
+__attribute__((target("sse2")))
+static void _BRScryptROMixSSE2(uint32_t *b, uint8_t *v, unsigned n, unsigned r)
+{
+    __m128i x[8*r], y[8*r];
+    uint32_t *w = (uint32_t *)x, m;
+    
+    for (unsigned j = 0; j < 32*r; j++) w[j] = le32(b[(j/16)*16 + salsa_diagonal(j % 16)]);
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        for (unsigned k = 0; k < 8*r; k++) _mm_storeu_si128((__m128i *)&v[(j*8*r + k)*16], x[k]);
+        _blockmix_salsa8_sse2(y, x, r);
+        for (unsigned k = 0; k < 8*r; k++) _mm_storeu_si128((__m128i *)&v[((j + 1)*8*r + k)*16], y[k]);
+        _blockmix_salsa8_sse2(x, y, r);
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) { // word 0 is first in its diagonal, so the block index is unchanged
+        m = w[(2*r - 1)*16] & (n - 1);
+        for (unsigned k = 0; k < 8*r; k++) x[k] = _mm_xor_si128(x[k], _mm_loadu_si128((__m128i *)&v[(m*8*r + k)*16]));
+        _blockmix_salsa8_sse2(y, x, r);
+        m = ((uint32_t *)y)[(2*r - 1)*16] & (n - 1);
+        for (unsigned k = 0; k < 8*r; k++) y[k] = _mm_xor_si128(y[k], _mm_loadu_si128((__m128i *)&v[(m*8*r + k)*16]));
+        _blockmix_salsa8_sse2(x, y, r);
+    }
+    
+    for (unsigned j = 0; j < 32*r; j++) b[(j/16)*16 + salsa_diagonal(j % 16)] = le32(w[j]);
+    mem_clean(x, sizeof(x));
+    mem_clean(y, sizeof(y));
+    var_clean(&m);
+}
+
+#define salsa_step256(a, b, c, n) (t = _mm256_add_epi32(b, c),\
+                                   (a) = _mm256_xor_si256(_mm256_xor_si256(a, _mm256_slli_epi32(t, n)),\
+                                                          _mm256_srli_epi32(t, 32 - (n))))
+
+// blockmix with salsa20/8 for two independent lanes at once, one per 128bit half of 256bit vectors
+__attribute__((target("avx2")))
+static void _blockmix_salsa8_avx2(__m256i *dest, const __m256i *src, unsigned r)
+{
+    __m256i x0 = src[(2*r - 1)*4], x1 = src[(2*r - 1)*4 + 1], x2 = src[(2*r - 1)*4 + 2], x3 = src[(2*r - 1)*4 + 3],
+            y0, y1, y2, y3, t;
+    
+    for (unsigned i = 0; i < 8*r; i += 4) {
+        x0 = y0 = _mm256_xor_si256(x0, src[i]), x1 = y1 = _mm256_xor_si256(x1, src[i + 1]);
+        x2 = y2 = _mm256_xor_si256(x2, src[i + 2]), x3 = y3 = _mm256_xor_si256(x3, src[i + 3]);
+        
+        for (unsigned j = 0; j < 8; j += 2) {
+            salsa_step256(x1, x0, x3, 7), salsa_step256(x2, x1, x0, 9);
+            salsa_step256(x3, x2, x1, 13), salsa_step256(x0, x3, x2, 18);
+            x1 = _mm256_shuffle_epi32(x1, 0x93), x2 = _mm256_shuffle_epi32(x2, 0x4e), x3 = _mm256_shuffle_epi32(x3, 0x39);
+            
+            salsa_step256(x3, x0, x1, 7), salsa_step256(x2, x3, x0, 9);
+            salsa_step256(x1, x2, x3, 13), salsa_step256(x0, x1, x2, 18);
+            x1 = _mm256_shuffle_epi32(x1, 0x39), x2 = _mm256_shuffle_epi32(x2, 0x4e), x3 = _mm256_shuffle_epi32(x3, 0x93);
+        }
+        
+        x0 = _mm256_add_epi32(x0, y0), x1 = _mm256_add_epi32(x1, y1);
+        x2 = _mm256_add_epi32(x2, y2), x3 = _mm256_add_epi32(x3, y3);
+        dest[((i/4) % 2)*r*4 + (i/8)*4] = x0, dest[((i/4) % 2)*r*4 + (i/8)*4 + 1] = x1;
+        dest[((i/4) % 2)*r*4 + (i/8)*4 + 2] = x2, dest[((i/4) % 2)*r*4 + (i/8)*4 + 3] = x3;
+    }
+}
+
+// scrypt romix on the two lanes b0 and b1, each 32*r words, using v, 2*128*r*n bytes
+__attribute__((target("avx2")))
+static void _BRScryptROMixAVX2(uint32_t *b0, uint32_t *b1, uint8_t *v, unsigned n, unsigned r)
+{
+    __m256i x[8*r], y[8*r];
+    uint32_t *w = (uint32_t *)x, m0, m1;
+    uint8_t *v1 = &v[128*r*n];
+    
+    for (unsigned j = 0; j < 32*r; j++) { // lane 0 in words 0...3 of each vector, lane 1 in words 4...7
+        w[(j/4)*8 + j % 4] = le32(b0[(j/16)*16 + salsa_diagonal(j % 16)]);
+        w[(j/4)*8 + 4 + j % 4] = le32(b1[(j/16)*16 + salsa_diagonal(j % 16)]);
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        for (unsigned k = 0; k < 8*r; k++) {
+            _mm_storeu_si128((__m128i *)&v[(j*8*r + k)*16], _mm256_castsi256_si128(x[k]));
+            _mm_storeu_si128((__m128i *)&v1[(j*8*r + k)*16], _mm256_extracti128_si256(x[k], 1));
+        }
+        
+        _blockmix_salsa8_avx2(y, x, r);
+        
+        for (unsigned k = 0; k < 8*r; k++) {
+            _mm_storeu_si128((__m128i *)&v[((j + 1)*8*r + k)*16], _mm256_castsi256_si128(y[k]));
+            _mm_storeu_si128((__m128i *)&v1[((j + 1)*8*r + k)*16], _mm256_extracti128_si256(y[k], 1));
+        }
+        
+        _blockmix_salsa8_avx2(x, y, r);
+    }
+    
+    for (unsigned j = 0; j < n; j += 2) {
+        m0 = w[(2*r - 1)*32] & (n - 1), m1 = w[(2*r - 1)*32 + 4] & (n - 1);
+        
+        for (unsigned k = 0; k < 8*r; k++) {
+            x[k] = _mm256_xor_si256(x[k], _mm256_inserti128_si256(
+                       _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&v[(m0*8*r + k)*16])),
+                       _mm_loadu_si128((__m128i *)&v1[(m1*8*r + k)*16]), 1));
+        }
+        
+        _blockmix_salsa8_avx2(y, x, r);
+        m0 = ((uint32_t *)y)[(2*r - 1)*32] & (n - 1), m1 = ((uint32_t *)y)[(2*r - 1)*32 + 4] & (n - 1);
+        
+        for (unsigned k = 0; k < 8*r; k++) {
+            y[k] = _mm256_xor_si256(y[k], _mm256_inserti128_si256(
+                       _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&v[(m0*8*r + k)*16])),
+                       _mm_loadu_si128((__m128i *)&v1[(m1*8*r + k)*16]), 1));
+        }
+        
+        _blockmix_salsa8_avx2(x, y, r);
+    }
+    
+    for (unsigned j = 0; j < 32*r; j++) {
+        b0[(j/16)*16 + salsa_diagonal(j % 16)] = le32(w[(j/4)*8 + j % 4]);
+        b1[(j/16)*16 + salsa_diagonal(j % 16)] = le32(w[(j/4)*8 + 4 + j % 4]);
+    }
+    
+    mem_clean(x, sizeof(x));
+    mem_clean(y, sizeof(y));
+    var_clean(&m0, &m1);
+}
+
+#endif // BR_SCRYPT_SIMD
+
+// scrypt uses the cpu's simd vectors when available; returns the previous setting
+int BRScryptSetVectorEnabled(int enabled)
+{
+    int previous = _BRScryptVectorEnabled;
+    
+    _BRScryptVectorEnabled = enabled;
+    return previous;
+}
+
 // scrypt key derivation: http://www.tarsnap.com/scrypt.html
 void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
               unsigned n, unsigned r, unsigned p)
 {
-    uint64_t x[16*r], y[16*r], z[8], *v = malloc(128*r*n), m;
+    uint64_t x[16*r], y[16*r], z[8], *v, m;
     uint32_t b[32*r*p];
+    unsigned i = 0, lanes = 1; // lanes of romix computed at once, each using 128*r*n bytes of v
+#if BR_SCRYPT_SIMD
+    int vector = _BRScryptVector();
+    
+    if (vector > 1 && p > 1) lanes = 2;
+#endif
     
+    v = malloc(128*r*n*lanes);
     assert(v != NULL);
     assert(dk != NULL || dkLen == 0);
     assert(pw != NULL || pwLen == 0);
@@ -1194,7 +1834,12 @@ void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *
     
     BRPBKDF2(b, sizeof(b), BRSHA256, 256/8, pw, pwLen, salt, saltLen, 1);
     
-    for (int i = 0; i < p; i++) {
+#if BR_SCRYPT_SIMD
+    if (vector > 1) for (; i + 1 < p; i += 2) _BRScryptROMixAVX2(&b[i*32*r], &b[(i + 1)*32*r], (uint8_t *)v, n, r);
+    if (vector > 0) for (; i < p; i++) _BRScryptROMixSSE2(&b[i*32*r], (uint8_t *)v, n, r);
+#endif
+    
+    for (; i < p; i++) {
         for (unsigned j = 0; j < 32*r; j++) ((uint32_t *)x)[j] = le32(b[i*32*r + j]);
         
         for (unsigned j = 0; j < n; j += 2) {
@@ -1221,6 +1866,6 @@ void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *
     mem_clean(x, sizeof(x));
     mem_clean(y, sizeof(y));
     mem_clean(z, sizeof(z));
-    mem_clean(v, 128*r*n);
+    mem_clean(v, 128*r*n*lanes);
     free(v);
 }
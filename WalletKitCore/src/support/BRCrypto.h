@@ -91,6 +91,10 @@ size_t BRChacha20Poly1305AEADEncrypt(void *out, size_t outLen, const void *key32
 
 size_t BRChacha20Poly1305AEADDecrypt(void *out, size_t outLen, const void *key32, const void *nonce12,
                                      const void *data, size_t dataLen, const void *ad, size_t adLen);
+
+// chacha20 and poly1305 use the cpu's simd vectors (sse2, avx2) and 64bit arithmetic when available; disabled, they use
+// portable 32bit code. returns the previous setting
+int BRChacha20Poly1305SetVectorEnabled(int enabled);
     
 // aes-ecb block cipher
 void BRAESECBEncrypt(void *buf16, const void *key, size_t keyLen);
@@ -100,6 +104,10 @@ void BRAESECBDecrypt(void *buf16, const void *key, size_t keyLen);
 // aes-ctr stream cipher encrypt/decrypt
 void BRAESCTR(void *out, const void *key, size_t keyLen, const void *iv16, const void *data, size_t dataLen);
 void BRAESCTR_OFFSET(void *out, size_t outLen, const void *key, size_t keyLen, void *iv16, const void *data, size_t dataLen);
+
+// aes uses the cpu's aes instructions (aes-ni, and vaes) when it has them; with hardware disabled, or on other cpus, aes
+// is computed in portable software. returns the previous setting
+int BRAESSetHardwareEnabled(int enabled);
     
 void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t), size_t hashLen,
               const void *pw, size_t pwLen, const void *salt, size_t saltLen, unsigned rounds);
@@ -108,6 +116,10 @@ void BRPBKDF2(void *dk, size_t dkLen, void (*hash)(void *, const void *, size_t)
 void BRScrypt(void *dk, size_t dkLen, const void *pw, size_t pwLen, const void *salt, size_t saltLen,
               unsigned n, unsigned r, unsigned p);
 
+// scrypt uses the cpu's simd vectors (sse2, avx2) when available; with avx2, and p > 1, two lanes are computed at once
+// using 2*128*r*n bytes of memory in place of 128*r*n. returns the previous setting
+int BRScryptSetVectorEnabled(int enabled);
+
 // zeros out memory in a way that can't be optimized out by the compiler
 inline static void mem_clean(void *ptr, size_t len)
 {
@@ -198,6 +198,10 @@ struct BRFileServiceRecord {
     BRFileServiceContext context;
     BRFileServiceErrorHandler handler;
 
+    /// Metrics, if any; see `fileServiceSetMetrics()`
+    BRMetricsCounter metricsWrites;
+    BRMetricsHistogram metricsWriteLatency;
+
     pthread_mutex_t lock;
 };
 
@@ -436,6 +440,15 @@ fileServiceSetErrorHandler (BRFileService fs,
     fs->handler = handler;
 }
 
+extern void
+fileServiceSetMetrics (BRFileService fs,
+                       BRMetrics metrics) {
+    pthread_mutex_lock (&fs->lock);
+    fs->metricsWrites       = BRMetricsGetCounter   (metrics, "fileService.writes");
+    fs->metricsWriteLatency = BRMetricsGetHistogram (metrics, "fileService.writeLatency");
+    pthread_mutex_unlock (&fs->lock);
+}
+
 static BRFileServiceEntityType *
 fileServiceLookupType (const BRFileService fs,
                        const char *type) {
@@ -603,6 +616,8 @@ _fileServiceSave (BRFileService fs,
     if (fs->sdbClosed)
         return fileServiceFailedImpl (fs, needLock, NULL, NULL, "closed");
 
+    uint64_t writeStart = (NULL != fs->metricsWriteLatency ? BRMetricsNow() : 0);
+
     sqlite3_reset (fs->sdbInsertStmt);
     sqlite3_clear_bindings(fs->sdbInsertStmt);
 
@@ -633,6 +648,9 @@ _fileServiceSave (BRFileService fs,
     // Ensure the 'implicit DB transaction' is committed.
     sqlite3_reset (fs->sdbInsertStmt);
 
+    BRMetricsCounterAdd (fs->metricsWrites, 1);
+    BRMetricsHistogramRecordSince (fs->metricsWriteLatency, writeStart);
+
     if (needLock)
         pthread_mutex_unlock (&fs->lock);
 
@@ -29,6 +29,7 @@
 #include <stdlib.h>
 #include "BRSet.h"
 #include "BRInt.h"
+#include "BRMetrics.h"
 
 // Both Bitcoin and Ethereum Wallet Managers include the ability to save and load peers, block,
 // transactions and logs (for Ethereum) to the file system.  But, they both implement the file
@@ -110,6 +111,14 @@ fileServiceSetErrorHandler (BRFileService fs,
                             BRFileServiceContext context,
                             BRFileServiceErrorHandler handler);
 
+/**
+ * Count saves ('fileService.writes') and record their SQLite write latency, in microseconds
+ * ('fileService.writeLatency'), in `metrics`.  The `metrics` must outlive the file service.
+ */
+extern void
+fileServiceSetMetrics (BRFileService fs,
+                       BRMetrics metrics);
+
 /**
  * Load all entities of `type` adding each to `results`.  If there is an error then the
  * fileServices' error handler is invoked and 0 is returned
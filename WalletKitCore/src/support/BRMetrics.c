@@ -0,0 +1,235 @@
+//
+//  BRMetrics.c
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "BRArray.h"
+#include "BRMetrics.h"
+
+// The number of stripes per counter; a power of two.
+#define METRICS_COUNTER_STRIPES         (8)
+
+// Stripes are padded to a (typical) cache line, so threads on different stripes don't contend.
+#define METRICS_CACHE_LINE_SIZE         (64)
+
+typedef struct {
+    atomic_uint_fast64_t value;
+    uint8_t padding[METRICS_CACHE_LINE_SIZE - sizeof (atomic_uint_fast64_t)];
+} BRMetricsStripe;
+
+// Allocated on a cache line boundary, so that each stripe is exactly one line.
+struct BRMetricsCounterRecord {
+    BRMetricsStripe stripes[METRICS_COUNTER_STRIPES];
+    const char *name;
+};
+
+struct BRMetricsHistogramRecord {
+    atomic_uint_fast64_t buckets[BR_METRICS_HISTOGRAM_BUCKETS];
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t sum;
+    const char *name;
+};
+
+struct BRMetricsRecord {
+    BRArrayOf(BRMetricsCounter) counters;
+    BRArrayOf(BRMetricsHistogram) histograms;
+
+    /// Guards `counters` and `histograms`; not the updates
+    pthread_mutex_t lock;
+};
+
+// Each thread is assigned a stripe, round-robin, on its first update.
+static atomic_uint metricsStripeNext = 0;
+static __thread unsigned int metricsStripe = UINT32_MAX;
+
+static inline unsigned int
+metricsGetStripe (void) {
+    if (UINT32_MAX == metricsStripe)
+        metricsStripe = atomic_fetch_add_explicit (&metricsStripeNext, 1, memory_order_relaxed) % METRICS_COUNTER_STRIPES;
+    return metricsStripe;
+}
+
+extern BRMetrics
+BRMetricsNew (void) {
+    BRMetrics metrics = calloc (1, sizeof (struct BRMetricsRecord));
+    assert (NULL != metrics);
+
+    array_new (metrics->counters,   16);
+    array_new (metrics->histograms, 16);
+    pthread_mutex_init (&metrics->lock, NULL);
+
+    return metrics;
+}
+
+extern void
+BRMetricsFree (BRMetrics metrics) {
+    if (NULL == metrics) return;
+
+    for (size_t index = 0; index < array_count (metrics->counters); index++)
+        free (metrics->counters[index]);
+    array_free (metrics->counters);
+
+    for (size_t index = 0; index < array_count (metrics->histograms); index++)
+        free (metrics->histograms[index]);
+    array_free (metrics->histograms);
+
+    pthread_mutex_destroy (&metrics->lock);
+    free (metrics);
+}
+
+extern BRMetricsCounter
+BRMetricsGetCounter (BRMetrics metrics,
+                     const char *name) {
+    if (NULL == metrics) return NULL;
+    BRMetricsCounter counter = NULL;
+
+    pthread_mutex_lock (&metrics->lock);
+    for (size_t index = 0; NULL == counter && index < array_count (metrics->counters); index++)
+        if (0 == strcmp (name, metrics->counters[index]->name))
+            counter = metrics->counters[index];
+
+    if (NULL == counter) {
+        void *memory = NULL;
+        if (0 != posix_memalign (&memory, METRICS_CACHE_LINE_SIZE, sizeof (struct BRMetricsCounterRecord))) memory = NULL;
+        assert (NULL != memory);
+
+        counter = memset (memory, 0, sizeof (struct BRMetricsCounterRecord));
+
+        counter->name = name;
+        for (size_t stripe = 0; stripe < METRICS_COUNTER_STRIPES; stripe++)
+            atomic_init (&counter->stripes[stripe].value, 0);
+        array_add (metrics->counters, counter);
+    }
+    pthread_mutex_unlock (&metrics->lock);
+
+    return counter;
+}
+
+extern BRMetricsHistogram
+BRMetricsGetHistogram (BRMetrics metrics,
+                       const char *name) {
+    if (NULL == metrics) return NULL;
+    BRMetricsHistogram histogram = NULL;
+
+    pthread_mutex_lock (&metrics->lock);
+    for (size_t index = 0; NULL == histogram && index < array_count (metrics->histograms); index++)
+        if (0 == strcmp (name, metrics->histograms[index]->name))
+            histogram = metrics->histograms[index];
+
+    if (NULL == histogram) {
+        histogram = calloc (1, sizeof (struct BRMetricsHistogramRecord));
+        assert (NULL != histogram);
+
+        histogram->name = name;
+        for (size_t bucket = 0; bucket < BR_METRICS_HISTOGRAM_BUCKETS; bucket++)
+            atomic_init (&histogram->buckets[bucket], 0);
+        atomic_init (&histogram->count, 0);
+        atomic_init (&histogram->sum,   0);
+        array_add (metrics->histograms, histogram);
+    }
+    pthread_mutex_unlock (&metrics->lock);
+
+    return histogram;
+}
+
+extern void
+BRMetricsCounterAdd (BRMetricsCounter counter,
+                     uint64_t value) {
+    if (NULL == counter) return;
+    atomic_fetch_add_explicit (&counter->stripes[metricsGetStripe()].value, value, memory_order_relaxed);
+}
+
+static inline size_t
+metricsHistogramBucket (uint64_t value) {
+    size_t bucket = 0;
+    while (value > 0 && bucket < BR_METRICS_HISTOGRAM_BUCKETS - 1) {
+        value >>= 1;
+        bucket += 1;
+    }
+    return bucket;
+}
+
+extern void
+BRMetricsHistogramRecord (BRMetricsHistogram histogram,
+                          uint64_t value) {
+    if (NULL == histogram) return;
+    atomic_fetch_add_explicit (&histogram->buckets[metricsHistogramBucket (value)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit (&histogram->count, 1,     memory_order_relaxed);
+    atomic_fetch_add_explicit (&histogram->sum,   value, memory_order_relaxed);
+}
+
+extern void
+BRMetricsHistogramRecordSince (BRMetricsHistogram histogram,
+                               uint64_t start) {
+    if (NULL == histogram) return;
+
+    uint64_t now = BRMetricsNow();
+    BRMetricsHistogramRecord (histogram, (now > start ? now - start : 0));
+}
+
+extern uint64_t
+BRMetricsNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return 1000000 * (uint64_t) ts.tv_sec + (uint64_t) ts.tv_nsec / 1000;
+}
+
+extern size_t
+BRMetricsGetCounterSnapshots (BRMetrics metrics,
+                              BRMetricsCounterSnapshot *counters,
+                              size_t countersCount) {
+    pthread_mutex_lock (&metrics->lock);
+    size_t count = array_count (metrics->counters);
+    if (NULL != counters) {
+        if (countersCount > count) countersCount = count;
+
+        for (size_t index = 0; index < countersCount; index++) {
+            BRMetricsCounter counter = metrics->counters[index];
+            uint64_t value = 0;
+            for (size_t stripe = 0; stripe < METRICS_COUNTER_STRIPES; stripe++)
+                value += atomic_load_explicit (&counter->stripes[stripe].value, memory_order_relaxed);
+
+            counters[index] = (BRMetricsCounterSnapshot) { counter->name, value };
+        }
+        count = countersCount;
+    }
+    pthread_mutex_unlock (&metrics->lock);
+
+    return count;
+}
+
+extern size_t
+BRMetricsGetHistogramSnapshots (BRMetrics metrics,
+                                BRMetricsHistogramSnapshot *histograms,
+                                size_t histogramsCount) {
+    pthread_mutex_lock (&metrics->lock);
+    size_t count = array_count (metrics->histograms);
+    if (NULL != histograms) {
+        if (histogramsCount > count) histogramsCount = count;
+
+        for (size_t index = 0; index < histogramsCount; index++) {
+            BRMetricsHistogram histogram = metrics->histograms[index];
+
+            histograms[index].name  = histogram->name;
+            histograms[index].count = atomic_load_explicit (&histogram->count, memory_order_relaxed);
+            histograms[index].sum   = atomic_load_explicit (&histogram->sum,   memory_order_relaxed);
+            for (size_t bucket = 0; bucket < BR_METRICS_HISTOGRAM_BUCKETS; bucket++)
+                histograms[index].buckets[bucket] = atomic_load_explicit (&histogram->buckets[bucket], memory_order_relaxed);
+        }
+        count = histogramsCount;
+    }
+    pthread_mutex_unlock (&metrics->lock);
+
+    return count;
+}
@@ -0,0 +1,111 @@
+//
+//  BRMetrics.h
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#ifndef BRMetrics_h
+#define BRMetrics_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Metrics
+
+///
+/// A registry of named counters and histograms, typically one per wallet manager, shared by
+/// the manager's subsystems (peers, file service, event handler, ...).  A subsystem looks up its
+/// counters and histograms once, when given the registry, and then updates them on its hot
+/// paths.  Updates are lock-free: a counter is striped so that threads mostly update their own
+/// cache line; a histogram's buckets are updated atomically.
+///
+/// Every update function accepts NULL, and does nothing, so that subsystems without a registry
+/// need not check.
+///
+typedef struct BRMetricsRecord *BRMetrics;
+
+typedef struct BRMetricsCounterRecord *BRMetricsCounter;
+
+typedef struct BRMetricsHistogramRecord *BRMetricsHistogram;
+
+/// Histogram buckets are powers of two: bucket 0 holds zero, bucket N holds values in
+/// [2^(N-1), 2^N) and the last bucket holds everything larger.
+#define BR_METRICS_HISTOGRAM_BUCKETS        (32)
+
+extern BRMetrics
+BRMetricsNew (void);
+
+/// Free the registry, its counters and its histograms.  No subsystem may still update them.
+extern void
+BRMetricsFree (BRMetrics metrics);
+
+/// The counter named `name`, created if needed.  The `name` must be static.  Returns NULL if
+/// `metrics` is NULL.
+extern BRMetricsCounter
+BRMetricsGetCounter (BRMetrics metrics,
+                     const char *name);
+
+/// The histogram named `name`, created if needed.  The `name` must be static.  Returns NULL if
+/// `metrics` is NULL.
+extern BRMetricsHistogram
+BRMetricsGetHistogram (BRMetrics metrics,
+                       const char *name);
+
+extern void
+BRMetricsCounterAdd (BRMetricsCounter counter,
+                     uint64_t value);
+
+extern void
+BRMetricsHistogramRecord (BRMetricsHistogram histogram,
+                          uint64_t value);
+
+/// Record the microseconds since `start`, from BRMetricsNow()
+extern void
+BRMetricsHistogramRecordSince (BRMetricsHistogram histogram,
+                               uint64_t start);
+
+/// A monotonic time, in microseconds
+extern uint64_t
+BRMetricsNow (void);
+
+// MARK: - Snapshot
+
+typedef struct {
+    const char *name;
+    uint64_t value;
+} BRMetricsCounterSnapshot;
+
+typedef struct {
+    const char *name;
+    uint64_t count;
+    uint64_t sum;
+    uint64_t buckets[BR_METRICS_HISTOGRAM_BUCKETS];
+} BRMetricsHistogramSnapshot;
+
+/// Fill `counters` with up to `countersCount` counters, in the order created.  If `counters` is
+/// NULL, return the number of counters.  Returns the number filled.
+extern size_t
+BRMetricsGetCounterSnapshots (BRMetrics metrics,
+                              BRMetricsCounterSnapshot *counters,
+                              size_t countersCount);
+
+/// Fill `histograms` with up to `histogramsCount` histograms, in the order created.  If
+/// `histograms` is NULL, return the number of histograms.  Returns the number filled.
+extern size_t
+BRMetricsGetHistogramSnapshots (BRMetrics metrics,
+                                BRMetricsHistogramSnapshot *histograms,
+                                size_t histogramsCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRMetrics_h */
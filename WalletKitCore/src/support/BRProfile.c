@@ -0,0 +1,152 @@
+//
+//  BRProfile.c
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "BRArray.h"
+#include "BRProfile.h"
+
+// A bound on the recorded phases, should a phase be begun in a loop.  Later phases are dropped.
+#define PROFILE_PHASES_LIMIT        (1024)
+
+struct BRProfileRecord {
+    /// The creation time, in nanoseconds
+    uint64_t origin;
+
+    /// The phases, in the order begun
+    BRArrayOf(BRProfilePhase) phases;
+
+    /// The number of phases open
+    size_t depth;
+};
+
+static __thread BRProfile profileCurrent = NULL;
+
+static uint64_t
+profileNow (void) {
+    struct timespec ts;
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+    return 1000000000 * (uint64_t) ts.tv_sec + (uint64_t) ts.tv_nsec;
+}
+
+extern BRProfile
+BRProfileNew (void) {
+    BRProfile profile = calloc (1, sizeof (struct BRProfileRecord));
+    assert (NULL != profile);
+
+    profile->origin = profileNow();
+    profile->depth  = 0;
+    array_new (profile->phases, 32);
+
+    return profile;
+}
+
+extern void
+BRProfileFree (BRProfile profile) {
+    if (NULL == profile) return;
+    if (profile == profileCurrent) profileCurrent = NULL;
+
+    array_free (profile->phases);
+    free (profile);
+}
+
+extern BRProfile
+BRProfileSetCurrent (BRProfile profile) {
+    BRProfile previous = profileCurrent;
+    profileCurrent = profile;
+    return previous;
+}
+
+extern BRProfile
+BRProfileGetCurrent (void) {
+    return profileCurrent;
+}
+
+extern BRProfileSpan
+BRProfileBegin (const char *name) {
+    BRProfile profile = profileCurrent;
+    if (NULL == profile || array_count (profile->phases) >= PROFILE_PHASES_LIMIT)
+        return BR_PROFILE_SPAN_NONE;
+
+    BRProfileSpan span = array_count (profile->phases);
+    array_add (profile->phases, ((BRProfilePhase) {
+        name,
+        profile->depth,
+        profileNow() - profile->origin,
+        0
+    }));
+    profile->depth += 1;
+
+    return span;
+}
+
+extern void
+BRProfileEnd (BRProfileSpan span) {
+    BRProfile profile = profileCurrent;
+    if (NULL == profile || span >= array_count (profile->phases)) return;
+    if (0 != profile->phases[span].duration) return;
+
+    uint64_t end = profileNow() - profile->origin;
+
+    // End `span` and any of its children left open
+    for (size_t index = span; index < array_count (profile->phases); index++) {
+        BRProfilePhase *phase = &profile->phases[index];
+        if (0 == phase->duration && phase->depth >= profile->phases[span].depth)
+            phase->duration = (end > phase->start ? end - phase->start : 1);
+    }
+    profile->depth = profile->phases[span].depth;
+}
+
+extern size_t
+BRProfileGetPhaseCount (BRProfile profile) {
+    return array_count (profile->phases);
+}
+
+extern BRProfilePhase
+BRProfileGetPhase (BRProfile profile,
+                   size_t index) {
+    assert (index < array_count (profile->phases));
+    return profile->phases[index];
+}
+
+extern uint64_t
+BRProfileGetTotal (BRProfile profile,
+                   const char *name,
+                   size_t *count) {
+    uint64_t total = 0;
+    size_t   found = 0;
+
+    for (size_t index = 0; index < array_count (profile->phases); index++)
+        if (0 == strcmp (name, profile->phases[index].name)) {
+            total += profile->phases[index].duration;
+            found += 1;
+        }
+
+    if (NULL != count) *count = found;
+    return total;
+}
+
+extern void
+BRProfilePrint (BRProfile profile,
+                const char *title,
+                FILE *file) {
+    fprintf (file, "%s:\n", (NULL == title ? "Profile" : title));
+
+    for (size_t index = 0; index < array_count (profile->phases); index++) {
+        BRProfilePhase *phase = &profile->phases[index];
+        size_t indent = 2 * (phase->depth < 16 ? phase->depth : 16);
+        fprintf (file, "%*s%-*s %10.3f ms\n",
+                 (int) (2 + indent), "",
+                 (int) (40 - indent), phase->name,
+                 (double) phase->duration / 1e6);
+    }
+}
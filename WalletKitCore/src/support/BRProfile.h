@@ -0,0 +1,114 @@
+//
+//  BRProfile.h
+//  Core
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+
+#ifndef BRProfile_h
+#define BRProfile_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// MARK: - Profile
+
+///
+/// A record of timed, named phases - such as loading a wallet manager's transactions from
+/// storage or deriving a wallet's addresses.  Phases nest; a phase begun while another is open
+/// is its child.
+///
+/// Phases are recorded against the calling thread's 'current' profile, if any, so that deeply
+/// nested code (BRWalletNew(), fileServiceLoad(), ...) need not be passed a profile.  With no
+/// current profile, BR_PROFILE_BEGIN() and BR_PROFILE_END() cost a thread-local load and a
+/// branch; with BR_PROFILE_DISABLED defined they compile to nothing.
+///
+/// A profile is not thread safe; it is only used by the thread on which it is current.
+///
+typedef struct BRProfileRecord *BRProfile;
+
+typedef struct {
+    /// The phase name; a static string
+    const char *name;
+
+    /// The number of phases open when this one began
+    size_t depth;
+
+    /// Nanoseconds from the profile's creation to the begin of this phase
+    uint64_t start;
+
+    /// Nanoseconds from the begin to the end of this phase; zero while still open.
+    uint64_t duration;
+} BRProfilePhase;
+
+/// An identifier for an begun phase, for BRProfileEnd().
+typedef size_t BRProfileSpan;
+
+#define BR_PROFILE_SPAN_NONE     ((BRProfileSpan) SIZE_MAX)
+
+extern BRProfile
+BRProfileNew (void);
+
+extern void
+BRProfileFree (BRProfile profile);
+
+/// Make `profile` (or none, if NULL) current on the calling thread.  Returns the previously
+/// current profile, which the caller should restore when done.
+extern BRProfile
+BRProfileSetCurrent (BRProfile profile);
+
+extern BRProfile
+BRProfileGetCurrent (void);
+
+/// Begin the phase `name` in the current profile.  Returns BR_PROFILE_SPAN_NONE if there is no
+/// current profile.
+extern BRProfileSpan
+BRProfileBegin (const char *name);
+
+/// End the phase `span`; any phases begun after `span`, and still open, are ended too.
+extern void
+BRProfileEnd (BRProfileSpan span);
+
+extern size_t
+BRProfileGetPhaseCount (BRProfile profile);
+
+/// The phase at `index`, in the order phases began.  The index must be less than
+/// BRProfileGetPhaseCount().
+extern BRProfilePhase
+BRProfileGetPhase (BRProfile profile,
+                   size_t index);
+
+/// The total duration of every phase named `name` (compared as strings), and, if `count` is not
+/// NULL, the number of them.
+extern uint64_t
+BRProfileGetTotal (BRProfile profile,
+                   const char *name,
+                   size_t *count);
+
+/// Print the phases to `file` - indented by depth, in milliseconds.
+extern void
+BRProfilePrint (BRProfile profile,
+                const char *title,
+                FILE *file);
+
+#if defined (BR_PROFILE_DISABLED)
+#define BR_PROFILE_BEGIN(name)       (BR_PROFILE_SPAN_NONE)
+#define BR_PROFILE_END(span)         ((void) (span))
+#else
+#define BR_PROFILE_BEGIN(name)       BRProfileBegin (name)
+#define BR_PROFILE_END(span)         BRProfileEnd (span)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRProfile_h */
@@ -13,6 +13,7 @@ import com.breadwallet.corenative.crypto.BRCryptoPayProtReqBitPayAndBip70Callbac
 import com.breadwallet.corenative.crypto.BRCryptoTransferState;
 import com.breadwallet.corenative.crypto.BRCryptoWalletManagerState;
 import com.breadwallet.corenative.crypto.BRCryptoWalletMigratorStatus;
+import com.breadwallet.corenative.crypto.BRCryptoWalletTransferCursor;
 import com.breadwallet.corenative.crypto.BRCryptoWalletManagerDisconnectReason;
 import com.breadwallet.corenative.crypto.BRCryptoSyncStoppedReason;
 import com.breadwallet.corenative.crypto.BRCryptoTransferSubmitError;
@@ -278,6 +279,9 @@ public final class CryptoLibraryDirect {
     public static native Pointer cryptoWalletGetBalanceMaximum(Pointer wallet);
     public static native Pointer cryptoWalletGetBalanceMinimum(Pointer wallet);
     public static native Pointer cryptoWalletGetTransfers(Pointer wallet, SizeTByReference count);
+    public static native SizeT cryptoWalletGetTransferCount(Pointer wallet);
+    public static native BRCryptoWalletTransferCursor.ByValue cryptoWalletTransferCursorInit();
+    public static native SizeT cryptoWalletGetTransfersPage(Pointer wallet, BRCryptoWalletTransferCursor cursor, Pointer transfers, SizeT transfersCount);
     public static native int cryptoWalletHasTransfer(Pointer wallet, Pointer transfer);
     public static native Pointer cryptoWalletGetAddress(Pointer wallet, int addressScheme);
     public static native int cryptoWalletHasAddress(Pointer wallet, Pointer address);
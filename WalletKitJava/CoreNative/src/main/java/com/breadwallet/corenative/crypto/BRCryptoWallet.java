@@ -14,6 +14,7 @@ import com.breadwallet.corenative.utility.SizeTByReference;
 import com.google.common.base.Optional;
 import com.google.common.primitives.UnsignedInts;
 import com.google.common.primitives.UnsignedLong;
+import com.sun.jna.Memory;
 import com.sun.jna.Native;
 import com.sun.jna.Pointer;
 import com.sun.jna.PointerType;
@@ -77,6 +78,34 @@ public class BRCryptoWallet extends PointerType {
     }
 
 
+    public UnsignedLong getTransferCount() {
+        Pointer thisPtr = this.getPointer();
+
+        return UnsignedLong.fromLongBits(
+                CryptoLibraryDirect.cryptoWalletGetTransferCount(thisPtr).longValue()
+        );
+    }
+
+    public BRCryptoWalletTransferCursor createTransferCursor() {
+        return CryptoLibraryDirect.cryptoWalletTransferCursorInit();
+    }
+
+    public List<BRCryptoTransfer> getTransfersPage(BRCryptoWalletTransferCursor cursor, int pageSize) {
+        Pointer thisPtr = this.getPointer();
+
+        List<BRCryptoTransfer> transfers = new ArrayList<>();
+        Memory transfersMemory = new Memory((long) Native.POINTER_SIZE * pageSize);
+        int transfersSize = UnsignedInts.checkedCast(
+                CryptoLibraryDirect.cryptoWalletGetTransfersPage(thisPtr, cursor, transfersMemory, new SizeT(pageSize)).longValue()
+        );
+        if (0 != transfersSize) {
+            for (Pointer transferPtr: transfersMemory.getPointerArray(0, transfersSize)) {
+                transfers.add(new BRCryptoTransfer(transferPtr));
+            }
+        }
+        return transfers;
+    }
+
     public boolean containsTransfer(BRCryptoTransfer transfer) {
         Pointer thisPtr = this.getPointer();
 
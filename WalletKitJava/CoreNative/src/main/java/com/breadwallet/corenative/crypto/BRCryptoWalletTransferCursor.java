@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2019 Breadwinner AG.  All right reserved.
+ *
+ * See the LICENSE file at the project root for license information.
+ * See the CONTRIBUTORS file at the project root for a list of contributors.
+ */
+package com.breadwallet.corenative.crypto;
+
+import com.sun.jna.Pointer;
+import com.sun.jna.Structure;
+
+import java.util.Arrays;
+import java.util.List;
+
+public class BRCryptoWalletTransferCursor extends Structure {
+
+    // the fields are opaque; they must be in sync with BRCryptoWalletTransferCursor
+    public long blockNumber;
+    public long transactionIndex;
+    public Pointer identity;
+
+    public BRCryptoWalletTransferCursor() {
+        super();
+    }
+
+    protected List<String> getFieldOrder() {
+        return Arrays.asList("blockNumber", "transactionIndex", "identity");
+    }
+
+    public BRCryptoWalletTransferCursor(Pointer peer) {
+        super(peer);
+    }
+
+    public static class ByReference extends BRCryptoWalletTransferCursor implements Structure.ByReference {
+
+    }
+
+    public static class ByValue extends BRCryptoWalletTransferCursor implements Structure.ByValue {
+
+    }
+}
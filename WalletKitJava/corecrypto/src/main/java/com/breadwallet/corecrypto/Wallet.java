@@ -18,6 +18,7 @@ import com.breadwallet.corenative.crypto.BRCryptoTransferAttribute;
 import com.breadwallet.corenative.crypto.BRCryptoWallet;
 import com.breadwallet.corenative.crypto.BRCryptoWalletManager;
 import com.breadwallet.corenative.crypto.BRCryptoWalletSweeper;
+import com.breadwallet.corenative.crypto.BRCryptoWalletTransferCursor;
 import com.breadwallet.crypto.AddressScheme;
 import com.breadwallet.crypto.WalletState;
 import com.breadwallet.crypto.errors.FeeEstimationError;
@@ -38,6 +39,7 @@ import java.util.Set;
 
 import javax.annotation.Nullable;
 
+import static com.google.common.base.Preconditions.checkArgument;
 import static com.google.common.base.Preconditions.checkState;
 
 /* package */
@@ -347,6 +349,21 @@ final class Wallet implements com.breadwallet.crypto.Wallet {
         return transfers;
     }
 
+    @Override
+    public void getTransfers(int pageSize, TransferPageHandler handler) {
+        checkArgument(pageSize > 0);
+
+        BRCryptoWalletTransferCursor cursor = core.createTransferCursor();
+        while (true) {
+            List<Transfer> transfers = new ArrayList<>();
+            for (BRCryptoTransfer transfer: core.getTransfersPage(cursor, pageSize)) {
+                transfers.add(Transfer.create(transfer, this));
+            }
+
+            if (transfers.isEmpty() || !handler.handlePage(transfers)) break;
+        }
+    }
+
     @Override
     public Optional<Transfer> getTransferByHash(com.breadwallet.crypto.TransferHash hash) {
         List<Transfer> transfers = getTransfers();
@@ -102,6 +102,17 @@ public interface Wallet {
 
     List<? extends Transfer> getTransfers();
 
+    /**
+     * Provide the transfers to `handler` in pages of at most `pageSize`, ordered by block number
+     * and transaction index, until all have been provided or `handler` returns `false`.  Only one
+     * page of transfers exists at a time.
+     */
+    void getTransfers(int pageSize, TransferPageHandler handler);
+
+    interface TransferPageHandler {
+        boolean handlePage(List<? extends Transfer> transfers);
+    }
+
     Optional<? extends Transfer> getTransferByHash(TransferHash hash);
 
     Set<? extends TransferAttribute> getTransferAttributesFor (@Nullable Address address);
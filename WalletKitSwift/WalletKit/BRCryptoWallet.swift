@@ -159,6 +159,31 @@ public final class Wallet: Equatable {
                              take: false) }
     }
 
+    /// The number of transfers; unlike `transfers.count` this does not create them
+    public var transfersCount: Int {
+        return cryptoWalletGetTransferCount (core)
+    }
+
+    /// Provide the transfers to `body` in pages of at most `pageSize`, ordered by block number and
+    /// transaction index, until all have been provided or `body` returns `false`.  Only one page
+    /// of transfers exists at a time.
+    public func transfers (pageSize: Int, _ body: ([Transfer]) -> Bool) {
+        precondition (pageSize > 0)
+        var cursor = cryptoWalletTransferCursorInit ()
+        var page = [BRCryptoTransfer?] (repeating: nil, count: pageSize)
+
+        while true {
+            let count = cryptoWalletGetTransfersPage (core, &cursor, &page, pageSize)
+            guard count > 0 else { return }
+
+            let transfers = page[0..<count]
+                .map { Transfer (core: $0!,
+                                 wallet: self,
+                                 take: false) }
+            guard body (transfers) else { return }
+        }
+    }
+
     /// Use a hash to lookup a transfer
     public func transferBy (hash: TransferHash) -> Transfer? {
         return transfers